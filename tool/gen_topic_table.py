@@ -0,0 +1,307 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+静态Topic表生成器
+
+读取JSON描述的Topic/规则/订阅者，生成topic_bus_init_static可直接使用的C源文件：
+  - 规则事件、超时与静态订阅者为const数组（位于只读存储）
+  - 每个规则附带一个RAM中的时效快照数组，由总线在发布时写入；超过32个事件的AND规则
+    附带扩展掩码，EDGE规则附带数据摘要数组（均位于RAM）
+  - event_key -> Topic 与 topic_id -> 槽位两级索引使用生成时搜索得到的无冲突乘法散列，
+    运行期查找与topic_bus.c中的__event_bucket/__topic_hash计算方式一致
+
+用法:
+  python3 tool/gen_topic_table.py <spec.json> -o <输出目录>
+
+JSON格式:
+{
+  "name": "app_topic_table",            // 生成文件名与表变量名
+  "includes": ["app_topics.h"],         // 可选：生成的.c需要额外包含的头文件
+  "topics": [
+    {
+      "id": 1,                          // topic_id（0..0xFFFE）
+      "rule": "OR",                     // OR / AND / MANUAL / WINDOW / DEBOUNCE / THROTTLE / EDGE
+      "events": [10, 20],               // 规则事件键（整数）
+      "timeouts_ms": [3000, 3000],      // 可选：与events一一对应的超时时间
+      "interval_ms": 100,               // 可选：WINDOW窗口 / DEBOUNCE静默时间 / THROTTLE最小间隔
+      "min_count": 2,                   // 可选：WINDOW窗口内需发布的不同事件数（0表示全部）
+      "subscribers": [                  // 可选：静态订阅者（同步回调）
+        {"callback": "on_topic", "user_data": "NULL"}
+      ]
+    }
+  ]
+}
+"""
+
+import argparse
+import json
+import os
+import sys
+
+HASH_MUL_DEFAULT = 2654435761
+MAX_EXTRA_BITS = 4
+MAX_MUL_TRIES = 20000
+RULE_TYPES = ("OR", "AND", "MANUAL", "WINDOW", "DEBOUNCE", "THROTTLE", "EDGE")
+
+
+def die(msg):
+    sys.stderr.write("gen_topic_table: %s\n" % msg)
+    sys.exit(1)
+
+
+def mul_candidates():
+    """候选散列乘数：先用默认Fibonacci乘数，再用固定种子的LCG序列（保证输出可复现）"""
+    yield HASH_MUL_DEFAULT
+    x = 0x9E3779B9
+    for _ in range(MAX_MUL_TRIES):
+        x = (x * 1664525 + 1013904223) & 0xFFFFFFFF
+        yield x | 1
+
+
+def bucket(key, mul, bits):
+    return ((key * mul) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def find_perfect_hash(keys, min_size):
+    """搜索使keys两两不冲突的(bits, mul)，桶数不小于min_size"""
+    bits = 1
+    while (1 << bits) < min_size:
+        bits += 1
+    for b in range(bits, bits + MAX_EXTRA_BITS + 1):
+        for mul in mul_candidates():
+            if len({bucket(k, mul, b) for k in keys}) == len(keys):
+                return b, mul
+    die("no collision-free hash found for %d keys" % len(keys))
+
+
+def load_spec(path):
+    with open(path, "r", encoding="utf-8") as f:
+        spec = json.load(f)
+    name = spec.get("name")
+    if not name or not name.replace("_", "a").isalnum():
+        die("invalid table name: %r" % name)
+    topics = spec.get("topics") or []
+    if not topics:
+        die("no topics declared")
+
+    seen = set()
+    for t in topics:
+        tid = t.get("id")
+        if not isinstance(tid, int) or tid < 0 or tid >= 0xFFFF:
+            die("invalid topic id: %r" % tid)
+        if tid in seen:
+            die("duplicate topic id: %d" % tid)
+        seen.add(tid)
+        rule = t.get("rule", "OR").upper()
+        if rule not in RULE_TYPES:
+            die("topic %d: unknown rule %r" % (tid, rule))
+        t["rule"] = rule
+        events = t.get("events") or []
+        if not all(isinstance(e, int) and 0 <= e <= 0xFFFFFFFF for e in events):
+            die("topic %d: events must be 32-bit integers" % tid)
+        for field in ("interval_ms", "min_count"):
+            v = t.get(field, 0)
+            if not isinstance(v, int) or v < 0 or v > 0xFFFFFFFF:
+                die("topic %d: %s must be a 32-bit unsigned integer" % (tid, field))
+            t[field] = v
+        timeouts = t.get("timeouts_ms")
+        if timeouts is not None and len(timeouts) != len(events):
+            die("topic %d: timeouts_ms must match events" % tid)
+        t["events"] = events
+        t["timeouts_ms"] = timeouts
+        t["subscribers"] = t.get("subscribers") or []
+    return name, spec.get("includes") or [], topics
+
+
+def generate(name, includes, topics, spec_path):
+    guard = name.upper() + "_H_"
+    n = len(topics)
+
+    # event_key -> Topic：每个规则内去重，MANUAL规则不入索引，同桶按槽位顺序
+    links = []
+    per_key = {}
+    for slot, t in enumerate(topics):
+        if t["rule"] == "MANUAL":
+            continue
+        for key in dict.fromkeys(t["events"]):
+            per_key.setdefault(key, []).append(slot)
+    keys = sorted(per_key)
+    ev_bits, ev_mul = find_perfect_hash(keys, max(len(keys), 1)) if keys else (1, HASH_MUL_DEFAULT)
+    ev_buckets = {}
+    for key in keys:
+        first = len(links)
+        slots = per_key[key]
+        for i, slot in enumerate(slots):
+            index = topics[slot]["events"].index(key)
+            links.append((key, slot, index, first + i + 1 if i + 1 < len(slots) else None))
+        ev_buckets[bucket(key, ev_mul, ev_bits)] = first
+
+    # topic_id -> 槽位：容量大于Topic数，未命中的查找总能探测到空位结束
+    ids = [t["id"] for t in topics]
+    tp_bits, tp_mul = find_perfect_hash(ids, n + 1)
+    tp_index = [0] * (1 << tp_bits)
+    for slot, tid in enumerate(ids):
+        tp_index[bucket(tid, tp_mul, tp_bits)] = slot + 1
+
+    rel_spec = os.path.basename(spec_path)
+    banner = ("/*\n"
+              " * 自动生成，请勿手动修改\n"
+              " * 来源: %s\n"
+              " * 生成: python3 tool/gen_topic_table.py %s -o <目录>\n"
+              " */\n") % (rel_spec, rel_spec)
+
+    h = [banner,
+         "#ifndef %s" % guard,
+         "#define %s" % guard,
+         "",
+         "#include \"topic_bus.h\"",
+         "",
+         "#ifdef __cplusplus",
+         "extern \"C\" {",
+         "#endif",
+         "",
+         "#if TOPIC_BUS_ENABLE_STATIC_TABLE",
+         "#define %s_TOPIC_COUNT %d" % (name.upper(), n),
+         "",
+         "extern const topic_static_table_t %s;" % name,
+         "#endif",
+         "",
+         "#ifdef __cplusplus",
+         "}",
+         "#endif",
+         "",
+         "#endif /* %s */" % guard,
+         ""]
+
+    c = [banner,
+         "#include \"%s.h\"" % name]
+    for inc in includes:
+        c.append("#include \"%s\"" % inc)
+    c += ["",
+          "#if TOPIC_BUS_ENABLE_STATIC_TABLE",
+          ""]
+
+    callbacks = sorted({s["callback"] for t in topics for s in t["subscribers"]})
+    if callbacks:
+        c.append("/* 静态订阅者回调 */")
+        for cb in callbacks:
+            c.append("extern void %s(uint16_t topic_id, const void* data, size_t data_len, void* user);" % cb)
+        c.append("")
+
+    c.append("/* 规则事件、超时与静态订阅者（只读） */")
+    for slot, t in enumerate(topics):
+        if t["events"]:
+            c.append("static const obj_dict_key_t %s_events_%d[] = { %s };"
+                     % (name, slot, ", ".join("%dU" % e for e in t["events"])))
+        if t["timeouts_ms"]:
+            c.append("static const uint32_t %s_timeouts_%d[] = { %s };"
+                     % (name, slot, ", ".join("%dU" % v for v in t["timeouts_ms"])))
+        if t["subscribers"]:
+            subs = ", ".join("{ .callback = %s, .user_data = %s }" % (s["callback"], s.get("user_data", "NULL"))
+                             for s in t["subscribers"])
+            c.append("static const topic_subscription_t %s_subs_%d[] = { %s };" % (name, slot, subs))
+    c.append("")
+
+    # MANUAL规则不响应事件，无需快照
+    snap = [bool(t["events"]) and t["rule"] != "MANUAL" for t in topics]
+    # 与TOPIC_RULE_MASK_EXT_WORDS一致
+    ext_words = [(len(t["events"]) - 1) // 32 if t["rule"] == "AND" and len(t["events"]) > 32 else 0
+                 for t in topics]
+    if any(snap):
+        c.append("/* 规则事件时效快照（运行期写入） */")
+        for slot, t in enumerate(topics):
+            if snap[slot]:
+                c.append("static uint64_t %s_ts_%d[%d];" % (name, slot, len(t["events"])))
+            if ext_words[slot]:
+                c.append("static uint32_t %s_mask_ext_%d[%d];" % (name, slot, ext_words[slot]))
+            if snap[slot] and t["rule"] == "EDGE":
+                c.append("static uint32_t %s_hash_%d[%d];" % (name, slot, len(t["events"])))
+        c.append("")
+
+    c.append("/* Topic条目（运行期字段由topic_bus_init_static重置） */")
+    c.append("static topic_entry_t %s_topics[%d] = {" % (name, n))
+    for slot, t in enumerate(topics):
+        ev = "(obj_dict_key_t*)%s_events_%d" % (name, slot) if t["events"] else "NULL"
+        to = "(uint32_t*)%s_timeouts_%d" % (name, slot) if t["timeouts_ms"] else "NULL"
+        ts = "%s_ts_%d" % (name, slot) if snap[slot] else "NULL"
+        extra = ""
+        if ext_words[slot]:
+            extra += ", .trigger_mask_ext = %s_mask_ext_%d" % (name, slot)
+        if snap[slot] and t["rule"] == "EDGE":
+            extra += ", .event_hash = %s_hash_%d" % (name, slot)
+        if t["interval_ms"]:
+            extra += ", .interval_ms = %dU" % t["interval_ms"]
+        if t["min_count"]:
+            extra += ", .min_count = %dU" % t["min_count"]
+        subs = "%s_subs_%d" % (name, slot) if t["subscribers"] else "NULL"
+        c.append("    { .topic_id = %d, .rule = { .type = TOPIC_RULE_%s, .events = %s, .event_count = %d, "
+                 ".event_timeouts_ms = %s, .event_ts_us = %s%s }, .static_subs = %s, .static_sub_count = %d },"
+                 % (t["id"], t["rule"], ev, len(t["events"]), to, ts, extra, subs, len(t["subscribers"])))
+    c.append("};")
+    c.append("")
+
+    if links:
+        c.append("/* event_key -> Topic索引节点 */")
+        c.append("static const topic_event_link_t %s_links[%d] = {" % (name, len(links)))
+        for key, slot, index, nxt in links:
+            nxt_s = "(topic_event_link_t*)&%s_links[%d]" % (name, nxt) if nxt is not None else "NULL"
+            c.append("    { .event_key = %dU, .entry = &%s_topics[%d], .event_index = %d, .next = %s },"
+                     % (key, name, slot, index, nxt_s))
+        c.append("};")
+        c.append("")
+
+    c.append("/* event_key索引桶（完美散列：乘数0x%08XU，%d位） */" % (ev_mul, ev_bits))
+    c.append("static topic_event_link_t* const %s_event_index[%d] = {" % (name, 1 << ev_bits))
+    for b in sorted(ev_buckets):
+        c.append("    [%d] = (topic_event_link_t*)&%s_links[%d]," % (b, name, ev_buckets[b]))
+    if not ev_buckets:
+        c.append("    NULL,")
+    c.append("};")
+    c.append("")
+
+    c.append("/* topic_id -> 槽位+1（完美散列：乘数0x%08XU，%d位） */" % (tp_mul, tp_bits))
+    c.append("static const uint32_t %s_topic_index[%d] = {" % (name, 1 << tp_bits))
+    row = []
+    for i, v in enumerate(tp_index):
+        row.append("%dU" % v)
+        if len(row) == 16 or i == len(tp_index) - 1:
+            c.append("    " + ", ".join(row) + ",")
+            row = []
+    c.append("};")
+    c.append("")
+
+    c += ["const topic_static_table_t %s = {" % name,
+          "    .topics = %s_topics," % name,
+          "    .topic_count = %d," % n,
+          "    .event_index = %s_event_index," % name,
+          "    .event_index_bits = %d," % ev_bits,
+          "    .event_hash_mul = 0x%08XU," % ev_mul,
+          "    .topic_index = %s_topic_index," % name,
+          "    .topic_index_bits = %d," % tp_bits,
+          "    .topic_hash_mul = 0x%08XU," % tp_mul,
+          "};",
+          "",
+          "#endif /* TOPIC_BUS_ENABLE_STATIC_TABLE */",
+          ""]
+    return "\n".join(h), "\n".join(c)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate a static topic_bus table with perfect-hash indexes")
+    parser.add_argument("spec", help="JSON table description")
+    parser.add_argument("-o", "--out-dir", default=".", help="output directory")
+    args = parser.parse_args()
+
+    name, includes, topics = load_spec(args.spec)
+    header, source = generate(name, includes, topics, args.spec)
+
+    os.makedirs(args.out_dir, exist_ok=True)
+    for ext, text in (("h", header), ("c", source)):
+        path = os.path.join(args.out_dir, "%s.%s" % (name, ext))
+        with open(path, "w", encoding="utf-8", newline="\n") as f:
+            f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
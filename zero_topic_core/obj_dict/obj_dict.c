@@ -2,47 +2,576 @@
 #include "obj_dict.h"
 #include "obj_dict_mempool.h"
 #include "../../Rte/inc/os_heap.h"
+#include "../../Rte/inc/os_thread.h"
+
+/* 数据缓冲头：位于数据之前，记录缓冲的引用计数（条目持有1，每个借用者各持有1） */
+typedef struct obj_dict_buf_hdr {
+    atomic_uint_fast32_t pins;          /* 引用计数 */
+    uint32_t retire_epoch;              /* 换下时的读者纪元 */
+    struct obj_dict_buf_hdr* retire_next; /* 待回收链表（持dict->lock访问） */
+} obj_dict_buf_hdr_t;
+
+#define OBJ_DICT_BUF_HDR_SIZE ((sizeof(obj_dict_buf_hdr_t) + 15U) & ~(size_t)15U)
+#define OBJ_DICT_BUF_HDR(p)   ((obj_dict_buf_hdr_t*)((uint8_t*)(uintptr_t)(p) - OBJ_DICT_BUF_HDR_SIZE))
+
+/* 三缓冲槽位：数据前同样有缓冲头，借用时钉住 */
+typedef struct {
+    atomic_uint_fast32_t seq;           /* 槽位序列号：写入期间为奇数 */
+    size_t   len;                       /* 数据长度 */
+    uint64_t timestamp_us;              /* 时间戳(微秒) */
+    uint32_t version;                   /* 版本号 */
+    uint8_t  flags;                     /* 标志 */
+    uint8_t* data;                      /* 数据（缓冲头之后） */
+} obj_dict_triple_slot_t;
+
+/* 三缓冲块：与三个槽位的数据一次分配，条目的value指向它 */
+typedef struct {
+    atomic_uint_fast8_t latest;         /* 最新完整槽位的下标 */
+    uint32_t version;                   /* 写入次数（只由写入者修改） */
+    atomic_uint_fast32_t dropped;       /* 三个槽位都被借用而丢弃的写入次数 */
+    obj_dict_triple_slot_t slots[3];
+} obj_dict_triple_t;
+
+#define OBJ_DICT_ALIGN16(n) (((n) + 15U) & ~(size_t)15U)
+
+#if OBJ_DICT_READER_SHARDS > 1
+/* 线程所在的读者分片（0表示尚未分配） */
+static OBJ_DICT_TLS uint32_t s_reader_slot = 0;
+static atomic_uint_fast32_t s_reader_next = 0;
+#endif
 
 /* ============================================================
  * 内部函数声明 (Internal Functions Declaration)
  * ============================================================ */
 
-static obj_dict_entry_t* __find_entry(obj_dict_t* dict, obj_dict_key_t key);
-static obj_dict_entry_t* __find_free_slot(obj_dict_t* dict);
+static size_t __key_home(const obj_dict_t* dict, obj_dict_key_t key);
+static obj_dict_entry_t* __find_free_slot(obj_dict_t* dict, obj_dict_key_t key);
+static void __settle_tombstones(obj_dict_t* dict, size_t pos);
+static void* __alloc_value(obj_dict_t* dict, size_t len, size_t* cap);
+static void __free_value(obj_dict_t* dict, void* value);
+static int __value_pinned(const obj_dict_entry_t* e);
+static void __value_unpin(obj_dict_t* dict, const void* value);
+static void __retire_value(obj_dict_t* dict, void* value);
+static void __reclaim_values(obj_dict_t* dict);
+static obj_dict_entry_t* __triple_insert(obj_dict_t* dict, obj_dict_key_t key, size_t cap);
+static int __triple_pinned(const obj_dict_triple_t* t);
+static int __triple_claim(obj_dict_triple_slot_t* slot);
+static int __triple_write(obj_dict_entry_t* e, obj_dict_key_t key, const void* data, size_t len, uint8_t flags);
+static int __triple_read(obj_dict_triple_t* t, obj_dict_peek_fn_t fn, void* user_data, uint64_t* ts_us,
+                         uint32_t* version, uint8_t* flags);
+static void __triple_latest(obj_dict_triple_t* t, uint64_t* ts_us, uint32_t* version);
+static obj_dict_reader_shard_t* __reader_shard(obj_dict_t* dict);
+static uint32_t __read_lock(obj_dict_t* dict, obj_dict_reader_shard_t* shard);
+static void __read_unlock(obj_dict_reader_shard_t* shard, uint32_t idx);
+static int __reader_advance(obj_dict_t* dict);
+static void __reader_sync(obj_dict_t* dict);
+static void __backoff(uint32_t* spins);
+static uint32_t __entry_lock(obj_dict_entry_t* e);
+static void __entry_unlock(obj_dict_entry_t* e, uint32_t seq);
+static void __entry_write(obj_dict_entry_t* e, const void* data, size_t len, uint8_t flags);
+static void __set_notify(obj_dict_t* dict, obj_dict_key_t key, const void* data, size_t len, uint8_t flags);
+static int __entry_read(obj_dict_t* dict, obj_dict_key_t key, obj_dict_peek_fn_t fn, void* user_data,
+                        uint64_t* ts_us, uint32_t* version, uint8_t* flags);
+static void __copy_visit(const void* data, size_t len, void* user_data);
 
 /* ============================================================
  * 函数实现 (Function Implementation)
  * ============================================================ */
 
 /*
- * @brief 查找指定key的条目
+ * @brief 计算key在条目数组中的起始探测位置
+ * @param dict 字典句柄
+ * @param key  目标键
+ * @return 起始槽位下标
+ */
+static size_t __key_home(const obj_dict_t* dict, obj_dict_key_t key) {
+    /* Fibonacci散列把连续的事件键打散，再按比例映射到[0, max_keys)，容量不必是2的幂 */
+    uint32_t hash = (uint32_t)key * 2654435769U;
+    return (size_t)(((uint64_t)hash * dict->max_keys) >> 32);
+}
+
+/*
+ * @brief 查找指定key的条目（不加锁）
  * @param dict 字典句柄
  * @param key  目标键
  * @return 找到返回条目指针，否则返回NULL
  */
-static obj_dict_entry_t* __find_entry(obj_dict_t* dict, obj_dict_key_t key) {
-    for (size_t i = 0; i < dict->max_keys; ++i) {
-        if (dict->entries[i].value != NULL && dict->entries[i].key == key) {
-            return &dict->entries[i];
-        }
+obj_dict_entry_t* obj_dict_lookup(obj_dict_t* dict, obj_dict_key_t key) {
+    if (!dict || !dict->entries) return NULL;
+    size_t pos = __key_home(dict, key);
+    for (size_t n = 0; n <= dict->max_probe; ++n) {
+        obj_dict_entry_t* e = &dict->entries[pos];
+        uint_fast8_t state = atomic_load_explicit(&e->state, memory_order_acquire);
+        if (state == OBJ_DICT_SLOT_EMPTY) return NULL;  /* 探测链结束 */
+        if (state == OBJ_DICT_SLOT_USED && e->key == key) return e;
+        if (++pos == dict->max_keys) pos = 0;
     }
     return NULL;
 }
 
 /*
- * @brief 查找空闲条目槽位
+ * @brief 沿key的探测序列查找可插入的槽位（需持有dict->lock，且已确认key不存在）
  * @param dict 字典句柄
- * @return 返回空槽的条目指针，若无空槽返回NULL
+ * @param key  待插入的键
+ * @return 返回第一个墓碑或空槽的条目指针（同时更新最长探测距离），若无空槽返回NULL
  */
-static obj_dict_entry_t* __find_free_slot(obj_dict_t* dict) {
-    for (size_t i = 0; i < dict->max_keys; ++i) {
-        if (dict->entries[i].value == NULL) {
-            return &dict->entries[i];
+static obj_dict_entry_t* __find_free_slot(obj_dict_t* dict, obj_dict_key_t key) {
+    size_t pos = __key_home(dict, key);
+    for (size_t n = 0; n < dict->max_keys; ++n) {
+        obj_dict_entry_t* e = &dict->entries[pos];
+        if (atomic_load_explicit(&e->state, memory_order_relaxed) != OBJ_DICT_SLOT_USED) {
+            if (n > dict->max_probe) dict->max_probe = n;
+            return e;
         }
+        if (++pos == dict->max_keys) pos = 0;
     }
     return NULL;
 }
 
+/*
+ * @brief 回收不再承担探测链的墓碑（需持有dict->lock）
+ *        pos之后的槽位为空时，没有探测链经过pos继续向后，
+ *        pos及其前面相邻的墓碑都可还原为空槽，查找不必再越过它们
+ * @param dict 字典句柄
+ * @param pos  刚变为墓碑的槽位
+ */
+static void __settle_tombstones(obj_dict_t* dict, size_t pos) {
+    size_t next = (pos + 1 == dict->max_keys) ? 0 : pos + 1;
+    if (atomic_load_explicit(&dict->entries[next].state, memory_order_relaxed) != OBJ_DICT_SLOT_EMPTY) return;
+    for (size_t n = 0; n < dict->max_keys; ++n) {
+        obj_dict_entry_t* e = &dict->entries[pos];
+        if (atomic_load_explicit(&e->state, memory_order_relaxed) != OBJ_DICT_SLOT_DELETED) break;
+        atomic_store_explicit(&e->state, OBJ_DICT_SLOT_EMPTY, memory_order_release);
+        pos = (pos == 0) ? dict->max_keys - 1 : pos - 1;
+    }
+}
+
+/*
+ * @brief 分配数据缓冲（优先内存池），缓冲的引用计数初始为1，由条目持有
+ * @param dict 字典句柄
+ * @param len  需要的长度（> 0）
+ * @param cap  输出缓冲容量
+ * @return 缓冲指针（缓冲头之后），失败返回NULL
+ */
+static void* __alloc_value(obj_dict_t* dict, size_t len, size_t* cap) {
+    size_t size = OBJ_DICT_BUF_HDR_SIZE + len;
+    obj_dict_buf_hdr_t* hdr = NULL;
+#if OBJ_DICT_MEMPOOL_ENABLE
+    if (dict->mempool && size <= OBJ_DICT_MEMPOOL_BLOCK_SIZE) {
+        hdr = (obj_dict_buf_hdr_t*)obj_dict_mempool_alloc(dict->mempool, size);
+    }
+    if (!hdr) {
+        /* 未使用内存池或内存池分配失败，回退到系统堆 */
+        hdr = (obj_dict_buf_hdr_t*)os_malloc(size);
+    }
+#else
+    (void)dict;
+    hdr = (obj_dict_buf_hdr_t*)os_malloc(size);
+#endif
+    if (!hdr) return NULL;
+    atomic_init(&hdr->pins, 1);
+    *cap = len;
+    return (uint8_t*)hdr + OBJ_DICT_BUF_HDR_SIZE;
+}
+
+/*
+ * @brief 释放数据缓冲（调用者已确认没有读者与借用者仍在访问）
+ * @param dict  字典句柄
+ * @param value 数据缓冲（可为NULL）
+ */
+static void __free_value(obj_dict_t* dict, void* value) {
+    if (!value) return;
+    obj_dict_buf_hdr_t* hdr = OBJ_DICT_BUF_HDR(value);
+#if OBJ_DICT_MEMPOOL_ENABLE
+    /* 内存池满时回退到系统堆分配，按地址区分归还对象 */
+    if (obj_dict_mempool_owns(dict->mempool, hdr)) {
+        obj_dict_mempool_free(dict->mempool, hdr);
+    } else {
+        os_free(hdr);
+    }
+#else
+    (void)dict;
+    os_free(hdr);
+#endif
+}
+
+/*
+ * @brief 条目当前的缓冲是否被借用（独占条目时结果可靠，否则只作提示）
+ * @param e 条目
+ * @return 1被借用，0未借用或无缓冲
+ */
+static int __value_pinned(const obj_dict_entry_t* e) {
+    if (!e->value) return 0;
+    /* 与obj_dict_borrow配对：独占条目后再读引用，借用者先加引用再复查序列号，两者至少一方看到对方 */
+    atomic_thread_fence(memory_order_seq_cst);
+    return atomic_load_explicit(&OBJ_DICT_BUF_HDR(e->value)->pins, memory_order_relaxed) > 1;
+}
+
+/*
+ * @brief 释放缓冲的一个引用，最后一个引用释放时归还缓冲
+ * @param dict  字典句柄
+ * @param value 数据缓冲
+ */
+static void __value_unpin(obj_dict_t* dict, const void* value) {
+    if (atomic_fetch_sub_explicit(&OBJ_DICT_BUF_HDR(value)->pins, 1, memory_order_acq_rel) == 1) {
+        __free_value(dict, (void*)(uintptr_t)value);
+    }
+}
+
+/*
+ * @brief 换下条目的旧缓冲并尝试回收（需持有dict->lock，旧缓冲已不可达，不阻塞）
+ *        读区内的读者可能仍持有旧指针，先挂入待回收链表，读者退出后再释放条目的引用；
+ *        仍被借用时由最后一次归还释放
+ * @param dict  字典句柄
+ * @param value 旧缓冲（可为NULL）
+ */
+static void __retire_value(obj_dict_t* dict, void* value) {
+    if (value) {
+        obj_dict_buf_hdr_t* hdr = OBJ_DICT_BUF_HDR(value);
+        hdr->retire_epoch = (uint32_t)atomic_load_explicit(&dict->read_epoch, memory_order_seq_cst);
+        hdr->retire_next = dict->retired;
+        dict->retired = hdr;
+    }
+    __reclaim_values(dict);
+}
+
+/*
+ * @brief 推进读者纪元并释放已过宽限期的旧缓冲（需持有dict->lock，不阻塞）
+ * @details 在纪元e换下的缓冲经过两次推进后不再可能被读区内的读者持有；
+ *          读者尚未退出时留在链表中，由之后的写入或清理再试
+ * @param dict 字典句柄
+ */
+static void __reclaim_values(obj_dict_t* dict) {
+    for (int i = 0; i < 2 && dict->retired; ++i) {
+        if (!__reader_advance(dict)) break;  /* 上一代读者尚未退出，下次再试 */
+    }
+
+    uint32_t now = (uint32_t)atomic_load_explicit(&dict->read_epoch, memory_order_seq_cst);
+    obj_dict_buf_hdr_t** pp = &dict->retired;
+    while (*pp) {
+        obj_dict_buf_hdr_t* hdr = *pp;
+        if ((uint32_t)(now - hdr->retire_epoch) >= 2U) {
+            *pp = hdr->retire_next;
+            __value_unpin(dict, (uint8_t*)hdr + OBJ_DICT_BUF_HDR_SIZE);
+        } else {
+            pp = &hdr->retire_next;
+        }
+    }
+}
+
+/*
+ * @brief 插入三缓冲键（需持有dict->lock，且已确认key不存在）
+ * @param dict 字典句柄
+ * @param key  待插入的键
+ * @param cap  每个槽位的容量（> 0）
+ * @return 条目指针，无空槽或分配失败返回NULL
+ */
+static obj_dict_entry_t* __triple_insert(obj_dict_t* dict, obj_dict_key_t key, size_t cap) {
+    obj_dict_entry_t* e = __find_free_slot(dict, key);
+    if (!e) return NULL;
+
+    /* 缓冲头、块头与三个槽位（缓冲头 + 数据）一次分配，之后的写入不再分配；
+     * 块前的缓冲头使清理时可与普通缓冲一样挂入待回收链表 */
+    size_t stride = OBJ_DICT_BUF_HDR_SIZE + OBJ_DICT_ALIGN16(cap);
+    uint8_t* block = (uint8_t*)os_malloc(OBJ_DICT_BUF_HDR_SIZE + OBJ_DICT_ALIGN16(sizeof(obj_dict_triple_t)) +
+                                         3U * stride);
+    if (!block) return NULL;
+    atomic_init(&((obj_dict_buf_hdr_t*)block)->pins, 1);
+    block += OBJ_DICT_BUF_HDR_SIZE;
+    obj_dict_triple_t* t = (obj_dict_triple_t*)block;
+    memset(t, 0, sizeof(*t));
+    atomic_init(&t->latest, 0);
+    atomic_init(&t->dropped, 0);
+    uint8_t* p = block + OBJ_DICT_ALIGN16(sizeof(obj_dict_triple_t));
+    for (int i = 0; i < 3; ++i, p += stride) {
+        atomic_init(&t->slots[i].seq, 0);
+        atomic_init(&((obj_dict_buf_hdr_t*)p)->pins, 1);  /* 块持有1，与普通缓冲一致 */
+        t->slots[i].data = p + OBJ_DICT_BUF_HDR_SIZE;
+    }
+
+    uint32_t seq = __entry_lock(e);
+    e->key = key;
+    e->value = t;
+    e->value_len = 0;
+    e->value_cap = cap;
+    e->flags = 0;
+    e->mode = OBJ_DICT_MODE_TRIPLE;
+    atomic_store_explicit(&e->state, OBJ_DICT_SLOT_USED, memory_order_release);
+    __entry_unlock(e, seq + 2U);
+    return e;
+}
+
+/*
+ * @brief 三缓冲块是否有槽位被借用
+ * @param t 三缓冲块
+ * @return 1有，0无
+ */
+static int __triple_pinned(const obj_dict_triple_t* t) {
+    for (int i = 0; i < 3; ++i) {
+        if (atomic_load_explicit(&OBJ_DICT_BUF_HDR(t->slots[i].data)->pins, memory_order_seq_cst) > 1) return 1;
+    }
+    return 0;
+}
+
+/*
+ * @brief 占用槽位准备写入：序列号置为奇数后复查借用
+ * @param slot 槽位（只有写入者修改其序列号）
+ * @return 1已占用，0槽位被借用（序列号已还原）
+ */
+static int __triple_claim(obj_dict_triple_slot_t* slot) {
+    /* 与借用者配对：以一次顺序一致的原子加置奇数再读引用，借用者先加引用再复查序列号，两者至少一方看到对方 */
+    uint32_t seq = (uint32_t)atomic_fetch_add_explicit(&slot->seq, 1, memory_order_seq_cst);
+    if (atomic_load_explicit(&OBJ_DICT_BUF_HDR(slot->data)->pins, memory_order_seq_cst) > 1) {
+        atomic_store_explicit(&slot->seq, seq, memory_order_release);  /* 数据未修改 */
+        return 0;
+    }
+    atomic_thread_fence(memory_order_release);  /* 之后的数据写入不能先于奇数被看到 */
+    return 1;
+}
+
+/*
+ * @brief 三缓冲写入：写入既非最新也未被借用的槽位，写完切换最新下标（不加锁、不分配、不进入读区）
+ * @details 条目上的写入标志与清理配对：写入者先置标志再复查槽位，清理先置墓碑再复查标志，
+ *          两者至少一方看到对方，写入期间三缓冲块不会被换下；元数据只随槽位发布，条目上的不再更新
+ * @param e     条目（查找结果，置标志后复核）
+ * @param key   键值
+ * @param data  数据
+ * @param len   长度（不超过槽位容量）
+ * @param flags 标志位
+ * @return 0成功，-1失败（键已清理或正在清理、超过容量、并发写入或三个槽位都被借用，后者计入丢弃次数）
+ */
+static int __triple_write(obj_dict_entry_t* e, obj_dict_key_t key, const void* data, size_t len, uint8_t flags) {
+    if (atomic_exchange_explicit(&e->writer, 1, memory_order_seq_cst) != 0) return -1;  /* 并发写入 */
+    int ret = -1;
+
+    if (atomic_load_explicit(&e->state, memory_order_seq_cst) == OBJ_DICT_SLOT_USED && e->key == key &&
+        e->mode == OBJ_DICT_MODE_TRIPLE && len <= e->value_cap) {
+        obj_dict_triple_t* t = (obj_dict_triple_t*)e->value;
+        uint32_t latest = (uint32_t)atomic_load_explicit(&t->latest, memory_order_relaxed);
+        /* 优先写最久未更新的槽位，读者被套圈的机会最小；两者都被借用时原地改写未被借用的最新槽位 */
+        for (uint32_t k = 1; k <= 3; ++k) {
+            uint32_t w = (latest + k) % 3U;
+            obj_dict_triple_slot_t* slot = &t->slots[w];
+            if (!__triple_claim(slot)) continue;
+
+            if (len > 0) {
+                memcpy(slot->data, data, len);
+            }
+            slot->len = len;
+            slot->timestamp_us = os_monotonic_time_get_microsecond();
+            slot->version = ++t->version;
+            slot->flags = flags;
+            atomic_store_explicit(&slot->seq, (uint32_t)atomic_load_explicit(&slot->seq, memory_order_relaxed) + 1U,
+                                  memory_order_release);
+            if (w != latest) {
+                atomic_store_explicit(&t->latest, w, memory_order_release);
+            }
+            ret = 0;
+            break;
+        }
+        if (ret != 0) {
+            atomic_fetch_add_explicit(&t->dropped, 1, memory_order_relaxed);
+        }
+    }
+
+    atomic_store_explicit(&e->writer, 0, memory_order_release);
+    return ret;
+}
+
+/*
+ * @brief 读取三缓冲条目的最新槽位（需在读区内）
+ * @param t    三缓冲块
+ * @param fn   数据访问函数（可为NULL）
+ * @param user_data 访问函数的用户数据
+ * @param ts_us   输出时间戳
+ * @param version 输出版本号
+ * @param flags   输出标志位
+ * @return 1读到一致的数据，0被写入者套圈需重试
+ */
+static int __triple_read(obj_dict_triple_t* t, obj_dict_peek_fn_t fn, void* user_data, uint64_t* ts_us,
+                         uint32_t* version, uint8_t* flags) {
+    obj_dict_triple_slot_t* slot = &t->slots[atomic_load_explicit(&t->latest, memory_order_acquire)];
+    uint32_t seq = (uint32_t)atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if (seq & 1U) return 0;
+    size_t len = slot->len;
+    *ts_us = slot->timestamp_us;
+    *version = slot->version;
+    *flags = slot->flags;
+    if (fn) {
+        fn(slot->data, len, user_data);
+    }
+    atomic_thread_fence(memory_order_acquire);
+    return (uint32_t)atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq;
+}
+
+/*
+ * @brief 读取三缓冲块最新槽位的时间戳与版本号（调用者保证块在访问期间不被释放）
+ * @param t       三缓冲块
+ * @param ts_us   输出时间戳
+ * @param version 输出版本号
+ */
+static void __triple_latest(obj_dict_triple_t* t, uint64_t* ts_us, uint32_t* version) {
+    uint8_t fl;
+    uint32_t spins = 0;
+    while (!__triple_read(t, NULL, NULL, ts_us, version, &fl)) {
+        __backoff(&spins);  /* 被写入者套圈 */
+    }
+}
+
+/*
+ * @brief 取得当前线程的读者分片（首次调用时按线程轮流分配）
+ * @param dict 字典句柄
+ * @return 读者分片
+ */
+static obj_dict_reader_shard_t* __reader_shard(obj_dict_t* dict) {
+#if OBJ_DICT_READER_SHARDS > 1
+    if (s_reader_slot == 0) {
+        s_reader_slot = (uint32_t)atomic_fetch_add_explicit(&s_reader_next, 1, memory_order_relaxed) + 1U;
+    }
+    return &dict->readers[(s_reader_slot - 1U) % OBJ_DICT_READER_SHARDS];
+#else
+    return &dict->readers[0];  /* 单分片：不需要线程局部存储 */
+#endif
+}
+
+/*
+ * @brief 进入读区（只写本线程的分片，读者之间无共享写入）
+ * @param dict  字典句柄
+ * @param shard 本线程的读者分片
+ * @return 读者所在的纪元奇偶槽，退出时传回
+ */
+static uint32_t __read_lock(obj_dict_t* dict, obj_dict_reader_shard_t* shard) {
+    uint32_t idx = (uint32_t)atomic_load_explicit(&dict->read_epoch, memory_order_acquire) & 1U;
+    atomic_fetch_add_explicit(&shard->count[idx], 1, memory_order_seq_cst);
+    return idx;
+}
+
+/*
+ * @brief 退出读区
+ * @param shard 本线程的读者分片
+ * @param idx   __read_lock返回的奇偶槽
+ */
+static void __read_unlock(obj_dict_reader_shard_t* shard, uint32_t idx) {
+    atomic_fetch_sub_explicit(&shard->count[idx], 1, memory_order_release);
+}
+
+/*
+ * @brief 尝试推进一次读者纪元：要求上一代读者已在所有分片上退出
+ * @details 纪元由e推进到e+1前要求奇偶槽(e+1)&1（即e-1代读者）已清空
+ * @param dict 字典句柄
+ * @return 1纪元已推进，0上一代读者尚未退出
+ */
+static int __reader_advance(obj_dict_t* dict) {
+    uint_fast32_t e = atomic_load_explicit(&dict->read_epoch, memory_order_seq_cst);
+    uint32_t prev = (uint32_t)(e + 1U) & 1U;
+    for (size_t s = 0; s < OBJ_DICT_READER_SHARDS; ++s) {
+        if (atomic_load_explicit(&dict->readers[s].count[prev], memory_order_seq_cst) != 0) return 0;
+    }
+    (void)atomic_compare_exchange_strong_explicit(&dict->read_epoch, &e, e + 1U, memory_order_seq_cst,
+                                                  memory_order_seq_cst);
+    return 1;
+}
+
+/*
+ * @brief 等待进入读区的读者全部退出（需持有dict->lock，阻塞；只用于更换写入钩子）
+ * @details 纪元推进两次，此后的读者只能看到新状态；缓冲回收走__retire_value，不在此等待
+ * @param dict 字典句柄
+ */
+static void __reader_sync(obj_dict_t* dict) {
+    for (int i = 0; i < 2; ++i) {
+        while (!__reader_advance(dict)) {
+            os_thread_sleep_ms(OBJ_DICT_BACKOFF_SLEEP_MS);  /* 读者可能是被抢占的低优先级任务，需真正阻塞 */
+        }
+    }
+}
+
+/*
+ * @brief 等待条目写入完成：写入通常只有一次memcpy，先自旋，超过次数后休眠
+ * @details 自旋超限说明写入者多半已被抢占；休眠至少一个节拍而非只让出CPU，
+ *          否则高优先级等待者在RTOS上会一直占用CPU，低优先级写入者永远无法完成
+ * @param spins 已自旋次数
+ */
+static void __backoff(uint32_t* spins) {
+    if (++*spins < OBJ_DICT_SPIN_LIMIT) return;
+    *spins = 0;
+    os_thread_sleep_ms(OBJ_DICT_BACKOFF_SLEEP_MS);
+}
+
+/*
+ * @brief 独占条目：把序列号由偶数置为奇数
+ * @param e 条目
+ * @return 独占前的序列号（偶数），解除时传回seq+2（已修改）或seq（未修改）
+ */
+static uint32_t __entry_lock(obj_dict_entry_t* e) {
+    uint32_t spins = 0;
+    for (;;) {
+        uint_fast32_t seq = atomic_load_explicit(&e->version, memory_order_relaxed);
+        if ((seq & 1U) == 0 &&
+            atomic_compare_exchange_weak_explicit(&e->version, &seq, seq + 1U, memory_order_acquire,
+                                                  memory_order_relaxed)) {
+            /* 之后对条目的写入不能先于奇数序列号被读者看到 */
+            atomic_thread_fence(memory_order_release);
+            return (uint32_t)seq;
+        }
+        if (seq & 1U) {
+            __backoff(&spins);  /* 同一键的另一写入者正在写 */
+        }
+    }
+}
+
+/*
+ * @brief 解除条目独占
+ * @param e   条目
+ * @param seq 新的序列号（偶数）
+ */
+static void __entry_unlock(obj_dict_entry_t* e, uint32_t seq) {
+    atomic_store_explicit(&e->version, seq, memory_order_release);
+}
+
+/*
+ * @brief 写入数据（需独占条目，且len不超过容量）
+ * @param e     条目
+ * @param data  数据
+ * @param len   长度
+ * @param flags 标志位
+ */
+static void __entry_write(obj_dict_entry_t* e, const void* data, size_t len, uint8_t flags) {
+    if (len > 0) {
+        memcpy(e->value, data, len);
+    }
+    e->value_len = len;
+    e->flags = flags;
+    e->timestamp_us = os_monotonic_time_get_microsecond();
+}
+
+/*
+ * @brief 写入完成后调用写入钩子（已解除条目独占，读者不会因钩子耗时而重试）
+ * @details 钩子在读区内调用，obj_dict_set_hook更换钩子后等待读区退出，旧钩子不会再被调用
+ * @param dict  字典句柄
+ * @param key   键值
+ * @param data  调用者传入的数据（obj_dict_set返回前有效）
+ * @param len   长度
+ * @param flags 标志位
+ */
+static void __set_notify(obj_dict_t* dict, obj_dict_key_t key, const void* data, size_t len, uint8_t flags) {
+#if OBJ_DICT_ENABLE_SET_HOOK
+    if (!atomic_load_explicit(&dict->set_hook, memory_order_relaxed)) return;  /* 未设置钩子时只有一次加载 */
+    obj_dict_reader_shard_t* shard = __reader_shard(dict);
+    uint32_t idx = __read_lock(dict, shard);
+    obj_dict_hook_t* hook = atomic_load_explicit(&dict->set_hook, memory_order_seq_cst);
+    if (hook) {
+        hook->fn(key, data, len, flags, hook->user_data);
+    }
+    __read_unlock(shard, idx);
+#else
+    (void)dict;
+    (void)key;
+    (void)data;
+    (void)len;
+    (void)flags;
+#endif
+}
+
 /*
  * @brief 初始化对象字典
  * @param dict 字典对象
@@ -54,14 +583,28 @@ int obj_dict_init(obj_dict_t* dict, obj_dict_entry_t* entry_array, size_t max_ke
     if (!dict || !entry_array || max_keys == 0) return -1;
     dict->entries = entry_array;
     dict->max_keys = max_keys;
+    dict->max_probe = 0;
     memset(entry_array, 0, sizeof(obj_dict_entry_t) * max_keys);
     /* 初始化所有条目的原子版本号和引用计数 */
     for (size_t i = 0; i < max_keys; ++i) {
         atomic_init(&entry_array[i].version, 0);
         atomic_init(&entry_array[i].ref_count, 0);
+        atomic_init(&entry_array[i].state, OBJ_DICT_SLOT_EMPTY);
+        atomic_init(&entry_array[i].writer, 0);
+        entry_array[i].mode = OBJ_DICT_MODE_NORMAL;
+    }
+    atomic_init(&dict->read_epoch, 0);
+    dict->retired = NULL;
+    for (size_t s = 0; s < OBJ_DICT_READER_SHARDS; ++s) {
+        atomic_init(&dict->readers[s].count[0], 0);
+        atomic_init(&dict->readers[s].count[1], 0);
     }
 #if OBJ_DICT_MEMPOOL_ENABLE
     dict->mempool = NULL;  /* 默认不使用内存池 */
+#endif
+#if OBJ_DICT_ENABLE_SET_HOOK
+    atomic_init(&dict->set_hook, NULL);
+    memset(dict->hook_slots, 0, sizeof(dict->hook_slots));
 #endif
     dict->lock = os_semaphore_create(1, "obj_dict_lock");
     return (dict->lock != NULL) ? 0 : -1;
@@ -102,86 +645,300 @@ int obj_dict_init_with_mempool(obj_dict_t* dict, obj_dict_entry_t* entry_array,
  */
 int obj_dict_set(obj_dict_t* dict, obj_dict_key_t key, const void* data, size_t len, uint8_t flags) {
     if (!dict || (!data && len > 0)) return -1;
-    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
 
-    obj_dict_entry_t* e = __find_entry(dict, key);
-    if (!e) {
-        e = __find_free_slot(dict);
-        if (!e) {
-            os_semaphore_give(dict->lock);
-            return -1;
+    /* 三缓冲键：单写者，不加锁 */
+    obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+    if (e && e->mode == OBJ_DICT_MODE_TRIPLE) {
+        if (__triple_write(e, key, data, len, flags) != 0) return -1;
+        __set_notify(dict, key, data, len, flags);
+        return 0;
+    }
+
+    /* 快路径：键已存在、容量足够且缓冲未被借用，只独占该条目；
+     * 复查模式：期间槽位可能被清理后复用为三缓冲键，其value为三缓冲块，交给慢路径 */
+    if (e && len <= e->value_cap) {
+        uint32_t seq = __entry_lock(e);
+        if (atomic_load_explicit(&e->state, memory_order_relaxed) == OBJ_DICT_SLOT_USED && e->key == key &&
+            e->mode == OBJ_DICT_MODE_NORMAL && len <= e->value_cap && (len == 0 || !__value_pinned(e))) {
+            __entry_write(e, data, len, flags);
+            __entry_unlock(e, seq + 2U);
+            __set_notify(dict, key, data, len, flags);
+            return 0;
         }
-        e->key = key;
-        atomic_init(&e->version, 0);
-        atomic_init(&e->ref_count, 0);
+        __entry_unlock(e, seq);  /* 期间被清理、复用或借用，未修改 */
     }
 
-    /* 重分配缓冲 */
-    if (e->value && e->value_len != len) {
-        /* 释放旧内存 */
-#if OBJ_DICT_MEMPOOL_ENABLE
-        if (dict->mempool) {
-            obj_dict_mempool_free(dict->mempool, e->value);
-        } else {
-            os_free(e->value);
+    /* 慢路径：插入新键、扩容或换下被借用的缓冲 */
+    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
+
+    e = obj_dict_lookup(dict, key);
+    if ((!e && (flags & OBJ_DICT_FLAG_TRIPLE_BUFFER)) || (e && e->mode == OBJ_DICT_MODE_TRIPLE)) {
+        /* 首次写入选用三缓冲：槽位容量取本次长度；或期间已被注册为三缓冲键 */
+        if (!e && (len == 0 || !(e = __triple_insert(dict, key, len)))) {
+            os_semaphore_give(dict->lock);
+            return -1;
         }
-#else
-        os_free(e->value);
-#endif
-        e->value = NULL;
-        e->value_len = 0;
+        os_semaphore_give(dict->lock);
+        if (__triple_write(e, key, data, len, flags) != 0) return -1;
+        __set_notify(dict, key, data, len, flags);
+        return 0;
     }
-    if (len > 0) {
-        if (!e->value) {
-            /* 从内存池或系统堆分配 */
-#if OBJ_DICT_MEMPOOL_ENABLE
-            if (dict->mempool && len <= OBJ_DICT_MEMPOOL_BLOCK_SIZE) {
-                e->value = obj_dict_mempool_alloc(dict->mempool, len);
-                if (!e->value) {
-                    /* 内存池分配失败，回退到系统堆 */
-                    e->value = os_malloc(len);
-                }
-            } else {
-                e->value = os_malloc(len);
-            }
-#else
-            e->value = os_malloc(len);
-#endif
-            if (!e->value) {
+    void* buf = NULL;
+    size_t cap = 0;
+    uint32_t seq;
+    for (;;) {
+        if (!buf && len > 0 && (!e || len > e->value_cap || __value_pinned(e))) {
+            /* 换缓冲时保持原容量，容量只增不减 */
+            buf = __alloc_value(dict, (e && e->value_cap > len) ? e->value_cap : len, &cap);
+            if (!buf) {
                 os_semaphore_give(dict->lock);
                 return -1;
             }
         }
-        memcpy(e->value, data, len);
-        e->value_len = len;
-    } else {
-        /* 长度为0表示清空数据 */
-        if (e->value) {
-#if OBJ_DICT_MEMPOOL_ENABLE
-            if (dict->mempool) {
-                obj_dict_mempool_free(dict->mempool, e->value);
-            } else {
-                os_free(e->value);
+        if (!e) {
+            e = __find_free_slot(dict, key);
+            if (!e) {
+                __free_value(dict, buf);
+                os_semaphore_give(dict->lock);
+                return -1;
             }
-#else
-            os_free(e->value);
-#endif
-            e->value = NULL;
         }
-        e->value_len = 0;
+
+        seq = __entry_lock(e);
+        /* 分配期间缓冲可能刚被借用：放弃独占，换新缓冲后重试 */
+        if (buf || len == 0 || atomic_load_explicit(&e->state, memory_order_relaxed) != OBJ_DICT_SLOT_USED ||
+            !__value_pinned(e)) {
+            break;
+        }
+        __entry_unlock(e, seq);
+    }
+    if (atomic_load_explicit(&e->state, memory_order_relaxed) != OBJ_DICT_SLOT_USED) {
+        /* 空槽与墓碑的缓冲均已释放、引用计数为0；写入key后再发布槽位 */
+        e->key = key;
+        atomic_store_explicit(&e->state, OBJ_DICT_SLOT_USED, memory_order_release);
     }
+    void* old = NULL;
+    if (buf) {
+        /* 先换缓冲再改长度：读者先读长度后读指针，长度总不超过所读缓冲的容量 */
+        old = e->value;
+        e->value = buf;
+        e->value_cap = cap;
+        atomic_thread_fence(memory_order_release);
+    }
+    __entry_write(e, data, len, flags);
+    __entry_unlock(e, seq + 2U);
 
-    e->flags = flags;
-    e->timestamp_us = os_monotonic_time_get_microsecond();
-    /* 使用原子递增版本号，保证线程安全 */
-    atomic_fetch_add_explicit(&e->version, 1, memory_order_release);
+    __retire_value(dict, old);
+    os_semaphore_give(dict->lock);
+    __set_notify(dict, key, data, len, flags);
+    return 0;
+}
+
+/*
+ * @brief 读取条目的数据时间戳（不加锁）
+ * @details 普通键单次读取条目上的时间戳；三缓冲键在读区内读取最新槽位，条目上的时间戳不随写入更新
+ * @param dict 字典对象
+ * @param e    obj_dict_lookup返回的条目
+ * @return 微秒时间戳，条目正在被清理时返回条目上的旧值
+ */
+uint64_t obj_dict_entry_timestamp(obj_dict_t* dict, obj_dict_entry_t* e) {
+    if (!dict || !e) return 0;
+    if (e->mode != OBJ_DICT_MODE_TRIPLE) {
+        /* 对齐的64位时间戳单次读取；并发写入时至多读到前后两次写入之一，只影响时效判定 */
+        return *(volatile const uint64_t*)&e->timestamp_us;
+    }
+
+    obj_dict_reader_shard_t* shard = __reader_shard(dict);
+    uint32_t idx = __read_lock(dict, shard);
+    uint64_t ts = e->timestamp_us;
+    uint32_t seq = (uint32_t)atomic_load_explicit(&e->version, memory_order_acquire);
+    /* 序列号为偶数且槽位仍是三缓冲键时块在读区内不会被释放；奇数表示正在清理 */
+    if (!(seq & 1U) && atomic_load_explicit(&e->state, memory_order_acquire) == OBJ_DICT_SLOT_USED &&
+        e->mode == OBJ_DICT_MODE_TRIPLE) {
+        uint32_t ver;
+        __triple_latest((obj_dict_triple_t*)e->value, &ts, &ver);
+    }
+    __read_unlock(shard, idx);
+    return ts;
+}
+
+/*
+ * @brief 注册单写者三缓冲键
+ * @param dict 字典对象
+ * @param key  键值
+ * @param max_len 每次写入的最大长度（> 0）
+ * @return 0成功，-1失败（键已是普通键、容量不足、无空槽或分配失败）
+ */
+int obj_dict_register_triple(obj_dict_t* dict, obj_dict_key_t key, size_t max_len) {
+    if (!dict || max_len == 0) return -1;
+    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
+
+    int ret = 0;
+    obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+    if (e) {
+        /* 重复注册同一三缓冲键视为成功 */
+        if (e->mode != OBJ_DICT_MODE_TRIPLE || e->value_cap < max_len) ret = -1;
+    } else if (!__triple_insert(dict, key, max_len)) {
+        ret = -1;
+    }
+
+    os_semaphore_give(dict->lock);
+    return ret;
+}
+
+/*
+ * @brief 查询三缓冲键的写入统计（不加锁）
+ * @param dict 字典对象
+ * @param key  键值
+ * @param writes  若非NULL，返回成功写入次数（即最新版本号）
+ * @param dropped 若非NULL，返回三个槽位都被借用而丢弃的写入次数
+ * @return 0成功，-1键不存在或不是三缓冲键
+ */
+int obj_dict_triple_get_stats(obj_dict_t* dict, obj_dict_key_t key, uint32_t* writes, uint32_t* dropped) {
+    if (!dict) return -1;
+    obj_dict_reader_shard_t* shard = __reader_shard(dict);
+    uint32_t idx = __read_lock(dict, shard);
+    int ret = -1;
+
+    obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+    if (e && atomic_load_explicit(&e->state, memory_order_acquire) == OBJ_DICT_SLOT_USED && e->key == key &&
+        e->mode == OBJ_DICT_MODE_TRIPLE) {
+        obj_dict_triple_t* t = (obj_dict_triple_t*)e->value;
+        uint64_t ts;
+        uint32_t ver;
+        __triple_latest(t, &ts, &ver);
+        if (writes) *writes = ver;
+        if (dropped) *dropped = (uint32_t)atomic_load_explicit(&t->dropped, memory_order_relaxed);
+        ret = 0;
+    }
+
+    __read_unlock(shard, idx);
+    return ret;
+}
+
+#if OBJ_DICT_ENABLE_SET_HOOK
+/*
+ * @brief 设置写入钩子
+ * @param dict 字典对象
+ * @param hook 钩子函数（NULL表示移除）
+ * @param user_data 钩子的用户数据
+ * @return 0成功，-1失败
+ */
+int obj_dict_set_hook(obj_dict_t* dict, obj_dict_set_hook_t hook, void* user_data) {
+    if (!dict) return -1;
+    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
+
+    /* 新钩子写入当前未发布的槽位再整体发布，写入者不会看到钩子与用户数据错配 */
+    obj_dict_hook_t* cur = atomic_load_explicit(&dict->set_hook, memory_order_relaxed);
+    obj_dict_hook_t* next = NULL;
+    if (hook) {
+        next = (cur == &dict->hook_slots[0]) ? &dict->hook_slots[1] : &dict->hook_slots[0];
+        next->fn = hook;
+        next->user_data = user_data;
+    }
+    atomic_store_explicit(&dict->set_hook, next, memory_order_seq_cst);
+    /* 等待仍在调用旧钩子的写入者退出读区，之后旧槽位可复用、旧user_data可释放 */
+    __reader_sync(dict);
 
     os_semaphore_give(dict->lock);
     return 0;
 }
+#endif
+
+/*
+ * @brief 在读区内按seqlock读取条目，写入并发时重试
+ * @param dict 字典对象
+ * @param key  键值
+ * @param fn   数据访问函数（可为NULL）
+ * @param user_data 访问函数的用户数据
+ * @param ts_us 若非NULL，返回微秒时间戳
+ * @param version 若非NULL，返回版本号
+ * @param flags 若非NULL，返回标志位
+ * @return 1读到一致的数据，0键不存在
+ */
+static int __entry_read(obj_dict_t* dict, obj_dict_key_t key, obj_dict_peek_fn_t fn, void* user_data,
+                        uint64_t* ts_us, uint32_t* version, uint8_t* flags) {
+    obj_dict_reader_shard_t* shard = __reader_shard(dict);
+    uint32_t idx = __read_lock(dict, shard);
+    int found = 0;
+    uint32_t spins = 0;
+
+    for (;;) {
+        obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+        if (!e) break;
+        uint32_t seq = (uint32_t)atomic_load_explicit(&e->version, memory_order_acquire);
+        if (seq & 1U) {
+            __backoff(&spins);  /* 写入进行中 */
+            continue;
+        }
+
+        int owned = atomic_load_explicit(&e->state, memory_order_relaxed) == OBJ_DICT_SLOT_USED && e->key == key;
+        if (owned && e->mode == OBJ_DICT_MODE_TRIPLE) {
+            uint64_t ts;
+            uint32_t ver;
+            uint8_t fl;
+            int ok = __triple_read((obj_dict_triple_t*)e->value, fn, user_data, &ts, &ver, &fl);
+            atomic_thread_fence(memory_order_acquire);
+            if ((uint32_t)atomic_load_explicit(&e->version, memory_order_relaxed) != seq) continue;
+            if (!ok) {
+                __backoff(&spins);  /* 被写入者套圈 */
+                continue;
+            }
+            if (ts_us) *ts_us = ts;
+            if (version) *version = ver;
+            if (flags) *flags = fl;
+            found = 1;
+            break;
+        }
+        size_t len = e->value_len;
+        atomic_thread_fence(memory_order_acquire);
+        const void* value = e->value;
+        uint64_t ts = e->timestamp_us;
+        uint8_t fl = e->flags;
+        if (owned && fn) {
+            fn(value, len, user_data);
+        }
+
+        atomic_thread_fence(memory_order_acquire);
+        if ((uint32_t)atomic_load_explicit(&e->version, memory_order_relaxed) != seq) continue;
+        if (!owned) continue;  /* 槽位已被清理或复用，重新查找 */
+
+        if (ts_us) *ts_us = ts;
+        if (version) *version = seq >> 1;
+        if (flags) *flags = fl;
+        found = 1;
+        break;
+    }
+
+    __read_unlock(shard, idx);
+    return found;
+}
+
+/* obj_dict_get的拷贝目标 */
+typedef struct {
+    void*  out;
+    size_t out_cap;
+    size_t copied;
+} obj_dict_copy_ctx_t;
 
 /*
- * @brief 获取指定key对应的数据（拷贝读取）
+ * @brief 拷贝访问函数：把数据拷到调用者缓冲
+ * @param data 数据
+ * @param len  长度
+ * @param user_data obj_dict_copy_ctx_t
+ */
+static void __copy_visit(const void* data, size_t len, void* user_data) {
+    obj_dict_copy_ctx_t* ctx = (obj_dict_copy_ctx_t*)user_data;
+    size_t n = 0;
+    if (ctx->out && ctx->out_cap > 0 && data && len > 0) {
+        n = (len <= ctx->out_cap) ? len : ctx->out_cap;
+        memcpy(ctx->out, data, n);
+    }
+    ctx->copied = n;
+}
+
+/*
+ * @brief 获取指定key对应的数据（拷贝读取，不加锁）
  * @param dict 字典对象
  * @param key  键值
  * @param out  输出缓冲区指针（可为NULL表示仅查询元数据）
@@ -194,90 +951,179 @@ int obj_dict_set(obj_dict_t* dict, obj_dict_key_t key, const void* data, size_t
 ssize_t obj_dict_get(obj_dict_t* dict, obj_dict_key_t key, void* out, size_t out_cap,
                      uint64_t* ts_us, uint32_t* version, uint8_t* flags) {
     if (!dict) return -1;
-    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
+    obj_dict_copy_ctx_t ctx = { .out = out, .out_cap = out_cap, .copied = 0 };
+    if (!__entry_read(dict, key, __copy_visit, &ctx, ts_us, version, flags)) return -1;
+    return (ssize_t)ctx.copied;
+}
 
-    obj_dict_entry_t* e = __find_entry(dict, key);
-    if (!e) {
-        os_semaphore_give(dict->lock);
-        return -1;
-    }
-    size_t n = 0;
-    if (out && out_cap > 0 && e->value && e->value_len > 0) {
-        n = (e->value_len <= out_cap) ? e->value_len : out_cap;
-        memcpy(out, e->value, n);
+/*
+ * @brief 就地访问指定key对应的数据（不加锁、不拷贝）
+ * @param dict 字典对象
+ * @param key  键值
+ * @param fn   访问函数，在读区内调用，写入并发时可能被调用多次，以最后一次为准
+ * @param user_data 访问函数的用户数据
+ * @return 0成功，-1键不存在
+ */
+int obj_dict_peek(obj_dict_t* dict, obj_dict_key_t key, obj_dict_peek_fn_t fn, void* user_data) {
+    if (!dict || !fn) return -1;
+    return __entry_read(dict, key, fn, user_data, NULL, NULL, NULL) ? 0 : -1;
+}
+
+/*
+ * @brief 借用指定key对应的数据（零拷贝，不加锁）
+ * @details 在读区内读取缓冲指针并一次原子加钉住缓冲，复查序列号确认指针与元数据一致；
+ *          读区保证缓冲在加引用之前不会被释放，之后由引用保证
+ * @param dict 字典对象
+ * @param key  键值
+ * @param view 输出借用视图，成功时需以obj_dict_return归还
+ * @return 0成功，-1键不存在
+ */
+int obj_dict_borrow(obj_dict_t* dict, obj_dict_key_t key, obj_dict_view_t* view) {
+    if (!view) return -1;
+    memset(view, 0, sizeof(*view));
+    if (!dict) return -1;
+
+    obj_dict_reader_shard_t* shard = __reader_shard(dict);
+    uint32_t idx = __read_lock(dict, shard);
+    int found = 0;
+    uint32_t spins = 0;
+
+    for (;;) {
+        obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+        if (!e) break;
+        uint32_t seq = (uint32_t)atomic_load_explicit(&e->version, memory_order_acquire);
+        if (seq & 1U) {
+            __backoff(&spins);  /* 写入进行中 */
+            continue;
+        }
+
+        if (atomic_load_explicit(&e->state, memory_order_relaxed) != OBJ_DICT_SLOT_USED || e->key != key) {
+            continue;  /* 槽位正在被清理或复用，重新查找 */
+        }
+        size_t len;
+        const void* value;
+        uint64_t ts;
+        uint8_t fl;
+        uint32_t ver = seq >> 1;
+        obj_dict_triple_slot_t* slot = NULL;
+        uint32_t slot_seq = 0;
+        if (e->mode == OBJ_DICT_MODE_TRIPLE) {
+            /* 三缓冲键：钉住最新槽位，写入者随后只写其余槽位 */
+            obj_dict_triple_t* t = (obj_dict_triple_t*)e->value;
+            slot = &t->slots[atomic_load_explicit(&t->latest, memory_order_acquire)];
+            slot_seq = (uint32_t)atomic_load_explicit(&slot->seq, memory_order_acquire);
+            if (slot_seq & 1U) {
+                __backoff(&spins);  /* 被写入者套圈 */
+                continue;
+            }
+            len = slot->len;
+            value = (len > 0) ? slot->data : NULL;
+            ts = slot->timestamp_us;
+            fl = slot->flags;
+            ver = slot->version;
+        } else {
+            len = e->value_len;
+            atomic_thread_fence(memory_order_acquire);
+            value = (len > 0) ? e->value : NULL;
+            ts = e->timestamp_us;
+            fl = e->flags;
+        }
+        if (value) {
+            /* 与写入者的__value_pinned配对：先加引用再复查序列号 */
+            atomic_fetch_add_explicit(&OBJ_DICT_BUF_HDR(value)->pins, 1, memory_order_seq_cst);
+            atomic_thread_fence(memory_order_seq_cst);
+        } else {
+            atomic_thread_fence(memory_order_acquire);
+        }
+        /* 复查槽位状态与清理配对：清理先置墓碑再复查借用 */
+        if ((uint32_t)atomic_load_explicit(&e->version, memory_order_relaxed) != seq ||
+            (slot && ((uint32_t)atomic_load_explicit(&slot->seq, memory_order_relaxed) != slot_seq ||
+                      atomic_load_explicit(&e->state, memory_order_seq_cst) != OBJ_DICT_SLOT_USED))) {
+            if (value) __value_unpin(dict, value);  /* 条目仍持有引用，不会在此释放 */
+            continue;
+        }
+
+        view->dict = dict;
+        view->data = value;
+        view->len = len;
+        view->timestamp_us = ts;
+        view->version = ver;
+        view->flags = fl;
+        found = 1;
+        break;
     }
-    if (ts_us) *ts_us = e->timestamp_us;
-    /* 使用原子读取版本号，保证一致性 */
-    if (version) *version = atomic_load_explicit(&e->version, memory_order_acquire);
-    if (flags) *flags = e->flags;
 
-    os_semaphore_give(dict->lock);
-    return (ssize_t)n;
+    __read_unlock(shard, idx);
+    return found ? 0 : -1;
 }
 
 /*
- * @brief 迭代非空条目
+ * @brief 归还借用（不加锁）
+ * @param view obj_dict_borrow填写的视图，归还后清空
+ */
+void obj_dict_return(obj_dict_view_t* view) {
+    if (!view) return;
+    if (view->dict && view->data) {
+        __value_unpin(view->dict, view->data);
+    }
+    memset(view, 0, sizeof(*view));
+}
+
+/*
+ * @brief 迭代已占用的条目
  * @param dict 字典对象
  * @param next_from 上一次返回的索引（首次传-1）
- * @return 返回下一非空条目的索引，若无更多返回-1
+ * @return 返回下一已占用条目的索引，若无更多返回-1
  */
 int obj_dict_iterate(obj_dict_t* dict, int next_from) {
     if (!dict) return -1;
     int start = next_from + 1;
     if (start < 0) start = 0;
     for (int i = start; i < (int)dict->max_keys; ++i) {
-        if (dict->entries[i].value != NULL) return i;
+        if (atomic_load_explicit(&dict->entries[i].state, memory_order_acquire) == OBJ_DICT_SLOT_USED) return i;
     }
     return -1;
 }
 
 /*
- * @brief 增加引用计数（生命周期保护）
+ * @brief 增加引用计数（生命周期保护，不加锁）
  * @param dict 字典对象
  * @param key  键值
  * @return 0成功，-1失败（键不存在）
  */
 int obj_dict_retain(obj_dict_t* dict, obj_dict_key_t key) {
     if (!dict) return -1;
-    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
 
-    obj_dict_entry_t* e = __find_entry(dict, key);
-    if (!e) {
-        os_semaphore_give(dict->lock);
+    obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+    if (!e) return -1;
+
+    /* 先加引用再复查槽位；清理先置墓碑再复查引用，两者至少一方看到对方 */
+    atomic_fetch_add_explicit(&e->ref_count, 1, memory_order_seq_cst);
+    if (atomic_load_explicit(&e->state, memory_order_seq_cst) != OBJ_DICT_SLOT_USED || e->key != key) {
+        atomic_fetch_sub_explicit(&e->ref_count, 1, memory_order_release);
         return -1;
     }
-
-    /* 原子递增引用计数 */
-    atomic_fetch_add_explicit(&e->ref_count, 1, memory_order_acq_rel);
-
-    os_semaphore_give(dict->lock);
     return 0;
 }
 
 /*
- * @brief 减少引用计数（释放引用）
+ * @brief 减少引用计数（释放引用，不加锁）
  * @param dict 字典对象
  * @param key  键值
  * @return 0成功，-1失败（键不存在）
  */
 int obj_dict_release(obj_dict_t* dict, obj_dict_key_t key) {
     if (!dict) return -1;
-    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
 
-    obj_dict_entry_t* e = __find_entry(dict, key);
-    if (!e) {
-        os_semaphore_give(dict->lock);
-        return -1;
-    }
+    obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+    if (!e) return -1;
 
     /* 原子递减引用计数 */
     uint32_t old_count = atomic_fetch_sub_explicit(&e->ref_count, 1, memory_order_acq_rel);
-    
+
     /* 如果引用计数减到0，可以考虑清理（当前版本保留数据，由外部管理清理） */
     /* 注意：这里不自动清理，避免在回调期间数据被意外删除 */
     (void)old_count;
-
-    os_semaphore_give(dict->lock);
     return 0;
 }
 
@@ -289,16 +1135,9 @@ int obj_dict_release(obj_dict_t* dict, obj_dict_key_t key) {
  */
 int32_t obj_dict_get_ref_count(obj_dict_t* dict, obj_dict_key_t key) {
     if (!dict) return -1;
-    if (os_semaphore_take(dict->lock, 100) < 0) return -1;
-
-    obj_dict_entry_t* e = __find_entry(dict, key);
-    int32_t count = -1;
-    if (e) {
-        count = (int32_t)atomic_load_explicit(&e->ref_count, memory_order_acquire);
-    }
-
-    os_semaphore_give(dict->lock);
-    return count;
+    obj_dict_entry_t* e = obj_dict_lookup(dict, key);
+    if (!e) return -1;
+    return (int32_t)atomic_load_explicit(&e->ref_count, memory_order_acquire);
 }
 
 /*
@@ -316,35 +1155,55 @@ int obj_dict_cleanup_unused(obj_dict_t* dict, uint64_t timeout_us) {
 
     for (size_t i = 0; i < dict->max_keys; ++i) {
         obj_dict_entry_t* e = &dict->entries[i];
-        if (!e->value) continue;  /* 空槽跳过 */
+        if (atomic_load_explicit(&e->state, memory_order_relaxed) != OBJ_DICT_SLOT_USED) continue;  /* 空槽跳过 */
 
         /* 检查引用计数 */
         uint32_t ref_count = atomic_load_explicit(&e->ref_count, memory_order_acquire);
         if (ref_count > 0) continue;  /* 有引用，不清理 */
 
-        /* 检查时间戳 */
-        uint64_t elapsed_us = (now_us >= e->timestamp_us) ? (now_us - e->timestamp_us) : 0;
-        if (elapsed_us < timeout_us) continue;  /* 未超时，不清理 */
+        /* 独占条目后检查时间戳，期间的写入者已完成 */
+        uint32_t seq = __entry_lock(e);
+        /* 三缓冲键的时间戳只随槽位发布；持有字典锁时块不会被换下 */
+        uint64_t ts_us = e->timestamp_us;
+        if (e->mode == OBJ_DICT_MODE_TRIPLE) {
+            uint32_t ver;
+            __triple_latest((obj_dict_triple_t*)e->value, &ts_us, &ver);
+        }
+        uint64_t elapsed_us = (now_us >= ts_us) ? (now_us - ts_us) : 0;
+        if (elapsed_us < timeout_us) {
+            __entry_unlock(e, seq);  /* 未超时，不清理 */
+            continue;
+        }
 
-        /* 清理数据 */
-        if (e->value) {
-#if OBJ_DICT_MEMPOOL_ENABLE
-            if (dict->mempool) {
-                obj_dict_mempool_free(dict->mempool, e->value);
-            } else {
-                os_free(e->value);
-            }
-#else
-            os_free(e->value);
-#endif
+        /* 槽位先留墓碑以保持其他键的探测链；置墓碑后复查引用，与obj_dict_retain配对；
+         * 三缓冲块整体释放，置墓碑后复查写入标志与三缓冲写入者配对，写入进行中或槽位被借用时不清理 */
+        int triple = (e->mode == OBJ_DICT_MODE_TRIPLE);
+        atomic_store_explicit(&e->state, OBJ_DICT_SLOT_DELETED, memory_order_seq_cst);
+        if (atomic_load_explicit(&e->ref_count, memory_order_seq_cst) != 0 ||
+            (triple && (atomic_load_explicit(&e->writer, memory_order_seq_cst) != 0 ||
+                        __triple_pinned((const obj_dict_triple_t*)e->value)))) {
+            atomic_store_explicit(&e->state, OBJ_DICT_SLOT_USED, memory_order_release);
+            __entry_unlock(e, seq);
+            continue;
+        }
+        void* old = e->value;
+        e->value_len = 0;
+        e->value_cap = 0;
+        e->key = 0;
+        e->mode = OBJ_DICT_MODE_NORMAL;
+        __entry_unlock(e, seq + 2U);
+
+        /* 被借用的缓冲随最后一次归还释放，清理不必等待借用者；
+         * 三缓冲块同样挂入待回收链表，写入者与读者退出读区后释放 */
+        if (old) {
+            __retire_value(dict, old);
             e->value = NULL;
-            e->value_len = 0;
-            e->key = 0;
-            atomic_store_explicit(&e->version, 0, memory_order_release);
-            atomic_store_explicit(&e->ref_count, 0, memory_order_release);
-            cleaned_count++;
         }
+        __settle_tombstones(dict, i);
+        cleaned_count++;
     }
+    /* 顺带回收之前换下、当时读者尚未退出的缓冲 */
+    __reclaim_values(dict);
 
     os_semaphore_give(dict->lock);
     return cleaned_count;
@@ -363,7 +1222,7 @@ int obj_dict_get_all_ref_counts(obj_dict_t* dict, int32_t* ref_counts, size_t ma
 
     size_t count = (max_count < dict->max_keys) ? max_count : dict->max_keys;
     for (size_t i = 0; i < count; ++i) {
-        if (dict->entries[i].value) {
+        if (atomic_load_explicit(&dict->entries[i].state, memory_order_acquire) == OBJ_DICT_SLOT_USED) {
             ref_counts[i] = (int32_t)atomic_load_explicit(&dict->entries[i].ref_count, memory_order_acquire);
         } else {
             ref_counts[i] = -1;  /* 空槽标记为-1 */
@@ -373,5 +1232,3 @@ int obj_dict_get_all_ref_counts(obj_dict_t* dict, int32_t* ref_counts, size_t ma
     os_semaphore_give(dict->lock);
     return (int)count;
 }
-
-
@@ -15,25 +15,103 @@ extern "C" {
 
 typedef uint16_t obj_dict_key_t; /* 与vfb_event_t一致 */
 
+/*
+ * 条目数组即开放寻址表：键经Fibonacci散列映射到起始槽位，线性探测；
+ * 槽位占用由state标记，与value是否为NULL无关（长度为0的值同样可查到），
+ * 清理后的槽位留下墓碑，探测越过墓碑继续，插入时复用；
+ * 查找的探测长度以插入时记录的最长探测距离为上限，表满时查不存在的键也不必走完整个数组
+ */
+#define OBJ_DICT_SLOT_EMPTY   0U  /* 从未占用：探测到即说明键不存在 */
+#define OBJ_DICT_SLOT_USED    1U  /* 已占用 */
+#define OBJ_DICT_SLOT_DELETED 2U  /* 墓碑：已清理，探测继续，可被插入复用 */
+
+/*
+ * 单写者三缓冲模式：为只有一个生产者（ADC任务、编码器ISR等）的键预分配三个槽位，
+ *   写入者写入既非最新也未被借用的槽位，写完原子切换"最新"下标，不加锁、不分配内存、不阻塞；
+ *   读者读取最新槽位并以槽位序列号复核，只有被写入者连续套圈时才重试；
+ *   首次写入时flags带OBJ_DICT_FLAG_TRIPLE_BUFFER，或预先调用obj_dict_register_triple选用，
+ *   之后长度不能超过首次写入（或注册）时的长度；同一键的并发写入返回-1
+ */
+#define OBJ_DICT_MODE_NORMAL  0U  /* 普通条目：seqlock写入 */
+#define OBJ_DICT_MODE_TRIPLE  1U  /* 单写者三缓冲条目 */
+
+#define OBJ_DICT_FLAG_TRIPLE_BUFFER 0x80U  /* flags位：首次写入时选用三缓冲模式 */
+
+/*
+ * 读写并发：每个条目的version同时是seqlock序列号，写入期间为奇数，每次写入加2；
+ *   读者不加锁：读序列号（偶数）→ 读数据 → 复查序列号，不一致时重试；
+ *   写入者以CAS把序列号由偶数置为奇数独占条目，不同键的写入互不阻塞；
+ *   插入新键、扩容与清理另持dict->lock。数据缓冲只增不减，长度不超过容量的写入原地覆盖；
+ *   扩容或清理换下的旧缓冲等到所有读者退出读区后才释放
+ *
+ * 零拷贝借用：每个数据缓冲前有一个引用计数（条目本身持有1），obj_dict_borrow在读区内
+ *   一次原子加把当前缓冲钉住，返回只读指针；写入者发现缓冲被钉住时换到新缓冲写入，
+ *   不覆盖被借用的数据，换下的缓冲在最后一个obj_dict_return时释放
+ */
+
 typedef struct {
     obj_dict_key_t key;          /* 键(ID) */
     void*          value;        /* 数据缓冲 */
     size_t         value_len;    /* 数据长度 */
+    size_t         value_cap;    /* 数据缓冲容量（只增不减） */
     uint64_t       timestamp_us; /* 时间戳(微秒) */
-    atomic_uint_fast32_t version; /* 版本号（C11原子操作） */
+    atomic_uint_fast32_t version; /* seqlock序列号：写入期间为奇数，对外版本号为其一半 */
     atomic_uint_fast32_t ref_count; /* 引用计数（C11原子操作，用于生命周期管理） */
     uint8_t        flags;        /* 标志 */
+    uint8_t        mode;         /* 条目模式（OBJ_DICT_MODE_*，置USED前确定，清理时复位） */
+    atomic_uint_fast8_t state;   /* 槽位状态（OBJ_DICT_SLOT_*，写入key后再置USED） */
+    atomic_uint_fast8_t writer;  /* 三缓冲写入进行中（单写者约定的检查，清理置墓碑后复查） */
 } obj_dict_entry_t;
 
+/* 读者分片：按纪元奇偶计数的活跃读者，填充到独占缓存行 */
+typedef struct {
+    atomic_uint_fast32_t count[2];
+    uint8_t pad[OBJ_DICT_CACHE_LINE_SIZE - 2 * sizeof(atomic_uint_fast32_t)];
+} obj_dict_reader_shard_t;
+
+/* 无锁读取的访问函数：在读区内以一致的数据调用，写入并发时可能被调用多次，只应产生可覆盖的输出 */
+typedef void (*obj_dict_peek_fn_t)(const void* data, size_t len, void* user_data);
+
+#if OBJ_DICT_ENABLE_SET_HOOK
+/* 写入钩子：写入完成、解除条目独占后在读区内调用，data为调用者传入obj_dict_set的数据；
+ * 同一键的并发写入到达钩子的顺序不保证与版本号一致；钩子内不能写入对象字典 */
+typedef void (*obj_dict_set_hook_t)(obj_dict_key_t key, const void* data, size_t len, uint8_t flags,
+                                    void* user_data);
+
+/* 钩子与用户数据成对发布，写入者一次原子加载取得 */
+typedef struct {
+    obj_dict_set_hook_t fn;      /* 钩子函数 */
+    void*               user_data; /* 钩子的用户数据 */
+} obj_dict_hook_t;
+#endif
+
 typedef struct {
     obj_dict_entry_t* entries;   /* 条目数组 */
     size_t            max_keys;  /* 最大键数量 */
-    OsSemaphore_t*    lock;      /* 线程安全 */
+    size_t            max_probe; /* 已插入键的最长探测距离，查找最多探测max_probe+1个槽位 */
+    OsSemaphore_t*    lock;      /* 插入新键、扩容与清理互斥（已有键的写入只锁条目） */
+    atomic_uint_fast32_t read_epoch; /* 读者纪元（释放旧缓冲前推进） */
+    obj_dict_reader_shard_t readers[OBJ_DICT_READER_SHARDS]; /* 读者分片 */
+    struct obj_dict_buf_hdr* retired; /* 换下待回收的缓冲（持dict->lock访问，读者退出后释放） */
 #if OBJ_DICT_MEMPOOL_ENABLE
     obj_dict_mempool_t* mempool; /* 内存池（可选，用于预分配数据缓冲） */
 #endif
+#if OBJ_DICT_ENABLE_SET_HOOK
+    _Atomic(obj_dict_hook_t*) set_hook; /* 当前写入钩子（NULL表示无），指向hook_slots之一 */
+    obj_dict_hook_t   hook_slots[2]; /* 交替使用：更换时写入另一个，等待读区退出后旧的才可复用 */
+#endif
 } obj_dict_t;
 
+/* 借用视图：obj_dict_borrow填写，obj_dict_return归还前data一直有效且内容不变 */
+typedef struct {
+    obj_dict_t*    dict;         /* 所属字典 */
+    const void*    data;         /* 数据（长度为0时为NULL） */
+    size_t         len;          /* 数据长度 */
+    uint64_t       timestamp_us; /* 时间戳(微秒) */
+    uint32_t       version;      /* 版本号 */
+    uint8_t        flags;        /* 标志 */
+} obj_dict_view_t;
+
 /* 初始化对象字典：由调用者提供条目数组及容量 */
 int obj_dict_init(obj_dict_t* dict, obj_dict_entry_t* entry_array, size_t max_keys);
 
@@ -41,21 +119,51 @@ int obj_dict_init(obj_dict_t* dict, obj_dict_entry_t* entry_array, size_t max_ke
 int obj_dict_init_with_mempool(obj_dict_t* dict, obj_dict_entry_t* entry_array, size_t max_keys,
                                 size_t mempool_block_size, size_t mempool_block_count);
 
-/* 设置键的值(拷贝写入)：若键不存在则占用空槽；返回0成功 */
+/* 设置键的值(拷贝写入)：若键不存在则占用空槽；已有键且长度不超过容量时只锁条目，三缓冲键不加锁；返回0成功 */
 int obj_dict_set(obj_dict_t* dict, obj_dict_key_t key, const void* data, size_t len, uint8_t flags);
 
-/* 获取键的值(拷贝读取)：返回写入字节数，<0失败；可返回时间戳与版本 */
+/* 注册单写者三缓冲键：预分配三个max_len字节的槽位，键已存在时返回-1（已是容量足够的三缓冲键除外）；返回0成功 */
+int obj_dict_register_triple(obj_dict_t* dict, obj_dict_key_t key, size_t max_len);
+
+/* 查询三缓冲键的写入统计：writes为成功写入次数，dropped为三个槽位都被借用而丢弃的写入次数；返回0成功 */
+int obj_dict_triple_get_stats(obj_dict_t* dict, obj_dict_key_t key, uint32_t* writes, uint32_t* dropped);
+
+#if OBJ_DICT_ENABLE_SET_HOOK
+/* 设置写入钩子：之后每次obj_dict_set成功时回调，hook为NULL表示移除；
+ * 返回前等待仍在执行旧钩子的写入者退出，返回后旧的user_data可以释放；不能在钩子内调用；返回0成功 */
+int obj_dict_set_hook(obj_dict_t* dict, obj_dict_set_hook_t hook, void* user_data);
+#endif
+
+/* 查找键所在的条目（开放寻址，不加锁）：持有dict->lock时结果稳定；
+ * 不持锁时只能作为提示，使用前需重新确认state与key（topic_bus的发布路径即如此） */
+obj_dict_entry_t* obj_dict_lookup(obj_dict_t* dict, obj_dict_key_t key);
+
+/* 读取条目的数据时间戳（不加锁）：普通键读条目上的时间戳，三缓冲键读最新槽位；并发写入时只作时效判定参考 */
+uint64_t obj_dict_entry_timestamp(obj_dict_t* dict, obj_dict_entry_t* e);
+
+/* 获取键的值(拷贝读取，seqlock无锁)：返回写入字节数，<0失败；可返回时间戳与版本 */
 ssize_t obj_dict_get(obj_dict_t* dict, obj_dict_key_t key, void* out, size_t out_cap,
                      uint64_t* ts_us, uint32_t* version, uint8_t* flags);
 
-/* 简易遍历：返回第一个非空条目索引，之后传入next_from继续 */
+/* 就地访问键的值(seqlock无锁，不拷贝)：fn在读区内调用，返回0成功，-1键不存在；
+ * fn内可以调用obj_dict_set等不等待读者的接口，不能调用obj_dict_set_hook（它等待读区内的读者退出） */
+int obj_dict_peek(obj_dict_t* dict, obj_dict_key_t key, obj_dict_peek_fn_t fn, void* user_data);
+
+/* 借用键的值(零拷贝，无锁)：钉住当前数据缓冲并填写view，之后的写入换到新缓冲；
+ * 用完必须调用obj_dict_return；返回0成功，-1键不存在 */
+int obj_dict_borrow(obj_dict_t* dict, obj_dict_key_t key, obj_dict_view_t* view);
+
+/* 归还借用：释放缓冲的引用并清空view，换下的缓冲在最后一次归还时释放（无锁） */
+void obj_dict_return(obj_dict_view_t* view);
+
+/* 简易遍历：返回第一个已占用条目索引（含长度为0的值），之后传入next_from继续 */
 int obj_dict_iterate(obj_dict_t* dict, int next_from /* -1开始 */);
 
 /* 引用计数管理（生命周期保护） */
-/* 增加引用计数：确保数据在回调期间有效 */
+/* 增加引用计数：确保数据在回调期间不被清理（无锁） */
 int obj_dict_retain(obj_dict_t* dict, obj_dict_key_t key);
 
-/* 减少引用计数：释放引用，当引用计数为0且数据已更新时可能被清理 */
+/* 减少引用计数：释放引用，当引用计数为0且数据已更新时可能被清理（无锁） */
 int obj_dict_release(obj_dict_t* dict, obj_dict_key_t key);
 
 /* 获取引用计数（调试用） */
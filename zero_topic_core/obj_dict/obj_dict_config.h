@@ -21,6 +21,11 @@
 #define OBJ_DICT_MEMPOOL_ENABLE_STATS 1
 #endif
 
+/* 释放内存池块时是否清零（仅调试用，耗时与块大小成正比，ISR中释放时不宜开启） */
+#ifndef OBJ_DICT_MEMPOOL_SCRUB
+#define OBJ_DICT_MEMPOOL_SCRUB 0
+#endif
+
 /* 是否启用引用计数（生命周期管理） */
 #ifndef OBJ_DICT_ENABLE_REF_COUNT
 #define OBJ_DICT_ENABLE_REF_COUNT 1
@@ -36,5 +41,42 @@
 #define OBJ_DICT_DEFAULT_CLEANUP_TIMEOUT_US (60 * 1000 * 1000)  /* 60秒 */
 #endif
 
+/* 是否支持写入钩子（每次obj_dict_set成功后回调，用于流量录制等） */
+#ifndef OBJ_DICT_ENABLE_SET_HOOK
+#define OBJ_DICT_ENABLE_SET_HOOK 1
+#endif
+
+/* 读者分片数：每个线程固定落在一个分片上登记进入/退出读区，写入者回收缓冲时等待分片清空；
+ * 不小于并发读者线程数时读者之间没有共享的写入。默认仅Linux为16；其他平台默认1，
+ * 不使用线程局部存储（RTOS下TLS通常不按任务区分，且每个obj_dict_t可省约1KB） */
+#ifndef OBJ_DICT_READER_SHARDS
+#if defined(__linux__)
+#define OBJ_DICT_READER_SHARDS 16
+#else
+#define OBJ_DICT_READER_SHARDS 1
+#endif
+#endif
+
+/* 缓存行大小（读者分片按此填充，避免伪共享） */
+#ifndef OBJ_DICT_CACHE_LINE_SIZE
+#define OBJ_DICT_CACHE_LINE_SIZE 64
+#endif
+
+/* 等待同一条目的写入完成时先自旋的次数，超过后休眠（单核平台可设为1） */
+#ifndef OBJ_DICT_SPIN_LIMIT
+#define OBJ_DICT_SPIN_LIMIT 64
+#endif
+
+/* 自旋超限后的休眠时长（毫秒，至少为1）：必须真正阻塞至少一个节拍，
+   被抢占的低优先级写入者/读者才能运行；只让出CPU(0)在RTOS上不会调度低优先级任务 */
+#ifndef OBJ_DICT_BACKOFF_SLEEP_MS
+#define OBJ_DICT_BACKOFF_SLEEP_MS 1
+#endif
+
+/* 线程局部存储修饰符（OBJ_DICT_READER_SHARDS大于1时记录线程所在的读者分片；平台不支持时需提供等价实现） */
+#ifndef OBJ_DICT_TLS
+#define OBJ_DICT_TLS _Thread_local
+#endif
+
 #endif /* OBJ_DICT_CONFIG_H_ */
 
@@ -1,81 +1,104 @@
 #include "obj_dict_mempool.h"
 #include "../../Rte/inc/os_heap.h"
-#include "../../Rte/inc/os_semaphore.h"
 #include <string.h>
 #include <stdatomic.h>
 
 #if OBJ_DICT_MEMPOOL_ENABLE
 
-/* 内存池块结构 */
-typedef struct {
-    void* ptr;          /* 内存块指针 */
-    uint8_t in_use;     /* 是否使用中（简化实现，原子操作） */
-} mempool_block_t;
+/*
+ * 空闲链表：以块下标串起的Treiber栈，不加锁，可在ISR中调用
+ *   栈顶head为32位：低16位是栈顶块下标（MEMPOOL_NIL表示空），高16位是ABA标签，
+ *   每次成功CAS加1，防止"弹出A→A被分配释放后又回到栈顶"时旧的next被误用；
+ *   只用32位CAS，Cortex-M等32位MCU上同样无锁（64位原子在这些平台上可能退化为加锁实现）
+ *   释放时由地址直接算出块下标，不再扫描块数组
+ */
+#define MEMPOOL_NIL        0xFFFFU  /* 空下标 */
+#define MEMPOOL_MAX_BLOCKS 0xFFFFU  /* 块下标占16位，MEMPOOL_NIL保留 */
+#define MEMPOOL_ALIGN      8U       /* 块起始地址对齐 */
 
 /* 内存池结构 */
 struct obj_dict_mempool {
-    mempool_block_t* blocks;    /* 块数组 */
-    size_t block_size;          /* 每个块大小 */
-    size_t block_count;         /* 块数量 */
-    void* buffer;               /* 预分配的内存缓冲区 */
-    OsSemaphore_t* lock;        /* 线程安全锁 */
+    uint8_t* buffer;                /* 预分配的内存缓冲区 */
+    size_t block_size;              /* 每个块可用大小 */
+    size_t block_stride;            /* 相邻块间距（block_size按MEMPOOL_ALIGN向上取整） */
+    size_t block_count;             /* 块数量 */
+    atomic_uint_fast16_t* next;     /* 空闲链表：next[i]为i之后的空闲块下标 */
+    atomic_uint_fast8_t* in_use;    /* 块是否已分配（用于忽略重复释放） */
+    atomic_uint_fast32_t head;      /* 栈顶：ABA标签<<16 | 块下标 */
 #if OBJ_DICT_MEMPOOL_ENABLE_STATS
-    atomic_size_t used_count;   /* 已使用块数（原子操作） */
+    atomic_size_t used_count;       /* 已使用块数（统计直接读取，不扫描块） */
 #endif
 };
 
+/* ==================== 内部函数声明 ==================== */
+
+static uint32_t __head_pack(uint32_t tag, uint32_t index);
+static int __block_index(obj_dict_mempool_t* pool, const void* ptr, uint32_t* index);
+
+/* ==================== 函数实现 ==================== */
+
+/*
+ * @brief 组合栈顶值
+ * @param tag ABA标签（取低16位）
+ * @param index 栈顶块下标
+ * @return 栈顶值
+ */
+static uint32_t __head_pack(uint32_t tag, uint32_t index) {
+    return ((tag & 0xFFFFU) << 16) | (index & 0xFFFFU);
+}
+
+/*
+ * @brief 由地址计算块下标
+ * @param pool 内存池句柄
+ * @param ptr 内存指针
+ * @param index 输出块下标
+ * @return 0成功，-1不属于本池或不在块起始处
+ */
+static int __block_index(obj_dict_mempool_t* pool, const void* ptr, uint32_t* index) {
+    uintptr_t base = (uintptr_t)pool->buffer;
+    uintptr_t addr = (uintptr_t)ptr;
+    if (addr < base) return -1;
+    uintptr_t offset = addr - base;
+    if (offset >= pool->block_stride * pool->block_count || offset % pool->block_stride != 0) return -1;
+    *index = (uint32_t)(offset / pool->block_stride);
+    return 0;
+}
+
 /*
  * @brief 创建内存池
  */
 obj_dict_mempool_t* obj_dict_mempool_create(size_t block_size, size_t block_count) {
-    if (block_size == 0 || block_count == 0) return NULL;
+    if (block_size == 0 || block_count == 0 || block_count > MEMPOOL_MAX_BLOCKS) return NULL;
 
     obj_dict_mempool_t* pool = (obj_dict_mempool_t*)os_malloc(sizeof(obj_dict_mempool_t));
     if (!pool) return NULL;
     memset(pool, 0, sizeof(obj_dict_mempool_t));
 
     pool->block_size = block_size;
+    pool->block_stride = (block_size + MEMPOOL_ALIGN - 1U) & ~(size_t)(MEMPOOL_ALIGN - 1U);
     pool->block_count = block_count;
 
-    /* 分配块数组 */
-    pool->blocks = (mempool_block_t*)os_malloc(sizeof(mempool_block_t) * block_count);
-    if (!pool->blocks) {
-        os_free(pool);
-        return NULL;
-    }
-    memset(pool->blocks, 0, sizeof(mempool_block_t) * block_count);
-
+    /* 分配空闲链表与占用标记 */
+    pool->next = (atomic_uint_fast16_t*)os_malloc(sizeof(atomic_uint_fast16_t) * block_count);
+    pool->in_use = (atomic_uint_fast8_t*)os_malloc(sizeof(atomic_uint_fast8_t) * block_count);
     /* 预分配内存缓冲区 */
-    pool->buffer = os_malloc(block_size * block_count);
-    if (!pool->buffer) {
-        os_free(pool->blocks);
-        os_free(pool);
+    pool->buffer = (uint8_t*)os_malloc(pool->block_stride * block_count);
+    if (!pool->next || !pool->in_use || !pool->buffer) {
+        obj_dict_mempool_destroy(pool);
         return NULL;
     }
-    memset(pool->buffer, 0, block_size * block_count);
+    memset(pool->buffer, 0, pool->block_stride * block_count);
 
-    /* 初始化块数组，将内存分段分配给各个块 */
-    uint8_t* buf_ptr = (uint8_t*)pool->buffer;
+    /* 初始时所有块按下标顺序入栈：0在栈顶 */
     for (size_t i = 0; i < block_count; ++i) {
-        pool->blocks[i].ptr = buf_ptr + i * block_size;
-        pool->blocks[i].in_use = 0;
+        atomic_init(&pool->next[i], (i + 1 < block_count) ? (uint_fast16_t)(i + 1) : (uint_fast16_t)MEMPOOL_NIL);
+        atomic_init(&pool->in_use[i], 0);
     }
-
+    atomic_init(&pool->head, __head_pack(0, 0));
 #if OBJ_DICT_MEMPOOL_ENABLE_STATS
     atomic_init(&pool->used_count, 0);
 #endif
 
-    /* 创建锁（互斥锁初始值为1） */
-    pool->lock = os_semaphore_create(1, "obj_dict_mempool_lock");
-    if (!pool->lock) {
-        os_free(pool->buffer);
-        os_free(pool->blocks);
-        os_free(pool);
-        return NULL;
-    }
-    /* 初始化互斥锁为可用状态 */
-    os_semaphore_give(pool->lock);
-
     return pool;
 }
 
@@ -85,91 +108,103 @@ obj_dict_mempool_t* obj_dict_mempool_create(size_t block_size, size_t block_coun
 void obj_dict_mempool_destroy(obj_dict_mempool_t* pool) {
     if (!pool) return;
 
-    if (pool->lock) {
-        os_semaphore_destroy(pool->lock);
-    }
     if (pool->buffer) {
         os_free(pool->buffer);
     }
-    if (pool->blocks) {
-        os_free(pool->blocks);
+    if (pool->in_use) {
+        os_free(pool->in_use);
+    }
+    if (pool->next) {
+        os_free(pool->next);
     }
     os_free(pool);
 }
 
 /*
- * @brief 从内存池分配内存
+ * @brief 从内存池分配内存（无锁，O(1)，可在ISR中调用）
  */
 void* obj_dict_mempool_alloc(obj_dict_mempool_t* pool, size_t size) {
     if (!pool || size == 0 || size > pool->block_size) return NULL;
-    if (os_semaphore_take(pool->lock, 100) < 0) return NULL;
 
-    /* 查找空闲块 */
-    for (size_t i = 0; i < pool->block_count; ++i) {
-        if (!pool->blocks[i].in_use) {
-            pool->blocks[i].in_use = 1;
+    uint_fast32_t head = atomic_load_explicit(&pool->head, memory_order_acquire);
+    for (;;) {
+        uint32_t index = (uint32_t)(head & 0xFFFFU);
+        if (index == MEMPOOL_NIL) {
+            return NULL;  /* 内存池已满 */
+        }
+        /* next可能已被并发的分配释放改写，此时标签也已变化，下面的CAS必然失败 */
+        uint32_t next = (uint32_t)atomic_load_explicit(&pool->next[index], memory_order_relaxed);
+        if (atomic_compare_exchange_weak_explicit(&pool->head, &head,
+                                                  __head_pack((uint32_t)(head >> 16) + 1U, next),
+                                                  memory_order_acquire, memory_order_acquire)) {
+            atomic_store_explicit(&pool->in_use[index], 1, memory_order_relaxed);
 #if OBJ_DICT_MEMPOOL_ENABLE_STATS
             atomic_fetch_add_explicit(&pool->used_count, 1, memory_order_relaxed);
 #endif
-            os_semaphore_give(pool->lock);
-            return pool->blocks[i].ptr;
+            return pool->buffer + (size_t)index * pool->block_stride;
         }
     }
-
-    os_semaphore_give(pool->lock);
-    return NULL;  /* 内存池已满 */
 }
 
 /*
- * @brief 释放内存到内存池
+ * @brief 释放内存到内存池（无锁，O(1)，可在ISR中调用）
  */
 void obj_dict_mempool_free(obj_dict_mempool_t* pool, void* ptr) {
     if (!pool || !ptr) return;
-    if (os_semaphore_take(pool->lock, 100) < 0) return;
-
-    /* 查找对应的块 */
-    for (size_t i = 0; i < pool->block_count; ++i) {
-        if (pool->blocks[i].ptr == ptr) {
-            if (pool->blocks[i].in_use) {
-                pool->blocks[i].in_use = 0;
-                /* 清零内存（可选，用于调试） */
-                memset(ptr, 0, pool->block_size);
+
+    /* 由地址算出块下标：不属于本池或不在块起始处的指针忽略 */
+    uint32_t index;
+    if (__block_index(pool, ptr, &index) != 0) return;
+
+    /* 重复释放忽略：只有把占用标记由1改为0的一方才归还块 */
+    if (atomic_exchange_explicit(&pool->in_use[index], 0, memory_order_relaxed) == 0) {
+        return;
+    }
+#if OBJ_DICT_MEMPOOL_SCRUB
+    /* 清零内存（仅调试用：耗时与块大小成正比） */
+    memset(ptr, 0, pool->block_size);
+#endif
 #if OBJ_DICT_MEMPOOL_ENABLE_STATS
-                atomic_fetch_sub_explicit(&pool->used_count, 1, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&pool->used_count, 1, memory_order_relaxed);
 #endif
-            }
-            break;
-        }
-    }
 
-    os_semaphore_give(pool->lock);
+    uint_fast32_t head = atomic_load_explicit(&pool->head, memory_order_relaxed);
+    do {
+        atomic_store_explicit(&pool->next[index], (uint_fast16_t)(head & 0xFFFFU), memory_order_relaxed);
+    } while (!atomic_compare_exchange_weak_explicit(&pool->head, &head,
+                                                    __head_pack((uint32_t)(head >> 16) + 1U, index),
+                                                    memory_order_release, memory_order_relaxed));
 }
 
 /*
- * @brief 获取内存池统计信息
+ * @brief 判断指针是否为本池分配的块
  */
-int obj_dict_mempool_get_stats(obj_dict_mempool_t* pool, 
-                                size_t* total_blocks, 
-                                size_t* free_blocks, 
+int obj_dict_mempool_owns(obj_dict_mempool_t* pool, const void* ptr) {
+    uint32_t index;
+    if (!pool || !ptr) return 0;
+    return __block_index(pool, ptr, &index) == 0;
+}
+
+/*
+ * @brief 获取内存池统计信息（读取计数器，不扫描块）
+ */
+int obj_dict_mempool_get_stats(obj_dict_mempool_t* pool,
+                                size_t* total_blocks,
+                                size_t* free_blocks,
                                 size_t* used_blocks) {
     if (!pool) return -1;
-    if (os_semaphore_take(pool->lock, 100) < 0) return -1;
 
     if (total_blocks) *total_blocks = pool->block_count;
-
-    size_t used = 0;
-    for (size_t i = 0; i < pool->block_count; ++i) {
-        if (pool->blocks[i].in_use) {
-            used++;
-        }
-    }
-
+#if OBJ_DICT_MEMPOOL_ENABLE_STATS
+    size_t used = atomic_load_explicit(&pool->used_count, memory_order_relaxed);
     if (free_blocks) *free_blocks = pool->block_count - used;
     if (used_blocks) *used_blocks = used;
+#else
+    /* 未启用统计：不维护计数器，只能给出总块数 */
+    if (free_blocks || used_blocks) return -1;
+#endif
 
-    os_semaphore_give(pool->lock);
     return 0;
 }
 
 #endif /* OBJ_DICT_MEMPOOL_ENABLE */
-
@@ -30,7 +30,7 @@ obj_dict_mempool_t* obj_dict_mempool_create(size_t block_size, size_t block_coun
 void obj_dict_mempool_destroy(obj_dict_mempool_t* pool);
 
 /*
- * @brief 从内存池分配内存
+ * @brief 从内存池分配内存（无锁，可在ISR中调用）
  * @param pool 内存池句柄
  * @param size 需要的大小（如果大于块大小，返回NULL）
  * @return 分配的内存指针，失败返回NULL
@@ -38,12 +38,20 @@ void obj_dict_mempool_destroy(obj_dict_mempool_t* pool);
 void* obj_dict_mempool_alloc(obj_dict_mempool_t* pool, size_t size);
 
 /*
- * @brief 释放内存到内存池
+ * @brief 释放内存到内存池（无锁，可在ISR中调用；不属于本池的指针与重复释放被忽略）
  * @param pool 内存池句柄
  * @param ptr 内存指针
  */
 void obj_dict_mempool_free(obj_dict_mempool_t* pool, void* ptr);
 
+/*
+ * @brief 判断指针是否为本池分配的块（按地址计算，O(1)）
+ * @param pool 内存池句柄
+ * @param ptr 内存指针
+ * @return 1属于本池，0不属于
+ */
+int obj_dict_mempool_owns(obj_dict_mempool_t* pool, const void* ptr);
+
 /*
  * @brief 获取内存池统计信息
  * @param pool 内存池句柄
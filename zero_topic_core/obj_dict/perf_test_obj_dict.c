@@ -14,6 +14,25 @@
 #define PERF_TEST_LOOPS_SINGLE    100000
 #define PERF_TEST_LOOPS_THREAD    100000
 #define PERF_TEST_THREAD_COUNT    4
+#define PERF_TEST_LOOKUP_KEYS     1536  /* 容量2048，装载率75% */
+#define PERF_TEST_LOOKUP_SLOTS    2048
+#define PERF_TEST_LOOKUP_LOOPS    200000
+#define PERF_TEST_SCALE_KEYS      50    /* 控制周期每轮读取的键数 */
+#define PERF_TEST_SCALE_READERS   16
+#define PERF_TEST_SCALE_RUN_MS    100
+#define PERF_TEST_FRAME_SIZE      16384 /* 借用测试的大帧 */
+#define PERF_TEST_FRAME_LOOPS     20000
+#define PERF_TEST_BORROW_READERS  4
+#define PERF_TEST_BORROW_RUN_MS   100
+#define PERF_TEST_TRIPLE_READERS  4
+#define PERF_TEST_TRIPLE_RUN_MS   100
+#define PERF_TEST_REUSE_ROUNDS    20000 /* 清理后复用为三缓冲键的轮数 */
+#define PERF_TEST_REUSE_WRITERS   8     /* 写入者多于核数，被抢占时可能停在查找与独占条目之间 */
+#define PERF_TEST_POOL_BLOCK_SIZE 128
+#define PERF_TEST_POOL_BLOCKS     32
+#define PERF_TEST_POOL_THREADS    4
+#define PERF_TEST_POOL_HOLD       12    /* 每线程每轮持有块数：4x12超过池容量 */
+#define PERF_TEST_POOL_RUN_MS     100
 
 /* 测试数据结构 */
 typedef struct {
@@ -33,6 +52,46 @@ typedef struct {
     atomic_uint reads;
 } thread_test_param_t;
 
+/* 读者扩展性测试参数 */
+typedef struct {
+    obj_dict_t* dict;
+    atomic_int* stop;
+    int locked;                 /* 1表示读取前后加字典锁（模拟原先的加锁读取） */
+    uint64_t ops;               /* 读取或写入次数 */
+    uint64_t torn;              /* 读到的撕裂数据 */
+} scale_param_t;
+
+/* 借用稳定性测试参数 */
+typedef struct {
+    obj_dict_t* dict;
+    atomic_int* stop;
+    uint64_t ops;               /* 借用或写入次数 */
+    uint64_t torn;              /* 借用期间内容发生变化的次数 */
+} borrow_param_t;
+
+/* 三缓冲并发测试参数 */
+typedef struct {
+    obj_dict_t* dict;
+    atomic_int* stop;
+    obj_dict_key_t key;
+    uint64_t ops;               /* 读取或写入次数 */
+    uint64_t torn;              /* 读到的撕裂数据 */
+    uint64_t failed;            /* 写入失败次数 */
+    uint64_t sum_us;            /* 写入总耗时 */
+    uint64_t max_us;            /* 单次写入最大耗时 */
+    int borrow;                 /* 读者以借用代替拷贝读取 */
+} triple_param_t;
+
+/* 内存池并发测试参数 */
+typedef struct {
+    obj_dict_mempool_t* pool;
+    atomic_int* stop;
+    uint8_t tag;                /* 写入所持块的标记 */
+    uint64_t ops;               /* 分配成功次数 */
+    uint64_t failed;            /* 池满次数 */
+    uint64_t corrupt;           /* 持有期间标记被改写的次数（同一块被重复分配） */
+} mempool_param_t;
+
 /* ========== 基础功能测试 ========== */
 
 static int test_functional_basic(void) {
@@ -93,6 +152,461 @@ static int test_functional_basic(void) {
     return 0;
 }
 
+/* ========== 槽位与墓碑测试 ========== */
+
+static int test_functional_slots(void) {
+    os_printf("\n[objdict][FUNC] 槽位测试: 长度为0的值/墓碑/容量\n");
+
+    obj_dict_entry_t entry_array[8];
+    obj_dict_t dict;
+
+    if (obj_dict_init(&dict, entry_array, 8) != 0) {
+        os_printf("[objdict][FUNC] 初始化失败\n");
+        return -1;
+    }
+
+    /* 长度为0的值：键保留，可读元数据、可增减引用、可遍历 */
+    uint32_t ver = 0;
+    if (obj_dict_set(&dict, 7, NULL, 0, 0x5A) != 0 ||
+        obj_dict_get(&dict, 7, NULL, 0, NULL, &ver, NULL) != 0 || ver != 1 ||
+        obj_dict_retain(&dict, 7) != 0 || obj_dict_get_ref_count(&dict, 7) != 1 ||
+        obj_dict_release(&dict, 7) != 0 || obj_dict_iterate(&dict, -1) < 0) {
+        os_printf("[objdict][FUNC] 长度为0的值不可查找 ver=%u\n", ver);
+        return -1;
+    }
+    test_data_t data = { .value = 0xCAFEBABE, .counter = 0, .padding = {0} };
+    if (obj_dict_set(&dict, 7, &data, sizeof(data), 0) != 0 || obj_dict_set(&dict, 7, NULL, 0, 0) != 0 ||
+        obj_dict_get(&dict, 7, NULL, 0, NULL, &ver, NULL) != 0 || ver != 3) {
+        os_printf("[objdict][FUNC] 清空数据后键丢失 ver=%u\n", ver);
+        return -1;
+    }
+
+    /* 写满：所有键都能查到，再写入新键失败 */
+    for (obj_dict_key_t key = 100; key < 107; ++key) {
+        data.value = key;
+        if (obj_dict_set(&dict, key, &data, sizeof(data), 0) != 0) {
+            os_printf("[objdict][FUNC] 写入key=%u失败\n", (unsigned)key);
+            return -1;
+        }
+    }
+    if (obj_dict_set(&dict, 200, &data, sizeof(data), 0) == 0) {
+        os_printf("[objdict][FUNC] 容量已满仍写入成功\n");
+        return -1;
+    }
+
+    /* 清理后留墓碑：其余键仍可查到，新键复用槽位 */
+    obj_dict_retain(&dict, 100);
+    obj_dict_retain(&dict, 103);
+    int cleaned = obj_dict_cleanup_unused(&dict, 0);
+    if (cleaned != 6 || obj_dict_lookup(&dict, 101) != NULL || obj_dict_lookup(&dict, 7) != NULL) {
+        os_printf("[objdict][FUNC] 清理结果不对 cleaned=%d\n", cleaned);
+        return -1;
+    }
+    test_data_t out = {0};
+    if (obj_dict_get(&dict, 100, &out, sizeof(out), NULL, NULL, NULL) != sizeof(out) || out.value != 100 ||
+        obj_dict_get(&dict, 103, &out, sizeof(out), NULL, NULL, NULL) != sizeof(out) || out.value != 103) {
+        os_printf("[objdict][FUNC] 墓碑之后的键丢失\n");
+        return -1;
+    }
+    for (obj_dict_key_t key = 300; key < 306; ++key) {
+        data.value = key;
+        if (obj_dict_set(&dict, key, &data, sizeof(data), 0) != 0) {
+            os_printf("[objdict][FUNC] 复用槽位写入key=%u失败\n", (unsigned)key);
+            return -1;
+        }
+    }
+    for (obj_dict_key_t key = 300; key < 306; ++key) {
+        if (obj_dict_get(&dict, key, &out, sizeof(out), NULL, NULL, NULL) != sizeof(out) || out.value != key) {
+            os_printf("[objdict][FUNC] 复用槽位读取key=%u失败\n", (unsigned)key);
+            return -1;
+        }
+    }
+    obj_dict_release(&dict, 100);
+    obj_dict_release(&dict, 103);
+    obj_dict_cleanup_unused(&dict, 0);
+
+    os_printf("[objdict][FUNC] 槽位测试: 通过\n");
+    return 0;
+}
+
+/* ========== 零拷贝借用测试 ========== */
+
+/* peek访问函数内写入同一键：扩容走慢路径换缓冲，换下的缓冲不应等待本线程所在的读区 */
+static void __peek_grow_visit(const void* data, size_t len, void* user_data) {
+    uint8_t grown[64] = {0};
+    (void)data;
+    if (len < sizeof(grown)) obj_dict_set((obj_dict_t*)user_data, 3, grown, sizeof(grown), 0);
+}
+
+static int test_functional_borrow(void) {
+    os_printf("\n[objdict][FUNC] 借用测试: 借用期间写入/清理/长度为0的值\n");
+
+    obj_dict_entry_t entry_array[8];
+    obj_dict_t dict;
+    if (obj_dict_init(&dict, entry_array, 8) != 0) {
+        os_printf("[objdict][FUNC] 初始化失败\n");
+        return -1;
+    }
+
+    obj_dict_view_t view;
+    if (obj_dict_borrow(&dict, 1, &view) == 0 || view.data != NULL) {
+        os_printf("[objdict][FUNC] 借用不存在的键成功\n");
+        return -1;
+    }
+
+    /* 借用期间覆盖写入：借用者看到的数据不变，新读者看到新数据 */
+    test_data_t data = { .value = 1, .counter = 1, .padding = {0} };
+    obj_dict_set(&dict, 1, &data, sizeof(data), 0x11);
+    if (obj_dict_borrow(&dict, 1, &view) != 0 || view.len != sizeof(data) || view.version != 1 ||
+        view.flags != 0x11 || ((const test_data_t*)view.data)->value != 1) {
+        os_printf("[objdict][FUNC] 借用结果不对 len=%zu ver=%u\n", view.len, view.version);
+        return -1;
+    }
+    const void* pinned = view.data;
+    data.value = 2;
+    obj_dict_set(&dict, 1, &data, sizeof(data), 0x22);
+    obj_dict_view_t next;
+    test_data_t out = {0};
+    if (((const test_data_t*)view.data)->value != 1 ||
+        obj_dict_get(&dict, 1, &out, sizeof(out), NULL, NULL, NULL) != sizeof(out) || out.value != 2 ||
+        obj_dict_borrow(&dict, 1, &next) != 0 || next.data == pinned || next.version != 2 ||
+        ((const test_data_t*)next.data)->value != 2) {
+        os_printf("[objdict][FUNC] 借用期间数据被覆盖\n");
+        return -1;
+    }
+    obj_dict_return(&view);
+    if (view.data != NULL) {
+        os_printf("[objdict][FUNC] 归还后视图未清空\n");
+        return -1;
+    }
+
+    /* 借用期间清理：键被删除，借用的数据在归还前仍可访问 */
+    int cleaned = obj_dict_cleanup_unused(&dict, 0);
+    if (cleaned != 1 || obj_dict_lookup(&dict, 1) != NULL || ((const test_data_t*)next.data)->value != 2) {
+        os_printf("[objdict][FUNC] 借用期间清理结果不对 cleaned=%d\n", cleaned);
+        return -1;
+    }
+    obj_dict_return(&next);
+
+    /* 长度为0的值：借用成功，data为NULL */
+    if (obj_dict_set(&dict, 2, NULL, 0, 0) != 0 || obj_dict_borrow(&dict, 2, &view) != 0 ||
+        view.data != NULL || view.len != 0) {
+        os_printf("[objdict][FUNC] 长度为0的值借用结果不对\n");
+        return -1;
+    }
+    obj_dict_return(&view);
+
+    /* 读区内写入：peek访问函数把键扩容，返回后读到扩容后的值 */
+    uint8_t small[4] = {0};
+    uint8_t grown[64];
+    if (obj_dict_set(&dict, 3, small, sizeof(small), 0) != 0 ||
+        obj_dict_peek(&dict, 3, __peek_grow_visit, &dict) != 0 ||
+        obj_dict_get(&dict, 3, grown, sizeof(grown), NULL, NULL, NULL) != (ssize_t)sizeof(grown)) {
+        os_printf("[objdict][FUNC] peek内写入结果不对\n");
+        return -1;
+    }
+    obj_dict_cleanup_unused(&dict, 0);
+
+    os_printf("[objdict][FUNC] 借用测试: 通过\n");
+    return 0;
+}
+
+/* ========== 单写者三缓冲测试 ========== */
+
+static int test_functional_triple(void) {
+    os_printf("\n[objdict][FUNC] 三缓冲测试: 注册/首次写入选用/借用占位/清理\n");
+
+    obj_dict_entry_t entry_array[8];
+    obj_dict_t dict;
+    if (obj_dict_init(&dict, entry_array, 8) != 0) {
+        os_printf("[objdict][FUNC] 初始化失败\n");
+        return -1;
+    }
+
+    /* 注册：写入不超过容量，重复注册容量足够时成功，普通键不能注册 */
+    test_data_t data = { .value = 1, .counter = 1, .padding = {0} };
+    test_data_t out = {0};
+    uint32_t ver = 0;
+    uint8_t fl = 0;
+    obj_dict_set(&dict, 1, &data, sizeof(data), 0);
+    if (obj_dict_register_triple(&dict, 10, sizeof(data)) != 0 ||
+        obj_dict_register_triple(&dict, 10, sizeof(data)) != 0 ||
+        obj_dict_register_triple(&dict, 10, sizeof(data) * 2) == 0 ||
+        obj_dict_register_triple(&dict, 1, sizeof(data)) == 0 ||
+        obj_dict_get(&dict, 10, NULL, 0, NULL, &ver, NULL) != 0 || ver != 0) {
+        os_printf("[objdict][FUNC] 三缓冲注册结果不对 ver=%u\n", ver);
+        return -1;
+    }
+    uint8_t big[sizeof(data) * 2] = {0};
+    if (obj_dict_set(&dict, 10, &data, sizeof(data), 0x01) != 0 ||
+        obj_dict_set(&dict, 10, big, sizeof(big), 0) == 0 ||
+        obj_dict_get(&dict, 10, &out, sizeof(out), NULL, &ver, &fl) != sizeof(out) ||
+        out.value != 1 || ver != 1 || fl != 0x01) {
+        os_printf("[objdict][FUNC] 三缓冲写入结果不对 ver=%u\n", ver);
+        return -1;
+    }
+
+    /* 首次写入带标志位选用三缓冲，之后不带标志位仍是三缓冲 */
+    if (obj_dict_set(&dict, 11, &data, sizeof(data), OBJ_DICT_FLAG_TRIPLE_BUFFER) != 0 ||
+        obj_dict_lookup(&dict, 11)->mode != OBJ_DICT_MODE_TRIPLE ||
+        obj_dict_set(&dict, 11, &data, sizeof(data), 0) != 0 || obj_dict_lookup(&dict, 11)->mode != OBJ_DICT_MODE_TRIPLE ||
+        obj_dict_lookup(&dict, 1)->mode != OBJ_DICT_MODE_NORMAL) {
+        os_printf("[objdict][FUNC] 首次写入选用三缓冲失败\n");
+        return -1;
+    }
+
+    /* 借用占住槽位：写入者绕开被借用的槽位，两个候选槽位都被借用时原地改写最新槽位，
+     * 三个槽位都被借用时丢弃写入并计数，不阻塞 */
+    obj_dict_view_t a, b;
+    if (obj_dict_borrow(&dict, 10, &a) != 0 || a.version != 1) {
+        os_printf("[objdict][FUNC] 三缓冲借用失败\n");
+        return -1;
+    }
+    data.value = 2;
+    obj_dict_set(&dict, 10, &data, sizeof(data), 0);
+    if (obj_dict_borrow(&dict, 10, &b) != 0 || b.version != 2 || ((const test_data_t*)b.data)->value != 2) {
+        os_printf("[objdict][FUNC] 三缓冲借用未看到最新值\n");
+        return -1;
+    }
+    data.value = 3;
+    int r3 = obj_dict_set(&dict, 10, &data, sizeof(data), 0);
+    data.value = 4;
+    int r4 = obj_dict_set(&dict, 10, &data, sizeof(data), 0);
+    if (r3 != 0 || r4 != 0 || ((const test_data_t*)a.data)->value != 1 || ((const test_data_t*)b.data)->value != 2 ||
+        obj_dict_get(&dict, 10, &out, sizeof(out), NULL, &ver, NULL) != sizeof(out) || out.value != 4 || ver != 4) {
+        os_printf("[objdict][FUNC] 三缓冲借用期间写入结果不对 r3=%d r4=%d ver=%u\n", r3, r4, ver);
+        return -1;
+    }
+    obj_dict_view_t c;
+    uint32_t writes = 0;
+    uint32_t dropped = 0;
+    data.value = 5;
+    if (obj_dict_borrow(&dict, 10, &c) != 0 || c.version != 4 || obj_dict_set(&dict, 10, &data, sizeof(data), 0) == 0 ||
+        obj_dict_triple_get_stats(&dict, 10, &writes, &dropped) != 0 || writes != 4 || dropped != 1 ||
+        obj_dict_triple_get_stats(&dict, 1, NULL, NULL) == 0 ||
+        obj_dict_get(&dict, 10, &out, sizeof(out), NULL, &ver, NULL) != sizeof(out) || out.value != 4 || ver != 4) {
+        os_printf("[objdict][FUNC] 三个槽位都被借用时写入结果不对 writes=%u dropped=%u\n", writes, dropped);
+        return -1;
+    }
+    obj_dict_return(&c);
+
+    /* 时间戳随槽位发布 */
+    uint64_t ts = 0;
+    if (obj_dict_get(&dict, 10, NULL, 0, &ts, NULL, NULL) != 0 || ts == 0 ||
+        obj_dict_entry_timestamp(&dict, obj_dict_lookup(&dict, 10)) != ts) {
+        os_printf("[objdict][FUNC] 三缓冲键时间戳不对\n");
+        return -1;
+    }
+
+    /* 槽位被借用时不清理，归还后可清理 */
+    int cleaned = obj_dict_cleanup_unused(&dict, 0);
+    if (cleaned != 2 || !obj_dict_lookup(&dict, 10)) {
+        os_printf("[objdict][FUNC] 借用中的三缓冲键被清理 cleaned=%d\n", cleaned);
+        return -1;
+    }
+    obj_dict_return(&a);
+    if (obj_dict_set(&dict, 10, &data, sizeof(data), 0) != 0) {
+        os_printf("[objdict][FUNC] 归还后三缓冲写入失败\n");
+        return -1;
+    }
+    obj_dict_return(&b);
+    cleaned = obj_dict_cleanup_unused(&dict, 0);
+    if (cleaned != 1 || obj_dict_lookup(&dict, 10)) {
+        os_printf("[objdict][FUNC] 三缓冲键清理失败 cleaned=%d\n", cleaned);
+        return -1;
+    }
+
+    /* 清理后的槽位可作普通键复用 */
+    if (obj_dict_set(&dict, 10, &data, sizeof(data), 0) != 0 || obj_dict_lookup(&dict, 10)->mode != OBJ_DICT_MODE_NORMAL) {
+        os_printf("[objdict][FUNC] 三缓冲键清理后复用失败\n");
+        return -1;
+    }
+    obj_dict_cleanup_unused(&dict, 0);
+
+    os_printf("[objdict][FUNC] 三缓冲测试: 通过\n");
+    return 0;
+}
+
+/* ========== 内存池功能测试 ========== */
+
+static int test_functional_mempool(void) {
+    os_printf("\n[objdict][FUNC] 内存池测试: 分配耗尽/地址归还/重复释放/统计/回退系统堆\n");
+
+    obj_dict_mempool_t* pool = obj_dict_mempool_create(PERF_TEST_POOL_BLOCK_SIZE, PERF_TEST_POOL_BLOCKS);
+    if (!pool) {
+        os_printf("[objdict][FUNC] 内存池创建失败\n");
+        return -1;
+    }
+
+    /* 分配耗尽：块互不重叠，超出块大小或块数时返回NULL */
+    void* blocks[PERF_TEST_POOL_BLOCKS];
+    size_t total = 0, free_blocks = 0, used = 0;
+    for (int i = 0; i < PERF_TEST_POOL_BLOCKS; ++i) {
+        blocks[i] = obj_dict_mempool_alloc(pool, PERF_TEST_POOL_BLOCK_SIZE);
+        if (!blocks[i] || !obj_dict_mempool_owns(pool, blocks[i])) {
+            os_printf("[objdict][FUNC] 第%d块分配失败\n", i);
+            obj_dict_mempool_destroy(pool);
+            return -1;
+        }
+        memset(blocks[i], i, PERF_TEST_POOL_BLOCK_SIZE);
+    }
+    for (int i = 0; i < PERF_TEST_POOL_BLOCKS; ++i) {
+        const uint8_t* b = (const uint8_t*)blocks[i];
+        if (b[0] != (uint8_t)i || b[PERF_TEST_POOL_BLOCK_SIZE - 1] != (uint8_t)i) {
+            os_printf("[objdict][FUNC] 第%d块与其他块重叠\n", i);
+            obj_dict_mempool_destroy(pool);
+            return -1;
+        }
+    }
+    obj_dict_mempool_get_stats(pool, &total, &free_blocks, &used);
+    if (obj_dict_mempool_alloc(pool, 1) != NULL || obj_dict_mempool_alloc(pool, PERF_TEST_POOL_BLOCK_SIZE + 1) != NULL ||
+        total != PERF_TEST_POOL_BLOCKS || free_blocks != 0 || used != PERF_TEST_POOL_BLOCKS) {
+        os_printf("[objdict][FUNC] 耗尽后统计错误 total=%zu free=%zu used=%zu\n", total, free_blocks, used);
+        obj_dict_mempool_destroy(pool);
+        return -1;
+    }
+
+    /* 归还：块内指针、池外指针与重复释放被忽略，计数不变 */
+    uint8_t foreign[8];
+    obj_dict_mempool_free(pool, foreign);
+    obj_dict_mempool_free(pool, (uint8_t*)blocks[1] + 1);
+    obj_dict_mempool_free(pool, blocks[3]);
+    obj_dict_mempool_free(pool, blocks[3]);
+    obj_dict_mempool_get_stats(pool, NULL, &free_blocks, &used);
+    if (obj_dict_mempool_owns(pool, foreign) || free_blocks != 1 || used != PERF_TEST_POOL_BLOCKS - 1) {
+        os_printf("[objdict][FUNC] 归还统计错误 free=%zu used=%zu\n", free_blocks, used);
+        obj_dict_mempool_destroy(pool);
+        return -1;
+    }
+    /* 空闲链表后进先出：刚归还的块被再次分配 */
+    if (obj_dict_mempool_alloc(pool, 1) != blocks[3]) {
+        os_printf("[objdict][FUNC] 归还的块未被复用\n");
+        obj_dict_mempool_destroy(pool);
+        return -1;
+    }
+    for (int i = 0; i < PERF_TEST_POOL_BLOCKS; ++i) {
+        obj_dict_mempool_free(pool, blocks[i]);
+    }
+    obj_dict_mempool_get_stats(pool, NULL, &free_blocks, &used);
+    obj_dict_mempool_destroy(pool);
+    if (free_blocks != PERF_TEST_POOL_BLOCKS || used != 0) {
+        os_printf("[objdict][FUNC] 全部归还后统计错误 free=%zu used=%zu\n", free_blocks, used);
+        return -1;
+    }
+
+    /* 字典：键数超过块数时回退到系统堆，清理后池内块全部归还 */
+    obj_dict_entry_t entry_array[PERF_TEST_POOL_BLOCKS * 2];
+    obj_dict_t dict;
+    if (obj_dict_init_with_mempool(&dict, entry_array, PERF_TEST_POOL_BLOCKS * 2, OBJ_DICT_MEMPOOL_BLOCK_SIZE,
+                                   PERF_TEST_POOL_BLOCKS) != 0) {
+        os_printf("[objdict][FUNC] 带内存池的字典初始化失败\n");
+        return -1;
+    }
+    test_data_t data = { .value = 7, .counter = 7, .padding = {0} };
+    for (obj_dict_key_t key = 0; key < PERF_TEST_POOL_BLOCKS * 2; ++key) {
+        obj_dict_set(&dict, key, &data, sizeof(data), 0);
+    }
+    obj_dict_mempool_get_stats(dict.mempool, NULL, NULL, &used);
+    int cleaned = obj_dict_cleanup_unused(&dict, 0);
+    obj_dict_mempool_get_stats(dict.mempool, NULL, &free_blocks, NULL);
+    obj_dict_mempool_destroy(dict.mempool);
+    if (used != PERF_TEST_POOL_BLOCKS || cleaned != PERF_TEST_POOL_BLOCKS * 2 || free_blocks != PERF_TEST_POOL_BLOCKS) {
+        os_printf("[objdict][FUNC] 字典内存池归还错误 used=%zu cleaned=%d free=%zu\n", used, cleaned, free_blocks);
+        return -1;
+    }
+
+    os_printf("[objdict][FUNC] 内存池测试: 通过\n");
+    return 0;
+}
+
+/* ========== 性能测试：键查找 ========== */
+
+/*
+ * @brief 线性扫描查找（旧实现，仅作对照）
+ */
+static obj_dict_entry_t* __linear_lookup(obj_dict_t* dict, obj_dict_key_t key) {
+    for (size_t i = 0; i < dict->max_keys; ++i) {
+        if (dict->entries[i].value != NULL && dict->entries[i].key == key) {
+            return &dict->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static int test_performance_lookup(void) {
+    os_printf("\n[objdict][PERF] 键查找测试: %u个键/%u个槽位\n", (unsigned)PERF_TEST_LOOKUP_KEYS,
+              (unsigned)PERF_TEST_LOOKUP_SLOTS);
+
+    obj_dict_entry_t* entry_array = (obj_dict_entry_t*)os_malloc(sizeof(obj_dict_entry_t) * PERF_TEST_LOOKUP_SLOTS);
+    if (!entry_array) return -1;
+    obj_dict_t dict;
+    if (obj_dict_init(&dict, entry_array, PERF_TEST_LOOKUP_SLOTS) != 0) {
+        os_printf("[objdict][PERF] 初始化失败\n");
+        os_free(entry_array);
+        return -1;
+    }
+
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < PERF_TEST_LOOKUP_KEYS; ++i) {
+        value = i;
+        if (obj_dict_set(&dict, (obj_dict_key_t)i, &value, sizeof(value), 0) != 0) {
+            os_printf("[objdict][PERF] 写入key=%u失败\n", (unsigned)i);
+            os_free(entry_array);
+            return -1;
+        }
+    }
+
+    /* 键查找（不加锁的纯查找）：散列 vs 线性扫描，键在全部范围内轮转 */
+    size_t misses = 0;
+    uint64_t t0 = os_monotonic_time_get_microsecond();
+    for (size_t i = 0; i < PERF_TEST_LOOKUP_LOOPS; ++i) {
+        if (!obj_dict_lookup(&dict, (obj_dict_key_t)((i * 7U) % PERF_TEST_LOOKUP_KEYS))) ++misses;
+    }
+    uint64_t us_hash = os_monotonic_time_get_microsecond() - t0;
+
+    const size_t linear_loops = PERF_TEST_LOOKUP_LOOPS / 100U;
+    t0 = os_monotonic_time_get_microsecond();
+    for (size_t i = 0; i < linear_loops; ++i) {
+        if (!__linear_lookup(&dict, (obj_dict_key_t)((i * 7U) % PERF_TEST_LOOKUP_KEYS))) ++misses;
+    }
+    uint64_t us_linear = os_monotonic_time_get_microsecond() - t0;
+
+    /* 不存在的键：线性扫描必须走完整个数组 */
+    t0 = os_monotonic_time_get_microsecond();
+    for (size_t i = 0; i < PERF_TEST_LOOKUP_LOOPS; ++i) {
+        if (obj_dict_lookup(&dict, (obj_dict_key_t)(PERF_TEST_LOOKUP_KEYS + (i & 1023U)))) ++misses;
+    }
+    uint64_t us_absent = os_monotonic_time_get_microsecond() - t0;
+
+    /* 完整的obj_dict_get（含加锁与拷贝） */
+    t0 = os_monotonic_time_get_microsecond();
+    for (size_t i = 0; i < PERF_TEST_LOOKUP_LOOPS; ++i) {
+        if (obj_dict_get(&dict, (obj_dict_key_t)((i * 7U) % PERF_TEST_LOOKUP_KEYS), &value, sizeof(value),
+                         NULL, NULL, NULL) != sizeof(value)) {
+            ++misses;
+        }
+    }
+    uint64_t us_get = os_monotonic_time_get_microsecond() - t0;
+
+    double hash_ns = (double)us_hash * 1000.0 / (double)PERF_TEST_LOOKUP_LOOPS;
+    double linear_ns = (double)us_linear * 1000.0 / (double)linear_loops;
+    os_printf("[objdict][PERF] 查找(散列): loops=%u avg=%.2f ns/op\n", (unsigned)PERF_TEST_LOOKUP_LOOPS, hash_ns);
+    os_printf("[objdict][PERF] 查找(线性扫描对照): loops=%zu avg=%.2f ns/op (%.1fx)\n",
+              linear_loops, linear_ns, hash_ns > 0.0 ? linear_ns / hash_ns : 0.0);
+    os_printf("[objdict][PERF] 查找不存在的键: avg=%.2f ns/op (最长探测距离=%zu)\n",
+              (double)us_absent * 1000.0 / (double)PERF_TEST_LOOKUP_LOOPS, dict.max_probe);
+    os_printf("[objdict][PERF] obj_dict_get: avg=%.2f ns/op\n",
+              (double)us_get * 1000.0 / (double)PERF_TEST_LOOKUP_LOOPS);
+
+    obj_dict_cleanup_unused(&dict, 0);
+    os_free(entry_array);
+    if (misses != 0) {
+        os_printf("[objdict][PERF] 查找结果不对 misses=%zu\n", misses);
+        return -1;
+    }
+    return 0;
+}
+
 /* ========== 性能测试：吞吐量 ========== */
 
 static int test_performance_throughput(void) {
@@ -478,6 +992,626 @@ static int test_version_consistency(void) {
     return 0;
 }
 
+/* ========== 多线程测试：读者扩展性 ========== */
+
+static void* scale_reader_entry(void* param) {
+    scale_param_t* p = (scale_param_t*)param;
+    test_data_t data;
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        for (obj_dict_key_t key = 0; key < PERF_TEST_SCALE_KEYS; ++key) {
+            if (p->locked) os_semaphore_take(p->dict->lock, 100);
+            ssize_t n = obj_dict_get(p->dict, key, &data, sizeof(data), NULL, NULL, NULL);
+            if (p->locked) os_semaphore_give(p->dict->lock);
+            /* 写入者让value、counter与填充字节同步变化，任何不一致即为撕裂 */
+            if (n != sizeof(data) || data.value != data.counter || data.padding[0] != (uint8_t)data.value ||
+                data.padding[sizeof(data.padding) - 1] != (uint8_t)data.value) {
+                p->torn++;
+            }
+            p->ops++;
+        }
+    }
+    return NULL;
+}
+
+static void* scale_writer_entry(void* param) {
+    scale_param_t* p = (scale_param_t*)param;
+    test_data_t data;
+    uint32_t seq = 0;
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        for (obj_dict_key_t key = 0; key < PERF_TEST_SCALE_KEYS; ++key) {
+            ++seq;
+            data.value = seq;
+            data.counter = seq;
+            memset(data.padding, (uint8_t)seq, sizeof(data.padding));
+            if (p->locked) os_semaphore_take(p->dict->lock, 100);
+            obj_dict_set(p->dict, key, &data, sizeof(data), 0);
+            if (p->locked) os_semaphore_give(p->dict->lock);
+            p->ops++;
+        }
+        os_thread_sleep_ms(1);  /* 控制周期的写入方：每毫秒刷新一轮 */
+    }
+    return NULL;
+}
+
+/*
+ * @brief 运行一轮扩展性测试
+ * @return 读取吞吐（次/秒），失败返回负数
+ */
+static double scale_run(obj_dict_t* dict, int readers, int locked, uint64_t* torn, uint64_t* writes) {
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    OsThread_t* threads[PERF_TEST_SCALE_READERS + 1];
+    scale_param_t params[PERF_TEST_SCALE_READERS + 1];
+    ThreadAttr_t attr = {
+        .pName = "ScaleReader",
+        .Priority = 5,
+        .StackSize = 4096,
+        .ScheduleType = 0
+    };
+
+    int created = 0;
+    for (int i = 0; i <= readers; ++i) {
+        params[i].dict = dict;
+        params[i].stop = &stop;
+        params[i].locked = locked;
+        params[i].ops = 0;
+        params[i].torn = 0;
+        attr.pName = (i == readers) ? "ScaleWriter" : "ScaleReader";
+        threads[i] = os_thread_create((i == readers) ? scale_writer_entry : scale_reader_entry, &params[i], &attr);
+        if (!threads[i]) break;
+        created++;
+    }
+
+    uint64_t t0 = os_monotonic_time_get_microsecond();
+    if (created == readers + 1) {
+        os_thread_sleep_ms(PERF_TEST_SCALE_RUN_MS);
+    }
+    atomic_store_explicit(&stop, 1, memory_order_relaxed);
+    for (int i = 0; i < created; ++i) {
+        os_thread_join(threads[i]);
+        os_thread_destroy(threads[i]);
+    }
+    uint64_t us = os_monotonic_time_get_microsecond() - t0;
+    if (created != readers + 1) return -1.0;
+
+    uint64_t reads = 0;
+    for (int i = 0; i < readers; ++i) {
+        reads += params[i].ops;
+        *torn += params[i].torn;
+    }
+    *writes = params[readers].ops;
+    return us ? (double)reads * 1e6 / (double)us : 0.0;
+}
+
+static int test_threads_reader_scaling(void) {
+    os_printf("\n[objdict][SCALE] 读者扩展性测试: 每轮读%d个键，1个写入者每毫秒刷新一轮\n", PERF_TEST_SCALE_KEYS);
+
+    obj_dict_entry_t entry_array[PERF_TEST_MAX_KEYS];
+    obj_dict_t dict;
+    if (obj_dict_init(&dict, entry_array, PERF_TEST_MAX_KEYS) != 0) {
+        os_printf("[objdict][SCALE] 初始化失败\n");
+        return -1;
+    }
+    test_data_t data;
+    memset(&data, 0, sizeof(data));
+    for (obj_dict_key_t key = 0; key < PERF_TEST_SCALE_KEYS; ++key) {
+        obj_dict_set(&dict, key, &data, sizeof(data), 0);
+    }
+
+    uint64_t torn = 0;
+    for (int readers = 1; readers <= PERF_TEST_SCALE_READERS; readers *= 2) {
+        uint64_t writes_free = 0, writes_locked = 0;
+        double free_rate = scale_run(&dict, readers, 0, &torn, &writes_free);
+        double locked_rate = scale_run(&dict, readers, 1, &torn, &writes_locked);
+        if (free_rate < 0.0 || locked_rate < 0.0) {
+            os_printf("[objdict][SCALE] 创建线程失败 readers=%d\n", readers);
+            return -1;
+        }
+        os_printf("[objdict][SCALE] readers=%2d  无锁: %.2f M reads/s  加锁对照: %.2f M reads/s (%.1fx)  "
+                  "writes=%llu/%llu\n",
+                  readers, free_rate / 1e6, locked_rate / 1e6, locked_rate > 0.0 ? free_rate / locked_rate : 0.0,
+                  (unsigned long long)writes_free, (unsigned long long)writes_locked);
+    }
+
+    obj_dict_cleanup_unused(&dict, 0);
+    if (torn != 0) {
+        os_printf("[objdict][SCALE] 读到撕裂数据 torn=%llu\n", (unsigned long long)torn);
+        return -1;
+    }
+    os_printf("[objdict][SCALE] 数据一致性检查: 通过\n");
+    return 0;
+}
+
+/* ========== 零拷贝借用：大帧读取与并发写入 ========== */
+
+static void* borrow_reader_entry(void* param) {
+    borrow_param_t* p = (borrow_param_t*)param;
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        obj_dict_view_t view;
+        if (obj_dict_borrow(p->dict, 0, &view) != 0) continue;
+        /* 写入者整帧填同一字节：借用期间首尾字节一致且两次读取不变 */
+        const uint8_t* frame = (const uint8_t*)view.data;
+        uint8_t head = frame[0];
+        os_thread_sleep_ms(0);  /* 持有期间让出CPU，给写入者覆盖的机会 */
+        if (frame[view.len - 1] != head || frame[view.len / 2] != head || frame[0] != head) {
+            p->torn++;
+        }
+        obj_dict_return(&view);
+        p->ops++;
+    }
+    return NULL;
+}
+
+static void* borrow_writer_entry(void* param) {
+    borrow_param_t* p = (borrow_param_t*)param;
+    uint8_t* frame = (uint8_t*)os_malloc(PERF_TEST_FRAME_SIZE);
+    if (!frame) return NULL;
+    uint8_t seq = 0;
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        memset(frame, ++seq, PERF_TEST_FRAME_SIZE);
+        obj_dict_set(p->dict, 0, frame, PERF_TEST_FRAME_SIZE, 0);
+        p->ops++;
+        os_thread_sleep_ms(0);
+    }
+    os_free(frame);
+    return NULL;
+}
+
+static int test_performance_borrow(void) {
+    os_printf("\n[objdict][PERF] 零拷贝借用测试: %d字节大帧\n", PERF_TEST_FRAME_SIZE);
+
+    obj_dict_entry_t entry_array[4];
+    obj_dict_t dict;
+    uint8_t* frame = (uint8_t*)os_malloc(PERF_TEST_FRAME_SIZE);
+    uint8_t* out = (uint8_t*)os_malloc(PERF_TEST_FRAME_SIZE);
+    if (!frame || !out || obj_dict_init(&dict, entry_array, 4) != 0) {
+        os_printf("[objdict][PERF] 初始化失败\n");
+        os_free(frame);
+        os_free(out);
+        return -1;
+    }
+    memset(frame, 0x5A, PERF_TEST_FRAME_SIZE);
+    obj_dict_set(&dict, 0, frame, PERF_TEST_FRAME_SIZE, 0);
+
+    /* 读取一个字节代表就地访问，拷贝读取另需搬运整帧 */
+    uint32_t sum = 0;
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_FRAME_LOOPS; ++i) {
+        obj_dict_get(&dict, 0, out, PERF_TEST_FRAME_SIZE, NULL, NULL, NULL);
+        sum += out[i % PERF_TEST_FRAME_SIZE];
+    }
+    uint64_t copy_us = os_monotonic_time_get_microsecond() - start;
+
+    start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_FRAME_LOOPS; ++i) {
+        obj_dict_view_t view;
+        obj_dict_borrow(&dict, 0, &view);
+        sum += ((const uint8_t*)view.data)[i % PERF_TEST_FRAME_SIZE];
+        obj_dict_return(&view);
+    }
+    uint64_t borrow_us = os_monotonic_time_get_microsecond() - start;
+    os_printf("[objdict][PERF] 拷贝读取: %.1f ns/次  借用+归还: %.1f ns/次 (%.1fx)  checksum=%u\n",
+              (double)copy_us * 1000.0 / PERF_TEST_FRAME_LOOPS, (double)borrow_us * 1000.0 / PERF_TEST_FRAME_LOOPS,
+              borrow_us ? (double)copy_us / (double)borrow_us : 0.0, (unsigned)sum);
+
+    /* 并发：写入者持续覆盖整帧，借用者持有期间数据不得变化 */
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    OsThread_t* threads[PERF_TEST_BORROW_READERS + 1];
+    borrow_param_t params[PERF_TEST_BORROW_READERS + 1];
+    ThreadAttr_t attr = {
+        .pName = "BorrowReader",
+        .Priority = 5,
+        .StackSize = 4096,
+        .ScheduleType = 0
+    };
+    int created = 0;
+    for (int i = 0; i <= PERF_TEST_BORROW_READERS; ++i) {
+        params[i].dict = &dict;
+        params[i].stop = &stop;
+        params[i].ops = 0;
+        params[i].torn = 0;
+        attr.pName = (i == PERF_TEST_BORROW_READERS) ? "BorrowWriter" : "BorrowReader";
+        threads[i] = os_thread_create((i == PERF_TEST_BORROW_READERS) ? borrow_writer_entry : borrow_reader_entry,
+                                      &params[i], &attr);
+        if (!threads[i]) break;
+        created++;
+    }
+    if (created == PERF_TEST_BORROW_READERS + 1) {
+        os_thread_sleep_ms(PERF_TEST_BORROW_RUN_MS);
+    }
+    atomic_store_explicit(&stop, 1, memory_order_relaxed);
+    for (int i = 0; i < created; ++i) {
+        os_thread_join(threads[i]);
+        os_thread_destroy(threads[i]);
+    }
+
+    uint64_t borrows = 0, torn = 0;
+    for (int i = 0; i < PERF_TEST_BORROW_READERS && i < created; ++i) {
+        borrows += params[i].ops;
+        torn += params[i].torn;
+    }
+    uint64_t writes = (created == PERF_TEST_BORROW_READERS + 1) ? params[PERF_TEST_BORROW_READERS].ops : 0;
+    obj_dict_cleanup_unused(&dict, 0);
+    os_free(frame);
+    os_free(out);
+
+    if (created != PERF_TEST_BORROW_READERS + 1) {
+        os_printf("[objdict][PERF] 创建线程失败\n");
+        return -1;
+    }
+    os_printf("[objdict][PERF] 并发借用: readers=%d borrows=%llu writes=%llu torn=%llu\n", PERF_TEST_BORROW_READERS,
+              (unsigned long long)borrows, (unsigned long long)writes, (unsigned long long)torn);
+    if (torn != 0) {
+        os_printf("[objdict][PERF] 借用期间数据被覆盖\n");
+        return -1;
+    }
+    os_printf("[objdict][PERF] 借用数据稳定性检查: 通过\n");
+    return 0;
+}
+
+/* ========== 单写者三缓冲：写入延迟与读者一致性 ========== */
+
+static void* triple_reader_entry(void* param) {
+    triple_param_t* p = (triple_param_t*)param;
+    test_data_t copy;
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        obj_dict_view_t view = {0};
+        const test_data_t* data = &copy;
+        size_t n;
+        if (p->borrow) {
+            if (obj_dict_borrow(p->dict, p->key, &view) != 0) continue;
+            data = (const test_data_t*)view.data;
+            n = view.len;
+        } else {
+            n = (size_t)obj_dict_get(p->dict, p->key, &copy, sizeof(copy), NULL, NULL, NULL);
+        }
+        if (n != sizeof(copy) || data->value != data->counter || data->padding[0] != (uint8_t)data->value ||
+            data->padding[sizeof(data->padding) - 1] != (uint8_t)data->value) {
+            p->torn++;
+        }
+        obj_dict_return(&view);
+        p->ops++;
+    }
+    return NULL;
+}
+
+static void* triple_writer_entry(void* param) {
+    triple_param_t* p = (triple_param_t*)param;
+    test_data_t data;
+    uint32_t seq = 0;
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        ++seq;
+        data.value = seq;
+        data.counter = seq;
+        memset(data.padding, (uint8_t)seq, sizeof(data.padding));
+        uint64_t t0 = os_monotonic_time_get_microsecond();
+        if (obj_dict_set(p->dict, p->key, &data, sizeof(data), 0) != 0) p->failed++;
+        uint64_t dt = os_monotonic_time_get_microsecond() - t0;
+        p->sum_us += dt;
+        if (dt > p->max_us) p->max_us = dt;
+        p->ops++;
+    }
+    return NULL;
+}
+
+/*
+ * @brief 运行一轮三缓冲/普通键对照：1个写入者全速写同一键，多个读者持续读取
+ * @return 0成功，-1创建线程失败
+ */
+static int triple_run(obj_dict_t* dict, obj_dict_key_t key, triple_param_t* writer, uint64_t* reads, uint64_t* torn) {
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    OsThread_t* threads[PERF_TEST_TRIPLE_READERS + 1];
+    triple_param_t params[PERF_TEST_TRIPLE_READERS + 1];
+    ThreadAttr_t attr = {
+        .pName = "TripleReader",
+        .Priority = 5,
+        .StackSize = 4096,
+        .ScheduleType = 0
+    };
+
+    int created = 0;
+    for (int i = 0; i <= PERF_TEST_TRIPLE_READERS; ++i) {
+        memset(&params[i], 0, sizeof(params[i]));
+        params[i].dict = dict;
+        params[i].stop = &stop;
+        params[i].key = key;
+        params[i].borrow = i & 1;  /* 一半读者借用，一半拷贝读取 */
+        attr.pName = (i == PERF_TEST_TRIPLE_READERS) ? "TripleWriter" : "TripleReader";
+        threads[i] = os_thread_create((i == PERF_TEST_TRIPLE_READERS) ? triple_writer_entry : triple_reader_entry,
+                                      &params[i], &attr);
+        if (!threads[i]) break;
+        created++;
+    }
+    if (created == PERF_TEST_TRIPLE_READERS + 1) {
+        os_thread_sleep_ms(PERF_TEST_TRIPLE_RUN_MS);
+    }
+    atomic_store_explicit(&stop, 1, memory_order_relaxed);
+    for (int i = 0; i < created; ++i) {
+        os_thread_join(threads[i]);
+        os_thread_destroy(threads[i]);
+    }
+    if (created != PERF_TEST_TRIPLE_READERS + 1) return -1;
+
+    *reads = 0;
+    for (int i = 0; i < PERF_TEST_TRIPLE_READERS; ++i) {
+        *reads += params[i].ops;
+        *torn += params[i].torn;
+    }
+    *writer = params[PERF_TEST_TRIPLE_READERS];
+    return 0;
+}
+
+static int test_performance_triple(void) {
+    os_printf("\n[objdict][PERF] 单写者三缓冲测试: 1个写入者 + %d个读者（一半借用）\n", PERF_TEST_TRIPLE_READERS);
+
+    obj_dict_entry_t entry_array[4];
+    obj_dict_t dict;
+    if (obj_dict_init(&dict, entry_array, 4) != 0) {
+        os_printf("[objdict][PERF] 初始化失败\n");
+        return -1;
+    }
+    test_data_t data;
+    memset(&data, 0, sizeof(data));
+    obj_dict_set(&dict, 0, &data, sizeof(data), 0);
+    obj_dict_set(&dict, 1, &data, sizeof(data), OBJ_DICT_FLAG_TRIPLE_BUFFER);
+
+    /* 单线程写入耗时 */
+    uint64_t us[2];
+    for (obj_dict_key_t key = 0; key < 2; ++key) {
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_LOOPS_SINGLE; ++i) {
+            data.value = (uint32_t)i;
+            obj_dict_set(&dict, key, &data, sizeof(data), 0);
+        }
+        us[key] = os_monotonic_time_get_microsecond() - start;
+    }
+    os_printf("[objdict][PERF] 单线程写入: 普通键 %.1f ns/次  三缓冲键 %.1f ns/次\n",
+              (double)us[0] * 1000.0 / PERF_TEST_LOOPS_SINGLE, (double)us[1] * 1000.0 / PERF_TEST_LOOPS_SINGLE);
+
+    /* 借用期间写入：普通键每次换新缓冲（字典锁 + 分配 + 等待读区），三缓冲键写其余槽位 */
+    for (obj_dict_key_t key = 0; key < 2; ++key) {
+        obj_dict_view_t view;
+        obj_dict_borrow(&dict, key, &view);
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_LOOPS_SINGLE; ++i) {
+            data.value = (uint32_t)i;
+            obj_dict_set(&dict, key, &data, sizeof(data), 0);
+        }
+        us[key] = os_monotonic_time_get_microsecond() - start;
+        obj_dict_return(&view);
+    }
+    os_printf("[objdict][PERF] 借用期间写入: 普通键 %.1f ns/次  三缓冲键 %.1f ns/次\n",
+              (double)us[0] * 1000.0 / PERF_TEST_LOOPS_SINGLE, (double)us[1] * 1000.0 / PERF_TEST_LOOPS_SINGLE);
+
+    /* 并发：写入者不等待读者，读者总能读到完整的最新值；先写入各字段一致的初值 */
+    memset(&data, 0, sizeof(data));
+    obj_dict_set(&dict, 0, &data, sizeof(data), 0);
+    obj_dict_set(&dict, 1, &data, sizeof(data), 0);
+    uint64_t torn = 0;
+    uint64_t failed = 0;
+    for (obj_dict_key_t key = 0; key < 2; ++key) {
+        triple_param_t writer;
+        uint64_t reads = 0;
+        if (triple_run(&dict, key, &writer, &reads, &torn) != 0) {
+            os_printf("[objdict][PERF] 创建线程失败\n");
+            return -1;
+        }
+        if (key == 0) failed += writer.failed;  /* 三缓冲键三个槽位都被借用时丢弃写入，属预期 */
+        os_printf("[objdict][PERF] %s: writes=%llu (平均%.2f us, 最大%llu us, 拒绝%llu) reads=%llu\n",
+                  key ? "三缓冲键" : "普通键", (unsigned long long)writer.ops,
+                  writer.ops ? (double)writer.sum_us / (double)writer.ops : 0.0, (unsigned long long)writer.max_us,
+                  (unsigned long long)writer.failed, (unsigned long long)reads);
+    }
+    obj_dict_cleanup_unused(&dict, 0);
+
+    if (torn != 0 || failed != 0) {
+        os_printf("[objdict][PERF] 三缓冲读写异常 torn=%llu failed=%llu\n", (unsigned long long)torn,
+                  (unsigned long long)failed);
+        return -1;
+    }
+    os_printf("[objdict][PERF] 三缓冲一致性检查: 通过\n");
+    return 0;
+}
+
+/*
+ * @brief 普通键写入者：全速写同一键，负载各字段均为写入序号
+ */
+static void* reuse_writer_entry(void* param) {
+    triple_param_t* p = (triple_param_t*)param;
+    test_data_t data;
+    for (uint32_t i = 1; !atomic_load_explicit(p->stop, memory_order_relaxed); ++i) {
+        data.value = i;
+        data.counter = i;
+        memset(data.padding, (uint8_t)i, sizeof(data.padding));
+        if (obj_dict_set(p->dict, p->key, &data, sizeof(data), 0) != 0) p->failed++;
+        p->ops++;
+    }
+    return NULL;
+}
+
+/*
+ * @brief 清理与复用竞争：普通键写入期间反复清理该键并把同一槽位注册为三缓冲键，
+ *        停在快路径中的写入者不能把负载写进三缓冲块
+ * @return 0成功，-1失败
+ */
+static int test_triple_reuse_race(void) {
+    os_printf("\n[objdict][THREAD] 清理后复用为三缓冲键的竞争测试: %d个写入者, %d轮\n", PERF_TEST_REUSE_WRITERS,
+              PERF_TEST_REUSE_ROUNDS);
+
+    obj_dict_entry_t entry_array[4];
+    obj_dict_t dict;
+    if (obj_dict_init(&dict, entry_array, 4) != 0) {
+        os_printf("[objdict][THREAD] 初始化失败\n");
+        return -1;
+    }
+
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    OsThread_t* threads[PERF_TEST_REUSE_WRITERS];
+    triple_param_t writers[PERF_TEST_REUSE_WRITERS];
+    ThreadAttr_t attr = { .pName = "ReuseWriter", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    int created = 0;
+    for (int i = 0; i < PERF_TEST_REUSE_WRITERS; ++i) {
+        memset(&writers[i], 0, sizeof(writers[i]));
+        writers[i].dict = &dict;
+        writers[i].stop = &stop;
+        writers[i].key = 1;
+        threads[i] = os_thread_create(reuse_writer_entry, &writers[i], &attr);
+        if (!threads[i]) break;
+        created++;
+    }
+
+    uint64_t reused = 0;
+    uint64_t torn = 0;
+    for (uint32_t round = 0; created == PERF_TEST_REUSE_WRITERS && round < PERF_TEST_REUSE_ROUNDS; ++round) {
+        obj_dict_cleanup_unused(&dict, 0);
+        if (obj_dict_register_triple(&dict, 1, sizeof(test_data_t)) != 0) continue;  /* 写入者已重新插入普通键 */
+        reused++;
+        /* 三缓冲块完好：读到的要么尚未写入，要么是某次完整写入 */
+        test_data_t out;
+        int len = obj_dict_get(&dict, 1, &out, sizeof(out), NULL, NULL, NULL);
+        if (obj_dict_triple_get_stats(&dict, 1, NULL, NULL) != 0 ||
+            (len != 0 && (len != (int)sizeof(out) || out.value != out.counter ||
+                          out.padding[0] != (uint8_t)out.value || out.padding[55] != (uint8_t)out.value))) {
+            torn++;
+        }
+    }
+    atomic_store_explicit(&stop, 1, memory_order_relaxed);
+    uint64_t writes = 0;
+    for (int i = 0; i < created; ++i) {
+        os_thread_join(threads[i]);
+        os_thread_destroy(threads[i]);
+        writes += writers[i].ops;
+    }
+    obj_dict_cleanup_unused(&dict, 0);
+    if (created != PERF_TEST_REUSE_WRITERS) {
+        os_printf("[objdict][THREAD] 创建线程失败\n");
+        return -1;
+    }
+
+    os_printf("[objdict][THREAD] 复用: writes=%llu reused=%llu torn=%llu\n", (unsigned long long)writes,
+              (unsigned long long)reused, (unsigned long long)torn);
+    if (torn != 0 || reused == 0) {
+        os_printf("[objdict][THREAD] 三缓冲块被普通写入改写\n");
+        return -1;
+    }
+    return 0;
+}
+
+/* ========== 内存池：分配释放耗时与并发正确性 ========== */
+
+static void* mempool_worker_entry(void* param) {
+    mempool_param_t* p = (mempool_param_t*)param;
+    void* held[PERF_TEST_POOL_HOLD];
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        /* 每轮持有若干块并写入自己的标记，归还前复核：块被重复分配时标记会被他人改写 */
+        int n = 0;
+        for (; n < PERF_TEST_POOL_HOLD; ++n) {
+            held[n] = obj_dict_mempool_alloc(p->pool, PERF_TEST_POOL_BLOCK_SIZE);
+            if (!held[n]) break;
+            memset(held[n], p->tag, PERF_TEST_POOL_BLOCK_SIZE);
+            p->ops++;
+        }
+        if (n < PERF_TEST_POOL_HOLD) p->failed++;
+        os_thread_sleep_ms(0);  /* 持有期间让出CPU，让其他线程交错分配释放 */
+        for (int i = 0; i < n; ++i) {
+            const uint8_t* b = (const uint8_t*)held[i];
+            if (b[0] != p->tag || b[PERF_TEST_POOL_BLOCK_SIZE - 1] != p->tag) p->corrupt++;
+            obj_dict_mempool_free(p->pool, held[i]);
+        }
+    }
+    return NULL;
+}
+
+static int test_performance_mempool(void) {
+    os_printf("\n[objdict][PERF] 内存池测试: %d块 x %d字节\n", PERF_TEST_POOL_BLOCKS, PERF_TEST_POOL_BLOCK_SIZE);
+
+    obj_dict_mempool_t* pool = obj_dict_mempool_create(PERF_TEST_POOL_BLOCK_SIZE, PERF_TEST_POOL_BLOCKS);
+    if (!pool) {
+        os_printf("[objdict][PERF] 内存池创建失败\n");
+        return -1;
+    }
+
+    /* 单线程：池满一半时分配+释放一块，与系统堆对照 */
+    void* half[PERF_TEST_POOL_BLOCKS / 2];
+    for (int i = 0; i < PERF_TEST_POOL_BLOCKS / 2; ++i) {
+        half[i] = obj_dict_mempool_alloc(pool, PERF_TEST_POOL_BLOCK_SIZE);
+    }
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS_SINGLE; ++i) {
+        void* b = obj_dict_mempool_alloc(pool, PERF_TEST_POOL_BLOCK_SIZE);
+        obj_dict_mempool_free(pool, b);
+    }
+    uint64_t pool_us = os_monotonic_time_get_microsecond() - start;
+    start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS_SINGLE; ++i) {
+        void* b = os_malloc(PERF_TEST_POOL_BLOCK_SIZE);
+        os_free(b);
+    }
+    uint64_t heap_us = os_monotonic_time_get_microsecond() - start;
+    for (int i = 0; i < PERF_TEST_POOL_BLOCKS / 2; ++i) {
+        obj_dict_mempool_free(pool, half[i]);
+    }
+    os_printf("[objdict][PERF] 分配+释放: 内存池 %.1f ns/次  系统堆 %.1f ns/次\n",
+              (double)pool_us * 1000.0 / PERF_TEST_LOOPS_SINGLE, (double)heap_us * 1000.0 / PERF_TEST_LOOPS_SINGLE);
+
+    /* 并发：线程数 x 持有块数超过池容量，分配会失败，但同一块不得同时分给两个线程 */
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    OsThread_t* threads[PERF_TEST_POOL_THREADS];
+    mempool_param_t params[PERF_TEST_POOL_THREADS];
+    ThreadAttr_t attr = {
+        .pName = "PoolWorker",
+        .Priority = 5,
+        .StackSize = 4096,
+        .ScheduleType = 0
+    };
+    int created = 0;
+    for (int i = 0; i < PERF_TEST_POOL_THREADS; ++i) {
+        memset(&params[i], 0, sizeof(params[i]));
+        params[i].pool = pool;
+        params[i].stop = &stop;
+        params[i].tag = (uint8_t)(0xA0 + i);
+        threads[i] = os_thread_create(mempool_worker_entry, &params[i], &attr);
+        if (!threads[i]) break;
+        created++;
+    }
+    if (created == PERF_TEST_POOL_THREADS) {
+        os_thread_sleep_ms(PERF_TEST_POOL_RUN_MS);
+    }
+    atomic_store_explicit(&stop, 1, memory_order_relaxed);
+    for (int i = 0; i < created; ++i) {
+        os_thread_join(threads[i]);
+        os_thread_destroy(threads[i]);
+    }
+
+    uint64_t allocs = 0, failed = 0, corrupt = 0;
+    for (int i = 0; i < created; ++i) {
+        allocs += params[i].ops;
+        failed += params[i].failed;
+        corrupt += params[i].corrupt;
+    }
+    size_t used = 0;
+    obj_dict_mempool_get_stats(pool, NULL, NULL, &used);
+    obj_dict_mempool_destroy(pool);
+
+    if (created != PERF_TEST_POOL_THREADS) {
+        os_printf("[objdict][PERF] 创建线程失败\n");
+        return -1;
+    }
+    os_printf("[objdict][PERF] 并发分配: threads=%d allocs=%llu 池满=%llu 重复分配=%llu 剩余占用=%zu\n",
+              PERF_TEST_POOL_THREADS, (unsigned long long)allocs, (unsigned long long)failed,
+              (unsigned long long)corrupt, used);
+    if (corrupt != 0 || used != 0) {
+        os_printf("[objdict][PERF] 内存池并发异常\n");
+        return -1;
+    }
+    os_printf("[objdict][PERF] 内存池并发检查: 通过\n");
+    return 0;
+}
+
 /* ========== 主测试入口 ========== */
 
 int obj_dict_perf_test_main(void) {
@@ -489,6 +1623,30 @@ int obj_dict_perf_test_main(void) {
         return -1;
     }
 
+    /* 功能测试：槽位与墓碑 */
+    if (test_functional_slots() != 0) {
+        os_printf("[objdict] 槽位测试失败\n");
+        return -1;
+    }
+
+    /* 功能测试：零拷贝借用 */
+    if (test_functional_borrow() != 0) {
+        os_printf("[objdict] 借用测试失败\n");
+        return -1;
+    }
+
+    /* 功能测试：单写者三缓冲 */
+    if (test_functional_triple() != 0) {
+        os_printf("[objdict] 三缓冲测试失败\n");
+        return -1;
+    }
+
+    /* 功能测试：内存池 */
+    if (test_functional_mempool() != 0) {
+        os_printf("[objdict] 内存池测试失败\n");
+        return -1;
+    }
+
     /* 性能测试：吞吐量 */
     if (test_performance_throughput() != 0) {
         os_printf("[objdict] 吞吐量测试失败\n");
@@ -501,6 +1659,12 @@ int obj_dict_perf_test_main(void) {
         return -1;
     }
 
+    /* 性能测试：键查找 */
+    if (test_performance_lookup() != 0) {
+        os_printf("[objdict] 键查找测试失败\n");
+        return -1;
+    }
+
     /* 版本一致性测试 */
     if (test_version_consistency() != 0) {
         os_printf("[objdict] 版本一致性测试失败\n");
@@ -519,6 +1683,36 @@ int obj_dict_perf_test_main(void) {
         return -1;
     }
 
+    /* 多线程测试：读者扩展性 */
+    if (test_threads_reader_scaling() != 0) {
+        os_printf("[objdict] 读者扩展性测试失败\n");
+        return -1;
+    }
+
+    /* 性能测试：零拷贝借用 */
+    if (test_performance_borrow() != 0) {
+        os_printf("[objdict] 零拷贝借用测试失败\n");
+        return -1;
+    }
+
+    /* 性能测试：单写者三缓冲 */
+    if (test_performance_triple() != 0) {
+        os_printf("[objdict] 三缓冲性能测试失败\n");
+        return -1;
+    }
+
+    /* 多线程测试：清理后复用为三缓冲键 */
+    if (test_triple_reuse_race() != 0) {
+        os_printf("[objdict] 三缓冲复用竞争测试失败\n");
+        return -1;
+    }
+
+    /* 性能测试：内存池 */
+    if (test_performance_mempool() != 0) {
+        os_printf("[objdict] 内存池性能测试失败\n");
+        return -1;
+    }
+
     os_printf("========== ObjDict 测试完成 =========\n\n");
     return 0;
 }
@@ -4,6 +4,7 @@
 #include "ring_buffer.h"
 #include "../../Rte/inc/os_timestamp.h"
 #include "../../Rte/inc/os_printf.h"
+#include "../../Rte/inc/os_thread.h"
 
 typedef struct {
     uint32_t v;
@@ -61,6 +62,36 @@ static int test_functional_basic(void) {
         return -1;
     }
 
+    /* 批量读：跨越环绕位置时顺序保持，数量受max_items限制 */
+    uint32_t seq = 0;
+    for (size_t i = 0; i < cap - 2; ++i) {
+        sample_item_t w = { .v = seq++ };
+        ring_buffer_write(rb, &w);
+    }
+    sample_item_t bulk[16];
+    if (ring_buffer_read_bulk(rb, bulk, cap / 2) != cap / 2) {
+        os_printf("[ringbuf][FUNC] 批量读数量错误\n");
+        ring_buffer_destroy(rb);
+        return -1;
+    }
+    for (size_t i = 0; i < cap / 2; ++i) {
+        sample_item_t w = { .v = seq++ };
+        ring_buffer_write(rb, &w);
+    }
+    size_t n = ring_buffer_read_bulk(rb, bulk, cap);
+    for (size_t i = 0; i < n; ++i) {
+        if (bulk[i].v != (uint32_t)(cap / 2 + i)) {
+            os_printf("[ringbuf][FUNC] 批量读顺序错误 i=%zu v=%u\n", i, bulk[i].v);
+            ring_buffer_destroy(rb);
+            return -1;
+        }
+    }
+    if (n != cap - 2 || ring_buffer_read_bulk(rb, bulk, cap) != 0) {
+        os_printf("[ringbuf][FUNC] 批量读未排空 n=%zu\n", n);
+        ring_buffer_destroy(rb);
+        return -1;
+    }
+
 #if RING_BUFFER_ENABLE_BLOCKING
     /* 阻塞接口：在空情况下读应超时，在满情况下写应超时 */
     sample_item_t it = { .v = 0xA5A5A5A5u };
@@ -179,6 +210,152 @@ static int test_performance_varlen(void) {
     return 0;
 }
 
+#if RING_BUFFER_ENABLE_MPMC
+#define MPMC_TEST_CAPACITY           1024
+#define MPMC_TEST_ITEMS_PER_PRODUCER 200000u
+#define MPMC_TEST_MAX_PRODUCERS      4
+#define MPMC_TEST_MAX_CONSUMERS      2
+
+typedef struct {
+    uint32_t producer;
+    uint32_t seq;
+} mpmc_item_t;
+
+typedef struct {
+    ring_buffer_mpmc_t* rb;
+    uint32_t            id;
+} mpmc_producer_arg_t;
+
+typedef struct {
+    ring_buffer_mpmc_t* rb;
+    atomic_uint*        remaining;                          /* 尚未消费的总数 */
+    uint64_t            seq_sum[MPMC_TEST_MAX_PRODUCERS];   /* 各生产者序号累加 */
+    uint32_t            count[MPMC_TEST_MAX_PRODUCERS];     /* 各生产者消费数 */
+    int                 order_error;                        /* 同一生产者序号逆序 */
+} mpmc_consumer_arg_t;
+
+static void* mpmc_producer_entry(void* param) {
+    mpmc_producer_arg_t* arg = (mpmc_producer_arg_t*)param;
+    for (uint32_t seq = 0; seq < MPMC_TEST_ITEMS_PER_PRODUCER; ++seq) {
+        mpmc_item_t it = { .producer = arg->id, .seq = seq };
+        while (ring_buffer_mpmc_write(arg->rb, &it) != 0) {
+            os_thread_sleep_ms(0);  /* 队列满，让出CPU */
+        }
+    }
+    return NULL;
+}
+
+static void* mpmc_consumer_entry(void* param) {
+    mpmc_consumer_arg_t* arg = (mpmc_consumer_arg_t*)param;
+    int64_t last_seq[MPMC_TEST_MAX_PRODUCERS];
+    for (size_t i = 0; i < MPMC_TEST_MAX_PRODUCERS; ++i) last_seq[i] = -1;
+
+    mpmc_item_t items[32];
+    while (atomic_load_explicit(arg->remaining, memory_order_acquire) > 0) {
+        size_t n = ring_buffer_mpmc_read_bulk(arg->rb, items, sizeof(items) / sizeof(items[0]));
+        if (n == 0) {
+            os_thread_sleep_ms(0);  /* 队列空，让出CPU */
+            continue;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t p = items[i].producer;
+            /* 单个消费者看到的同一生产者序号必须递增 */
+            if (p >= MPMC_TEST_MAX_PRODUCERS || (int64_t)items[i].seq <= last_seq[p]) {
+                arg->order_error = 1;
+                continue;
+            }
+            last_seq[p] = items[i].seq;
+            arg->seq_sum[p] += items[i].seq;
+            arg->count[p]++;
+        }
+        atomic_fetch_sub_explicit(arg->remaining, (unsigned)n, memory_order_acq_rel);
+    }
+    return NULL;
+}
+
+/*
+ * @brief 多生产者/多消费者无锁队列吞吐与正确性测试
+ * @details 每个生产者写入递增序号，校验无丢失、无重复、单生产者内有序
+ * @return 0成功，-1失败
+ */
+static int test_performance_mpmc(void) {
+    os_printf("\n[ringbuf][PERF] 多生产者无锁队列吞吐测试 (cap=%d, 每生产者%u条)\n",
+              MPMC_TEST_CAPACITY, MPMC_TEST_ITEMS_PER_PRODUCER);
+
+    static const uint32_t configs[][2] = { {1, 1}, {2, 1}, {4, 1}, {4, 2} };
+
+    for (size_t ci = 0; ci < sizeof(configs) / sizeof(configs[0]); ++ci) {
+        uint32_t producers = configs[ci][0];
+        uint32_t consumers = configs[ci][1];
+
+        ring_buffer_mpmc_t* rb = ring_buffer_mpmc_create(MPMC_TEST_CAPACITY, sizeof(mpmc_item_t));
+        if (!rb) {
+            os_printf("[ringbuf][PERF] MPMC创建失败\n");
+            return -1;
+        }
+
+        atomic_uint remaining;
+        atomic_init(&remaining, producers * MPMC_TEST_ITEMS_PER_PRODUCER);
+        mpmc_producer_arg_t pargs[MPMC_TEST_MAX_PRODUCERS];
+        mpmc_consumer_arg_t cargs[MPMC_TEST_MAX_CONSUMERS];
+        OsThread_t* pthreads[MPMC_TEST_MAX_PRODUCERS] = {0};
+        OsThread_t* cthreads[MPMC_TEST_MAX_CONSUMERS] = {0};
+        ThreadAttr_t attr = { .pName = "rb_mpmc", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+
+        uint64_t t0 = os_monotonic_time_get_microsecond();
+        for (uint32_t i = 0; i < consumers; ++i) {
+            memset(&cargs[i], 0, sizeof(cargs[i]));
+            cargs[i].rb = rb;
+            cargs[i].remaining = &remaining;
+            cthreads[i] = os_thread_create(mpmc_consumer_entry, &cargs[i], &attr);
+        }
+        for (uint32_t i = 0; i < producers; ++i) {
+            pargs[i].rb = rb;
+            pargs[i].id = i;
+            pthreads[i] = os_thread_create(mpmc_producer_entry, &pargs[i], &attr);
+        }
+        for (uint32_t i = 0; i < producers; ++i) {
+            if (pthreads[i]) {
+                os_thread_join(pthreads[i]);
+                os_thread_destroy(pthreads[i]);
+            }
+        }
+        for (uint32_t i = 0; i < consumers; ++i) {
+            if (cthreads[i]) {
+                os_thread_join(cthreads[i]);
+                os_thread_destroy(cthreads[i]);
+            }
+        }
+        uint64_t t1 = os_monotonic_time_get_microsecond();
+        ring_buffer_mpmc_destroy(rb);
+
+        /* 汇总校验：每个生产者的条目恰好被消费一次 */
+        const uint64_t expect_sum = (uint64_t)MPMC_TEST_ITEMS_PER_PRODUCER * (MPMC_TEST_ITEMS_PER_PRODUCER - 1) / 2;
+        int ok = 1;
+        for (uint32_t p = 0; p < producers; ++p) {
+            uint64_t sum = 0;
+            uint32_t cnt = 0;
+            for (uint32_t c = 0; c < consumers; ++c) {
+                sum += cargs[c].seq_sum[p];
+                cnt += cargs[c].count[p];
+            }
+            if (cnt != MPMC_TEST_ITEMS_PER_PRODUCER || sum != expect_sum) ok = 0;
+        }
+        for (uint32_t c = 0; c < consumers; ++c) {
+            if (cargs[c].order_error) ok = 0;
+        }
+
+        uint64_t us = (t1 > t0) ? (t1 - t0) : 1;
+        double total = (double)producers * MPMC_TEST_ITEMS_PER_PRODUCER;
+        os_printf("[ringbuf][PERF] MPMC %uP/%uC  items=%.0f  time=%llu us  thr=%.2f Mops/s  校验=%s\n",
+                  producers, consumers, total, (unsigned long long)us, total / (double)us, ok ? "通过" : "失败");
+        if (!ok) return -1;
+    }
+
+    return 0;
+}
+#endif
+
 /*
  * @brief 环形队列接口功能与性能测试入口
  * @return 0成功，-1失败
@@ -204,6 +381,14 @@ int ring_buffer_perf_test_main(void) {
         return -1;
     }
 
+#if RING_BUFFER_ENABLE_MPMC
+    /* 性能测试：多生产者/多消费者无锁队列 */
+    if (test_performance_mpmc() != 0) {
+        os_printf("[ringbuf] 多生产者无锁队列测试失败\n");
+        return -1;
+    }
+#endif
+
     os_printf("========== RingBuffer 测试完成 =========\n\n");
     return 0;
 }
@@ -202,6 +202,35 @@ ssize_t ring_buffer_read(ring_buffer_t* rb, void* item_out) {
     return __rb_pop(rb, item_out);
 }
 
+/*
+ * @brief 非阻塞批量读取
+ * @details 只读取一次写索引并只发布一次读索引，环绕时分两段拷贝
+ * @param rb 环形队列句柄
+ * @param items_out 输出缓冲区（容量不小于max_items*item_size）
+ * @param max_items 最多读取的元素个数
+ * @return 实际读取的元素个数，0表示队列空或参数错误
+ */
+size_t ring_buffer_read_bulk(ring_buffer_t* rb, void* items_out, size_t max_items) {
+    if (!rb || !items_out || max_items == 0) return 0;
+
+    size_t w = atomic_load_explicit(&rb->write_idx, memory_order_acquire);
+    size_t r = atomic_load_explicit(&rb->read_idx, memory_order_relaxed);
+    size_t n = w - r;
+    if (n > max_items) n = max_items;
+    if (n == 0) return 0;
+
+    size_t pos = __rb_mask(rb, r);
+    size_t first = rb->capacity - pos;
+    if (first > n) first = n;
+    memcpy(items_out, rb->buffer + pos * rb->item_size, first * rb->item_size);
+    if (n > first) {
+        memcpy((uint8_t*)items_out + first * rb->item_size, rb->buffer, (n - first) * rb->item_size);
+    }
+
+    atomic_store_explicit(&rb->read_idx, r + n, memory_order_release);
+    return n;
+}
+
 #if RING_BUFFER_ENABLE_BLOCKING
 /*
  * @brief 阻塞式写入一个元素
@@ -271,4 +300,158 @@ ssize_t ring_buffer_write_isr(ring_buffer_t* rb, const void* item) {
 }
 #endif
 
+#if RING_BUFFER_ENABLE_MPMC
+/*
+ * 多生产者/多消费者无锁队列（Vyukov有界队列）
+ * 槽位i的序号初始为i：
+ *   seq == pos        槽位空闲，生产者CAS领取enqueue_pos后写入，发布seq = pos + 1
+ *   seq == pos + 1    槽位已写入，消费者CAS领取dequeue_pos后读出，发布seq = pos + capacity
+ * 生产者之间、消费者之间只竞争各自的位置计数，领取成功后独占槽位，不会重复写同一槽位
+ */
+
+/*
+ * @brief 取得槽位序号
+ */
+static atomic_size_t* __mpmc_slot_seq(const ring_buffer_mpmc_t* rb, size_t pos) {
+    return (atomic_size_t*)(rb->buffer + (pos & (rb->capacity - 1)) * rb->slot_size);
+}
 
+/*
+ * @brief 取得槽位数据区
+ */
+static uint8_t* __mpmc_slot_data(const ring_buffer_mpmc_t* rb, size_t pos) {
+    return rb->buffer + (pos & (rb->capacity - 1)) * rb->slot_size + sizeof(atomic_size_t);
+}
+
+/*
+ * @brief 创建多生产者/多消费者队列
+ * @param capacity 元素容量（必须为2的幂）
+ * @param item_size 单个元素大小（字节），为0则采用默认
+ * @return 成功返回队列指针，失败返回NULL
+ */
+ring_buffer_mpmc_t* ring_buffer_mpmc_create(size_t capacity, size_t item_size) {
+    if (item_size == 0) {
+        item_size = RING_BUFFER_DEFAULT_ITEM_SIZE;
+    }
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+        return NULL;
+    }
+    ring_buffer_mpmc_t* rb = (ring_buffer_mpmc_t*)os_malloc(sizeof(ring_buffer_mpmc_t));
+    if (!rb) return NULL;
+    memset(rb, 0, sizeof(*rb));
+
+    /* 槽位按序号对齐，保证序号原子访问对齐 */
+    size_t align = sizeof(atomic_size_t);
+    rb->slot_size = (sizeof(atomic_size_t) + item_size + align - 1) & ~(align - 1);
+    rb->buffer = (uint8_t*)os_malloc(capacity * rb->slot_size);
+    if (!rb->buffer) {
+        os_free(rb);
+        return NULL;
+    }
+    rb->capacity  = capacity;
+    rb->item_size = item_size;
+    for (size_t i = 0; i < capacity; ++i) {
+        atomic_init(__mpmc_slot_seq(rb, i), i);
+    }
+    atomic_init(&rb->enqueue_pos, 0);
+    atomic_init(&rb->dequeue_pos, 0);
+    return rb;
+}
+
+/*
+ * @brief 销毁多生产者/多消费者队列
+ * @param rb 队列句柄
+ */
+void ring_buffer_mpmc_destroy(ring_buffer_mpmc_t* rb) {
+    if (!rb) return;
+    if (rb->buffer) os_free(rb->buffer);
+    os_free(rb);
+}
+
+/*
+ * @brief 无锁写入一个元素（可在ISR与任意线程中并发调用）
+ * @param rb 队列句柄
+ * @param item 元素指针
+ * @return 0成功，-1失败（队列满或参数错误）
+ */
+ssize_t ring_buffer_mpmc_write(ring_buffer_mpmc_t* rb, const void* item) {
+    if (!rb || !item) return -1;
+
+    size_t pos = atomic_load_explicit(&rb->enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        atomic_size_t* seq_ptr = __mpmc_slot_seq(rb, pos);
+        size_t seq = atomic_load_explicit(seq_ptr, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            /* 槽位空闲，尝试领取；失败时pos被更新为最新位置 */
+            if (atomic_compare_exchange_weak_explicit(&rb->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(__mpmc_slot_data(rb, pos), item, rb->item_size);
+                atomic_store_explicit(seq_ptr, pos + 1, memory_order_release);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return -1;  /* 上一圈的数据尚未被消费：队列满 */
+        } else {
+            pos = atomic_load_explicit(&rb->enqueue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * @brief 无锁读取一个元素（可在任意线程中并发调用）
+ * @param rb 队列句柄
+ * @param item_out 输出缓冲区
+ * @return 0成功，-1失败（队列空或参数错误）
+ */
+ssize_t ring_buffer_mpmc_read(ring_buffer_mpmc_t* rb, void* item_out) {
+    if (!rb || !item_out) return -1;
+
+    size_t pos = atomic_load_explicit(&rb->dequeue_pos, memory_order_relaxed);
+    for (;;) {
+        atomic_size_t* seq_ptr = __mpmc_slot_seq(rb, pos);
+        size_t seq = atomic_load_explicit(seq_ptr, memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&rb->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                memcpy(item_out, __mpmc_slot_data(rb, pos), rb->item_size);
+                atomic_store_explicit(seq_ptr, pos + rb->capacity, memory_order_release);
+                return 0;
+            }
+        } else if (diff < 0) {
+            return -1;  /* 槽位尚未写入：队列空（或生产者正在写入） */
+        } else {
+            pos = atomic_load_explicit(&rb->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/*
+ * @brief 无锁批量读取
+ * @param rb 队列句柄
+ * @param items_out 输出缓冲区（容量不小于max_items*item_size）
+ * @param max_items 最多读取的元素个数
+ * @return 实际读取的元素个数
+ */
+size_t ring_buffer_mpmc_read_bulk(ring_buffer_mpmc_t* rb, void* items_out, size_t max_items) {
+    if (!rb || !items_out) return 0;
+    size_t n = 0;
+    uint8_t* out = (uint8_t*)items_out;
+    while (n < max_items && ring_buffer_mpmc_read(rb, out + n * rb->item_size) == 0) {
+        ++n;
+    }
+    return n;
+}
+
+/*
+ * @brief 获取当前已存元素个数（并发读写时为近似值）
+ * @param rb 队列句柄
+ * @return 已存元素数量
+ */
+size_t ring_buffer_mpmc_get_count(const ring_buffer_mpmc_t* rb) {
+    size_t e = atomic_load_explicit(&rb->enqueue_pos, memory_order_relaxed);
+    size_t d = atomic_load_explicit(&rb->dequeue_pos, memory_order_relaxed);
+    return (e > d) ? (e - d) : 0;
+}
+#endif
@@ -24,6 +24,21 @@ typedef struct {
 #endif
 } ring_buffer_t;
 
+#if RING_BUFFER_ENABLE_MPMC
+/* 多生产者/多消费者无锁队列：每个槽位携带序号，生产者与消费者各自CAS领取位置 */
+typedef struct {
+    uint8_t*            buffer;        /* 槽位数组：序号 + 元素数据 */
+    size_t              capacity;      /* 元素容量(个)，必须为2的幂 */
+    size_t              item_size;     /* 单个元素大小(字节) */
+    size_t              slot_size;     /* 单个槽位大小(字节) */
+    uint8_t             pad0[RING_BUFFER_CACHE_LINE_SIZE];
+    atomic_size_t       enqueue_pos;   /* 生产者领取位置 */
+    uint8_t             pad1[RING_BUFFER_CACHE_LINE_SIZE - sizeof(atomic_size_t)];
+    atomic_size_t       dequeue_pos;   /* 消费者领取位置 */
+    uint8_t             pad2[RING_BUFFER_CACHE_LINE_SIZE - sizeof(atomic_size_t)];
+} ring_buffer_mpmc_t;
+#endif
+
 /* 创建/销毁 */
 ring_buffer_t* ring_buffer_create(size_t capacity, size_t item_size);
 void ring_buffer_destroy(ring_buffer_t* rb);
@@ -32,6 +47,9 @@ void ring_buffer_destroy(ring_buffer_t* rb);
 ssize_t ring_buffer_write(ring_buffer_t* rb, const void* item);
 ssize_t ring_buffer_read(ring_buffer_t* rb, void* item_out);
 
+/* 非阻塞批量读取：最多读取max_items个元素，返回实际读取数量 */
+size_t ring_buffer_read_bulk(ring_buffer_t* rb, void* items_out, size_t max_items);
+
 /* 阻塞API：等待毫秒，UINT32_MAX表示无限等待。返回0成功，-1失败/超时 */
 #if RING_BUFFER_ENABLE_BLOCKING
 ssize_t ring_buffer_write_blocking(ring_buffer_t* rb, const void* item, uint32_t timeout_ms);
@@ -43,6 +61,16 @@ ssize_t ring_buffer_read_blocking(ring_buffer_t* rb, void* item_out, uint32_t ti
 ssize_t ring_buffer_write_isr(ring_buffer_t* rb, const void* item);
 #endif
 
+#if RING_BUFFER_ENABLE_MPMC
+/* 多生产者/多消费者：任意数量的ISR与线程可并发读写，无锁，均为非阻塞。成功返回0，失败返回-1 */
+ring_buffer_mpmc_t* ring_buffer_mpmc_create(size_t capacity, size_t item_size);
+void    ring_buffer_mpmc_destroy(ring_buffer_mpmc_t* rb);
+ssize_t ring_buffer_mpmc_write(ring_buffer_mpmc_t* rb, const void* item);
+ssize_t ring_buffer_mpmc_read(ring_buffer_mpmc_t* rb, void* item_out);
+size_t  ring_buffer_mpmc_read_bulk(ring_buffer_mpmc_t* rb, void* items_out, size_t max_items);
+size_t  ring_buffer_mpmc_get_count(const ring_buffer_mpmc_t* rb);
+#endif
+
 /* 查询/维护 */
 size_t ring_buffer_get_count(const ring_buffer_t* rb);
 size_t ring_buffer_get_space(const ring_buffer_t* rb);
@@ -21,6 +21,16 @@
 #define RING_BUFFER_ENABLE_ZEROCOPY 1
 #endif
 
+/* 是否启用多生产者/多消费者无锁队列(按槽位序号，Vyukov算法) */
+#ifndef RING_BUFFER_ENABLE_MPMC
+#define RING_BUFFER_ENABLE_MPMC 1
+#endif
+
+/* 缓存行大小(字节)，用于隔离生产/消费索引避免伪共享 */
+#ifndef RING_BUFFER_CACHE_LINE_SIZE
+#define RING_BUFFER_CACHE_LINE_SIZE 64
+#endif
+
 /* 默认元素大小(字节)，仅在创建时未指定时生效 */
 #ifndef RING_BUFFER_DEFAULT_ITEM_SIZE
 #define RING_BUFFER_DEFAULT_ITEM_SIZE sizeof(uintptr_t)
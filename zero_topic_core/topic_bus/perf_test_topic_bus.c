@@ -1,14 +1,37 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stdatomic.h>
 #include "topic_bus.h"
 #include "topic_server.h"
 #include "topic_router.h"
+#include "topic_trace.h"
+#include "topic_shm.h"
+#include "topic_bridge.h"
+#include "topic_serial.h"
+#include "topic_record.h"
+#include "perf_test_topic_table.h"
 #include "../obj_dict/obj_dict.h"
 #include "../../Rte/inc/os_timestamp.h"
 #include "../../Rte/inc/os_printf.h"
 #include "../../Rte/inc/os_thread.h"
+#include "../../Rte/inc/os_heap.h"
+#include "../../Rte/inc/os_file.h"
+#if TOPIC_BUS_ENABLE_SHM || TOPIC_BUS_ENABLE_BRIDGE
+#include <unistd.h>
+#include <signal.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#endif
+#if TOPIC_BUS_ENABLE_SERIAL
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#endif
 
 /* 诊断打印辅助（仅当启用统计与诊断时有效） */
 #if TOPIC_BUS_ENABLE_STATS && TOPIC_BUS_ENABLE_DIAG
@@ -39,6 +62,66 @@ static void print_topic_diag(topic_bus_t* bus, uint16_t topic_id) { (void)bus; (
 #define PERF_TEST_MAX_SUBSCRIBERS 8
 #define PERF_TEST_LOOPS           100000
 #define PERF_TEST_EVENT_COUNT     100
+#define PERF_TEST_SCALE_LOOPS     100000
+#define PERF_TEST_CHURN_PUBLISHERS 2
+#define PERF_TEST_CHURN_DURATION_MS 500
+#define PERF_TEST_LOAN_LOOPS      20000
+#define PERF_TEST_LOAN_BLOCKS     8
+#define PERF_TEST_DRAIN_ROUNDS    20000
+#define PERF_TEST_DRAIN_KEYS      4
+#define PERF_TEST_ISR_PRODUCERS   4
+#define PERF_TEST_ISR_PER_PRODUCER 20000
+#define PERF_TEST_LATENCY_SAMPLES 500
+#define PERF_TEST_LATENCY_POLL_MS 10
+#define PERF_TEST_LATENCY_IDLE_MS 300
+#define PERF_TEST_EXEC_EVENTS     50
+#define PERF_TEST_EXEC_SLOW_MS    1
+#define PERF_TEST_EXEC_WAIT_MS    3000
+#define PERF_TEST_STATIC_LOOPS    100000
+#define PERF_TEST_AND_EVENTS      4
+#define PERF_TEST_AND_FILLER_KEYS 64
+#define PERF_TEST_RULE_WIDE_EVENTS 40
+#define PERF_TEST_RULE_BURST      10
+#define PERF_TEST_RULE_INTERVAL_MS 50
+#define PERF_TEST_RULE_WINDOW_MS  200
+#define PERF_TEST_STORM_LOOPS     20000
+#define PERF_TEST_STORM_WORK_US   5
+#define PERF_TEST_HIST_LOOPS      200
+#define PERF_TEST_HIST_SLOW_US    200
+#define PERF_TEST_TRACE_LOOPS     20
+#define PERF_TEST_TRACE_RECORDS   1000000
+#define PERF_TEST_TRACE_FILE      "topic_trace.json"
+#define PERF_TEST_ROUTER_BATCH_TOPICS 3
+#define PERF_TEST_ROUTER_MAX_ROUTES 512
+#define PERF_TEST_ROUTER_SEND_US  2
+#define PERF_TEST_ROUTER_BATCH_COUNT 16
+#define PERF_TEST_ROUTER_CHURN_LOOPS 200000
+#define PERF_TEST_HISTORY_DEPTH   4
+#define PERF_TEST_HISTORY_LOOPS   100000
+#define PERF_TEST_RANGE_BLOCK     32
+#define PERF_TEST_RANGE_TOPICS    256
+#define PERF_TEST_RANGE_MAX_SUBS  1024
+#define PERF_TEST_RANGE_LOOPS     100000
+#define PERF_TEST_RECORD_FILE     "topic_record.bin"
+#define PERF_TEST_RECORD_CAPACITY (8 * 1024 * 1024)
+#define PERF_TEST_RECORD_LOOPS    100000
+#define PERF_TEST_RECORD_PACED    200
+#define PERF_TEST_RECORD_PERIOD_US 500
+#define PERF_TEST_SHM_NAME        "/dev/shm/zero_topic_perf_shm"
+#define PERF_TEST_SHM_PINGS       1000
+#define PERF_TEST_SHM_MESSAGES    100000
+#define PERF_TEST_SHM_BURST       256
+#define PERF_TEST_SHM_PAYLOAD     64
+#define PERF_TEST_SHM_WAIT_MS     5000
+#define PERF_TEST_BRIDGE_PORT     47810
+#define PERF_TEST_BRIDGE_TOPICS   4
+#define PERF_TEST_BRIDGE_RECORDS  100000
+#define PERF_TEST_BRIDGE_WAIT_MS  5000
+#define PERF_TEST_SERIAL_LINK     4096
+#define PERF_TEST_SERIAL_CHUNK    64
+#define PERF_TEST_SERIAL_FRAMES   50000
+#define PERF_TEST_SERIAL_PAYLOAD  32
+#define PERF_TEST_SERIAL_WAIT_MS  5000
 
 /* 测试Topic ID枚举 */
 typedef enum {
@@ -55,12 +138,54 @@ typedef enum {
     TEST_TOPIC_ID_ROUTER_VFB = 1,
     TEST_TOPIC_ID_ROUTER_CUSTOM = 1,
     TEST_TOPIC_ID_ROUTER_MULTIPLE = 1,
+    TEST_TOPIC_ID_ROUTER_BATCH_BASE = 1,
     TEST_TOPIC_ID_ISR = 1,
     TEST_TOPIC_ID_PERF_TIMEOUT = 1,
+    TEST_TOPIC_ID_PERF_TIMEOUT_AND = 2,
+    TEST_TOPIC_ID_RULE_WIDE_AND = 1,
+    TEST_TOPIC_ID_RULE_WINDOW = 2,
+    TEST_TOPIC_ID_RULE_DEBOUNCE = 3,
+    TEST_TOPIC_ID_RULE_THROTTLE = 4,
+    TEST_TOPIC_ID_RULE_EDGE = 5,
+    TEST_TOPIC_ID_STORM = 1,
+    TEST_TOPIC_ID_HIST = 1,
+    TEST_TOPIC_ID_TRACE = 1,
     TEST_TOPIC_ID_PERF_EVENT_PUBLISH_BASE = 1,
     TEST_TOPIC_ID_PERF_RULE_MATCHING_OR_BASE = 1,
     TEST_TOPIC_ID_PERF_RULE_MATCHING_AND = 100,
     TEST_TOPIC_ID_CONCURRENT_BASE = 1,
+    TEST_TOPIC_ID_PERF_SCALE_BASE = 1,
+    TEST_TOPIC_ID_CHURN = 1,
+    TEST_TOPIC_ID_LOAN = 1,
+    TEST_TOPIC_ID_DRAIN_BASE = 1,
+    TEST_TOPIC_ID_LATENCY = 1,
+    TEST_TOPIC_ID_EXEC_SLOW = 1,
+    TEST_TOPIC_ID_EXEC_DROP = 2,
+    TEST_TOPIC_ID_STATIC_OR = 1,        /* 与perf_test_topic_table.json一致 */
+    TEST_TOPIC_ID_STATIC_AND = 7,
+    TEST_TOPIC_ID_STATIC_MANUAL = 3,
+    TEST_TOPIC_ID_STATIC_NO_SUBS = 40,
+    TEST_TOPIC_ID_STATIC_DUP = 120,
+    TEST_TOPIC_ID_SHM_OR = 1,
+    TEST_TOPIC_ID_SHM_AND = 2,
+    TEST_TOPIC_ID_SHM_PING = 1,
+    TEST_TOPIC_ID_SHM_PONG = 2,
+    TEST_TOPIC_ID_SHM_DATA = 3,
+    TEST_TOPIC_ID_SHM_STOP = 4,
+    TEST_TOPIC_ID_SHM_RESULT = 5,
+    TEST_TOPIC_ID_BRIDGE_BASE = 1,      /* 1..PERF_TEST_BRIDGE_TOPICS */
+    TEST_TOPIC_ID_BRIDGE_STOP = 5,
+    TEST_TOPIC_ID_BRIDGE_UNMAPPED = 6,
+    TEST_TOPIC_ID_SERIAL = 1,
+    TEST_TOPIC_ID_SERIAL_UNMAPPED = 2,
+    TEST_TOPIC_ID_HISTORY = 1,
+    TEST_TOPIC_ID_HISTORY_NONE = 2,
+    TEST_TOPIC_ID_RANGE_A = 0x1000,     /* 0x1000..0x101F，性能测试为0x1000..0x10FF */
+    TEST_TOPIC_ID_RANGE_B = 0x2000,     /* 0x2000..0x201F */
+    TEST_TOPIC_ID_RECORD_OR = 1,
+    TEST_TOPIC_ID_RECORD_AND = 2,
+    TEST_TOPIC_ID_RECORD_MANUAL = 3,
+    TEST_TOPIC_ID_RECORD_LOAN = 4,
     TEST_TOPIC_ID_MAX = 100
 } test_topic_id_t;
 
@@ -83,8 +208,21 @@ typedef enum {
     TEST_EVENT_ID_ROUTER_VFB = 200,
     TEST_EVENT_ID_ROUTER_CUSTOM = 300,
     TEST_EVENT_ID_ROUTER_MULTIPLE = 400,
+    TEST_EVENT_ID_ROUTER_BATCH = 410,
     TEST_EVENT_ID_ISR = 500,
     TEST_EVENT_ID_PERF_TIMEOUT = 600,
+    TEST_EVENT_ID_PERF_TIMEOUT_AND_BASE = 610,
+    TEST_EVENT_ID_PERF_TIMEOUT_FILLER_BASE = 1100,
+    TEST_EVENT_ID_RULE_WIDE_BASE = 1200,    /* 1200..1239 */
+    TEST_EVENT_ID_RULE_WINDOW_1 = 1250,
+    TEST_EVENT_ID_RULE_WINDOW_2 = 1251,
+    TEST_EVENT_ID_RULE_WINDOW_3 = 1252,
+    TEST_EVENT_ID_RULE_DEBOUNCE = 1253,
+    TEST_EVENT_ID_RULE_THROTTLE = 1254,
+    TEST_EVENT_ID_RULE_EDGE = 1255,
+    TEST_EVENT_ID_STORM = 1260,
+    TEST_EVENT_ID_HIST = 1270,
+    TEST_EVENT_ID_TRACE = 1280,
     TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE = 10,
     TEST_EVENT_ID_PERF_EVENT_PUBLISH_OFFSET = 20,
     TEST_EVENT_ID_PERF_RULE_MATCHING_OR = 15,
@@ -92,6 +230,42 @@ typedef enum {
     TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2 = 50,
     TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3 = 60,
     TEST_EVENT_ID_CONCURRENT_BASE = 700,
+    TEST_EVENT_ID_PERF_SCALE_HOT = 800,
+    TEST_EVENT_ID_CHURN = 900,
+    TEST_EVENT_ID_LOAN = 950,
+    TEST_EVENT_ID_DRAIN_BASE = 960,
+    TEST_EVENT_ID_LATENCY = 970,
+    TEST_EVENT_ID_EXEC_SLOW = 980,
+    TEST_EVENT_ID_EXEC_DROP = 981,
+    TEST_EVENT_ID_PERF_SCALE_BASE = 1000,
+    TEST_EVENT_ID_STATIC_OR = 1500,     /* 与perf_test_topic_table.json一致 */
+    TEST_EVENT_ID_STATIC_SHARED = 1501,
+    TEST_EVENT_ID_STATIC_AND_1 = 1502,
+    TEST_EVENT_ID_STATIC_AND_2 = 1503,
+    TEST_EVENT_ID_STATIC_UNKNOWN = 1599,
+    TEST_EVENT_ID_SHM_OR = 1600,
+    TEST_EVENT_ID_SHM_AND_1 = 1601,
+    TEST_EVENT_ID_SHM_AND_2 = 1602,
+    TEST_EVENT_ID_SHM_PING = 1610,
+    TEST_EVENT_ID_SHM_PONG = 1611,
+    TEST_EVENT_ID_SHM_DATA = 1612,
+    TEST_EVENT_ID_SHM_STOP = 1613,
+    TEST_EVENT_ID_SHM_RESULT = 1614,
+    TEST_EVENT_ID_BRIDGE_BASE = 1620,           /* 发送端 1620..1623 */
+    TEST_EVENT_ID_BRIDGE_STOP = 1624,
+    TEST_EVENT_ID_BRIDGE_UNMAPPED = 1625,
+    TEST_EVENT_ID_BRIDGE_REMOTE_BASE = 1630,    /* 接收端 1630..1633 */
+    TEST_EVENT_ID_BRIDGE_REMOTE_STOP = 1634,
+    TEST_EVENT_ID_SERIAL = 1640,
+    TEST_EVENT_ID_SERIAL_REMOTE = 1641,
+    TEST_EVENT_ID_HISTORY = 1650,
+    TEST_EVENT_ID_HISTORY_NONE = 1651,
+    TEST_EVENT_ID_RANGE_BASE = 1700,            /* A段1700..1731，B段1732..1763 */
+    TEST_EVENT_ID_RANGE_PERF_BASE = 1800,       /* 1800..2055 */
+    TEST_EVENT_ID_RECORD_OR = 1660,
+    TEST_EVENT_ID_RECORD_AND_1 = 1661,
+    TEST_EVENT_ID_RECORD_AND_2 = 1662,
+    TEST_EVENT_ID_RECORD_LOAN = 1663,
     TEST_EVENT_ID_MAX = 1000
 } test_event_id_t;
 
@@ -117,6 +291,14 @@ static void test_callback(uint16_t topic_id, const void* data, size_t data_len,
     atomic_fetch_add_explicit(&callback_count, 1, memory_order_relaxed);
 }
 
+/* 回调内取消自身订阅：旧订阅者数组在本次分发的读区内退役 */
+static void self_unsub_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)data;
+    (void)data_len;
+    topic_unsubscribe((topic_bus_t*)user, topic_id, self_unsub_callback, user);
+    atomic_fetch_add_explicit(&callback_count, 1, memory_order_relaxed);
+}
+
 /* ---------------- 基础功能测试 ---------------- */
 
 static int test_functional_basic(void) {
@@ -245,6 +427,19 @@ static int test_functional_basic(void) {
     /* 打印MANUAL Topic诊断信息 */
     print_topic_diag(&bus, TEST_TOPIC_ID_MANUAL_BASIC);
 
+    /* 测试：回调内取消订阅时旧数组无法立即回收，之后的发布顺带回收，不必等下一次订阅变更 */
+    topic_subscribe(&bus, TEST_TOPIC_ID_OR_BASIC, self_unsub_callback, &bus);
+    obj_dict_set(&dict, TEST_EVENT_ID_OR_2, &event_data, sizeof(event_data), 0);
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    topic_publish_event(&bus, TEST_EVENT_ID_OR_1);
+    int retired = (bus.rcu_retired != NULL);
+    topic_publish_event(&bus, TEST_EVENT_ID_OR_2);
+    if (atomic_load_explicit(&callback_count, memory_order_acquire) != 3 || !retired || bus.rcu_retired != NULL) {
+        os_printf("[topic][FUNC] 退役订阅者数组未被发布路径回收 count=%u retired=%d\n",
+                  atomic_load_explicit(&callback_count, memory_order_acquire), retired);
+        return -1;
+    }
+
     os_printf("[topic][FUNC] 基础功能测试: 通过\n");
     return 0;
 }
@@ -277,6 +472,14 @@ static int test_timeout_default(void) {
     topic_rule_create(&bus, TEST_TOPIC_ID_TIMEOUT_DEFAULT, &rule);
     topic_subscribe(&bus, TEST_TOPIC_ID_TIMEOUT_DEFAULT, test_callback, NULL);
 
+    /* 事件尚未写入对象字典，有超时配置时不触发 */
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    topic_publish_event(&bus, TEST_EVENT_ID_TIMEOUT_DEFAULT);
+    if (atomic_load_explicit(&callback_count, memory_order_acquire) != 0) {
+        os_printf("[topic][TIMEOUT] 事件未写入时不应触发\n");
+        return -1;
+    }
+
     test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
     obj_dict_set(&dict, TEST_EVENT_ID_TIMEOUT_DEFAULT, &event_data, sizeof(event_data), 0);
 
@@ -393,6 +596,14 @@ static int test_timeout_max(void) {
     topic_rule_create(&bus, TEST_TOPIC_ID_TIMEOUT_MAX, &rule);
     topic_subscribe(&bus, TEST_TOPIC_ID_TIMEOUT_MAX, test_callback, NULL);
 
+    /* 事件尚未写入对象字典时也应触发（负载为空） */
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    topic_publish_event(&bus, TEST_EVENT_ID_TIMEOUT_MAX);
+    if (atomic_load_explicit(&callback_count, memory_order_acquire) != 1) {
+        os_printf("[topic][TIMEOUT] 最大延迟宏在事件未写入时应触发\n");
+        return -1;
+    }
+
     test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
     obj_dict_set(&dict, TEST_EVENT_ID_TIMEOUT_MAX, &event_data, sizeof(event_data), 0);
 
@@ -524,15 +735,30 @@ static int test_shared_event_key(void) {
     return 0;
 }
 
-/* ---------------- Topic Server测试 ---------------- */
+/* ---------------- 扩展规则测试 ---------------- */
+
+static void rule_ext_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    atomic_fetch_add_explicit((atomic_uint*)user, 1, memory_order_relaxed);
+}
 
-#if TOPIC_BUS_ENABLE_SERVER
 /*
- * @brief 测试Topic Server周期性运行（4.1）
+ * @brief 写入对象字典并发布事件
+ */
+static void rule_ext_publish(topic_bus_t* bus, obj_dict_t* dict, obj_dict_key_t key, uint32_t value) {
+    test_event_data_t event_data = { .value = value, .counter = 0 };
+    obj_dict_set(dict, key, &event_data, sizeof(event_data), 0);
+    topic_publish_event(bus, key);
+}
+
+/*
+ * @brief 扩展规则测试：40事件AND、N-of-M窗口、去抖、限频、边沿
  * @return 0成功，-1失败
  */
-static int test_server_periodic(void) {
-    os_printf("\n[topic][SERVER] Server周期性运行测试\n");
+static int test_rule_extended(void) {
+    os_printf("\n[topic][RULE] 扩展规则测试: 宽AND/WINDOW/DEBOUNCE/THROTTLE/EDGE\n");
 
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
@@ -542,37 +768,148 @@ static int test_server_periodic(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
-    topic_server_t server;
-    if (topic_server_init(&server, &bus, 100) != 0) {
-        os_printf("[topic][SERVER] Server初始化失败\n");
+    static atomic_uint wide_count, window_count, debounce_count, throttle_count, edge_count;
+    atomic_store(&wide_count, 0);
+    atomic_store(&window_count, 0);
+    atomic_store(&debounce_count, 0);
+    atomic_store(&throttle_count, 0);
+    atomic_store(&edge_count, 0);
+
+    obj_dict_key_t wide_events[PERF_TEST_RULE_WIDE_EVENTS];
+    for (int i = 0; i < PERF_TEST_RULE_WIDE_EVENTS; ++i) {
+        wide_events[i] = (obj_dict_key_t)(TEST_EVENT_ID_RULE_WIDE_BASE + i);
+    }
+    topic_rule_t rule_wide = { .type = TOPIC_RULE_AND, .events = wide_events, .event_count = PERF_TEST_RULE_WIDE_EVENTS };
+    obj_dict_key_t window_events[] = {TEST_EVENT_ID_RULE_WINDOW_1, TEST_EVENT_ID_RULE_WINDOW_2, TEST_EVENT_ID_RULE_WINDOW_3};
+    topic_rule_t rule_window = { .type = TOPIC_RULE_WINDOW, .events = window_events, .event_count = 3,
+                                 .interval_ms = PERF_TEST_RULE_WINDOW_MS, .min_count = 2 };
+    obj_dict_key_t debounce_events[] = {TEST_EVENT_ID_RULE_DEBOUNCE};
+    topic_rule_t rule_debounce = { .type = TOPIC_RULE_DEBOUNCE, .events = debounce_events, .event_count = 1,
+                                   .interval_ms = PERF_TEST_RULE_INTERVAL_MS };
+    obj_dict_key_t throttle_events[] = {TEST_EVENT_ID_RULE_THROTTLE};
+    topic_rule_t rule_throttle = { .type = TOPIC_RULE_THROTTLE, .events = throttle_events, .event_count = 1,
+                                   .interval_ms = PERF_TEST_RULE_INTERVAL_MS };
+    obj_dict_key_t edge_events[] = {TEST_EVENT_ID_RULE_EDGE};
+    topic_rule_t rule_edge = { .type = TOPIC_RULE_EDGE, .events = edge_events, .event_count = 1 };
+
+    if (topic_rule_create(&bus, TEST_TOPIC_ID_RULE_WIDE_AND, &rule_wide) != 0 ||
+        topic_rule_create(&bus, TEST_TOPIC_ID_RULE_WINDOW, &rule_window) != 0 ||
+        topic_rule_create(&bus, TEST_TOPIC_ID_RULE_DEBOUNCE, &rule_debounce) != 0 ||
+        topic_rule_create(&bus, TEST_TOPIC_ID_RULE_THROTTLE, &rule_throttle) != 0 ||
+        topic_rule_create(&bus, TEST_TOPIC_ID_RULE_EDGE, &rule_edge) != 0) {
+        os_printf("[topic][RULE] 规则创建失败\n");
+        topic_bus_deinit(&bus);
         return -1;
     }
+    topic_subscribe(&bus, TEST_TOPIC_ID_RULE_WIDE_AND, rule_ext_callback, &wide_count);
+    topic_subscribe(&bus, TEST_TOPIC_ID_RULE_WINDOW, rule_ext_callback, &window_count);
+    topic_subscribe(&bus, TEST_TOPIC_ID_RULE_DEBOUNCE, rule_ext_callback, &debounce_count);
+    topic_subscribe(&bus, TEST_TOPIC_ID_RULE_THROTTLE, rule_ext_callback, &throttle_count);
+    topic_subscribe(&bus, TEST_TOPIC_ID_RULE_EDGE, rule_ext_callback, &edge_count);
 
-#if TOPIC_BUS_ENABLE_ISR
-    /* 模拟ISR发布事件 */
-    topic_publish_isr(&bus, TEST_EVENT_ID_SERVER);
-    topic_publish_isr(&bus, (obj_dict_key_t)(TEST_EVENT_ID_SERVER + 1));
+    int ret = 0;
 
-    /* 运行Server一次，处理ISR队列 */
-    int processed = topic_server_run_once(&server);
-    if (processed <= 0) {
-        os_printf("[topic][SERVER] Server未处理事件\n");
-        return -1;
+    /* 宽AND：第32个之后的事件同样参与掩码，集齐40个才触发 */
+    for (int i = 0; i < PERF_TEST_RULE_WIDE_EVENTS - 1; ++i) {
+        rule_ext_publish(&bus, &dict, wide_events[i], (uint32_t)i);
+    }
+    unsigned wide_partial = atomic_load(&wide_count);
+    rule_ext_publish(&bus, &dict, wide_events[PERF_TEST_RULE_WIDE_EVENTS - 1], 0);
+    if (wide_partial != 0 || atomic_load(&wide_count) != 1) {
+        os_printf("[topic][RULE] 40事件AND触发错误: 缺1个=%u 集齐=%u\n", wide_partial, atomic_load(&wide_count));
+        ret = -1;
+    }
+
+    /* WINDOW(2-of-3)：同一事件重复发布不计数，上次触发已计入的事件不再计数，窗口外事件不计数 */
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_1, 1);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_1, 2);
+    unsigned window_single = atomic_load(&window_count);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_2, 3);   /* 1+2 -> 触发 */
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_2, 4);   /* 仅2为新事件 */
+    unsigned window_after = atomic_load(&window_count);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_3, 5);   /* 2+3 -> 触发 */
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_1, 6);
+    os_thread_sleep_ms(PERF_TEST_RULE_WINDOW_MS + 50);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_WINDOW_2, 7);   /* 1已在窗口外 */
+    if (window_single != 0 || window_after != 1 || atomic_load(&window_count) != 2) {
+        os_printf("[topic][RULE] WINDOW触发错误: %u/%u/%u (期望 0/1/2)\n",
+                  window_single, window_after, atomic_load(&window_count));
+        ret = -1;
+    }
+
+    /* DEBOUNCE：连续突发只在开头触发一次，静默期后再次触发 */
+    for (int i = 0; i < PERF_TEST_RULE_BURST; ++i) {
+        rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_DEBOUNCE, (uint32_t)i);
+    }
+    unsigned debounce_burst = atomic_load(&debounce_count);
+    os_thread_sleep_ms(PERF_TEST_RULE_INTERVAL_MS + 30);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_DEBOUNCE, 0);
+    if (debounce_burst != 1 || atomic_load(&debounce_count) != 2) {
+        os_printf("[topic][RULE] DEBOUNCE触发错误: 突发=%u 静默后=%u\n", debounce_burst, atomic_load(&debounce_count));
+        ret = -1;
+    }
+
+    /* THROTTLE：间隔内只触发一次 */
+    for (int i = 0; i < PERF_TEST_RULE_BURST; ++i) {
+        rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_THROTTLE, (uint32_t)i);
+    }
+    unsigned throttle_burst = atomic_load(&throttle_count);
+    os_thread_sleep_ms(PERF_TEST_RULE_INTERVAL_MS + 10);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_THROTTLE, 0);
+    if (throttle_burst != 1 || atomic_load(&throttle_count) != 2) {
+        os_printf("[topic][RULE] THROTTLE触发错误: 突发=%u 间隔后=%u\n", throttle_burst, atomic_load(&throttle_count));
+        ret = -1;
+    }
+
+    /* EDGE：只有数据变化时触发 */
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_EDGE, 1);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_EDGE, 1);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_EDGE, 1);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_EDGE, 2);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_EDGE, 2);
+    rule_ext_publish(&bus, &dict, TEST_EVENT_ID_RULE_EDGE, 1);
+    if (atomic_load(&edge_count) != 3) {
+        os_printf("[topic][RULE] EDGE触发错误: %u (期望 3)\n", atomic_load(&edge_count));
+        ret = -1;
+    }
+
+#if TOPIC_BUS_ENABLE_STATS
+    int64_t throttle_suppressed = topic_bus_get_suppressed_count(&bus, TEST_TOPIC_ID_RULE_THROTTLE);
+    int64_t edge_suppressed = topic_bus_get_suppressed_count(&bus, TEST_TOPIC_ID_RULE_EDGE);
+    if (throttle_suppressed != PERF_TEST_RULE_BURST - 1 || edge_suppressed != 3) {
+        os_printf("[topic][RULE] 过滤计数错误: THROTTLE=%lld EDGE=%lld\n",
+                  (long long)throttle_suppressed, (long long)edge_suppressed);
+        ret = -1;
     }
 #endif
 
-    os_printf("[topic][SERVER] Server周期性运行测试: 通过\n");
-    return 0;
+    topic_bus_deinit(&bus);
+    if (ret == 0) {
+        os_printf("[topic][RULE] 扩展规则测试: 通过\n");
+    }
+    return ret;
 }
 
-#if TOPIC_BUS_ENABLE_STATS
 /*
- * @brief 测试Topic Server性能统计（4.2）
- * @return 0成功，-1失败
+ * @brief 风暴测试回调：模拟订阅者自行过滤前的处理开销
  */
-static int test_server_stats(void) {
-    os_printf("\n[topic][SERVER] Server性能统计测试\n");
+static void storm_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    uint64_t until = os_monotonic_time_get_microsecond() + PERF_TEST_STORM_WORK_US;
+    while (os_monotonic_time_get_microsecond() < until) {
+    }
+    atomic_fetch_add_explicit((atomic_uint*)user, 1, memory_order_relaxed);
+}
 
+/*
+ * @brief 以指定规则类型测量重复数据风暴的单次发布开销
+ * @param type 规则类型
+ * @param avg_us 输出：平均发布开销（微秒）
+ * @param callbacks 输出：回调次数
+ */
+static void storm_run(topic_rule_type_t type, double* avg_us, unsigned* callbacks) {
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
     obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
@@ -581,86 +918,84 @@ static int test_server_stats(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
-    /* 创建Topic以便事件可以触发 */
-    obj_dict_key_t events[] = {TEST_EVENT_ID_SERVER};
-    topic_rule_t rule = {
-        .type = TOPIC_RULE_OR,
-        .events = events,
-        .event_count = 1,
-    };
-    topic_rule_create(&bus, TEST_TOPIC_ID_SERVER, &rule);
-    topic_subscribe(&bus, TEST_TOPIC_ID_SERVER, test_callback, NULL);
+    static atomic_uint storm_count;
+    atomic_store(&storm_count, 0);
 
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
-    obj_dict_set(&dict, TEST_EVENT_ID_SERVER, &event_data, sizeof(event_data), 0);
+    obj_dict_key_t events[] = {TEST_EVENT_ID_STORM};
+    topic_rule_t rule = { .type = type, .events = events, .event_count = 1,
+                          .interval_ms = PERF_TEST_RULE_INTERVAL_MS };
+    topic_rule_create(&bus, TEST_TOPIC_ID_STORM, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_STORM, storm_callback, &storm_count);
 
-    topic_server_t server;
-    topic_server_init(&server, &bus, 100);
+    /* 状态量被周期性重复发布，值很少变化 */
+    test_event_data_t event_data = { .value = 0x5A5A5A5A, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_STORM, &event_data, sizeof(event_data), 0);
 
-#if TOPIC_BUS_ENABLE_ISR
-    /* 模拟多次ISR发布 */
-    for (int i = 0; i < 10; ++i) {
-        topic_publish_isr(&bus, TEST_EVENT_ID_SERVER);
-    }
-    /* 处理ISR队列并手动更新统计信息（模拟topic_server_task的行为） */
-    uint64_t start_us = os_monotonic_time_get_microsecond();
-    int processed = topic_server_run_once(&server);
-    uint64_t end_us = os_monotonic_time_get_microsecond();
-    
-#if TOPIC_BUS_ENABLE_STATS
-    if (processed > 0) {
-        server.total_processed += processed;
-        server.total_time_us += (end_us - start_us);
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_STORM_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_STORM);
     }
-#endif
+    uint64_t end = os_monotonic_time_get_microsecond();
 
-    if (processed == 0) {
-        os_printf("[topic][SERVER] Server未处理任何事件\n");
-        return -1;
-    }
-#else
-    /* 非ISR模式下，统计信息始终为0 */
-    os_printf("[topic][SERVER] ISR未启用，跳过统计测试\n");
-    return 0;
-#endif
+    *avg_us = (double)(end - start) / PERF_TEST_STORM_LOOPS;
+    *callbacks = atomic_load(&storm_count);
+    topic_bus_deinit(&bus);
+}
 
-    uint64_t avg_time_us = 0;
-    uint64_t total = topic_server_get_stats(&server, &avg_time_us);
-    if (total == 0) {
-        os_printf("[topic][SERVER] 统计信息为空\n");
+/*
+ * @brief 回调风暴抑制性能测试：OR规则（订阅者自行过滤）对比总线侧EDGE/THROTTLE过滤
+ * @return 0成功，-1失败
+ */
+static int test_performance_rule_filter(void) {
+    os_printf("\n[topic][PERF] 回调风暴抑制性能测试\n");
+
+    double or_us = 0, edge_us = 0, throttle_us = 0;
+    unsigned or_cb = 0, edge_cb = 0, throttle_cb = 0;
+    storm_run(TOPIC_RULE_OR, &or_us, &or_cb);
+    storm_run(TOPIC_RULE_EDGE, &edge_us, &edge_cb);
+    storm_run(TOPIC_RULE_THROTTLE, &throttle_us, &throttle_cb);
+
+    os_printf("[topic][PERF] 重复数据风暴(%d次): OR %.2f us/publish(%u回调), EDGE %.2f us/publish(%u回调), "
+              "THROTTLE(%dms) %.2f us/publish(%u回调)\n",
+              PERF_TEST_STORM_LOOPS, or_us, or_cb, edge_us, edge_cb,
+              PERF_TEST_RULE_INTERVAL_MS, throttle_us, throttle_cb);
+
+    if (or_cb != PERF_TEST_STORM_LOOPS || edge_cb != 1 || throttle_cb == 0 || throttle_cb >= or_cb) {
+        os_printf("[topic][PERF] 风暴抑制回调次数错误\n");
         return -1;
     }
-
-    os_printf("[topic][SERVER] 总处理数=%llu, 平均耗时=%llu us\n",
-              (unsigned long long)total, (unsigned long long)avg_time_us);
-
-    os_printf("[topic][SERVER] Server性能统计测试: 通过\n");
     return 0;
 }
-#endif
-#endif
-
-/* ---------------- Topic Router测试 ---------------- */
 
-#if TOPIC_BUS_ENABLE_ROUTER
+#if TOPIC_BUS_ENABLE_HIST
 /*
- * @brief 自定义Router回调函数
+ * @brief 直方图测试回调：busy-wait user指定的微秒数
  */
-static int custom_router_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+static void hist_work_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    uint64_t until = os_monotonic_time_get_microsecond() + (uint64_t)(uintptr_t)user;
+    while (os_monotonic_time_get_microsecond() < until) {
+    }
+}
+
+#if TOPIC_BUS_ENABLE_ROUTER
+static int hist_router_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
     (void)topic_id;
     (void)data;
     (void)data_len;
     (void)user_data;
-    atomic_fetch_add_explicit(&router_custom_count, 1, memory_order_relaxed);
     return 0;
 }
+#endif
 
 /*
- * @brief 测试VFB Router（5.1）
+ * @brief 测试延迟直方图：分发延迟/回调/Router计数，按订阅者定位慢回调，清零与ISR路径
  * @return 0成功，-1失败
  */
-static int test_router_vfb(void) {
-    os_printf("\n[topic][ROUTER] VFB Router测试\n");
+static int test_hist(void) {
+    os_printf("\n[topic][HIST] 延迟直方图测试\n");
 
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
@@ -670,49 +1005,113 @@ static int test_router_vfb(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
+#if TOPIC_BUS_ENABLE_ROUTER
     topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
     topic_router_t router;
     topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+    topic_router_add_custom(&router, TEST_TOPIC_ID_HIST, hist_router_callback, NULL);
+    topic_bus_set_router(&bus, &router);
+#endif
 
-    /* 添加VFB Router */
-    if (topic_router_add_vfb(&router, TEST_TOPIC_ID_ROUTER_VFB, 100) != 0) {
-        os_printf("[topic][ROUTER] 添加VFB Router失败\n");
-        return -1;
+    obj_dict_key_t events[] = {TEST_EVENT_ID_HIST};
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = events, .event_count = 1 };
+    topic_rule_create(&bus, TEST_TOPIC_ID_HIST, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_HIST, hist_work_callback, (void*)(uintptr_t)0);
+
+    /* 默认关闭且未分配；开启时为已有Topic与订阅者分配，之后的订阅随即分配 */
+    int ret = 0;
+    topic_hist_snapshot_t latency, callback, routing;
+    if (topic_bus_get_hist(&bus, TEST_TOPIC_ID_HIST, TOPIC_HIST_LATENCY, &latency) == 0 ||
+        topic_bus_hist_enable(&bus, 1) != 0) {
+        os_printf("[topic][HIST] 默认状态或开启失败\n");
+        ret = -1;
     }
+    topic_subscribe(&bus, TEST_TOPIC_ID_HIST, hist_work_callback, (void*)(uintptr_t)PERF_TEST_HIST_SLOW_US);
 
-    /* 设置Router到Topic Bus */
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    for (int i = 0; i < PERF_TEST_HIST_LOOPS; ++i) {
+        event_data.counter = (uint32_t)i;
+        obj_dict_set(&dict, TEST_EVENT_ID_HIST, &event_data, sizeof(event_data), 0);
+        topic_publish_event(&bus, TEST_EVENT_ID_HIST);
+    }
+
+    if (topic_bus_get_hist(&bus, TEST_TOPIC_ID_HIST, TOPIC_HIST_LATENCY, &latency) != 0 ||
+        topic_bus_get_hist(&bus, TEST_TOPIC_ID_HIST, TOPIC_HIST_CALLBACK, &callback) != 0 ||
+        topic_bus_get_hist(&bus, TEST_TOPIC_ID_HIST, TOPIC_HIST_ROUTER, &routing) != 0) {
+        os_printf("[topic][HIST] 读取Topic直方图失败\n");
+        ret = -1;
+    } else if (latency.count != PERF_TEST_HIST_LOOPS || callback.count != 2U * PERF_TEST_HIST_LOOPS) {
+        os_printf("[topic][HIST] 样本数错误: latency=%lu callback=%lu\n",
+                  (unsigned long)latency.count, (unsigned long)callback.count);
+        ret = -1;
+    }
 #if TOPIC_BUS_ENABLE_ROUTER
-    topic_bus_set_router(&bus, &router);
+    if (ret == 0 && routing.count != PERF_TEST_HIST_LOOPS) {
+        os_printf("[topic][HIST] Router样本数错误: %lu\n", (unsigned long)routing.count);
+        ret = -1;
+    }
 #endif
 
-    /* 创建Topic并触发 */
-    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_VFB};
-    topic_rule_t rule = {
-        .type = TOPIC_RULE_OR,
-        .events = events,
-        .event_count = 1,
-    };
-
-    topic_rule_create(&bus, TEST_TOPIC_ID_ROUTER_VFB, &rule);
-
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
-    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_VFB, &event_data, sizeof(event_data), 0);
+    /* 按订阅者查询：慢订阅者的p99不低于其忙等时间，且高于快订阅者 */
+    uint32_t fast_p99 = 0, slow_p99 = 0;
+    size_t sub_count = 0;
+    topic_sub_hist_t sub;
+    while (topic_bus_get_sub_hist(&bus, TEST_TOPIC_ID_HIST, sub_count, &sub) == 0) {
+        uint32_t p99 = topic_hist_percentile(&sub.hist, 990);
+        if ((uintptr_t)sub.user_data == PERF_TEST_HIST_SLOW_US) {
+            slow_p99 = p99;
+        } else {
+            fast_p99 = p99;
+        }
+        ++sub_count;
+    }
+    if (ret == 0 && (sub_count != 2 || slow_p99 < PERF_TEST_HIST_SLOW_US || slow_p99 <= fast_p99)) {
+        os_printf("[topic][HIST] 订阅者直方图错误: subs=%u fast_p99=%u slow_p99=%u\n",
+                  (unsigned)sub_count, (unsigned)fast_p99, (unsigned)slow_p99);
+        ret = -1;
+    }
+    topic_bus_hist_dump(&bus, TEST_TOPIC_ID_HIST);
+
+    /* 清零后从ISR路径发布：延迟起点为入队时刻 */
+    topic_bus_hist_reset(&bus, TOPIC_BUS_HIST_ALL_TOPICS);
+    topic_bus_get_hist(&bus, TEST_TOPIC_ID_HIST, TOPIC_HIST_LATENCY, &latency);
+    if (ret == 0 && latency.count != 0) {
+        os_printf("[topic][HIST] 清零失败\n");
+        ret = -1;
+    }
+#if TOPIC_BUS_ENABLE_ISR
+    topic_publish_isr(&bus, TEST_EVENT_ID_HIST);
+    topic_bus_process_isr_queue(&bus);
+    topic_bus_get_hist(&bus, TEST_TOPIC_ID_HIST, TOPIC_HIST_LATENCY, &latency);
+    if (ret == 0 && latency.count != 1) {
+        os_printf("[topic][HIST] ISR路径未记录延迟\n");
+        ret = -1;
+    }
+#endif
 
-    atomic_store_explicit(&router_vfb_count, 0, memory_order_release);
-    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_VFB);
+    /* 取消订阅后序号随之变化 */
+    topic_unsubscribe(&bus, TEST_TOPIC_ID_HIST, hist_work_callback, (void*)(uintptr_t)PERF_TEST_HIST_SLOW_US);
+    if (ret == 0 && topic_bus_get_sub_hist(&bus, TEST_TOPIC_ID_HIST, 1, &sub) == 0) {
+        os_printf("[topic][HIST] 取消订阅后仍可查询到订阅者\n");
+        ret = -1;
+    }
 
-    /* 注意：VFB Router需要VFB模块支持，这里仅测试Router调用 */
-    os_printf("[topic][ROUTER] VFB Router测试: 通过（需VFB模块支持）\n");
-    return 0;
+    topic_bus_deinit(&bus);
+#if TOPIC_BUS_ENABLE_ROUTER
+    topic_router_deinit(&router);
+#endif
+    if (ret == 0) {
+        os_printf("[topic][HIST] 延迟直方图测试: 通过\n");
+    }
+    return ret;
 }
 
 /*
- * @brief 测试自定义Router（5.2）
- * @return 0成功，-1失败
+ * @brief 测量一次发布的平均开销（单个空回调订阅者）
+ * @param enable 是否开启直方图
+ * @return 平均开销（微秒）
  */
-static int test_router_custom(void) {
-    os_printf("\n[topic][ROUTER] 自定义Router测试\n");
-
+static double hist_publish_run(int enable) {
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
     obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
@@ -720,53 +1119,65 @@ static int test_router_custom(void) {
     topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+    topic_bus_hist_enable(&bus, enable);
 
-    topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
-    topic_router_t router;
-    topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
-
-    /* 添加自定义Router */
-    if (topic_router_add_custom(&router, TEST_TOPIC_ID_ROUTER_CUSTOM, custom_router_callback, NULL) != 0) {
-        os_printf("[topic][ROUTER] 添加自定义Router失败\n");
-        return -1;
-    }
+    obj_dict_key_t events[] = {TEST_EVENT_ID_HIST};
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = events, .event_count = 1 };
+    topic_rule_create(&bus, TEST_TOPIC_ID_HIST, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_HIST, hist_work_callback, (void*)(uintptr_t)0);
 
-#if TOPIC_BUS_ENABLE_ROUTER
-    topic_bus_set_router(&bus, &router);
-#endif
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_HIST, &event_data, sizeof(event_data), 0);
 
-    /* 创建Topic并触发 */
-    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_CUSTOM};
-    topic_rule_t rule = {
-        .type = TOPIC_RULE_OR,
-        .events = events,
-        .event_count = 1,
-    };
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_HIST);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
 
-    topic_rule_create(&bus, TEST_TOPIC_ID_ROUTER_CUSTOM, &rule);
+    topic_bus_deinit(&bus);
+    return (double)(end - start) / PERF_TEST_LOOPS;
+}
 
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
-    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_CUSTOM, &event_data, sizeof(event_data), 0);
+/*
+ * @brief 直方图记录开销测试：同一发布路径开启/关闭直方图对比
+ * @return 0成功，-1失败
+ */
+static int test_performance_hist(void) {
+    os_printf("\n[topic][PERF] 延迟直方图开销测试\n");
 
-    atomic_store_explicit(&router_custom_count, 0, memory_order_release);
-    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_CUSTOM);
+    double off_us = hist_publish_run(0);
+    double on_us = hist_publish_run(1);
+    os_printf("[topic][PERF] 单订阅者发布(%d次): 直方图关闭 %.3f us/publish, 开启 %.3f us/publish (+%.3f us)\n",
+              PERF_TEST_LOOPS, off_us, on_us, on_us - off_us);
+    return 0;
+}
+#endif
 
-    if (atomic_load_explicit(&router_custom_count, memory_order_acquire) != 1) {
-        os_printf("[topic][ROUTER] 自定义Router回调未执行 count=%u\n",
-                  atomic_load_explicit(&router_custom_count, memory_order_acquire));
-        return -1;
-    }
+#if TOPIC_BUS_ENABLE_TRACE
+static void trace_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    (void)user_data;
+}
 
-    os_printf("[topic][ROUTER] 自定义Router测试: 通过\n");
+#if TOPIC_BUS_ENABLE_ROUTER
+static int trace_router_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    (void)user_data;
     return 0;
 }
+#endif
 
 /*
- * @brief 测试多Router（5.3）
+ * @brief 测试二进制事件跟踪：发布/命中/回调/Router记录，导出Chrome trace JSON
  * @return 0成功，-1失败
  */
-static int test_router_multiple(void) {
-    os_printf("\n[topic][ROUTER] 多Router测试\n");
+static int test_trace(void) {
+    os_printf("\n[topic][TRACE] 二进制事件跟踪测试\n");
 
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
@@ -776,53 +1187,160 @@ static int test_router_multiple(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
+    /* 发布级每次发布：发布B/E + 命中（+ Router B/E）；回调级另有回调B/E */
+    size_t per_publish = 3;
+#if TOPIC_BUS_ENABLE_ROUTER
     topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
     topic_router_t router;
     topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+    topic_router_add_custom(&router, TEST_TOPIC_ID_TRACE, trace_router_callback, NULL);
+    topic_bus_set_router(&bus, &router);
+    per_publish += 2;
+#endif
 
-    /* 为Topic1添加VFB Router和自定义Router */
-    topic_router_add_vfb(&router, TEST_TOPIC_ID_ROUTER_MULTIPLE, 100);
-    topic_router_add_custom(&router, TEST_TOPIC_ID_ROUTER_MULTIPLE, custom_router_callback, NULL);
+    obj_dict_key_t events[] = {TEST_EVENT_ID_TRACE};
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = events, .event_count = 1 };
+    topic_rule_create(&bus, TEST_TOPIC_ID_TRACE, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_TRACE, trace_callback, NULL);
+
+    topic_trace_thread_name("main");
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    int ret = 0;
+    topic_trace_stats_t stats;
+    for (int level = TOPIC_TRACE_LEVEL_PUBLISH; level <= TOPIC_TRACE_LEVEL_CALLBACK; ++level) {
+        if (level == TOPIC_TRACE_LEVEL_CALLBACK) {
+            per_publish += 2;
+        }
+        topic_trace_enable(level);
+        topic_trace_reset();
+        for (int i = 0; i < PERF_TEST_TRACE_LOOPS; ++i) {
+            event_data.counter = (uint32_t)i;
+            obj_dict_set(&dict, TEST_EVENT_ID_TRACE, &event_data, sizeof(event_data), 0);
+            topic_publish_event(&bus, TEST_EVENT_ID_TRACE);
+        }
+        topic_trace_get_stats(&stats);
+        if (stats.records != per_publish * PERF_TEST_TRACE_LOOPS) {
+            os_printf("[topic][TRACE] 级别%d记录数错误: %u (期望%u)\n", level,
+                      (unsigned)stats.records, (unsigned)(per_publish * PERF_TEST_TRACE_LOOPS));
+            ret = -1;
+        }
+    }
+
+    /* 关闭后不再记录 */
+    topic_trace_enable(TOPIC_TRACE_LEVEL_OFF);
+    topic_publish_event(&bus, TEST_EVENT_ID_TRACE);
+    topic_trace_enable(TOPIC_TRACE_LEVEL_CALLBACK);
+    topic_trace_get_stats(&stats);
+    if (ret == 0 && stats.records != per_publish * PERF_TEST_TRACE_LOOPS) {
+        os_printf("[topic][TRACE] 关闭后仍有记录\n");
+        ret = -1;
+    }
+
+#if TOPIC_TRACE_ENABLE_EXPORT
+    /* 导出：全部记录成对且完整，元数据事件不计入返回值 */
+    int exported = topic_trace_export_chrome(PERF_TEST_TRACE_FILE);
+    if (ret == 0 && exported != (int)(per_publish * PERF_TEST_TRACE_LOOPS)) {
+        os_printf("[topic][TRACE] 导出事件数错误: %d\n", exported);
+        ret = -1;
+    }
+    if (ret == 0) {
+        char head[32] = {0};
+        FILE* fp = fopen(PERF_TEST_TRACE_FILE, "rb");
+        if (!fp || fread(head, 1, sizeof(head) - 1, fp) == 0 || !strstr(head, "\"traceEvents\"")) {
+            os_printf("[topic][TRACE] 导出文件格式错误\n");
+            ret = -1;
+        }
+        if (fp) fclose(fp);
+    }
+    if (ret == 0) {
+        os_printf("[topic][TRACE] 导出%d个事件到%s（chrome://tracing或ui.perfetto.dev打开）\n",
+                  exported, PERF_TEST_TRACE_FILE);
+    }
+#endif
+    topic_trace_enable(TOPIC_TRACE_DEFAULT_LEVEL);
 
+    topic_bus_deinit(&bus);
 #if TOPIC_BUS_ENABLE_ROUTER
-    topic_bus_set_router(&bus, &router);
+    topic_router_deinit(&router);
 #endif
+    if (ret == 0) {
+        os_printf("[topic][TRACE] 二进制事件跟踪测试: 通过\n");
+    }
+    return ret;
+}
 
-    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_MULTIPLE};
-    topic_rule_t rule = {
-        .type = TOPIC_RULE_OR,
-        .events = events,
-        .event_count = 1,
-    };
+/*
+ * @brief 测量一次发布的平均开销（单个空回调订阅者）
+ * @param level 跟踪级别
+ * @return 平均开销（微秒）
+ */
+static double trace_publish_run(int level) {
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
 
-    topic_rule_create(&bus, TEST_TOPIC_ID_ROUTER_MULTIPLE, &rule);
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+#if TOPIC_BUS_ENABLE_HIST
+    topic_bus_hist_enable(&bus, 0);
+#endif
 
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
-    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_MULTIPLE, &event_data, sizeof(event_data), 0);
+    obj_dict_key_t events[] = {TEST_EVENT_ID_TRACE};
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = events, .event_count = 1 };
+    topic_rule_create(&bus, TEST_TOPIC_ID_TRACE, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_TRACE, trace_callback, NULL);
 
-    atomic_store_explicit(&router_custom_count, 0, memory_order_release);
-    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_MULTIPLE);
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_TRACE, &event_data, sizeof(event_data), 0);
 
-    /* 验证自定义Router被调用 */
-    if (atomic_load_explicit(&router_custom_count, memory_order_acquire) != 1) {
-        os_printf("[topic][ROUTER] 多Router未全部执行\n");
-        return -1;
+    topic_trace_enable(level);
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_TRACE);
     }
+    uint64_t end = os_monotonic_time_get_microsecond();
+    topic_trace_enable(TOPIC_TRACE_DEFAULT_LEVEL);
 
-    os_printf("[topic][ROUTER] 多Router测试: 通过\n");
+    topic_bus_deinit(&bus);
+    return (double)(end - start) / PERF_TEST_LOOPS;
+}
+
+/*
+ * @brief 跟踪记录开销测试：单条记录耗时，以及发布路径开启/关闭跟踪对比
+ * @return 0成功，-1失败
+ */
+static int test_performance_trace(void) {
+    os_printf("\n[topic][PERF] 二进制事件跟踪开销测试\n");
+
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (uint32_t i = 0; i < PERF_TEST_TRACE_RECORDS; ++i) {
+        TOPIC_TRACE(TOPIC_TRACE_MATCH, TEST_TOPIC_ID_TRACE, TEST_EVENT_ID_TRACE, i);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+    os_printf("[topic][PERF] 单条跟踪记录(%d次): %.2f ns/record\n", PERF_TEST_TRACE_RECORDS,
+              (double)(end - start) * 1000.0 / PERF_TEST_TRACE_RECORDS);
+
+    double off_us = trace_publish_run(TOPIC_TRACE_LEVEL_OFF);
+    double publish_us = trace_publish_run(TOPIC_TRACE_LEVEL_PUBLISH);
+    double callback_us = trace_publish_run(TOPIC_TRACE_LEVEL_CALLBACK);
+    os_printf("[topic][PERF] 单订阅者发布(%d次): 跟踪关闭 %.3f us/publish, 发布级 %.3f us/publish (+%.3f us), "
+              "回调级 %.3f us/publish (+%.3f us)\n", PERF_TEST_LOOPS, off_us, publish_us, publish_us - off_us,
+              callback_us, callback_us - off_us);
+    topic_trace_reset();
     return 0;
 }
 #endif
 
-/* ---------------- ISR路径测试 ---------------- */
+/* ---------------- Topic Server测试 ---------------- */
 
-#if TOPIC_BUS_ENABLE_ISR
+#if TOPIC_BUS_ENABLE_SERVER
 /*
- * @brief 测试ISR发布（6.1）
+ * @brief 测试Topic Server周期性运行（4.1）
  * @return 0成功，-1失败
  */
-static int test_isr_publish(void) {
-    os_printf("\n[topic][ISR] ISR发布测试\n");
+static int test_server_periodic(void) {
+    os_printf("\n[topic][SERVER] Server周期性运行测试\n");
 
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
@@ -832,49 +1350,36 @@ static int test_isr_publish(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
-    /* 创建Topic */
-    obj_dict_key_t events[] = {TEST_EVENT_ID_ISR};
-    topic_rule_t rule = {
-        .type = TOPIC_RULE_OR,
-        .events = events,
-        .event_count = 1,
-    };
-
-    topic_rule_create(&bus, TEST_TOPIC_ID_ISR, &rule);
-    topic_subscribe(&bus, TEST_TOPIC_ID_ISR, test_callback, NULL);
-
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
-    obj_dict_set(&dict, TEST_EVENT_ID_ISR, &event_data, sizeof(event_data), 0);
-
-    /* 模拟ISR发布 */
-    if (topic_publish_isr(&bus, TEST_EVENT_ID_ISR) != 0) {
-        os_printf("[topic][ISR] ISR发布失败\n");
+    topic_server_t server;
+    if (topic_server_init(&server, &bus, 100) != 0) {
+        os_printf("[topic][SERVER] Server初始化失败\n");
         return -1;
     }
 
-    /* 在任务上下文中处理ISR队列 */
-    atomic_store_explicit(&callback_count, 0, memory_order_release);
-    topic_bus_process_isr_queue(&bus);
+#if TOPIC_BUS_ENABLE_ISR
+    /* 模拟ISR发布事件 */
+    topic_publish_isr(&bus, TEST_EVENT_ID_SERVER);
+    topic_publish_isr(&bus, (obj_dict_key_t)(TEST_EVENT_ID_SERVER + 1));
 
-    if (atomic_load_explicit(&callback_count, memory_order_acquire) != 1) {
-        os_printf("[topic][ISR] ISR事件未处理 count=%u\n",
-                  atomic_load_explicit(&callback_count, memory_order_acquire));
+    /* 运行Server一次，处理ISR队列 */
+    int processed = topic_server_run_once(&server);
+    if (processed <= 0) {
+        os_printf("[topic][SERVER] Server未处理事件\n");
         return -1;
     }
+#endif
 
-    os_printf("[topic][ISR] ISR发布测试: 通过\n");
+    os_printf("[topic][SERVER] Server周期性运行测试: 通过\n");
     return 0;
 }
-#endif
-
-/* ---------------- 时效性性能测试 ---------------- */
 
+#if TOPIC_BUS_ENABLE_STATS
 /*
- * @brief 测试时效性检查性能开销（7.3）
+ * @brief 测试Topic Server性能统计（4.2）
  * @return 0成功，-1失败
  */
-static int test_performance_timeout(void) {
-    os_printf("\n[topic][PERF] 时效性检查性能测试\n");
+static int test_server_stats(void) {
+    os_printf("\n[topic][SERVER] Server性能统计测试\n");
 
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
@@ -884,42 +1389,99 @@ static int test_performance_timeout(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
-    obj_dict_key_t events[] = {TEST_EVENT_ID_PERF_TIMEOUT};
-    uint32_t timeouts[] = {3000};  /* 启用时效性检查 */
+    /* 创建Topic以便事件可以触发 */
+    obj_dict_key_t events[] = {TEST_EVENT_ID_SERVER};
     topic_rule_t rule = {
         .type = TOPIC_RULE_OR,
         .events = events,
         .event_count = 1,
-        .event_timeouts_ms = timeouts,
     };
-
-    topic_rule_create(&bus, TEST_TOPIC_ID_PERF_TIMEOUT, &rule);
-    topic_subscribe(&bus, TEST_TOPIC_ID_PERF_TIMEOUT, test_callback, NULL);
+    topic_rule_create(&bus, TEST_TOPIC_ID_SERVER, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_SERVER, test_callback, NULL);
 
     test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
-    obj_dict_set(&dict, TEST_EVENT_ID_PERF_TIMEOUT, &event_data, sizeof(event_data), 0);
+    obj_dict_set(&dict, TEST_EVENT_ID_SERVER, &event_data, sizeof(event_data), 0);
 
-    /* 测量带时效性检查的性能 */
-    uint64_t start = os_monotonic_time_get_microsecond();
-    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
-        topic_publish_event(&bus, TEST_EVENT_ID_PERF_TIMEOUT);
+    topic_server_t server;
+    topic_server_init(&server, &bus, 100);
+
+#if TOPIC_BUS_ENABLE_ISR
+    /* 模拟多次ISR发布 */
+    for (int i = 0; i < 10; ++i) {
+        topic_publish_isr(&bus, TEST_EVENT_ID_SERVER);
     }
-    uint64_t end = os_monotonic_time_get_microsecond();
+    /* 处理ISR队列并手动更新统计信息（模拟topic_server_task的行为） */
+    uint64_t start_us = os_monotonic_time_get_microsecond();
+    int processed = topic_server_run_once(&server);
+    uint64_t end_us = os_monotonic_time_get_microsecond();
+    
+#if TOPIC_BUS_ENABLE_STATS
+    if (processed > 0) {
+        server.total_processed += processed;
+        server.total_time_us += (end_us - start_us);
+    }
+#endif
 
-    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
-    os_printf("[topic][PERF] 时效性检查延迟: %.2f us/publish\n", avg_us);
+    if (processed == 0) {
+        os_printf("[topic][SERVER] Server未处理任何事件\n");
+        return -1;
+    }
+#else
+    /* 非ISR模式下，统计信息始终为0 */
+    os_printf("[topic][SERVER] ISR未启用，跳过统计测试\n");
+    return 0;
+#endif
+
+    uint64_t avg_time_us = 0;
+    uint64_t total = topic_server_get_stats(&server, &avg_time_us);
+    if (total == 0) {
+        os_printf("[topic][SERVER] 统计信息为空\n");
+        return -1;
+    }
+
+    os_printf("[topic][SERVER] 总处理数=%llu, 平均耗时=%llu us\n",
+              (unsigned long long)total, (unsigned long long)avg_time_us);
 
+    os_printf("[topic][SERVER] Server性能统计测试: 通过\n");
     return 0;
 }
 
-/* ---------------- 高并发测试 ---------------- */
+#if TOPIC_BUS_ENABLE_ISR
+/*
+ * @brief 初始化ISR排空测试用的总线：每个事件键对应一个OR Topic
+ */
+static void drain_test_setup(topic_bus_t* bus, topic_entry_t* topic_entries, obj_dict_t* dict) {
+    topic_bus_init(bus, topic_entries, PERF_TEST_MAX_TOPICS, dict);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    for (uint16_t i = 0; i < PERF_TEST_DRAIN_KEYS; ++i) {
+        obj_dict_key_t events[1] = { (obj_dict_key_t)(TEST_EVENT_ID_DRAIN_BASE + i) };
+        topic_rule_t rule = {
+            .type = TOPIC_RULE_OR,
+            .events = events,
+            .event_count = 1,
+        };
+        topic_rule_create(bus, (uint16_t)(TEST_TOPIC_ID_DRAIN_BASE + i), &rule);
+        topic_subscribe(bus, (uint16_t)(TEST_TOPIC_ID_DRAIN_BASE + i), test_callback, NULL);
+        obj_dict_set(dict, events[0], &event_data, sizeof(event_data), 0);
+    }
+}
 
 /*
- * @brief 测试高并发场景（7.4）
+ * @brief 模拟ISR突发：填满ISR队列，PERF_TEST_DRAIN_KEYS个事件键轮流出现
+ */
+static void drain_test_burst(topic_bus_t* bus) {
+    for (size_t i = 0; i < TOPIC_BUS_ISR_QUEUE_SIZE; ++i) {
+        topic_publish_isr(bus, (obj_dict_key_t)(TEST_EVENT_ID_DRAIN_BASE + (i % PERF_TEST_DRAIN_KEYS)));
+    }
+}
+
+/*
+ * @brief 测试Server批量合并排空及突发/合并统计（4.3）
  * @return 0成功，-1失败
  */
-static int test_concurrent_high(void) {
-    os_printf("\n[topic][CONCURRENT] 高并发测试\n");
+static int test_server_drain_coalesce(void) {
+    os_printf("\n[topic][SERVER] Server批量合并排空测试\n");
 
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
@@ -927,47 +1489,134 @@ static int test_concurrent_high(void) {
 
     topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
     topic_bus_t bus;
-    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+    drain_test_setup(&bus, topic_entries, &dict);
 
-    /* 创建多个Topic */
-    for (uint16_t i = 0; i < 8; ++i) {
-        obj_dict_key_t events[] = {(obj_dict_key_t)(TEST_EVENT_ID_CONCURRENT_BASE + i)};
-        topic_rule_t rule = {
-            .type = TOPIC_RULE_OR,
-            .events = events,
-            .event_count = 1,
-        };
-        topic_rule_create(&bus, (test_topic_id_t)(TEST_TOPIC_ID_CONCURRENT_BASE + i), &rule);
-        /* 每个Topic注册多个订阅者 */
-        for (int j = 0; j < 4; ++j) {
-            topic_subscribe(&bus, (test_topic_id_t)(TEST_TOPIC_ID_CONCURRENT_BASE + i), test_callback, NULL);
-        }
+    topic_server_t server;
+    topic_server_init(&server, &bus, 100);
+    int ret = -1;
+
+    /* 批量模式：每个事件都分发 */
+    topic_server_set_drain_mode(&server, TOPIC_SERVER_DRAIN_BATCH);
+    drain_test_burst(&bus);
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    int processed = topic_server_run_once(&server);
+    uint32_t callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
+    if (processed != TOPIC_BUS_ISR_QUEUE_SIZE || callbacks != TOPIC_BUS_ISR_QUEUE_SIZE) {
+        os_printf("[topic][SERVER] 批量排空错误 processed=%d callbacks=%u\n", processed, callbacks);
+        goto cleanup;
     }
 
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    /* 合并模式：同批重复事件只分发一次 */
+    topic_server_set_drain_mode(&server, TOPIC_SERVER_DRAIN_COALESCE);
+    drain_test_burst(&bus);
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    processed = topic_server_run_once(&server);
+    callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
+    if (processed != TOPIC_BUS_ISR_QUEUE_SIZE || callbacks != PERF_TEST_DRAIN_KEYS) {
+        os_printf("[topic][SERVER] 合并排空错误 processed=%d callbacks=%u\n", processed, callbacks);
+        goto cleanup;
+    }
 
-    /* 并发发布事件 */
-    uint64_t start = os_monotonic_time_get_microsecond();
-    for (int i = 0; i < 10000; ++i) {
-        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_CONCURRENT_BASE + (i % 8));
-        obj_dict_set(&dict, key, &event_data, sizeof(event_data), 0);
-        topic_publish_event(&bus, key);
+    topic_server_drain_stats_t stats;
+    topic_server_get_drain_stats(&server, &stats);
+    if (stats.bursts != 2 || stats.max_burst != TOPIC_BUS_ISR_QUEUE_SIZE ||
+        stats.events_drained != 2 * TOPIC_BUS_ISR_QUEUE_SIZE ||
+        stats.events_dispatched != TOPIC_BUS_ISR_QUEUE_SIZE + PERF_TEST_DRAIN_KEYS) {
+        os_printf("[topic][SERVER] 排空统计错误\n");
+        goto cleanup;
     }
-    uint64_t end = os_monotonic_time_get_microsecond();
+    os_printf("[topic][SERVER] 突发批次=%llu, 最大突发=%u, 平均突发=%.1f, 合并比=%.2f\n",
+              (unsigned long long)stats.bursts, stats.max_burst,
+              (double)stats.events_drained / (double)stats.bursts,
+              (double)stats.events_drained / (double)stats.events_dispatched);
 
-    double avg_us = (double)(end - start) / 10000;
-    uint32_t total_callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
-    os_printf("[topic][CONCURRENT] 高并发延迟: %.2f us/publish, 总回调数=%u\n",
-              avg_us, total_callbacks);
+    os_printf("[topic][SERVER] Server批量合并排空测试: 通过\n");
+    ret = 0;
+
+cleanup:
+    topic_bus_deinit(&bus);
+    return ret;
+}
+
+/*
+ * @brief ISR突发排空开销对比：逐条 vs 批量 vs 批量合并
+ * @return 0成功，-1失败
+ */
+static int test_performance_isr_drain(void) {
+    os_printf("\n[topic][PERF] ISR突发排空开销测试（突发=%d，事件键=%d）\n",
+              TOPIC_BUS_ISR_QUEUE_SIZE, PERF_TEST_DRAIN_KEYS);
+
+    static const topic_server_drain_mode_t modes[] = {
+        TOPIC_SERVER_DRAIN_SINGLE, TOPIC_SERVER_DRAIN_BATCH, TOPIC_SERVER_DRAIN_COALESCE
+    };
+    static const char* const mode_names[] = { "逐条", "批量", "合并" };
+
+    for (size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+        obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+        obj_dict_t dict;
+        obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+        topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+        topic_bus_t bus;
+        drain_test_setup(&bus, topic_entries, &dict);
+
+        topic_server_t server;
+        topic_server_init(&server, &bus, 100);
+        topic_server_set_drain_mode(&server, modes[m]);
+
+        uint64_t drain_us = 0;
+        for (int r = 0; r < PERF_TEST_DRAIN_ROUNDS; ++r) {
+            drain_test_burst(&bus);
+            uint64_t start = os_monotonic_time_get_microsecond();
+            topic_server_run_once(&server);
+            drain_us += os_monotonic_time_get_microsecond() - start;
+        }
+
+        topic_server_drain_stats_t stats;
+        topic_server_get_drain_stats(&server, &stats);
+        os_printf("[topic][PERF] %s排空: %.3f us/event, 平均突发=%.1f, 合并比=%.2f\n",
+                  mode_names[m], (double)drain_us / (double)stats.events_drained,
+                  (double)stats.events_drained / (double)stats.bursts,
+                  (double)stats.events_drained / (double)stats.events_dispatched);
+
+        topic_bus_deinit(&bus);
+    }
 
     return 0;
 }
 
-/* ---------------- 性能测试：事件发布延迟 ---------------- */
+/* ISR -> 回调端到端延迟采样 */
+static atomic_ullong latency_publish_us = ATOMIC_VAR_INIT(0);
+static atomic_uint latency_count = ATOMIC_VAR_INIT(0);
+static uint32_t latency_samples[PERF_TEST_LATENCY_SAMPLES];
 
-static int test_performance_event_publish(void) {
-    os_printf("\n[topic][PERF] 事件发布延迟测试\n");
+static void latency_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    (void)user;
+    uint64_t now = os_monotonic_time_get_microsecond();
+    unsigned idx = atomic_load_explicit(&latency_count, memory_order_relaxed);
+    if (idx < PERF_TEST_LATENCY_SAMPLES) {
+        latency_samples[idx] = (uint32_t)(now - atomic_load_explicit(&latency_publish_us, memory_order_acquire));
+    }
+    atomic_store_explicit(&latency_count, idx + 1, memory_order_release);
+}
+
+static int latency_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
 
+/*
+ * @brief 测量Server运行时ISR发布到订阅者回调的端到端延迟及空闲唤醒次数
+ * @param event_driven 是否由ISR事件唤醒
+ * @param period_ms Server周期（轮询周期或事件模式下的空闲超时）
+ * @param samples 采样数
+ * @return 0成功，-1失败
+ */
+static int latency_run(int event_driven, uint32_t period_ms, size_t samples) {
     obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
     obj_dict_t dict;
     obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
@@ -976,8 +1625,1131 @@ static int test_performance_event_publish(void) {
     topic_bus_t bus;
     topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
 
-    /* 创建多个OR规则的Topic */
-    for (uint16_t i = 0; i < 5; ++i) {
+    obj_dict_key_t events[] = {TEST_EVENT_ID_LATENCY};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+    topic_rule_create(&bus, TEST_TOPIC_ID_LATENCY, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_LATENCY, latency_callback, NULL);
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_LATENCY, &event_data, sizeof(event_data), 0);
+
+    topic_server_t server;
+    topic_server_init(&server, &bus, period_ms);
+    topic_server_set_wakeup(&server, event_driven, 0);
+    if (topic_server_start(&server) != 0) {
+        topic_bus_deinit(&bus);
+        return -1;
+    }
+
+    /* 空闲窗口：统计无事件时的Server唤醒次数 */
+    os_thread_sleep_ms(20);
+    uint64_t idle_begin = server.drain.wakeups;
+    os_thread_sleep_ms(PERF_TEST_LATENCY_IDLE_MS);
+    uint64_t idle_wakeups = server.drain.wakeups - idle_begin;
+
+    atomic_store_explicit(&latency_count, 0, memory_order_release);
+    int ret = 0;
+    for (size_t i = 0; i < samples && ret == 0; ++i) {
+        atomic_store_explicit(&latency_publish_us, os_monotonic_time_get_microsecond(), memory_order_release);
+        topic_publish_isr(&bus, TEST_EVENT_ID_LATENCY);
+
+        /* 等待本次事件被回调，再间隔1ms发布下一个事件，模拟零散中断 */
+        uint64_t deadline = os_monotonic_time_get_microsecond() + 1000000U;
+        while (atomic_load_explicit(&latency_count, memory_order_acquire) <= i) {
+            if (os_monotonic_time_get_microsecond() > deadline) {
+                os_printf("[topic][PERF] 等待回调超时 i=%zu\n", i);
+                ret = -1;
+                break;
+            }
+            os_thread_sleep_ms(0);
+        }
+        os_thread_sleep_ms(1);
+    }
+
+    topic_server_stop(&server);
+    topic_bus_deinit(&bus);
+    if (ret != 0) return ret;
+
+    qsort(latency_samples, samples, sizeof(latency_samples[0]), latency_compare);
+    os_printf("[topic][PERF] %s(周期=%ums): p50=%u us, p99=%u us, max=%u us, 空闲%ums唤醒=%llu次\n",
+              event_driven ? "事件唤醒" : "周期轮询", (unsigned)period_ms,
+              latency_samples[samples / 2], latency_samples[(samples * 99) / 100],
+              latency_samples[samples - 1], (unsigned)PERF_TEST_LATENCY_IDLE_MS,
+              (unsigned long long)idle_wakeups);
+    return 0;
+}
+
+/*
+ * @brief ISR -> 回调端到端延迟：事件唤醒 vs 周期轮询
+ * @return 0成功，-1失败
+ */
+static int test_performance_isr_latency(void) {
+    os_printf("\n[topic][PERF] ISR到回调端到端延迟测试\n");
+
+    if (latency_run(1, TOPIC_BUS_SERVER_PERIOD_MS, PERF_TEST_LATENCY_SAMPLES) != 0) return -1;
+    /* 默认100ms轮询单次采样即需数十毫秒，此处以10ms周期作对比 */
+    if (latency_run(0, PERF_TEST_LATENCY_POLL_MS, PERF_TEST_LATENCY_SAMPLES / 5) != 0) return -1;
+    return 0;
+}
+#endif
+#endif
+#endif
+
+/* ---------------- Topic Router测试 ---------------- */
+
+#if TOPIC_BUS_ENABLE_ROUTER
+/*
+ * @brief 自定义Router回调函数
+ */
+static int custom_router_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    (void)user_data;
+    atomic_fetch_add_explicit(&router_custom_count, 1, memory_order_relaxed);
+    return 0;
+}
+
+/*
+ * @brief 测试VFB Router（5.1）
+ * @return 0成功，-1失败
+ */
+static int test_router_vfb(void) {
+    os_printf("\n[topic][ROUTER] VFB Router测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
+    topic_router_t router;
+    topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+
+    /* 添加VFB Router */
+    if (topic_router_add_vfb(&router, TEST_TOPIC_ID_ROUTER_VFB, 100) != 0) {
+        os_printf("[topic][ROUTER] 添加VFB Router失败\n");
+        return -1;
+    }
+
+    /* VFB类型的枚举值为0，槽位占用不能再以type判断 */
+    if (topic_router_count(&router, TEST_TOPIC_ID_ROUTER_VFB) != 1) {
+        os_printf("[topic][ROUTER] 已添加的VFB Router查找失败\n");
+        topic_router_deinit(&router);
+        return -1;
+    }
+
+    /* 设置Router到Topic Bus */
+#if TOPIC_BUS_ENABLE_ROUTER
+    topic_bus_set_router(&bus, &router);
+#endif
+
+    /* 创建Topic并触发 */
+    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_VFB};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+
+    topic_rule_create(&bus, TEST_TOPIC_ID_ROUTER_VFB, &rule);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_VFB, &event_data, sizeof(event_data), 0);
+
+    atomic_store_explicit(&router_vfb_count, 0, memory_order_release);
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_VFB);
+
+    topic_bus_deinit(&bus);
+    topic_router_deinit(&router);
+
+    /* 注意：VFB Router需要VFB模块支持，这里仅测试Router调用 */
+    os_printf("[topic][ROUTER] VFB Router测试: 通过（需VFB模块支持）\n");
+    return 0;
+}
+
+/*
+ * @brief 测试自定义Router（5.2）
+ * @return 0成功，-1失败
+ */
+static int test_router_custom(void) {
+    os_printf("\n[topic][ROUTER] 自定义Router测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
+    topic_router_t router;
+    topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+
+    /* 添加自定义Router */
+    if (topic_router_add_custom(&router, TEST_TOPIC_ID_ROUTER_CUSTOM, custom_router_callback, NULL) != 0) {
+        os_printf("[topic][ROUTER] 添加自定义Router失败\n");
+        return -1;
+    }
+
+#if TOPIC_BUS_ENABLE_ROUTER
+    topic_bus_set_router(&bus, &router);
+#endif
+
+    /* 创建Topic并触发 */
+    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_CUSTOM};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+
+    topic_rule_create(&bus, TEST_TOPIC_ID_ROUTER_CUSTOM, &rule);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_CUSTOM, &event_data, sizeof(event_data), 0);
+
+    atomic_store_explicit(&router_custom_count, 0, memory_order_release);
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_CUSTOM);
+
+    if (atomic_load_explicit(&router_custom_count, memory_order_acquire) != 1) {
+        os_printf("[topic][ROUTER] 自定义Router回调未执行 count=%u\n",
+                  atomic_load_explicit(&router_custom_count, memory_order_acquire));
+        return -1;
+    }
+
+    topic_bus_deinit(&bus);
+    topic_router_deinit(&router);
+
+    os_printf("[topic][ROUTER] 自定义Router测试: 通过\n");
+    return 0;
+}
+
+/*
+ * @brief 测试多Router（5.3）
+ * @return 0成功，-1失败
+ */
+static int test_router_multiple(void) {
+    os_printf("\n[topic][ROUTER] 多Router测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
+    topic_router_t router;
+    topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+
+    /* 为Topic1添加VFB Router和自定义Router */
+    topic_router_add_vfb(&router, TEST_TOPIC_ID_ROUTER_MULTIPLE, 100);
+    topic_router_add_custom(&router, TEST_TOPIC_ID_ROUTER_MULTIPLE, custom_router_callback, NULL);
+    if (topic_router_count(&router, TEST_TOPIC_ID_ROUTER_MULTIPLE) != 2) {
+        os_printf("[topic][ROUTER] VFB与自定义Router未同时登记\n");
+        topic_router_deinit(&router);
+        return -1;
+    }
+
+#if TOPIC_BUS_ENABLE_ROUTER
+    topic_bus_set_router(&bus, &router);
+#endif
+
+    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_MULTIPLE};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+
+    topic_rule_create(&bus, TEST_TOPIC_ID_ROUTER_MULTIPLE, &rule);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_MULTIPLE, &event_data, sizeof(event_data), 0);
+
+    atomic_store_explicit(&router_custom_count, 0, memory_order_release);
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_MULTIPLE);
+
+    /* 验证自定义Router被调用 */
+    if (atomic_load_explicit(&router_custom_count, memory_order_acquire) != 1) {
+        os_printf("[topic][ROUTER] 多Router未全部执行\n");
+        return -1;
+    }
+
+    topic_bus_deinit(&bus);
+    topic_router_deinit(&router);
+
+    os_printf("[topic][ROUTER] 多Router测试: 通过\n");
+    return 0;
+}
+/* 批量sink的接收统计 */
+typedef struct {
+    uint32_t flushes;                   /* 收到的批次数 */
+    uint32_t records;                   /* 收到的记录数 */
+    uint32_t topic_mask;                /* 收到的Topic（按位） */
+    uint32_t bad;                       /* 解析失败或数据不一致的记录数 */
+} router_batch_sink_t;
+
+static int router_batch_flush(const void* batch, size_t len, size_t count, void* user_data) {
+    router_batch_sink_t* sink = (router_batch_sink_t*)user_data;
+    size_t offset = 0, parsed = 0;
+    uint16_t topic_id;
+    const void* data;
+    size_t data_len;
+    while (topic_router_batch_next(batch, len, &offset, &topic_id, &data, &data_len) == 0) {
+        const test_event_data_t* evt = (const test_event_data_t*)data;
+        if (data_len != sizeof(test_event_data_t) || evt->value != 0x12345678 || topic_id >= 32) {
+            sink->bad++;
+        } else {
+            sink->topic_mask |= 1U << topic_id;
+        }
+        parsed++;
+    }
+    if (parsed != count) sink->bad++;
+    sink->flushes++;
+    sink->records += (uint32_t)count;
+    return 0;
+}
+
+/*
+ * @brief 测试批量Router：多个Topic汇聚到同一sink，显式/按条数/按容量/按时间发送，移除后索引仍正确
+ * @return 0成功，-1失败
+ */
+static int test_router_batch(void) {
+    os_printf("\n[topic][ROUTER] 批量Router测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
+    topic_router_t router;
+    topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+
+    uint8_t batch_buf[256];
+    router_batch_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    topic_router_batch_t batch;
+    topic_router_batch_init(&batch, batch_buf, sizeof(batch_buf), 0, router_batch_flush, &sink);
+
+    /* 同一事件触发3个Topic，全部汇聚到同一sink；第一个Topic另有一个自定义Router */
+    obj_dict_key_t events[] = {TEST_EVENT_ID_ROUTER_BATCH};
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = events, .event_count = 1 };
+    for (uint16_t i = 0; i < PERF_TEST_ROUTER_BATCH_TOPICS; ++i) {
+        topic_rule_create(&bus, (uint16_t)(TEST_TOPIC_ID_ROUTER_BATCH_BASE + i), &rule);
+        topic_router_add_batch(&router, (uint16_t)(TEST_TOPIC_ID_ROUTER_BATCH_BASE + i), &batch);
+    }
+    topic_router_add_custom(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE, custom_router_callback, NULL);
+    topic_bus_set_router(&bus, &router);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_ROUTER_BATCH, &event_data, sizeof(event_data), 0);
+    atomic_store_explicit(&router_custom_count, 0, memory_order_release);
+
+    int ret = 0;
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    uint32_t all_topics = ((1U << PERF_TEST_ROUTER_BATCH_TOPICS) - 1U) << TEST_TOPIC_ID_ROUTER_BATCH_BASE;
+    if (sink.flushes != 0 || atomic_load_explicit(&router_custom_count, memory_order_acquire) != 1) {
+        os_printf("[topic][ROUTER] 批量记录未汇聚: flushes=%u\n", (unsigned)sink.flushes);
+        ret = -1;
+    }
+    size_t sent = topic_router_flush(&router);
+    if (ret == 0 && (sent != PERF_TEST_ROUTER_BATCH_TOPICS || sink.flushes != 1 ||
+                     sink.topic_mask != all_topics || sink.bad != 0)) {
+        os_printf("[topic][ROUTER] 显式发送错误: sent=%u flushes=%u mask=0x%x bad=%u\n",
+                  (unsigned)sent, (unsigned)sink.flushes, (unsigned)sink.topic_mask, (unsigned)sink.bad);
+        ret = -1;
+    }
+
+    /* 按容量：缓冲放不下下一条记录时先发出已汇聚的记录 */
+    size_t per_batch = sizeof(batch_buf) / ((sizeof(topic_router_batch_hdr_t) + sizeof(test_event_data_t) + 3U) & ~(size_t)3U);
+    size_t total = 8U * PERF_TEST_ROUTER_BATCH_TOPICS;
+    memset(&sink, 0, sizeof(sink));
+    for (int i = 0; i < 8; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    }
+    topic_router_flush(&router);
+    if (ret == 0 && (sink.flushes != (total + per_batch - 1U) / per_batch || sink.records != total || sink.bad != 0)) {
+        os_printf("[topic][ROUTER] 按容量发送错误: flushes=%u records=%u\n",
+                  (unsigned)sink.flushes, (unsigned)sink.records);
+        ret = -1;
+    }
+
+    /* 移除：中间Topic的唯一Router移除后，其余Topic仍可查找；首Topic移除批量后保留自定义 */
+    topic_router_remove(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE + 1, TOPIC_ROUTER_TYPE_BATCH);
+    topic_router_remove(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE, TOPIC_ROUTER_TYPE_BATCH);
+    if (ret == 0 && (topic_router_count(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE) != 1 ||
+                     topic_router_count(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE + 1) != 0 ||
+                     topic_router_count(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE + 2) != 1)) {
+        os_printf("[topic][ROUTER] 移除后索引错误\n");
+        ret = -1;
+    }
+
+    /* 按条数：max_count为1时每条立即发送 */
+    batch.max_count = 1;
+    memset(&sink, 0, sizeof(sink));
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    if (ret == 0 && (sink.flushes != 1 || sink.topic_mask != (1U << (TEST_TOPIC_ID_ROUTER_BATCH_BASE + 2)))) {
+        os_printf("[topic][ROUTER] 按条数发送错误: flushes=%u mask=0x%x\n",
+                  (unsigned)sink.flushes, (unsigned)sink.topic_mask);
+        ret = -1;
+    }
+
+    /* 按时间：最早一条等待超过max_delay_ms后，由topic_router_flush_due或下一次汇聚发出 */
+    batch.max_count = 0;
+    topic_router_batch_set_max_delay(&batch, 20);
+    memset(&sink, 0, sizeof(sink));
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    size_t due_early = topic_router_flush_due(&router);
+    os_thread_sleep_ms(30);
+    size_t due = topic_router_flush_due(&router);
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    os_thread_sleep_ms(30);
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    if (ret == 0 && (due_early != 0 || due != 1 || sink.flushes != 2 || sink.records != 3)) {
+        os_printf("[topic][ROUTER] 按时间发送错误: early=%u due=%u flushes=%u records=%u\n", (unsigned)due_early,
+                  (unsigned)due, (unsigned)sink.flushes, (unsigned)sink.records);
+        ret = -1;
+    }
+
+    /* sink只能属于一个Router；最后一个批量Router移除后sink注销，不再被原Router发送，可登记到其他Router */
+    topic_router_entry_t other_entries[2];
+    topic_router_t other;
+    topic_router_init(&other, other_entries, 2);
+    int foreign = topic_router_add_batch(&other, TEST_TOPIC_ID_ROUTER_BATCH_BASE, &batch);
+    topic_router_batch_set_max_delay(&batch, 0);
+    memset(&sink, 0, sizeof(sink));
+    topic_publish_event(&bus, TEST_EVENT_ID_ROUTER_BATCH);
+    topic_router_remove(&router, TEST_TOPIC_ID_ROUTER_BATCH_BASE + 2, TOPIC_ROUTER_TYPE_BATCH);
+    size_t orphan = topic_router_flush(&router);
+    int moved = topic_router_add_batch(&other, TEST_TOPIC_ID_ROUTER_BATCH_BASE, &batch);
+    size_t moved_sent = topic_router_flush(&other);
+    if (ret == 0 && (foreign != -1 || orphan != 0 || moved != 0 || moved_sent != 1 || sink.flushes != 1)) {
+        os_printf("[topic][ROUTER] sink注销错误: foreign=%d orphan=%u moved=%d sent=%u\n", foreign,
+                  (unsigned)orphan, moved, (unsigned)moved_sent);
+        ret = -1;
+    }
+    topic_router_deinit(&other);
+
+    topic_bus_deinit(&bus);
+    topic_router_deinit(&router);
+    topic_router_batch_deinit(&batch);
+    if (ret == 0) {
+        os_printf("[topic][ROUTER] 批量Router测试: 通过\n");
+    }
+    return ret;
+}
+
+static int router_count_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    (*(uint32_t*)user_data)++;
+    return 0;
+}
+
+typedef struct {
+    topic_router_t* router;
+    atomic_int stop;
+    uint32_t changes;
+    uint32_t hits;
+} router_churn_t;
+
+static void* router_churn_entry(void* param) {
+    router_churn_t* ctx = (router_churn_t*)param;
+    while (!atomic_load_explicit(&ctx->stop, memory_order_relaxed)) {
+        /* 同一Topic与相邻Topic反复增删，每次都发布新快照 */
+        if (topic_router_add_vfb(ctx->router, 1, 100) == 0 &&
+            topic_router_remove(ctx->router, 1, TOPIC_ROUTER_TYPE_VFB) == 0) {
+            ctx->changes++;
+        }
+        if (topic_router_add_custom(ctx->router, 2, router_count_callback, &ctx->hits) == 0 &&
+            topic_router_remove(ctx->router, 2, TOPIC_ROUTER_TYPE_CUSTOM) == 0) {
+            ctx->changes++;
+        }
+    }
+    return NULL;
+}
+
+static int router_blocking_flush(const void* batch, size_t len, size_t count, void* user_data) {
+    (void)batch;
+    (void)len;
+    (void)count;
+    (void)user_data;
+    os_thread_sleep_ms(200);  /* 超过配置接口的加锁超时 */
+    return 0;
+}
+
+static void* router_flush_entry(void* param) {
+    topic_router_flush((topic_router_t*)param);
+    return NULL;
+}
+
+/*
+ * @brief 并发增删Router时route不加锁、不丢失已有Router，退役快照在宽限期后回收；sink发送期间可增删；
+ *        释放仍登记的sink时先移除其Router
+ * @return 0成功，-1失败
+ */
+static int test_router_churn(void) {
+    os_printf("\n[topic][ROUTER] 并发增删Router测试\n");
+
+    topic_router_entry_t entries[8];
+    topic_router_t router;
+    topic_router_init(&router, entries, 8);
+    uint32_t hits = 0;
+    topic_router_add_custom(&router, 1, router_count_callback, &hits);  /* 增删的VFB Router挂在其后 */
+
+    router_churn_t ctx = { .router = &router, .changes = 0, .hits = 0 };
+    atomic_init(&ctx.stop, 0);
+    ThreadAttr_t attr = { .pName = "RouterChurn", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    OsThread_t* thread = os_thread_create(router_churn_entry, &ctx, &attr);
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    for (int i = 0; i < PERF_TEST_ROUTER_CHURN_LOOPS && thread; ++i) {
+        topic_router_route(&router, 1, &event_data, sizeof(event_data));
+    }
+    atomic_store_explicit(&ctx.stop, 1, memory_order_relaxed);
+    if (thread) {
+        os_thread_join(thread);
+        os_thread_destroy(thread);
+    }
+
+    /* 另一线程flush时发送函数阻塞，增删Router不等待发送完成 */
+    uint8_t batch_buf[64];
+    topic_router_batch_t batch;
+    topic_router_batch_init(&batch, batch_buf, sizeof(batch_buf), 0, router_blocking_flush, NULL);
+    topic_router_add_batch(&router, 3, &batch);
+    topic_router_route(&router, 3, &event_data, sizeof(event_data));
+    OsThread_t* flusher = os_thread_create(router_flush_entry, &router, &attr);
+    os_thread_sleep_ms(50);
+    int blocked_add = flusher ? topic_router_add_custom(&router, 4, router_count_callback, &ctx.hits) : -1;
+    if (flusher) {
+        os_thread_join(flusher);
+        os_thread_destroy(flusher);
+    }
+    topic_router_remove(&router, 4, TOPIC_ROUTER_TYPE_CUSTOM);
+
+    /* 仍有Router引用时释放sink：引用它的Router全部移除、sink注销后才销毁 */
+    topic_router_add_batch(&router, 5, &batch);
+    uint32_t flushes = batch.flushes;
+    int deinit = topic_router_batch_deinit(&batch);
+
+    topic_router_synchronize(&router);
+    int ret = 0;
+    if (blocked_add != 0 || flushes != 1) {
+        os_printf("[topic][ROUTER] sink发送期间增删失败: add=%d flushes=%u\n", blocked_add, (unsigned)flushes);
+        ret = -1;
+    }
+    if (ret == 0 && (deinit != 0 || batch.owner != NULL || topic_router_count(&router, 3) != 0 ||
+                     topic_router_count(&router, 5) != 0 || topic_router_flush(&router) != 0)) {
+        os_printf("[topic][ROUTER] 释放已登记的sink错误: deinit=%d\n", deinit);
+        ret = -1;
+    }
+    if (ret == 0 && (!thread || hits != PERF_TEST_ROUTER_CHURN_LOOPS || topic_router_count(&router, 1) != 1 ||
+        topic_router_count(&router, 2) != 0 || router.rcu_retired != NULL)) {
+        os_printf("[topic][ROUTER] 并发增删错误: hits=%u changes=%u retired=%d\n", (unsigned)hits,
+                  (unsigned)ctx.changes, router.rcu_retired != NULL);
+        ret = -1;
+    } else if (ret == 0) {
+        os_printf("[topic][ROUTER] 并发增删: %d次route, %u次增删, 已有Router无丢失\n", PERF_TEST_ROUTER_CHURN_LOOPS,
+                  (unsigned)ctx.changes);
+    }
+    topic_router_deinit(&router);
+    return ret;
+}
+
+/*
+ * @brief 原实现的路由方式：扫描全部槽位并逐个比较topic_id（基准对比用）
+ */
+static int router_scan_route(topic_router_t* router, uint16_t topic_id, const void* data, size_t data_len) {
+    int routed = 0;
+    for (size_t i = 0; i < router->max_routers; ++i) {
+        topic_router_entry_t* entry = &router->routers[i];
+        if (!entry->in_use || entry->topic_id != topic_id) continue;
+        if (entry->type == TOPIC_ROUTER_TYPE_CUSTOM &&
+            entry->u.custom_cb(topic_id, data, data_len, entry->callback_user_data) == 0) {
+            routed++;
+        }
+    }
+    return (routed > 0) ? 0 : -1;
+}
+
+static int router_slow_send(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    (void)user_data;
+    uint64_t until = os_monotonic_time_get_microsecond() + PERF_TEST_ROUTER_SEND_US;
+    while (os_monotonic_time_get_microsecond() < until) {
+    }
+    return 0;
+}
+
+static int router_slow_flush(const void* batch, size_t len, size_t count, void* user_data) {
+    (void)batch;
+    (void)len;
+    (void)count;
+    return router_slow_send(0, NULL, 0, user_data);
+}
+
+/*
+ * @brief Router性能测试：8~512条Router下索引查找与全槽位扫描对比；固定单次发送开销的传输上逐条与批量对比
+ * @return 0成功，-1失败
+ */
+static int test_performance_router(void) {
+    os_printf("\n[topic][PERF] Router索引与批量发送测试\n");
+
+    topic_router_entry_t* entries =
+        (topic_router_entry_t*)os_malloc(sizeof(topic_router_entry_t) * PERF_TEST_ROUTER_MAX_ROUTES);
+    if (!entries) return -1;
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    int ret = 0;
+
+    for (size_t routes = 8; routes <= PERF_TEST_ROUTER_MAX_ROUTES; routes *= 4) {
+        /* 每个Topic一条Router，依次路由全部Topic */
+        topic_router_t router;
+        topic_router_init(&router, entries, routes);
+        uint32_t hits = 0;
+        for (size_t i = 0; i < routes; ++i) {
+            topic_router_add_custom(&router, (uint16_t)(i + 1), router_count_callback, &hits);
+        }
+
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+            router_scan_route(&router, (uint16_t)((size_t)i % routes + 1), &event_data, sizeof(event_data));
+        }
+        uint64_t scan_us = os_monotonic_time_get_microsecond() - start;
+
+        start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+            topic_router_route(&router, (uint16_t)((size_t)i % routes + 1), &event_data, sizeof(event_data));
+        }
+        uint64_t index_us = os_monotonic_time_get_microsecond() - start;
+
+        if (hits != 2U * PERF_TEST_LOOPS) {
+            os_printf("[topic][PERF] Router命中数错误: %u\n", (unsigned)hits);
+            ret = -1;
+        }
+        os_printf("[topic][PERF] %3u条Router: 全槽位扫描 %.1f ns/route, 索引查找 %.1f ns/route\n",
+                  (unsigned)routes, (double)scan_us * 1000.0 / PERF_TEST_LOOPS,
+                  (double)index_us * 1000.0 / PERF_TEST_LOOPS);
+        topic_router_deinit(&router);
+    }
+
+    /* 每次发送固定开销（模拟一次串口/网络写）：逐条发送与每16条一批 */
+    {
+        topic_router_t router;
+        topic_router_init(&router, entries, 16);
+        uint8_t batch_buf[1024];
+        topic_router_batch_t batch;
+        topic_router_batch_init(&batch, batch_buf, sizeof(batch_buf), PERF_TEST_ROUTER_BATCH_COUNT,
+                                router_slow_flush, NULL);
+        for (uint16_t i = 0; i < 8; ++i) {
+            topic_router_add_custom(&router, (uint16_t)(i + 1), router_slow_send, NULL);
+            topic_router_add_batch(&router, (uint16_t)(i + 9), &batch);
+        }
+        int loops = PERF_TEST_LOOPS / 10;
+
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < loops; ++i) {
+            topic_router_route(&router, (uint16_t)(i % 8 + 1), &event_data, sizeof(event_data));
+        }
+        uint64_t single_us = os_monotonic_time_get_microsecond() - start;
+
+        start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < loops; ++i) {
+            topic_router_route(&router, (uint16_t)(i % 8 + 9), &event_data, sizeof(event_data));
+        }
+        topic_router_flush(&router);
+        uint64_t batch_us = os_monotonic_time_get_microsecond() - start;
+
+        os_printf("[topic][PERF] 单次发送%dus的传输(%d条): 逐条 %.3f us/record, 每%d条一批 %.3f us/record (%u批)\n",
+                  PERF_TEST_ROUTER_SEND_US, loops, (double)single_us / loops, PERF_TEST_ROUTER_BATCH_COUNT,
+                  (double)batch_us / loops, (unsigned)batch.flushes);
+        topic_router_deinit(&router);
+        topic_router_batch_deinit(&batch);
+    }
+
+    os_free(entries);
+    return ret;
+}
+#endif
+
+/* ---------------- ISR路径测试 ---------------- */
+
+#if TOPIC_BUS_ENABLE_ISR
+/*
+ * @brief 测试ISR发布（6.1）
+ * @return 0成功，-1失败
+ */
+static int test_isr_publish(void) {
+    os_printf("\n[topic][ISR] ISR发布测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    /* 创建Topic */
+    obj_dict_key_t events[] = {TEST_EVENT_ID_ISR};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+
+    topic_rule_create(&bus, TEST_TOPIC_ID_ISR, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_ISR, test_callback, NULL);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_ISR, &event_data, sizeof(event_data), 0);
+
+    /* 模拟ISR发布 */
+    if (topic_publish_isr(&bus, TEST_EVENT_ID_ISR) != 0) {
+        os_printf("[topic][ISR] ISR发布失败\n");
+        return -1;
+    }
+
+    /* 在任务上下文中处理ISR队列 */
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    topic_bus_process_isr_queue(&bus);
+
+    if (atomic_load_explicit(&callback_count, memory_order_acquire) != 1) {
+        os_printf("[topic][ISR] ISR事件未处理 count=%u\n",
+                  atomic_load_explicit(&callback_count, memory_order_acquire));
+        return -1;
+    }
+
+    os_printf("[topic][ISR] ISR发布测试: 通过\n");
+    return 0;
+}
+
+/* 多生产者ISR发布上下文 */
+typedef struct {
+    topic_bus_t* bus;
+    atomic_uint accepted;      /* 成功入队数 */
+    atomic_uint producers_left;
+} isr_mp_ctx_t;
+
+static void* isr_mp_producer_entry(void* param) {
+    isr_mp_ctx_t* ctx = (isr_mp_ctx_t*)param;
+    unsigned accepted = 0;
+    for (int i = 0; i < PERF_TEST_ISR_PER_PRODUCER; ++i) {
+        if (topic_publish_isr(ctx->bus, TEST_EVENT_ID_ISR) == 0) {
+            accepted++;
+        } else {
+            os_thread_sleep_ms(0);  /* 队列满，等待任务侧排空 */
+        }
+    }
+    atomic_fetch_add_explicit(&ctx->accepted, accepted, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&ctx->producers_left, 1, memory_order_release);
+    return NULL;
+}
+
+/*
+ * @brief 测试多个生产者并发ISR发布：入队成功的事件全部被处理，无丢失、无重复
+ * @return 0成功，-1失败
+ */
+static int test_isr_multi_producer(void) {
+    os_printf("\n[topic][ISR] 多生产者并发ISR发布测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    obj_dict_key_t events[] = {TEST_EVENT_ID_ISR};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+    topic_rule_create(&bus, TEST_TOPIC_ID_ISR, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_ISR, test_callback, NULL);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_ISR, &event_data, sizeof(event_data), 0);
+
+    isr_mp_ctx_t ctx = { .bus = &bus };
+    atomic_init(&ctx.accepted, 0);
+    atomic_init(&ctx.producers_left, PERF_TEST_ISR_PRODUCERS);
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+
+    ThreadAttr_t attr = { .pName = "isr_mp", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    OsThread_t* threads[PERF_TEST_ISR_PRODUCERS] = {0};
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_ISR_PRODUCERS; ++i) {
+        threads[i] = os_thread_create(isr_mp_producer_entry, &ctx, &attr);
+    }
+
+    /* 任务侧持续排空，直到生产者全部结束且队列为空 */
+    for (;;) {
+        int done = atomic_load_explicit(&ctx.producers_left, memory_order_acquire) == 0;
+        topic_bus_process_isr_queue(&bus);
+        if (done && ring_buffer_mpmc_get_count(bus.isr_queue) == 0) break;
+        os_thread_sleep_ms(0);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+
+    for (int i = 0; i < PERF_TEST_ISR_PRODUCERS; ++i) {
+        if (threads[i]) {
+            os_thread_join(threads[i]);
+            os_thread_destroy(threads[i]);
+        }
+    }
+
+    unsigned accepted = atomic_load_explicit(&ctx.accepted, memory_order_acquire);
+    unsigned callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
+    topic_bus_deinit(&bus);
+
+    os_printf("[topic][ISR] 生产者=%d, 入队=%u, 回调=%u, 耗时=%llu us\n",
+              PERF_TEST_ISR_PRODUCERS, accepted, callbacks, (unsigned long long)(end - start));
+    if (callbacks != accepted) {
+        os_printf("[topic][ISR] 并发ISR事件丢失或重复\n");
+        return -1;
+    }
+
+    os_printf("[topic][ISR] 多生产者并发ISR发布测试: 通过\n");
+    return 0;
+}
+#endif
+
+/* ---------------- 时效性性能测试 ---------------- */
+
+/*
+ * @brief 测试时效性检查性能开销（7.3）
+ * @return 0成功，-1失败
+ */
+static int test_performance_timeout(void) {
+    os_printf("\n[topic][PERF] 时效性检查性能测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    obj_dict_key_t events[] = {TEST_EVENT_ID_PERF_TIMEOUT};
+    uint32_t timeouts[] = {3000};  /* 启用时效性检查 */
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+        .event_timeouts_ms = timeouts,
+    };
+
+    topic_rule_create(&bus, TEST_TOPIC_ID_PERF_TIMEOUT, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_PERF_TIMEOUT, test_callback, NULL);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_PERF_TIMEOUT, &event_data, sizeof(event_data), 0);
+
+    /* 测量带时效性检查的性能 */
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_PERF_TIMEOUT);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+
+    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
+    os_printf("[topic][PERF] 时效性检查延迟: %.2f us/publish\n", avg_us);
+
+    return 0;
+}
+
+/*
+ * @brief AND规则时效性检查性能测试：字典条目较多时，其余事件的时效由快照判定，不随字典规模增长
+ * @return 0成功，-1失败
+ */
+static int test_performance_timeout_and(void) {
+    os_printf("\n[topic][PERF] AND规则时效快照性能测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+
+    /* 规则事件排在大量无关条目之后，放大按键查找的代价 */
+    for (int i = 0; i < PERF_TEST_AND_FILLER_KEYS; ++i) {
+        obj_dict_set(&dict, (obj_dict_key_t)(TEST_EVENT_ID_PERF_TIMEOUT_FILLER_BASE + i),
+                     &event_data, sizeof(event_data), 0);
+    }
+
+    obj_dict_key_t events[PERF_TEST_AND_EVENTS];
+    uint32_t timeouts[PERF_TEST_AND_EVENTS];
+    for (int i = 0; i < PERF_TEST_AND_EVENTS; ++i) {
+        events[i] = (obj_dict_key_t)(TEST_EVENT_ID_PERF_TIMEOUT_AND_BASE + i);
+        timeouts[i] = 3000;  /* 启用时效性检查 */
+        obj_dict_set(&dict, events[i], &event_data, sizeof(event_data), 0);
+    }
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_AND,
+        .events = events,
+        .event_count = PERF_TEST_AND_EVENTS,
+        .event_timeouts_ms = timeouts,
+    };
+
+    topic_rule_create(&bus, TEST_TOPIC_ID_PERF_TIMEOUT_AND, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_PERF_TIMEOUT_AND, test_callback, NULL);
+
+    /* 轮流发布全部事件，每轮触发一次 */
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+        topic_publish_event(&bus, events[i % PERF_TEST_AND_EVENTS]);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+
+    unsigned expected = PERF_TEST_LOOPS / PERF_TEST_AND_EVENTS;
+    unsigned got = atomic_load_explicit(&callback_count, memory_order_acquire);
+    topic_bus_deinit(&bus);
+    if (got != expected) {
+        os_printf("[topic][PERF] AND规则触发次数错误: %u (期望 %u)\n", got, expected);
+        return -1;
+    }
+
+    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
+    os_printf("[topic][PERF] AND规则(%d事件, 字典%d条)时效检查延迟: %.2f us/publish\n",
+              PERF_TEST_AND_EVENTS, PERF_TEST_AND_FILLER_KEYS + PERF_TEST_AND_EVENTS, avg_us);
+
+    return 0;
+}
+
+/* ---------------- 高并发测试 ---------------- */
+
+/*
+ * @brief 测试高并发场景（7.4）
+ * @return 0成功，-1失败
+ */
+static int test_concurrent_high(void) {
+    os_printf("\n[topic][CONCURRENT] 高并发测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    /* 创建多个Topic */
+    for (uint16_t i = 0; i < 8; ++i) {
+        obj_dict_key_t events[] = {(obj_dict_key_t)(TEST_EVENT_ID_CONCURRENT_BASE + i)};
+        topic_rule_t rule = {
+            .type = TOPIC_RULE_OR,
+            .events = events,
+            .event_count = 1,
+        };
+        topic_rule_create(&bus, (test_topic_id_t)(TEST_TOPIC_ID_CONCURRENT_BASE + i), &rule);
+        /* 每个Topic注册多个订阅者 */
+        for (int j = 0; j < 4; ++j) {
+            topic_subscribe(&bus, (test_topic_id_t)(TEST_TOPIC_ID_CONCURRENT_BASE + i), test_callback, NULL);
+        }
+    }
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+
+    /* 并发发布事件 */
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < 10000; ++i) {
+        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_CONCURRENT_BASE + (i % 8));
+        obj_dict_set(&dict, key, &event_data, sizeof(event_data), 0);
+        topic_publish_event(&bus, key);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+
+    double avg_us = (double)(end - start) / 10000;
+    uint32_t total_callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
+    os_printf("[topic][CONCURRENT] 高并发延迟: %.2f us/publish, 总回调数=%u\n",
+              avg_us, total_callbacks);
+
+    return 0;
+}
+
+/* ---------------- 订阅者并发变更压力测试 ---------------- */
+
+/* 订阅变更压测共享状态 */
+typedef struct churn_ctx {
+    topic_bus_t* bus;
+    atomic_int stop;
+    atomic_ulong publishes;
+    atomic_ulong churn_ops;
+    atomic_ulong stable_callbacks;
+    atomic_ulong churn_callbacks;
+    struct churn_ctx* tokens[8];    /* 临时订阅者的user_data：发布者可能仍持有取消订阅前的数组快照，
+                                       因此不能放在订阅变更线程的栈上 */
+} churn_ctx_t;
+
+static void churn_stable_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    churn_ctx_t* ctx = (churn_ctx_t*)user;
+    atomic_fetch_add_explicit(&ctx->stable_callbacks, 1, memory_order_relaxed);
+}
+
+static void churn_volatile_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    (void)data;
+    (void)data_len;
+    churn_ctx_t* ctx = *(churn_ctx_t**)user;
+    atomic_fetch_add_explicit(&ctx->churn_callbacks, 1, memory_order_relaxed);
+}
+
+static void* churn_publisher_entry(void* param) {
+    churn_ctx_t* ctx = (churn_ctx_t*)param;
+    unsigned long count = 0;
+    while (!atomic_load_explicit(&ctx->stop, memory_order_acquire)) {
+        if (topic_publish_event(ctx->bus, TEST_EVENT_ID_CHURN) == 0) {
+            count++;
+        }
+    }
+    atomic_fetch_add_explicit(&ctx->publishes, count, memory_order_relaxed);
+#if TOPIC_BUS_ENABLE_TRACE
+    topic_trace_thread_exit();
+#endif
+    return NULL;
+}
+
+static void* churn_subscriber_entry(void* param) {
+    churn_ctx_t* ctx = (churn_ctx_t*)param;
+    /* 每个临时订阅者用不同的user_data区分，回调内通过它找回ctx */
+    for (size_t i = 0; i < 8; ++i) ctx->tokens[i] = ctx;
+    unsigned long ops = 0;
+    size_t i = 0;
+    while (!atomic_load_explicit(&ctx->stop, memory_order_acquire)) {
+        void* token = &ctx->tokens[i++ & 7U];
+        if (topic_subscribe(ctx->bus, TEST_TOPIC_ID_CHURN, churn_volatile_callback, token) == 0) {
+            ops++;
+            if (topic_unsubscribe(ctx->bus, TEST_TOPIC_ID_CHURN, churn_volatile_callback, token) == 0) {
+                ops++;
+            }
+        }
+    }
+    atomic_fetch_add_explicit(&ctx->churn_ops, ops, memory_order_relaxed);
+    return NULL;
+}
+
+/*
+ * @brief 发布与订阅/取消订阅并发压力测试（写时复制订阅者数组）
+ * @details 多个线程持续发布，同时一个线程不断订阅/取消订阅；
+ *          常驻订阅者的回调次数必须与发布次数严格一致
+ * @return 0成功，-1失败
+ */
+static int test_concurrent_subscriber_churn(void) {
+    os_printf("\n[topic][CONCURRENT] 订阅者并发变更压力测试（%d发布线程 + 1订阅变更线程, %dms）\n",
+              PERF_TEST_CHURN_PUBLISHERS, PERF_TEST_CHURN_DURATION_MS);
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    if (topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict) != 0) {
+        os_printf("[topic][CONCURRENT] topic_bus初始化失败\n");
+        return -1;
+    }
+
+    obj_dict_key_t events[] = {TEST_EVENT_ID_CHURN};
+    uint32_t timeouts[] = {TOPIC_BUS_EVENT_TIMEOUT_MAX};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+        .event_timeouts_ms = timeouts,
+    };
+    topic_rule_create(&bus, TEST_TOPIC_ID_CHURN, &rule);
+
+    static churn_ctx_t ctx;
+    ctx.bus = &bus;
+    atomic_init(&ctx.stop, 0);
+    atomic_init(&ctx.publishes, 0);
+    atomic_init(&ctx.churn_ops, 0);
+    atomic_init(&ctx.stable_callbacks, 0);
+    atomic_init(&ctx.churn_callbacks, 0);
+
+    topic_subscribe(&bus, TEST_TOPIC_ID_CHURN, churn_stable_callback, &ctx);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_CHURN, &event_data, sizeof(event_data), 0);
+
+    ThreadAttr_t attr = { .pName = "churn", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    OsThread_t* threads[PERF_TEST_CHURN_PUBLISHERS + 1] = {0};
+    for (int i = 0; i < PERF_TEST_CHURN_PUBLISHERS; ++i) {
+        threads[i] = os_thread_create(churn_publisher_entry, &ctx, &attr);
+    }
+    threads[PERF_TEST_CHURN_PUBLISHERS] = os_thread_create(churn_subscriber_entry, &ctx, &attr);
+
+    os_thread_sleep_ms(PERF_TEST_CHURN_DURATION_MS);
+    atomic_store_explicit(&ctx.stop, 1, memory_order_release);
+    for (int i = 0; i <= PERF_TEST_CHURN_PUBLISHERS; ++i) {
+        if (threads[i]) {
+            os_thread_join(threads[i]);
+            os_thread_destroy(threads[i]);
+        }
+    }
+
+    unsigned long publishes = atomic_load(&ctx.publishes);
+    unsigned long stable = atomic_load(&ctx.stable_callbacks);
+    unsigned long churn_ops = atomic_load(&ctx.churn_ops);
+    unsigned long churn_cbs = atomic_load(&ctx.churn_callbacks);
+
+    topic_bus_deinit(&bus);
+
+    double secs = PERF_TEST_CHURN_DURATION_MS / 1000.0;
+    os_printf("[topic][CONCURRENT] 发布=%lu (%.0f/s), 订阅变更=%lu (%.0f/s), 常驻回调=%lu, 临时回调=%lu\n",
+              publishes, publishes / secs, churn_ops, churn_ops / secs, stable, churn_cbs);
+
+    if (stable != publishes || churn_ops == 0) {
+        os_printf("[topic][CONCURRENT] 常驻订阅者回调数与发布数不一致或订阅变更未执行\n");
+        return -1;
+    }
+
+    os_printf("[topic][CONCURRENT] 订阅者并发变更压力测试: 通过\n");
+    return 0;
+}
+
+/* ---------------- 性能测试：事件发布延迟 ---------------- */
+
+static int test_performance_event_publish(void) {
+    os_printf("\n[topic][PERF] 事件发布延迟测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    /* 创建多个OR规则的Topic */
+    for (uint16_t i = 0; i < 5; ++i) {
         obj_dict_key_t events[2] = {(obj_dict_key_t)(TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE + i), 
                                      (obj_dict_key_t)(TEST_EVENT_ID_PERF_EVENT_PUBLISH_OFFSET + i)};
         topic_rule_t rule = {
@@ -989,102 +2761,2792 @@ static int test_performance_event_publish(void) {
         topic_subscribe(&bus, (test_topic_id_t)(TEST_TOPIC_ID_PERF_EVENT_PUBLISH_BASE + i), test_callback, NULL);
     }
 
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+
+    /* 预热 */
+    for (int i = 0; i < 1000; ++i) {
+        obj_dict_set(&dict, TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE, &event_data, sizeof(event_data), 0);
+        topic_publish_event(&bus, TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE);
+    }
+
+    /* 测量延迟 */
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE + (i % 5));
+        obj_dict_set(&dict, key, &event_data, sizeof(event_data), 0);
+        topic_publish_event(&bus, key);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+
+    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
+    os_printf("[topic][PERF] 事件发布延迟: %.2f us/publish (原子=%d)\n",
+              avg_us, TOPIC_BUS_ENABLE_ATOMICS);
+
+    return 0;
+}
+
+/* ---------------- 性能测试：规则匹配性能 ---------------- */
+
+static int test_performance_rule_matching(void) {
+    os_printf("\n[topic][PERF] 规则匹配性能测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    /* 创建多个Topic（OR规则） */
+    /* 使用静态数组，避免栈上的数组生命周期问题 */
+    static obj_dict_key_t events_or_static[10][1];
+    for (uint16_t i = 0; i < 10; ++i) {
+        events_or_static[i][0] = (obj_dict_key_t)(TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE + i);
+        topic_rule_t rule = {
+            .type = TOPIC_RULE_OR,
+            .events = events_or_static[i],
+            .event_count = 1,
+        };
+        topic_rule_create(&bus, (test_topic_id_t)(TEST_TOPIC_ID_PERF_RULE_MATCHING_OR_BASE + i), &rule);
+        topic_subscribe(&bus, (test_topic_id_t)(TEST_TOPIC_ID_PERF_RULE_MATCHING_OR_BASE + i), test_callback, NULL);
+    }
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+
+    /* 测量OR规则匹配性能 */
+    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_OR, &event_data, sizeof(event_data), 0);
+    
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_OR);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+
+    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
+    os_printf("[topic][PERF] OR规则匹配延迟: %.2f us/match\n", avg_us);
+
+    /* 测量AND规则匹配性能 */
+    /* 使用静态数组，避免栈上的数组生命周期问题 */
+    static obj_dict_key_t events_and[] = {TEST_EVENT_ID_PERF_RULE_MATCHING_AND_1, 
+                                           TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2, 
+                                           TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3};
+    topic_rule_t rule_and = {
+        .type = TOPIC_RULE_AND,
+        .events = events_and,
+        .event_count = 3,
+    };
+    topic_rule_create(&bus, TEST_TOPIC_ID_PERF_RULE_MATCHING_AND, &rule_and);
+    topic_subscribe(&bus, TEST_TOPIC_ID_PERF_RULE_MATCHING_AND, test_callback, NULL);
+
+    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_1, &event_data, sizeof(event_data), 0);
+    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2, &event_data, sizeof(event_data), 0);
+    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3, &event_data, sizeof(event_data), 0);
+
+    start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_LOOPS / 10; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_1);
+        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2);
+        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3);
+    }
+    end = os_monotonic_time_get_microsecond();
+
+    avg_us = (double)(end - start) / (PERF_TEST_LOOPS / 10 * 3);
+    os_printf("[topic][PERF] AND规则匹配延迟: %.2f us/match\n", avg_us);
+
+    return 0;
+}
+
+/* ---------------- 性能测试：Topic数量扩展性 ---------------- */
+
+/*
+ * @brief 测试发布开销随Topic数量的变化（事件反向索引）
+ * @details 每个Topic订阅一个独立事件，热事件仅驱动其中3个Topic；
+ *          发布开销应与Topic总数无关（64 -> 4096保持平稳）
+ * @return 0成功，-1失败
+ */
+static int test_performance_topic_scaling(void) {
+    os_printf("\n[topic][PERF] Topic数量扩展性测试（热事件驱动3个Topic，订阅管理按topic_id查找）\n");
+
+    static const size_t topic_counts[] = { 64, 256, 1024, 4096 };
+    double first_avg_us = 0.0;
+    double last_avg_us = 0.0;
+
+    for (size_t ci = 0; ci < sizeof(topic_counts) / sizeof(topic_counts[0]); ++ci) {
+        size_t n = topic_counts[ci];
+
+        obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+        obj_dict_t dict;
+        obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+        topic_entry_t* topic_entries = (topic_entry_t*)os_malloc(sizeof(topic_entry_t) * n);
+        if (!topic_entries) {
+            os_printf("[topic][PERF] 分配Topic数组失败 n=%zu\n", n);
+            return -1;
+        }
+        topic_bus_t bus;
+        if (topic_bus_init(&bus, topic_entries, n, &dict) != 0) {
+            os_printf("[topic][PERF] topic_bus初始化失败 n=%zu\n", n);
+            os_free(topic_entries);
+            return -1;
+        }
+
+        /* 前3个Topic额外引用热事件，其余Topic只引用各自的冷事件 */
+        uint32_t timeouts[2] = { TOPIC_BUS_EVENT_TIMEOUT_MAX, TOPIC_BUS_EVENT_TIMEOUT_MAX };
+        for (size_t i = 0; i < n; ++i) {
+            obj_dict_key_t events[2] = { (obj_dict_key_t)(TEST_EVENT_ID_PERF_SCALE_BASE + i),
+                                         TEST_EVENT_ID_PERF_SCALE_HOT };
+            topic_rule_t rule = {
+                .type = TOPIC_RULE_OR,
+                .events = events,
+                .event_count = (i < 3) ? 2 : 1,
+                .event_timeouts_ms = timeouts,
+            };
+            uint16_t topic_id = (uint16_t)(TEST_TOPIC_ID_PERF_SCALE_BASE + i);
+            if (topic_rule_create(&bus, topic_id, &rule) != 0 ||
+                topic_subscribe(&bus, topic_id, test_callback, NULL) != 0) {
+                os_printf("[topic][PERF] 创建Topic失败 n=%zu i=%zu\n", n, i);
+                topic_bus_deinit(&bus);
+                os_free(topic_entries);
+                return -1;
+            }
+        }
+
+        test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+        obj_dict_set(&dict, TEST_EVENT_ID_PERF_SCALE_HOT, &event_data, sizeof(event_data), 0);
+
+        atomic_store_explicit(&callback_count, 0, memory_order_release);
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_SCALE_LOOPS; ++i) {
+            topic_publish_event(&bus, TEST_EVENT_ID_PERF_SCALE_HOT);
+        }
+        uint64_t end = os_monotonic_time_get_microsecond();
+
+        uint32_t callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
+        double avg_us = (double)(end - start) / PERF_TEST_SCALE_LOOPS;
+
+        /* 管理调用开销：对最后创建的Topic反复订阅/取消订阅（topic_id -> 槽位查找） */
+        uint16_t last_topic = (uint16_t)(TEST_TOPIC_ID_PERF_SCALE_BASE + n - 1);
+        uint64_t mgmt_start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_SCALE_LOOPS / 10; ++i) {
+            topic_subscribe(&bus, last_topic, test_callback, &bus);
+            topic_unsubscribe(&bus, last_topic, test_callback, &bus);
+        }
+        uint64_t mgmt_end = os_monotonic_time_get_microsecond();
+        double mgmt_us = (double)(mgmt_end - mgmt_start) / (PERF_TEST_SCALE_LOOPS / 10 * 2);
+
+        os_printf("[topic][PERF] topics=%-5zu 发布延迟: %.3f us/publish, 订阅管理: %.3f us/call, 回调数=%u\n",
+                  n, avg_us, mgmt_us, callbacks);
+
+        topic_bus_deinit(&bus);
+        os_free(topic_entries);
+
+        if (callbacks != (uint32_t)PERF_TEST_SCALE_LOOPS * 3) {
+            os_printf("[topic][PERF] 回调次数错误 期望=%u 实际=%u\n",
+                      (unsigned)PERF_TEST_SCALE_LOOPS * 3, callbacks);
+            return -1;
+        }
+
+        if (ci == 0) first_avg_us = avg_us;
+        last_avg_us = avg_us;
+    }
+
+    os_printf("[topic][PERF] 4096/64 Topic发布开销比: %.2fx\n",
+              (first_avg_us > 0.0) ? (last_avg_us / first_avg_us) : 0.0);
+    return 0;
+}
+
+#if TOPIC_BUS_ENABLE_LOAN
+/* ---------------- 借出缓冲（零拷贝发布）测试 ---------------- */
+
+/* 借出缓冲订阅者记录 */
+typedef struct {
+    const void* last_data;
+    size_t last_len;
+    topic_bus_t* bus;       /* 借出缓冲所属总线 */
+    const void* held;       /* retain后保留的缓冲 */
+    uint32_t count;
+} loan_sub_ctx_t;
+
+static const void* loan_router_data = NULL;
+
+static void loan_sub_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    loan_sub_ctx_t* ctx = (loan_sub_ctx_t*)user;
+    ctx->last_data = data;
+    ctx->last_len = data_len;
+    ctx->count++;
+    /* 回调返回后仍需使用数据时自行增加引用 */
+    if (!ctx->held && topic_loan_retain(ctx->bus, data) == 0) {
+        ctx->held = data;
+    }
+}
+
+#if TOPIC_BUS_ENABLE_ROUTER
+static int loan_router_callback(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    (void)topic_id;
+    (void)data_len;
+    (void)user_data;
+    loan_router_data = data;
+    return 0;
+}
+#endif
+
+static size_t loan_pool_used(topic_bus_t* bus) {
+    size_t used = 0;
+    obj_dict_mempool_get_stats(bus->loan_pool, NULL, NULL, &used);
+    return used;
+}
+
+/*
+ * @brief 测试借出缓冲发布：订阅者与Router收到同一缓冲，引用计数归零后回收
+ * @return 0成功，-1失败
+ */
+static int test_loan_publish(void) {
+    os_printf("\n[topic][LOAN] 借出缓冲零拷贝发布测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    int ret = -1;
+    if (topic_bus_loan_pool_init(&bus, 4096, PERF_TEST_LOAN_BLOCKS) != 0) {
+        os_printf("[topic][LOAN] 缓冲池初始化失败\n");
+        goto cleanup;
+    }
+
+#if TOPIC_BUS_ENABLE_ROUTER
+    topic_router_entry_t router_entries[TOPIC_BUS_MAX_ROUTERS_PER_TOPIC];
+    topic_router_t router;
+    topic_router_init(&router, router_entries, TOPIC_BUS_MAX_ROUTERS_PER_TOPIC);
+    topic_router_add_custom(&router, TEST_TOPIC_ID_LOAN, loan_router_callback, NULL);
+    topic_bus_set_router(&bus, &router);
+#endif
+
+    obj_dict_key_t events[] = {TEST_EVENT_ID_LOAN};
+    topic_rule_t rule = {
+        .type = TOPIC_RULE_OR,
+        .events = events,
+        .event_count = 1,
+    };
+    topic_rule_create(&bus, TEST_TOPIC_ID_LOAN, &rule);
+
+    loan_sub_ctx_t ctx = { .bus = &bus };
+    topic_subscribe(&bus, TEST_TOPIC_ID_LOAN, loan_sub_callback, &ctx);
+
+    /* 超出容量的借出请求应失败 */
+    if (topic_loan(&bus, bus.loan_capacity + 1) != NULL) {
+        os_printf("[topic][LOAN] 超容量借出未被拒绝\n");
+        goto cleanup;
+    }
+
+    uint8_t* buf = (uint8_t*)topic_loan(&bus, 4096);
+    if (!buf) {
+        os_printf("[topic][LOAN] 借出缓冲失败\n");
+        goto cleanup;
+    }
+    for (size_t i = 0; i < 4096; ++i) buf[i] = (uint8_t)i;
+
+    loan_router_data = NULL;
+    if (topic_publish_loaned(&bus, TEST_EVENT_ID_LOAN, buf, 4096) != 0) {
+        os_printf("[topic][LOAN] 借出缓冲发布失败\n");
+        goto cleanup;
+    }
+
+    if (ctx.count != 1 || ctx.last_data != buf || ctx.last_len != 4096) {
+        os_printf("[topic][LOAN] 订阅者未收到原缓冲 count=%u\n", ctx.count);
+        goto cleanup;
+    }
+#if TOPIC_BUS_ENABLE_ROUTER
+    if (loan_router_data != buf) {
+        os_printf("[topic][LOAN] Router未收到原缓冲\n");
+        goto cleanup;
+    }
+#endif
+
+    /* 订阅者持有引用期间缓冲不应回收，数据保持不变 */
+    if (loan_pool_used(&bus) != 1 || ((const uint8_t*)ctx.held)[4095] != (uint8_t)4095) {
+        os_printf("[topic][LOAN] 持有引用的缓冲被提前回收\n");
+        goto cleanup;
+    }
+    topic_loan_release(&bus, ctx.held);
+    ctx.held = NULL;
+    if (loan_pool_used(&bus) != 0) {
+        os_printf("[topic][LOAN] 缓冲引用归零后未回收\n");
+        goto cleanup;
+    }
+
+    /* 非借出缓冲不能retain */
+    test_event_data_t plain = {0};
+    if (topic_loan_retain(&bus, &plain) == 0) {
+        os_printf("[topic][LOAN] 非借出缓冲retain未被拒绝\n");
+        goto cleanup;
+    }
+    if (topic_publish_loaned(&bus, TEST_EVENT_ID_LOAN, &plain, sizeof(plain)) == 0 || ctx.count != 1) {
+        os_printf("[topic][LOAN] 非借出缓冲发布未被拒绝\n");
+        goto cleanup;
+    }
+
+    os_printf("[topic][LOAN] 借出缓冲零拷贝发布测试: 通过\n");
+    ret = 0;
+
+cleanup:
+    if (ctx.held) topic_loan_release(&bus, ctx.held);
+    topic_bus_deinit(&bus);
+#if TOPIC_BUS_ENABLE_ROUTER
+    topic_router_deinit(&router);
+#endif
+    return ret;
+}
+
+/*
+ * @brief 借出缓冲发布与obj_dict_set+topic_publish_event的开销对比
+ * @return 0成功，-1失败
+ */
+static int test_performance_loan_publish(void) {
+    os_printf("\n[topic][PERF] 大负载发布开销对比（obj_dict拷贝 vs 借出缓冲）\n");
+
+    static const size_t payload_sizes[] = { 4096, 16384 };
+    uint8_t* src = (uint8_t*)os_malloc(16384);
+    if (!src) return -1;
+    memset(src, 0x5A, 16384);
+
+    int ret = 0;
+    for (size_t si = 0; si < sizeof(payload_sizes) / sizeof(payload_sizes[0]) && ret == 0; ++si) {
+        size_t size = payload_sizes[si];
+
+        obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+        obj_dict_t dict;
+        obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+        topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+        topic_bus_t bus;
+        topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+        if (topic_bus_loan_pool_init(&bus, size, PERF_TEST_LOAN_BLOCKS) != 0) {
+            topic_bus_deinit(&bus);
+            ret = -1;
+            break;
+        }
+
+        obj_dict_key_t events[] = {TEST_EVENT_ID_LOAN};
+        topic_rule_t rule = {
+            .type = TOPIC_RULE_OR,
+            .events = events,
+            .event_count = 1,
+        };
+        topic_rule_create(&bus, TEST_TOPIC_ID_LOAN, &rule);
+        topic_subscribe(&bus, TEST_TOPIC_ID_LOAN, test_callback, NULL);
+
+        /* 拷贝路径：生产者先写本地缓冲，再拷入对象字典后发布 */
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_LOAN_LOOPS; ++i) {
+            src[0] = (uint8_t)i;
+            obj_dict_set(&dict, TEST_EVENT_ID_LOAN, src, size, 0);
+            topic_publish_event(&bus, TEST_EVENT_ID_LOAN);
+        }
+        uint64_t copy_us = os_monotonic_time_get_microsecond() - start;
+
+        /* 零拷贝路径：生产者直接写入借出缓冲 */
+        atomic_store_explicit(&callback_count, 0, memory_order_release);
+        start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_LOAN_LOOPS; ++i) {
+            uint8_t* buf = (uint8_t*)topic_loan(&bus, size);
+            if (!buf) {
+                ret = -1;
+                break;
+            }
+            buf[0] = (uint8_t)i;
+            topic_publish_loaned(&bus, TEST_EVENT_ID_LOAN, buf, size);
+        }
+        uint64_t loan_us = os_monotonic_time_get_microsecond() - start;
+        uint32_t callbacks = atomic_load_explicit(&callback_count, memory_order_acquire);
+
+        double copy_avg = (double)copy_us / PERF_TEST_LOAN_LOOPS;
+        double loan_avg = (double)loan_us / PERF_TEST_LOAN_LOOPS;
+        os_printf("[topic][PERF] payload=%-5zu 拷贝发布: %.3f us/publish, 借出发布: %.3f us/publish, 加速比: %.2fx\n",
+                  size, copy_avg, loan_avg, (loan_avg > 0.0) ? (copy_avg / loan_avg) : 0.0);
+
+        if (ret == 0 && (callbacks != PERF_TEST_LOAN_LOOPS || loan_pool_used(&bus) != 0)) {
+            os_printf("[topic][PERF] 借出发布回调或缓冲回收异常 回调数=%u\n", callbacks);
+            ret = -1;
+        }
+
+        topic_bus_deinit(&bus);
+    }
+
+    os_free(src);
+    return ret;
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
+/* ---------------- 异步订阅执行器测试 ---------------- */
+
+/* 慢订阅者记录 */
+typedef struct {
+    atomic_uint count;
+    atomic_uint out_of_order;
+    uint32_t last_counter;
+    uint32_t sleep_ms;
+} exec_slow_ctx_t;
+
+static void exec_slow_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    exec_slow_ctx_t* ctx = (exec_slow_ctx_t*)user;
+    if (data && data_len == sizeof(test_event_data_t)) {
+        uint32_t counter = ((const test_event_data_t*)data)->counter;
+        if (atomic_load_explicit(&ctx->count, memory_order_relaxed) > 0 && counter <= ctx->last_counter) {
+            atomic_fetch_add_explicit(&ctx->out_of_order, 1, memory_order_relaxed);
+        }
+        ctx->last_counter = counter;
+    }
+    os_thread_sleep_ms(ctx->sleep_ms);
+    atomic_fetch_add_explicit(&ctx->count, 1, memory_order_release);
+}
+
+/*
+ * @brief 等待异步订阅者处理完expected个事件（投递或丢弃）
+ * @return 0成功，-1超时
+ */
+static int exec_wait_idle(topic_bus_t* bus, uint16_t topic_id, exec_slow_ctx_t* ctx, uint64_t expected,
+                          topic_async_stats_t* stats) {
+    for (uint32_t waited = 0; waited < PERF_TEST_EXEC_WAIT_MS; ++waited) {
+        if (topic_get_async_stats(bus, topic_id, exec_slow_callback, ctx, stats) != 0) return -1;
+        if (stats->delivered + stats->dropped >= expected) {
+            return 0;
+        }
+        os_thread_sleep_ms(1);
+    }
+    return -1;
+}
+
+/*
+ * @brief 初始化执行器测试用的总线：慢Topic与丢弃Topic各一个OR规则
+ */
+static void exec_test_setup(topic_bus_t* bus, topic_entry_t* topic_entries, obj_dict_t* dict,
+                            obj_dict_entry_t* dict_entries, topic_executor_t* exec) {
+    obj_dict_init(dict, dict_entries, PERF_TEST_EVENT_COUNT);
+    topic_bus_init(bus, topic_entries, PERF_TEST_MAX_TOPICS, dict);
+    topic_bus_set_executor(bus, exec);
+
+    obj_dict_key_t slow_events[] = {TEST_EVENT_ID_EXEC_SLOW};
+    obj_dict_key_t drop_events[] = {TEST_EVENT_ID_EXEC_DROP};
+    topic_rule_t slow_rule = { .type = TOPIC_RULE_OR, .events = slow_events, .event_count = 1 };
+    topic_rule_t drop_rule = { .type = TOPIC_RULE_OR, .events = drop_events, .event_count = 1 };
+    topic_rule_create(bus, TEST_TOPIC_ID_EXEC_SLOW, &slow_rule);
+    topic_rule_create(bus, TEST_TOPIC_ID_EXEC_DROP, &drop_rule);
+}
+
+/*
+ * @brief 测试异步订阅：慢订阅者不阻塞发布者与同步订阅者，Topic内保序，DROP/BLOCK策略与取消订阅
+ * @return 0成功，-1失败
+ */
+static int test_executor_async(void) {
+    os_printf("\n[topic][EXEC] 异步订阅执行器测试\n");
+
+    topic_executor_t exec;
+    if (topic_executor_init(&exec, 2) != 0) {
+        os_printf("[topic][EXEC] 执行器初始化失败\n");
+        return -1;
+    }
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    exec_test_setup(&bus, topic_entries, &dict, dict_entries, &exec);
+
+    exec_slow_ctx_t slow = { .sleep_ms = PERF_TEST_EXEC_SLOW_MS };
+    exec_slow_ctx_t drop = { .sleep_ms = 5 };
+    atomic_init(&slow.count, 0);
+    atomic_init(&slow.out_of_order, 0);
+    atomic_init(&drop.count, 0);
+    atomic_init(&drop.out_of_order, 0);
+
+    /* 慢订阅者通过Topic默认选项异步化（BLOCK），同Topic再挂一个同步订阅者 */
+    topic_sub_options_t block_opts = { .async = 1, .policy = TOPIC_SUB_POLICY_BLOCK, .queue_depth = 64 };
+    topic_sub_options_t drop_opts = { .async = 1, .policy = TOPIC_SUB_POLICY_DROP, .queue_depth = 4 };
+    topic_sub_options_t sync_opts = { .async = 0 };
+    topic_set_sub_defaults(&bus, TEST_TOPIC_ID_EXEC_SLOW, &block_opts);
+    int ret = -1;
+    if (topic_subscribe(&bus, TEST_TOPIC_ID_EXEC_SLOW, exec_slow_callback, &slow) != 0 ||
+        topic_subscribe_ex(&bus, TEST_TOPIC_ID_EXEC_SLOW, test_callback, NULL, &sync_opts) != 0 ||
+        topic_subscribe_ex(&bus, TEST_TOPIC_ID_EXEC_DROP, exec_slow_callback, &drop, &drop_opts) != 0) {
+        os_printf("[topic][EXEC] 订阅失败\n");
+        goto cleanup;
+    }
+
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (uint32_t i = 1; i <= PERF_TEST_EXEC_EVENTS; ++i) {
+        event_data.counter = i;
+        obj_dict_set(&dict, TEST_EVENT_ID_EXEC_SLOW, &event_data, sizeof(event_data), 0);
+        topic_publish_event(&bus, TEST_EVENT_ID_EXEC_SLOW);
+        obj_dict_set(&dict, TEST_EVENT_ID_EXEC_DROP, &event_data, sizeof(event_data), 0);
+        topic_publish_event(&bus, TEST_EVENT_ID_EXEC_DROP);
+    }
+    uint64_t publish_us = os_monotonic_time_get_microsecond() - start;
+    unsigned sync_count = atomic_load_explicit(&callback_count, memory_order_acquire);
+
+    topic_async_stats_t slow_stats, drop_stats;
+    if (exec_wait_idle(&bus, TEST_TOPIC_ID_EXEC_SLOW, &slow, PERF_TEST_EXEC_EVENTS, &slow_stats) != 0 ||
+        exec_wait_idle(&bus, TEST_TOPIC_ID_EXEC_DROP, &drop, PERF_TEST_EXEC_EVENTS, &drop_stats) != 0) {
+        os_printf("[topic][EXEC] 等待异步投递超时\n");
+        goto cleanup;
+    }
+    uint64_t total_us = os_monotonic_time_get_microsecond() - start;
+
+    os_printf("[topic][EXEC] 发布%d次耗时=%llu us, 全部投递耗时=%llu us, 同步回调=%u\n",
+              PERF_TEST_EXEC_EVENTS, (unsigned long long)publish_us, (unsigned long long)total_us, sync_count);
+    os_printf("[topic][EXEC] BLOCK: 投递=%llu 丢弃=%llu 乱序=%u; DROP: 投递=%llu 丢弃=%llu\n",
+              (unsigned long long)slow_stats.delivered, (unsigned long long)slow_stats.dropped,
+              atomic_load_explicit(&slow.out_of_order, memory_order_relaxed),
+              (unsigned long long)drop_stats.delivered, (unsigned long long)drop_stats.dropped);
+
+    /* 同步订阅者在发布返回前已全部回调，发布者不等待慢订阅者 */
+    if (sync_count != PERF_TEST_EXEC_EVENTS || publish_us >= total_us) {
+        os_printf("[topic][EXEC] 同步订阅者被慢订阅者阻塞\n");
+        goto cleanup;
+    }
+    if (slow_stats.delivered != PERF_TEST_EXEC_EVENTS || slow_stats.dropped != 0 ||
+        atomic_load_explicit(&slow.out_of_order, memory_order_relaxed) != 0) {
+        os_printf("[topic][EXEC] BLOCK策略丢失事件或顺序错误\n");
+        goto cleanup;
+    }
+    if (drop_stats.delivered + drop_stats.dropped != PERF_TEST_EXEC_EVENTS || drop_stats.dropped == 0) {
+        os_printf("[topic][EXEC] DROP策略计数错误\n");
+        goto cleanup;
+    }
+
+    /* 取消订阅后不再回调 */
+    topic_unsubscribe(&bus, TEST_TOPIC_ID_EXEC_SLOW, exec_slow_callback, &slow);
+    unsigned before = atomic_load_explicit(&slow.count, memory_order_acquire);
+    topic_publish_event(&bus, TEST_EVENT_ID_EXEC_SLOW);
+    os_thread_sleep_ms(10);
+    if (atomic_load_explicit(&slow.count, memory_order_acquire) != before) {
+        os_printf("[topic][EXEC] 取消订阅后仍有异步回调\n");
+        goto cleanup;
+    }
+
+    ret = 0;
+    os_printf("[topic][EXEC] 异步订阅执行器测试: 通过\n");
+
+cleanup:
+    /* 先销毁总线（退役异步订阅者），再停止执行器 */
+    topic_bus_deinit(&bus);
+    topic_executor_deinit(&exec);
+    return ret;
+}
+
+/*
+ * @brief 对比慢订阅者同步/异步回调时的发布开销
+ * @return 0成功，-1失败
+ */
+static int test_performance_executor(void) {
+    os_printf("\n[topic][PERF] 慢订阅者发布开销对比测试（同步 vs 异步）\n");
+
+    topic_executor_t exec;
+    if (topic_executor_init(&exec, 1) != 0) return -1;
+
+    int ret = 0;
+    for (int async = 0; async <= 1 && ret == 0; ++async) {
+        obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+        obj_dict_t dict;
+        topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+        topic_bus_t bus;
+        exec_test_setup(&bus, topic_entries, &dict, dict_entries, &exec);
+
+        exec_slow_ctx_t slow = { .sleep_ms = PERF_TEST_EXEC_SLOW_MS };
+        atomic_init(&slow.count, 0);
+        atomic_init(&slow.out_of_order, 0);
+        topic_sub_options_t opts = { .async = (uint8_t)async, .policy = TOPIC_SUB_POLICY_BLOCK,
+                                     .queue_depth = 64 };
+        topic_subscribe_ex(&bus, TEST_TOPIC_ID_EXEC_SLOW, exec_slow_callback, &slow, &opts);
+
+        test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (uint32_t i = 1; i <= PERF_TEST_EXEC_EVENTS; ++i) {
+            event_data.counter = i;
+            obj_dict_set(&dict, TEST_EVENT_ID_EXEC_SLOW, &event_data, sizeof(event_data), 0);
+            topic_publish_event(&bus, TEST_EVENT_ID_EXEC_SLOW);
+        }
+        uint64_t publish_us = os_monotonic_time_get_microsecond() - start;
+
+        if (async) {
+            topic_async_stats_t stats;
+            if (exec_wait_idle(&bus, TEST_TOPIC_ID_EXEC_SLOW, &slow, PERF_TEST_EXEC_EVENTS, &stats) != 0) ret = -1;
+        }
+        os_printf("[topic][PERF] %s回调: %.3f us/publish (订阅者耗时约%d ms)\n",
+                  async ? "异步" : "同步", (double)publish_us / PERF_TEST_EXEC_EVENTS, PERF_TEST_EXEC_SLOW_MS);
+        if (atomic_load_explicit(&slow.count, memory_order_acquire) != PERF_TEST_EXEC_EVENTS) {
+            os_printf("[topic][PERF] 回调数异常 %u\n", atomic_load_explicit(&slow.count, memory_order_acquire));
+            ret = -1;
+        }
+
+        topic_bus_deinit(&bus);
+    }
+
+    topic_executor_deinit(&exec);
+    return ret;
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+/* ---------------- 静态Topic表测试 ---------------- */
+
+/* 按topic_id记录静态订阅者回调次数 */
+static atomic_uint static_table_hits[128];
+
+/* 静态表订阅者（由perf_test_topic_table.c引用，不能为static） */
+void perf_test_static_table_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)data;
+    (void)data_len;
+    (void)user;
+    atomic_fetch_add_explicit(&static_table_hits[topic_id & 127U], 1, memory_order_relaxed);
+}
+
+static void static_table_hits_reset(void) {
+    for (size_t i = 0; i < sizeof(static_table_hits) / sizeof(static_table_hits[0]); ++i) {
+        atomic_store_explicit(&static_table_hits[i], 0, memory_order_relaxed);
+    }
+}
+
+static unsigned static_table_hit(uint16_t topic_id) {
+    return atomic_load_explicit(&static_table_hits[topic_id & 127U], memory_order_relaxed);
+}
+
+/*
+ * @brief 测试静态Topic表：OR/AND/MANUAL规则、共享事件、规则内重复事件、动态订阅与重复初始化
+ * @return 0成功，-1失败
+ */
+static int test_static_table(void) {
+    os_printf("\n[topic][STATIC] 静态Topic表测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_key_t keys[] = {TEST_EVENT_ID_STATIC_OR, TEST_EVENT_ID_STATIC_SHARED,
+                             TEST_EVENT_ID_STATIC_AND_1, TEST_EVENT_ID_STATIC_AND_2};
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        obj_dict_set(&dict, keys[i], &event_data, sizeof(event_data), 0);
+    }
+
+    topic_bus_t bus;
+    for (int round = 0; round < 2; ++round) {
+        /* 第二轮验证deinit后可再次使用同一静态表 */
+        if (topic_bus_init_static(&bus, &perf_test_topic_table, &dict) != 0) {
+            os_printf("[topic][STATIC] 初始化失败\n");
+            return -1;
+        }
+        static_table_hits_reset();
+        atomic_store_explicit(&callback_count, 0, memory_order_release);
+
+        int ok = 1;
+        topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = keys, .event_count = 1 };
+        ok &= (topic_rule_create(&bus, 200, &rule) != 0);  /* Topic集合固定 */
+        ok &= (topic_subscribe(&bus, TEST_TOPIC_ID_STATIC_NO_SUBS, test_callback, NULL) == 0);
+        ok &= (topic_subscribe(&bus, 200, test_callback, NULL) != 0);
+
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_OR);
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_SHARED);
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_AND_1);
+        ok &= (static_table_hit(TEST_TOPIC_ID_STATIC_AND) == 0);
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_AND_2);
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_UNKNOWN);
+        topic_publish_manual(&bus, TEST_TOPIC_ID_STATIC_MANUAL);
+
+        ok &= (static_table_hit(TEST_TOPIC_ID_STATIC_OR) == 2);
+        ok &= (static_table_hit(TEST_TOPIC_ID_STATIC_AND) == 1);
+        ok &= (static_table_hit(TEST_TOPIC_ID_STATIC_MANUAL) == 1);
+        ok &= (static_table_hit(TEST_TOPIC_ID_STATIC_DUP) == 1);
+        ok &= (atomic_load_explicit(&callback_count, memory_order_acquire) == 1);
+#if TOPIC_BUS_ENABLE_STATS
+        ok &= (topic_bus_get_event_count(&bus, TEST_TOPIC_ID_STATIC_NO_SUBS) == 1);
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+        /* 静态初始化不为直方图分配内存；开启后静态订阅者同样有直方图 */
+        topic_sub_hist_t sub_hist;
+        ok &= (topic_bus_get_sub_hist(&bus, TEST_TOPIC_ID_STATIC_OR, 0, &sub_hist) != 0);
+        ok &= (topic_bus_hist_enable(&bus, 1) == 0);
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_OR);
+        ok &= (topic_bus_get_sub_hist(&bus, TEST_TOPIC_ID_STATIC_OR, 0, &sub_hist) == 0 && sub_hist.is_static &&
+               sub_hist.hist.count == 1);
+#endif
+        topic_bus_deinit(&bus);
+
+        if (!ok) {
+            os_printf("[topic][STATIC] 第%d轮回调计数错误: OR=%u AND=%u MANUAL=%u DUP=%u 动态=%u\n", round + 1,
+                      static_table_hit(TEST_TOPIC_ID_STATIC_OR), static_table_hit(TEST_TOPIC_ID_STATIC_AND),
+                      static_table_hit(TEST_TOPIC_ID_STATIC_MANUAL), static_table_hit(TEST_TOPIC_ID_STATIC_DUP),
+                      atomic_load_explicit(&callback_count, memory_order_acquire));
+            return -1;
+        }
+    }
+
+    os_printf("[topic][STATIC] 静态Topic表测试: 通过\n");
+    return 0;
+}
+
+/*
+ * @brief 对比运行期创建规则与静态表的初始化及发布开销
+ * @return 0成功，-1失败
+ */
+static int test_performance_static_table(void) {
+    os_printf("\n[topic][PERF] 静态Topic表与运行期规则开销对比测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    obj_dict_set(&dict, TEST_EVENT_ID_STATIC_SHARED, &event_data, sizeof(event_data), 0);
+
+    /* 运行期：按相同声明逐条创建规则并订阅 */
+    const topic_static_table_t* table = &perf_test_topic_table;
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (size_t i = 0; i < table->topic_count; ++i) {
+        const topic_entry_t* decl = &table->topics[i];
+        topic_rule_create(&bus, decl->topic_id, &decl->rule);
+        for (size_t j = 0; j < decl->static_sub_count; ++j) {
+            topic_subscribe(&bus, decl->topic_id, decl->static_subs[j].callback, decl->static_subs[j].user_data);
+        }
+    }
+    uint64_t dyn_register_us = os_monotonic_time_get_microsecond() - start;
+
+    static_table_hits_reset();
+    start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_STATIC_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_SHARED);
+    }
+    uint64_t dyn_pub_us = os_monotonic_time_get_microsecond() - start;
+    unsigned dyn_hits = static_table_hit(TEST_TOPIC_ID_STATIC_OR) + static_table_hit(TEST_TOPIC_ID_STATIC_DUP);
+    topic_bus_deinit(&bus);
+
+    /* 静态表：无注册过程 */
+    topic_bus_init_static(&bus, table, &dict);
+
+    static_table_hits_reset();
+    start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_STATIC_LOOPS; ++i) {
+        topic_publish_event(&bus, TEST_EVENT_ID_STATIC_SHARED);
+    }
+    uint64_t static_pub_us = os_monotonic_time_get_microsecond() - start;
+    unsigned static_hits = static_table_hit(TEST_TOPIC_ID_STATIC_OR) + static_table_hit(TEST_TOPIC_ID_STATIC_DUP);
+    topic_bus_deinit(&bus);
+
+    os_printf("[topic][PERF] 运行期规则注册与订阅: %llu us（静态表无需注册，规则与索引不占用堆）\n",
+              (unsigned long long)dyn_register_us);
+    os_printf("[topic][PERF] 发布(%zu个Topic): 运行期=%.3f us/publish, 静态表=%.3f us/publish\n",
+              table->topic_count, (double)dyn_pub_us / PERF_TEST_STATIC_LOOPS,
+              (double)static_pub_us / PERF_TEST_STATIC_LOOPS);
+
+    if (dyn_hits != 2 * PERF_TEST_STATIC_LOOPS || static_hits != 2 * PERF_TEST_STATIC_LOOPS) {
+        os_printf("[topic][PERF] 回调数异常 运行期=%u 静态表=%u\n", dyn_hits, static_hits);
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+/* ---------------- Topic历史测试 ---------------- */
+
+#if TOPIC_BUS_ENABLE_HISTORY
+/* 历史回调记录 */
+typedef struct {
+    uint32_t values[16];
+    uint32_t count;
+} history_sink_t;
+
+static void history_sink_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    history_sink_t* sink = (history_sink_t*)user;
+    test_event_data_t value;
+    if (data_len != sizeof(value) || sink->count >= sizeof(sink->values) / sizeof(sink->values[0])) return;
+    memcpy(&value, data, sizeof(value));
+    sink->values[sink->count++] = value.value;
+}
+
+static void history_publish(topic_bus_t* bus, obj_dict_key_t key, uint32_t value) {
+    test_event_data_t data = { .value = value, .counter = value };
+    obj_dict_set(bus->obj_dict, key, &data, sizeof(data), 0);
+    topic_publish_event(bus, key);
+}
+
+/* 并发回放顺序检查：回放与实时投递合起来应连续递增（允许重复） */
+typedef struct {
+    uint32_t last;
+    uint32_t count;
+    uint32_t errors;
+} history_order_t;
+
+static void history_order_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    history_order_t* order = (history_order_t*)user;
+    test_event_data_t value;
+    if (data_len != sizeof(value)) {
+        order->errors++;
+        return;
+    }
+    memcpy(&value, data, sizeof(value));
+    if (order->count > 0 && (value.value < order->last || value.value > order->last + 1)) {
+        order->errors++;
+    }
+    order->last = value.value;
+    order->count++;
+}
+
+/* 并发回放：发布线程参数 */
+typedef struct {
+    topic_bus_t* bus;
+    uint32_t first;
+    uint32_t count;
+} history_publisher_t;
+
+static void* history_publisher_entry(void* param) {
+    history_publisher_t* p = (history_publisher_t*)param;
+    for (uint32_t i = 0; i < p->count; ++i) {
+        history_publish(p->bus, TEST_EVENT_ID_HISTORY, p->first + i);
+        os_thread_sleep_ms(1);
+    }
+    return NULL;
+}
+
+/*
+ * @brief Topic历史测试：保留最近N个、订阅回放、游标拉取、游标落后的覆盖计数
+ * @return 0成功，-1失败
+ */
+static int test_history(void) {
+    os_printf("\n[topic][HISTORY] Topic历史与订阅回放测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+
+    obj_dict_key_t keys[] = {TEST_EVENT_ID_HISTORY, TEST_EVENT_ID_HISTORY_NONE};
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &keys[0], .event_count = 1 };
+    topic_rule_create(&bus, TEST_TOPIC_ID_HISTORY, &rule);
+    rule.events = &keys[1];
+    topic_rule_create(&bus, TEST_TOPIC_ID_HISTORY_NONE, &rule);
+
+    int ok = 1;
+    ok &= (topic_bus_history_enable(&bus, TEST_TOPIC_ID_HISTORY, PERF_TEST_HISTORY_DEPTH,
+                                    sizeof(test_event_data_t)) == 0);
+    ok &= (topic_bus_history_enable(&bus, TEST_TOPIC_ID_HISTORY, 8, 8) != 0);  /* 不能重复开启 */
+    ok &= (topic_bus_history_enable(&bus, 999, 8, 8) != 0);
+
+    /* 发布6次，只保留最近4次 */
+    for (uint32_t i = 0; i < 6; ++i) {
+        history_publish(&bus, TEST_EVENT_ID_HISTORY, i);
+    }
+    history_publish(&bus, TEST_EVENT_ID_HISTORY_NONE, 100);
+
+    /* 游标拉取：从最旧的样本开始 */
+    uint64_t cursor = 0;
+    test_event_data_t value;
+    topic_history_sample_t sample;
+    uint32_t pulled = 0;
+    while (topic_history_read(&bus, TEST_TOPIC_ID_HISTORY, &cursor, &value, sizeof(value), &sample) == 1) {
+        ok &= (value.value == 2 + pulled && sample.seq == 3 + pulled && sample.len == sizeof(value) &&
+               sample.lost == 0 && sample.ts_us != 0);
+        pulled++;
+    }
+    ok &= (pulled == PERF_TEST_HISTORY_DEPTH && cursor == 7);
+    ok &= (topic_history_read(&bus, TEST_TOPIC_ID_HISTORY_NONE, &cursor, &value, sizeof(value), NULL) == -1);
+
+    /* 订阅回放：立即收到最近4次，之后的发布照常回调 */
+    history_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    topic_sub_options_t opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.replay = 1;
+    ok &= (topic_subscribe_ex(&bus, TEST_TOPIC_ID_HISTORY, history_sink_callback, &sink, &opts) == 0);
+    uint32_t replayed = sink.count;
+    history_publish(&bus, TEST_EVENT_ID_HISTORY, 6);
+    ok &= (replayed == PERF_TEST_HISTORY_DEPTH && sink.count == PERF_TEST_HISTORY_DEPTH + 1);
+    for (uint32_t i = 0; i < sink.count; ++i) {
+        ok &= (sink.values[i] == 2 + i);
+    }
+
+    /* 增量拉取新样本；落后的游标跳到最旧样本并报告被覆盖数 */
+    ok &= (topic_history_read(&bus, TEST_TOPIC_ID_HISTORY, &cursor, &value, sizeof(value), &sample) == 1 &&
+           value.value == 6 && sample.seq == 7);
+    ok &= (topic_history_read(&bus, TEST_TOPIC_ID_HISTORY, &cursor, &value, sizeof(value), NULL) == 0);
+    cursor = 1;
+    ok &= (topic_history_read(&bus, TEST_TOPIC_ID_HISTORY, &cursor, &value, sizeof(value), &sample) == 1 &&
+           sample.seq == 4 && sample.lost == 3 && value.value == 3);
+
+    /* 发布同时订阅回放：回放的样本先于实时投递，整体连续不乱序，最后收到最新值 */
+    history_order_t orders[8];
+    memset(orders, 0, sizeof(orders));
+    history_publisher_t publisher = { .bus = &bus, .first = 7, .count = 200 };
+    ThreadAttr_t attr = { .pName = "HistoryPub", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    OsThread_t* thread = os_thread_create(history_publisher_entry, &publisher, &attr);
+    ok &= (thread != NULL);
+    for (int i = 0; i < 8 && thread; ++i) {
+        os_thread_sleep_ms(20);
+        ok &= (topic_subscribe_ex(&bus, TEST_TOPIC_ID_HISTORY, history_order_callback, &orders[i], &opts) == 0);
+    }
+    if (thread) {
+        os_thread_join(thread);
+        os_thread_destroy(thread);
+    }
+    uint32_t order_errors = 0;
+    for (int i = 0; i < 8 && thread; ++i) {
+        order_errors += orders[i].errors;
+        ok &= (orders[i].count >= PERF_TEST_HISTORY_DEPTH && orders[i].last == publisher.first + publisher.count - 1);
+    }
+    ok &= (order_errors == 0);
+
+    topic_bus_deinit(&bus);
+    if (!ok) {
+        os_printf("[topic][HISTORY] 失败: pulled=%u replayed=%u callbacks=%u order_errors=%u\n", pulled, replayed,
+                  sink.count, order_errors);
+        return -1;
+    }
+    os_printf("[topic][HISTORY] 保留最近%d个、订阅回放、并发回放顺序、游标拉取与覆盖计数正确\n", PERF_TEST_HISTORY_DEPTH);
+    return 0;
+}
+
+/*
+ * @brief Topic历史开销：同一Topic开启历史前后的发布耗时
+ * @return 0成功，-1失败
+ */
+static int test_performance_history(void) {
+    os_printf("\n[topic][PERF] Topic历史记录开销测试（深度%d，%uB负载）\n", PERF_TEST_HISTORY_DEPTH,
+              (unsigned)sizeof(test_event_data_t));
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+    obj_dict_key_t key = TEST_EVENT_ID_HISTORY;
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &key, .event_count = 1 };
+    topic_rule_create(&bus, TEST_TOPIC_ID_HISTORY, &rule);
+    topic_subscribe(&bus, TEST_TOPIC_ID_HISTORY, test_callback, NULL);
+    test_event_data_t data = { .value = 1, .counter = 0 };
+    obj_dict_set(&dict, key, &data, sizeof(data), 0);
+
+    uint64_t cost_us[2] = {0};
+    for (int with_history = 0; with_history < 2; ++with_history) {
+        if (with_history) {
+            topic_bus_history_enable(&bus, TEST_TOPIC_ID_HISTORY, PERF_TEST_HISTORY_DEPTH, sizeof(data));
+        }
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_HISTORY_LOOPS; ++i) {
+            topic_publish_event(&bus, key);
+        }
+        cost_us[with_history] = os_monotonic_time_get_microsecond() - start;
+    }
+
+    uint64_t cursor = 0;
+    topic_history_sample_t sample;
+    uint32_t pulled = 0;
+    uint64_t start = os_monotonic_time_get_microsecond();
+    while (topic_history_read(&bus, TEST_TOPIC_ID_HISTORY, &cursor, &data, sizeof(data), &sample) == 1) {
+        pulled++;
+    }
+    uint64_t read_us = os_monotonic_time_get_microsecond() - start;
+    topic_bus_deinit(&bus);
+
+    os_printf("[topic][PERF] 发布: 无历史=%.3f us/publish, 有历史=%.3f us/publish; 拉取%u个样本=%llu us\n",
+              (double)cost_us[0] / PERF_TEST_HISTORY_LOOPS, (double)cost_us[1] / PERF_TEST_HISTORY_LOOPS,
+              pulled, (unsigned long long)read_us);
+    if (pulled != PERF_TEST_HISTORY_DEPTH || sample.seq != PERF_TEST_HISTORY_LOOPS) {
+        os_printf("[topic][PERF] 历史样本数异常\n");
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+/* ---------------- 范围订阅测试 ---------------- */
+
+/* 范围订阅者命中记录：[0, BLOCK)为A段，[BLOCK, 2*BLOCK)为B段 */
+typedef struct {
+    uint32_t hits[PERF_TEST_RANGE_BLOCK * 2];
+    uint32_t outside;                   /* 不在A/B段内的回调数 */
+} range_sink_t;
+
+static void range_sink_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)data;
+    (void)data_len;
+    range_sink_t* sink = (range_sink_t*)user;
+    if (topic_id >= TEST_TOPIC_ID_RANGE_A && topic_id < TEST_TOPIC_ID_RANGE_A + PERF_TEST_RANGE_BLOCK) {
+        sink->hits[topic_id - TEST_TOPIC_ID_RANGE_A]++;
+    } else if (topic_id >= TEST_TOPIC_ID_RANGE_B && topic_id < TEST_TOPIC_ID_RANGE_B + PERF_TEST_RANGE_BLOCK) {
+        sink->hits[PERF_TEST_RANGE_BLOCK + topic_id - TEST_TOPIC_ID_RANGE_B]++;
+    } else {
+        sink->outside++;
+    }
+}
+
+/*
+ * @brief 发布A/B两段的全部Topic各一次
+ */
+static void range_publish_all(topic_bus_t* bus) {
+    test_event_data_t data = { .value = 1, .counter = 0 };
+    for (int i = 0; i < PERF_TEST_RANGE_BLOCK * 2; ++i) {
+        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_RANGE_BASE + i);
+        obj_dict_set(bus->obj_dict, key, &data, sizeof(data), 0);
+        topic_publish_event(bus, key);
+    }
+}
+
+/*
+ * @brief 范围订阅测试：范围/前缀掩码/重叠区间的命中、订阅后创建的Topic、取消订阅与参数校验
+ * @return 0成功，-1失败
+ */
+static int test_range_subscribe(void) {
+    os_printf("\n[topic][RANGE] 范围与前缀掩码订阅测试\n");
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+    size_t max_topics = PERF_TEST_RANGE_BLOCK * 2;
+    topic_entry_t* topic_entries = (topic_entry_t*)os_malloc(sizeof(topic_entry_t) * max_topics);
+    if (!topic_entries) return -1;
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, max_topics, &dict);
+
+    /* 先订阅再创建Topic：范围订阅覆盖之后创建的Topic */
+    static range_sink_t sinks[3];
+    memset(sinks, 0, sizeof(sinks));
+    int ok = 1;
+    ok &= (topic_subscribe_range(&bus, TEST_TOPIC_ID_RANGE_A, TEST_TOPIC_ID_RANGE_A + 15,
+                                 range_sink_callback, &sinks[0]) == 0);
+    ok &= (topic_subscribe_mask(&bus, TEST_TOPIC_ID_RANGE_B + 5, 0xFFF0, range_sink_callback, &sinks[1]) == 0);
+    ok &= (topic_subscribe_range(&bus, TEST_TOPIC_ID_RANGE_A + 8, TEST_TOPIC_ID_RANGE_B + 8,
+                                 range_sink_callback, &sinks[2]) == 0);
+
+    for (int i = 0; i < PERF_TEST_RANGE_BLOCK * 2; ++i) {
+        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_RANGE_BASE + i);
+        topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &key, .event_count = 1 };
+        uint16_t topic_id = (i < PERF_TEST_RANGE_BLOCK) ? (uint16_t)(TEST_TOPIC_ID_RANGE_A + i)
+                                                        : (uint16_t)(TEST_TOPIC_ID_RANGE_B + i - PERF_TEST_RANGE_BLOCK);
+        ok &= (topic_rule_create(&bus, topic_id, &rule) == 0);
+    }
+    /* 普通订阅者与范围订阅者共存 */
+    ok &= (topic_subscribe(&bus, TEST_TOPIC_ID_RANGE_A + 9, test_callback, NULL) == 0);
+
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    range_publish_all(&bus);
+    ok &= (atomic_load_explicit(&callback_count, memory_order_acquire) == 1);
+    for (int i = 0; i < PERF_TEST_RANGE_BLOCK; ++i) {
+        ok &= (sinks[0].hits[i] == (i < 16 ? 1U : 0U) && sinks[0].hits[PERF_TEST_RANGE_BLOCK + i] == 0);
+        ok &= (sinks[1].hits[i] == 0 && sinks[1].hits[PERF_TEST_RANGE_BLOCK + i] == (i < 16 ? 1U : 0U));
+        ok &= (sinks[2].hits[i] == (i >= 8 ? 1U : 0U) &&
+               sinks[2].hits[PERF_TEST_RANGE_BLOCK + i] == (i <= 8 ? 1U : 0U));
+    }
+    for (int k = 0; k < 3; ++k) {
+        ok &= (sinks[k].outside == 0);
+    }
+
+    /* 参数校验：非前缀掩码、first > last、取消不存在的订阅 */
+    ok &= (topic_subscribe_mask(&bus, TEST_TOPIC_ID_RANGE_A, 0xF0F0, range_sink_callback, &sinks[0]) == -1);
+    ok &= (topic_subscribe_range(&bus, TEST_TOPIC_ID_RANGE_B, TEST_TOPIC_ID_RANGE_A,
+                                 range_sink_callback, &sinks[0]) == -1);
+    ok &= (topic_unsubscribe_range(&bus, TEST_TOPIC_ID_RANGE_A, TEST_TOPIC_ID_RANGE_A + 15,
+                                   range_sink_callback, &sinks[1]) == -1);
+
+    /* 取消后不再回调 */
+    ok &= (topic_unsubscribe_range(&bus, TEST_TOPIC_ID_RANGE_A, TEST_TOPIC_ID_RANGE_A + 15,
+                                   range_sink_callback, &sinks[0]) == 0);
+    ok &= (topic_unsubscribe_mask(&bus, TEST_TOPIC_ID_RANGE_B, 0xFFF0, range_sink_callback, &sinks[1]) == 0);
+    ok &= (topic_unsubscribe_range(&bus, TEST_TOPIC_ID_RANGE_A + 8, TEST_TOPIC_ID_RANGE_B + 8,
+                                   range_sink_callback, &sinks[2]) == 0);
+    memset(sinks, 0, sizeof(sinks));
+    range_publish_all(&bus);
+    uint32_t after = 0;
+    for (int k = 0; k < 3; ++k) {
+        for (int i = 0; i < PERF_TEST_RANGE_BLOCK * 2; ++i) {
+            after += sinks[k].hits[i];
+        }
+        after += sinks[k].outside;
+    }
+    ok &= (after == 0);
+
+    topic_bus_deinit(&bus);
+    os_free(topic_entries);
+    if (!ok) {
+        os_printf("[topic][RANGE] 失败: 取消订阅后回调数=%u\n", after);
+        return -1;
+    }
+    os_printf("[topic][RANGE] 范围、前缀掩码与重叠区间命中正确，取消订阅与参数校验正确\n");
+    return 0;
+}
+
+/*
+ * @brief 发布热Topic并返回单次发布耗时
+ */
+static double range_publish_run(topic_bus_t* bus, obj_dict_key_t key) {
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_RANGE_LOOPS; ++i) {
+        topic_publish_event(bus, key);
+    }
+    return (double)(os_monotonic_time_get_microsecond() - start) / PERF_TEST_RANGE_LOOPS;
+}
+
+/*
+ * @brief 范围订阅性能：逐Topic订阅与一次范围订阅的开销对比，以及范围订阅数增长时的分发开销
+ * @return 0成功，-1失败
+ */
+static int test_performance_range(void) {
+    os_printf("\n[topic][PERF] 范围订阅测试（%d个Topic，范围订阅数至%d）\n",
+              PERF_TEST_RANGE_TOPICS, PERF_TEST_RANGE_MAX_SUBS);
+
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+    topic_entry_t* topic_entries = (topic_entry_t*)os_malloc(sizeof(topic_entry_t) * PERF_TEST_RANGE_TOPICS);
+    if (!topic_entries) return -1;
+    topic_bus_t bus;
+    topic_bus_init(&bus, topic_entries, PERF_TEST_RANGE_TOPICS, &dict);
+    for (int i = 0; i < PERF_TEST_RANGE_TOPICS; ++i) {
+        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_RANGE_PERF_BASE + i);
+        topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &key, .event_count = 1 };
+        topic_rule_create(&bus, (uint16_t)(TEST_TOPIC_ID_RANGE_A + i), &rule);
+    }
+    uint16_t hot_topic = (uint16_t)(TEST_TOPIC_ID_RANGE_A + PERF_TEST_RANGE_TOPICS / 2);
+    obj_dict_key_t hot_key = (obj_dict_key_t)(TEST_EVENT_ID_RANGE_PERF_BASE + PERF_TEST_RANGE_TOPICS / 2);
+    test_event_data_t data = { .value = 1, .counter = 0 };
+    obj_dict_set(&dict, hot_key, &data, sizeof(data), 0);
+    int ok = 1;
+
+    /* 逐Topic订阅全部Topic */
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_RANGE_TOPICS; ++i) {
+        ok &= (topic_subscribe(&bus, (uint16_t)(TEST_TOPIC_ID_RANGE_A + i), test_callback, NULL) == 0);
+    }
+    uint64_t per_topic_setup_us = os_monotonic_time_get_microsecond() - start;
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    double per_topic_us = range_publish_run(&bus, hot_key);
+    ok &= (atomic_load_explicit(&callback_count, memory_order_acquire) == PERF_TEST_RANGE_LOOPS);
+    for (int i = 0; i < PERF_TEST_RANGE_TOPICS; ++i) {
+        topic_unsubscribe(&bus, (uint16_t)(TEST_TOPIC_ID_RANGE_A + i), test_callback, NULL);
+    }
+
+    /* 一次范围订阅覆盖全部Topic */
+    start = os_monotonic_time_get_microsecond();
+    ok &= (topic_subscribe_range(&bus, TEST_TOPIC_ID_RANGE_A, (uint16_t)(TEST_TOPIC_ID_RANGE_A + PERF_TEST_RANGE_TOPICS - 1),
+                                 test_callback, NULL) == 0);
+    uint64_t range_setup_us = os_monotonic_time_get_microsecond() - start;
+    atomic_store_explicit(&callback_count, 0, memory_order_release);
+    double range_us = range_publish_run(&bus, hot_key);
+    ok &= (atomic_load_explicit(&callback_count, memory_order_acquire) == PERF_TEST_RANGE_LOOPS);
+    topic_unsubscribe_range(&bus, TEST_TOPIC_ID_RANGE_A, (uint16_t)(TEST_TOPIC_ID_RANGE_A + PERF_TEST_RANGE_TOPICS - 1),
+                            test_callback, NULL);
+
+    os_printf("[topic][PERF] 订阅%d个Topic: 逐个订阅=%llu us, 范围订阅=%llu us; 发布: %.3f / %.3f us/publish\n",
+              PERF_TEST_RANGE_TOPICS, (unsigned long long)per_topic_setup_us, (unsigned long long)range_setup_us,
+              per_topic_us, range_us);
+
+    /* 范围订阅数增长：只有一个区间覆盖热Topic，其余区间一半在其之下、一半在其之上 */
+    ok &= (topic_subscribe_range(&bus, hot_topic, hot_topic, test_callback, NULL) == 0);
+    static const size_t sub_counts[] = { 1, 16, 256, PERF_TEST_RANGE_MAX_SUBS };
+    size_t count = 1;
+    double first_us = 0.0;
+    double last_us = 0.0;
+    for (size_t ci = 0; ci < sizeof(sub_counts) / sizeof(sub_counts[0]); ++ci) {
+        for (; count < sub_counts[ci]; ++count) {
+            size_t k = count / 2;
+            uint16_t first = (count & 1U) ? (uint16_t)(k * 4) : (uint16_t)(0x8000 + k * 4);
+            ok &= (topic_subscribe_range(&bus, first, (uint16_t)(first + 2), test_callback, &bus) == 0);
+        }
+        atomic_store_explicit(&callback_count, 0, memory_order_release);
+        double avg_us = range_publish_run(&bus, hot_key);
+        ok &= (atomic_load_explicit(&callback_count, memory_order_acquire) == PERF_TEST_RANGE_LOOPS);
+        os_printf("[topic][PERF] 范围订阅数=%-5zu 发布: %.3f us/publish\n", count, avg_us);
+        if (ci == 0) first_us = avg_us;
+        last_us = avg_us;
+    }
+    os_printf("[topic][PERF] %d/1 范围订阅发布开销比: %.2fx\n", PERF_TEST_RANGE_MAX_SUBS,
+              (first_us > 0.0) ? (last_us / first_us) : 0.0);
+
+    topic_bus_deinit(&bus);
+    os_free(topic_entries);
+    if (!ok) {
+        os_printf("[topic][PERF] 范围订阅回调次数异常\n");
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_RECORD
+/* ---------------- 流量录制与回放测试 ---------------- */
+
+/* 录制/回放两侧的回调结果，回放后应与录制时一致 */
+typedef struct {
+    uint32_t hits[TEST_TOPIC_ID_RECORD_LOAN + 1];
+    uint64_t sum;                       /* 按Topic加权的负载值之和 */
+} record_sink_t;
+
+/* 录制测试总线 */
+typedef struct {
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    record_sink_t sink;
+} record_bench_t;
+
+static void record_sink_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    record_sink_t* sink = (record_sink_t*)user;
+    test_event_data_t value = { .value = 0, .counter = 0 };
+    if (data && data_len >= sizeof(value)) {
+        memcpy(&value, data, sizeof(value));
+    }
+    if (topic_id <= TEST_TOPIC_ID_RECORD_LOAN) {
+        sink->hits[topic_id]++;
+    }
+    sink->sum += (uint64_t)value.value * topic_id;
+}
+
+/*
+ * @brief 创建录制/回放两侧相同的Topic：OR、AND、MANUAL与借出缓冲发布
+ */
+static int record_bench_init(record_bench_t* b) {
+    memset(&b->sink, 0, sizeof(b->sink));
+    obj_dict_init(&b->dict, b->dict_entries, PERF_TEST_EVENT_COUNT);
+    if (topic_bus_init(&b->bus, b->topic_entries, PERF_TEST_MAX_TOPICS, &b->dict) != 0) return -1;
+
+    obj_dict_key_t or_keys[] = {TEST_EVENT_ID_RECORD_OR};
+    obj_dict_key_t and_keys[] = {TEST_EVENT_ID_RECORD_AND_1, TEST_EVENT_ID_RECORD_AND_2};
+    obj_dict_key_t loan_keys[] = {TEST_EVENT_ID_RECORD_LOAN};
+    topic_rule_t rule_or = { .type = TOPIC_RULE_OR, .events = or_keys, .event_count = 1 };
+    topic_rule_t rule_and = { .type = TOPIC_RULE_AND, .events = and_keys, .event_count = 2 };
+    topic_rule_t rule_manual = { .type = TOPIC_RULE_MANUAL, .events = or_keys, .event_count = 1 };
+    topic_rule_t rule_loan = { .type = TOPIC_RULE_OR, .events = loan_keys, .event_count = 1 };
+    int ok = 1;
+    ok &= (topic_rule_create(&b->bus, TEST_TOPIC_ID_RECORD_OR, &rule_or) == 0);
+    ok &= (topic_rule_create(&b->bus, TEST_TOPIC_ID_RECORD_AND, &rule_and) == 0);
+    ok &= (topic_rule_create(&b->bus, TEST_TOPIC_ID_RECORD_MANUAL, &rule_manual) == 0);
+    ok &= (topic_rule_create(&b->bus, TEST_TOPIC_ID_RECORD_LOAN, &rule_loan) == 0);
+    for (uint16_t id = TEST_TOPIC_ID_RECORD_OR; id <= TEST_TOPIC_ID_RECORD_LOAN; ++id) {
+        ok &= (topic_subscribe(&b->bus, id, record_sink_callback, &b->sink) == 0);
+    }
+#if TOPIC_BUS_ENABLE_LOAN
+    ok &= (topic_bus_loan_pool_init(&b->bus, sizeof(test_event_data_t), 8) == 0);
+#endif
+    return ok ? 0 : -1;
+}
+
+/*
+ * @brief 模拟一段生产流量：写入+发布、AND双事件、手动发布、借出缓冲发布与ISR发布
+ */
+static void record_workload(topic_bus_t* bus, uint32_t loops) {
+    for (uint32_t i = 0; i < loops; ++i) {
+        test_event_data_t data = { .value = i, .counter = i };
+        obj_dict_set(bus->obj_dict, TEST_EVENT_ID_RECORD_OR, &data, sizeof(data), 0);
+        topic_publish_event(bus, TEST_EVENT_ID_RECORD_OR);
+        if (i % 4 == 0) {
+            data.value = i * 3U;
+            obj_dict_set(bus->obj_dict, TEST_EVENT_ID_RECORD_AND_1, &data, sizeof(data), 0);
+            obj_dict_set(bus->obj_dict, TEST_EVENT_ID_RECORD_AND_2, &data, sizeof(data), 1);
+            topic_publish_event(bus, TEST_EVENT_ID_RECORD_AND_1);
+            topic_publish_event(bus, TEST_EVENT_ID_RECORD_AND_2);
+        }
+        if (i % 8 == 0) {
+            topic_publish_manual(bus, TEST_TOPIC_ID_RECORD_MANUAL);
+        }
+#if TOPIC_BUS_ENABLE_LOAN
+        if (i % 16 == 0) {
+            test_event_data_t* loan = (test_event_data_t*)topic_loan(bus, sizeof(*loan));
+            if (loan) {
+                loan->value = i * 7U;
+                loan->counter = i;
+                topic_publish_loaned(bus, TEST_EVENT_ID_RECORD_LOAN, loan, sizeof(*loan));
+            }
+        }
+#endif
+#if TOPIC_BUS_ENABLE_ISR
+        if (i % 5 == 0) {
+            topic_publish_isr(bus, TEST_EVENT_ID_RECORD_OR);
+            topic_bus_process_isr_queue(bus);
+        }
+#endif
+    }
+}
+
+/* 并发停止录制：写入+发布线程参数 */
+typedef struct {
+    topic_bus_t* bus;
+    atomic_int* stop;
+    uint64_t ops;
+} record_churn_t;
+
+static void* record_churn_entry(void* param) {
+    record_churn_t* p = (record_churn_t*)param;
+    test_event_data_t data = { .value = 0, .counter = 0 };
+    while (!atomic_load_explicit(p->stop, memory_order_relaxed)) {
+        data.value++;
+        obj_dict_set(p->bus->obj_dict, TEST_EVENT_ID_RECORD_OR, &data, sizeof(data), 0);
+        topic_publish_event(p->bus, TEST_EVENT_ID_RECORD_OR);
+        p->ops++;
+    }
+    return NULL;
+}
+
+/*
+ * @brief 录制与回放测试：回放后回调结果与录制时一致、定速回放耗时、空间不足计数与坏文件
+ * @return 0成功，-1失败
+ */
+static int test_record_replay(void) {
+    os_printf("\n[topic][RECORD] 流量录制与回放测试\n");
+
+    static record_bench_t src;
+    static record_bench_t dst;
+    int ok = (record_bench_init(&src) == 0 && record_bench_init(&dst) == 0);
+
+    /* 录制：回调结果与未录制时相同 */
+    topic_recorder_t rec;
+    ok &= (topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, PERF_TEST_RECORD_CAPACITY) == 0);
+    ok &= (topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, PERF_TEST_RECORD_CAPACITY) != 0);
+    record_workload(&src.bus, 1000);
+    topic_record_stats_t rstats;
+    topic_recorder_get_stats(&rec, &rstats);
+    ok &= (topic_recorder_stop(&rec) == 0);
+    ok &= (rstats.records > 1000 && rstats.dropped == 0);
+
+    /* 尽快回放到另一条总线：回调次数与负载完全一致 */
+    topic_replay_stats_t stats;
+    ok &= (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 0.0, &stats) == 0);
+    ok &= (stats.records == rstats.records && stats.errors == 0 && stats.sets + stats.publishes == stats.records);
+    ok &= (memcmp(&src.sink, &dst.sink, sizeof(src.sink)) == 0);
+    for (uint16_t id = TEST_TOPIC_ID_RECORD_OR; id <= TEST_TOPIC_ID_RECORD_MANUAL; ++id) {
+        ok &= (dst.sink.hits[id] > 0);
+    }
+#if TOPIC_BUS_ENABLE_LOAN
+    ok &= (dst.sink.hits[TEST_TOPIC_ID_RECORD_LOAN] > 0);
+#endif
+
+    /* 定速回放：按录制间隔施加，4倍速耗时约为四分之一 */
+    ok &= (topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, PERF_TEST_RECORD_CAPACITY) == 0);
+    for (int i = 0; i < 10; ++i) {
+        record_workload(&src.bus, 1);
+        os_thread_sleep_ms(2);
+    }
+    ok &= (topic_recorder_stop(&rec) == 0);
+    topic_replay_stats_t paced[2];
+    ok &= (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 1.0, &paced[0]) == 0);
+    ok &= (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 4.0, &paced[1]) == 0);
+    ok &= (paced[0].duration_us >= 18000 && paced[0].elapsed_us + 100 >= paced[0].duration_us);
+    ok &= (paced[1].elapsed_us + 100 >= paced[1].duration_us / 4 && paced[1].elapsed_us < paced[0].elapsed_us);
+
+    /* 空间不足：只记录放得下的部分 */
+    ok &= (topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, sizeof(topic_record_file_hdr_t) + 64) == 0);
+    record_workload(&src.bus, 10);
+    topic_recorder_get_stats(&rec, &rstats);
+    ok &= (topic_recorder_stop(&rec) == 0);
+    ok &= (rstats.records > 0 && rstats.dropped > 0 && rstats.bytes <= sizeof(topic_record_file_hdr_t) + 64);
+    ok &= (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 0.0, &stats) == 0 && stats.records == rstats.records);
+
+    /* 并发停止：写入+发布线程持续运行时反复开始/停止录制，停止返回后不再有追加 */
+    atomic_int stop;
+    atomic_init(&stop, 0);
+    record_churn_t churn[2];
+    OsThread_t* threads[2];
+    ThreadAttr_t attr = { .pName = "RecordChurn", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    int created = 0;
+    for (int i = 0; i < 2; ++i) {
+        churn[i].bus = &src.bus;
+        churn[i].stop = &stop;
+        churn[i].ops = 0;
+        threads[i] = os_thread_create(record_churn_entry, &churn[i], &attr);
+        if (!threads[i]) break;
+        created++;
+    }
+    ok &= (created == 2);
+    for (int cycle = 0; cycle < 20 && created == 2; ++cycle) {
+        ok &= (topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, PERF_TEST_RECORD_CAPACITY) == 0);
+        os_thread_sleep_ms(1);
+        ok &= (topic_recorder_stop(&rec) == 0);
+        topic_record_stats_t cstats;
+        topic_recorder_get_stats(&rec, &cstats);  /* 已停止：锁已销毁，统计为0 */
+        ok &= (cstats.records == 0);
+    }
+    atomic_store_explicit(&stop, 1, memory_order_relaxed);
+    for (int i = 0; i < created; ++i) {
+        os_thread_join(threads[i]);
+        os_thread_destroy(threads[i]);
+    }
+
+    /* 不是录制文件 */
+    os_file_remove(PERF_TEST_RECORD_FILE);
+    ok &= (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 0.0, &stats) == -1);
+
+    topic_bus_deinit(&src.bus);
+    topic_bus_deinit(&dst.bus);
+    if (!ok) {
+        os_printf("[topic][RECORD] 失败: records=%llu replayed=%llu errors=%llu paced=%llu/%llu us\n",
+                  (unsigned long long)rstats.records, (unsigned long long)stats.records,
+                  (unsigned long long)stats.errors, (unsigned long long)paced[0].elapsed_us,
+                  (unsigned long long)paced[0].duration_us);
+        return -1;
+    }
+    os_printf("[topic][RECORD] 回放结果与录制一致，定速/倍速回放、空间不足计数、并发停止与坏文件检查正确\n");
+    return 0;
+}
+
+/*
+ * @brief 录制与回放性能：录制开销、尽快回放的吞吐与单次发布耗时、定速回放的时间偏差
+ * @return 0成功，-1失败
+ */
+static int test_performance_record(void) {
+    os_printf("\n[topic][PERF] 流量录制与回放性能测试（%d次写入+发布）\n", PERF_TEST_RECORD_LOOPS);
+
+    static record_bench_t src;
+    static record_bench_t dst;
+    if (record_bench_init(&src) != 0 || record_bench_init(&dst) != 0) return -1;
+    test_event_data_t data = { .value = 1, .counter = 0 };
+
+    /* 录制开销：同一段写入+发布，未录制与录制时的单次耗时 */
+    uint64_t cost_us[2] = {0};
+    topic_recorder_t rec;
+    for (int recording = 0; recording < 2; ++recording) {
+        if (recording && topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, PERF_TEST_RECORD_CAPACITY) != 0) {
+            topic_bus_deinit(&src.bus);
+            topic_bus_deinit(&dst.bus);
+            return -1;
+        }
+        uint64_t start = os_monotonic_time_get_microsecond();
+        for (int i = 0; i < PERF_TEST_RECORD_LOOPS; ++i) {
+            data.value = (uint32_t)i;
+            obj_dict_set(&src.dict, TEST_EVENT_ID_RECORD_OR, &data, sizeof(data), 0);
+            topic_publish_event(&src.bus, TEST_EVENT_ID_RECORD_OR);
+        }
+        cost_us[recording] = os_monotonic_time_get_microsecond() - start;
+    }
+    topic_record_stats_t rstats;
+    topic_recorder_get_stats(&rec, &rstats);
+    topic_recorder_stop(&rec);
+    os_printf("[topic][PERF] 写入+发布: 未录制=%.3f us/op, 录制=%.3f us/op; %llu条记录共%llu字节\n",
+              (double)cost_us[0] / PERF_TEST_RECORD_LOOPS, (double)cost_us[1] / PERF_TEST_RECORD_LOOPS,
+              (unsigned long long)rstats.records, (unsigned long long)rstats.bytes);
+
+    /* 尽快回放 */
+    static topic_replay_stats_t stats;
+    int ok = (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 0.0, &stats) == 0);
+    ok &= (stats.records == rstats.records && stats.errors == 0 &&
+           dst.sink.hits[TEST_TOPIC_ID_RECORD_OR] == PERF_TEST_RECORD_LOOPS);
+    os_printf("[topic][PERF] 尽快回放: %llu条/%llu us = %.2f M records/s, 发布平均%.3f us, 最大%llu us\n",
+              (unsigned long long)stats.records, (unsigned long long)stats.elapsed_us,
+              stats.records_per_sec / 1e6, stats.publish_avg_us, (unsigned long long)stats.publish_max_us);
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_print("replay.publish", &stats.publish_hist);
+#endif
+
+    /* 定速回放：按固定周期录制，原速回放时施加时刻与计划时刻的偏差 */
+    ok &= (topic_recorder_start(&rec, &src.bus, PERF_TEST_RECORD_FILE, PERF_TEST_RECORD_CAPACITY) == 0);
+    uint64_t next_us = os_monotonic_time_get_microsecond();
+    for (int i = 0; i < PERF_TEST_RECORD_PACED; ++i) {
+        next_us += PERF_TEST_RECORD_PERIOD_US;
+        while (os_monotonic_time_get_microsecond() < next_us) {
+        }
+        obj_dict_set(&src.dict, TEST_EVENT_ID_RECORD_OR, &data, sizeof(data), 0);
+        topic_publish_event(&src.bus, TEST_EVENT_ID_RECORD_OR);
+    }
+    topic_recorder_stop(&rec);
+    ok &= (topic_replay(&dst.bus, PERF_TEST_RECORD_FILE, 1.0, &stats) == 0);
+    os_printf("[topic][PERF] 原速回放: 录制%llu us, 回放%llu us, 施加时刻偏差 平均%.1f us, 最大%llu us\n",
+              (unsigned long long)stats.duration_us, (unsigned long long)stats.elapsed_us, stats.lag_avg_us,
+              (unsigned long long)stats.lag_max_us);
+
+    os_file_remove(PERF_TEST_RECORD_FILE);
+    topic_bus_deinit(&src.bus);
+    topic_bus_deinit(&dst.bus);
+    if (!ok) {
+        os_printf("[topic][PERF] 回放记录数异常\n");
+        return -1;
+    }
+    return 0;
+}
+#endif
+
+/* ---------------- 共享内存多进程总线测试 ---------------- */
+
+#if TOPIC_BUS_ENABLE_SHM
+/* 本进程收到的共享内存回调 */
+typedef struct {
+    topic_shm_t* shm;                   /* 所在句柄 */
+    uint32_t or_hits;
+    uint32_t and_hits;
+    uint32_t last_value;
+    uint32_t outside;                   /* 数据指针不在本句柄映射区内的次数 */
+} shm_sink_t;
+
+static void shm_sink_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    shm_sink_t* sink = (shm_sink_t*)user;
+    const uint8_t* base = (const uint8_t*)sink->shm->map->pBuffer;
+    if ((const uint8_t*)data < base || (const uint8_t*)data + data_len > base + sink->shm->map->Length) {
+        sink->outside++;
+    }
+    if (data_len >= sizeof(uint32_t)) {
+        memcpy(&sink->last_value, data, sizeof(uint32_t));
+    }
+    if (topic_id == TEST_TOPIC_ID_SHM_OR) {
+        sink->or_hits++;
+    } else if (topic_id == TEST_TOPIC_ID_SHM_AND) {
+        sink->and_hits++;
+    }
+}
+
+/* 阻塞在topic_shm_poll中的线程 */
+typedef struct {
+    topic_shm_t* shm;
+    int polled;                         /* topic_shm_poll的返回值 */
+    uint64_t elapsed_ms;                /* 阻塞时长 */
+} shm_poll_ctx_t;
+
+static void* shm_poll_entry(void* param) {
+    shm_poll_ctx_t* ctx = (shm_poll_ctx_t*)param;
+    uint64_t start = os_monotonic_time_get_millisecond();
+    ctx->polled = topic_shm_poll(ctx->shm, 2000);
+    ctx->elapsed_ms = os_monotonic_time_get_millisecond() - start;
+    return NULL;
+}
+
+/*
+ * @brief 共享内存总线功能测试：同一进程两次映射（地址不同）模拟两个进程，
+ *        验证零拷贝投递、最新值读取、AND规则、通知环溢出计数、值缓冲覆盖计数与本进程唤醒
+ * @return 0成功，-1失败
+ */
+static int test_shm(void) {
+    os_printf("\n[topic][SHM] 共享内存总线功能测试\n");
+
+    topic_shm_config_t config = {
+        .max_topics = 4, .max_events = 8, .value_size = 64, .value_depth = 2, .ring_size = 16,
+    };
+    topic_shm_t owner;
+    topic_shm_t peer;
+    if (topic_shm_create(&owner, PERF_TEST_SHM_NAME, &config) != 0) {
+        os_printf("[topic][SHM] 创建映射区失败\n");
+        return -1;
+    }
+    if (topic_shm_open(&peer, PERF_TEST_SHM_NAME) != 0) {
+        os_printf("[topic][SHM] 接入映射区失败\n");
+        topic_shm_close(&owner);
+        return -1;
+    }
+
+    obj_dict_key_t or_events[] = { TEST_EVENT_ID_SHM_OR };
+    obj_dict_key_t and_events[] = { TEST_EVENT_ID_SHM_AND_1, TEST_EVENT_ID_SHM_AND_2 };
+    topic_rule_t or_rule = { .type = TOPIC_RULE_OR, .events = or_events, .event_count = 1 };
+    topic_rule_t and_rule = { .type = TOPIC_RULE_AND, .events = and_events, .event_count = 2 };
+    shm_sink_t sink = { .shm = &peer };
+    int ret = 0;
+
+    /* 规则由一方创建、另一方订阅 */
+    if (topic_shm_rule_create(&owner, TEST_TOPIC_ID_SHM_OR, &or_rule) != 0 ||
+        topic_shm_rule_create(&peer, TEST_TOPIC_ID_SHM_AND, &and_rule) != 0 ||
+        topic_shm_rule_create(&peer, TEST_TOPIC_ID_SHM_OR, &or_rule) == 0) {
+        os_printf("[topic][SHM] 规则创建结果错误\n");
+        ret = -1;
+        goto __exit;
+    }
+    topic_shm_subscribe(&peer, TEST_TOPIC_ID_SHM_OR, shm_sink_callback, &sink);
+    topic_shm_subscribe(&peer, TEST_TOPIC_ID_SHM_AND, shm_sink_callback, &sink);
+
+    /* 零拷贝：借出缓冲直接写入，订阅方拿到的是自己映射区内的指针 */
+    uint32_t* loaned = (uint32_t*)topic_shm_loan(&owner, TEST_EVENT_ID_SHM_OR, sizeof(uint32_t));
+    if (!loaned) {
+        ret = -1;
+        goto __exit;
+    }
+    *loaned = 0xA5A5A5A5U;
+    topic_shm_publish_loaned(&owner, loaned, sizeof(uint32_t));
+    uint32_t value = 0;
+    int got = topic_shm_get(&peer, TEST_EVENT_ID_SHM_OR, &value, sizeof(value));
+    int polled = topic_shm_poll(&peer, 100);
+    if (polled != 1 || sink.or_hits != 1 || sink.last_value != 0xA5A5A5A5U || sink.outside != 0 ||
+        got != (int)sizeof(uint32_t) || value != 0xA5A5A5A5U) {
+        os_printf("[topic][SHM] 零拷贝投递错误: polled=%d hits=%u value=0x%08x outside=%u get=%d/0x%08x\n",
+                  polled, (unsigned)sink.or_hits, (unsigned)sink.last_value, (unsigned)sink.outside, got,
+                  (unsigned)value);
+        ret = -1;
+        goto __exit;
+    }
+
+    /* AND：两个事件都到达后触发一次，重复发布同一事件不触发 */
+    value = 1;
+    topic_shm_publish(&owner, TEST_EVENT_ID_SHM_AND_1, &value, sizeof(value));
+    topic_shm_publish(&owner, TEST_EVENT_ID_SHM_AND_1, &value, sizeof(value));
+    topic_shm_poll(&peer, 0);
+    uint32_t and_before = sink.and_hits;
+    topic_shm_publish(&peer, TEST_EVENT_ID_SHM_AND_2, &value, sizeof(value));
+    topic_shm_poll(&peer, 0);
+    if (and_before != 0 || sink.and_hits != 1) {
+        os_printf("[topic][SHM] AND规则错误: 前=%u 后=%u\n", (unsigned)and_before, (unsigned)sink.and_hits);
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 订阅方不读取：通知环（16）被覆盖的部分计入lost，只剩最近的通知可投递 */
+    topic_shm_stats_t before;
+    topic_shm_stats_t after;
+    topic_shm_get_stats(&peer, &before);
+    for (uint32_t i = 0; i < 40; ++i) {
+        topic_shm_publish(&owner, TEST_EVENT_ID_SHM_OR, &i, sizeof(i));
+    }
+    polled = topic_shm_poll(&peer, 0);
+    topic_shm_get_stats(&peer, &after);
+    if (after.lost - before.lost != 24 || polled != 16 || sink.last_value != 39) {
+        os_printf("[topic][SHM] 通知环溢出计数错误: lost=%llu polled=%d last=%u\n",
+                  (unsigned long long)(after.lost - before.lost), polled, (unsigned)sink.last_value);
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 每个事件2个值缓冲：第3次发布复用第1个缓冲，第1条通知计入overruns且不回调 */
+    before = after;
+    uint32_t hits_before = sink.or_hits;
+    for (uint32_t i = 0; i < 3; ++i) {
+        topic_shm_publish(&owner, TEST_EVENT_ID_SHM_OR, &i, sizeof(i));
+    }
+    topic_shm_poll(&peer, 0);
+    topic_shm_get_stats(&peer, &after);
+    if (after.overruns - before.overruns != 1 || sink.or_hits - hits_before != 2) {
+        os_printf("[topic][SHM] 值缓冲覆盖计数错误: overruns=%llu hits=%u\n",
+                  (unsigned long long)(after.overruns - before.overruns), (unsigned)(sink.or_hits - hits_before));
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 本进程另一线程发布：阻塞在topic_shm_poll中的线程被本进程的信号量唤醒，不等到超时 */
+    shm_poll_ctx_t poll_ctx = { .shm = &peer, .polled = -1 };
+    ThreadAttr_t attr = { .pName = "shm_poll", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    OsThread_t* poller = os_thread_create(shm_poll_entry, &poll_ctx, &attr);
+    if (!poller) {
+        os_printf("[topic][SHM] 创建线程失败\n");
+        ret = -1;
+        goto __exit;
+    }
+    os_thread_sleep_ms(50);
+    value = 7;
+    topic_shm_publish(&peer, TEST_EVENT_ID_SHM_OR, &value, sizeof(value));
+    os_thread_join(poller);
+    os_thread_destroy(poller);
+    if (poll_ctx.polled != 1 || poll_ctx.elapsed_ms >= 1000) {
+        os_printf("[topic][SHM] 本进程发布未唤醒等待线程: polled=%d elapsed=%llums\n", poll_ctx.polled,
+                  (unsigned long long)poll_ctx.elapsed_ms);
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 超出值缓冲容量的发布被拒绝 */
+    uint8_t big[128] = { 0 };
+    if (topic_shm_publish(&owner, TEST_EVENT_ID_SHM_OR, big, sizeof(big)) == 0) {
+        os_printf("[topic][SHM] 超长发布未被拒绝\n");
+        ret = -1;
+    }
+
+    /* 写者借出后放弃（模拟进程在借出与发布之间退出）：2个值缓冲轮转回最新值，读取有限次重试后失败 */
+    if (!topic_shm_loan(&owner, TEST_EVENT_ID_SHM_OR, sizeof(uint32_t)) ||
+        !topic_shm_loan(&owner, TEST_EVENT_ID_SHM_OR, sizeof(uint32_t)) ||
+        topic_shm_get(&peer, TEST_EVENT_ID_SHM_OR, &value, sizeof(value)) != -1) {
+        os_printf("[topic][SHM] 放弃的借出未使读取失败返回\n");
+        ret = -1;
+    }
+
+__exit:
+    topic_shm_close(&peer);
+    topic_shm_close(&owner);
+    if (ret == 0) {
+        os_printf("[topic][SHM] 共享内存总线功能测试: 通过\n");
+    }
+    return ret;
+}
+
+/* 子进程回传的结果 */
+typedef struct {
+    uint32_t received;                  /* 收到的DATA条数 */
+    uint32_t out_of_order;              /* 序号不连续的DATA条数 */
+    uint64_t lost;
+    uint64_t overruns;
+} shm_child_result_t;
+
+typedef struct {
+    topic_shm_t* shm;
+    shm_child_result_t result;
+    uint32_t next_seq;
+    int stop;
+} shm_child_ctx_t;
+
+static void shm_child_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    shm_child_ctx_t* ctx = (shm_child_ctx_t*)user;
+    uint32_t seq = 0;
+    if (data_len >= sizeof(seq)) memcpy(&seq, data, sizeof(seq));
+
+    if (topic_id == TEST_TOPIC_ID_SHM_PING) {
+        topic_shm_publish(ctx->shm, TEST_EVENT_ID_SHM_PONG, &seq, sizeof(seq));
+    } else if (topic_id == TEST_TOPIC_ID_SHM_DATA) {
+        if (seq != ctx->next_seq) ctx->result.out_of_order++;
+        ctx->next_seq = seq + 1;
+        ctx->result.received++;
+    } else if (topic_id == TEST_TOPIC_ID_SHM_STOP) {
+        ctx->stop = 1;
+    }
+}
+
+/*
+ * @brief 子进程：接入映射区，PING回PONG，统计DATA，收到STOP后回传结果
+ * @return 进程退出码
+ */
+static int shm_child_main(void) {
+    topic_shm_t shm;
+    if (topic_shm_open(&shm, PERF_TEST_SHM_NAME) != 0) return 1;
+
+    shm_child_ctx_t ctx = { .shm = &shm };
+    topic_shm_subscribe(&shm, TEST_TOPIC_ID_SHM_PING, shm_child_callback, &ctx);
+    topic_shm_subscribe(&shm, TEST_TOPIC_ID_SHM_DATA, shm_child_callback, &ctx);
+    topic_shm_subscribe(&shm, TEST_TOPIC_ID_SHM_STOP, shm_child_callback, &ctx);
+
+    /* 就绪通知 */
+    uint32_t ready = UINT32_MAX;
+    topic_shm_publish(&shm, TEST_EVENT_ID_SHM_PONG, &ready, sizeof(ready));
+
+    uint64_t deadline = os_monotonic_time_get_millisecond() + 60000;
+    while (!ctx.stop && os_monotonic_time_get_millisecond() < deadline) {
+        topic_shm_poll(&shm, 100);
+    }
+
+    topic_shm_stats_t stats;
+    topic_shm_get_stats(&shm, &stats);
+    ctx.result.lost = stats.lost;
+    ctx.result.overruns = stats.overruns;
+    topic_shm_publish(&shm, TEST_EVENT_ID_SHM_RESULT, &ctx.result, sizeof(ctx.result));
+    topic_shm_close(&shm);
+    return ctx.stop ? 0 : 2;
+}
+
+typedef struct {
+    uint32_t pong_seq;                  /* 最近收到的PONG序号 */
+    int pong;                           /* 收到PONG */
+    int result_ready;
+    shm_child_result_t result;
+} shm_parent_ctx_t;
+
+static void shm_parent_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    shm_parent_ctx_t* ctx = (shm_parent_ctx_t*)user;
+    if (topic_id == TEST_TOPIC_ID_SHM_PONG && data_len >= sizeof(uint32_t)) {
+        memcpy(&ctx->pong_seq, data, sizeof(uint32_t));
+        ctx->pong = 1;
+    } else if (topic_id == TEST_TOPIC_ID_SHM_RESULT && data_len == sizeof(shm_child_result_t)) {
+        memcpy(&ctx->result, data, sizeof(ctx->result));
+        ctx->result_ready = 1;
+    }
+}
+
+/*
+ * @brief 等待子进程回应指定序号的PONG
+ * @return 0成功，-1超时
+ */
+static int shm_wait_pong(topic_shm_t* shm, shm_parent_ctx_t* ctx, uint32_t seq) {
+    uint64_t deadline = os_monotonic_time_get_millisecond() + PERF_TEST_SHM_WAIT_MS;
+    while (!(ctx->pong && ctx->pong_seq == seq)) {
+        if (os_monotonic_time_get_millisecond() >= deadline) return -1;
+        topic_shm_poll(shm, 10);
+    }
+    ctx->pong = 0;
+    return 0;
+}
+
+static int shm_u32_compare(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * @brief 共享内存多进程性能测试：fork出订阅进程，测量跨进程往返延迟与吞吐
+ * @return 0成功，-1失败
+ */
+static int test_performance_shm(void) {
+    os_printf("\n[topic][PERF] 共享内存多进程总线测试\n");
+
+    topic_shm_config_t config = {
+        .max_topics = 8, .max_events = 8, .value_size = sizeof(shm_child_result_t) + PERF_TEST_SHM_PAYLOAD,
+        .value_depth = PERF_TEST_SHM_BURST * 2, .ring_size = PERF_TEST_SHM_BURST * 4,
+    };
+    topic_shm_t shm;
+    if (topic_shm_create(&shm, PERF_TEST_SHM_NAME, &config) != 0) return -1;
+
+    static const struct {
+        uint16_t topic_id;
+        obj_dict_key_t event;
+    } routes[] = {
+        { TEST_TOPIC_ID_SHM_PING, TEST_EVENT_ID_SHM_PING },
+        { TEST_TOPIC_ID_SHM_PONG, TEST_EVENT_ID_SHM_PONG },
+        { TEST_TOPIC_ID_SHM_DATA, TEST_EVENT_ID_SHM_DATA },
+        { TEST_TOPIC_ID_SHM_STOP, TEST_EVENT_ID_SHM_STOP },
+        { TEST_TOPIC_ID_SHM_RESULT, TEST_EVENT_ID_SHM_RESULT },
+    };
+    for (size_t i = 0; i < sizeof(routes) / sizeof(routes[0]); ++i) {
+        obj_dict_key_t key = routes[i].event;
+        topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &key, .event_count = 1 };
+        topic_shm_rule_create(&shm, routes[i].topic_id, &rule);
+    }
+    shm_parent_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    topic_shm_subscribe(&shm, TEST_TOPIC_ID_SHM_PONG, shm_parent_callback, &ctx);
+    topic_shm_subscribe(&shm, TEST_TOPIC_ID_SHM_RESULT, shm_parent_callback, &ctx);
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        topic_shm_close(&shm);
+        return -1;
+    }
+    if (pid == 0) {
+        _exit(shm_child_main());
+    }
+
+    int ret = 0;
+    uint32_t* rtt = (uint32_t*)os_malloc(sizeof(uint32_t) * PERF_TEST_SHM_PINGS);
+    if (!rtt || shm_wait_pong(&shm, &ctx, UINT32_MAX) != 0) {
+        os_printf("[topic][PERF] 子进程未就绪\n");
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 往返延迟：PING -> 子进程回调 -> PONG -> 本进程回调 */
+    for (uint32_t i = 0; i < PERF_TEST_SHM_PINGS; ++i) {
+        uint64_t start = os_monotonic_time_get_microsecond();
+        topic_shm_publish(&shm, TEST_EVENT_ID_SHM_PING, &i, sizeof(i));
+        if (shm_wait_pong(&shm, &ctx, i) != 0) {
+            os_printf("[topic][PERF] 第%u次PING超时\n", (unsigned)i);
+            ret = -1;
+            goto __exit;
+        }
+        rtt[i] = (uint32_t)(os_monotonic_time_get_microsecond() - start);
+    }
+    qsort(rtt, PERF_TEST_SHM_PINGS, sizeof(uint32_t), shm_u32_compare);
+
+    /* 吞吐：每PERF_TEST_SHM_BURST条DATA后以一次PING/PONG同步（通知按序处理，PONG表示此前DATA已全部回调） */
+    uint8_t payload[PERF_TEST_SHM_PAYLOAD] = { 0 };
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (uint32_t i = 0; i < PERF_TEST_SHM_MESSAGES; ++i) {
+        uint8_t* buf = (uint8_t*)topic_shm_loan(&shm, TEST_EVENT_ID_SHM_DATA, sizeof(payload));
+        if (!buf) {
+            ret = -1;
+            goto __exit;
+        }
+        memcpy(payload, &i, sizeof(i));
+        memcpy(buf, payload, sizeof(payload));
+        topic_shm_publish_loaned(&shm, buf, sizeof(payload));
+        if ((i + 1) % PERF_TEST_SHM_BURST == 0) {
+            topic_shm_publish(&shm, TEST_EVENT_ID_SHM_PING, &i, sizeof(i));
+            if (shm_wait_pong(&shm, &ctx, i) != 0) {
+                ret = -1;
+                goto __exit;
+            }
+        }
+    }
+    uint64_t elapsed_us = os_monotonic_time_get_microsecond() - start;
+
+    uint32_t stop = 0;
+    topic_shm_publish(&shm, TEST_EVENT_ID_SHM_STOP, &stop, sizeof(stop));
+    uint64_t deadline = os_monotonic_time_get_millisecond() + PERF_TEST_SHM_WAIT_MS;
+    while (!ctx.result_ready && os_monotonic_time_get_millisecond() < deadline) {
+        topic_shm_poll(&shm, 10);
+    }
+
+    topic_shm_stats_t stats;
+    topic_shm_get_stats(&shm, &stats);
+    os_printf("[topic][PERF] 跨进程往返(%d次): p50=%u us, p99=%u us, max=%u us\n", PERF_TEST_SHM_PINGS,
+              (unsigned)rtt[PERF_TEST_SHM_PINGS / 2], (unsigned)rtt[PERF_TEST_SHM_PINGS * 99 / 100],
+              (unsigned)rtt[PERF_TEST_SHM_PINGS - 1]);
+    os_printf("[topic][PERF] 跨进程吞吐(%d条x%dB，每%d条同步一次): %.0f msg/s, %.3f us/msg\n",
+              PERF_TEST_SHM_MESSAGES, PERF_TEST_SHM_PAYLOAD, PERF_TEST_SHM_BURST,
+              (double)PERF_TEST_SHM_MESSAGES * 1000000.0 / (double)(elapsed_us ? elapsed_us : 1),
+              (double)elapsed_us / PERF_TEST_SHM_MESSAGES);
+    os_printf("[topic][PERF] 子进程: 收到=%u 乱序=%u lost=%llu overruns=%llu; 本进程唤醒对端%llu次\n",
+              (unsigned)ctx.result.received, (unsigned)ctx.result.out_of_order,
+              (unsigned long long)ctx.result.lost, (unsigned long long)ctx.result.overruns,
+              (unsigned long long)stats.wakeups);
+    if (!ctx.result_ready || ctx.result.received != PERF_TEST_SHM_MESSAGES || ctx.result.out_of_order != 0 ||
+        ctx.result.lost != 0 || ctx.result.overruns != 0) {
+        os_printf("[topic][PERF] 子进程结果错误\n");
+        ret = -1;
+    }
+
+__exit:
+    if (ret != 0) {
+        kill(pid, SIGKILL);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (ret == 0 && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        os_printf("[topic][PERF] 子进程异常退出: 0x%x\n", (unsigned)status);
+        ret = -1;
+    }
+    os_free(rtt);
+    topic_shm_close(&shm);
+    return ret;
+}
+#endif
+
+/* ---------------- UDP桥接测试 ---------------- */
+
+#if TOPIC_BUS_ENABLE_BRIDGE
+/* 桥接负载 */
+typedef struct {
+    uint32_t seq;                       /* 发送序号 */
+    uint32_t topic;                     /* 发送端Topic */
+    uint8_t padding[8];
+} bridge_payload_t;
+
+/* 接收端的Topic映射：发送端Topic -> 接收端事件 */
+static const topic_bridge_map_t bridge_map[] = {
+    { TEST_TOPIC_ID_BRIDGE_BASE + 0, TEST_EVENT_ID_BRIDGE_REMOTE_BASE + 0 },
+    { TEST_TOPIC_ID_BRIDGE_BASE + 1, TEST_EVENT_ID_BRIDGE_REMOTE_BASE + 1 },
+    { TEST_TOPIC_ID_BRIDGE_BASE + 2, TEST_EVENT_ID_BRIDGE_REMOTE_BASE + 2 },
+    { TEST_TOPIC_ID_BRIDGE_BASE + 3, TEST_EVENT_ID_BRIDGE_REMOTE_BASE + 3 },
+    { TEST_TOPIC_ID_BRIDGE_STOP, TEST_EVENT_ID_BRIDGE_REMOTE_STOP },
+};
+
+/* 桥接的一端：对象字典 + 总线 + Router */
+typedef struct {
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_router_entry_t router_entries[PERF_TEST_MAX_TOPICS];
+    topic_router_t router;
+} bridge_node_t;
+
+/* 接收端回调统计 */
+typedef struct {
+    uint32_t records;                   /* 收到的数据记录数 */
+    uint32_t bad;                       /* Topic与负载不一致的记录数 */
+    uint32_t topic_mask;                /* 收到的Topic（按位） */
+    uint32_t last_seq;
+    int stop;
+} bridge_sink_t;
+
+static void bridge_sink_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    bridge_sink_t* sink = (bridge_sink_t*)user;
+    if (topic_id == TEST_TOPIC_ID_BRIDGE_STOP) {
+        sink->stop = 1;
+        return;
+    }
+    bridge_payload_t payload;
+    if (data_len != sizeof(payload)) {
+        sink->bad++;
+        return;
+    }
+    memcpy(&payload, data, sizeof(payload));
+    if (payload.topic != topic_id) sink->bad++;
+    sink->topic_mask |= 1U << topic_id;
+    sink->last_seq = payload.seq;
+    sink->records++;
+}
+
+/*
+ * @brief 初始化桥接的一端：发送端每个事件一个OR Topic，接收端按映射的事件建同号Topic并订阅
+ * @param node 桥接端
+ * @param remote 非0表示接收端
+ * @param sink 接收端回调统计（发送端为NULL）
+ */
+static void bridge_node_init(bridge_node_t* node, int remote, bridge_sink_t* sink) {
+    obj_dict_init(&node->dict, node->dict_entries, PERF_TEST_EVENT_COUNT);
+    topic_bus_init(&node->bus, node->topic_entries, PERF_TEST_MAX_TOPICS, &node->dict);
+    topic_router_init(&node->router, node->router_entries, PERF_TEST_MAX_TOPICS);
+    topic_bus_set_router(&node->bus, &node->router);
+
+    for (uint16_t i = 0; i <= PERF_TEST_BRIDGE_TOPICS + 1; ++i) {
+        uint16_t topic_id = (uint16_t)(TEST_TOPIC_ID_BRIDGE_BASE + i);
+        obj_dict_key_t key = (obj_dict_key_t)((remote ? TEST_EVENT_ID_BRIDGE_REMOTE_BASE : TEST_EVENT_ID_BRIDGE_BASE) + i);
+        topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &key, .event_count = 1 };
+        topic_rule_create(&node->bus, topic_id, &rule);
+        if (sink) topic_subscribe(&node->bus, topic_id, bridge_sink_callback, sink);
+    }
+}
+
+static void bridge_node_deinit(bridge_node_t* node) {
+    topic_bus_deinit(&node->bus);
+    topic_router_deinit(&node->router);
+}
+
+/*
+ * @brief 发送端发布一条数据记录
+ */
+static void bridge_publish(bridge_node_t* node, uint32_t seq, uint16_t index) {
+    bridge_payload_t payload = { .seq = seq, .topic = (uint32_t)(TEST_TOPIC_ID_BRIDGE_BASE + index) };
+    obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_BRIDGE_BASE + index);
+    obj_dict_set(&node->dict, key, &payload, sizeof(payload), 0);
+    topic_publish_event(&node->bus, key);
+}
+
+/*
+ * @brief 桥接功能测试：本机回环上两条总线，验证合并发送、映射注入、序号丢失统计、未映射与错误报文
+ * @return 0成功，-1失败
+ */
+static int test_bridge(void) {
+    os_printf("\n[topic][BRIDGE] UDP桥接功能测试\n");
+
+    bridge_node_t* local = (bridge_node_t*)os_malloc(sizeof(bridge_node_t));
+    bridge_node_t* remote = (bridge_node_t*)os_malloc(sizeof(bridge_node_t));
+    topic_bridge_tx_t* tx = (topic_bridge_tx_t*)os_malloc(sizeof(topic_bridge_tx_t));
+    topic_bridge_rx_t* rx = (topic_bridge_rx_t*)os_malloc(sizeof(topic_bridge_rx_t));
+    if (!local || !remote || !tx || !rx) {
+        os_free(local);
+        os_free(remote);
+        os_free(tx);
+        os_free(rx);
+        return -1;
+    }
+    bridge_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    bridge_node_init(local, 0, NULL);
+    bridge_node_init(remote, 1, &sink);
+
+    int ret = 0;
+    if (topic_bridge_rx_init(rx, &remote->bus, "127.0.0.1", PERF_TEST_BRIDGE_PORT, bridge_map,
+                             sizeof(bridge_map) / sizeof(bridge_map[0])) != 0 ||
+        topic_bridge_tx_init(tx, "127.0.0.1", PERF_TEST_BRIDGE_PORT, 7, 0) != 0) {
+        os_printf("[topic][BRIDGE] socket初始化失败\n");
+        ret = -1;
+        goto __exit;
+    }
+    for (uint16_t i = 0; i < PERF_TEST_BRIDGE_TOPICS; ++i) {
+        topic_bridge_tx_add(tx, &local->router, (uint16_t)(TEST_TOPIC_ID_BRIDGE_BASE + i));
+    }
+    topic_bridge_tx_add(tx, &local->router, TEST_TOPIC_ID_BRIDGE_UNMAPPED);
+
+    /* 4个Topic各一条：汇聚为一个报文，注入接收端对应事件 */
+    for (uint16_t i = 0; i < PERF_TEST_BRIDGE_TOPICS; ++i) {
+        bridge_publish(local, i, i);
+    }
+    size_t sent = topic_router_flush(&local->router);
+    int injected = topic_bridge_rx_poll(rx, 1000);
+    topic_bridge_tx_stats_t tx_stats;
+    topic_bridge_rx_stats_t rx_stats;
+    topic_bridge_tx_get_stats(tx, &tx_stats);
+    uint32_t all_topics = ((1U << PERF_TEST_BRIDGE_TOPICS) - 1U) << TEST_TOPIC_ID_BRIDGE_BASE;
+    if (sent != PERF_TEST_BRIDGE_TOPICS || injected != PERF_TEST_BRIDGE_TOPICS || tx_stats.datagrams != 1 ||
+        sink.records != PERF_TEST_BRIDGE_TOPICS || sink.topic_mask != all_topics || sink.bad != 0) {
+        os_printf("[topic][BRIDGE] 合并发送错误: sent=%u injected=%d datagrams=%llu records=%u mask=0x%x bad=%u\n",
+                  (unsigned)sent, injected, (unsigned long long)tx_stats.datagrams, (unsigned)sink.records,
+                  (unsigned)sink.topic_mask, (unsigned)sink.bad);
+        ret = -1;
+        goto __exit;
+    }
+    bridge_payload_t value;
+    if (obj_dict_get(&remote->dict, TEST_EVENT_ID_BRIDGE_REMOTE_BASE + 2, &value, sizeof(value), NULL, NULL, NULL) !=
+            (ssize_t)sizeof(value) || value.seq != 2) {
+        os_printf("[topic][BRIDGE] 接收端对象字典未更新\n");
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 线上格式为小端：magic、节点ID与首条记录的topic_id逐字节核对；回环报文计入延迟直方图 */
+    const uint8_t* wire = tx->dgram;
+    const uint8_t* rec = wire + TOPIC_BRIDGE_HDR_SIZE;
+    int wire_ok = wire[0] == (TOPIC_BRIDGE_MAGIC & 0xFFU) && wire[1] == (TOPIC_BRIDGE_MAGIC >> 8) &&
+                  wire[4] == 7 && wire[5] == 0 && rec[0] == (uint8_t)TEST_TOPIC_ID_BRIDGE_BASE &&
+                  rec[1] == (uint8_t)(TEST_TOPIC_ID_BRIDGE_BASE >> 8);
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_snapshot_t delay;
+    topic_hist_snapshot(&rx->delay, &delay);
+    wire_ok = wire_ok && delay.count == 1;
+#endif
+    if (!wire_ok) {
+        os_printf("[topic][BRIDGE] 报文头字节序或回环延迟统计错误\n");
+        ret = -1;
+        goto __exit;
+    }
+
+    /* 跳过2个序号模拟丢包；未映射的Topic只计数；错误报文丢弃 */
+    tx->seq += 2;
+    bridge_publish(local, 100, 0);
+    obj_dict_set(&local->dict, TEST_EVENT_ID_BRIDGE_UNMAPPED, &value, sizeof(value), 0);
+    topic_publish_event(&local->bus, TEST_EVENT_ID_BRIDGE_UNMAPPED);
+    topic_router_flush(&local->router);
+    const char garbage[] = "not a bridge datagram";
+    sendto(tx->sock, garbage, sizeof(garbage), 0, (const struct sockaddr*)&tx->addr, sizeof(tx->addr));
+    injected = 0;
+    for (int i = 0; i < 10 && injected < 1; ++i) {
+        injected += topic_bridge_rx_poll(rx, 100);
+    }
+    topic_bridge_rx_poll(rx, 100);
+    topic_bridge_rx_get_stats(rx, &rx_stats);
+    if (injected != 1 || rx_stats.lost != 2 || rx_stats.unmapped != 1 || rx_stats.malformed != 1 ||
+        rx_stats.datagrams != 2 || sink.last_seq != 100) {
+        os_printf("[topic][BRIDGE] 统计错误: injected=%d lost=%llu unmapped=%llu malformed=%llu datagrams=%llu\n",
+                  injected, (unsigned long long)rx_stats.lost, (unsigned long long)rx_stats.unmapped,
+                  (unsigned long long)rx_stats.malformed, (unsigned long long)rx_stats.datagrams);
+        ret = -1;
+    }
+
+__exit:
+    topic_bridge_tx_deinit(tx);
+    topic_bridge_rx_deinit(rx);
+    bridge_node_deinit(local);
+    bridge_node_deinit(remote);
+    os_free(local);
+    os_free(remote);
+    os_free(tx);
+    os_free(rx);
+    if (ret == 0) {
+        os_printf("[topic][BRIDGE] UDP桥接功能测试: 通过\n");
+    }
+    return ret;
+}
+
+/* 接收进程回传的结果 */
+typedef struct {
+    uint32_t records;
+    uint32_t bad;
+    uint64_t datagrams;
+    uint64_t lost;
+    uint32_t delay_p50_us;
+    uint32_t delay_p99_us;
+} bridge_child_result_t;
+
+/*
+ * @brief 接收进程：绑定端口后通知父进程，注入收到的记录直到STOP或空闲超时，经管道回传结果
+ * @param fd 管道写端
+ * @return 进程退出码
+ */
+static int bridge_child_main(int fd) {
+    bridge_node_t* node = (bridge_node_t*)os_malloc(sizeof(bridge_node_t));
+    topic_bridge_rx_t* rx = (topic_bridge_rx_t*)os_malloc(sizeof(topic_bridge_rx_t));
+    if (!node || !rx) return 1;
+    bridge_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    bridge_node_init(node, 1, &sink);
+    if (topic_bridge_rx_init(rx, &node->bus, "127.0.0.1", PERF_TEST_BRIDGE_PORT, bridge_map,
+                             sizeof(bridge_map) / sizeof(bridge_map[0])) != 0) {
+        return 1;
+    }
+    uint8_t ready = 1;
+    if (write(fd, &ready, 1) != 1) return 1;
+
+    /* 收到STOP或发送开始后空闲1秒结束 */
+    uint64_t last_rx = os_monotonic_time_get_millisecond();
+    uint64_t deadline = last_rx + 60000;
+    while (!sink.stop) {
+        uint64_t now = os_monotonic_time_get_millisecond();
+        if (now >= deadline || (sink.records > 0 && now - last_rx > 1000)) break;
+        if (topic_bridge_rx_poll(rx, 100) > 0) last_rx = os_monotonic_time_get_millisecond();
+    }
+
+    topic_bridge_rx_stats_t stats;
+    topic_bridge_rx_get_stats(rx, &stats);
+    bridge_child_result_t result = {
+        .records = sink.records, .bad = sink.bad, .datagrams = stats.datagrams, .lost = stats.lost,
+    };
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_snapshot_t snap;
+    topic_hist_snapshot(&rx->delay, &snap);
+    result.delay_p50_us = topic_hist_percentile(&snap, 500);
+    result.delay_p99_us = topic_hist_percentile(&snap, 990);
+#endif
+    ssize_t n = write(fd, &result, sizeof(result));
+    topic_bridge_rx_deinit(rx);
+    return (n == (ssize_t)sizeof(result)) ? 0 : 1;
+}
+
+/*
+ * @brief 一轮跨进程桥接：fork接收进程，发送端按max_records合并发送PERF_TEST_BRIDGE_RECORDS条记录
+ * @param max_records 每个报文最多的记录数（1为不合并）
+ * @return 0成功，-1失败
+ */
+static int bridge_run(size_t max_records) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1;
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        _exit(bridge_child_main(fds[1]));
+    }
+    close(fds[1]);
+
+    int ret = 0;
+    bridge_child_result_t result;
+    memset(&result, 0, sizeof(result));
+    bridge_node_t* node = (bridge_node_t*)os_malloc(sizeof(bridge_node_t));
+    topic_bridge_tx_t* tx = (topic_bridge_tx_t*)os_malloc(sizeof(topic_bridge_tx_t));
+    struct pollfd pfd = { .fd = fds[0], .events = POLLIN };
+    uint8_t ready = 0;
+    if (!node || !tx || poll(&pfd, 1, PERF_TEST_BRIDGE_WAIT_MS) != 1 || read(fds[0], &ready, 1) != 1) {
+        os_printf("[topic][PERF] 接收进程未就绪\n");
+        os_free(node);
+        os_free(tx);
+        kill(pid, SIGKILL);
+        waitpid(pid, NULL, 0);
+        close(fds[0]);
+        return -1;
+    }
+    bridge_node_init(node, 0, NULL);
+    topic_bridge_tx_init(tx, "127.0.0.1", PERF_TEST_BRIDGE_PORT, 1, max_records);
+    for (uint16_t i = 0; i <= PERF_TEST_BRIDGE_TOPICS; ++i) {
+        topic_bridge_tx_add(tx, &node->router, (uint16_t)(TEST_TOPIC_ID_BRIDGE_BASE + i));
+    }
+
+    uint64_t start = os_monotonic_time_get_microsecond();
+    for (uint32_t i = 0; i < PERF_TEST_BRIDGE_RECORDS; ++i) {
+        bridge_publish(node, i, (uint16_t)(i % PERF_TEST_BRIDGE_TOPICS));
+    }
+    topic_router_flush(&node->router);
+    uint64_t elapsed_us = os_monotonic_time_get_microsecond() - start;
+
+    /* STOP单独一个报文 */
+    obj_dict_set(&node->dict, TEST_EVENT_ID_BRIDGE_STOP, &ready, sizeof(ready), 0);
+    topic_publish_event(&node->bus, TEST_EVENT_ID_BRIDGE_STOP);
+    topic_router_flush(&node->router);
+
+    topic_bridge_tx_stats_t tx_stats;
+    topic_bridge_tx_get_stats(tx, &tx_stats);
+    pfd.revents = 0;
+    if (poll(&pfd, 1, PERF_TEST_BRIDGE_WAIT_MS * 2) != 1 || read(fds[0], &result, sizeof(result)) != sizeof(result)) {
+        os_printf("[topic][PERF] 未收到接收进程结果\n");
+        kill(pid, SIGKILL);
+        ret = -1;
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+
+    if (ret == 0) {
+        uint32_t lost_records = PERF_TEST_BRIDGE_RECORDS - result.records;
+        os_printf("[topic][PERF] %s: %llu个报文(%.1f条/报文), 发送 %.0f records/s (%.3f us/record, %llu B), "
+                  "接收 %u条 丢失 %u条(%.2f%%) 丢失报文%llu, 单程延迟 p50=%u us p99=%u us\n",
+                  (max_records == 1) ? "逐条发送" : "合并发送", (unsigned long long)tx_stats.datagrams,
+                  (double)tx_stats.records / (double)(tx_stats.datagrams ? tx_stats.datagrams : 1),
+                  (double)PERF_TEST_BRIDGE_RECORDS * 1000000.0 / (double)(elapsed_us ? elapsed_us : 1),
+                  (double)elapsed_us / PERF_TEST_BRIDGE_RECORDS, (unsigned long long)tx_stats.bytes,
+                  (unsigned)result.records, (unsigned)lost_records,
+                  100.0 * lost_records / PERF_TEST_BRIDGE_RECORDS, (unsigned long long)result.lost,
+                  (unsigned)result.delay_p50_us, (unsigned)result.delay_p99_us);
+        /* UDP不保证送达：丢失只报告；数据错误或记录数超过发送数视为失败 */
+        if (result.bad != 0 || result.records > PERF_TEST_BRIDGE_RECORDS || tx_stats.errors != 0 ||
+            !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            os_printf("[topic][PERF] 桥接结果错误: bad=%u errors=%llu status=0x%x\n", (unsigned)result.bad,
+                      (unsigned long long)tx_stats.errors, (unsigned)status);
+            ret = -1;
+        }
+    }
+
+    topic_bridge_tx_deinit(tx);
+    bridge_node_deinit(node);
+    os_free(tx);
+    os_free(node);
+    return ret;
+}
+
+/*
+ * @brief 跨进程UDP桥接性能测试：逐条发送与合并发送的报文数、吞吐与丢失对比
+ * @return 0成功，-1失败
+ */
+static int test_performance_bridge(void) {
+    os_printf("\n[topic][PERF] 跨进程UDP桥接测试（本机回环，%d条x%uB记录）\n", PERF_TEST_BRIDGE_RECORDS,
+              (unsigned)sizeof(bridge_payload_t));
+    if (bridge_run(1) != 0) return -1;
+    return bridge_run(0);
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_SERIAL
+/* 内存链路：发送端写入的字节，按需转交给接收端 */
+typedef struct {
+    uint8_t buf[PERF_TEST_SERIAL_LINK];
+    size_t len;
+} serial_link_t;
+
+static int serial_link_write(const uint8_t* data, size_t len, void* user_data) {
+    serial_link_t* link = (serial_link_t*)user_data;
+    if (link->len + len > sizeof(link->buf)) return -1;
+    memcpy(link->buf + link->len, data, len);
+    link->len += len;
+    return 0;
+}
+
+/* 串口链路的一端：对象字典 + 总线 + Router */
+typedef struct {
+    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
+    obj_dict_t dict;
+    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
+    topic_bus_t bus;
+    topic_router_entry_t router_entries[PERF_TEST_MAX_TOPICS];
+    topic_router_t router;
+} serial_node_t;
+
+/* 接收端回调统计 */
+typedef struct {
+    uint32_t records;                   /* 收到的记录数 */
+    uint32_t bad;                       /* 负载与期望不一致的记录数 */
+    uint32_t last_len;
+    uint32_t last_seq;                  /* 负载前4字节 */
+} serial_sink_t;
 
-    /* 预热 */
-    for (int i = 0; i < 1000; ++i) {
-        obj_dict_set(&dict, TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE, &event_data, sizeof(event_data), 0);
-        topic_publish_event(&bus, TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE);
+/*
+ * @brief 生成测试负载：前4字节为序号，其余字节含0与连续非0段，覆盖COBS的各种块
+ */
+static void serial_fill(uint8_t* data, size_t len, uint32_t seq) {
+    for (size_t i = 0; i < len; ++i) {
+        data[i] = (uint8_t)((i % 5 == 4) ? 0 : (seq + i));
     }
+    if (len >= sizeof(seq)) memcpy(data, &seq, sizeof(seq));
+}
 
-    /* 测量延迟 */
-    uint64_t start = os_monotonic_time_get_microsecond();
-    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
-        obj_dict_key_t key = (obj_dict_key_t)(TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE + (i % 5));
-        obj_dict_set(&dict, key, &event_data, sizeof(event_data), 0);
-        topic_publish_event(&bus, key);
+static void serial_sink_callback(uint16_t topic_id, const void* data, size_t data_len, void* user) {
+    (void)topic_id;
+    serial_sink_t* sink = (serial_sink_t*)user;
+    uint8_t expect[TOPIC_SERIAL_MAX_PAYLOAD];
+    uint32_t seq = 0;
+    if (data_len >= sizeof(seq)) memcpy(&seq, data, sizeof(seq));
+    if (data_len > sizeof(expect)) {
+        sink->bad++;
+        return;
     }
-    uint64_t end = os_monotonic_time_get_microsecond();
-
-    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
-    os_printf("[topic][PERF] 事件发布延迟: %.2f us/publish (原子=%d)\n",
-              avg_us, TOPIC_BUS_ENABLE_ATOMICS);
+    serial_fill(expect, data_len, seq);
+    /* 满块负载（全非0）不按serial_fill生成，只检查没有0 */
+    if (data_len == 254 && memchr(data, 0, data_len) == NULL) {
+        seq = 0;
+    } else if (memcmp(expect, data, data_len) != 0) {
+        sink->bad++;
+    }
+    sink->last_len = (uint32_t)data_len;
+    sink->last_seq = seq;
+    sink->records++;
+}
 
-    return 0;
+/*
+ * @brief 初始化链路的一端：事件key触发同号的OR Topic
+ * @param node 链路端
+ * @param key 事件
+ * @param sink 回调统计（NULL表示不订阅）
+ */
+static void serial_node_init(serial_node_t* node, obj_dict_key_t key, serial_sink_t* sink) {
+    obj_dict_init(&node->dict, node->dict_entries, PERF_TEST_EVENT_COUNT);
+    topic_bus_init(&node->bus, node->topic_entries, PERF_TEST_MAX_TOPICS, &node->dict);
+    topic_router_init(&node->router, node->router_entries, PERF_TEST_MAX_TOPICS);
+    topic_bus_set_router(&node->bus, &node->router);
+    topic_rule_t rule = { .type = TOPIC_RULE_OR, .events = &key, .event_count = 1 };
+    topic_rule_create(&node->bus, TEST_TOPIC_ID_SERIAL, &rule);
+    if (sink) topic_subscribe(&node->bus, TEST_TOPIC_ID_SERIAL, serial_sink_callback, sink);
 }
 
-/* ---------------- 性能测试：规则匹配性能 ---------------- */
+static void serial_node_deinit(serial_node_t* node) {
+    topic_bus_deinit(&node->bus);
+    topic_router_deinit(&node->router);
+}
 
-static int test_performance_rule_matching(void) {
-    os_printf("\n[topic][PERF] 规则匹配性能测试\n");
+/*
+ * @brief 把链路中的字节按chunk大小喂给接收端，并排空接收总线的ISR队列
+ * @param chunk 每次喂入的字节数
+ * @return 完成的帧数
+ */
+static size_t serial_link_deliver(serial_link_t* link, topic_serial_rx_t* rx, size_t chunk) {
+    size_t frames = 0;
+    for (size_t off = 0; off < link->len; off += chunk) {
+        size_t n = link->len - off < chunk ? link->len - off : chunk;
+        frames += topic_serial_rx_feed(rx, link->buf + off, n);
+        topic_bus_process_isr_queue(rx->bus);
+    }
+    link->len = 0;
+    return frames;
+}
 
-    obj_dict_entry_t dict_entries[PERF_TEST_EVENT_COUNT];
-    obj_dict_t dict;
-    obj_dict_init(&dict, dict_entries, PERF_TEST_EVENT_COUNT);
+static const topic_serial_map_t serial_map[] = {
+    { TEST_TOPIC_ID_SERIAL, TEST_EVENT_ID_SERIAL_REMOTE },
+};
 
-    topic_entry_t topic_entries[PERF_TEST_MAX_TOPICS];
-    topic_bus_t bus;
-    topic_bus_init(&bus, topic_entries, PERF_TEST_MAX_TOPICS, &dict);
+/*
+ * @brief 串口帧传输功能测试：经内存链路验证Router发送、逐字节与不对齐分块解析、
+ *        CRC错误与重新同步、满块负载、映射、序号丢失统计以及确认重传去重
+ * @return 0成功，-1失败
+ */
+static int test_serial(void) {
+    os_printf("\n[topic][SERIAL] 串口帧传输功能测试\n");
+
+    serial_node_t* local = (serial_node_t*)os_malloc(sizeof(serial_node_t));
+    serial_node_t* remote = (serial_node_t*)os_malloc(sizeof(serial_node_t));
+    serial_link_t* ab = (serial_link_t*)os_malloc(sizeof(serial_link_t));
+    serial_link_t* ba = (serial_link_t*)os_malloc(sizeof(serial_link_t));
+    topic_serial_tx_t* tx = (topic_serial_tx_t*)os_malloc(sizeof(topic_serial_tx_t));
+    topic_serial_tx_t* tx_ack = (topic_serial_tx_t*)os_malloc(sizeof(topic_serial_tx_t));
+    topic_serial_tx_t* tx_back = (topic_serial_tx_t*)os_malloc(sizeof(topic_serial_tx_t));
+    topic_serial_rx_t* rx = (topic_serial_rx_t*)os_malloc(sizeof(topic_serial_rx_t));
+    topic_serial_rx_t* rx_back = (topic_serial_rx_t*)os_malloc(sizeof(topic_serial_rx_t));
+    if (!local || !remote || !ab || !ba || !tx || !tx_ack || !tx_back || !rx || !rx_back) {
+        os_free(local);
+        os_free(remote);
+        os_free(ab);
+        os_free(ba);
+        os_free(tx);
+        os_free(tx_ack);
+        os_free(tx_back);
+        os_free(rx);
+        os_free(rx_back);
+        return -1;
+    }
+    serial_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    ab->len = 0;
+    ba->len = 0;
+    serial_node_init(local, TEST_EVENT_ID_SERIAL, NULL);
+    serial_node_init(remote, TEST_EVENT_ID_SERIAL_REMOTE, &sink);
+
+    /* local -> remote：tx（不确认）与tx_ack（确认）；remote -> local：tx_back回ACK */
+    topic_serial_tx_init(tx, serial_link_write, ab, 0);
+    topic_serial_tx_init(tx_ack, serial_link_write, ab, 1);
+    topic_serial_tx_init(tx_back, serial_link_write, ba, 0);
+    topic_serial_rx_init(rx, &remote->bus, serial_map, sizeof(serial_map) / sizeof(serial_map[0]), tx_back);
+    topic_serial_rx_init(rx_back, &local->bus, NULL, 0, tx_ack);
+    topic_router_add_custom(&local->router, TEST_TOPIC_ID_SERIAL, topic_serial_route, tx);
+
+    int ret = 0;
+    uint8_t data[TOPIC_SERIAL_MAX_PAYLOAD + 1];
+    topic_serial_tx_stats_t tx_stats;
+    topic_serial_rx_stats_t rx_stats;
+
+    /* Router发送3条，逐字节解析 */
+    for (uint32_t i = 0; i < 3; ++i) {
+        serial_fill(data, 40, i);
+        obj_dict_set(&local->dict, TEST_EVENT_ID_SERIAL, data, 40, 0);
+        topic_publish_event(&local->bus, TEST_EVENT_ID_SERIAL);
+    }
+    size_t frames = serial_link_deliver(ab, rx, 1);
+    if (frames != 3 || sink.records != 3 || sink.bad != 0 || sink.last_seq != 2) {
+        os_printf("[topic][SERIAL] 逐字节解析错误: frames=%u records=%u bad=%u\n", (unsigned)frames,
+                  (unsigned)sink.records, (unsigned)sink.bad);
+        ret = -1;
+        goto __exit;
+    }
 
-    /* 创建多个Topic（OR规则） */
-    /* 使用静态数组，避免栈上的数组生命周期问题 */
-    static obj_dict_key_t events_or_static[10][1];
-    for (uint16_t i = 0; i < 10; ++i) {
-        events_or_static[i][0] = (obj_dict_key_t)(TEST_EVENT_ID_PERF_EVENT_PUBLISH_BASE + i);
-        topic_rule_t rule = {
-            .type = TOPIC_RULE_OR,
-            .events = events_or_static[i],
-            .event_count = 1,
-        };
-        topic_rule_create(&bus, (test_topic_id_t)(TEST_TOPIC_ID_PERF_RULE_MATCHING_OR_BASE + i), &rule);
-        topic_subscribe(&bus, (test_topic_id_t)(TEST_TOPIC_ID_PERF_RULE_MATCHING_OR_BASE + i), test_callback, NULL);
+    /* 不同长度（含满块与最大负载）按7字节分块解析；超长负载被拒绝 */
+    static const size_t lens[] = { 4, 5, 9, 253, 255, TOPIC_SERIAL_MAX_PAYLOAD };
+    for (size_t i = 0; i < sizeof(lens) / sizeof(lens[0]); ++i) {
+        serial_fill(data, lens[i], (uint32_t)(10 + i));
+        topic_serial_send(tx, TEST_TOPIC_ID_SERIAL, data, lens[i]);
+    }
+    memset(data, 0xA5, 254);
+    topic_serial_send(tx, TEST_TOPIC_ID_SERIAL, data, 254);
+    int too_long = topic_serial_send(tx, TEST_TOPIC_ID_SERIAL, data, TOPIC_SERIAL_MAX_PAYLOAD + 1);
+    frames = serial_link_deliver(ab, rx, 7);
+    topic_serial_tx_get_stats(tx, &tx_stats);
+    if (frames != 7 || sink.records != 10 || sink.bad != 0 || sink.last_len != 254 || too_long != -1 ||
+        tx_stats.dropped != 1) {
+        os_printf("[topic][SERIAL] 分块解析错误: frames=%u records=%u bad=%u dropped=%u\n", (unsigned)frames,
+                  (unsigned)sink.records, (unsigned)sink.bad, (unsigned)tx_stats.dropped);
+        ret = -1;
+        goto __exit;
+    }
+    uint8_t value[TOPIC_SERIAL_MAX_PAYLOAD];
+    if (obj_dict_get(&remote->dict, TEST_EVENT_ID_SERIAL_REMOTE, value, sizeof(value), NULL, NULL, NULL) != 254 ||
+        memcmp(value, data, 254) != 0) {
+        os_printf("[topic][SERIAL] 接收端对象字典未更新\n");
+        ret = -1;
+        goto __exit;
     }
 
-    test_event_data_t event_data = { .value = 0x12345678, .counter = 0 };
+    /* 篡改一帧的负载字节：CRC错误（按序号也计为丢失）；之前的噪声在下一个0x00处同步；未映射只计数 */
+    static const uint8_t noise[] = { 0x03, 0x11, 0x22, 0x33, 0x44, 0x00, 0x00 };
+    serial_link_write(noise, sizeof(noise), ab);
+    serial_fill(data, 40, 20);
+    topic_serial_send(tx, TEST_TOPIC_ID_SERIAL, data, 40);
+    ab->buf[sizeof(noise) + 10] ^= 0x40;
+    topic_serial_send(tx, TEST_TOPIC_ID_SERIAL_UNMAPPED, data, 40);
+    tx->seq = (uint8_t)(tx->seq + 2);  /* 跳过2个序号模拟丢帧 */
+    serial_fill(data, 40, 21);
+    topic_serial_send(tx, TEST_TOPIC_ID_SERIAL, data, 40);
+    serial_link_deliver(ab, rx, 13);
+    topic_serial_rx_get_stats(rx, &rx_stats);
+    if (sink.records != 11 || sink.last_seq != 21 || rx_stats.crc_errors != 1 || rx_stats.malformed != 1 ||
+        rx_stats.unmapped != 1 || rx_stats.lost != 3) {
+        os_printf("[topic][SERIAL] 错误统计不符: records=%u crc=%u malformed=%u unmapped=%u lost=%u\n",
+                  (unsigned)sink.records, (unsigned)rx_stats.crc_errors, (unsigned)rx_stats.malformed,
+                  (unsigned)rx_stats.unmapped, (unsigned)rx_stats.lost);
+        ret = -1;
+        goto __exit;
+    }
 
-    /* 测量OR规则匹配性能 */
-    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_OR, &event_data, sizeof(event_data), 0);
-    
-    uint64_t start = os_monotonic_time_get_microsecond();
-    for (int i = 0; i < PERF_TEST_LOOPS; ++i) {
-        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_OR);
+    /* 确认模式：丢掉第一轮ACK，超时重传，接收端去重并再次确认 */
+    for (uint32_t i = 0; i < 2; ++i) {
+        serial_fill(data, 40, 30 + i);
+        topic_serial_send(tx_ack, TEST_TOPIC_ID_SERIAL, data, 40);
+    }
+    serial_link_deliver(ab, rx, PERF_TEST_SERIAL_CHUNK);
+    ba->len = 0;
+    size_t pending = topic_serial_tx_pending(tx_ack);
+    os_thread_sleep_ms(TOPIC_SERIAL_ACK_TIMEOUT_MS + 10);
+    size_t retransmits = topic_serial_tx_poll(tx_ack);
+    serial_link_deliver(ab, rx, PERF_TEST_SERIAL_CHUNK);
+    serial_link_deliver(ba, rx_back, PERF_TEST_SERIAL_CHUNK);
+    topic_serial_rx_get_stats(rx, &rx_stats);
+    topic_serial_tx_get_stats(tx_ack, &tx_stats);
+    if (pending != 2 || retransmits != 2 || sink.records != 13 || rx_stats.duplicates != 2 ||
+        tx_stats.acked != 2 || topic_serial_tx_pending(tx_ack) != 0) {
+        os_printf("[topic][SERIAL] 确认重传错误: pending=%u retransmits=%u records=%u duplicates=%u acked=%u\n",
+                  (unsigned)pending, (unsigned)retransmits, (unsigned)sink.records, (unsigned)rx_stats.duplicates,
+                  (unsigned)tx_stats.acked);
+        ret = -1;
+        goto __exit;
     }
-    uint64_t end = os_monotonic_time_get_microsecond();
 
-    double avg_us = (double)(end - start) / PERF_TEST_LOOPS;
-    os_printf("[topic][PERF] OR规则匹配延迟: %.2f us/match\n", avg_us);
+    /* 链路不通：重传次数用尽后计入failed并释放窗口 */
+    topic_serial_send(tx_ack, TEST_TOPIC_ID_SERIAL, data, 40);
+    for (int i = 0; i <= TOPIC_SERIAL_ACK_RETRIES; ++i) {
+        os_thread_sleep_ms(TOPIC_SERIAL_ACK_TIMEOUT_MS + 10);
+        topic_serial_tx_poll(tx_ack);
+        ab->len = 0;
+    }
+    topic_serial_tx_get_stats(tx_ack, &tx_stats);
+    if (tx_stats.failed != 1 || tx_stats.retransmits != 2 + TOPIC_SERIAL_ACK_RETRIES ||
+        topic_serial_tx_pending(tx_ack) != 0) {
+        os_printf("[topic][SERIAL] 重传失败统计错误: failed=%u retransmits=%u\n", (unsigned)tx_stats.failed,
+                  (unsigned)tx_stats.retransmits);
+        ret = -1;
+        goto __exit;
+    }
 
-    /* 测量AND规则匹配性能 */
-    /* 使用静态数组，避免栈上的数组生命周期问题 */
-    static obj_dict_key_t events_and[] = {TEST_EVENT_ID_PERF_RULE_MATCHING_AND_1, 
-                                           TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2, 
-                                           TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3};
-    topic_rule_t rule_and = {
-        .type = TOPIC_RULE_AND,
-        .events = events_and,
-        .event_count = 3,
-    };
-    topic_rule_create(&bus, TEST_TOPIC_ID_PERF_RULE_MATCHING_AND, &rule_and);
-    topic_subscribe(&bus, TEST_TOPIC_ID_PERF_RULE_MATCHING_AND, test_callback, NULL);
+    /* 丢帧使最大序号跨越半个序号空间：跳过的序号的过期位全部清除，序号回绕后的新帧不被误判为重复 */
+    static const uint8_t jump_seqs[] = { 100, 200, 0 };
+    uint32_t records_before = sink.records;
+    for (size_t i = 0; i < sizeof(jump_seqs) / sizeof(jump_seqs[0]); ++i) {
+        tx_ack->seq = jump_seqs[i];
+        serial_fill(data, 40, (uint32_t)(40 + i));
+        topic_serial_send(tx_ack, TEST_TOPIC_ID_SERIAL, data, 40);
+        serial_link_deliver(ab, rx, PERF_TEST_SERIAL_CHUNK);
+        serial_link_deliver(ba, rx_back, PERF_TEST_SERIAL_CHUNK);
+    }
+    topic_serial_rx_get_stats(rx, &rx_stats);
+    if (sink.records - records_before != 3 || rx_stats.duplicates != 2 || topic_serial_tx_pending(tx_ack) != 0) {
+        os_printf("[topic][SERIAL] 丢帧后去重窗口错误: records=%u duplicates=%u\n",
+                  (unsigned)(sink.records - records_before), (unsigned)rx_stats.duplicates);
+        ret = -1;
+        goto __exit;
+    }
+    os_printf("[topic][SERIAL] 分块解析、CRC校验、重新同步、确认重传与去重正确\n");
+
+__exit:
+    topic_serial_tx_deinit(tx);
+    topic_serial_tx_deinit(tx_ack);
+    topic_serial_tx_deinit(tx_back);
+    serial_node_deinit(local);
+    serial_node_deinit(remote);
+    os_free(local);
+    os_free(remote);
+    os_free(ab);
+    os_free(ba);
+    os_free(tx);
+    os_free(tx_ack);
+    os_free(tx_back);
+    os_free(rx);
+    os_free(rx_back);
+    return ret;
+}
 
-    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_1, &event_data, sizeof(event_data), 0);
-    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2, &event_data, sizeof(event_data), 0);
-    obj_dict_set(&dict, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3, &event_data, sizeof(event_data), 0);
+/* 内存流：性能测试中收集编码结果 */
+typedef struct {
+    uint8_t* buf;
+    size_t len;
+    size_t cap;
+} serial_stream_t;
+
+static int serial_stream_write(const uint8_t* data, size_t len, void* user_data) {
+    serial_stream_t* stream = (serial_stream_t*)user_data;
+    if (stream->len + len > stream->cap) return -1;
+    memcpy(stream->buf + stream->len, data, len);
+    stream->len += len;
+    return 0;
+}
 
-    start = os_monotonic_time_get_microsecond();
-    for (int i = 0; i < PERF_TEST_LOOPS / 10; ++i) {
-        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_1);
-        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_2);
-        topic_publish_event(&bus, TEST_EVENT_ID_PERF_RULE_MATCHING_AND_3);
+/* pty写函数：写满时等待可写 */
+static int serial_pty_write(const uint8_t* data, size_t len, void* user_data) {
+    int fd = *(int*)user_data;
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            struct pollfd pfd = { .fd = fd, .events = POLLOUT };
+            if (poll(&pfd, 1, PERF_TEST_SERIAL_WAIT_MS) != 1) return -1;
+            continue;
+        }
+        data += n;
+        len -= (size_t)n;
     }
-    end = os_monotonic_time_get_microsecond();
+    return 0;
+}
 
-    avg_us = (double)(end - start) / (PERF_TEST_LOOPS / 10 * 3);
-    os_printf("[topic][PERF] AND规则匹配延迟: %.2f us/match\n", avg_us);
+/* pty发送线程上下文 */
+typedef struct {
+    topic_serial_tx_t* tx;
+    uint32_t sent;
+} serial_writer_ctx_t;
+
+static void* serial_writer_entry(void* param) {
+    serial_writer_ctx_t* ctx = (serial_writer_ctx_t*)param;
+    uint8_t data[PERF_TEST_SERIAL_PAYLOAD];
+    for (uint32_t i = 0; i < PERF_TEST_SERIAL_FRAMES; ++i) {
+        serial_fill(data, sizeof(data), i);
+        if (topic_serial_send(ctx->tx, TEST_TOPIC_ID_SERIAL, data, sizeof(data)) != 0) break;
+        ctx->sent++;
+    }
+    return NULL;
+}
 
+/*
+ * @brief 打开一对原始模式的pty（master写，slave读），模拟点对点串口
+ * @return 0成功，-1失败
+ */
+static int serial_pty_open(int* master, int* slave) {
+    /* 直接使用/dev/ptmx的ioctl解锁并取得slave编号，不依赖XSI扩展 */
+    *master = open("/dev/ptmx", O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (*master < 0) return -1;
+    int unlock = 0;
+    unsigned int index = 0;
+    char name[32];
+    if (ioctl(*master, TIOCSPTLCK, &unlock) != 0 || ioctl(*master, TIOCGPTN, &index) != 0) {
+        close(*master);
+        return -1;
+    }
+    snprintf(name, sizeof(name), "/dev/pts/%u", index);
+    *slave = open(name, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (*slave < 0) {
+        close(*master);
+        return -1;
+    }
+    struct termios tio;
+    tcgetattr(*slave, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(*slave, TCSANOW, &tio);
     return 0;
 }
 
+/*
+ * @brief 串口帧传输性能测试：pty上的端到端吞吐，以及内存中解析每字节的时钟周期
+ * @return 0成功，-1失败
+ */
+static int test_performance_serial(void) {
+    os_printf("\n[topic][PERF] 串口帧传输测试（pty，%d帧x%dB负载，每次读取%dB）\n", PERF_TEST_SERIAL_FRAMES,
+              PERF_TEST_SERIAL_PAYLOAD, PERF_TEST_SERIAL_CHUNK);
+
+    int master = -1;
+    int slave = -1;
+    if (serial_pty_open(&master, &slave) != 0) {
+        os_printf("[topic][SERIAL] pty不可用，跳过\n");
+        return 0;
+    }
+    serial_node_t* remote = (serial_node_t*)os_malloc(sizeof(serial_node_t));
+    topic_serial_tx_t* tx = (topic_serial_tx_t*)os_malloc(sizeof(topic_serial_tx_t));
+    topic_serial_rx_t* rx = (topic_serial_rx_t*)os_malloc(sizeof(topic_serial_rx_t));
+    size_t stream_cap = (size_t)PERF_TEST_SERIAL_FRAMES * TOPIC_SERIAL_ENCODED_MAX;
+    uint8_t* encoded = (uint8_t*)os_malloc(stream_cap);
+    if (!remote || !tx || !rx || !encoded) {
+        os_free(remote);
+        os_free(tx);
+        os_free(rx);
+        os_free(encoded);
+        close(master);
+        close(slave);
+        return -1;
+    }
+    serial_sink_t sink;
+    memset(&sink, 0, sizeof(sink));
+    serial_node_init(remote, TEST_EVENT_ID_SERIAL_REMOTE, &sink);
+    topic_serial_tx_init(tx, serial_pty_write, &master, 0);
+    topic_serial_rx_init(rx, &remote->bus, serial_map, sizeof(serial_map) / sizeof(serial_map[0]), NULL);
+
+    /* 发送线程写master，本线程从slave按块读取、解析并排空ISR队列 */
+    serial_writer_ctx_t ctx = { .tx = tx, .sent = 0 };
+    ThreadAttr_t attr = { .pName = "serial_tx", .Priority = 5, .StackSize = 4096, .ScheduleType = 0 };
+    uint64_t start = os_monotonic_time_get_microsecond();
+    OsThread_t* writer = os_thread_create(serial_writer_entry, &ctx, &attr);
+    uint8_t chunk[PERF_TEST_SERIAL_CHUNK];
+    while (writer && sink.records < PERF_TEST_SERIAL_FRAMES) {
+        struct pollfd pfd = { .fd = slave, .events = POLLIN };
+        if (poll(&pfd, 1, PERF_TEST_SERIAL_WAIT_MS) != 1) break;
+        ssize_t n = read(slave, chunk, sizeof(chunk));
+        if (n <= 0) continue;
+        topic_serial_rx_feed(rx, chunk, (size_t)n);
+        topic_bus_process_isr_queue(&remote->bus);
+    }
+    uint64_t end = os_monotonic_time_get_microsecond();
+    if (writer) {
+        os_thread_join(writer);
+        os_thread_destroy(writer);
+    }
+    topic_serial_tx_stats_t tx_stats;
+    topic_serial_rx_stats_t rx_stats;
+    topic_serial_tx_get_stats(tx, &tx_stats);
+    topic_serial_rx_get_stats(rx, &rx_stats);
+    uint64_t elapsed = end > start ? end - start : 1;
+    os_printf("[topic][SERIAL] pty: 发送=%u帧/%llu字节, 收到=%u帧, CRC错误=%u, 丢失=%u, 耗时=%llu us, "
+              "吞吐=%.2f MB/s (%.0f 帧/s)\n",
+              (unsigned)ctx.sent, (unsigned long long)tx_stats.bytes, (unsigned)sink.records,
+              (unsigned)rx_stats.crc_errors, (unsigned)rx_stats.lost, (unsigned long long)elapsed,
+              (double)rx_stats.bytes / (double)elapsed, (double)sink.records * 1e6 / (double)elapsed);
+    int ret = 0;
+    if (ctx.sent != PERF_TEST_SERIAL_FRAMES || sink.records != PERF_TEST_SERIAL_FRAMES || sink.bad != 0 ||
+        rx_stats.crc_errors != 0 || rx_stats.lost != 0) {
+        os_printf("[topic][SERIAL] pty传输丢帧或数据错误: bad=%u\n", (unsigned)sink.bad);
+        ret = -1;
+    }
+    close(master);
+    close(slave);
+
+    /* 编码与解析开销：同样的帧编码到内存，再按块喂给只统计不注入的接收端（映射中没有该Topic） */
+    static const topic_serial_map_t parse_map[] = { { TEST_TOPIC_ID_SERIAL_UNMAPPED, TEST_EVENT_ID_SERIAL_REMOTE } };
+    serial_stream_t stream = { .buf = encoded, .len = 0, .cap = stream_cap };
+    topic_serial_tx_deinit(tx);
+    topic_serial_tx_init(tx, serial_stream_write, &stream, 0);
+    topic_serial_rx_init(rx, &remote->bus, parse_map, 1, NULL);
+    uint8_t data[PERF_TEST_SERIAL_PAYLOAD];
+    serial_fill(data, sizeof(data), 0);
+    uint64_t t0 = TOPIC_TRACE_CLOCK();
+    for (uint32_t i = 0; i < PERF_TEST_SERIAL_FRAMES; ++i) {
+        topic_serial_send(tx, TEST_TOPIC_ID_SERIAL, data, sizeof(data));
+    }
+    uint64_t t1 = TOPIC_TRACE_CLOCK();
+    uint64_t us0 = os_monotonic_time_get_microsecond();
+    for (size_t off = 0; off < stream.len; off += PERF_TEST_SERIAL_CHUNK) {
+        size_t n = stream.len - off < PERF_TEST_SERIAL_CHUNK ? stream.len - off : PERF_TEST_SERIAL_CHUNK;
+        topic_serial_rx_feed(rx, stream.buf + off, n);
+    }
+    uint64_t us1 = os_monotonic_time_get_microsecond();
+    uint64_t t2 = TOPIC_TRACE_CLOCK();
+    topic_serial_rx_get_stats(rx, &rx_stats);
+    double bytes = stream.len ? (double)stream.len : 1.0;
+    os_printf("[topic][SERIAL] 内存: %llu字节, 编码=%.1f 周期/字节, 解析=%.1f 周期/字节 (%.1f ns/字节), 帧=%u\n",
+              (unsigned long long)stream.len, (double)(t1 - t0) / bytes, (double)(t2 - t1) / bytes,
+              (double)(us1 - us0) * 1000.0 / bytes, (unsigned)rx_stats.unmapped);
+    if (rx_stats.unmapped != PERF_TEST_SERIAL_FRAMES || rx_stats.crc_errors != 0) {
+        os_printf("[topic][SERIAL] 内存解析帧数错误\n");
+        ret = -1;
+    }
+
+    topic_serial_tx_deinit(tx);
+    serial_node_deinit(remote);
+    os_free(remote);
+    os_free(tx);
+    os_free(rx);
+    os_free(encoded);
+    return ret;
+}
+#endif
+
 /* ---------------- 主测试入口 ---------------- */
 
 /*
@@ -1129,6 +5591,11 @@ int topic_bus_perf_test_main(void) {
         return -1;
     }
 
+    if (test_rule_extended() != 0) {
+        os_printf("[topic] 扩展规则测试失败\n");
+        return -1;
+    }
+
     /* ========== 阶段2：新功能测试（P1） ========== */
     os_printf("\n--- 阶段2：新功能测试 ---\n");
 
@@ -1143,6 +5610,13 @@ int topic_bus_perf_test_main(void) {
         os_printf("[topic] Server性能统计测试失败\n");
         return -1;
     }
+
+#if TOPIC_BUS_ENABLE_ISR
+    if (test_server_drain_coalesce() != 0) {
+        os_printf("[topic] Server批量合并排空测试失败\n");
+        return -1;
+    }
+#endif
 #endif
 #endif
 
@@ -1160,6 +5634,15 @@ int topic_bus_perf_test_main(void) {
     if (test_router_vfb() != 0) {
         os_printf("[topic] VFB Router测试失败（可选）\n");
     }
+
+    if (test_router_batch() != 0) {
+        os_printf("[topic] 批量Router测试失败\n");
+        return -1;
+    }
+    if (test_router_churn() != 0) {
+        os_printf("[topic] 并发增删Router测试失败\n");
+        return -1;
+    }
 #endif
 
 #if TOPIC_BUS_ENABLE_ISR
@@ -1167,6 +5650,25 @@ int topic_bus_perf_test_main(void) {
         os_printf("[topic] ISR发布测试失败\n");
         return -1;
     }
+
+    if (test_isr_multi_producer() != 0) {
+        os_printf("[topic] 多生产者并发ISR发布测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_HIST
+    if (test_hist() != 0) {
+        os_printf("[topic] 延迟直方图测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_TRACE
+    if (test_trace() != 0) {
+        os_printf("[topic] 二进制事件跟踪测试失败\n");
+        return -1;
+    }
 #endif
 
     /* ========== 阶段3：性能测试（P1） ========== */
@@ -1187,11 +5689,172 @@ int topic_bus_perf_test_main(void) {
         return -1;
     }
 
+    if (test_performance_timeout_and() != 0) {
+        os_printf("[topic] AND规则时效快照性能测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_rule_filter() != 0) {
+        os_printf("[topic] 回调风暴抑制性能测试失败\n");
+        return -1;
+    }
+
+#if TOPIC_BUS_ENABLE_HIST
+    if (test_performance_hist() != 0) {
+        os_printf("[topic] 延迟直方图开销测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_TRACE
+    if (test_performance_trace() != 0) {
+        os_printf("[topic] 二进制事件跟踪开销测试失败\n");
+        return -1;
+    }
+#endif
+
     if (test_concurrent_high() != 0) {
         os_printf("[topic] 高并发测试失败\n");
         return -1;
     }
 
+    if (test_concurrent_subscriber_churn() != 0) {
+        os_printf("[topic] 订阅者并发变更压力测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_topic_scaling() != 0) {
+        os_printf("[topic] Topic数量扩展性测试失败\n");
+        return -1;
+    }
+
+#if TOPIC_BUS_ENABLE_ROUTER
+    if (test_performance_router() != 0) {
+        os_printf("[topic] Router性能测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_SERVER && TOPIC_BUS_ENABLE_STATS && TOPIC_BUS_ENABLE_ISR
+    if (test_performance_isr_drain() != 0) {
+        os_printf("[topic] ISR突发排空开销测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_isr_latency() != 0) {
+        os_printf("[topic] ISR到回调端到端延迟测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_LOAN
+    if (test_loan_publish() != 0) {
+        os_printf("[topic] 借出缓冲发布测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_loan_publish() != 0) {
+        os_printf("[topic] 大负载发布开销对比测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    if (test_executor_async() != 0) {
+        os_printf("[topic] 异步订阅执行器测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_executor() != 0) {
+        os_printf("[topic] 慢订阅者发布开销对比测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    if (test_static_table() != 0) {
+        os_printf("[topic] 静态Topic表测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_static_table() != 0) {
+        os_printf("[topic] 静态Topic表开销对比测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_HISTORY
+    if (test_history() != 0) {
+        os_printf("[topic] Topic历史测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_history() != 0) {
+        os_printf("[topic] Topic历史开销测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+    if (test_range_subscribe() != 0) {
+        os_printf("[topic] 范围订阅测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_range() != 0) {
+        os_printf("[topic] 范围订阅性能测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_RECORD
+    if (test_record_replay() != 0) {
+        os_printf("[topic] 流量录制与回放测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_record() != 0) {
+        os_printf("[topic] 流量录制与回放性能测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_SHM
+    if (test_shm() != 0) {
+        os_printf("[topic] 共享内存总线功能测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_shm() != 0) {
+        os_printf("[topic] 共享内存多进程总线测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_BRIDGE
+    if (test_bridge() != 0) {
+        os_printf("[topic] UDP桥接功能测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_bridge() != 0) {
+        os_printf("[topic] 跨进程UDP桥接测试失败\n");
+        return -1;
+    }
+#endif
+
+#if TOPIC_BUS_ENABLE_SERIAL
+    if (test_serial() != 0) {
+        os_printf("[topic] 串口帧传输功能测试失败\n");
+        return -1;
+    }
+
+    if (test_performance_serial() != 0) {
+        os_printf("[topic] 串口帧传输性能测试失败\n");
+        return -1;
+    }
+#endif
+
     os_printf("\n========== TopicBus 完整测试完成 ==========\n\n");
     return 0;
 }
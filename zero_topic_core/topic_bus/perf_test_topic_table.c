@@ -0,0 +1,79 @@
+/*
+ * 自动生成，请勿手动修改
+ * 来源: perf_test_topic_table.json
+ * 生成: python3 tool/gen_topic_table.py perf_test_topic_table.json -o <目录>
+ */
+
+#include "perf_test_topic_table.h"
+
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+
+/* 静态订阅者回调 */
+extern void perf_test_static_table_callback(uint16_t topic_id, const void* data, size_t data_len, void* user);
+
+/* 规则事件、超时与静态订阅者（只读） */
+static const obj_dict_key_t perf_test_topic_table_events_0[] = { 1500U, 1501U };
+static const topic_subscription_t perf_test_topic_table_subs_0[] = { { .callback = perf_test_static_table_callback, .user_data = NULL } };
+static const obj_dict_key_t perf_test_topic_table_events_1[] = { 1502U, 1503U };
+static const uint32_t perf_test_topic_table_timeouts_1[] = { 3000U, 3000U };
+static const topic_subscription_t perf_test_topic_table_subs_1[] = { { .callback = perf_test_static_table_callback, .user_data = NULL } };
+static const obj_dict_key_t perf_test_topic_table_events_2[] = { 1504U };
+static const topic_subscription_t perf_test_topic_table_subs_2[] = { { .callback = perf_test_static_table_callback, .user_data = NULL } };
+static const obj_dict_key_t perf_test_topic_table_events_3[] = { 1501U, 1505U };
+static const obj_dict_key_t perf_test_topic_table_events_4[] = { 1506U, 1501U, 1506U };
+static const topic_subscription_t perf_test_topic_table_subs_4[] = { { .callback = perf_test_static_table_callback, .user_data = NULL } };
+
+/* 规则事件时效快照（运行期写入） */
+static uint64_t perf_test_topic_table_ts_0[2];
+static uint64_t perf_test_topic_table_ts_1[2];
+static uint64_t perf_test_topic_table_ts_3[2];
+static uint64_t perf_test_topic_table_ts_4[3];
+
+/* Topic条目（运行期字段由topic_bus_init_static重置） */
+static topic_entry_t perf_test_topic_table_topics[5] = {
+    { .topic_id = 1, .rule = { .type = TOPIC_RULE_OR, .events = (obj_dict_key_t*)perf_test_topic_table_events_0, .event_count = 2, .event_timeouts_ms = NULL, .event_ts_us = perf_test_topic_table_ts_0 }, .static_subs = perf_test_topic_table_subs_0, .static_sub_count = 1 },
+    { .topic_id = 7, .rule = { .type = TOPIC_RULE_AND, .events = (obj_dict_key_t*)perf_test_topic_table_events_1, .event_count = 2, .event_timeouts_ms = (uint32_t*)perf_test_topic_table_timeouts_1, .event_ts_us = perf_test_topic_table_ts_1 }, .static_subs = perf_test_topic_table_subs_1, .static_sub_count = 1 },
+    { .topic_id = 3, .rule = { .type = TOPIC_RULE_MANUAL, .events = (obj_dict_key_t*)perf_test_topic_table_events_2, .event_count = 1, .event_timeouts_ms = NULL, .event_ts_us = NULL }, .static_subs = perf_test_topic_table_subs_2, .static_sub_count = 1 },
+    { .topic_id = 40, .rule = { .type = TOPIC_RULE_OR, .events = (obj_dict_key_t*)perf_test_topic_table_events_3, .event_count = 2, .event_timeouts_ms = NULL, .event_ts_us = perf_test_topic_table_ts_3 }, .static_subs = NULL, .static_sub_count = 0 },
+    { .topic_id = 120, .rule = { .type = TOPIC_RULE_OR, .events = (obj_dict_key_t*)perf_test_topic_table_events_4, .event_count = 3, .event_timeouts_ms = NULL, .event_ts_us = perf_test_topic_table_ts_4 }, .static_subs = perf_test_topic_table_subs_4, .static_sub_count = 1 },
+};
+
+/* event_key -> Topic索引节点 */
+static const topic_event_link_t perf_test_topic_table_links[8] = {
+    { .event_key = 1500U, .entry = &perf_test_topic_table_topics[0], .event_index = 0, .next = NULL },
+    { .event_key = 1501U, .entry = &perf_test_topic_table_topics[0], .event_index = 1, .next = (topic_event_link_t*)&perf_test_topic_table_links[2] },
+    { .event_key = 1501U, .entry = &perf_test_topic_table_topics[3], .event_index = 0, .next = (topic_event_link_t*)&perf_test_topic_table_links[3] },
+    { .event_key = 1501U, .entry = &perf_test_topic_table_topics[4], .event_index = 1, .next = NULL },
+    { .event_key = 1502U, .entry = &perf_test_topic_table_topics[1], .event_index = 0, .next = NULL },
+    { .event_key = 1503U, .entry = &perf_test_topic_table_topics[1], .event_index = 1, .next = NULL },
+    { .event_key = 1505U, .entry = &perf_test_topic_table_topics[3], .event_index = 1, .next = NULL },
+    { .event_key = 1506U, .entry = &perf_test_topic_table_topics[4], .event_index = 0, .next = NULL },
+};
+
+/* event_key索引桶（完美散列：乘数0x9E3779B1U，3位） */
+static topic_event_link_t* const perf_test_topic_table_event_index[8] = {
+    [0] = (topic_event_link_t*)&perf_test_topic_table_links[0],
+    [1] = (topic_event_link_t*)&perf_test_topic_table_links[6],
+    [2] = (topic_event_link_t*)&perf_test_topic_table_links[4],
+    [5] = (topic_event_link_t*)&perf_test_topic_table_links[1],
+    [6] = (topic_event_link_t*)&perf_test_topic_table_links[7],
+    [7] = (topic_event_link_t*)&perf_test_topic_table_links[5],
+};
+
+/* topic_id -> 槽位+1（完美散列：乘数0x9E3779B1U，3位） */
+static const uint32_t perf_test_topic_table_topic_index[8] = {
+    0U, 5U, 2U, 0U, 1U, 4U, 3U, 0U,
+};
+
+const topic_static_table_t perf_test_topic_table = {
+    .topics = perf_test_topic_table_topics,
+    .topic_count = 5,
+    .event_index = perf_test_topic_table_event_index,
+    .event_index_bits = 3,
+    .event_hash_mul = 0x9E3779B1U,
+    .topic_index = perf_test_topic_table_topic_index,
+    .topic_index_bits = 3,
+    .topic_hash_mul = 0x9E3779B1U,
+};
+
+#endif /* TOPIC_BUS_ENABLE_STATIC_TABLE */
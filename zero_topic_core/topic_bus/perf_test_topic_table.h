@@ -0,0 +1,26 @@
+/*
+ * 自动生成，请勿手动修改
+ * 来源: perf_test_topic_table.json
+ * 生成: python3 tool/gen_topic_table.py perf_test_topic_table.json -o <目录>
+ */
+
+#ifndef PERF_TEST_TOPIC_TABLE_H_
+#define PERF_TEST_TOPIC_TABLE_H_
+
+#include "topic_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+#define PERF_TEST_TOPIC_TABLE_TOPIC_COUNT 5
+
+extern const topic_static_table_t perf_test_topic_table;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PERF_TEST_TOPIC_TABLE_H_ */
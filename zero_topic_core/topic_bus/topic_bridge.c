@@ -0,0 +1,449 @@
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "topic_bridge.h"
+#include "../../Rte/inc/os_timestamp.h"
+
+#if TOPIC_BUS_ENABLE_BRIDGE
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static void __le_put(uint8_t* p, uint64_t v, size_t n);
+static uint64_t __le_get(const uint8_t* p, size_t n);
+static void __hdr_encode(uint8_t* p, const topic_bridge_hdr_t* hdr);
+static void __hdr_decode(const uint8_t* p, topic_bridge_hdr_t* hdr);
+static int __tx_flush(const void* batch, size_t len, size_t count, void* user_data);
+static int __rx_event_key(const topic_bridge_rx_t* rx, uint16_t topic_id, obj_dict_key_t* key);
+static void __rx_track_seq(topic_bridge_rx_t* rx, uint16_t node_id, uint32_t seq);
+static int __rx_datagram(topic_bridge_rx_t* rx, size_t len, int loopback);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/*
+ * @brief 按小端写入n字节整数
+ * @param p 输出位置
+ * @param v 数值
+ * @param n 字节数
+ */
+static void __le_put(uint8_t* p, uint64_t v, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        p[i] = (uint8_t)(v >> (8U * i));
+    }
+}
+
+/*
+ * @brief 按小端读取n字节整数
+ * @param p 输入位置
+ * @param n 字节数
+ * @return 数值
+ */
+static uint64_t __le_get(const uint8_t* p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v |= (uint64_t)p[i] << (8U * i);
+    }
+    return v;
+}
+
+/*
+ * @brief 编码报文头（TOPIC_BRIDGE_HDR_SIZE字节，小端）
+ * @param p 输出位置
+ * @param hdr 报文头
+ */
+static void __hdr_encode(uint8_t* p, const topic_bridge_hdr_t* hdr) {
+    __le_put(p + 0, hdr->magic, 2);
+    p[2] = hdr->version;
+    p[3] = hdr->reserved;
+    __le_put(p + 4, hdr->node_id, 2);
+    __le_put(p + 6, hdr->count, 2);
+    __le_put(p + 8, hdr->seq, 4);
+    __le_put(p + 12, hdr->len, 4);
+    __le_put(p + 16, hdr->ts_us, 8);
+}
+
+/*
+ * @brief 解码报文头
+ * @param p 输入位置（至少TOPIC_BRIDGE_HDR_SIZE字节）
+ * @param hdr 输出报文头
+ */
+static void __hdr_decode(const uint8_t* p, topic_bridge_hdr_t* hdr) {
+    hdr->magic = (uint16_t)__le_get(p + 0, 2);
+    hdr->version = p[2];
+    hdr->reserved = p[3];
+    hdr->node_id = (uint16_t)__le_get(p + 4, 2);
+    hdr->count = (uint16_t)__le_get(p + 6, 2);
+    hdr->seq = (uint32_t)__le_get(p + 8, 4);
+    hdr->len = (uint32_t)__le_get(p + 12, 4);
+    hdr->ts_us = __le_get(p + 16, 8);
+}
+
+/*
+ * @brief 批量sink的发送函数：在记录区前补上报文头，整体发送一次
+ * @param batch 记录区（位于tx->dgram的报文头之后）
+ * @param len 记录区长度
+ * @param count 记录数
+ * @param user_data 发送端
+ * @return 0成功，-1失败
+ */
+static int __tx_flush(const void* batch, size_t len, size_t count, void* user_data) {
+    topic_bridge_tx_t* tx = (topic_bridge_tx_t*)user_data;
+    (void)batch;
+
+    topic_bridge_hdr_t hdr = {
+        .magic = TOPIC_BRIDGE_MAGIC,
+        .version = TOPIC_BRIDGE_VERSION,
+        .node_id = tx->node_id,
+        .count = (uint16_t)count,
+        .seq = tx->seq++,
+        .len = (uint32_t)len,
+        .ts_us = os_monotonic_time_get_microsecond(),
+    };
+    __hdr_encode(tx->dgram, &hdr);
+
+    size_t total = TOPIC_BRIDGE_HDR_SIZE + len;
+    ssize_t sent = sendto(tx->sock, tx->dgram, total, 0, (const struct sockaddr*)&tx->addr, sizeof(tx->addr));
+    if (sent != (ssize_t)total) {
+        tx->stats.errors++;
+        return -1;
+    }
+    tx->stats.datagrams++;
+    tx->stats.records += count;
+    tx->stats.bytes += total;
+    return 0;
+}
+
+/*
+ * @brief 初始化发送端
+ * @param tx 发送端
+ * @param addr 目的IPv4地址
+ * @param port 目的端口
+ * @param node_id 本节点ID
+ * @param max_records 每个报文最多的记录数
+ * @return 0成功，-1失败
+ */
+int topic_bridge_tx_init(topic_bridge_tx_t* tx, const char* addr, uint16_t port, uint16_t node_id,
+                         size_t max_records) {
+    if (!tx || !addr || max_records > 0xFFFFU) return -1;
+
+    memset(tx, 0, sizeof(*tx));
+    tx->addr.sin_family = AF_INET;
+    tx->addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, addr, &tx->addr.sin_addr) != 1) return -1;
+    tx->node_id = node_id;
+
+    tx->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (tx->sock < 0) return -1;
+    if (IN_MULTICAST(ntohl(tx->addr.sin_addr.s_addr))) {
+        /* 组播限制在本网段，并允许同一主机上的接收端收到 */
+        unsigned char ttl = 1;
+        unsigned char loop = 1;
+        setsockopt(tx->sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+        setsockopt(tx->sock, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+    }
+
+    /* 批量sink直接在报文缓冲的记录区汇聚，发送时无需再拷贝 */
+    if (topic_router_batch_init(&tx->batch, tx->dgram + TOPIC_BRIDGE_HDR_SIZE,
+                                sizeof(tx->dgram) - TOPIC_BRIDGE_HDR_SIZE, max_records,
+                                __tx_flush, tx) != 0) {
+        close(tx->sock);
+        tx->sock = -1;
+        return -1;
+    }
+    return 0;
+}
+
+/*
+ * @brief 释放发送端
+ * @param tx 发送端
+ * @return 0成功，-1失败
+ */
+int topic_bridge_tx_deinit(topic_bridge_tx_t* tx) {
+    if (!tx) return -1;
+    /* 先从Router移除并等待宽限期，之后不再有route/flush经本发送端sendto */
+    if (topic_router_batch_deinit(&tx->batch) != 0) return -1;
+    if (tx->sock >= 0) {
+        close(tx->sock);
+        tx->sock = -1;
+    }
+    return 0;
+}
+
+/*
+ * @brief 把Topic登记到发送端
+ * @param tx 发送端
+ * @param router Topic Router
+ * @param topic_id Topic ID
+ * @return 0成功，-1失败
+ */
+int topic_bridge_tx_add(topic_bridge_tx_t* tx, topic_router_t* router, uint16_t topic_id) {
+    if (!tx || !router) return -1;
+    return topic_router_add_batch(router, topic_id, &tx->batch);
+}
+
+/*
+ * @brief 立即发送已汇聚的记录
+ * @param tx 发送端
+ * @return 本次发送的记录数
+ */
+size_t topic_bridge_tx_flush(topic_bridge_tx_t* tx) {
+    if (!tx) return 0;
+    return topic_router_batch_flush(&tx->batch);
+}
+
+/*
+ * @brief 获取发送端统计
+ * @param tx 发送端
+ * @param stats 输出统计
+ */
+void topic_bridge_tx_get_stats(topic_bridge_tx_t* tx, topic_bridge_tx_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!tx || !tx->batch.lock) return;
+    if (os_semaphore_take(tx->batch.lock, 100) < 0) return;
+    *stats = tx->stats;
+    stats->dropped = tx->batch.dropped;
+    os_semaphore_give(tx->batch.lock);
+}
+
+/*
+ * @brief 查找Topic对应的本地事件键
+ * @param rx 接收端
+ * @param topic_id 报文中的Topic ID
+ * @param key 输出事件键
+ * @return 0成功，-1没有映射
+ */
+static int __rx_event_key(const topic_bridge_rx_t* rx, uint16_t topic_id, obj_dict_key_t* key) {
+    if (!rx->map) {
+        *key = (obj_dict_key_t)topic_id;
+        return 0;
+    }
+    for (size_t i = 0; i < rx->map_count; ++i) {
+        if (rx->map[i].topic_id == topic_id) {
+            *key = rx->map[i].event_key;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * @brief 按发送节点跟踪报文序号，统计丢失与乱序
+ * @param rx 接收端
+ * @param node_id 发送节点
+ * @param seq 报文序号
+ */
+static void __rx_track_seq(topic_bridge_rx_t* rx, uint16_t node_id, uint32_t seq) {
+    topic_bridge_node_t* node = NULL;
+    for (size_t i = 0; i < TOPIC_BRIDGE_MAX_NODES; ++i) {
+        topic_bridge_node_t* n = &rx->nodes[i];
+        if (n->valid && n->node_id == node_id) {
+            node = n;
+            break;
+        }
+        if (!n->valid && !node) node = n;
+    }
+    if (!node) return;  /* 节点数超过跟踪上限：只注入不统计 */
+
+    if (!node->valid) {
+        /* 首个报文：从该序号开始跟踪（接收端晚于发送端启动时不计丢失） */
+        node->valid = 1;
+        node->node_id = node_id;
+        node->next_seq = seq + 1U;
+        return;
+    }
+    int32_t diff = (int32_t)(seq - node->next_seq);
+    if (diff >= 0) {
+        rx->stats.lost += (uint32_t)diff;
+        node->next_seq = seq + 1U;
+    } else {
+        rx->stats.reordered++;
+    }
+}
+
+/*
+ * @brief 解析一个报文并注入本地总线
+ * @param rx 接收端
+ * @param len 报文长度
+ * @param loopback 非0表示报文来自本机回环地址
+ * @return 注入的记录数
+ */
+static int __rx_datagram(topic_bridge_rx_t* rx, size_t len, int loopback) {
+    topic_bridge_hdr_t hdr;
+    if (len < TOPIC_BRIDGE_HDR_SIZE) {
+        rx->stats.malformed++;
+        return 0;
+    }
+    __hdr_decode(rx->dgram, &hdr);
+    if (hdr.magic != TOPIC_BRIDGE_MAGIC || hdr.version != TOPIC_BRIDGE_VERSION ||
+        hdr.len != len - TOPIC_BRIDGE_HDR_SIZE) {
+        rx->stats.malformed++;
+        return 0;
+    }
+
+    rx->stats.datagrams++;
+    rx->stats.bytes += len;
+    __rx_track_seq(rx, hdr.node_id, hdr.seq);
+#if TOPIC_BUS_ENABLE_HIST
+    /* 时间戳是发送端的单调时钟，只有同一主机上的两端可以相减 */
+    if (loopback) {
+        uint64_t now = os_monotonic_time_get_microsecond();
+        topic_hist_record(&rx->delay, (now > hdr.ts_us) ? now - hdr.ts_us : 0);
+    }
+#else
+    (void)loopback;
+#endif
+
+    const uint8_t* records = rx->dgram + TOPIC_BRIDGE_HDR_SIZE;
+    size_t offset = 0;
+    size_t parsed = 0;
+    int injected = 0;
+    uint16_t topic_id;
+    const void* data;
+    size_t data_len;
+    while (topic_router_batch_next(records, hdr.len, &offset, &topic_id, &data, &data_len) == 0) {
+        parsed++;
+        obj_dict_key_t key;
+        if (__rx_event_key(rx, topic_id, &key) != 0) {
+            rx->stats.unmapped++;
+            continue;
+        }
+        if (obj_dict_set(rx->bus->obj_dict, key, data, data_len, 0) != 0) {
+            rx->stats.inject_errors++;
+            continue;
+        }
+        topic_publish_event(rx->bus, key);
+        injected++;
+    }
+    if (parsed != hdr.count) {
+        rx->stats.malformed++;
+    }
+    rx->stats.records += (uint64_t)injected;
+    return injected;
+}
+
+/*
+ * @brief 初始化接收端
+ * @param rx 接收端
+ * @param bus 注入的本地总线
+ * @param addr 绑定的IPv4地址
+ * @param port 监听端口
+ * @param map Topic映射
+ * @param map_count 映射条数
+ * @return 0成功，-1失败
+ */
+int topic_bridge_rx_init(topic_bridge_rx_t* rx, topic_bus_t* bus, const char* addr, uint16_t port,
+                         const topic_bridge_map_t* map, size_t map_count) {
+    if (!rx || !bus || !bus->obj_dict || (!map && map_count > 0)) return -1;
+
+    memset(rx, 0, sizeof(*rx));
+    rx->bus = bus;
+    rx->map = map;
+    rx->map_count = map_count;
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_reset(&rx->delay);
+#endif
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_port = htons(port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    struct in_addr group = { .s_addr = htonl(INADDR_ANY) };
+    if (addr && inet_pton(AF_INET, addr, &group) != 1) return -1;
+    int multicast = IN_MULTICAST(ntohl(group.s_addr));
+    if (!multicast) local.sin_addr = group;
+
+    rx->sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (rx->sock < 0) return -1;
+    int opt = 1;
+    setsockopt(rx->sock, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    opt = TOPIC_BRIDGE_RCVBUF;
+    setsockopt(rx->sock, SOL_SOCKET, SO_RCVBUF, &opt, sizeof(opt));
+    if (bind(rx->sock, (const struct sockaddr*)&local, sizeof(local)) != 0) goto __error;
+
+    if (multicast) {
+        struct ip_mreq mreq;
+        mreq.imr_multiaddr = group;
+        mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (setsockopt(rx->sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) != 0) goto __error;
+    }
+    return 0;
+
+__error:
+    close(rx->sock);
+    rx->sock = -1;
+    return -1;
+}
+
+/*
+ * @brief 释放接收端
+ * @param rx 接收端
+ * @return 0成功，-1失败
+ */
+int topic_bridge_rx_deinit(topic_bridge_rx_t* rx) {
+    if (!rx) return -1;
+    if (rx->sock >= 0) {
+        close(rx->sock);
+        rx->sock = -1;
+    }
+    return 0;
+}
+
+/*
+ * @brief 接收并注入报文
+ * @param rx 接收端
+ * @param timeout_ms 最长等待时间（毫秒）
+ * @return 本次注入的记录数，-1表示socket错误
+ */
+int topic_bridge_rx_poll(topic_bridge_rx_t* rx, uint32_t timeout_ms) {
+    if (!rx || rx->sock < 0) return -1;
+
+    if (timeout_ms > 0) {
+        struct pollfd pfd = { .fd = rx->sock, .events = POLLIN };
+        int ready = poll(&pfd, 1, (int)timeout_ms);
+        if (ready < 0) return (errno == EINTR) ? 0 : -1;
+        if (ready == 0) return 0;
+    }
+
+    /* 一次唤醒处理socket中已排队的全部报文 */
+    int injected = 0;
+    for (;;) {
+        struct sockaddr_in src;
+        socklen_t src_len = sizeof(src);
+        ssize_t len = recvfrom(rx->sock, rx->dgram, sizeof(rx->dgram), MSG_DONTWAIT | MSG_TRUNC,
+                               (struct sockaddr*)&src, &src_len);
+        if (len < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) break;
+            return -1;
+        }
+        if ((size_t)len > sizeof(rx->dgram)) {
+            rx->stats.malformed++;  /* 超过TOPIC_BRIDGE_MTU被截断 */
+            continue;
+        }
+        int loopback = (src_len >= sizeof(src) && src.sin_family == AF_INET &&
+                        (ntohl(src.sin_addr.s_addr) >> 24) == IN_LOOPBACKNET);
+        injected += __rx_datagram(rx, (size_t)len, loopback);
+    }
+    return injected;
+}
+
+/*
+ * @brief 获取接收端统计
+ * @param rx 接收端
+ * @param stats 输出统计
+ */
+void topic_bridge_rx_get_stats(topic_bridge_rx_t* rx, topic_bridge_rx_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!rx) return;
+    *stats = rx->stats;
+}
+
+#endif /* TOPIC_BUS_ENABLE_BRIDGE */
@@ -0,0 +1,190 @@
+#ifndef TOPIC_BRIDGE_H_
+#define TOPIC_BRIDGE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "topic_bus_config.h"
+#include "topic_bus.h"
+#include "topic_router.h"
+#include "topic_hist.h"
+#if TOPIC_BUS_ENABLE_BRIDGE
+#include <netinet/in.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_BRIDGE
+
+/*
+ * UDP桥接：把一个节点上触发的Topic转发到其他节点的topic_bus
+ *   发送端是一个批量Router sink：登记的Topic触发时负载汇聚到报文缓冲，报文满、达到条数上限
+ *   或flush时加上报文头整体sendto一次（单播或组播）
+ *   接收端按topic_id -> event_key映射，以obj_dict_set + topic_publish_event注入本地总线
+ *
+ * 报文格式（全部字段按小端逐字节编解码，与主机字节序和结构体布局无关）：
+ *   TOPIC_BRIDGE_HDR_SIZE字节报文头 + 若干条记录，记录为topic_router_batch_hdr_t{topic_id, len} + 负载，按4字节对齐
+ *   报文头依次为magic(2) version(1) reserved(1) node_id(2) count(2) seq(4) len(4) ts_us(8)
+ */
+
+#define TOPIC_BRIDGE_MAGIC   0x5A42U    /* "ZB" */
+#define TOPIC_BRIDGE_VERSION 1U
+#define TOPIC_BRIDGE_HDR_SIZE 24U       /* 报文头在线上的字节数 */
+
+/* 报文头（解码后的主机表示，线上格式见上） */
+typedef struct {
+    uint16_t magic;                     /* TOPIC_BRIDGE_MAGIC */
+    uint8_t version;                    /* TOPIC_BRIDGE_VERSION */
+    uint8_t reserved;
+    uint16_t node_id;                   /* 发送节点 */
+    uint16_t count;                     /* 记录数 */
+    uint32_t seq;                       /* 报文序号（每个发送端从0递增） */
+    uint32_t len;                       /* 记录区长度 */
+    uint64_t ts_us;                     /* 发送时间（发送端单调时钟，微秒） */
+} topic_bridge_hdr_t;
+
+/* 接收端Topic映射 */
+typedef struct {
+    uint16_t topic_id;                  /* 报文中的Topic ID */
+    obj_dict_key_t event_key;           /* 注入本地总线使用的事件键 */
+} topic_bridge_map_t;
+
+/* 发送端统计 */
+typedef struct {
+    uint64_t datagrams;                 /* 发出的报文数 */
+    uint64_t records;                   /* 发出的记录数 */
+    uint64_t bytes;                     /* 发出的字节数（含报文头） */
+    uint64_t errors;                    /* sendto失败的报文数 */
+    uint32_t dropped;                   /* 超长或发送失败而丢弃的记录数 */
+} topic_bridge_tx_stats_t;
+
+/* 接收端统计 */
+typedef struct {
+    uint64_t datagrams;                 /* 收到的有效报文数 */
+    uint64_t records;                   /* 注入的记录数 */
+    uint64_t bytes;                     /* 收到的字节数 */
+    uint64_t lost;                      /* 按序号推算丢失的报文数 */
+    uint64_t reordered;                 /* 序号回退（乱序或重复）的报文数 */
+    uint64_t malformed;                 /* 格式错误的报文数 */
+    uint64_t unmapped;                  /* 没有映射的记录数 */
+    uint64_t inject_errors;             /* obj_dict_set失败的记录数 */
+} topic_bridge_rx_stats_t;
+
+/* 发送端 */
+typedef struct {
+    int sock;                           /* UDP socket */
+    struct sockaddr_in addr;            /* 目的地址 */
+    uint16_t node_id;                   /* 本节点ID */
+    uint32_t seq;                       /* 下一个报文序号 */
+    topic_router_batch_t batch;         /* 汇聚记录的批量sink（缓冲为dgram的记录区） */
+    topic_bridge_tx_stats_t stats;      /* 统计（在batch锁内更新） */
+    uint8_t dgram[TOPIC_BRIDGE_MTU];    /* 报文缓冲：报文头 + 记录区 */
+} topic_bridge_tx_t;
+
+/* 接收端跟踪的发送节点 */
+typedef struct {
+    uint16_t node_id;
+    uint8_t valid;
+    uint32_t next_seq;                  /* 期望的下一个序号 */
+} topic_bridge_node_t;
+
+/* 接收端 */
+typedef struct {
+    int sock;                           /* UDP socket */
+    topic_bus_t* bus;                   /* 注入的本地总线 */
+    const topic_bridge_map_t* map;      /* Topic映射（NULL表示event_key = topic_id） */
+    size_t map_count;
+    topic_bridge_node_t nodes[TOPIC_BRIDGE_MAX_NODES];
+    topic_bridge_rx_stats_t stats;      /* 统计（仅由poll线程更新） */
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_t delay;                 /* 发送到注入的单程延迟：只统计来自本机回环地址的报文（两端同一时钟） */
+#endif
+    uint8_t dgram[TOPIC_BRIDGE_MTU];    /* 接收缓冲 */
+} topic_bridge_rx_t;
+
+/*
+ * @brief 初始化发送端
+ * @param tx 发送端
+ * @param addr 目的IPv4地址（单播或组播，组播时TTL为1并开启本机回环）
+ * @param port 目的端口
+ * @param node_id 本节点ID（接收端按节点跟踪序号）
+ * @param max_records 每个报文最多的记录数（0表示只按报文长度，1表示不合并）
+ * @return 0成功，-1失败
+ */
+int topic_bridge_tx_init(topic_bridge_tx_t* tx, const char* addr, uint16_t port, uint16_t node_id,
+                         size_t max_records);
+
+/*
+ * @brief 释放发送端（未发送的记录被丢弃，需要时先flush；登记过的Topic随之从Router移除）
+ * @param tx 发送端
+ * @return 0成功，-1失败
+ */
+int topic_bridge_tx_deinit(topic_bridge_tx_t* tx);
+
+/*
+ * @brief 把Topic登记到发送端（在Router中添加批量Router）
+ * @param tx 发送端
+ * @param router Topic Router
+ * @param topic_id Topic ID
+ * @return 0成功，-1失败
+ */
+int topic_bridge_tx_add(topic_bridge_tx_t* tx, topic_router_t* router, uint16_t topic_id);
+
+/*
+ * @brief 立即发送已汇聚的记录（Topic Server每轮自动通过topic_router_flush发送）
+ * @param tx 发送端
+ * @return 本次发送的记录数
+ */
+size_t topic_bridge_tx_flush(topic_bridge_tx_t* tx);
+
+/*
+ * @brief 获取发送端统计
+ * @param tx 发送端
+ * @param stats 输出统计
+ */
+void topic_bridge_tx_get_stats(topic_bridge_tx_t* tx, topic_bridge_tx_stats_t* stats);
+
+/*
+ * @brief 初始化接收端
+ * @param rx 接收端
+ * @param bus 注入的本地总线（需已关联对象字典）
+ * @param addr 绑定的IPv4地址（NULL表示任意地址；组播地址时绑定任意地址并加入该组）
+ * @param port 监听端口
+ * @param map Topic映射（NULL表示event_key = topic_id）
+ * @param map_count 映射条数
+ * @return 0成功，-1失败
+ */
+int topic_bridge_rx_init(topic_bridge_rx_t* rx, topic_bus_t* bus, const char* addr, uint16_t port,
+                         const topic_bridge_map_t* map, size_t map_count);
+
+/*
+ * @brief 释放接收端
+ * @param rx 接收端
+ * @return 0成功，-1失败
+ */
+int topic_bridge_rx_deinit(topic_bridge_rx_t* rx);
+
+/*
+ * @brief 接收并注入报文：等待最多timeout_ms，然后处理socket中已到达的全部报文
+ * @details 同一接收端只能由一个线程调用
+ * @param rx 接收端
+ * @param timeout_ms 最长等待时间（毫秒），0表示不等待
+ * @return 本次注入的记录数，-1表示socket错误
+ */
+int topic_bridge_rx_poll(topic_bridge_rx_t* rx, uint32_t timeout_ms);
+
+/*
+ * @brief 获取接收端统计
+ * @param rx 接收端
+ * @param stats 输出统计
+ */
+void topic_bridge_rx_get_stats(topic_bridge_rx_t* rx, topic_bridge_rx_stats_t* stats);
+
+#endif /* TOPIC_BUS_ENABLE_BRIDGE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_BRIDGE_H_ */
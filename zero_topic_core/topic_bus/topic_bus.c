@@ -1,16 +1,105 @@
+#include <stdio.h>
 #include <string.h>
 #include "topic_bus.h"
 #include "../../Rte/inc/os_heap.h"
 #include "../../Rte/inc/os_timestamp.h"
+#include "../../Rte/inc/os_thread.h"
+#include "topic_trace.h"
+#if TOPIC_BUS_ENABLE_RECORD
+#include "topic_record.h"
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+#include "../../Rte/inc/os_printf.h"
+#endif
+
+#if TOPIC_BUS_ENABLE_LOAN
+/* 借出缓冲头：位于负载之前，记录引用计数与所属缓冲池 */
+typedef struct {
+    uint32_t magic;                     /* 校验标识 */
+    atomic_uint_fast32_t ref_count;     /* 引用计数 */
+    obj_dict_mempool_t* pool;           /* 所属缓冲池 */
+} topic_loan_hdr_t;
+
+#define TOPIC_LOAN_MAGIC    0x4C4F414EU  /* "LOAN" */
+#define TOPIC_LOAN_HDR_SIZE ((sizeof(topic_loan_hdr_t) + 15U) & ~(size_t)15U)
+#define TOPIC_LOAN_HDR(p)   ((topic_loan_hdr_t*)((uint8_t*)(uintptr_t)(p) - TOPIC_LOAN_HDR_SIZE))
+#endif
+
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+/* 范围订阅分发上下文：区间树递归查找时共享 */
+typedef struct {
+    const topic_sub_array_t* arr;       /* 范围订阅数组 */
+    const topic_range_t* ranges;        /* 区间（紧随arr->subs之后） */
+    topic_entry_t* entry;               /* 触发的Topic */
+    obj_dict_key_t event_key;
+    const void* data;
+    size_t data_len;
+    size_t sub_base;                    /* 跟踪记录中范围订阅者的起始序号 */
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_set_t* hist;
+    uint64_t lap_us;
+#endif
+} topic_range_ctx_t;
+#endif
 
 /* ============================================================
  * 内部函数声明 (Internal Functions Declaration)
  * ============================================================ */
 
+static size_t __event_bucket(const topic_bus_t* bus, obj_dict_key_t event_key);
+static void __event_index_unlink(topic_bus_t* bus, topic_entry_t* entry);
+static int __event_index_needed(const topic_rule_t* rule);
+static void __event_index_link(topic_bus_t* bus, topic_entry_t* entry, topic_event_link_t* links);
+static size_t __topic_hash(const topic_bus_t* bus, uint16_t topic_id);
 static topic_entry_t* __find_topic(topic_bus_t* bus, uint16_t topic_id);
-static topic_entry_t* __find_free_topic_slot(topic_bus_t* bus);
-static obj_dict_entry_t* __find_dict_entry(obj_dict_t* dict, obj_dict_key_t key);
-static void __trigger_topic_callbacks(topic_entry_t* entry, obj_dict_key_t event_key, topic_bus_t* bus);
+static topic_entry_t* __alloc_topic_slot(topic_bus_t* bus, uint16_t topic_id);
+static uint32_t __rcu_read_lock(topic_bus_t* bus);
+static void __rcu_read_unlock(topic_bus_t* bus, uint32_t idx);
+static int __rcu_advance(topic_bus_t* bus);
+static void __rcu_retire(topic_bus_t* bus, topic_sub_array_t* arr);
+static void __rcu_reclaim(topic_bus_t* bus);
+static void __trigger_topic_callbacks(topic_entry_t* entry, obj_dict_key_t event_key,
+                                      const void* data, size_t data_len, int loaned,
+                                      uint64_t publish_ts_us, topic_bus_t* bus);
+static uint64_t __hist_clock(topic_bus_t* bus);
+static uint64_t __dict_event_ts(topic_bus_t* bus, obj_dict_key_t event_key);
+static void __dict_payload_acquire(topic_bus_t* bus, obj_dict_key_t event_key, obj_dict_view_t* view);
+static void __dict_hash_visit(const void* data, size_t len, void* user_data);
+static uint32_t __dict_event_hash(topic_bus_t* bus, obj_dict_key_t event_key);
+static size_t __collect_triggered_locked(topic_bus_t* bus, obj_dict_key_t event_key, uint64_t event_ts_us,
+                                         const void* payload, size_t payload_len,
+                                         topic_entry_t** entries, size_t max_entries);
+static void __dispatch_triggered(topic_bus_t* bus, topic_entry_t** entries, size_t count,
+                                 obj_dict_key_t event_key, const void* data, size_t data_len, int loaned,
+                                 uint64_t publish_ts_us);
+static void __rule_arrays_free(topic_rule_t* rule);
+static int __topic_rule_alloc(topic_rule_t* fresh, const topic_rule_t* rule, topic_event_link_t** links);
+static void __entry_runtime_init(topic_entry_t* entry);
+static int __bus_runtime_init(topic_bus_t* bus);
+static int __subscribe_locked(topic_bus_t* bus, topic_entry_t* entry, const topic_subscription_t* sub);
+#if TOPIC_BUS_ENABLE_HISTORY
+static int __history_replay(topic_bus_t* bus, topic_entry_t* entry, topic_history_t* history,
+                            const topic_subscription_t* sub);
+#endif
+#if TOPIC_BUS_ENABLE_RECORD
+static void __record(topic_bus_t* bus, uint8_t type, uint16_t key, const void* data, size_t len);
+#endif
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+static topic_range_t* __range_of(const topic_sub_array_t* arr);
+static uint16_t __range_build(topic_range_t* ranges, size_t lo, size_t hi);
+static void __range_dispatch(topic_range_ctx_t* ctx, size_t lo, size_t hi);
+static int __range_update(topic_bus_t* bus, uint16_t first_id, uint16_t last_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*),
+                          void* user_data, int add);
+static int __mask_to_range(uint16_t topic_id, uint16_t mask, uint16_t* first_id, uint16_t* last_id);
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+static uint64_t __hist_lap(topic_hist_set_t* hist, topic_hist_t* own, uint64_t start_us);
+static int __entry_hist_alloc(topic_entry_t* entry, size_t static_count);
+static void __entry_hist_free(topic_entry_t* entry);
+static int __entry_sub_hist_alloc(topic_bus_t* bus, topic_entry_t* entry);
+static topic_hist_t* __sub_hist_at(topic_entry_t* entry, size_t index, topic_sub_hist_t* info);
+#endif
 
 /* ============================================================
  * 函数实现 (Function Implementation)
@@ -19,72 +108,286 @@ static void __trigger_topic_callbacks(topic_entry_t* entry, obj_dict_key_t event
 /* ---------------- 辅助函数 ---------------- */
 
 /*
- * @brief 查找指定topic_id的Topic条目
+ * @brief 计算event_key所在的索引桶（乘法散列，默认Fibonacci乘数；静态表使用无冲突乘数）
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @return 桶下标
+ */
+static size_t __event_bucket(const topic_bus_t* bus, obj_dict_key_t event_key) {
+    return (size_t)(((uint32_t)event_key * bus->event_hash_mul) >> (32U - bus->event_index_bits));
+}
+
+/*
+ * @brief 将Topic的规则事件节点从反向索引中摘除并释放（需持有bus->lock）
+ * @param bus Topic总线指针
+ * @param entry Topic条目指针
+ */
+static void __event_index_unlink(topic_bus_t* bus, topic_entry_t* entry) {
+    if (!entry->event_links) return;
+
+    for (size_t i = 0; i < entry->rule.event_count; ++i) {
+        topic_event_link_t* link = &entry->event_links[i];
+        if (!link->entry) continue;  /* 规则内重复事件未入索引 */
+        topic_event_link_t** pp = &bus->event_index[__event_bucket(bus, link->event_key)];
+        while (*pp && *pp != link) {
+            pp = &(*pp)->next;
+        }
+        if (*pp) {
+            *pp = link->next;
+        }
+    }
+
+    os_free(entry->event_links);
+    entry->event_links = NULL;
+}
+
+/*
+ * @brief 判断规则是否需要反向索引节点（MANUAL规则不响应事件，无需入索引）
+ * @param rule 规则指针
+ * @return 1需要，0不需要
+ */
+static int __event_index_needed(const topic_rule_t* rule) {
+    return rule->type != TOPIC_RULE_MANUAL && rule->events && rule->event_count > 0;
+}
+
+/*
+ * @brief 为Topic的规则事件建立反向索引（需持有bus->lock，不会失败）
+ * @param bus Topic总线指针
+ * @param entry Topic条目指针（rule.events已就绪）
+ * @param links 预先分配的rule.event_count个索引节点（__event_index_needed为0时传NULL），所有权归entry
+ */
+static void __event_index_link(topic_bus_t* bus, topic_entry_t* entry, topic_event_link_t* links) {
+    if (!links) return;
+
+    entry->event_links = links;
+    memset(entry->event_links, 0, sizeof(topic_event_link_t) * entry->rule.event_count);
+
+    for (size_t i = 0; i < entry->rule.event_count; ++i) {
+        obj_dict_key_t key = entry->rule.events[i];
+
+        /* 同一规则内重复的事件只索引一次，保证每次发布最多访问该Topic一次 */
+        int duplicated = 0;
+        for (size_t j = 0; j < i; ++j) {
+            if (entry->rule.events[j] == key) {
+                duplicated = 1;
+                break;
+            }
+        }
+        if (duplicated) continue;
+
+        topic_event_link_t* link = &entry->event_links[i];
+        link->event_key = key;
+        link->entry = entry;
+        link->event_index = (uint32_t)i;
+
+        /* 按Topic槽位顺序插入，保持与原线性扫描一致的触发顺序 */
+        topic_event_link_t** pp = &bus->event_index[__event_bucket(bus, key)];
+        while (*pp && (*pp)->entry < entry) {
+            pp = &(*pp)->next;
+        }
+        link->next = *pp;
+        *pp = link;
+    }
+}
+
+/*
+ * @brief 释放规则的事件、超时、时效快照、扩展掩码与摘要数组（运行期创建的规则）
+ * @param rule 规则指针
+ */
+static void __rule_arrays_free(topic_rule_t* rule) {
+    if (rule->events) {
+        os_free(rule->events);
+        rule->events = NULL;
+    }
+    if (rule->event_timeouts_ms) {
+        os_free(rule->event_timeouts_ms);
+        rule->event_timeouts_ms = NULL;
+    }
+    if (rule->event_ts_us) {
+        os_free(rule->event_ts_us);
+        rule->event_ts_us = NULL;
+    }
+    if (rule->trigger_mask_ext) {
+        os_free(rule->trigger_mask_ext);
+        rule->trigger_mask_ext = NULL;
+    }
+    if (rule->event_hash) {
+        os_free(rule->event_hash);
+        rule->event_hash = NULL;
+    }
+}
+
+/*
+ * @brief 计算topic_id在开放寻址表中的起始位置
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @return 起始探测下标
+ */
+static size_t __topic_hash(const topic_bus_t* bus, uint16_t topic_id) {
+    return (size_t)(((uint32_t)topic_id * bus->topic_hash_mul) >> (32U - bus->topic_index_bits));
+}
+
+/*
+ * @brief 查找指定topic_id的Topic条目（开放寻址，O(1)）
  * @param bus Topic总线指针
  * @param topic_id Topic ID
  * @return 返回Topic条目指针，否则返回NULL
  */
 static topic_entry_t* __find_topic(topic_bus_t* bus, uint16_t topic_id) {
-    if (!bus || !bus->topics) return NULL;
-    for (size_t i = 0; i < bus->max_topics; ++i) {
-        if (bus->topics[i].topic_id == topic_id) {
-            return &bus->topics[i];
+    if (!bus || !bus->topics || !bus->topic_index) return NULL;
+    size_t mask = ((size_t)1 << bus->topic_index_bits) - 1;
+    for (size_t pos = __topic_hash(bus, topic_id);; pos = (pos + 1) & mask) {
+        uint32_t slot = bus->topic_index[pos];
+        if (slot == 0) return NULL;  /* 探测到空位，不存在 */
+        if (bus->topics[slot - 1].topic_id == topic_id) {
+            return &bus->topics[slot - 1];
         }
     }
-    return NULL;
 }
 
 /*
- * @brief 查找空闲Topic槽位
+ * @brief 从空闲栈分配Topic槽位并登记到topic_id索引
  * @param bus Topic总线指针
- * @return 返回空槽的Topic条目指针，若无空槽返回NULL
+ * @param topic_id Topic ID
+ * @return 返回新槽位的Topic条目指针，若无空槽返回NULL
  */
-static topic_entry_t* __find_free_topic_slot(topic_bus_t* bus) {
-    if (!bus || !bus->topics) return NULL;
-    for (size_t i = 0; i < bus->max_topics; ++i) {
-        if (bus->topics[i].topic_id == 0xFFFF) {  /* 使用0xFFFF作为空槽标识 */
-            return &bus->topics[i];
-        }
+static topic_entry_t* __alloc_topic_slot(topic_bus_t* bus, uint16_t topic_id) {
+    if (!bus || !bus->topics || bus->free_count == 0) return NULL;
+    uint32_t slot = bus->free_slots[--bus->free_count];
+
+    /* 表容量不小于2*max_topics，必有空位 */
+    size_t mask = ((size_t)1 << bus->topic_index_bits) - 1;
+    size_t pos = __topic_hash(bus, topic_id);
+    while (bus->topic_index[pos] != 0) {
+        pos = (pos + 1) & mask;
+    }
+    bus->topic_index[pos] = slot + 1;
+
+    topic_entry_t* entry = &bus->topics[slot];
+    entry->topic_id = topic_id;
+    return entry;
+}
+
+/*
+ * @brief 进入订阅者数组读临界区（无等待）
+ * @param bus Topic总线指针
+ * @return 读者所在的纪元奇偶槽，退出时传回
+ */
+static uint32_t __rcu_read_lock(topic_bus_t* bus) {
+    uint32_t idx = (uint32_t)atomic_load_explicit(&bus->rcu_epoch, memory_order_acquire) & 1U;
+    atomic_fetch_add_explicit(&bus->rcu_readers[idx], 1, memory_order_seq_cst);
+    return idx;
+}
+
+/*
+ * @brief 退出订阅者数组读临界区
+ * @param bus Topic总线指针
+ * @param idx __rcu_read_lock返回的奇偶槽
+ */
+static void __rcu_read_unlock(topic_bus_t* bus, uint32_t idx) {
+    atomic_fetch_sub_explicit(&bus->rcu_readers[idx], 1, memory_order_release);
+}
+
+/*
+ * @brief 尝试推进一次纪元：要求上一代读者已全部退出
+ * @details 以CAS推进，回收（持bus->lock）与topic_bus_synchronize（不持锁）可以并发推进，
+ *          两者各自检查同一条件，只有一方生效
+ * @param bus Topic总线指针
+ * @return 1纪元已推进（本线程或其他线程），0上一代读者尚未退出
+ */
+static int __rcu_advance(topic_bus_t* bus) {
+    uint_fast32_t e = atomic_load_explicit(&bus->rcu_epoch, memory_order_seq_cst);
+    if (atomic_load_explicit(&bus->rcu_readers[(e + 1U) & 1U], memory_order_seq_cst) != 0) {
+        return 0;
+    }
+    (void)atomic_compare_exchange_strong_explicit(&bus->rcu_epoch, &e, e + 1U, memory_order_seq_cst,
+                                                  memory_order_seq_cst);
+    return 1;
+}
+
+/*
+ * @brief 退役旧订阅者数组并尝试回收（需持有bus->lock，数组已从Topic上摘除）
+ * @param bus Topic总线指针
+ * @param arr 旧数组（可为NULL）
+ */
+static void __rcu_retire(topic_bus_t* bus, topic_sub_array_t* arr) {
+    if (arr) {
+        arr->retire_epoch = (uint32_t)atomic_load_explicit(&bus->rcu_epoch, memory_order_seq_cst);
+        arr->retire_next = bus->rcu_retired;
+        bus->rcu_retired = arr;
     }
-    return NULL;
+    __rcu_reclaim(bus);
 }
 
 /*
- * @brief 查找obj_dict_entry（内部使用）
+ * @brief 推进纪元并释放已过宽限期的数组（需持有bus->lock，不阻塞）
+ * @details 纪元由e推进到e+1前要求奇偶槽(e+1)&1（即e-1代读者）已清空；
+ *          在纪元e退役的数组经过两次推进后不再可能被任何读者持有
+ * @param bus Topic总线指针
  */
-static obj_dict_entry_t* __find_dict_entry(obj_dict_t* dict, obj_dict_key_t key) {
-    if (!dict || !dict->entries) return NULL;
-    for (size_t i = 0; i < dict->max_keys; ++i) {
-        if (dict->entries[i].value != NULL && dict->entries[i].key == key) {
-            return &dict->entries[i];
+static void __rcu_reclaim(topic_bus_t* bus) {
+    for (int i = 0; i < 2 && bus->rcu_retired; ++i) {
+        if (!__rcu_advance(bus)) break;  /* 上一代读者尚未退出，下次再试 */
+    }
+
+    uint32_t now = (uint32_t)atomic_load_explicit(&bus->rcu_epoch, memory_order_seq_cst);
+    topic_sub_array_t** pp = &bus->rcu_retired;
+    while (*pp) {
+        topic_sub_array_t* arr = *pp;
+        if ((uint32_t)(now - arr->retire_epoch) >= 2U) {
+            *pp = arr->retire_next;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+            /* 已无发布者可能向其投递，交由工作线程释放 */
+            topic_executor_detach(arr->retire_async);
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+            os_free(arr->retire_hist);
+#endif
+            os_free(arr);
+        } else {
+            pp = &arr->retire_next;
         }
     }
-    return NULL;
 }
 
 /*
  * @brief 触发Topic回调
  * @param entry Topic条目指针
- * @param event_key 触发的事件键（用于从obj_dict获取数据）
+ * @param event_key 触发的事件键
+ * @param data 数据指针（调用者保证回调与路由期间有效）
+ * @param data_len 数据长度
+ * @param loaned 非0表示data为借出缓冲（异步投递时只增加引用）
+ * @param publish_ts_us 发布时刻（分发延迟起点，0表示不记录）
  * @param bus Topic总线指针
  */
-static void __trigger_topic_callbacks(topic_entry_t* entry, obj_dict_key_t event_key, topic_bus_t* bus) {
+static void __trigger_topic_callbacks(topic_entry_t* entry, obj_dict_key_t event_key,
+                                      const void* data, size_t data_len, int loaned,
+                                      uint64_t publish_ts_us, topic_bus_t* bus) {
     if (!entry) return;
+    (void)event_key;
+    (void)loaned;
+    (void)publish_ts_us;
 
-    /* 从对象字典获取最新数据 */
-    void* data = NULL;
-    size_t data_len = 0;
-    
-    /* 生命周期保护：在回调前增加引用计数，确保数据在回调期间有效 */
-    if (bus && bus->obj_dict) {
-        obj_dict_entry_t* dict_entry = __find_dict_entry(bus->obj_dict, event_key);
-        if (dict_entry && dict_entry->value) {
-            data = dict_entry->value;
-            data_len = dict_entry->value_len;
-            /* 增加引用计数，保护数据在回调期间不被删除 */
-            obj_dict_retain(bus->obj_dict, event_key);
+#if TOPIC_BUS_ENABLE_HIST
+    /* 直方图：开始分发时读一次时钟，之后每个回调/Router结束各读一次，相邻读数之差即其耗时 */
+    topic_hist_set_t* hist = (bus && atomic_load_explicit(&bus->hist_enabled, memory_order_relaxed))
+                           ? atomic_load_explicit(&entry->hist, memory_order_acquire) : NULL;
+    uint64_t lap_us = 0;
+    if (hist) {
+        lap_us = os_monotonic_time_get_microsecond();
+        if (publish_ts_us && lap_us >= publish_ts_us) {
+            topic_hist_record(&hist->latency, lap_us - publish_ts_us);
         }
     }
+#endif
+
+#if TOPIC_BUS_ENABLE_HISTORY
+    /* 先记录历史再回调，回调中拉取历史可读到本次负载 */
+    topic_history_t* history = atomic_load_explicit(&entry->history, memory_order_acquire);
+    if (history) {
+        (void)topic_history_record(history, data, data_len, os_monotonic_time_get_microsecond());
+    }
+#endif
 
     /* 诊断信息记录（可选） */
 #if TOPIC_BUS_ENABLE_STATS && TOPIC_BUS_ENABLE_DIAG
@@ -93,450 +396,2142 @@ static void __trigger_topic_callbacks(topic_entry_t* entry, obj_dict_key_t event
     entry->last_ts_us     = os_monotonic_time_get_microsecond();
 #endif
 
-    /* 触发所有订阅者 */
-    if (entry->subscribers) {
-        topic_subscription_t* sub = entry->subscribers;
-        while (sub) {
-            if (sub->callback) {
-                sub->callback(entry->topic_id, data, data_len, sub->user_data);
-            }
-            sub = sub->next;
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    /* 静态表声明的订阅者：const数组，无需RCU保护 */
+    for (size_t i = 0; i < entry->static_sub_count; ++i) {
+        TOPIC_TRACE_CB(TOPIC_TRACE_CALLBACK_BEGIN, entry->topic_id, event_key, i);
+        entry->static_subs[i].callback(entry->topic_id, data, data_len, entry->static_subs[i].user_data);
+        TOPIC_TRACE_CB(TOPIC_TRACE_CALLBACK_END, entry->topic_id, event_key, i);
+#if TOPIC_BUS_ENABLE_HIST
+        if (hist) {
+            lap_us = __hist_lap(hist, (i < hist->static_count) ? &hist->static_subs[i] : NULL, lap_us);
         }
+#endif
     }
+#endif
 
-    /* 释放引用计数：回调完成后释放引用 */
-    if (bus && bus->obj_dict && data) {
-        obj_dict_release(bus->obj_dict, event_key);
+    /* 触发所有订阅者：一次原子加载取得数组快照，并发订阅/取消订阅不影响本次遍历 */
+    if (bus) {
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+        size_t sub_base = entry->static_sub_count;  /* 跟踪记录中的订阅者序号与直方图查询一致 */
+#else
+        size_t sub_base = 0;
+#endif
+        (void)sub_base;
+        uint32_t rcu_idx = __rcu_read_lock(bus);
+        topic_sub_array_t* subs = atomic_load_explicit(&entry->subscribers, memory_order_seq_cst);
+        if (subs) {
+            for (size_t i = 0; i < subs->count; ++i) {
+                const topic_subscription_t* sub = &subs->subs[i];
+#if TOPIC_BUS_ENABLE_EXECUTOR
+                if (sub->async) {
+                    /* 异步订阅者：入队后立即返回，由执行器工作线程回调 */
+                    TOPIC_TRACE_CB(TOPIC_TRACE_ASYNC_SUBMIT, entry->topic_id, event_key, sub_base + i);
+                    (void)topic_executor_submit(sub->async, data, data_len, loaned);
+#if TOPIC_BUS_ENABLE_HIST
+                    if (hist) lap_us = os_monotonic_time_get_microsecond();  /* 入队耗时不计入下一个回调 */
+#endif
+                    continue;
+                }
+#endif
+                if (sub->callback) {
+                    TOPIC_TRACE_CB(TOPIC_TRACE_CALLBACK_BEGIN, entry->topic_id, event_key, sub_base + i);
+                    sub->callback(entry->topic_id, data, data_len, sub->user_data);
+                    TOPIC_TRACE_CB(TOPIC_TRACE_CALLBACK_END, entry->topic_id, event_key, sub_base + i);
+#if TOPIC_BUS_ENABLE_HIST
+                    if (hist) lap_us = __hist_lap(hist, sub->hist, lap_us);
+#endif
+                }
+            }
+        }
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+        /* 范围订阅者：区间树查找覆盖本Topic的区间，未命中的子树整体跳过 */
+        topic_sub_array_t* ranges = atomic_load_explicit(&bus->range_subs, memory_order_seq_cst);
+        if (ranges) {
+            topic_range_ctx_t ctx = {
+                .arr = ranges, .ranges = __range_of(ranges), .entry = entry, .event_key = event_key,
+                .data = data, .data_len = data_len, .sub_base = sub_base + (subs ? subs->count : 0),
+#if TOPIC_BUS_ENABLE_HIST
+                .hist = hist, .lap_us = lap_us,
+#endif
+            };
+            __range_dispatch(&ctx, 0, ranges->count);
+#if TOPIC_BUS_ENABLE_HIST
+            lap_us = ctx.lap_us;
+#endif
+        }
+#endif
+        __rcu_read_unlock(bus, rcu_idx);
     }
 
 #if TOPIC_BUS_ENABLE_ROUTER
     /* 触发Router处理 */
     if (bus && bus->router && data && data_len > 0) {
+        TOPIC_TRACE(TOPIC_TRACE_ROUTER_BEGIN, entry->topic_id, event_key, 0);
         topic_router_route(bus->router, entry->topic_id, data, data_len);
+        TOPIC_TRACE(TOPIC_TRACE_ROUTER_END, entry->topic_id, event_key, 0);
+#if TOPIC_BUS_ENABLE_HIST
+        if (hist) topic_hist_record(&hist->router, os_monotonic_time_get_microsecond() - lap_us);
+#endif
     }
 #endif
 }
 
-/* ---------------- 初始化与销毁 ---------------- */
+/*
+ * @brief 读取分发延迟起点（直方图关闭时不读时钟）
+ * @param bus Topic总线指针
+ * @return 当前时间（微秒），直方图关闭时返回0
+ */
+static uint64_t __hist_clock(topic_bus_t* bus) {
+#if TOPIC_BUS_ENABLE_HIST
+    if (atomic_load_explicit(&bus->hist_enabled, memory_order_relaxed)) {
+        return os_monotonic_time_get_microsecond();
+    }
+#endif
+    (void)bus;
+    return 0;
+}
 
+#if TOPIC_BUS_ENABLE_HIST
 /*
- * @brief 初始化Topic总线
+ * @brief 记录一次回调耗时（Topic合计与订阅者各自），返回新的计时起点
+ * @param hist Topic直方图组
+ * @param own 订阅者直方图（可为NULL）
+ * @param start_us 回调开始时间
+ * @return 回调结束时间
+ */
+static uint64_t __hist_lap(topic_hist_set_t* hist, topic_hist_t* own, uint64_t start_us) {
+    uint64_t now_us = os_monotonic_time_get_microsecond();
+    uint64_t cost_us = now_us - start_us;
+    topic_hist_record(&hist->callback, cost_us);
+    topic_hist_record(own, cost_us);
+    return now_us;
+}
+
+/*
+ * @brief 为Topic分配直方图组（已分配时保留原有数据）
+ * @param entry Topic条目指针
+ * @param static_count 静态订阅者数量
+ * @return 0成功，-1失败
+ */
+static int __entry_hist_alloc(topic_entry_t* entry, size_t static_count) {
+    if (atomic_load_explicit(&entry->hist, memory_order_relaxed)) return 0;
+    size_t size = sizeof(topic_hist_set_t) + sizeof(topic_hist_t) * static_count;
+    topic_hist_set_t* hist = (topic_hist_set_t*)os_malloc(size);
+    if (!hist) return -1;
+    memset(hist, 0, size);
+    hist->static_count = static_count;
+    atomic_store_explicit(&entry->hist, hist, memory_order_release);
+    return 0;
+}
+
+/*
+ * @brief 释放Topic直方图组
+ * @param entry Topic条目指针
+ */
+static void __entry_hist_free(topic_entry_t* entry) {
+    os_free(atomic_exchange_explicit(&entry->hist, NULL, memory_order_acq_rel));
+}
+
+/*
+ * @brief 为Topic中尚无直方图的同步订阅者分配直方图（需持有bus->lock）
+ * @details 复制订阅者数组并替换，与订阅/取消订阅相同；旧数组过宽限期后释放，直方图归新数组所有
  * @param bus Topic总线指针
- * @param topics Topic条目数组
- * @param max_topics 最大Topic数量
- * @param dict 关联的对象字典
+ * @param entry Topic条目指针
  * @return 0成功，-1失败
  */
-int topic_bus_init(topic_bus_t* bus, topic_entry_t* topics, size_t max_topics, obj_dict_t* dict) {
-    if (!bus || !topics || max_topics == 0 || !dict) return -1;
+static int __entry_sub_hist_alloc(topic_bus_t* bus, topic_entry_t* entry) {
+    topic_sub_array_t* old_subs = atomic_load_explicit(&entry->subscribers, memory_order_acquire);
+    size_t missing = 0;
+    for (size_t i = 0; old_subs && i < old_subs->count; ++i) {
+        const topic_subscription_t* sub = &old_subs->subs[i];
+#if TOPIC_BUS_ENABLE_EXECUTOR
+        if (sub->async) continue;
+#endif
+        if (!sub->hist) missing++;
+    }
+    if (missing == 0) return 0;
 
-    bus->topics = topics;
-    bus->max_topics = max_topics;
-    bus->obj_dict = dict;
+    size_t size = sizeof(topic_sub_array_t) + sizeof(topic_subscription_t) * old_subs->count;
+    topic_sub_array_t* new_subs = (topic_sub_array_t*)os_malloc(size);
+    if (!new_subs) return -1;
+    memcpy(new_subs, old_subs, size);
+    new_subs->retire_next = NULL;
+    new_subs->retire_epoch = 0;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    new_subs->retire_async = NULL;
+#endif
+    new_subs->retire_hist = NULL;
+    for (size_t i = 0; i < new_subs->count; ++i) {
+        topic_subscription_t* sub = &new_subs->subs[i];
+#if TOPIC_BUS_ENABLE_EXECUTOR
+        if (sub->async) continue;
+#endif
+        if (sub->hist) continue;
+        sub->hist = (topic_hist_t*)os_malloc(sizeof(topic_hist_t));
+        if (!sub->hist) {
+            /* 释放本次分配的部分，原数组不变 */
+            for (size_t j = 0; j < i; ++j) {
+                if (new_subs->subs[j].hist != old_subs->subs[j].hist) os_free(new_subs->subs[j].hist);
+            }
+            os_free(new_subs);
+            return -1;
+        }
+        topic_hist_reset(sub->hist);
+    }
 
-    /* 初始化Topic数组 */
-    memset(topics, 0, sizeof(topic_entry_t) * max_topics);
-    for (size_t i = 0; i < max_topics; ++i) {
-        topics[i].topic_id = 0xFFFF;  /* 标记为空 */
+    atomic_store_explicit(&entry->subscribers, new_subs, memory_order_seq_cst);
+    __rcu_retire(bus, old_subs);
+    return 0;
+}
+
+/*
+ * @brief 按回调顺序定位第index个订阅者的直方图（需持有bus->lock）
+ * @param entry Topic条目指针
+ * @param index 订阅者序号（先静态订阅者，再动态订阅者）
+ * @param info 输出：订阅者标识（不含快照）
+ * @return 直方图指针，越界返回NULL
+ */
+static topic_hist_t* __sub_hist_at(topic_entry_t* entry, size_t index, topic_sub_hist_t* info) {
+    topic_hist_set_t* set = atomic_load_explicit(&entry->hist, memory_order_relaxed);
+    if (!set) return NULL;
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    if (index < entry->static_sub_count) {
+        info->callback = entry->static_subs[index].callback;
+        info->user_data = entry->static_subs[index].user_data;
+        info->is_static = 1;
+        info->is_async = 0;
+        return (index < set->static_count) ? &set->static_subs[index] : NULL;
+    }
+    index -= entry->static_sub_count;
+#endif
+    topic_sub_array_t* subs = atomic_load_explicit(&entry->subscribers, memory_order_acquire);
+    if (!subs || index >= subs->count) return NULL;
+
+    const topic_subscription_t* sub = &subs->subs[index];
+    info->callback = sub->callback;
+    info->user_data = sub->user_data;
+    info->is_static = 0;
+    info->is_async = 0;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    if (sub->async) {
+        info->is_async = 1;
+        return &sub->async->hist;
+    }
+#endif
+    return sub->hist;
+}
+#endif
+
+/*
+ * @brief 在持有bus->lock之前读取事件的数据时间戳（不加字典锁）
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @return obj_dict_set写入的数据时间戳，事件不在对象字典中返回0（交由各事件的超时配置判定）
+ */
+static uint64_t __dict_event_ts(topic_bus_t* bus, obj_dict_key_t event_key) {
+    obj_dict_entry_t* dict_entry = bus->obj_dict ? obj_dict_lookup(bus->obj_dict, event_key) : NULL;
+    if (!dict_entry) return 0;
+    /* 并发写入时至多读到前后两次set之一，只影响时效判定；三缓冲键的时间戳取自最新槽位 */
+    return obj_dict_entry_timestamp(bus->obj_dict, dict_entry);
+}
+
+/*
+ * @brief 从对象字典借用事件数据（零拷贝），回调期间数据不被覆盖或释放
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @param view 输出借用视图（无数据时data为NULL），分发完成后以obj_dict_return归还
+ */
+static void __dict_payload_acquire(topic_bus_t* bus, obj_dict_key_t event_key, obj_dict_view_t* view) {
+    memset(view, 0, sizeof(*view));
+    if (!bus->obj_dict) return;
+    (void)obj_dict_borrow(bus->obj_dict, event_key, view);
+}
+
+/*
+ * @brief 数据摘要访问函数（obj_dict_peek在读区内调用）
+ * @param data 事件数据
+ * @param len 数据长度
+ * @param user_data 输出摘要
+ */
+static void __dict_hash_visit(const void* data, size_t len, void* user_data) {
+    *(uint32_t*)user_data = topic_rule_data_hash(data, len);
+}
+
+/*
+ * @brief 以seqlock一致读计算事件数据摘要（仅EDGE规则需要，每次发布最多一次）
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @return 数据摘要
+ */
+static uint32_t __dict_event_hash(topic_bus_t* bus, obj_dict_key_t event_key) {
+    uint32_t hash = topic_rule_data_hash(NULL, 0);
+    if (bus->obj_dict) {
+        (void)obj_dict_peek(bus->obj_dict, event_key, __dict_hash_visit, &hash);
+    }
+    return hash;
+}
+
+/*
+ * @brief 评估event_key相关的规则，收集需要触发的Topic（需持有bus->lock）
+ *        触发事件的时间戳写入各规则的时效快照，AND规则的其余事件直接比较快照，
+ *        评估过程不访问对象字典（无字典锁、无查找；EDGE规则的数据摘要除外）
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @param event_ts_us 触发事件的数据时间戳
+ * @param payload 借出缓冲数据，NULL表示数据在对象字典中
+ * @param payload_len 借出缓冲数据长度
+ * @param entries 输出：需要触发的Topic条目
+ * @param max_entries entries容量
+ * @return 需要触发的Topic数量
+ */
+static size_t __collect_triggered_locked(topic_bus_t* bus, obj_dict_key_t event_key, uint64_t event_ts_us,
+                                         const void* payload, size_t payload_len,
+                                         topic_entry_t** entries, size_t max_entries) {
+    size_t trigger_count = 0;
+    uint64_t now_us = os_monotonic_time_get_microsecond();
+    uint32_t data_hash = 0;  /* 首个EDGE规则需要时才计算 */
+
+    /* 通过反向索引仅访问规则引用了该event_key的Topic */
+    for (topic_event_link_t* link = bus->event_index[__event_bucket(bus, event_key)]; link; link = link->next) {
+        if (link->event_key != event_key) continue;  /* 同桶的其他事件 */
+        topic_entry_t* entry = link->entry;
+        topic_rule_t* rule = &entry->rule;
+
+        /* 记录快照并检查时效性 */
+        if (rule->event_ts_us) {
+            rule->event_ts_us[link->event_index] = event_ts_us;
+        }
+        if (!topic_rule_check_timeout_index(rule, link->event_index, event_ts_us, now_us)) {
+            continue;  /* 时效性不满足，跳过该Topic */
+        }
+
+        if (rule->type == TOPIC_RULE_EDGE && data_hash == 0) {
+            data_hash = payload ? topic_rule_data_hash(payload, payload_len) : __dict_event_hash(bus, event_key);
+        }
+
+        /* 规则条件与过滤（去抖/限频/边沿/窗口）在分发前判定，被抑制的事件不产生任何回调 */
+        if (topic_rule_evaluate(rule, link->event_index, event_ts_us, now_us, data_hash, bus->obj_dict)
+            && trigger_count < max_entries) {
+            entries[trigger_count++] = entry;
+            TOPIC_TRACE(TOPIC_TRACE_MATCH, entry->topic_id, event_key, 0);
+        }
+    }
+
+    return trigger_count;
+}
+
+/*
+ * @brief 在无锁状态下分发已收集的Topic（同一份数据交给全部订阅者与路由）
+ * @param bus Topic总线指针
+ * @param entries 需要触发的Topic条目
+ * @param count 条目数量
+ * @param event_key 事件键
+ * @param data 数据指针
+ * @param data_len 数据长度
+ * @param loaned 非0表示data为借出缓冲
+ * @param publish_ts_us 发布时刻（分发延迟起点，0表示不记录）
+ */
+static void __dispatch_triggered(topic_bus_t* bus, topic_entry_t** entries, size_t count,
+                                 obj_dict_key_t event_key, const void* data, size_t data_len, int loaned,
+                                 uint64_t publish_ts_us) {
+    for (size_t i = 0; i < count; ++i) {
+        topic_entry_t* entry = entries[i];
+        __trigger_topic_callbacks(entry, event_key, data, data_len, loaned, publish_ts_us, bus);
+
+        /* 更新统计信息 */
 #if TOPIC_BUS_ENABLE_STATS
 #if TOPIC_BUS_ENABLE_ATOMICS
-        atomic_init(&topics[i].event_count, 0);
+        /* 原子操作，无需锁 */
+        atomic_fetch_add_explicit(&entry->event_count, 1, memory_order_relaxed);
+#else
+        /* 非原子模式：需要重新获取锁以更新计数器 */
+        if (os_semaphore_take(bus->lock, 100) >= 0) {
+            entry->event_count++;
+            os_semaphore_give(bus->lock);
+        }
+#endif
+#endif
+    }
+}
+
+/* ---------------- 初始化与销毁 ---------------- */
+
+/*
+ * @brief 初始化Topic条目的运行期字段（订阅者、触发掩码、时效快照、过滤状态与统计）
+ * @param entry Topic条目指针
+ */
+static void __entry_runtime_init(topic_entry_t* entry) {
+    atomic_init(&entry->subscribers, NULL);
+    topic_rule_reset_mask(&entry->rule);
+    if (entry->rule.event_ts_us && entry->rule.event_count > 0) {
+        memset(entry->rule.event_ts_us, 0, sizeof(uint64_t) * entry->rule.event_count);
+    }
+    if (entry->rule.event_hash && entry->rule.event_count > 0) {
+        memset(entry->rule.event_hash, 0, sizeof(uint32_t) * entry->rule.event_count);
+    }
+    entry->rule.last_trigger_us  = 0;
+    entry->rule.last_event_us    = 0;
+    entry->rule.suppressed_count = 0;
+#if TOPIC_BUS_ENABLE_HIST
+    atomic_init(&entry->hist, NULL);
+#endif
+#if TOPIC_BUS_ENABLE_STATS
+#if TOPIC_BUS_ENABLE_ATOMICS
+    atomic_init(&entry->event_count, 0);
 #else
-        topics[i].event_count = 0;
+    entry->event_count = 0;
 #endif
 #if TOPIC_BUS_ENABLE_DIAG
-        topics[i].last_event_key = 0;
-        topics[i].last_data_len  = 0;
-        topics[i].last_ts_us     = 0;
+    entry->last_event_key = 0;
+    entry->last_data_len  = 0;
+    entry->last_ts_us     = 0;
 #endif
 #endif
+}
+
+/*
+ * @brief 初始化总线的运行期资源（回收状态、锁与ISR队列），索引已就绪
+ * @param bus Topic总线指针
+ * @return 0成功，-1失败（已释放本函数创建的资源）
+ */
+static int __bus_runtime_init(topic_bus_t* bus) {
+#if TOPIC_BUS_ENABLE_ROUTER
+    bus->router = NULL;  /* 初始化Router为NULL */
+#endif
+#if TOPIC_BUS_ENABLE_LOAN
+    bus->loan_pool = NULL;
+    bus->loan_capacity = 0;
+#endif
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    bus->executor = NULL;
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    atomic_init(&bus->hist_enabled, 0);
+#endif
+#if TOPIC_BUS_ENABLE_RECORD
+    atomic_init(&bus->recorder, NULL);
+#endif
+
+    /* 初始化订阅者数组回收状态 */
+    atomic_init(&bus->rcu_epoch, 0);
+    atomic_init(&bus->rcu_readers[0], 0);
+    atomic_init(&bus->rcu_readers[1], 0);
+    bus->rcu_retired = NULL;
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+    atomic_init(&bus->range_subs, NULL);
+#endif
+
+    /* 创建锁 */
+    bus->lock = os_semaphore_create(1, "topic_bus_lock");
+    if (!bus->lock) return -1;
+
+#if TOPIC_BUS_ENABLE_ISR
+    /* 创建ISR队列：多个ISR/线程可并发发布 */
+    bus->isr_queue = ring_buffer_mpmc_create(TOPIC_BUS_ISR_QUEUE_SIZE, sizeof(topic_bus_isr_event_t));
+    atomic_init(&bus->isr_waiting, 0);
+    bus->isr_signal = os_semaphore_create(0, NULL);
+    if (!bus->isr_queue || !bus->isr_signal) {
+        if (bus->isr_queue) ring_buffer_mpmc_destroy(bus->isr_queue);
+        if (bus->isr_signal) os_semaphore_destroy(bus->isr_signal);
+        bus->isr_queue = NULL;
+        bus->isr_signal = NULL;
+        os_semaphore_destroy(bus->lock);
+        bus->lock = NULL;
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * @brief 初始化Topic总线
+ * @param bus Topic总线指针
+ * @param topics Topic条目数组
+ * @param max_topics 最大Topic数量
+ * @param dict 关联的对象字典
+ * @return 0成功，-1失败
+ */
+int topic_bus_init(topic_bus_t* bus, topic_entry_t* topics, size_t max_topics, obj_dict_t* dict) {
+    if (!bus || !topics || max_topics == 0 || max_topics >= 0xFFFF || !dict) return -1;
+
+    bus->topics = topics;
+    bus->max_topics = max_topics;
+    bus->obj_dict = dict;
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    bus->static_table = NULL;
+#endif
+
+    /* 初始化Topic数组 */
+    memset(topics, 0, sizeof(topic_entry_t) * max_topics);
+    for (size_t i = 0; i < max_topics; ++i) {
+        topics[i].topic_id = 0xFFFF;  /* 标记为空 */
+        __entry_runtime_init(&topics[i]);
+    }
+
+    /* 创建事件反向索引：桶数取不小于max_topics的2的幂 */
+    size_t buckets = TOPIC_BUS_EVENT_INDEX_MIN_BUCKETS;
+    bus->event_index_bits = 0;
+    bus->event_hash_mul = TOPIC_BUS_HASH_MUL_DEFAULT;
+    while (((size_t)1 << bus->event_index_bits) < buckets) {
+        bus->event_index_bits++;
+    }
+    while (((size_t)1 << bus->event_index_bits) < max_topics && bus->event_index_bits < 16) {
+        bus->event_index_bits++;
+    }
+    buckets = (size_t)1 << bus->event_index_bits;
+    bus->event_index = (topic_event_link_t**)os_malloc(sizeof(topic_event_link_t*) * buckets);
+    if (!bus->event_index) return -1;
+    memset(bus->event_index, 0, sizeof(topic_event_link_t*) * buckets);
+
+    /* 创建topic_id开放寻址表（容量不小于2*max_topics）与空闲槽位栈 */
+    bus->topic_index_bits = 1;
+    bus->topic_hash_mul = TOPIC_BUS_HASH_MUL_DEFAULT;
+    while (((size_t)1 << bus->topic_index_bits) < max_topics * 2) {
+        bus->topic_index_bits++;
+    }
+    size_t index_size = (size_t)1 << bus->topic_index_bits;
+    bus->topic_index = (uint32_t*)os_malloc(sizeof(uint32_t) * (index_size + max_topics));
+    if (!bus->topic_index) {
+        os_free(bus->event_index);
+        bus->event_index = NULL;
+        return -1;
+    }
+    memset(bus->topic_index, 0, sizeof(uint32_t) * index_size);
+    bus->free_slots = bus->topic_index + index_size;
+    for (size_t i = 0; i < max_topics; ++i) {
+        /* 逆序入栈，保证按槽位0,1,2...顺序分配 */
+        bus->free_slots[i] = (uint32_t)(max_topics - 1 - i);
+    }
+    bus->free_count = max_topics;
+
+    if (__bus_runtime_init(bus) != 0) {
+        os_free(bus->topic_index);
+        bus->topic_index = NULL;
+        os_free(bus->event_index);
+        bus->event_index = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+/*
+ * @brief 使用编译期静态Topic表初始化Topic总线
+ * @param bus Topic总线指针
+ * @param table 生成的静态Topic表
+ * @param dict 关联的对象字典
+ * @return 0成功，-1失败
+ */
+int topic_bus_init_static(topic_bus_t* bus, const topic_static_table_t* table, obj_dict_t* dict) {
+    if (!bus || !table || !table->topics || table->topic_count == 0 || table->topic_count >= 0xFFFF || !dict) {
+        return -1;
+    }
+    if (!table->event_index || !table->topic_index || table->event_index_bits == 0 || table->topic_index_bits == 0) {
+        return -1;
+    }
+
+    bus->topics = table->topics;
+    bus->max_topics = table->topic_count;
+    bus->obj_dict = dict;
+    bus->static_table = table;
+
+    /* 规则与订阅者声明来自生成代码，只重置运行期字段 */
+    for (size_t i = 0; i < table->topic_count; ++i) {
+        __entry_runtime_init(&table->topics[i]);
+    }
+
+    /* 索引只读：event_index/topic_index仅在topic_rule_create中写入，而静态总线拒绝该调用 */
+    bus->event_index = (topic_event_link_t**)(uintptr_t)table->event_index;
+    bus->event_index_bits = table->event_index_bits;
+    bus->event_hash_mul = table->event_hash_mul;
+    bus->topic_index = (uint32_t*)(uintptr_t)table->topic_index;
+    bus->topic_index_bits = table->topic_index_bits;
+    bus->topic_hash_mul = table->topic_hash_mul;
+    bus->free_slots = NULL;
+    bus->free_count = 0;
+
+    if (__bus_runtime_init(bus) != 0) {
+        bus->static_table = NULL;
+        bus->event_index = NULL;
+        bus->topic_index = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+#endif
+
+/*
+ * @brief 销毁Topic总线，释放规则、订阅者、索引及锁等内部资源
+ * @param bus Topic总线指针
+ */
+void topic_bus_deinit(topic_bus_t* bus) {
+    if (!bus || !bus->topics) return;
+
+    int static_table = 0;
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    static_table = (bus->static_table != NULL);
+#endif
+
+    for (size_t i = 0; i < bus->max_topics; ++i) {
+        topic_entry_t* entry = &bus->topics[i];
+        if (entry->topic_id == 0xFFFF) continue;
+
+        topic_sub_array_t* subs = atomic_exchange_explicit(&entry->subscribers, NULL, memory_order_acq_rel);
+        if (subs) {
+#if TOPIC_BUS_ENABLE_EXECUTOR
+            for (size_t j = 0; j < subs->count; ++j) {
+                topic_executor_detach(subs->subs[j].async);
+            }
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+            for (size_t j = 0; j < subs->count; ++j) {
+                os_free(subs->subs[j].hist);
+            }
+#endif
+            os_free(subs);
+        }
+#if TOPIC_BUS_ENABLE_HIST
+        __entry_hist_free(entry);
+#endif
+#if TOPIC_BUS_ENABLE_HISTORY
+        topic_history_destroy(atomic_exchange_explicit(&entry->history, NULL, memory_order_acq_rel));
+#endif
+        if (static_table) continue;  /* 规则数组与Topic条目属于静态表，保留 */
+
+        if (entry->event_links) {
+            os_free(entry->event_links);
+            entry->event_links = NULL;
+        }
+        __rule_arrays_free(&entry->rule);
+        entry->topic_id = 0xFFFF;
+    }
+
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+    /* 范围订阅者均为同步回调，不持有直方图与异步队列 */
+    os_free(atomic_exchange_explicit(&bus->range_subs, NULL, memory_order_acq_rel));
+#endif
+
+    /* 销毁时不应再有发布者，直接释放全部退役数组 */
+    while (bus->rcu_retired) {
+        topic_sub_array_t* arr = bus->rcu_retired;
+        bus->rcu_retired = arr->retire_next;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+        topic_executor_detach(arr->retire_async);
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+        os_free(arr->retire_hist);
+#endif
+        os_free(arr);
+    }
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    /* 等待工作线程释放异步订阅者，其队列中的借出缓冲须先于缓冲池归还 */
+    if (bus->executor) {
+        (void)topic_executor_sync(bus->executor, TOPIC_EXECUTOR_BLOCK_TIMEOUT_MS);
+        bus->executor = NULL;
+    }
+#endif
+
+    if (bus->event_index && !static_table) {
+        os_free(bus->event_index);
+    }
+    if (bus->topic_index && !static_table) {
+        os_free(bus->topic_index);
+    }
+    bus->event_index = NULL;
+    bus->topic_index = NULL;
+    bus->free_slots = NULL;
+    bus->free_count = 0;
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    bus->static_table = NULL;
+#endif
+#if TOPIC_BUS_ENABLE_ISR
+    if (bus->isr_queue) {
+        ring_buffer_mpmc_destroy(bus->isr_queue);
+        bus->isr_queue = NULL;
+    }
+    if (bus->isr_signal) {
+        os_semaphore_destroy(bus->isr_signal);
+        bus->isr_signal = NULL;
+    }
+#endif
+    if (bus->lock) {
+        os_semaphore_destroy(bus->lock);
+        bus->lock = NULL;
+    }
+#if TOPIC_BUS_ENABLE_ROUTER
+    bus->router = NULL;
+#endif
+#if TOPIC_BUS_ENABLE_LOAN
+    /* 仍被订阅者持有的借出缓冲随缓冲池一并释放 */
+    if (bus->loan_pool) {
+        obj_dict_mempool_destroy(bus->loan_pool);
+        bus->loan_pool = NULL;
+        bus->loan_capacity = 0;
+    }
+#endif
+}
+
+/*
+ * @brief 等待宽限期：此前进入发布路径读区的调用全部退出
+ * @param bus Topic总线指针
+ */
+void topic_bus_synchronize(topic_bus_t* bus) {
+    if (!bus || !bus->topics) return;
+
+    /* 纪元推进两次后，调用前进入读区的读者（分属当前与上一代奇偶槽）均已退出 */
+    uint32_t start = (uint32_t)atomic_load_explicit(&bus->rcu_epoch, memory_order_seq_cst);
+    while ((uint32_t)((uint32_t)atomic_load_explicit(&bus->rcu_epoch, memory_order_seq_cst) - start) < 2U) {
+        if (!__rcu_advance(bus)) {
+            os_thread_sleep_ms(1);  /* 读者可能是被抢占的低优先级任务，需真正阻塞而非只让出CPU */
+        }
+    }
+
+    /* 宽限期已过：释放此前退役的订阅者数组，退役的异步订阅者交给工作线程释放 */
+    if (os_semaphore_take(bus->lock, 100) > 0) {
+        __rcu_reclaim(bus);
+        os_semaphore_give(bus->lock);
+    }
+}
+
+/* ---------------- 规则管理 ---------------- */
+
+/*
+ * @brief 为新规则分配并填写事件、超时、时效快照、扩展掩码、摘要数组与反向索引节点
+ * @param fresh 新规则（type与event_count已设置，其余数组为NULL；失败时由调用者释放已分配的数组）
+ * @param rule 调用者传入的规则
+ * @param links 输出：反向索引节点（不需要时为NULL）
+ * @return 0成功，-1内存不足
+ */
+static int __topic_rule_alloc(topic_rule_t* fresh, const topic_rule_t* rule, topic_event_link_t** links) {
+    /* 复制事件数组 */
+    if (rule->events && rule->event_count > 0) {
+        fresh->events = (obj_dict_key_t*)os_malloc(sizeof(obj_dict_key_t) * rule->event_count);
+        if (!fresh->events) return -1;
+        memcpy(fresh->events, rule->events, sizeof(obj_dict_key_t) * rule->event_count);
+
+        /* 时效快照：发布时记录各事件的数据时间戳，AND规则评估无需查询对象字典（MANUAL规则不响应事件） */
+        if (rule->type != TOPIC_RULE_MANUAL) {
+            fresh->event_ts_us = (uint64_t*)os_malloc(sizeof(uint64_t) * rule->event_count);
+            if (!fresh->event_ts_us) return -1;
+            memset(fresh->event_ts_us, 0, sizeof(uint64_t) * rule->event_count);
+        }
+    }
+
+    /* 复制超时数组 */
+    if (rule->event_timeouts_ms && rule->event_count > 0) {
+        fresh->event_timeouts_ms = (uint32_t*)os_malloc(sizeof(uint32_t) * rule->event_count);
+        if (!fresh->event_timeouts_ms) return -1;
+        memcpy(fresh->event_timeouts_ms, rule->event_timeouts_ms, sizeof(uint32_t) * rule->event_count);
+    }
+
+    /* 超过32个事件的AND规则使用扩展掩码；EDGE规则记录各事件的数据摘要 */
+    size_t ext_words = (rule->type == TOPIC_RULE_AND) ? TOPIC_RULE_MASK_EXT_WORDS(rule->event_count) : 0;
+    if (ext_words > 0) {
+        fresh->trigger_mask_ext = (uint32_t*)os_malloc(sizeof(uint32_t) * ext_words);
+        if (!fresh->trigger_mask_ext) return -1;
+        memset(fresh->trigger_mask_ext, 0, sizeof(uint32_t) * ext_words);
+    }
+    if (rule->type == TOPIC_RULE_EDGE && fresh->events) {
+        fresh->event_hash = (uint32_t*)os_malloc(sizeof(uint32_t) * rule->event_count);
+        if (!fresh->event_hash) return -1;
+        memset(fresh->event_hash, 0, sizeof(uint32_t) * rule->event_count);
+    }
+
+    /* 反向索引节点也预先分配，换入新规则后建立索引不会失败 */
+    *links = NULL;
+    if (__event_index_needed(fresh)) {
+        *links = (topic_event_link_t*)os_malloc(sizeof(topic_event_link_t) * fresh->event_count);
+        if (!*links) return -1;
+    }
+    return 0;
+}
+
+/*
+ * @brief 创建Topic规则
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param rule 规则指针
+ * @return 0成功，-1失败
+ */
+int topic_rule_create(topic_bus_t* bus, uint16_t topic_id, const topic_rule_t* rule) {
+    if (!bus || !rule || topic_id == 0xFFFF) return -1;  /* 0xFFFF保留为空槽标识 */
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    if (bus->static_table) return -1;  /* 静态表的Topic集合在编译期确定 */
+#endif
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    if (!entry) {
+        entry = __alloc_topic_slot(bus, topic_id);
+        if (!entry) {
+            os_semaphore_give(bus->lock);
+            return -1;
+        }
+    }
+#if TOPIC_BUS_ENABLE_HIST
+    if (atomic_load_explicit(&bus->hist_enabled, memory_order_relaxed) && __entry_hist_alloc(entry, 0) != 0) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+#endif
+
+    /* 先在局部规则中分配并填好全部数组，任何一步失败都保留旧规则不变 */
+    topic_rule_t fresh;
+    memset(&fresh, 0, sizeof(fresh));
+    fresh.type = rule->type;
+    fresh.event_count = rule->event_count;
+    topic_event_link_t* links = NULL;
+    if (__topic_rule_alloc(&fresh, rule, &links) != 0) {
+        __rule_arrays_free(&fresh);
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+
+    /* 全部分配成功：从反向索引摘除旧规则并释放其数组，再换入新数组 */
+    __event_index_unlink(bus, entry);
+    __rule_arrays_free(&entry->rule);
+
+    /* 复制规则基本字段 */
+    entry->rule.type              = fresh.type;
+    entry->rule.event_count       = fresh.event_count;
+    entry->rule.events            = fresh.events;
+    entry->rule.event_timeouts_ms = fresh.event_timeouts_ms;
+    entry->rule.event_ts_us       = fresh.event_ts_us;
+    entry->rule.trigger_mask_ext  = fresh.trigger_mask_ext;
+    entry->rule.event_hash        = fresh.event_hash;
+
+    /* 初始化trigger_mask（确保原子类型正确初始化） */
+#if TOPIC_BUS_ENABLE_ATOMICS
+    atomic_init(&entry->rule.trigger_mask, 0);
+#else
+    entry->rule.trigger_mask = 0;
+#endif
+    topic_rule_reset_mask(&entry->rule);
+
+#if TOPIC_BUS_ENABLE_RULE_CACHE
+    entry->rule.last_event_key_cached   = 0;
+    entry->rule.last_can_trigger_cached = 0;
+#endif
+
+    /* 过滤参数与运行期状态 */
+    entry->rule.interval_ms      = rule->interval_ms;
+    entry->rule.min_count        = rule->min_count;
+    entry->rule.last_trigger_us  = 0;
+    entry->rule.last_event_us    = 0;
+    entry->rule.suppressed_count = 0;
+
+    /* 建立event_key -> Topic反向索引（节点已预先分配） */
+    __event_index_link(bus, entry, links);
+
+    os_semaphore_give(bus->lock);
+    return 0;
+}
+
+/* ---------------- 订阅管理 ---------------- */
+
+/*
+ * @brief 将订阅者插入Topic的订阅者数组（需持有bus->lock）
+ * @param bus Topic总线指针
+ * @param entry Topic条目指针
+ * @param sub 订阅者
+ * @return 0成功，-1失败
+ */
+static int __subscribe_locked(topic_bus_t* bus, topic_entry_t* entry, const topic_subscription_t* sub) {
+    /* 复制现有数组并追加新订阅者，原子替换后退役旧数组 */
+    topic_sub_array_t* old_subs = atomic_load_explicit(&entry->subscribers, memory_order_acquire);
+    size_t old_count = old_subs ? old_subs->count : 0;
+    topic_sub_array_t* new_subs = (topic_sub_array_t*)os_malloc(
+        sizeof(topic_sub_array_t) + sizeof(topic_subscription_t) * (old_count + 1));
+    if (!new_subs) return -1;
+    new_subs->retire_next = NULL;
+    new_subs->retire_epoch = 0;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    new_subs->retire_async = NULL;
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    new_subs->retire_hist = NULL;
+#endif
+    new_subs->count = old_count + 1;
+    /* 新订阅者置于首位，与原链表头插顺序一致 */
+    new_subs->subs[0] = *sub;
+#if TOPIC_BUS_ENABLE_HIST
+    /* 同步订阅者的回调耗时直方图（异步订阅者在执行器中统计） */
+    new_subs->subs[0].hist = NULL;
+    int want_hist = atomic_load_explicit(&bus->hist_enabled, memory_order_relaxed);
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    want_hist = want_hist && !sub->async;
+#endif
+    if (want_hist) {
+        new_subs->subs[0].hist = (topic_hist_t*)os_malloc(sizeof(topic_hist_t));
+        if (!new_subs->subs[0].hist) {
+            os_free(new_subs);
+            return -1;
+        }
+        topic_hist_reset(new_subs->subs[0].hist);
+    }
+#endif
+    if (old_count > 0) {
+        memcpy(&new_subs->subs[1], old_subs->subs, sizeof(topic_subscription_t) * old_count);
+    }
+
+    atomic_store_explicit(&entry->subscribers, new_subs, memory_order_seq_cst);
+    __rcu_retire(bus, old_subs);
+    return 0;
+}
+
+#if TOPIC_BUS_ENABLE_HISTORY
+/*
+ * @brief 向新订阅者回放Topic历史，追上后再插入订阅者（调用时不持有bus->lock，回调中可发布或订阅）
+ * @details 回放期间订阅者尚未发布给发布者：取消订阅找不到它，异步订阅者也只有本线程使用，
+ *          回放的样本必然先于实时投递。每轮只回放本轮开始时已有的样本并在锁外回调；
+ *          然后在bus->lock与历史锁内检查是否已追上最新样本，追上（或达到TOPIC_BUS_HISTORY_REPLAY_ROUNDS轮）
+ *          即插入订阅者：持有历史锁期间没有新样本，之后的发布都会实时投递
+ * @param bus Topic总线指针
+ * @param entry Topic条目指针
+ * @param history Topic历史
+ * @param sub 新订阅者
+ * @return 0成功，-1失败（订阅者未插入）
+ */
+static int __history_replay(topic_bus_t* bus, topic_entry_t* entry, topic_history_t* history,
+                            const topic_subscription_t* sub) {
+    void* buf = os_malloc(history->max_payload ? history->max_payload : 1U);
+    if (!buf) return -1;
+
+    int ret = -1;
+    uint64_t cursor = 0;
+    for (uint32_t round = 1; ; ++round) {
+        /* 只回放本轮开始时已有的样本：回调向本Topic发布不会使回放无休止 */
+        uint64_t last = topic_history_last_seq(history);
+        topic_history_sample_t sample;
+        while ((cursor == 0 || cursor <= last) &&
+               topic_history_fetch(history, &cursor, buf, history->max_payload, &sample) == 1) {
+#if TOPIC_BUS_ENABLE_EXECUTOR
+            if (sub->async) {
+                (void)topic_executor_submit(sub->async, buf, sample.len, 0);
+                continue;
+            }
+#endif
+            sub->callback(entry->topic_id, buf, sample.len, sub->user_data);
+        }
+
+        /* 锁顺序：bus->lock → 历史锁（记录历史时不持有bus->lock） */
+        if (os_semaphore_take(bus->lock, 100) < 0) break;
+        if (os_semaphore_take(history->lock, 100) < 0) {
+            os_semaphore_give(bus->lock);
+            break;
+        }
+        int done = ((cursor ? cursor : 1U) >= history->next_seq || round >= TOPIC_BUS_HISTORY_REPLAY_ROUNDS);
+        if (done) {
+            ret = __subscribe_locked(bus, entry, sub);
+        }
+        os_semaphore_give(history->lock);
+        os_semaphore_give(bus->lock);
+        if (done) break;
+    }
+    os_free(buf);
+    return ret;
+}
+#endif
+
+/*
+ * @brief 订阅Topic
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_subscribe(topic_bus_t* bus, uint16_t topic_id,
+                    void (*callback)(uint16_t, const void*, size_t, void*),
+                    void* user_data) {
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    /* 按Topic默认订阅选项订阅 */
+    return topic_subscribe_ex(bus, topic_id, callback, user_data, NULL);
+#else
+    if (!bus || !callback) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    if (!entry) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+
+    topic_subscription_t sub = { .callback = callback, .user_data = user_data };
+    int ret = __subscribe_locked(bus, entry, &sub);
+
+    os_semaphore_give(bus->lock);
+    return ret;
+#endif
+}
+
+#if TOPIC_BUS_ENABLE_EXECUTOR || TOPIC_BUS_ENABLE_HISTORY
+/*
+ * @brief 按选项订阅Topic
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param options 订阅选项（NULL使用Topic默认选项）
+ * @return 0成功，-1失败
+ */
+int topic_subscribe_ex(topic_bus_t* bus, uint16_t topic_id,
+                       void (*callback)(uint16_t, const void*, size_t, void*),
+                       void* user_data, const topic_sub_options_t* options) {
+    if (!bus || !callback) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    if (!entry) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    if (!options) {
+        options = &entry->sub_defaults;
+    }
+
+    topic_subscription_t sub = { .callback = callback, .user_data = user_data, .async = NULL };
+    if (options->async) {
+        sub.async = topic_executor_attach(bus->executor, topic_id, callback, user_data,
+                                          (int)options->policy, options->queue_depth);
+        if (!sub.async) {
+            os_semaphore_give(bus->lock);
+            return -1;
+        }
+    }
+#else
+    topic_subscription_t sub = { .callback = callback, .user_data = user_data };
+#endif
+
+    int ret;
+#if TOPIC_BUS_ENABLE_HISTORY
+    topic_history_t* history = atomic_load_explicit(&entry->history, memory_order_acquire);
+    if (options && options->replay && history) {
+        /* 先回放再插入订阅者，回放在锁外进行 */
+        os_semaphore_give(bus->lock);
+        ret = __history_replay(bus, entry, history, &sub);
+    } else
+#endif
+    {
+        ret = __subscribe_locked(bus, entry, &sub);
+        os_semaphore_give(bus->lock);
+    }
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    if (ret != 0) {
+        /* 尚未发布给任何发布者，可直接退役 */
+        topic_executor_detach(sub.async);
+    }
+#endif
+    return ret;
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
+/*
+ * @brief 设置Topic的默认订阅选项
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param options 订阅选项
+ * @return 0成功，-1失败
+ */
+int topic_set_sub_defaults(topic_bus_t* bus, uint16_t topic_id, const topic_sub_options_t* options) {
+    if (!bus || !options) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    if (entry) {
+        entry->sub_defaults = *options;
+    }
+
+    os_semaphore_give(bus->lock);
+    return entry ? 0 : -1;
+}
+#endif
+
+/*
+ * @brief 取消订阅Topic
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_unsubscribe(topic_bus_t* bus, uint16_t topic_id,
+                      void (*callback)(uint16_t, const void*, size_t, void*),
+                      void* user_data) {
+    if (!bus || !callback) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    if (!entry) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+
+    /* 查找订阅者，复制剩余订阅者到新数组后原子替换 */
+    topic_sub_array_t* old_subs = atomic_load_explicit(&entry->subscribers, memory_order_acquire);
+    size_t old_count = old_subs ? old_subs->count : 0;
+    size_t found = SIZE_MAX;
+    for (size_t i = 0; i < old_count; ++i) {
+        if (old_subs->subs[i].callback == callback && old_subs->subs[i].user_data == user_data) {
+            found = i;
+            break;
+        }
+    }
+    if (found == SIZE_MAX) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+
+    topic_sub_array_t* new_subs = NULL;
+    if (old_count > 1) {
+        new_subs = (topic_sub_array_t*)os_malloc(
+            sizeof(topic_sub_array_t) + sizeof(topic_subscription_t) * (old_count - 1));
+        if (!new_subs) {
+            os_semaphore_give(bus->lock);
+            return -1;
+        }
+        new_subs->retire_next = NULL;
+        new_subs->retire_epoch = 0;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+        new_subs->retire_async = NULL;
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+        new_subs->retire_hist = NULL;
+#endif
+        new_subs->count = old_count - 1;
+        memcpy(&new_subs->subs[0], &old_subs->subs[0], sizeof(topic_subscription_t) * found);
+        memcpy(&new_subs->subs[found], &old_subs->subs[found + 1],
+               sizeof(topic_subscription_t) * (old_count - found - 1));
+    }
+
+    atomic_store_explicit(&entry->subscribers, new_subs, memory_order_seq_cst);
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    /* 立即停止异步回调；旧数组过宽限期后再释放异步订阅者 */
+    topic_executor_close(old_subs->subs[found].async);
+    old_subs->retire_async = old_subs->subs[found].async;
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    old_subs->retire_hist = old_subs->subs[found].hist;
+#endif
+    __rcu_retire(bus, old_subs);
+
+    os_semaphore_give(bus->lock);
+    return 0;
+}
+
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+/* ---------------- 范围订阅 ---------------- */
+
+/*
+ * @brief 取得范围订阅数组的区间表
+ * @param arr 范围订阅数组
+ * @return 区间表（紧随subs[count]之后）
+ */
+static topic_range_t* __range_of(const topic_sub_array_t* arr) {
+    return (topic_range_t*)(void*)&((topic_sub_array_t*)(uintptr_t)arr)->subs[arr->count];
+}
+
+/*
+ * @brief 计算隐式区间树[lo, hi)各节点的max_last（根为区间中点）
+ * @param ranges 按first排序的区间表
+ * @param lo 起始下标
+ * @param hi 结束下标（不含）
+ * @return 子树中last的最大值，空子树返回0
+ */
+static uint16_t __range_build(topic_range_t* ranges, size_t lo, size_t hi) {
+    if (lo >= hi) return 0;
+    size_t mid = lo + (hi - lo) / 2;
+    uint16_t max_last = ranges[mid].last;
+    uint16_t left = __range_build(ranges, lo, mid);
+    uint16_t right = __range_build(ranges, mid + 1, hi);
+    if (left > max_last) max_last = left;
+    if (right > max_last) max_last = right;
+    ranges[mid].max_last = max_last;
+    return max_last;
+}
+
+/*
+ * @brief 在隐式区间树[lo, hi)中回调所有覆盖ctx->entry->topic_id的范围订阅者
+ * @details 子树max_last小于topic_id时整棵子树跳过；节点first大于topic_id时右子树跳过，
+ *          开销为O(log n + 命中数)
+ * @param ctx 分发上下文
+ * @param lo 起始下标
+ * @param hi 结束下标（不含）
+ */
+static void __range_dispatch(topic_range_ctx_t* ctx, size_t lo, size_t hi) {
+    uint16_t topic_id = ctx->entry->topic_id;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        const topic_range_t* range = &ctx->ranges[mid];
+        if (range->max_last < topic_id) return;
+        __range_dispatch(ctx, lo, mid);
+        if (range->first > topic_id) return;
+        if (range->last >= topic_id) {
+            const topic_subscription_t* sub = &ctx->arr->subs[mid];
+            TOPIC_TRACE_CB(TOPIC_TRACE_CALLBACK_BEGIN, topic_id, ctx->event_key, ctx->sub_base + mid);
+            sub->callback(topic_id, ctx->data, ctx->data_len, sub->user_data);
+            TOPIC_TRACE_CB(TOPIC_TRACE_CALLBACK_END, topic_id, ctx->event_key, ctx->sub_base + mid);
+#if TOPIC_BUS_ENABLE_HIST
+            if (ctx->hist) ctx->lap_us = __hist_lap(ctx->hist, NULL, ctx->lap_us);
+#endif
+        }
+        lo = mid + 1;
+    }
+}
+
+/*
+ * @brief 增加或删除一个范围订阅者：复制区间表、重建max_last后原子替换
+ * @param bus Topic总线指针
+ * @param first_id 起始topic_id（含）
+ * @param last_id 结束topic_id（含）
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param add 非0增加，0删除
+ * @return 0成功，-1失败
+ */
+static int __range_update(topic_bus_t* bus, uint16_t first_id, uint16_t last_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*),
+                          void* user_data, int add) {
+    if (!bus || !callback || first_id > last_id) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_sub_array_t* old_arr = atomic_load_explicit(&bus->range_subs, memory_order_acquire);
+    size_t old_count = old_arr ? old_arr->count : 0;
+    const topic_range_t* old_ranges = old_arr ? __range_of(old_arr) : NULL;
+
+    /* 增加：按(first, last)有序插入的位置；删除：匹配的下标 */
+    size_t pos = SIZE_MAX;
+    for (size_t i = 0; i < old_count; ++i) {
+        if (add) {
+            if (old_ranges[i].first > first_id ||
+                (old_ranges[i].first == first_id && old_ranges[i].last > last_id)) {
+                pos = i;
+                break;
+            }
+        } else if (old_ranges[i].first == first_id && old_ranges[i].last == last_id &&
+                   old_arr->subs[i].callback == callback && old_arr->subs[i].user_data == user_data) {
+            pos = i;
+            break;
+        }
+    }
+    if (add && pos == SIZE_MAX) {
+        pos = old_count;
+    }
+    if (pos == SIZE_MAX) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+
+    size_t new_count = add ? old_count + 1 : old_count - 1;
+    topic_sub_array_t* new_arr = NULL;
+    if (new_count > 0) {
+        new_arr = (topic_sub_array_t*)os_malloc(sizeof(topic_sub_array_t) +
+                                                (sizeof(topic_subscription_t) + sizeof(topic_range_t)) * new_count);
+        if (!new_arr) {
+            os_semaphore_give(bus->lock);
+            return -1;
+        }
+        new_arr->retire_next = NULL;
+        new_arr->retire_epoch = 0;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+        new_arr->retire_async = NULL;
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+        new_arr->retire_hist = NULL;
+#endif
+        new_arr->count = new_count;
+        topic_range_t* new_ranges = __range_of(new_arr);
+
+        /* 旧表中pos之前的元素位置不变，之后的元素增加时后移一位、删除时前移一位 */
+        size_t tail = add ? old_count - pos : old_count - pos - 1;
+        size_t src = add ? pos : pos + 1;
+        size_t dst = add ? pos + 1 : pos;
+        if (pos > 0) {
+            memcpy(new_arr->subs, old_arr->subs, sizeof(topic_subscription_t) * pos);
+            memcpy(new_ranges, old_ranges, sizeof(topic_range_t) * pos);
+        }
+        if (tail > 0) {
+            memcpy(&new_arr->subs[dst], &old_arr->subs[src], sizeof(topic_subscription_t) * tail);
+            memcpy(&new_ranges[dst], &old_ranges[src], sizeof(topic_range_t) * tail);
+        }
+        if (add) {
+            memset(&new_arr->subs[pos], 0, sizeof(topic_subscription_t));
+            new_arr->subs[pos].callback = callback;
+            new_arr->subs[pos].user_data = user_data;
+            new_ranges[pos].first = first_id;
+            new_ranges[pos].last = last_id;
+        }
+        (void)__range_build(new_ranges, 0, new_count);
+    }
+
+    atomic_store_explicit(&bus->range_subs, new_arr, memory_order_seq_cst);
+    __rcu_retire(bus, old_arr);
+
+    os_semaphore_give(bus->lock);
+    return 0;
+}
+
+/*
+ * @brief 将前缀掩码转换为topic_id范围
+ * @param topic_id 前缀值
+ * @param mask 前缀掩码（高位连续的1）
+ * @param first_id 输出起始topic_id
+ * @param last_id 输出结束topic_id
+ * @return 0成功，-1掩码不是前缀形式
+ */
+static int __mask_to_range(uint16_t topic_id, uint16_t mask, uint16_t* first_id, uint16_t* last_id) {
+    uint16_t host = (uint16_t)~mask;
+    if ((host & (uint16_t)(host + 1U)) != 0) return -1;  /* 低位须为连续的0 */
+    *first_id = (uint16_t)(topic_id & mask);
+    *last_id = (uint16_t)(*first_id | host);
+    return 0;
+}
+
+/*
+ * @brief 订阅一段topic_id
+ * @param bus Topic总线指针
+ * @param first_id 起始topic_id（含）
+ * @param last_id 结束topic_id（含）
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_subscribe_range(topic_bus_t* bus, uint16_t first_id, uint16_t last_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*),
+                          void* user_data) {
+    return __range_update(bus, first_id, last_id, callback, user_data, 1);
+}
+
+/*
+ * @brief 取消范围订阅
+ * @param bus Topic总线指针
+ * @param first_id 起始topic_id（含）
+ * @param last_id 结束topic_id（含）
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_unsubscribe_range(topic_bus_t* bus, uint16_t first_id, uint16_t last_id,
+                            void (*callback)(uint16_t, const void*, size_t, void*),
+                            void* user_data) {
+    return __range_update(bus, first_id, last_id, callback, user_data, 0);
+}
+
+/*
+ * @brief 按前缀掩码订阅
+ * @param bus Topic总线指针
+ * @param topic_id 前缀值
+ * @param mask 前缀掩码
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_subscribe_mask(topic_bus_t* bus, uint16_t topic_id, uint16_t mask,
+                         void (*callback)(uint16_t, const void*, size_t, void*),
+                         void* user_data) {
+    uint16_t first_id, last_id;
+    if (__mask_to_range(topic_id, mask, &first_id, &last_id) != 0) return -1;
+    return __range_update(bus, first_id, last_id, callback, user_data, 1);
+}
+
+/*
+ * @brief 取消前缀掩码订阅
+ * @param bus Topic总线指针
+ * @param topic_id 前缀值
+ * @param mask 前缀掩码
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_unsubscribe_mask(topic_bus_t* bus, uint16_t topic_id, uint16_t mask,
+                           void (*callback)(uint16_t, const void*, size_t, void*),
+                           void* user_data) {
+    uint16_t first_id, last_id;
+    if (__mask_to_range(topic_id, mask, &first_id, &last_id) != 0) return -1;
+    return __range_update(bus, first_id, last_id, callback, user_data, 0);
+}
+#endif
+
+/* ---------------- 事件发布 ---------------- */
+
+#if TOPIC_BUS_ENABLE_RECORD
+/*
+ * @brief 录制一次发布（未录制时只有一次原子加载）
+ * @param bus Topic总线指针
+ * @param type 记录类型
+ * @param key event_key或topic_id
+ * @param data 负载（可为NULL）
+ * @param len 负载长度
+ */
+static void __record(topic_bus_t* bus, uint8_t type, uint16_t key, const void* data, size_t len) {
+    if (!atomic_load_explicit(&bus->recorder, memory_order_relaxed)) return;
+
+    /* 在读区内重新加载：topic_recorder_stop摘除录制端后等待读区退出，再销毁锁与映射 */
+    uint32_t rcu_idx = __rcu_read_lock(bus);
+    topic_recorder_t* recorder = atomic_load_explicit(&bus->recorder, memory_order_seq_cst);
+    if (recorder) {
+        (void)topic_recorder_append(recorder, type, key, data, len, 0);
+    }
+    __rcu_read_unlock(bus, rcu_idx);
+}
+#endif
+
+/*
+ * @brief 发布事件（任务模式）
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @return 0成功，-1失败
+ */
+int topic_publish_event(topic_bus_t* bus, obj_dict_key_t event_key) {
+    if (!bus) return -1;
+#if TOPIC_BUS_ENABLE_RECORD
+    __record(bus, TOPIC_RECORD_PUBLISH, event_key, NULL, 0);
+#endif
+    uint64_t publish_ts_us = __hist_clock(bus);
+
+    /* 加锁前取得事件的数据时间戳；事件不在对象字典中时为0，只有不判断时效性的事件仍可触发 */
+    uint64_t event_ts_us = __dict_event_ts(bus, event_key);
+
+    TOPIC_TRACE(TOPIC_TRACE_PUBLISH_BEGIN, 0xFFFF, event_key, 0);
+    if (os_semaphore_take(bus->lock, 100) < 0) {
+        TOPIC_TRACE(TOPIC_TRACE_PUBLISH_END, 0xFFFF, event_key, 0);
+        return -1;
+    }
+
+    /* 收集需要触发的Topic条目（避免在持有锁时调用回调） */
+    topic_entry_t* entries_to_trigger[TOPIC_BUS_MAX_TOPICS];
+    size_t trigger_count = __collect_triggered_locked(bus, event_key, event_ts_us, NULL, 0,
+                                                      entries_to_trigger, TOPIC_BUS_MAX_TOPICS);
+    /* 顺带回收退役的订阅者数组：取消订阅之后不再有订阅变更时也能及时释放（不阻塞） */
+    if (bus->rcu_retired) {
+        __rcu_reclaim(bus);
+    }
+
+    /* 释放锁，避免在回调期间持有锁导致死锁 */
+    os_semaphore_give(bus->lock);
+
+    if (trigger_count == 0) {
+        TOPIC_TRACE(TOPIC_TRACE_PUBLISH_END, 0xFFFF, event_key, 0);
+        return 0;
+    }
+
+    /* 数据只借用一次，全部触发的Topic共享同一份数据 */
+    obj_dict_view_t view;
+    __dict_payload_acquire(bus, event_key, &view);
+
+    /* 在无锁状态下触发回调（避免死锁，同时允许并发回调） */
+    __dispatch_triggered(bus, entries_to_trigger, trigger_count, event_key, view.data, view.len, 0, publish_ts_us);
+
+    /* 回调与路由完成后归还借用 */
+    obj_dict_return(&view);
+
+    TOPIC_TRACE(TOPIC_TRACE_PUBLISH_END, 0xFFFF, event_key, 0);
+    return 0;
+}
+
+/*
+ * @brief 手动发布Topic
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @return 0成功，-1失败
+ */
+int topic_publish_manual(topic_bus_t* bus, uint16_t topic_id) {
+    if (!bus) return -1;
+#if TOPIC_BUS_ENABLE_RECORD
+    __record(bus, TOPIC_RECORD_MANUAL, topic_id, NULL, 0);
+#endif
+    uint64_t publish_ts_us = __hist_clock(bus);
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    if (!entry) {
+        os_semaphore_give(bus->lock);
+        return -1;
+    }
+
+    /* 检查是否为手动触发类型；手动触发时使用规则的第一个事件（如果有） */
+    int manual = (entry->rule.type == TOPIC_RULE_MANUAL);
+    obj_dict_key_t first_event = (entry->rule.events && entry->rule.event_count > 0)
+                                 ? entry->rule.events[0] : 0;
+
+    /* 释放锁后再回调：回调中可订阅/取消订阅/拉取历史，与topic_publish_event一致 */
+    os_semaphore_give(bus->lock);
+    if (!manual) return 0;
+
+    obj_dict_view_t view;
+    __dict_payload_acquire(bus, first_event, &view);
+    TOPIC_TRACE(TOPIC_TRACE_PUBLISH_BEGIN, topic_id, first_event, 0);
+    __dispatch_triggered(bus, &entry, 1, first_event, view.data, view.len, 0, publish_ts_us);
+    TOPIC_TRACE(TOPIC_TRACE_PUBLISH_END, topic_id, first_event, 0);
+    obj_dict_return(&view);
+    return 0;
+}
+
+#if TOPIC_BUS_ENABLE_ISR
+/*
+ * @brief ISR安全发布事件
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @return 0成功，-1失败
+ */
+int topic_publish_isr(topic_bus_t* bus, obj_dict_key_t event_key) {
+    if (!bus || !bus->isr_queue) return -1;
+
+    topic_bus_isr_event_t evt = { .event_key = event_key };
+#if TOPIC_BUS_ENABLE_HIST
+    evt.ts_us = __hist_clock(bus);
+#endif
+    if (ring_buffer_mpmc_write(bus->isr_queue, &evt) < 0) {
+        return -1;
+    }
+
+    /* 入队与读取等待标志之间需全序，与topic_bus_wait_isr配对避免丢失唤醒 */
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&bus->isr_waiting, memory_order_relaxed) &&
+        atomic_exchange_explicit(&bus->isr_waiting, 0, memory_order_acq_rel)) {
+        (void)os_semaphore_give_isr(bus->isr_signal);
+    }
+
+    return 0;
+}
+#endif
+
+#if TOPIC_BUS_ENABLE_LOAN
+/* ---------------- 借出缓冲（零拷贝发布） ---------------- */
+
+/*
+ * @brief 初始化借出缓冲池
+ * @param bus Topic总线指针
+ * @param payload_size 单个缓冲最大负载（字节）
+ * @param block_count 缓冲数量
+ * @return 0成功，-1失败
+ */
+int topic_bus_loan_pool_init(topic_bus_t* bus, size_t payload_size, size_t block_count) {
+    if (!bus || payload_size == 0 || block_count == 0 || bus->loan_pool) return -1;
+
+    /* 块大小向上取16字节，保证相邻块的负载同样对齐 */
+    size_t block_size = (TOPIC_LOAN_HDR_SIZE + payload_size + 15U) & ~(size_t)15U;
+    bus->loan_pool = obj_dict_mempool_create(block_size, block_count);
+    if (!bus->loan_pool) return -1;
+    bus->loan_capacity = block_size - TOPIC_LOAN_HDR_SIZE;
+    return 0;
+}
+
+/*
+ * @brief 借出一个缓冲
+ * @param bus Topic总线指针
+ * @param size 需要的负载大小（字节）
+ * @return 负载指针，失败返回NULL
+ */
+void* topic_loan(topic_bus_t* bus, size_t size) {
+    if (!bus || !bus->loan_pool || size == 0 || size > bus->loan_capacity) return NULL;
+
+    topic_loan_hdr_t* hdr = (topic_loan_hdr_t*)obj_dict_mempool_alloc(bus->loan_pool, TOPIC_LOAN_HDR_SIZE + size);
+    if (!hdr) return NULL;
+    hdr->magic = TOPIC_LOAN_MAGIC;
+    hdr->pool = bus->loan_pool;
+    atomic_init(&hdr->ref_count, 1);  /* 生产者持有初始引用 */
+    return (uint8_t*)hdr + TOPIC_LOAN_HDR_SIZE;
+}
+
+/*
+ * @brief 判断payload是否为本总线借出的缓冲（先按地址核对缓冲池，再读头部）
+ * @param bus Topic总线指针
+ * @param payload 负载指针
+ * @return 1是，0否
+ */
+static int __loan_owned(topic_bus_t* bus, const void* payload) {
+    if (!bus || !bus->loan_pool || !payload || (uintptr_t)payload < TOPIC_LOAN_HDR_SIZE) return 0;
+    topic_loan_hdr_t* hdr = TOPIC_LOAN_HDR(payload);
+    return obj_dict_mempool_owns(bus->loan_pool, hdr) && hdr->magic == TOPIC_LOAN_MAGIC;
+}
+
+/*
+ * @brief 增加借出缓冲引用计数
+ * @param bus Topic总线指针
+ * @param payload 负载指针
+ * @return 0成功，-1不是本总线的借出缓冲
+ */
+int topic_loan_retain(topic_bus_t* bus, const void* payload) {
+    if (!__loan_owned(bus, payload)) return -1;
+    topic_loan_hold(payload);
+    return 0;
+}
+
+/*
+ * @brief 释放借出缓冲引用，计数归零时归还缓冲池
+ * @param bus Topic总线指针
+ * @param payload 负载指针
+ */
+void topic_loan_release(topic_bus_t* bus, const void* payload) {
+    if (!__loan_owned(bus, payload)) return;
+    topic_loan_drop(payload);
+}
+
+/*
+ * @brief 增加借出缓冲引用计数（不检查归属）
+ * @param payload 已确认的借出缓冲
+ */
+void topic_loan_hold(const void* payload) {
+    atomic_fetch_add_explicit(&TOPIC_LOAN_HDR(payload)->ref_count, 1, memory_order_relaxed);
+}
+
+/*
+ * @brief 释放借出缓冲引用（不检查归属），计数归零时归还缓冲池
+ * @param payload 已确认的借出缓冲
+ */
+void topic_loan_drop(const void* payload) {
+    topic_loan_hdr_t* hdr = TOPIC_LOAN_HDR(payload);
+    if (atomic_fetch_sub_explicit(&hdr->ref_count, 1, memory_order_acq_rel) == 1) {
+        hdr->magic = 0;
+        obj_dict_mempool_free(hdr->pool, hdr);
+    }
+}
+
+/*
+ * @brief 发布借出缓冲
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @param payload topic_loan返回的负载指针（所有权转移给总线）
+ * @param len 有效数据长度
+ * @return 0成功，-1失败
+ */
+int topic_publish_loaned(topic_bus_t* bus, obj_dict_key_t event_key, void* payload, size_t len) {
+    if (!__loan_owned(bus, payload)) return -1;  /* 不是本总线的借出缓冲，不能代为释放 */
+    if (len > bus->loan_capacity) {
+        topic_loan_drop(payload);
+        return -1;
+    }
+
+#if TOPIC_BUS_ENABLE_RECORD
+    __record(bus, TOPIC_RECORD_LOANED, event_key, payload, len);
+#endif
+
+    /* 借出缓冲的数据时间戳即发布时刻，触发事件无需查询对象字典 */
+    uint64_t event_ts_us = os_monotonic_time_get_microsecond();
+
+    TOPIC_TRACE(TOPIC_TRACE_PUBLISH_BEGIN, 0xFFFF, event_key, 0);
+    if (os_semaphore_take(bus->lock, 100) < 0) {
+        TOPIC_TRACE(TOPIC_TRACE_PUBLISH_END, 0xFFFF, event_key, 0);
+        topic_loan_drop(payload);
+        return -1;
+    }
+    topic_entry_t* entries_to_trigger[TOPIC_BUS_MAX_TOPICS];
+    size_t trigger_count = __collect_triggered_locked(bus, event_key, event_ts_us, payload, len,
+                                                      entries_to_trigger, TOPIC_BUS_MAX_TOPICS);
+    os_semaphore_give(bus->lock);
+
+    /* 同一缓冲直接交给全部订阅者与Router，无拷贝 */
+    __dispatch_triggered(bus, entries_to_trigger, trigger_count, event_key, payload, len, 1, event_ts_us);
+
+    /* 释放生产者转交的引用；订阅者如需继续持有应自行retain */
+    topic_loan_drop(payload);
+    TOPIC_TRACE(TOPIC_TRACE_PUBLISH_END, 0xFFFF, event_key, 0);
+    return 0;
+}
+#endif
+
+/* ---------------- 查询与管理 ---------------- */
+
+#if TOPIC_BUS_ENABLE_ISR
+/*
+ * @brief 处理ISR队列中的事件（任务模式调用）
+ * @param bus Topic总线指针
+ */
+void topic_bus_process_isr_queue(topic_bus_t* bus) {
+    if (!bus || !bus->isr_queue) return;
+
+    /* 批量排空，每批只加锁一次 */
+    while (topic_bus_drain_isr_batch(bus, 0, NULL) > 0) {
+    }
+}
+
+/*
+ * @brief 批量排空ISR队列一批事件（任务模式调用）
+ * @param bus Topic总线指针
+ * @param coalesce 非0表示合并重复event_key
+ * @param distinct_out 输出：本批实际评估的事件数（可为NULL）
+ * @return 本批出队的事件数，0表示队列为空
+ */
+size_t topic_bus_drain_isr_batch(topic_bus_t* bus, int coalesce, size_t* distinct_out) {
+    if (distinct_out) *distinct_out = 0;
+    if (!bus || !bus->isr_queue) return 0;
+
+    topic_bus_isr_event_t events[TOPIC_BUS_ISR_DRAIN_BATCH];
+    size_t drained = ring_buffer_mpmc_read_bulk(bus->isr_queue, events, TOPIC_BUS_ISR_DRAIN_BATCH);
+    if (drained == 0) return 0;
+    TOPIC_TRACE(TOPIC_TRACE_DRAIN_BEGIN, 0xFFFF, 0, drained);
+#if TOPIC_BUS_ENABLE_RECORD
+    /* ISR发布在排空时按出队顺序录制，回放时以topic_publish_event施加 */
+    for (size_t i = 0; i < drained; ++i) {
+        __record(bus, TOPIC_RECORD_PUBLISH, events[i].event_key, NULL, 0);
+    }
+#endif
+
+    /* 合并重复事件：保留首次出现的位置，数据取对象字典中的最新值 */
+    size_t distinct = drained;
+    if (coalesce) {
+        distinct = 0;
+        for (size_t i = 0; i < drained; ++i) {
+            size_t j = 0;
+            while (j < distinct && events[j].event_key != events[i].event_key) {
+                ++j;
+            }
+            if (j == distinct) {
+                events[distinct++] = events[i];
+            }
+        }
+    }
+    if (distinct_out) *distinct_out = distinct;
+
+    /* 单事件最多触发的Topic数，与topic_publish_event保持一致 */
+    const size_t per_key_max = (TOPIC_BUS_MAX_TOPICS < TOPIC_BUS_ISR_DRAIN_MAX_TRIGGERS)
+                             ? TOPIC_BUS_MAX_TOPICS : TOPIC_BUS_ISR_DRAIN_MAX_TRIGGERS;
+    topic_entry_t* triggered[TOPIC_BUS_ISR_DRAIN_MAX_TRIGGERS];
+    size_t key_end[TOPIC_BUS_ISR_DRAIN_BATCH];
+
+    /* 加锁前取得每个事件的数据时间戳，锁内评估不再访问对象字典 */
+    uint64_t event_ts[TOPIC_BUS_ISR_DRAIN_BATCH];
+    for (size_t i = 0; i < distinct; ++i) {
+        event_ts[i] = __dict_event_ts(bus, events[i].event_key);
+    }
+
+    size_t next = 0;
+    while (next < distinct) {
+        if (os_semaphore_take(bus->lock, 100) < 0) break;
+
+        /* 同一次加锁内评估尽可能多的事件；剩余容量不足以容纳下一事件的全部候选Topic时先分发 */
+        size_t first = next;
+        size_t total = 0;
+        while (next < distinct) {
+            obj_dict_key_t key = events[next].event_key;
+            size_t candidates = 0;
+            for (topic_event_link_t* link = bus->event_index[__event_bucket(bus, key)]; link; link = link->next) {
+                if (link->event_key == key) ++candidates;
+            }
+            if (candidates > per_key_max) candidates = per_key_max;
+            if (next > first && total + candidates > TOPIC_BUS_ISR_DRAIN_MAX_TRIGGERS) break;
+
+            total += __collect_triggered_locked(bus, key, event_ts[next], NULL, 0,
+                                                &triggered[total], per_key_max);
+            key_end[next++] = total;
+        }
+        if (bus->rcu_retired) {
+            __rcu_reclaim(bus);  /* 与topic_publish_event相同，顺带回收退役的订阅者数组 */
+        }
+        os_semaphore_give(bus->lock);
+
+        /* 无锁分发：每个事件的数据只借用一次 */
+        size_t begin = 0;
+        for (size_t k = first; k < next; ++k) {
+            size_t count = key_end[k] - begin;
+            if (count > 0) {
+                obj_dict_key_t key = events[k].event_key;
+                obj_dict_view_t view;
+                __dict_payload_acquire(bus, key, &view);
+#if TOPIC_BUS_ENABLE_HIST
+                uint64_t publish_ts_us = events[k].ts_us;  /* 合并模式下取首次入队时刻 */
+#else
+                uint64_t publish_ts_us = 0;
+#endif
+                __dispatch_triggered(bus, &triggered[begin], count, key, view.data, view.len, 0, publish_ts_us);
+                obj_dict_return(&view);
+            }
+            begin = key_end[k];
+        }
     }
 
-#if TOPIC_BUS_ENABLE_ROUTER
-    bus->router = NULL;  /* 初始化Router为NULL */
-#endif
+    TOPIC_TRACE(TOPIC_TRACE_DRAIN_END, 0xFFFF, 0, drained);
+    return drained;
+}
 
-    /* 创建锁 */
-    bus->lock = os_semaphore_create(1, "topic_bus_lock");
-    if (!bus->lock) return -1;
+/*
+ * @brief 等待ISR队列出现事件（任务模式调用）
+ * @param bus Topic总线指针
+ * @param timeout_ms 最长等待时间（毫秒），0表示只检查不等待
+ * @return 1队列有事件，0超时，-1失败
+ */
+int topic_bus_wait_isr(topic_bus_t* bus, uint32_t timeout_ms) {
+    if (!bus || !bus->isr_queue || !bus->isr_signal) return -1;
+    if (ring_buffer_mpmc_get_count(bus->isr_queue) > 0) return 1;
+    if (timeout_ms == 0) return 0;
 
-#if TOPIC_BUS_ENABLE_ISR
-    /* 创建ISR队列 */
-    bus->isr_queue = ring_buffer_create(TOPIC_BUS_ISR_QUEUE_SIZE, sizeof(topic_bus_isr_event_t));
-    if (!bus->isr_queue) {
-        os_semaphore_destroy(bus->lock);
-        return -1;
+    /* 先登记等待再复查队列：生产者要么看到等待标志，要么入队已对此处可见 */
+    atomic_store_explicit(&bus->isr_waiting, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    if (ring_buffer_mpmc_get_count(bus->isr_queue) > 0) {
+        atomic_store_explicit(&bus->isr_waiting, 0, memory_order_relaxed);
+        return 1;
     }
-#endif
 
-    return 0;
+    ssize_t rc = os_semaphore_take(bus->isr_signal, timeout_ms);
+    atomic_store_explicit(&bus->isr_waiting, 0, memory_order_relaxed);
+    if (rc < 0) return -1;
+    return (ring_buffer_mpmc_get_count(bus->isr_queue) > 0) ? 1 : 0;
 }
 
-/* ---------------- 规则管理 ---------------- */
+/*
+ * @brief 唤醒topic_bus_wait_isr的等待者
+ * @param bus Topic总线指针
+ */
+void topic_bus_isr_wakeup(topic_bus_t* bus) {
+    if (!bus || !bus->isr_signal) return;
+    (void)os_semaphore_give(bus->isr_signal);
+}
+#endif
 
+#if TOPIC_BUS_ENABLE_STATS
 /*
- * @brief 创建Topic规则
+ * @brief 获取Topic事件计数
  * @param bus Topic总线指针
  * @param topic_id Topic ID
- * @param rule 规则指针
- * @return 0成功，-1失败
+ * @return 事件计数，失败返回-1
  */
-int topic_rule_create(topic_bus_t* bus, uint16_t topic_id, const topic_rule_t* rule) {
-    if (!bus || !rule) return -1;
+int64_t topic_bus_get_event_count(topic_bus_t* bus, uint16_t topic_id) {
+    if (!bus) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
     topic_entry_t* entry = __find_topic(bus, topic_id);
-    if (!entry) {
-        entry = __find_free_topic_slot(bus);
-        if (!entry) {
-            os_semaphore_give(bus->lock);
-            return -1;
-        }
-        entry->topic_id = topic_id;
-    }
-
-    /* 释放旧的事件数组和超时数组（如果存在） */
-    if (entry->rule.events) {
-        os_free(entry->rule.events);
-        entry->rule.events = NULL;
-    }
-    if (entry->rule.event_timeouts_ms) {
-        os_free(entry->rule.event_timeouts_ms);
-        entry->rule.event_timeouts_ms = NULL;
-    }
-
-    /* 复制规则基本字段 */
-    entry->rule.type = rule->type;
-    entry->rule.event_count = rule->event_count;
-    
-    /* 初始化trigger_mask（确保原子类型正确初始化） */
+    int64_t count = -1;
+    if (entry) {
 #if TOPIC_BUS_ENABLE_ATOMICS
-    atomic_init(&entry->rule.trigger_mask, 0);
+        count = (int64_t)atomic_load_explicit(&entry->event_count, memory_order_acquire);
 #else
-    entry->rule.trigger_mask = 0;
+        count = entry->event_count;
 #endif
-    topic_rule_reset_mask(&entry->rule);
+    }
 
-#if TOPIC_BUS_ENABLE_RULE_CACHE
-    entry->rule.last_event_key_cached   = 0;
-    entry->rule.last_can_trigger_cached = 0;
+    os_semaphore_give(bus->lock);
+    return count;
+}
+
+/*
+ * @brief 获取Topic被规则过滤的事件数（去抖/限频/边沿/窗口未满）
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @return 过滤计数，失败返回-1
+ */
+int64_t topic_bus_get_suppressed_count(topic_bus_t* bus, uint16_t topic_id) {
+    if (!bus) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    int64_t count = entry ? (int64_t)entry->rule.suppressed_count : -1;
+
+    os_semaphore_give(bus->lock);
+    return count;
+}
 #endif
 
-    /* 复制事件数组 */
-    if (rule->events && rule->event_count > 0) {
-        entry->rule.events = (obj_dict_key_t*)os_malloc(sizeof(obj_dict_key_t) * rule->event_count);
-        if (!entry->rule.events) {
-            os_semaphore_give(bus->lock);
-            return -1;
-        }
-        memcpy(entry->rule.events, rule->events, sizeof(obj_dict_key_t) * rule->event_count);
-    } else {
-        entry->rule.events = NULL;
+#if TOPIC_BUS_ENABLE_HIST
+/* ---------------- 延迟直方图 ---------------- */
+
+/*
+ * @brief 开启/关闭直方图记录
+ * @param bus Topic总线指针
+ * @param enable 非0开启
+ * @return 0成功，-1失败
+ */
+int topic_bus_hist_enable(topic_bus_t* bus, int enable) {
+    if (!bus) return -1;
+    if (!enable) {
+        atomic_store_explicit(&bus->hist_enabled, 0, memory_order_relaxed);
+        return 0;
     }
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
-    /* 复制超时数组 */
-    if (rule->event_timeouts_ms && rule->event_count > 0) {
-        entry->rule.event_timeouts_ms = (uint32_t*)os_malloc(sizeof(uint32_t) * rule->event_count);
-        if (!entry->rule.event_timeouts_ms) {
-            if (entry->rule.events) {
-                os_free(entry->rule.events);
-                entry->rule.events = NULL;
-            }
-            os_semaphore_give(bus->lock);
-            return -1;
+    /* 首次开启时分配：之后创建规则与订阅时看到hist_enabled随即分配（均在bus->lock内） */
+    int ret = 0;
+    for (size_t i = 0; i < bus->max_topics && ret == 0; ++i) {
+        topic_entry_t* entry = &bus->topics[i];
+        if (entry->topic_id == 0xFFFF) continue;
+        size_t static_count = 0;
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+        static_count = entry->static_sub_count;
+#endif
+        ret = __entry_hist_alloc(entry, static_count);
+        if (ret == 0) {
+            ret = __entry_sub_hist_alloc(bus, entry);
         }
-        memcpy(entry->rule.event_timeouts_ms, rule->event_timeouts_ms, sizeof(uint32_t) * rule->event_count);
-    } else {
-        entry->rule.event_timeouts_ms = NULL;
+    }
+    if (ret == 0) {
+        atomic_store_explicit(&bus->hist_enabled, 1, memory_order_relaxed);
     }
 
     os_semaphore_give(bus->lock);
-    return 0;
+    return ret;
 }
 
-/* ---------------- 订阅管理 ---------------- */
-
 /*
- * @brief 订阅Topic
+ * @brief 读取Topic级直方图快照
  * @param bus Topic总线指针
  * @param topic_id Topic ID
- * @param callback 回调函数
- * @param user_data 用户数据
+ * @param kind 直方图类别
+ * @param snap 输出快照
  * @return 0成功，-1失败
  */
-int topic_subscribe(topic_bus_t* bus, uint16_t topic_id,
-                    void (*callback)(uint16_t, const void*, size_t, void*),
-                    void* user_data) {
-    if (!bus || !callback) return -1;
+int topic_bus_get_hist(topic_bus_t* bus, uint16_t topic_id, topic_hist_kind_t kind, topic_hist_snapshot_t* snap) {
+    if (!bus || !snap) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
     topic_entry_t* entry = __find_topic(bus, topic_id);
-    if (!entry) {
-        os_semaphore_give(bus->lock);
-        return -1;
+    topic_hist_set_t* set = entry ? atomic_load_explicit(&entry->hist, memory_order_relaxed) : NULL;
+    const topic_hist_t* hist = NULL;
+    if (set) {
+        switch (kind) {
+            case TOPIC_HIST_LATENCY:  hist = &set->latency;  break;
+            case TOPIC_HIST_CALLBACK: hist = &set->callback; break;
+            case TOPIC_HIST_ROUTER:   hist = &set->router;   break;
+            default: break;
+        }
     }
-
-    /* 分配订阅者节点 */
-    topic_subscription_t* sub = (topic_subscription_t*)os_malloc(sizeof(topic_subscription_t));
-    if (!sub) {
-        os_semaphore_give(bus->lock);
-        return -1;
+    if (hist) {
+        topic_hist_snapshot(hist, snap);
     }
 
-    sub->callback = callback;
-    sub->user_data = user_data;
-    sub->next = entry->subscribers;
-    entry->subscribers = sub;
-
     os_semaphore_give(bus->lock);
-    return 0;
+    return hist ? 0 : -1;
 }
 
 /*
- * @brief 取消订阅Topic
+ * @brief 读取第index个订阅者的回调耗时直方图
  * @param bus Topic总线指针
  * @param topic_id Topic ID
- * @param callback 回调函数
- * @param user_data 用户数据
+ * @param index 订阅者序号
+ * @param out 输出：订阅者标识与直方图快照
  * @return 0成功，-1失败
  */
-int topic_unsubscribe(topic_bus_t* bus, uint16_t topic_id,
-                      void (*callback)(uint16_t, const void*, size_t, void*),
-                      void* user_data) {
-    if (!bus || !callback) return -1;
+int topic_bus_get_sub_hist(topic_bus_t* bus, uint16_t topic_id, size_t index, topic_sub_hist_t* out) {
+    if (!bus || !out) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
     topic_entry_t* entry = __find_topic(bus, topic_id);
-    if (!entry) {
-        os_semaphore_give(bus->lock);
-        return -1;
+    topic_hist_t* hist = entry ? __sub_hist_at(entry, index, out) : NULL;
+    if (hist) {
+        topic_hist_snapshot(hist, &out->hist);
     }
 
-    /* 从链表中删除订阅者 */
-    topic_subscription_t* prev = NULL;
-    topic_subscription_t* curr = entry->subscribers;
-    while (curr) {
-        if (curr->callback == callback && curr->user_data == user_data) {
-            if (prev) {
-                prev->next = curr->next;
-            } else {
-                entry->subscribers = curr->next;
-            }
-            os_free(curr);
-            break;
+    os_semaphore_give(bus->lock);
+    return hist ? 0 : -1;
+}
+
+/*
+ * @brief 清零直方图
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID，TOPIC_BUS_HIST_ALL_TOPICS表示全部
+ * @return 0成功，-1失败
+ */
+int topic_bus_hist_reset(topic_bus_t* bus, uint16_t topic_id) {
+    if (!bus) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
+
+    int found = 0;
+    for (size_t i = 0; i < bus->max_topics; ++i) {
+        topic_entry_t* entry = &bus->topics[i];
+        topic_hist_set_t* set = atomic_load_explicit(&entry->hist, memory_order_relaxed);
+        if (entry->topic_id == 0xFFFF || !set) continue;
+        if (topic_id != TOPIC_BUS_HIST_ALL_TOPICS && entry->topic_id != topic_id) continue;
+
+        topic_hist_reset(&set->latency);
+        topic_hist_reset(&set->callback);
+        topic_hist_reset(&set->router);
+        topic_sub_hist_t info;
+        topic_hist_t* hist;
+        for (size_t j = 0; (hist = __sub_hist_at(entry, j, &info)) != NULL; ++j) {
+            topic_hist_reset(hist);
         }
-        prev = curr;
-        curr = curr->next;
+        found = 1;
     }
 
     os_semaphore_give(bus->lock);
-    return (curr != NULL) ? 0 : -1;
+    return found ? 0 : -1;
 }
 
-/* ---------------- 事件发布 ---------------- */
-
 /*
- * @brief 发布事件（任务模式）
+ * @brief 打印直方图摘要，并标出p99最大的订阅者
  * @param bus Topic总线指针
- * @param event_key 事件键
+ * @param topic_id Topic ID，TOPIC_BUS_HIST_ALL_TOPICS表示全部
  * @return 0成功，-1失败
  */
-int topic_publish_event(topic_bus_t* bus, obj_dict_key_t event_key) {
+int topic_bus_hist_dump(topic_bus_t* bus, uint16_t topic_id) {
     if (!bus) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
-    /* 收集需要触发的Topic条目（避免在持有锁时调用回调） */
-    topic_entry_t* entries_to_trigger[TOPIC_BUS_MAX_TOPICS];
-    size_t trigger_count = 0;
+    int found = 0;
+    uint16_t worst_topic = 0xFFFF;
+    size_t worst_index = 0;
+    uint32_t worst_p99 = 0;
+    void* worst_callback = NULL;
+    topic_sub_hist_t info;
 
-    /* 遍历所有Topic，检查是否匹配 */
     for (size_t i = 0; i < bus->max_topics; ++i) {
         topic_entry_t* entry = &bus->topics[i];
-        if (entry->topic_id == 0xFFFF) continue;  /* 空槽跳过 */
-        
-        /* 检查规则是否有效 */
-        if (!entry->rule.events || entry->rule.event_count == 0) continue;  /* 规则无效，跳过 */
-
-        /* 检查规则是否匹配 */
-        if (topic_rule_can_trigger(&entry->rule, event_key)) {
-            /* 检查时效性 */
-            if (!topic_rule_check_timeout(&entry->rule, event_key, bus->obj_dict)) {
-                continue;  /* 时效性不满足，跳过该Topic */
-            }
-            
-            if (entry->rule.type == TOPIC_RULE_AND) {
-                /* AND规则：更新掩码并检查是否全部触发 */
-                topic_rule_update_mask(&entry->rule, event_key, 1);
-                if (topic_rule_matches(&entry->rule, event_key)) {
-                    /* 检查所有事件的时效性 */
-                    int all_timeout_ok = 1;
-                    for (size_t j = 0; j < entry->rule.event_count; ++j) {
-                        if (!topic_rule_check_timeout(&entry->rule, entry->rule.events[j], bus->obj_dict)) {
-                            all_timeout_ok = 0;
-                            break;
-                        }
-                    }
-                    
-                    if (all_timeout_ok) {
-                        /* 收集需要触发的条目 */
-                        if (trigger_count < TOPIC_BUS_MAX_TOPICS) {
-                            entries_to_trigger[trigger_count++] = entry;
-                        }
-                        /* 重置掩码，准备下次触发 */
-                        topic_rule_reset_mask(&entry->rule);
-                    } else {
-                        /* 有事件超时，不触发，重置掩码 */
-                        topic_rule_reset_mask(&entry->rule);
-                    }
-                }
-            } else if (entry->rule.type == TOPIC_RULE_OR) {
-                /* OR规则：收集需要触发的条目 */
-                if (trigger_count < TOPIC_BUS_MAX_TOPICS) {
-                    entries_to_trigger[trigger_count++] = entry;
-                }
-            }
+        topic_hist_set_t* set = atomic_load_explicit(&entry->hist, memory_order_relaxed);
+        if (entry->topic_id == 0xFFFF || !set) continue;
+        if (topic_id != TOPIC_BUS_HIST_ALL_TOPICS && entry->topic_id != topic_id) continue;
+        found = 1;
+
+        os_printf("Topic %u:\n", (unsigned)entry->topic_id);
+        topic_hist_snapshot(&set->latency, &info.hist);
+        topic_hist_print("latency", &info.hist);
+        topic_hist_snapshot(&set->callback, &info.hist);
+        topic_hist_print("callback(all)", &info.hist);
+        topic_hist_snapshot(&set->router, &info.hist);
+        if (info.hist.count > 0) {
+            topic_hist_print("router", &info.hist);
         }
-    }
 
-    /* 释放锁，避免在回调期间持有锁导致死锁 */
-    os_semaphore_give(bus->lock);
+        topic_hist_t* hist;
+        for (size_t j = 0; (hist = __sub_hist_at(entry, j, &info)) != NULL; ++j) {
+            char name[64];
+            snprintf(name, sizeof(name), "sub[%u]%s %p/%p", (unsigned)j,
+                     info.is_static ? "(static)" : (info.is_async ? "(async)" : ""),
+                     (void*)(uintptr_t)info.callback, info.user_data);
+            topic_hist_snapshot(hist, &info.hist);
+            topic_hist_print(name, &info.hist);
 
-    /* 在无锁状态下触发回调（避免死锁，同时允许并发回调） */
-    for (size_t i = 0; i < trigger_count; ++i) {
-        topic_entry_t* entry = entries_to_trigger[i];
-        __trigger_topic_callbacks(entry, event_key, bus);
-        
-        /* 更新统计信息 */
-#if TOPIC_BUS_ENABLE_STATS
-#if TOPIC_BUS_ENABLE_ATOMICS
-        /* 原子操作，无需锁 */
-        atomic_fetch_add_explicit(&entry->event_count, 1, memory_order_relaxed);
-#else
-        /* 非原子模式：需要重新获取锁以更新计数器 */
-        if (os_semaphore_take(bus->lock, 100) >= 0) {
-            entry->event_count++;
-            os_semaphore_give(bus->lock);
+            uint32_t p99 = topic_hist_percentile(&info.hist, 990);
+            if (p99 > worst_p99) {
+                worst_p99 = p99;
+                worst_topic = entry->topic_id;
+                worst_index = j;
+                worst_callback = (void*)(uintptr_t)info.callback;
+            }
         }
-#endif
-#endif
+    }
+    if (worst_topic != 0xFFFF) {
+        os_printf("slowest subscriber: topic %u sub[%u] %p p99=%lu us\n", (unsigned)worst_topic,
+                  (unsigned)worst_index, worst_callback, (unsigned long)worst_p99);
     }
 
-    return 0;
+    os_semaphore_give(bus->lock);
+    return found ? 0 : -1;
 }
+#endif
 
+#if TOPIC_BUS_ENABLE_ROUTER
 /*
- * @brief 手动发布Topic
+ * @brief 设置Topic Router
  * @param bus Topic总线指针
- * @param topic_id Topic ID
+ * @param router Router指针
  * @return 0成功，-1失败
  */
-int topic_publish_manual(topic_bus_t* bus, uint16_t topic_id) {
+int topic_bus_set_router(topic_bus_t* bus, topic_router_t* router) {
     if (!bus) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
-
-    topic_entry_t* entry = __find_topic(bus, topic_id);
-    if (!entry) {
-        os_semaphore_give(bus->lock);
-        return -1;
-    }
-
-    /* 检查是否为手动触发类型 */
-    if (entry->rule.type == TOPIC_RULE_MANUAL) {
-        /* 手动触发时，使用规则的第一个事件（如果有） */
-        obj_dict_key_t first_event = (entry->rule.events && entry->rule.event_count > 0) 
-                                     ? entry->rule.events[0] : 0;
-        __trigger_topic_callbacks(entry, first_event, bus);
-#if TOPIC_BUS_ENABLE_STATS
-#if TOPIC_BUS_ENABLE_ATOMICS
-        atomic_fetch_add_explicit(&entry->event_count, 1, memory_order_relaxed);
-#else
-        entry->event_count++;
-#endif
-#endif
-    }
-
+    
+    bus->router = router;
+    
     os_semaphore_give(bus->lock);
     return 0;
 }
+#endif
 
-#if TOPIC_BUS_ENABLE_ISR
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
 /*
- * @brief ISR安全发布事件
+ * @brief 设置异步订阅执行器
  * @param bus Topic总线指针
- * @param event_key 事件键
+ * @param executor 执行器指针
  * @return 0成功，-1失败
  */
-int topic_publish_isr(topic_bus_t* bus, obj_dict_key_t event_key) {
-    if (!bus || !bus->isr_queue) return -1;
+int topic_bus_set_executor(topic_bus_t* bus, topic_executor_t* executor) {
+    if (!bus) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
-    topic_bus_isr_event_t evt = { .event_key = event_key };
-    if (ring_buffer_write_isr(bus->isr_queue, &evt) < 0) {
-        return -1;
-    }
+    bus->executor = executor;
 
+    os_semaphore_give(bus->lock);
     return 0;
 }
-#endif
 
-/* ---------------- 查询与管理 ---------------- */
-
-#if TOPIC_BUS_ENABLE_ISR
+#if TOPIC_BUS_ENABLE_STATS
 /*
- * @brief 处理ISR队列中的事件（任务模式调用）
+ * @brief 获取异步订阅统计
  * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param stats 输出统计
+ * @return 0成功，-1未找到异步订阅
  */
-void topic_bus_process_isr_queue(topic_bus_t* bus) {
-    if (!bus || !bus->isr_queue) return;
+int topic_get_async_stats(topic_bus_t* bus, uint16_t topic_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*),
+                          void* user_data, topic_async_stats_t* stats) {
+    if (!bus || !callback || !stats) return -1;
+    if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
-    topic_bus_isr_event_t evt;
-    while (ring_buffer_read(bus->isr_queue, &evt) == 0) {
-        /* 在任务上下文中处理事件 */
-        (void)topic_publish_event(bus, evt.event_key);
+    int ret = -1;
+    topic_entry_t* entry = __find_topic(bus, topic_id);
+    topic_sub_array_t* subs = entry ? atomic_load_explicit(&entry->subscribers, memory_order_acquire) : NULL;
+    for (size_t i = 0; subs && i < subs->count; ++i) {
+        if (subs->subs[i].callback == callback && subs->subs[i].user_data == user_data && subs->subs[i].async) {
+            ret = topic_executor_get_stats(subs->subs[i].async, stats);
+            break;
+        }
     }
+
+    os_semaphore_give(bus->lock);
+    return ret;
 }
 #endif
+#endif
+
+#if TOPIC_BUS_ENABLE_HISTORY
+/* ---------------- Topic历史 ---------------- */
 
-#if TOPIC_BUS_ENABLE_STATS
 /*
- * @brief 获取Topic事件计数
+ * @brief 为Topic开启历史
  * @param bus Topic总线指针
  * @param topic_id Topic ID
- * @return 事件计数，失败返回-1
+ * @param depth 保留的样本数
+ * @param max_payload 单个样本最大负载（字节）
+ * @return 0成功，-1失败
  */
-int64_t topic_bus_get_event_count(topic_bus_t* bus, uint16_t topic_id) {
-    if (!bus) return -1;
+int topic_bus_history_enable(topic_bus_t* bus, uint16_t topic_id, size_t depth, size_t max_payload) {
+    if (!bus || depth == 0) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
 
+    int ret = -1;
     topic_entry_t* entry = __find_topic(bus, topic_id);
-    int64_t count = -1;
-    if (entry) {
-#if TOPIC_BUS_ENABLE_ATOMICS
-        count = (int64_t)atomic_load_explicit(&entry->event_count, memory_order_acquire);
-#else
-        count = entry->event_count;
-#endif
+    if (entry && !atomic_load_explicit(&entry->history, memory_order_acquire)) {
+        topic_history_t* history = topic_history_create(depth, max_payload);
+        if (history) {
+            atomic_store_explicit(&entry->history, history, memory_order_release);
+            ret = 0;
+        }
     }
 
     os_semaphore_give(bus->lock);
-    return count;
+    return ret;
 }
-#endif
 
-#if TOPIC_BUS_ENABLE_ROUTER
 /*
- * @brief 设置Topic Router
+ * @brief 按游标拉取Topic历史
  * @param bus Topic总线指针
- * @param router Router指针
- * @return 0成功，-1失败
+ * @param topic_id Topic ID
+ * @param cursor 输入输出：下一个要读的序号，0表示从最旧的样本开始
+ * @param buf 负载缓冲
+ * @param capacity 缓冲容量
+ * @param sample 输出样本信息（可为NULL）
+ * @return 1读到样本，0没有更新的样本，-1失败
  */
-int topic_bus_set_router(topic_bus_t* bus, topic_router_t* router) {
-    if (!bus) return -1;
+int topic_history_read(topic_bus_t* bus, uint16_t topic_id, uint64_t* cursor, void* buf, size_t capacity,
+                       topic_history_sample_t* sample) {
+    if (!bus || !cursor) return -1;
     if (os_semaphore_take(bus->lock, 100) < 0) return -1;
-    
-    bus->router = router;
-    
+    topic_entry_t* entry = __find_topic(bus, topic_id);
     os_semaphore_give(bus->lock);
-    return 0;
+
+    /* 历史环开启后直到总线销毁都不会释放，读取只需历史锁 */
+    topic_history_t* history = entry ? atomic_load_explicit(&entry->history, memory_order_acquire) : NULL;
+    if (!history) return -1;
+    return topic_history_fetch(history, cursor, buf, capacity, sample);
 }
 #endif
-
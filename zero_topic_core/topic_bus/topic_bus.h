@@ -14,19 +14,134 @@ extern "C" {
 #include "../ring_buffer/ring_buffer.h"
 #include "topic_rule.h"
 #include "../../Rte/inc/os_semaphore.h"
+#if TOPIC_BUS_ENABLE_HIST
+#include "topic_hist.h"
+#endif
+#if TOPIC_BUS_ENABLE_HISTORY
+#include "topic_history.h"
+#endif
+
+#if TOPIC_BUS_ENABLE_LOAN && !OBJ_DICT_MEMPOOL_ENABLE
+#error "TOPIC_BUS_ENABLE_LOAN requires OBJ_DICT_MEMPOOL_ENABLE"
+#endif
+
+#if TOPIC_BUS_ENABLE_ISR && !RING_BUFFER_ENABLE_MPMC
+#error "TOPIC_BUS_ENABLE_ISR requires RING_BUFFER_ENABLE_MPMC"
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR && !RING_BUFFER_ENABLE_MPMC
+#error "TOPIC_BUS_ENABLE_EXECUTOR requires RING_BUFFER_ENABLE_MPMC"
+#endif
+
+#if TOPIC_BUS_ENABLE_RECORD && !OBJ_DICT_ENABLE_SET_HOOK
+#error "TOPIC_BUS_ENABLE_RECORD requires OBJ_DICT_ENABLE_SET_HOOK"
+#endif
+
+/* 事件反向索引节点（event_key -> Topic）：每个规则事件对应一个节点，挂在event_key所在的桶上 */
+struct topic_entry;
+typedef struct topic_event_link {
+    obj_dict_key_t event_key;           /* 规则引用的事件键 */
+    struct topic_entry* entry;          /* 所属Topic条目 */
+    uint32_t event_index;               /* 事件在entry->rule.events中的下标（时效快照与超时配置） */
+    struct topic_event_link* next;      /* 同桶下一个节点（按Topic槽位顺序排列） */
+} topic_event_link_t;
+
+/* topic_id与event_key索引的默认散列乘数（Fibonacci散列） */
+#define TOPIC_BUS_HASH_MUL_DEFAULT 2654435761U
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
+/* 异步订阅者（由执行器工作线程回调，内部使用） */
+struct topic_async_sub;
+
+/* 异步订阅者队列满时的处理策略 */
+typedef enum {
+    TOPIC_SUB_POLICY_DROP = 0,      /* 丢弃新事件并计数 */
+    TOPIC_SUB_POLICY_BLOCK = 1,     /* 发布者等待队列空位（最长TOPIC_EXECUTOR_BLOCK_TIMEOUT_MS） */
+} topic_sub_policy_t;
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR || TOPIC_BUS_ENABLE_HISTORY
+/* 订阅选项 */
+typedef struct {
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    uint8_t async;                  /* 非0：在执行器工作线程中异步回调 */
+    topic_sub_policy_t policy;      /* 队列满策略 */
+    uint32_t queue_depth;           /* 队列深度（2的幂，0使用默认值） */
+#endif
+#if TOPIC_BUS_ENABLE_HISTORY
+    uint8_t replay;                 /* 非0：订阅后立即按从旧到新回放Topic历史 */
+#endif
+} topic_sub_options_t;
+#endif
 
 /* Topic订阅者结构 */
-typedef struct topic_subscription {
+typedef struct {
     void (*callback)(uint16_t topic_id, const void* data, size_t data_len, void* user);
     void* user_data;
-    struct topic_subscription* next;
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    struct topic_async_sub* async;  /* 异步投递队列，NULL表示同步回调 */
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_t* hist;             /* 同步回调耗时直方图（直方图开启后分配，异步订阅者记录在执行器中） */
+#endif
 } topic_subscription_t;
 
-/* Topic条目结构 */
+/* 订阅者数组（写时复制：写者复制后原子替换，发布者一次原子加载即可遍历） */
+typedef struct topic_sub_array {
+    struct topic_sub_array* retire_next;  /* 待回收链表（仅写者在bus->lock下访问） */
+    uint32_t retire_epoch;                /* 退役时的纪元 */
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    struct topic_async_sub* retire_async; /* 随本数组回收而失效的异步订阅者 */
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_t* retire_hist;            /* 随本数组回收而释放的订阅者直方图 */
+#endif
+    size_t count;                         /* 订阅者数量 */
+    topic_subscription_t subs[];          /* 订阅者 */
+} topic_sub_array_t;
+
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+/*
+ * 范围订阅区间：与范围订阅数组的subs[]一一对应，存放在subs[count]之后；
+ * 数组按first排序，以区间中点为根构成隐式区间树，max_last为子树中last的最大值
+ */
 typedef struct {
+    uint16_t first;                 /* 起始topic_id（含） */
+    uint16_t last;                  /* 结束topic_id（含） */
+    uint16_t max_last;              /* 以本元素为根的子树中last的最大值 */
+} topic_range_t;
+#endif
+
+#if TOPIC_BUS_ENABLE_HIST
+/* Topic直方图组：分发延迟、全部同步回调合计耗时、Router耗时与各静态订阅者耗时 */
+typedef struct {
+    topic_hist_t latency;           /* 发布 -> 开始分发本Topic */
+    topic_hist_t callback;          /* 单次同步回调耗时（全部订阅者合计） */
+    topic_hist_t router;            /* 单次Router处理耗时 */
+    size_t static_count;            /* 静态订阅者数量 */
+    topic_hist_t static_subs[];     /* 各静态订阅者回调耗时 */
+} topic_hist_set_t;
+#endif
+
+/* Topic条目结构 */
+typedef struct topic_entry {
     uint16_t topic_id;              /* Topic ID */
     topic_rule_t rule;              /* 触发规则 */
-    topic_subscription_t* subscribers;  /* 订阅者链表 */
+    _Atomic(topic_sub_array_t*) subscribers;  /* 订阅者数组（RCU发布） */
+    topic_event_link_t* event_links;  /* 规则事件索引节点（由topic_rule_create维护） */
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    const topic_subscription_t* static_subs;  /* 静态表声明的订阅者（同步回调，先于动态订阅者触发） */
+    size_t static_sub_count;        /* 静态订阅者数量 */
+#endif
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    topic_sub_options_t sub_defaults;  /* topic_subscribe使用的默认订阅选项 */
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    _Atomic(topic_hist_set_t*) hist;  /* 延迟/耗时直方图（首次topic_bus_hist_enable或其后创建规则时分配） */
+#endif
+#if TOPIC_BUS_ENABLE_HISTORY
+    _Atomic(topic_history_t*) history;  /* 最近N个负载（topic_bus_history_enable后非NULL，销毁总线时释放） */
+#endif
 #if TOPIC_BUS_ENABLE_STATS
 #if TOPIC_BUS_ENABLE_ATOMICS
     atomic_uint_fast32_t event_count;  /* 事件计数（原子操作） */
@@ -50,27 +165,92 @@ typedef struct topic_bus topic_bus_t;  /* 前向声明 */
 typedef struct topic_router topic_router_t;
 #endif
 
+#if TOPIC_BUS_ENABLE_EXECUTOR
+typedef struct topic_executor topic_executor_t;
+#endif
+
+#if TOPIC_BUS_ENABLE_RECORD
+struct topic_recorder;
+#endif
+
 /* Topic总线结构 */
 struct topic_bus {
     topic_entry_t* topics;          /* Topic条目数组 */
     size_t max_topics;              /* 最大Topic数量 */
     obj_dict_t* obj_dict;           /* 关联对象字典 */
     OsSemaphore_t* lock;            /* 线程安全锁 */
+    topic_event_link_t** event_index;  /* event_key -> Topic 反向索引桶数组 */
+    uint8_t event_index_bits;       /* 索引桶数量的位宽（桶数 = 1 << bits） */
+    uint32_t event_hash_mul;        /* event_key散列乘数 */
+    uint32_t* topic_index;          /* topic_id -> 槽位开放寻址表（存槽位+1，0为空） */
+    uint8_t topic_index_bits;       /* 开放寻址表容量的位宽 */
+    uint32_t topic_hash_mul;        /* topic_id散列乘数 */
+    uint32_t* free_slots;           /* 空闲槽位栈 */
+    size_t free_count;              /* 空闲槽位数量 */
+    atomic_uint_fast32_t rcu_epoch;       /* 订阅者数组回收纪元 */
+    atomic_uint_fast32_t rcu_readers[2];  /* 按纪元奇偶计数的活跃读者 */
+    topic_sub_array_t* rcu_retired;       /* 已退役待回收的订阅者数组 */
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+    _Atomic(topic_sub_array_t*) range_subs;  /* 范围订阅（写时复制，与订阅者数组同样按纪元回收） */
+#endif
 #if TOPIC_BUS_ENABLE_ISR
-    ring_buffer_t* isr_queue;       /* ISR路径缓冲 */
+    ring_buffer_mpmc_t* isr_queue;  /* ISR路径缓冲（多生产者无锁） */
+    OsSemaphore_t* isr_signal;      /* ISR事件唤醒信号（任务侧等待时由生产者释放） */
+    atomic_int isr_waiting;         /* 任务侧正在等待ISR事件 */
 #endif
 #if TOPIC_BUS_ENABLE_ROUTER
     topic_router_t* router;        /* Router处理器 */
 #endif
+#if TOPIC_BUS_ENABLE_LOAN
+    obj_dict_mempool_t* loan_pool;  /* 借出缓冲池（未初始化时为NULL） */
+    size_t loan_capacity;           /* 单个借出缓冲的最大负载（字节） */
+#endif
+#if TOPIC_BUS_ENABLE_EXECUTOR
+    topic_executor_t* executor;     /* 异步订阅执行器（未设置时异步订阅失败） */
+#endif
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+    const struct topic_static_table* static_table;  /* 静态Topic表（NULL表示运行期创建规则） */
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    atomic_int hist_enabled;        /* 非0时记录直方图（默认关闭） */
+#endif
+#if TOPIC_BUS_ENABLE_RECORD
+    _Atomic(struct topic_recorder*) recorder;  /* 流量录制端（NULL表示未录制） */
+#endif
 };
 
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+/*
+ * 编译期静态Topic表（由tool/gen_topic_table.py生成）
+ * 规则事件、超时、静态订阅者与两级索引均为const数据；event_key与topic_id索引使用
+ * 生成时搜索得到的无冲突散列乘数，每个桶只对应一个event_key
+ */
+typedef struct topic_static_table {
+    topic_entry_t* topics;                      /* Topic条目（RAM，生成代码静态初始化） */
+    size_t topic_count;                         /* Topic数量 */
+    topic_event_link_t* const* event_index;     /* event_key -> Topic索引桶 */
+    uint8_t event_index_bits;                   /* 索引桶数量的位宽 */
+    uint32_t event_hash_mul;                    /* event_key完美散列乘数 */
+    const uint32_t* topic_index;                /* topic_id -> 槽位表（存槽位+1，0为空） */
+    uint8_t topic_index_bits;                   /* 槽位表容量的位宽 */
+    uint32_t topic_hash_mul;                    /* topic_id完美散列乘数 */
+} topic_static_table_t;
+#endif
+
 #if TOPIC_BUS_ENABLE_ROUTER
 #include "topic_router.h"
 #endif
 
+#if TOPIC_BUS_ENABLE_EXECUTOR
+#include "topic_executor.h"
+#endif
+
 /* ISR事件结构（用于ISR队列） */
 typedef struct {
     obj_dict_key_t event_key;
+#if TOPIC_BUS_ENABLE_HIST
+    uint64_t ts_us;                 /* 入队时间戳（分发延迟起点） */
+#endif
 } topic_bus_isr_event_t;
 
 /* ---------------- 初始化与销毁 ---------------- */
@@ -85,6 +265,34 @@ typedef struct {
  */
 int topic_bus_init(topic_bus_t* bus, topic_entry_t* topics, size_t max_topics, obj_dict_t* dict);
 
+#if TOPIC_BUS_ENABLE_STATIC_TABLE
+/*
+ * @brief 使用编译期静态Topic表初始化Topic总线
+ * @details 规则与索引直接引用表中的const数据，不分配堆内存也无需逐条topic_rule_create；
+ *          Topic集合固定，topic_rule_create对该总线返回-1，订阅/取消订阅不受影响
+ * @param bus Topic总线指针
+ * @param table 生成的静态Topic表
+ * @param dict 关联的对象字典
+ * @return 0成功，-1失败
+ */
+int topic_bus_init_static(topic_bus_t* bus, const topic_static_table_t* table, obj_dict_t* dict);
+#endif
+
+/*
+ * @brief 销毁Topic总线，释放规则、订阅者、索引及锁等内部资源
+ * @param bus Topic总线指针
+ * @note Topic条目数组与对象字典由调用者管理，不在此释放
+ */
+void topic_bus_deinit(topic_bus_t* bus);
+
+/*
+ * @brief 等待宽限期：调用前已开始的分发（同步回调、异步投递、录制追加）全部结束后返回
+ * @details 等待期间不持有总线锁，不阻塞发布者；返回前短暂加锁回收已退役的订阅者数组；
+ *          不能在订阅回调中调用（会等待自身）
+ * @param bus Topic总线指针
+ */
+void topic_bus_synchronize(topic_bus_t* bus);
+
 /* ---------------- 规则管理 ---------------- */
 
 /*
@@ -112,6 +320,9 @@ int topic_subscribe(topic_bus_t* bus, uint16_t topic_id,
 
 /*
  * @brief 取消订阅Topic
+ * @details 返回后新的分发不再调用该订阅者，但返回前已开始的分发可能仍在其他线程中执行回调，
+ *          user_data可能仍被使用：释放user_data前先调用topic_bus_synchronize；
+ *          异步订阅者的回调在工作线程中执行，还需topic_executor_sync等待其退役完成
  * @param bus Topic总线指针
  * @param topic_id Topic ID
  * @param callback 回调函数
@@ -122,6 +333,111 @@ int topic_unsubscribe(topic_bus_t* bus, uint16_t topic_id,
                       void (*callback)(uint16_t, const void*, size_t, void*),
                       void* user_data);
 
+#if TOPIC_BUS_ENABLE_RANGE_SUB
+/*
+ * @brief 订阅一段topic_id：[first_id, last_id]内任一Topic触发时回调（含之后才创建的Topic）
+ * @details 同步回调，在该Topic的普通订阅者之后、Router之前执行；
+ *          分发时按区间树查找，开销为O(log n + 命中数)，n为范围订阅数
+ * @param bus Topic总线指针
+ * @param first_id 起始topic_id（含）
+ * @param last_id 结束topic_id（含）
+ * @param callback 回调函数（收到的topic_id为实际触发的Topic）
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_subscribe_range(topic_bus_t* bus, uint16_t first_id, uint16_t last_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*),
+                          void* user_data);
+
+/*
+ * @brief 取消范围订阅（区间、回调与用户数据需与订阅时一致）
+ * @return 0成功，-1失败
+ */
+int topic_unsubscribe_range(topic_bus_t* bus, uint16_t first_id, uint16_t last_id,
+                            void (*callback)(uint16_t, const void*, size_t, void*),
+                            void* user_data);
+
+/*
+ * @brief 按前缀掩码订阅：(id & mask) == (topic_id & mask)的Topic触发时回调
+ * @details mask需为高位连续的1（如0xFF00），等价于一段连续的topic_id范围
+ * @param bus Topic总线指针
+ * @param topic_id 前缀值
+ * @param mask 前缀掩码
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败（掩码不是前缀形式时也返回-1）
+ */
+int topic_subscribe_mask(topic_bus_t* bus, uint16_t topic_id, uint16_t mask,
+                         void (*callback)(uint16_t, const void*, size_t, void*),
+                         void* user_data);
+
+/*
+ * @brief 取消前缀掩码订阅
+ * @return 0成功，-1失败
+ */
+int topic_unsubscribe_mask(topic_bus_t* bus, uint16_t topic_id, uint16_t mask,
+                           void (*callback)(uint16_t, const void*, size_t, void*),
+                           void* user_data);
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR || TOPIC_BUS_ENABLE_HISTORY
+/*
+ * @brief 按选项订阅Topic
+ * @details async非0时回调在执行器工作线程中执行：每个订阅者一个有界队列，
+ *          同一Topic的异步订阅者固定在同一工作线程，保证Topic内顺序；
+ *          负载在发布时拷贝（借出缓冲仅增加引用），回调返回后释放。
+ *          replay非0时先回放历史再使订阅生效（同步订阅者在调用线程中回调，异步订阅者入队）：
+ *          回放的样本总在实时投递之前，与订阅同时发生的发布可能重复但不会遗漏；
+ *          回放期间订阅尚未生效，在回放回调中对它取消订阅返回-1；
+ *          超过历史max_payload的发布不入历史，回放期间发生的此类发布收不到；
+ *          发布持续快于回放时最多追赶TOPIC_BUS_HISTORY_REPLAY_ROUNDS轮
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param options 订阅选项（NULL使用Topic默认选项）
+ * @return 0成功，-1失败（异步订阅需先topic_bus_set_executor）
+ */
+int topic_subscribe_ex(topic_bus_t* bus, uint16_t topic_id,
+                       void (*callback)(uint16_t, const void*, size_t, void*),
+                       void* user_data, const topic_sub_options_t* options);
+#endif
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
+
+/*
+ * @brief 设置Topic的默认订阅选项（之后的topic_subscribe按该选项订阅）
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID（需已创建规则）
+ * @param options 订阅选项
+ * @return 0成功，-1失败
+ */
+int topic_set_sub_defaults(topic_bus_t* bus, uint16_t topic_id, const topic_sub_options_t* options);
+
+/*
+ * @brief 设置异步订阅执行器
+ * @param bus Topic总线指针
+ * @param executor 执行器指针（需在topic_bus_deinit之后再销毁）
+ * @return 0成功，-1失败
+ */
+int topic_bus_set_executor(topic_bus_t* bus, topic_executor_t* executor);
+
+#if TOPIC_BUS_ENABLE_STATS
+/*
+ * @brief 获取异步订阅统计（投递、丢弃与排队事件数）
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param stats 输出统计
+ * @return 0成功，-1未找到异步订阅
+ */
+int topic_get_async_stats(topic_bus_t* bus, uint16_t topic_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*),
+                          void* user_data, topic_async_stats_t* stats);
+#endif
+#endif
+
 /* ---------------- 事件发布 ---------------- */
 
 /*
@@ -150,6 +466,60 @@ int topic_publish_manual(topic_bus_t* bus, uint16_t topic_id);
 int topic_publish_isr(topic_bus_t* bus, obj_dict_key_t event_key);
 #endif
 
+#if TOPIC_BUS_ENABLE_LOAN
+/* ---------------- 借出缓冲（零拷贝发布） ---------------- */
+
+/*
+ * @brief 初始化借出缓冲池（块内含引用计数头，负载按16字节对齐）
+ * @param bus Topic总线指针
+ * @param payload_size 单个缓冲最大负载（字节）
+ * @param block_count 缓冲数量
+ * @return 0成功，-1失败
+ */
+int topic_bus_loan_pool_init(topic_bus_t* bus, size_t payload_size, size_t block_count);
+
+/*
+ * @brief 借出一个缓冲，生产者直接在其中写入数据
+ * @param bus Topic总线指针
+ * @param size 需要的负载大小（字节）
+ * @return 负载指针，池未初始化/已耗尽/size过大时返回NULL
+ */
+void* topic_loan(topic_bus_t* bus, size_t size);
+
+/*
+ * @brief 发布借出缓冲：同一缓冲直接交给全部订阅者与Router，不经过对象字典
+ * @param bus Topic总线指针
+ * @param event_key 事件键
+ * @param payload topic_loan返回的负载指针（调用后所有权归总线，无论成功与否；不是本总线借出的缓冲时直接返回-1）
+ * @param len 有效数据长度
+ * @return 0成功，-1失败
+ * @note 回调中的data即payload本身；订阅者需跨回调持有时调用topic_loan_retain
+ */
+int topic_publish_loaned(topic_bus_t* bus, obj_dict_key_t event_key, void* payload, size_t len);
+
+/*
+ * @brief 增加借出缓冲引用计数（订阅者在回调后继续持有数据时使用）
+ * @param bus Topic总线指针
+ * @param payload 负载指针（按地址核对总线缓冲池后才读取头部，可传入任意回调数据）
+ * @return 0成功，-1不是本总线的借出缓冲
+ */
+int topic_loan_retain(topic_bus_t* bus, const void* payload);
+
+/*
+ * @brief 释放借出缓冲引用，计数归零时归还缓冲池（也用于放弃未发布的借出）
+ * @param bus Topic总线指针
+ * @param payload 负载指针（不是本总线的借出缓冲时忽略）
+ */
+void topic_loan_release(topic_bus_t* bus, const void* payload);
+
+/*
+ * @brief 不检查归属的引用增减（总线内部与执行器使用，payload须已确认为借出缓冲）
+ * @param payload 借出缓冲负载指针
+ */
+void topic_loan_hold(const void* payload);
+void topic_loan_drop(const void* payload);
+#endif
+
 /* ---------------- 查询与管理 ---------------- */
 
 /*
@@ -158,6 +528,36 @@ int topic_publish_isr(topic_bus_t* bus, obj_dict_key_t event_key);
  */
 void topic_bus_process_isr_queue(topic_bus_t* bus);
 
+#if TOPIC_BUS_ENABLE_ISR
+/*
+ * @brief 批量排空ISR队列一批事件（任务模式调用）
+ * @details 一次取出最多TOPIC_BUS_ISR_DRAIN_BATCH个事件，在同一次加锁内评估全部规则，
+ *          解锁后再依次分发。合并模式下同一批内重复的event_key只评估、分发一次
+ *          （对象字典只保存最新值，回调收到的即最新数据）
+ * @param bus Topic总线指针
+ * @param coalesce 非0表示合并重复event_key
+ * @param distinct_out 输出：本批实际评估的事件数（可为NULL）
+ * @return 本批出队的事件数，0表示队列为空
+ */
+size_t topic_bus_drain_isr_batch(topic_bus_t* bus, int coalesce, size_t* distinct_out);
+
+/*
+ * @brief 等待ISR队列出现事件（任务模式调用）
+ * @details 队列为空时阻塞在唤醒信号上，topic_publish_isr入队后唤醒等待者；
+ *          没有等待者时生产者不操作信号量
+ * @param bus Topic总线指针
+ * @param timeout_ms 最长等待时间（毫秒），0表示只检查不等待
+ * @return 1队列有事件，0超时，-1失败
+ */
+int topic_bus_wait_isr(topic_bus_t* bus, uint32_t timeout_ms);
+
+/*
+ * @brief 唤醒topic_bus_wait_isr的等待者（如停止Server时）
+ * @param bus Topic总线指针
+ */
+void topic_bus_isr_wakeup(topic_bus_t* bus);
+#endif
+
 /*
  * @brief 获取Topic事件计数
  * @param bus Topic总线指针
@@ -166,6 +566,112 @@ void topic_bus_process_isr_queue(topic_bus_t* bus);
  */
 #if TOPIC_BUS_ENABLE_STATS
 int64_t topic_bus_get_event_count(topic_bus_t* bus, uint16_t topic_id);
+
+/*
+ * @brief 获取Topic被规则过滤的事件数（去抖/限频/边沿/窗口未满）
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @return 过滤计数，失败返回-1
+ */
+int64_t topic_bus_get_suppressed_count(topic_bus_t* bus, uint16_t topic_id);
+#endif
+
+#if TOPIC_BUS_ENABLE_HIST
+/* ---------------- 延迟直方图 ---------------- */
+
+/* topic_bus_hist_reset/topic_bus_hist_dump的topic_id取该值时作用于全部Topic */
+#define TOPIC_BUS_HIST_ALL_TOPICS 0xFFFF
+
+/* Topic级直方图类别 */
+typedef enum {
+    TOPIC_HIST_LATENCY = 0,         /* 发布到开始分发本Topic（首个回调前）的延迟 */
+    TOPIC_HIST_CALLBACK = 1,        /* 单次同步回调耗时（全部订阅者合计） */
+    TOPIC_HIST_ROUTER = 2,          /* 单次Router处理耗时 */
+} topic_hist_kind_t;
+
+/* 订阅者直方图查询结果 */
+typedef struct {
+    void (*callback)(uint16_t topic_id, const void* data, size_t data_len, void* user);
+    void* user_data;
+    uint8_t is_static;              /* 静态表声明的订阅者 */
+    uint8_t is_async;               /* 异步订阅者（耗时在执行器工作线程中统计） */
+    topic_hist_snapshot_t hist;     /* 回调耗时 */
+} topic_sub_hist_t;
+
+/*
+ * @brief 开启/关闭直方图记录（默认关闭；关闭后分发路径不再读取时钟）
+ * @details 开启时为尚未分配的Topic与同步订阅者分配直方图（每Topic约1KB，每订阅者约300B），
+ *          之后创建的规则与订阅随即分配；关闭时保留已分配的直方图与数据，销毁总线时释放。
+ *          总线初始化（包括topic_bus_init_static）不为直方图分配内存
+ * @param bus Topic总线指针
+ * @param enable 非0开启
+ * @return 0成功，-1失败（开启时内存不足，记录状态不变）
+ */
+int topic_bus_hist_enable(topic_bus_t* bus, int enable);
+
+/*
+ * @brief 读取Topic级直方图快照
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param kind 直方图类别
+ * @param snap 输出快照
+ * @return 0成功，-1失败
+ */
+int topic_bus_get_hist(topic_bus_t* bus, uint16_t topic_id, topic_hist_kind_t kind, topic_hist_snapshot_t* snap);
+
+/*
+ * @brief 读取第index个订阅者的回调耗时直方图（先静态订阅者，再按回调顺序的动态订阅者）
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param index 订阅者序号
+ * @param out 输出：订阅者标识与直方图快照
+ * @return 0成功，-1失败（index越界时返回-1，可用于遍历）
+ */
+int topic_bus_get_sub_hist(topic_bus_t* bus, uint16_t topic_id, size_t index, topic_sub_hist_t* out);
+
+/*
+ * @brief 清零直方图
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID，TOPIC_BUS_HIST_ALL_TOPICS表示全部
+ * @return 0成功，-1失败
+ */
+int topic_bus_hist_reset(topic_bus_t* bus, uint16_t topic_id);
+
+/*
+ * @brief 打印直方图摘要，并标出p99最大的订阅者
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID，TOPIC_BUS_HIST_ALL_TOPICS表示全部
+ * @return 0成功，-1失败
+ */
+int topic_bus_hist_dump(topic_bus_t* bus, uint16_t topic_id);
+#endif
+
+#if TOPIC_BUS_ENABLE_HISTORY
+/* ---------------- Topic历史 ---------------- */
+
+/*
+ * @brief 为Topic开启历史：之后每次触发时在分发前记录负载（借出缓冲同样拷贝）
+ * @details 历史环在此一次分配，记录路径不分配内存；开启后不能关闭或调整，随topic_bus_deinit释放
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID（需已创建规则或位于静态表）
+ * @param depth 保留的样本数
+ * @param max_payload 单个样本最大负载（字节，更长的负载不记录）
+ * @return 0成功，-1失败（已开启时也返回-1）
+ */
+int topic_bus_history_enable(topic_bus_t* bus, uint16_t topic_id, size_t depth, size_t max_payload);
+
+/*
+ * @brief 按游标拉取Topic历史（轮询消费者使用，不需要订阅）
+ * @param bus Topic总线指针
+ * @param topic_id Topic ID
+ * @param cursor 输入输出：下一个要读的序号，0表示从最旧的样本开始；成功后指向下一个样本
+ * @param buf 负载缓冲
+ * @param capacity 缓冲容量（负载更长时只拷贝capacity字节，sample->len为实际长度）
+ * @param sample 输出样本信息（序号、时间戳、长度、游标落后被覆盖的样本数，可为NULL）
+ * @return 1读到样本，0没有更新的样本，-1失败（Topic不存在或未开启历史）
+ */
+int topic_history_read(topic_bus_t* bus, uint16_t topic_id, uint64_t* cursor, void* buf, size_t capacity,
+                       topic_history_sample_t* sample);
 #endif
 
 #if TOPIC_BUS_ENABLE_ROUTER
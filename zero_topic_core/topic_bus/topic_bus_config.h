@@ -16,6 +16,16 @@
 #define TOPIC_BUS_ISR_QUEUE_SIZE 32
 #endif
 
+/* ISR队列批量排空时单批最大事件数 */
+#ifndef TOPIC_BUS_ISR_DRAIN_BATCH
+#define TOPIC_BUS_ISR_DRAIN_BATCH TOPIC_BUS_ISR_QUEUE_SIZE
+#endif
+
+/* ISR队列批量排空时单次加锁可收集的最大触发Topic数 */
+#ifndef TOPIC_BUS_ISR_DRAIN_MAX_TRIGGERS
+#define TOPIC_BUS_ISR_DRAIN_MAX_TRIGGERS TOPIC_BUS_MAX_TOPICS
+#endif
+
 /* 是否启用统计信息（事件计数等） */
 #ifndef TOPIC_BUS_ENABLE_STATS
 #define TOPIC_BUS_ENABLE_STATS 1
@@ -61,6 +71,21 @@
 #define TOPIC_BUS_SERVER_PERIOD_MS 100
 #endif
 
+/* Topic Server是否由ISR事件唤醒（0为固定周期轮询，1为阻塞等待ISR队列，period_ms作为空闲超时） */
+#ifndef TOPIC_BUS_SERVER_EVENT_DRIVEN
+#define TOPIC_BUS_SERVER_EVENT_DRIVEN 1
+#endif
+
+/* Topic Server被唤醒后等待更多事件成批的最长时间（毫秒，0表示立即处理） */
+#ifndef TOPIC_BUS_SERVER_MAX_BATCH_DELAY_MS
+#define TOPIC_BUS_SERVER_MAX_BATCH_DELAY_MS 0
+#endif
+
+/* Topic Server默认ISR队列排空模式：0逐条，1批量，2批量并合并重复事件 */
+#ifndef TOPIC_BUS_SERVER_DRAIN_MODE
+#define TOPIC_BUS_SERVER_DRAIN_MODE 1
+#endif
+
 /* 是否启用Topic Router功能 */
 #ifndef TOPIC_BUS_ENABLE_ROUTER
 #define TOPIC_BUS_ENABLE_ROUTER 1
@@ -71,15 +96,255 @@
 #define TOPIC_BUS_MAX_ROUTERS_PER_TOPIC 8
 #endif
 
+/* 批量sink中最早一条记录最多等待的时间（毫秒，0表示只按容量/条数发送；见topic_router_flush_due） */
+#ifndef TOPIC_ROUTER_BATCH_MAX_DELAY_MS
+#define TOPIC_ROUTER_BATCH_MAX_DELAY_MS 10
+#endif
+
+/* Router是否通过VFB发送（需工程包含Middlewares/vfb，为0时VFB Router只登记不发送） */
+#ifndef TOPIC_ROUTER_ENABLE_VFB
+#define TOPIC_ROUTER_ENABLE_VFB 0
+#endif
+
 /* 是否启用规则匹配结果缓存（提升热事件匹配效率） */
 #ifndef TOPIC_BUS_ENABLE_RULE_CACHE
 #define TOPIC_BUS_ENABLE_RULE_CACHE 1
 #endif
 
+/* 事件反向索引最小桶数量（实际桶数按max_topics向上取2的幂） */
+#ifndef TOPIC_BUS_EVENT_INDEX_MIN_BUCKETS
+#define TOPIC_BUS_EVENT_INDEX_MIN_BUCKETS 16
+#endif
+
+/* 是否启用借出缓冲（零拷贝）发布路径，依赖OBJ_DICT_MEMPOOL_ENABLE */
+#ifndef TOPIC_BUS_ENABLE_LOAN
+#define TOPIC_BUS_ENABLE_LOAN 1
+#endif
+
+/* 是否支持编译期静态Topic表（tool/gen_topic_table.py生成，规则与索引位于只读存储） */
+#ifndef TOPIC_BUS_ENABLE_STATIC_TABLE
+#define TOPIC_BUS_ENABLE_STATIC_TABLE 1
+#endif
+
+/* 是否启用异步订阅执行器（慢订阅者在工作线程中回调） */
+#ifndef TOPIC_BUS_ENABLE_EXECUTOR
+#define TOPIC_BUS_ENABLE_EXECUTOR 1
+#endif
+
+/* 执行器最大工作线程数 */
+#ifndef TOPIC_EXECUTOR_MAX_WORKERS
+#define TOPIC_EXECUTOR_MAX_WORKERS 4
+#endif
+
+/* 异步订阅者默认队列深度（必须是2的幂） */
+#ifndef TOPIC_EXECUTOR_DEFAULT_QUEUE_DEPTH
+#define TOPIC_EXECUTOR_DEFAULT_QUEUE_DEPTH 64
+#endif
+
+/* 异步投递时内联拷贝的最大负载（字节），更大的负载单独分配 */
+#ifndef TOPIC_EXECUTOR_INLINE_SIZE
+#define TOPIC_EXECUTOR_INLINE_SIZE 48
+#endif
+
+/* BLOCK策略下队列满时最长等待时间（毫秒），超时后丢弃 */
+#ifndef TOPIC_EXECUTOR_BLOCK_TIMEOUT_MS
+#define TOPIC_EXECUTOR_BLOCK_TIMEOUT_MS 1000
+#endif
+
 /* 是否启用诊断统计（最近事件信息等） */
 #ifndef TOPIC_BUS_ENABLE_DIAG
 #define TOPIC_BUS_ENABLE_DIAG 1
 #endif
 
+/* 是否启用每主题延迟/回调耗时直方图（运行期由topic_bus_hist_enable开启并分配，默认仅Linux编译） */
+#ifndef TOPIC_BUS_ENABLE_HIST
+#if defined(__linux__)
+#define TOPIC_BUS_ENABLE_HIST 1
+#else
+#define TOPIC_BUS_ENABLE_HIST 0
+#endif
+#endif
+
+/* 直方图每个2的幂分段的子桶位数（相对误差 <= 1/2^n） */
+#ifndef TOPIC_HIST_SUB_BITS
+#define TOPIC_HIST_SUB_BITS 2
+#endif
+
+/* 直方图最大可分辨值位数（>= 2^n 微秒计入最后一个桶） */
+#ifndef TOPIC_HIST_MAX_BITS
+#define TOPIC_HIST_MAX_BITS 24
+#endif
+
+/* 是否启用Topic历史（保留最近N个负载，订阅时回放与按游标拉取） */
+#ifndef TOPIC_BUS_ENABLE_HISTORY
+#define TOPIC_BUS_ENABLE_HISTORY 1
+#endif
+
+/* 订阅回放最多追赶的轮数（发布持续快于回放时，最后一轮之后、订阅生效之前的样本不再回放） */
+#ifndef TOPIC_BUS_HISTORY_REPLAY_ROUNDS
+#define TOPIC_BUS_HISTORY_REPLAY_ROUNDS 8
+#endif
+
+/* 是否启用topic_id范围/前缀掩码订阅（一次订阅覆盖一段ID，分发按区间树查找） */
+#ifndef TOPIC_BUS_ENABLE_RANGE_SUB
+#define TOPIC_BUS_ENABLE_RANGE_SUB 1
+#endif
+
+/* 是否注册shell命令（需要工程中包含Middlewares/shell） */
+#ifndef TOPIC_BUS_ENABLE_SHELL
+#define TOPIC_BUS_ENABLE_SHELL 0
+#endif
+
+/* 是否启用二进制事件跟踪（每线程无锁环形缓冲，可导出Chrome trace JSON；
+ * 依赖按线程/任务隔离的TOPIC_TRACE_TLS，默认仅Linux） */
+#ifndef TOPIC_BUS_ENABLE_TRACE
+#if defined(__linux__)
+#define TOPIC_BUS_ENABLE_TRACE 1
+#else
+#define TOPIC_BUS_ENABLE_TRACE 0
+#endif
+#endif
+
+/* 是否编译topic_trace_export_chrome（依赖os_file，默认仅Linux） */
+#ifndef TOPIC_TRACE_ENABLE_EXPORT
+#if defined(__linux__)
+#define TOPIC_TRACE_ENABLE_EXPORT 1
+#else
+#define TOPIC_TRACE_ENABLE_EXPORT 0
+#endif
+#endif
+
+/* 默认跟踪级别：1只记录发布、规则命中、Router与ISR排空，2另记录每个回调与异步投递（见topic_trace_enable） */
+#ifndef TOPIC_TRACE_DEFAULT_LEVEL
+#define TOPIC_TRACE_DEFAULT_LEVEL 1
+#endif
+
+/* 每个线程的跟踪记录数（2的幂，每条16字节） */
+#ifndef TOPIC_TRACE_RING_SIZE
+#define TOPIC_TRACE_RING_SIZE 1024
+#endif
+
+/* 最多同时跟踪的线程数（超出的线程不记录，计入丢失计数） */
+#ifndef TOPIC_TRACE_MAX_THREADS
+#define TOPIC_TRACE_MAX_THREADS 16
+#endif
+
+/* 线程局部存储修饰符（平台不支持时需提供等价实现）；时钟源见topic_trace.h的TOPIC_TRACE_CLOCK */
+#ifndef TOPIC_TRACE_TLS
+#define TOPIC_TRACE_TLS _Thread_local
+#endif
+
+/* 是否启用共享内存多进程总线（依赖os_mmap与命名os_semaphore，默认仅Linux） */
+#ifndef TOPIC_BUS_ENABLE_SHM
+#if defined(__linux__)
+#define TOPIC_BUS_ENABLE_SHM 1
+#else
+#define TOPIC_BUS_ENABLE_SHM 0
+#endif
+#endif
+
+/* 同时接入共享内存总线的最大进程数 */
+#ifndef TOPIC_SHM_MAX_PROCS
+#define TOPIC_SHM_MAX_PROCS 8
+#endif
+
+/* 每个进程的最大订阅数 */
+#ifndef TOPIC_SHM_MAX_SUBS
+#define TOPIC_SHM_MAX_SUBS 16
+#endif
+
+/* 共享内存Topic规则的最大事件数 */
+#ifndef TOPIC_SHM_MAX_TOPIC_EVENTS
+#define TOPIC_SHM_MAX_TOPIC_EVENTS 8
+#endif
+
+/* 每个事件最多关联的共享内存Topic数 */
+#ifndef TOPIC_SHM_MAX_EVENT_TOPICS
+#define TOPIC_SHM_MAX_EVENT_TOPICS 8
+#endif
+
+/* topic_shm_get遇到写入中的值缓冲时的最大重试次数：写者进程崩溃或放弃借出时读者不会永久自旋 */
+#ifndef TOPIC_SHM_GET_RETRIES
+#define TOPIC_SHM_GET_RETRIES 1024
+#endif
+
+/* 共享内存总线默认配置（topic_shm_create的config为NULL时使用） */
+#ifndef TOPIC_SHM_DEFAULT_MAX_TOPICS
+#define TOPIC_SHM_DEFAULT_MAX_TOPICS 64
+#endif
+#ifndef TOPIC_SHM_DEFAULT_MAX_EVENTS
+#define TOPIC_SHM_DEFAULT_MAX_EVENTS 128
+#endif
+#ifndef TOPIC_SHM_DEFAULT_VALUE_SIZE
+#define TOPIC_SHM_DEFAULT_VALUE_SIZE 256
+#endif
+#ifndef TOPIC_SHM_DEFAULT_VALUE_DEPTH
+#define TOPIC_SHM_DEFAULT_VALUE_DEPTH 4
+#endif
+#ifndef TOPIC_SHM_DEFAULT_RING_SIZE
+#define TOPIC_SHM_DEFAULT_RING_SIZE 1024
+#endif
+
+/* 是否启用UDP桥接（依赖Router与BSD socket，默认仅Linux） */
+#ifndef TOPIC_BUS_ENABLE_BRIDGE
+#if defined(__linux__) && TOPIC_BUS_ENABLE_ROUTER
+#define TOPIC_BUS_ENABLE_BRIDGE 1
+#else
+#define TOPIC_BUS_ENABLE_BRIDGE 0
+#endif
+#endif
+
+/* 桥接报文最大长度（字节，含报文头；默认为以太网MTU下的UDP负载上限） */
+#ifndef TOPIC_BRIDGE_MTU
+#define TOPIC_BRIDGE_MTU 1472
+#endif
+
+/* 接收端按发送节点跟踪序号的最大节点数 */
+#ifndef TOPIC_BRIDGE_MAX_NODES
+#define TOPIC_BRIDGE_MAX_NODES 8
+#endif
+
+/* 接收socket缓冲大小（字节，受系统rmem_max限制） */
+#ifndef TOPIC_BRIDGE_RCVBUF
+#define TOPIC_BRIDGE_RCVBUF (1024 * 1024)
+#endif
+
+/* 是否启用串口帧传输（COBS分帧 + CRC，用于UART/SPI板间转发） */
+#ifndef TOPIC_BUS_ENABLE_SERIAL
+#define TOPIC_BUS_ENABLE_SERIAL 1
+#endif
+
+/* 串口帧的最大负载（字节） */
+#ifndef TOPIC_SERIAL_MAX_PAYLOAD
+#define TOPIC_SERIAL_MAX_PAYLOAD 256
+#endif
+
+/* 串口帧校验：0为CRC16-CCITT，1为CRC32（IEEE 802.3） */
+#ifndef TOPIC_SERIAL_CRC32
+#define TOPIC_SERIAL_CRC32 0
+#endif
+
+/* 确认模式下未确认帧的窗口大小（0表示不编译确认与重传） */
+#ifndef TOPIC_SERIAL_ACK_WINDOW
+#define TOPIC_SERIAL_ACK_WINDOW 8
+#endif
+
+/* 确认超时（毫秒）与最大重传次数 */
+#ifndef TOPIC_SERIAL_ACK_TIMEOUT_MS
+#define TOPIC_SERIAL_ACK_TIMEOUT_MS 20
+#endif
+#ifndef TOPIC_SERIAL_ACK_RETRIES
+#define TOPIC_SERIAL_ACK_RETRIES 3
+#endif
+
+/* 是否启用总线流量录制与回放（依赖os_mmap与OBJ_DICT_ENABLE_SET_HOOK，默认仅Linux） */
+#ifndef TOPIC_BUS_ENABLE_RECORD
+#if defined(__linux__)
+#define TOPIC_BUS_ENABLE_RECORD 1
+#else
+#define TOPIC_BUS_ENABLE_RECORD 0
+#endif
+#endif
+
 #endif /* TOPIC_BUS_CONFIG_H_ */
 
@@ -0,0 +1,55 @@
+#include "topic_bus_shell.h"
+
+#if TOPIC_BUS_ENABLE_SHELL && TOPIC_BUS_ENABLE_HIST
+#include <stdlib.h>
+#include <string.h>
+#include "shell.h"
+#include "../../Rte/inc/os_printf.h"
+
+/* shell命令操作的Topic总线 */
+static topic_bus_t* s_shell_bus = NULL;
+
+/*
+ * @brief 绑定shell命令操作的Topic总线
+ * @param bus Topic总线指针（NULL解除绑定）
+ */
+void topic_bus_shell_attach(topic_bus_t* bus) {
+    s_shell_bus = bus;
+}
+
+/*
+ * @brief topichist命令处理
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @return 0成功，-1失败
+ */
+static int CmdTopicHistHandle(int argc, char* argv[]) {
+    if (!s_shell_bus) {
+        os_printf("topichist: no topic bus attached\n");
+        return -1;
+    }
+
+    uint16_t topic_id = TOPIC_BUS_HIST_ALL_TOPICS;
+    if (argc >= 2 && strcmp(argv[1], "all") != 0) {
+        topic_id = (uint16_t)strtoul(argv[1], NULL, 0);
+    }
+
+    if (argc >= 3) {
+        if (strcmp(argv[2], "reset") == 0) {
+            return topic_bus_hist_reset(s_shell_bus, topic_id);
+        }
+        if (strcmp(argv[2], "off") == 0 || strcmp(argv[2], "on") == 0) {
+            return topic_bus_hist_enable(s_shell_bus, strcmp(argv[2], "on") == 0);
+        }
+        os_printf("Usage: topichist [topic_id|all] [reset|off|on]\n");
+        return -1;
+    }
+
+    if (topic_bus_hist_dump(s_shell_bus, topic_id) != 0) {
+        os_printf("topichist: topic not found\n");
+        return -1;
+    }
+    return 0;
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_MAIN), topichist, CmdTopicHistHandle, topic latency histograms);
+#endif
@@ -0,0 +1,24 @@
+#ifndef TOPIC_BUS_SHELL_H_
+#define TOPIC_BUS_SHELL_H_
+
+#include "topic_bus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_SHELL && TOPIC_BUS_ENABLE_HIST
+/*
+ * @brief 绑定shell命令操作的Topic总线
+ * @details 注册命令 topichist [topic_id|all] [reset|off|on]：
+ *          无参数打印全部Topic的延迟/耗时直方图并标出p99最大的订阅者
+ * @param bus Topic总线指针（NULL解除绑定）
+ */
+void topic_bus_shell_attach(topic_bus_t* bus);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_BUS_SHELL_H_ */
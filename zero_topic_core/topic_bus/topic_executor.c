@@ -0,0 +1,460 @@
+#include <string.h>
+#include "topic_bus.h"
+#include "../../Rte/inc/os_heap.h"
+#include "../../Rte/inc/os_timestamp.h"
+#include "topic_trace.h"
+
+#if TOPIC_BUS_ENABLE_EXECUTOR
+
+/* 队列元素的负载类型 */
+#define TOPIC_EXEC_ITEM_INLINE  0   /* 负载内联在元素中 */
+#define TOPIC_EXEC_ITEM_HEAP    1   /* 负载单独分配，投递后释放 */
+#define TOPIC_EXEC_ITEM_LOAN    2   /* 借出缓冲，投递后释放引用 */
+
+/* 工作线程空闲时的最长阻塞时间（毫秒），仅作为丢失唤醒的兜底 */
+#define TOPIC_EXEC_IDLE_TIMEOUT_MS  100
+
+/* 异步订阅者队列元素 */
+typedef struct {
+    const void* ptr;                            /* HEAP/LOAN负载指针 */
+    uint32_t len;                               /* 负载长度 */
+    uint8_t kind;                               /* 负载类型 */
+    uint8_t data[TOPIC_EXECUTOR_INLINE_SIZE];   /* INLINE负载 */
+} topic_exec_item_t;
+
+/* ============================================================
+ * 内部函数声明 (Internal Functions Declaration)
+ * ============================================================ */
+
+static void __item_release(topic_exec_item_t* item);
+static void __worker_wake(topic_executor_worker_t* worker);
+static void __worker_collect_pending(topic_executor_worker_t* worker);
+static size_t __worker_discard(topic_async_sub_t* sub);
+static size_t __worker_run_subs(topic_executor_worker_t* worker);
+static int __worker_has_work(topic_executor_worker_t* worker);
+static void* __worker_task(void* arg);
+static void __async_sub_free(topic_async_sub_t* sub);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/* ---------------- 辅助函数 ---------------- */
+
+/*
+ * @brief 释放队列元素持有的负载
+ * @param item 队列元素
+ */
+static void __item_release(topic_exec_item_t* item) {
+    if (item->kind == TOPIC_EXEC_ITEM_HEAP) {
+        os_free((void*)(uintptr_t)item->ptr);
+#if TOPIC_BUS_ENABLE_LOAN
+    } else if (item->kind == TOPIC_EXEC_ITEM_LOAN) {
+        topic_loan_drop(item->ptr);
+#endif
+    }
+    item->ptr = NULL;
+}
+
+/*
+ * @brief 唤醒即将阻塞的工作线程（与__worker_task的等待登记配对）
+ * @param worker 工作线程
+ */
+static void __worker_wake(topic_executor_worker_t* worker) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&worker->waiting, memory_order_relaxed) &&
+        atomic_exchange_explicit(&worker->waiting, 0, memory_order_acq_rel)) {
+        (void)os_semaphore_give(worker->signal);
+    }
+}
+
+/*
+ * @brief 将新挂入的异步订阅者移入私有链表
+ * @param worker 工作线程
+ */
+static void __worker_collect_pending(topic_executor_worker_t* worker) {
+    topic_async_sub_t* list = atomic_exchange_explicit(&worker->pending, NULL, memory_order_acquire);
+    while (list) {
+        topic_async_sub_t* sub = list;
+        list = sub->next;
+        sub->next = worker->subs;
+        worker->subs = sub;
+    }
+}
+
+/*
+ * @brief 丢弃异步订阅者队列中的全部事件
+ * @param sub 异步订阅者
+ * @return 丢弃的事件数
+ */
+static size_t __worker_discard(topic_async_sub_t* sub) {
+    topic_exec_item_t item;
+    size_t count = 0;
+    while (ring_buffer_mpmc_read(sub->queue, &item) >= 0) {
+        __item_release(&item);
+        ++count;
+    }
+#if TOPIC_BUS_ENABLE_STATS
+    if (count > 0) {
+        atomic_fetch_add_explicit(&sub->dropped, count, memory_order_relaxed);
+    }
+#endif
+    return count;
+}
+
+/*
+ * @brief 释放异步订阅者
+ * @param sub 异步订阅者
+ */
+static void __async_sub_free(topic_async_sub_t* sub) {
+    __worker_discard(sub);
+    ring_buffer_mpmc_destroy(sub->queue);
+    os_free(sub);
+}
+
+/*
+ * @brief 处理本线程负责的全部异步订阅者一轮
+ * @details 每个订阅者只处理本轮开始时已排队的事件，避免单个高频订阅者饿死其他订阅者
+ * @param worker 工作线程
+ * @return 本轮处理的事件数与释放的订阅者数之和
+ */
+static size_t __worker_run_subs(topic_executor_worker_t* worker) {
+    size_t done = 0;
+    topic_async_sub_t** pp = &worker->subs;
+    while (*pp) {
+        topic_async_sub_t* sub = *pp;
+        int state = atomic_load_explicit(&sub->state, memory_order_acquire);
+
+        if (state == TOPIC_ASYNC_RETIRED) {
+            /* 发布者已不可能再引用，排空后释放 */
+            *pp = sub->next;
+            __async_sub_free(sub);
+            atomic_fetch_sub_explicit(&worker->exec->retiring, 1, memory_order_release);
+            ++done;
+            continue;
+        }
+
+        size_t pending = ring_buffer_mpmc_get_count(sub->queue);
+        topic_exec_item_t item;
+        while (pending-- > 0 && ring_buffer_mpmc_read(sub->queue, &item) >= 0) {
+            if (atomic_load_explicit(&sub->state, memory_order_acquire) == TOPIC_ASYNC_ACTIVE) {
+                const void* data = (item.kind == TOPIC_EXEC_ITEM_INLINE)
+                                 ? (item.len ? (const void*)item.data : NULL) : item.ptr;
+                TOPIC_TRACE_CB(TOPIC_TRACE_ASYNC_BEGIN, sub->topic_id, 0, 0);
+#if TOPIC_BUS_ENABLE_HIST
+                uint64_t start_us = os_monotonic_time_get_microsecond();
+                sub->callback(sub->topic_id, data, item.len, sub->user_data);
+                topic_hist_record(&sub->hist, os_monotonic_time_get_microsecond() - start_us);
+#else
+                sub->callback(sub->topic_id, data, item.len, sub->user_data);
+#endif
+                TOPIC_TRACE_CB(TOPIC_TRACE_ASYNC_END, sub->topic_id, 0, 0);
+#if TOPIC_BUS_ENABLE_STATS
+                atomic_fetch_add_explicit(&sub->delivered, 1, memory_order_relaxed);
+#endif
+            } else {
+#if TOPIC_BUS_ENABLE_STATS
+                atomic_fetch_add_explicit(&sub->dropped, 1, memory_order_relaxed);
+#endif
+            }
+            __item_release(&item);
+            ++done;
+        }
+        pp = &sub->next;
+    }
+    return done;
+}
+
+/*
+ * @brief 检查工作线程是否有待处理的工作
+ * @param worker 工作线程
+ * @return 1有，0无
+ */
+static int __worker_has_work(topic_executor_worker_t* worker) {
+    if (atomic_load_explicit(&worker->pending, memory_order_relaxed)) return 1;
+    for (topic_async_sub_t* sub = worker->subs; sub; sub = sub->next) {
+        if (ring_buffer_mpmc_get_count(sub->queue) > 0 ||
+            atomic_load_explicit(&sub->state, memory_order_relaxed) == TOPIC_ASYNC_RETIRED) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* 执行器工作线程函数 */
+static void* __worker_task(void* arg) {
+    topic_executor_worker_t* worker = (topic_executor_worker_t*)arg;
+    topic_executor_t* exec = worker->exec;
+#if TOPIC_BUS_ENABLE_TRACE
+    topic_trace_thread_name("topic_exec");
+#endif
+
+    while (exec->running) {
+        __worker_collect_pending(worker);
+        if (__worker_run_subs(worker) > 0) {
+            continue;
+        }
+
+        /* 先登记等待再复查：入队者要么看到等待标志，要么入队已对此处可见 */
+        atomic_store_explicit(&worker->waiting, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!exec->running || __worker_has_work(worker)) {
+            atomic_store_explicit(&worker->waiting, 0, memory_order_relaxed);
+            continue;
+        }
+        (void)os_semaphore_take(worker->signal, TOPIC_EXEC_IDLE_TIMEOUT_MS);
+        atomic_store_explicit(&worker->waiting, 0, memory_order_relaxed);
+    }
+
+#if TOPIC_BUS_ENABLE_TRACE
+    topic_trace_thread_exit();
+#endif
+    return NULL;
+}
+
+/* ---------------- 初始化与销毁 ---------------- */
+
+/*
+ * @brief 初始化执行器并启动工作线程
+ * @param exec 执行器指针
+ * @param worker_count 工作线程数（1..TOPIC_EXECUTOR_MAX_WORKERS）
+ * @return 0成功，-1失败
+ */
+int topic_executor_init(topic_executor_t* exec, size_t worker_count) {
+    if (!exec || worker_count == 0 || worker_count > TOPIC_EXECUTOR_MAX_WORKERS) return -1;
+
+    memset(exec, 0, sizeof(*exec));
+    atomic_init(&exec->retiring, 0);
+    exec->running = 1;
+
+    ThreadAttr_t attr = {
+        .pName = "TopicExecutor",
+        .Priority = 5,
+        .StackSize = 4096,
+        .ScheduleType = 0
+    };
+
+    for (size_t i = 0; i < worker_count; ++i) {
+        topic_executor_worker_t* worker = &exec->workers[i];
+        worker->exec = exec;
+        worker->subs = NULL;
+        atomic_init(&worker->waiting, 0);
+        atomic_init(&worker->pending, NULL);
+        worker->signal = os_semaphore_create(0, NULL);
+        if (!worker->signal) {
+            topic_executor_deinit(exec);
+            return -1;
+        }
+        exec->worker_count = i + 1;
+        worker->thread = os_thread_create(__worker_task, worker, &attr);
+        if (!worker->thread) {
+            topic_executor_deinit(exec);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * @brief 停止工作线程并释放全部异步订阅者（需在topic_bus_deinit之后调用）
+ * @param exec 执行器指针
+ */
+void topic_executor_deinit(topic_executor_t* exec) {
+    if (!exec) return;
+
+    exec->running = 0;
+    for (size_t i = 0; i < exec->worker_count; ++i) {
+        topic_executor_worker_t* worker = &exec->workers[i];
+        if (worker->thread) {
+            (void)os_semaphore_give(worker->signal);
+            os_thread_join(worker->thread);
+            os_thread_destroy(worker->thread);
+            worker->thread = NULL;
+        }
+    }
+
+    for (size_t i = 0; i < exec->worker_count; ++i) {
+        topic_executor_worker_t* worker = &exec->workers[i];
+        __worker_collect_pending(worker);
+        while (worker->subs) {
+            topic_async_sub_t* sub = worker->subs;
+            worker->subs = sub->next;
+            __async_sub_free(sub);
+        }
+        if (worker->signal) {
+            os_semaphore_destroy(worker->signal);
+            worker->signal = NULL;
+        }
+    }
+    exec->worker_count = 0;
+    atomic_store_explicit(&exec->retiring, 0, memory_order_relaxed);
+}
+
+/* ---------------- 异步订阅者 ---------------- */
+
+/*
+ * @brief 创建异步订阅者并挂到topic_id对应的工作线程（同一Topic固定同一线程，保证顺序）
+ * @param exec 执行器指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param policy 队列满策略（topic_sub_policy_t）
+ * @param queue_depth 队列深度（2的幂，0使用默认值）
+ * @return 异步订阅者指针，失败返回NULL
+ */
+topic_async_sub_t* topic_executor_attach(topic_executor_t* exec, uint16_t topic_id,
+                                         void (*callback)(uint16_t, const void*, size_t, void*),
+                                         void* user_data, int policy, uint32_t queue_depth) {
+    if (!exec || !callback || exec->worker_count == 0 || !exec->running) return NULL;
+
+    topic_async_sub_t* sub = (topic_async_sub_t*)os_malloc(sizeof(topic_async_sub_t));
+    if (!sub) return NULL;
+    memset(sub, 0, sizeof(*sub));
+
+    sub->queue = ring_buffer_mpmc_create(queue_depth ? queue_depth : TOPIC_EXECUTOR_DEFAULT_QUEUE_DEPTH,
+                                         sizeof(topic_exec_item_t));
+    if (!sub->queue) {
+        os_free(sub);
+        return NULL;
+    }
+    sub->callback = callback;
+    sub->user_data = user_data;
+    sub->topic_id = topic_id;
+    sub->policy = (uint8_t)policy;
+    sub->worker = &exec->workers[topic_id % exec->worker_count];
+    atomic_init(&sub->state, TOPIC_ASYNC_ACTIVE);
+#if TOPIC_BUS_ENABLE_STATS
+    atomic_init(&sub->delivered, 0);
+    atomic_init(&sub->dropped, 0);
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_reset(&sub->hist);
+#endif
+
+    /* 压入工作线程的待接收栈 */
+    topic_async_sub_t* head = atomic_load_explicit(&sub->worker->pending, memory_order_relaxed);
+    do {
+        sub->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&sub->worker->pending, &head, sub,
+                                                    memory_order_release, memory_order_relaxed));
+    __worker_wake(sub->worker);
+    return sub;
+}
+
+/*
+ * @brief 投递一个事件到异步订阅者队列
+ * @param sub 异步订阅者
+ * @param data 数据指针（拷贝；loaned非0时仅增加借出缓冲引用）
+ * @param data_len 数据长度
+ * @param loaned 非0表示data为topic_loan返回的借出缓冲
+ * @return 0成功，-1丢弃
+ */
+int topic_executor_submit(topic_async_sub_t* sub, const void* data, size_t data_len, int loaned) {
+    if (!sub) return -1;
+    if (atomic_load_explicit(&sub->state, memory_order_acquire) != TOPIC_ASYNC_ACTIVE) return -1;
+    if (!data || data_len > UINT32_MAX) data_len = 0;
+
+    /* 准备元素：小负载内联，借出缓冲只加引用，其余单独分配 */
+    topic_exec_item_t item;
+    item.ptr = NULL;
+    item.len = (uint32_t)data_len;
+    item.kind = TOPIC_EXEC_ITEM_INLINE;
+#if TOPIC_BUS_ENABLE_LOAN
+    if (loaned && data_len > 0) {
+        topic_loan_hold(data);  /* 总线分发时已确认是借出缓冲 */
+        item.kind = TOPIC_EXEC_ITEM_LOAN;
+        item.ptr = data;
+    } else
+#else
+    (void)loaned;
+#endif
+    if (data_len <= TOPIC_EXECUTOR_INLINE_SIZE) {
+        if (data_len > 0) memcpy(item.data, data, data_len);
+    } else {
+        void* copy = os_malloc(data_len);
+        if (!copy) {
+#if TOPIC_BUS_ENABLE_STATS
+            atomic_fetch_add_explicit(&sub->dropped, 1, memory_order_relaxed);
+#endif
+            return -1;
+        }
+        memcpy(copy, data, data_len);
+        item.kind = TOPIC_EXEC_ITEM_HEAP;
+        item.ptr = copy;
+    }
+
+    ssize_t rc = ring_buffer_mpmc_write(sub->queue, &item);
+    if (rc < 0 && sub->policy == TOPIC_SUB_POLICY_BLOCK) {
+        /* 队列满：唤醒工作线程后等待空位，超时后按丢弃处理 */
+        for (uint32_t waited = 0; rc < 0 && waited < TOPIC_EXECUTOR_BLOCK_TIMEOUT_MS; ++waited) {
+            __worker_wake(sub->worker);
+            os_thread_sleep_ms(1);
+            if (atomic_load_explicit(&sub->state, memory_order_acquire) != TOPIC_ASYNC_ACTIVE) break;
+            rc = ring_buffer_mpmc_write(sub->queue, &item);
+        }
+    }
+    if (rc < 0) {
+        __item_release(&item);
+#if TOPIC_BUS_ENABLE_STATS
+        atomic_fetch_add_explicit(&sub->dropped, 1, memory_order_relaxed);
+#endif
+        return -1;
+    }
+
+    __worker_wake(sub->worker);
+    return 0;
+}
+
+/*
+ * @brief 关闭异步订阅者：不再回调，已排队事件丢弃（取消订阅时调用）
+ * @param sub 异步订阅者
+ */
+void topic_executor_close(topic_async_sub_t* sub) {
+    if (!sub) return;
+    atomic_store_explicit(&sub->state, TOPIC_ASYNC_CLOSING, memory_order_release);
+}
+
+/*
+ * @brief 退役异步订阅者，由工作线程排空后释放（调用者保证不再投递）
+ * @param sub 异步订阅者
+ */
+void topic_executor_detach(topic_async_sub_t* sub) {
+    if (!sub) return;
+    atomic_fetch_add_explicit(&sub->worker->exec->retiring, 1, memory_order_relaxed);
+    atomic_store_explicit(&sub->state, TOPIC_ASYNC_RETIRED, memory_order_seq_cst);
+    __worker_wake(sub->worker);
+}
+
+/*
+ * @brief 等待全部已退役的异步订阅者释放完毕
+ * @param exec 执行器指针
+ * @param timeout_ms 最长等待时间（毫秒）
+ * @return 0完成，-1超时
+ */
+int topic_executor_sync(topic_executor_t* exec, uint32_t timeout_ms) {
+    if (!exec) return -1;
+    for (uint32_t waited = 0; ; ++waited) {
+        if (atomic_load_explicit(&exec->retiring, memory_order_acquire) == 0) return 0;
+        if (waited >= timeout_ms || !exec->running) return -1;
+        os_thread_sleep_ms(1);
+    }
+}
+
+#if TOPIC_BUS_ENABLE_STATS
+/*
+ * @brief 获取异步订阅者统计
+ * @param sub 异步订阅者
+ * @param stats 输出统计
+ * @return 0成功，-1失败
+ */
+int topic_executor_get_stats(const topic_async_sub_t* sub, topic_async_stats_t* stats) {
+    if (!sub || !stats) return -1;
+    stats->delivered = (uint64_t)atomic_load_explicit(&sub->delivered, memory_order_relaxed);
+    stats->dropped = (uint64_t)atomic_load_explicit(&sub->dropped, memory_order_relaxed);
+    stats->queued = ring_buffer_mpmc_get_count(sub->queue);
+    return 0;
+}
+#endif
+
+#endif /* TOPIC_BUS_ENABLE_EXECUTOR */
@@ -0,0 +1,145 @@
+#ifndef TOPIC_EXECUTOR_H_
+#define TOPIC_EXECUTOR_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "topic_bus_config.h"
+#include "../ring_buffer/ring_buffer.h"
+#include "../../Rte/inc/os_semaphore.h"
+#include "../../Rte/inc/os_thread.h"
+#if TOPIC_BUS_ENABLE_HIST
+#include "topic_hist.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 异步订阅者状态 */
+typedef enum {
+    TOPIC_ASYNC_ACTIVE = 0,     /* 正常投递 */
+    TOPIC_ASYNC_CLOSING = 1,    /* 已取消订阅：不再回调，队列中的事件直接丢弃 */
+    TOPIC_ASYNC_RETIRED = 2,    /* 发布者不再可能引用：工作线程排空后释放 */
+} topic_async_state_t;
+
+/* 执行器工作线程 */
+typedef struct topic_executor_worker {
+    struct topic_executor* exec;                /* 所属执行器 */
+    OsThread_t* thread;                         /* 线程句柄 */
+    OsSemaphore_t* signal;                      /* 唤醒信号量 */
+    atomic_int waiting;                         /* 非0表示线程即将阻塞，入队者需唤醒 */
+    _Atomic(struct topic_async_sub*) pending;   /* 新挂入的异步订阅者（无锁栈） */
+    struct topic_async_sub* subs;               /* 本线程负责的异步订阅者（仅本线程访问） */
+} topic_executor_worker_t;
+
+/* 异步订阅者：每个订阅者一个有界队列，由固定的工作线程回调 */
+typedef struct topic_async_sub {
+    struct topic_async_sub* next;               /* 工作线程私有链表 */
+    topic_executor_worker_t* worker;            /* 负责回调的工作线程 */
+    void (*callback)(uint16_t topic_id, const void* data, size_t data_len, void* user);
+    void* user_data;
+    uint16_t topic_id;
+    uint8_t policy;                             /* topic_sub_policy_t */
+    atomic_int state;                           /* topic_async_state_t */
+    ring_buffer_mpmc_t* queue;                  /* 待投递事件队列 */
+#if TOPIC_BUS_ENABLE_STATS
+    atomic_uint_fast64_t delivered;             /* 已回调事件数 */
+    atomic_uint_fast64_t dropped;               /* 队列满或关闭时丢弃的事件数 */
+#endif
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_t hist;                          /* 工作线程中的回调耗时 */
+#endif
+} topic_async_sub_t;
+
+/* 异步订阅执行器 */
+struct topic_executor {
+    topic_executor_worker_t workers[TOPIC_EXECUTOR_MAX_WORKERS];
+    size_t worker_count;                        /* 工作线程数 */
+    volatile int running;                       /* 运行标志 */
+    atomic_size_t retiring;                     /* 已退役但尚未释放的异步订阅者数 */
+};
+typedef struct topic_executor topic_executor_t;
+
+#if TOPIC_BUS_ENABLE_STATS
+/* 异步订阅统计 */
+typedef struct {
+    uint64_t delivered;                         /* 已回调事件数 */
+    uint64_t dropped;                           /* 丢弃事件数 */
+    size_t queued;                              /* 当前排队事件数 */
+} topic_async_stats_t;
+#endif
+
+/*
+ * @brief 初始化执行器并启动工作线程
+ * @param exec 执行器指针
+ * @param worker_count 工作线程数（1..TOPIC_EXECUTOR_MAX_WORKERS）
+ * @return 0成功，-1失败
+ */
+int topic_executor_init(topic_executor_t* exec, size_t worker_count);
+
+/*
+ * @brief 停止工作线程并释放全部异步订阅者（需在topic_bus_deinit之后调用）
+ * @param exec 执行器指针
+ */
+void topic_executor_deinit(topic_executor_t* exec);
+
+/*
+ * @brief 创建异步订阅者并挂到topic_id对应的工作线程（同一Topic固定同一线程，保证顺序）
+ * @param exec 执行器指针
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @param policy 队列满策略（topic_sub_policy_t）
+ * @param queue_depth 队列深度（2的幂，0使用默认值）
+ * @return 异步订阅者指针，失败返回NULL
+ */
+topic_async_sub_t* topic_executor_attach(topic_executor_t* exec, uint16_t topic_id,
+                                         void (*callback)(uint16_t, const void*, size_t, void*),
+                                         void* user_data, int policy, uint32_t queue_depth);
+
+/*
+ * @brief 投递一个事件到异步订阅者队列
+ * @param sub 异步订阅者
+ * @param data 数据指针（拷贝；loaned非0时仅增加借出缓冲引用）
+ * @param data_len 数据长度
+ * @param loaned 非0表示data为topic_loan返回的借出缓冲
+ * @return 0成功，-1丢弃
+ */
+int topic_executor_submit(topic_async_sub_t* sub, const void* data, size_t data_len, int loaned);
+
+/*
+ * @brief 关闭异步订阅者：不再回调，已排队事件丢弃（取消订阅时调用）
+ * @param sub 异步订阅者
+ */
+void topic_executor_close(topic_async_sub_t* sub);
+
+/*
+ * @brief 退役异步订阅者，由工作线程排空后释放（调用者保证不再投递）
+ * @param sub 异步订阅者
+ */
+void topic_executor_detach(topic_async_sub_t* sub);
+
+/*
+ * @brief 等待全部已退役的异步订阅者释放完毕
+ * @param exec 执行器指针
+ * @param timeout_ms 最长等待时间（毫秒）
+ * @return 0完成，-1超时
+ */
+int topic_executor_sync(topic_executor_t* exec, uint32_t timeout_ms);
+
+#if TOPIC_BUS_ENABLE_STATS
+/*
+ * @brief 获取异步订阅者统计
+ * @param sub 异步订阅者
+ * @param stats 输出统计
+ * @return 0成功，-1失败
+ */
+int topic_executor_get_stats(const topic_async_sub_t* sub, topic_async_stats_t* stats);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_EXECUTOR_H_ */
@@ -0,0 +1,133 @@
+#include <string.h>
+#include "topic_hist.h"
+#include "../../Rte/inc/os_printf.h"
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static size_t __bucket_index(uint64_t value);
+static uint32_t __bucket_upper(size_t index);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/*
+ * @brief 计算样本所在的桶
+ * @param value 样本值
+ * @return 桶下标
+ */
+static size_t __bucket_index(uint64_t value) {
+    if (value < TOPIC_HIST_SUB_COUNT) return (size_t)value;
+    if (value >= ((uint64_t)1 << TOPIC_HIST_MAX_BITS)) return TOPIC_HIST_BUCKETS - 1U;
+
+    /* 最高位所在的2的幂分段，分段内取最高位之后的SUB_BITS位作为子桶 */
+    uint32_t v = (uint32_t)value;
+    uint32_t msb = 31U - (uint32_t)__builtin_clz(v);
+    uint32_t sub = (v >> (msb - TOPIC_HIST_SUB_BITS)) & (TOPIC_HIST_SUB_COUNT - 1U);
+    return (size_t)((msb - TOPIC_HIST_SUB_BITS + 1U) * TOPIC_HIST_SUB_COUNT + sub);
+}
+
+/*
+ * @brief 计算桶的上界（桶内最大值）
+ * @param index 桶下标
+ * @return 上界
+ */
+static uint32_t __bucket_upper(size_t index) {
+    if (index < TOPIC_HIST_SUB_COUNT) return (uint32_t)index;
+    uint32_t segment = (uint32_t)(index / TOPIC_HIST_SUB_COUNT);   /* >= 1 */
+    uint32_t sub = (uint32_t)(index % TOPIC_HIST_SUB_COUNT);
+    uint32_t msb = segment + TOPIC_HIST_SUB_BITS - 1U;
+    uint32_t width = 1U << (msb - TOPIC_HIST_SUB_BITS);
+    uint64_t lower = ((uint64_t)1 << msb) + (uint64_t)sub * width;
+    uint64_t upper = lower + width - 1U;
+    return (upper > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (uint32_t)upper;
+}
+
+/*
+ * @brief 清零直方图
+ * @param hist 直方图指针
+ */
+void topic_hist_reset(topic_hist_t* hist) {
+    if (!hist) return;
+    for (size_t i = 0; i < TOPIC_HIST_BUCKETS; ++i) {
+        atomic_store_explicit(&hist->buckets[i], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&hist->max_us, 0, memory_order_relaxed);
+    atomic_store_explicit(&hist->sum_us, 0, memory_order_relaxed);
+}
+
+/*
+ * @brief 记录一个样本
+ * @param hist 直方图指针（NULL时忽略）
+ * @param value_us 样本值（微秒）
+ */
+void topic_hist_record(topic_hist_t* hist, uint64_t value_us) {
+    if (!hist) return;
+    atomic_fetch_add_explicit(&hist->buckets[__bucket_index(value_us)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&hist->sum_us, value_us, memory_order_relaxed);
+
+    unsigned v = (value_us > 0xFFFFFFFFULL) ? 0xFFFFFFFFU : (unsigned)value_us;
+    unsigned cur = atomic_load_explicit(&hist->max_us, memory_order_relaxed);
+    while (v > cur && !atomic_compare_exchange_weak_explicit(&hist->max_us, &cur, v,
+                                                             memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/*
+ * @brief 读取直方图快照
+ * @param hist 直方图指针
+ * @param snap 输出快照
+ */
+void topic_hist_snapshot(const topic_hist_t* hist, topic_hist_snapshot_t* snap) {
+    if (!snap) return;
+    memset(snap, 0, sizeof(*snap));
+    if (!hist) return;
+    topic_hist_t* h = (topic_hist_t*)hist;
+    for (size_t i = 0; i < TOPIC_HIST_BUCKETS; ++i) {
+        snap->buckets[i] = atomic_load_explicit(&h->buckets[i], memory_order_relaxed);
+        snap->count += snap->buckets[i];
+    }
+    snap->sum_us = atomic_load_explicit(&h->sum_us, memory_order_relaxed);
+    snap->max_us = atomic_load_explicit(&h->max_us, memory_order_relaxed);
+}
+
+/*
+ * @brief 计算分位数
+ * @param snap 直方图快照
+ * @param permille 千分位
+ * @return 分位数所在桶的上界（不超过最大值），无样本返回0
+ */
+uint32_t topic_hist_percentile(const topic_hist_snapshot_t* snap, uint32_t permille) {
+    if (!snap || snap->count == 0) return 0;
+    if (permille > 1000U) permille = 1000U;
+
+    /* 第rank个样本（向上取整，至少为1） */
+    uint64_t rank = (snap->count * permille + 999U) / 1000U;
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < TOPIC_HIST_BUCKETS; ++i) {
+        seen += snap->buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = __bucket_upper(i);
+            return (upper < snap->max_us) ? upper : snap->max_us;
+        }
+    }
+    return snap->max_us;
+}
+
+/*
+ * @brief 以一行文本打印直方图摘要
+ * @param name 名称
+ * @param snap 直方图快照
+ */
+void topic_hist_print(const char* name, const topic_hist_snapshot_t* snap) {
+    if (!snap) return;
+    unsigned long avg = snap->count ? (unsigned long)(snap->sum_us / snap->count) : 0UL;
+    os_printf("  %-24s n=%-8lu avg=%-6lu p50=%-6lu p90=%-6lu p99=%-6lu p999=%-6lu max=%lu (us)\n",
+              name ? name : "", (unsigned long)snap->count, avg,
+              (unsigned long)topic_hist_percentile(snap, 500), (unsigned long)topic_hist_percentile(snap, 900),
+              (unsigned long)topic_hist_percentile(snap, 990), (unsigned long)topic_hist_percentile(snap, 999),
+              (unsigned long)snap->max_us);
+}
@@ -0,0 +1,76 @@
+#ifndef TOPIC_HIST_H_
+#define TOPIC_HIST_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "topic_bus_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 对数分桶直方图（HDR风格）：
+ *   v < 2^SUB_BITS 时每个值一个桶；其余按2的幂分段，每段再等分为2^SUB_BITS个子桶，
+ *   相对误差不超过1/2^SUB_BITS；>= 2^MAX_BITS 的值计入最后一个桶
+ * 记录只使用relaxed原子操作，可在回调路径与多个发布线程中并发调用
+ */
+#define TOPIC_HIST_SUB_COUNT (1U << TOPIC_HIST_SUB_BITS)
+#define TOPIC_HIST_BUCKETS   ((TOPIC_HIST_MAX_BITS - TOPIC_HIST_SUB_BITS + 1U) * TOPIC_HIST_SUB_COUNT)
+
+/* 直方图（单位：微秒） */
+typedef struct {
+    atomic_uint buckets[TOPIC_HIST_BUCKETS];
+    atomic_uint max_us;                 /* 最大值 */
+    atomic_uint_fast64_t sum_us;        /* 累计值（用于平均值） */
+} topic_hist_t;
+
+/* 直方图快照（查询与打印使用） */
+typedef struct {
+    uint32_t buckets[TOPIC_HIST_BUCKETS];
+    uint64_t count;                     /* 样本数 */
+    uint64_t sum_us;                    /* 累计值 */
+    uint32_t max_us;                    /* 最大值 */
+} topic_hist_snapshot_t;
+
+/*
+ * @brief 清零直方图
+ * @param hist 直方图指针
+ */
+void topic_hist_reset(topic_hist_t* hist);
+
+/*
+ * @brief 记录一个样本
+ * @param hist 直方图指针（NULL时忽略）
+ * @param value_us 样本值（微秒）
+ */
+void topic_hist_record(topic_hist_t* hist, uint64_t value_us);
+
+/*
+ * @brief 读取直方图快照（与并发记录之间不保证原子一致，误差为正在记录的少量样本）
+ * @param hist 直方图指针
+ * @param snap 输出快照
+ */
+void topic_hist_snapshot(const topic_hist_t* hist, topic_hist_snapshot_t* snap);
+
+/*
+ * @brief 计算分位数
+ * @param snap 直方图快照
+ * @param permille 千分位（500为p50，990为p99，999为p99.9）
+ * @return 分位数所在桶的上界（不超过最大值），无样本返回0
+ */
+uint32_t topic_hist_percentile(const topic_hist_snapshot_t* snap, uint32_t permille);
+
+/*
+ * @brief 以一行文本打印直方图摘要（样本数/平均/p50/p90/p99/p99.9/最大值）
+ * @param name 名称
+ * @param snap 直方图快照
+ */
+void topic_hist_print(const char* name, const topic_hist_snapshot_t* snap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_HIST_H_ */
@@ -0,0 +1,156 @@
+#include <string.h>
+#include "topic_history.h"
+#include "../../Rte/inc/os_heap.h"
+
+#if TOPIC_BUS_ENABLE_HISTORY
+
+/* 槽位头，负载紧随其后 */
+typedef struct {
+    uint64_t seq;
+    uint64_t ts_us;
+    size_t len;
+} topic_history_slot_t;
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static topic_history_slot_t* __slot_of(topic_history_t* history, uint64_t seq);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/*
+ * @brief 取得序号对应的槽位
+ * @param history 历史环指针
+ * @param seq 样本序号
+ * @return 槽位指针
+ */
+static topic_history_slot_t* __slot_of(topic_history_t* history, uint64_t seq) {
+    return (topic_history_slot_t*)(void*)(history->slots + (size_t)(seq % history->depth) * history->stride);
+}
+
+/*
+ * @brief 创建历史环
+ * @param depth 保留的样本数
+ * @param max_payload 单个样本最大负载（字节）
+ * @return 历史环指针，失败返回NULL
+ */
+topic_history_t* topic_history_create(size_t depth, size_t max_payload) {
+    if (depth == 0) return NULL;
+    size_t head = (sizeof(topic_history_t) + 7U) & ~(size_t)7U;
+    size_t stride = (sizeof(topic_history_slot_t) + max_payload + 7U) & ~(size_t)7U;
+    topic_history_t* history = (topic_history_t*)os_malloc(head + stride * depth);
+    if (!history) return NULL;
+
+    memset(history, 0, head);
+    history->lock = os_semaphore_create(1, NULL);
+    if (!history->lock) {
+        os_free(history);
+        return NULL;
+    }
+    history->depth = depth;
+    history->max_payload = max_payload;
+    history->stride = stride;
+    history->next_seq = 1;
+    history->slots = (uint8_t*)history + head;
+    return history;
+}
+
+/*
+ * @brief 销毁历史环
+ * @param history 历史环指针
+ */
+void topic_history_destroy(topic_history_t* history) {
+    if (!history) return;
+    os_semaphore_destroy(history->lock);
+    os_free(history);
+}
+
+/*
+ * @brief 记录一个样本，环满时覆盖最旧的样本
+ * @param history 历史环指针
+ * @param data 负载
+ * @param len 负载长度
+ * @param ts_us 时间戳
+ * @return 0成功，-1失败
+ */
+int topic_history_record(topic_history_t* history, const void* data, size_t len, uint64_t ts_us) {
+    if (!history || (!data && len > 0)) return -1;
+    if (os_semaphore_take(history->lock, 100) < 0) return -1;
+    if (len > history->max_payload) {
+        history->oversize++;
+        os_semaphore_give(history->lock);
+        return -1;
+    }
+
+    topic_history_slot_t* slot = __slot_of(history, history->next_seq);
+    slot->seq = history->next_seq++;
+    slot->ts_us = ts_us;
+    slot->len = len;
+    if (len > 0) {
+        memcpy(slot + 1, data, len);
+    }
+
+    os_semaphore_give(history->lock);
+    return 0;
+}
+
+/*
+ * @brief 按游标读取下一个样本
+ * @param history 历史环指针
+ * @param cursor 输入输出：下一个要读的序号，0表示从最旧的样本开始
+ * @param buf 负载缓冲
+ * @param capacity 缓冲容量
+ * @param sample 输出样本信息（可为NULL）
+ * @return 1读到样本，0没有更新的样本，-1失败
+ */
+int topic_history_fetch(topic_history_t* history, uint64_t* cursor, void* buf, size_t capacity,
+                        topic_history_sample_t* sample) {
+    if (!history || !cursor || (!buf && capacity > 0)) return -1;
+    if (os_semaphore_take(history->lock, 100) < 0) return -1;
+
+    /* 环中保留的序号范围为[oldest, next_seq) */
+    uint64_t oldest = (history->next_seq > history->depth) ? history->next_seq - history->depth : 1U;
+    uint64_t seq = *cursor;
+    uint64_t lost = 0;
+    if (seq < oldest) {
+        lost = (seq == 0) ? 0 : oldest - seq;
+        seq = oldest;
+    }
+    if (seq >= history->next_seq) {
+        os_semaphore_give(history->lock);
+        return 0;
+    }
+
+    const topic_history_slot_t* slot = __slot_of(history, seq);
+    size_t n = (slot->len < capacity) ? slot->len : capacity;
+    if (n > 0) {
+        memcpy(buf, slot + 1, n);
+    }
+    if (sample) {
+        sample->seq = slot->seq;
+        sample->ts_us = slot->ts_us;
+        sample->len = slot->len;
+        sample->lost = lost;
+    }
+    *cursor = seq + 1;
+
+    os_semaphore_give(history->lock);
+    return 1;
+}
+
+/*
+ * @brief 获取最新样本的序号
+ * @param history 历史环指针
+ * @return 序号，尚无样本时返回0
+ */
+uint64_t topic_history_last_seq(topic_history_t* history) {
+    if (!history || os_semaphore_take(history->lock, 100) < 0) return 0;
+    uint64_t seq = history->next_seq - 1;
+    os_semaphore_give(history->lock);
+    return seq;
+}
+
+#endif /* TOPIC_BUS_ENABLE_HISTORY */
@@ -0,0 +1,90 @@
+#ifndef TOPIC_HISTORY_H_
+#define TOPIC_HISTORY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "topic_bus_config.h"
+#include "../../Rte/inc/os_semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_HISTORY
+
+/*
+ * Topic历史环：保存最近depth个负载及其时间戳
+ *   槽位在创建时一次分配（每槽固定max_payload字节），记录时只拷贝，不再分配内存；
+ *   样本序号从1开始递增，读者以游标（下一个要读的序号）增量读取，
+ *   游标落后超过depth时跳到最旧的样本并报告被覆盖的样本数
+ */
+
+/* 读出的样本信息 */
+typedef struct {
+    uint64_t seq;                       /* 样本序号（从1开始） */
+    uint64_t ts_us;                     /* 记录时间（单调时钟，微秒） */
+    size_t len;                         /* 负载长度（可能大于读取缓冲，超出部分未拷贝） */
+    uint64_t lost;                      /* 游标与本样本之间被覆盖的样本数 */
+} topic_history_sample_t;
+
+/* 历史环 */
+typedef struct {
+    OsSemaphore_t* lock;                /* 记录与读取互斥 */
+    size_t depth;                       /* 槽位数 */
+    size_t max_payload;                 /* 单个样本最大负载 */
+    size_t stride;                      /* 槽位间距（槽位头 + max_payload，8字节对齐） */
+    uint64_t next_seq;                  /* 下一个样本序号 */
+    uint32_t oversize;                  /* 超过max_payload而未记录的样本数 */
+    uint8_t* slots;                     /* 槽位区（与本结构体同一次分配） */
+} topic_history_t;
+
+/*
+ * @brief 创建历史环
+ * @param depth 保留的样本数
+ * @param max_payload 单个样本最大负载（字节）
+ * @return 历史环指针，失败返回NULL
+ */
+topic_history_t* topic_history_create(size_t depth, size_t max_payload);
+
+/*
+ * @brief 销毁历史环
+ * @param history 历史环指针
+ */
+void topic_history_destroy(topic_history_t* history);
+
+/*
+ * @brief 记录一个样本，环满时覆盖最旧的样本
+ * @param history 历史环指针
+ * @param data 负载
+ * @param len 负载长度（超过max_payload时不记录并计入oversize）
+ * @param ts_us 时间戳
+ * @return 0成功，-1失败
+ */
+int topic_history_record(topic_history_t* history, const void* data, size_t len, uint64_t ts_us);
+
+/*
+ * @brief 按游标读取下一个样本
+ * @param history 历史环指针
+ * @param cursor 输入输出：下一个要读的序号，0表示从最旧的样本开始；成功后指向下一个样本
+ * @param buf 负载缓冲
+ * @param capacity 缓冲容量
+ * @param sample 输出样本信息（可为NULL）
+ * @return 1读到样本，0没有更新的样本，-1失败
+ */
+int topic_history_fetch(topic_history_t* history, uint64_t* cursor, void* buf, size_t capacity,
+                        topic_history_sample_t* sample);
+
+/*
+ * @brief 获取最新样本的序号
+ * @param history 历史环指针
+ * @return 序号，尚无样本时返回0
+ */
+uint64_t topic_history_last_seq(topic_history_t* history);
+
+#endif /* TOPIC_BUS_ENABLE_HISTORY */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_HISTORY_H_ */
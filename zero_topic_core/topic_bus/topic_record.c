@@ -0,0 +1,325 @@
+#include <string.h>
+#include "topic_record.h"
+#include "../../Rte/inc/os_timestamp.h"
+#include "../../Rte/inc/os_thread.h"
+#include "../../Rte/inc/os_heap.h"
+
+#if TOPIC_BUS_ENABLE_RECORD
+
+#define TOPIC_RECORD_ALIGN(n) (((n) + 3U) & ~(size_t)3U)
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static void __set_hook(obj_dict_key_t key, const void* data, size_t len, uint8_t flags, void* user_data);
+static void __replay_wait(uint64_t target_us);
+static int __replay_record(topic_bus_t* bus, const topic_record_hdr_t* hdr, const uint8_t* payload);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/*
+ * @brief 对象字典写入钩子：录制obj_dict_set
+ * @param key 事件键
+ * @param data 写入的数据
+ * @param len 数据长度
+ * @param flags 写入标志
+ * @param user_data 录制端
+ */
+static void __set_hook(obj_dict_key_t key, const void* data, size_t len, uint8_t flags, void* user_data) {
+    (void)topic_recorder_append((topic_recorder_t*)user_data, TOPIC_RECORD_SET, key, data, len, flags);
+}
+
+/*
+ * @brief 开始录制
+ * @param rec 录制端
+ * @param bus Topic总线
+ * @param path 文件路径
+ * @param capacity 文件容量（字节，含文件头）
+ * @return 0成功，-1失败
+ */
+int topic_recorder_start(topic_recorder_t* rec, topic_bus_t* bus, const char* path, size_t capacity) {
+    if (!rec || !bus || !bus->obj_dict || !path || capacity < sizeof(topic_record_file_hdr_t)) return -1;
+    if (atomic_load_explicit(&bus->obj_dict->set_hook, memory_order_acquire) ||
+        atomic_load_explicit(&bus->recorder, memory_order_acquire)) {
+        return -1;
+    }
+
+    memset(rec, 0, sizeof(*rec));
+    rec->bus = bus;
+    rec->lock = os_semaphore_create(1, NULL);
+    rec->map = os_mmap_create(path, capacity);
+    if (!rec->lock || !rec->map) goto __error;
+
+    rec->file = (topic_record_file_hdr_t*)rec->map->pBuffer;
+    memset(rec->file, 0, sizeof(*rec->file));
+    rec->file->magic = TOPIC_RECORD_MAGIC;
+    rec->file->version = TOPIC_RECORD_VERSION;
+    rec->file->header_size = (uint16_t)sizeof(topic_record_file_hdr_t);
+    rec->file->capacity = capacity;
+    rec->file->used = sizeof(topic_record_file_hdr_t);
+    rec->file->start_us = os_monotonic_time_get_microsecond();
+    rec->last_us = rec->file->start_us;
+    rec->active = 1;
+
+    if (obj_dict_set_hook(bus->obj_dict, __set_hook, rec) != 0) goto __error;
+    atomic_store_explicit(&bus->recorder, rec, memory_order_release);
+    return 0;
+
+__error:
+    if (rec->map) {
+        os_mmap_destroy(rec->map);  /* 未完成的文件一并删除 */
+        rec->map = NULL;
+    }
+    if (rec->lock) {
+        os_semaphore_destroy(rec->lock);
+        rec->lock = NULL;
+    }
+    return -1;
+}
+
+/*
+ * @brief 停止录制
+ * @param rec 录制端
+ * @return 0成功，-1失败
+ */
+int topic_recorder_stop(topic_recorder_t* rec) {
+    if (!rec || !rec->map) return -1;
+
+    /* 先摘除再等待：发布路径在总线读区内追加，写入钩子在对象字典读区内调用；
+     * 两处等待返回后不再有调用者持有rec，之后才能销毁锁与映射 */
+    atomic_store_explicit(&rec->bus->recorder, NULL, memory_order_seq_cst);
+    topic_bus_synchronize(rec->bus);
+    (void)obj_dict_set_hook(rec->bus->obj_dict, NULL, NULL);
+
+    (void)os_semaphore_take(rec->lock, 100);
+    rec->active = 0;
+    os_semaphore_give(rec->lock);
+
+    /* 关闭映射保留文件，内核负责写回 */
+    os_mmap_close(rec->map);
+    rec->map = NULL;
+    rec->file = NULL;
+    os_semaphore_destroy(rec->lock);
+    rec->lock = NULL;
+    return 0;
+}
+
+/*
+ * @brief 追加一条记录
+ * @param rec 录制端
+ * @param type 记录类型
+ * @param key event_key或topic_id
+ * @param data 负载
+ * @param len 负载长度
+ * @param flags obj_dict_set的flags
+ * @return 0成功，-1失败
+ */
+int topic_recorder_append(topic_recorder_t* rec, uint8_t type, uint16_t key, const void* data, size_t len,
+                          uint8_t flags) {
+    if (!rec || (!data && len > 0) || len > UINT32_MAX) return -1;
+    if (os_semaphore_take(rec->lock, 100) < 0) return -1;
+    if (!rec->active) {
+        os_semaphore_give(rec->lock);
+        return -1;
+    }
+
+    topic_record_file_hdr_t* file = rec->file;
+    size_t need = sizeof(topic_record_hdr_t) + TOPIC_RECORD_ALIGN(len);
+    if (need > file->capacity - file->used) {
+        file->dropped++;
+        os_semaphore_give(rec->lock);
+        return -1;
+    }
+
+    /* 时刻在锁内读取，文件中的记录按时间单调排列 */
+    uint64_t now = os_monotonic_time_get_microsecond();
+    uint64_t dt = now - rec->last_us;
+    rec->last_us = now;
+
+    uint8_t* p = (uint8_t*)file + file->used;
+    topic_record_hdr_t hdr = {
+        .dt_us = (dt > UINT32_MAX) ? UINT32_MAX : (uint32_t)dt,
+        .key = key,
+        .type = type,
+        .flags = flags,
+        .len = (uint32_t)len,
+    };
+    memcpy(p, &hdr, sizeof(hdr));
+    if (len > 0) {
+        memcpy(p + sizeof(hdr), data, len);
+    }
+
+    /* 记录写完后再推进used，异常退出时文件头只覆盖完整的记录 */
+    file->used += need;
+    file->records++;
+    file->duration_us = now - file->start_us;
+    os_semaphore_give(rec->lock);
+    return 0;
+}
+
+/*
+ * @brief 获取录制统计
+ * @param rec 录制端
+ * @param stats 输出统计
+ */
+void topic_recorder_get_stats(topic_recorder_t* rec, topic_record_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!rec || !rec->lock || os_semaphore_take(rec->lock, 100) < 0) return;
+    if (rec->file) {
+        stats->records = rec->file->records;
+        stats->bytes = rec->file->used;
+        stats->dropped = rec->file->dropped;
+    }
+    os_semaphore_give(rec->lock);
+}
+
+/*
+ * @brief 等待到计划时刻：1ms以上的部分睡眠，剩余部分自旋
+ * @param target_us 计划时刻（单调时钟，微秒）
+ */
+static void __replay_wait(uint64_t target_us) {
+    uint64_t now = os_monotonic_time_get_microsecond();
+    if (now + 2000U < target_us) {
+        os_thread_sleep_ms((size_t)((target_us - now) / 1000U) - 1U);
+    }
+    while (os_monotonic_time_get_microsecond() < target_us) {
+    }
+}
+
+/*
+ * @brief 把一条记录施加到总线上
+ * @param bus Topic总线
+ * @param hdr 记录头
+ * @param payload 负载
+ * @return 0成功，-1失败
+ */
+static int __replay_record(topic_bus_t* bus, const topic_record_hdr_t* hdr, const uint8_t* payload) {
+    switch (hdr->type) {
+    case TOPIC_RECORD_SET:
+        return obj_dict_set(bus->obj_dict, hdr->key, payload, hdr->len, hdr->flags);
+    case TOPIC_RECORD_PUBLISH:
+        return topic_publish_event(bus, hdr->key);
+    case TOPIC_RECORD_MANUAL:
+        return topic_publish_manual(bus, hdr->key);
+#if TOPIC_BUS_ENABLE_LOAN
+    case TOPIC_RECORD_LOANED: {
+        void* buf = topic_loan(bus, hdr->len);
+        if (!buf) return -1;
+        memcpy(buf, payload, hdr->len);
+        return topic_publish_loaned(bus, hdr->key, buf, hdr->len);
+    }
+#endif
+    default:
+        return -1;
+    }
+}
+
+/*
+ * @brief 把录制文件回放到总线上
+ * @param bus Topic总线
+ * @param path 录制文件路径
+ * @param speed 回放速度：1.0为原速，N为N倍速，<= 0为尽快回放
+ * @param stats 输出回放统计（可为NULL）
+ * @return 0成功，-1失败
+ */
+int topic_replay(topic_bus_t* bus, const char* path, double speed, topic_replay_stats_t* stats) {
+    topic_replay_stats_t local;
+    if (!stats) stats = &local;
+    memset(stats, 0, sizeof(*stats));
+    if (!bus || !bus->obj_dict || !path) return -1;
+
+    /* 先映射文件头取得容量，再映射整个文件 */
+    OsMMap_t* probe = os_mmap_open(path, sizeof(topic_record_file_hdr_t));
+    if (!probe) return -1;
+    topic_record_file_hdr_t probe_hdr;
+    memcpy(&probe_hdr, probe->pBuffer, sizeof(probe_hdr));
+    os_mmap_close(probe);
+    if (probe_hdr.magic != TOPIC_RECORD_MAGIC || probe_hdr.version != TOPIC_RECORD_VERSION ||
+        probe_hdr.header_size != sizeof(topic_record_file_hdr_t) || probe_hdr.used > probe_hdr.capacity ||
+        probe_hdr.used < sizeof(topic_record_file_hdr_t)) {
+        return -1;
+    }
+
+    OsMMap_t* map = os_mmap_open(path, (size_t)probe_hdr.capacity);
+    if (!map) return -1;
+    const uint8_t* base = (const uint8_t*)map->pBuffer;
+    size_t used = (size_t)probe_hdr.used;
+    stats->duration_us = probe_hdr.duration_us;
+
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_t* hist = (topic_hist_t*)os_malloc(sizeof(topic_hist_t));
+    if (hist) topic_hist_reset(hist);
+#endif
+    uint64_t publish_sum_us = 0;
+    uint64_t lag_sum_us = 0;
+    uint64_t offset_us = 0;     /* 记录相对录制开始的时刻 */
+    int ret = 0;
+
+    uint64_t start_us = os_monotonic_time_get_microsecond();
+    size_t pos = sizeof(topic_record_file_hdr_t);
+    while (pos < used) {
+        topic_record_hdr_t hdr;
+        if (used - pos < sizeof(hdr)) {
+            ret = -1;
+            break;
+        }
+        memcpy(&hdr, base + pos, sizeof(hdr));
+        size_t need = sizeof(hdr) + TOPIC_RECORD_ALIGN((size_t)hdr.len);
+        if (need > used - pos) {
+            ret = -1;   /* 记录越界，文件已损坏 */
+            break;
+        }
+        offset_us += hdr.dt_us;
+
+        if (speed > 0.0) {
+            uint64_t target_us = start_us + (uint64_t)((double)offset_us / speed);
+            __replay_wait(target_us);
+            uint64_t lag_us = os_monotonic_time_get_microsecond() - target_us;
+            lag_sum_us += lag_us;
+            if (lag_us > stats->lag_max_us) stats->lag_max_us = lag_us;
+        }
+
+        uint64_t call_us = os_monotonic_time_get_microsecond();
+        if (__replay_record(bus, &hdr, base + pos + sizeof(hdr)) != 0) {
+            stats->errors++;
+        }
+        if (hdr.type == TOPIC_RECORD_SET) {
+            stats->sets++;
+        } else {
+            uint64_t cost_us = os_monotonic_time_get_microsecond() - call_us;
+            publish_sum_us += cost_us;
+            if (cost_us > stats->publish_max_us) stats->publish_max_us = cost_us;
+#if TOPIC_BUS_ENABLE_HIST
+            topic_hist_record(hist, cost_us);
+#endif
+            stats->publishes++;
+        }
+        stats->records++;
+        pos += need;
+    }
+    stats->elapsed_us = os_monotonic_time_get_microsecond() - start_us;
+    os_mmap_close(map);
+
+    if (stats->elapsed_us > 0) {
+        stats->records_per_sec = (double)stats->records * 1e6 / (double)stats->elapsed_us;
+    }
+    if (stats->publishes > 0) {
+        stats->publish_avg_us = (double)publish_sum_us / (double)stats->publishes;
+    }
+    if (stats->records > 0 && speed > 0.0) {
+        stats->lag_avg_us = (double)lag_sum_us / (double)stats->records;
+    }
+#if TOPIC_BUS_ENABLE_HIST
+    if (hist) {
+        topic_hist_snapshot(hist, &stats->publish_hist);
+        os_free(hist);
+    }
+#endif
+    return ret;
+}
+
+#endif /* TOPIC_BUS_ENABLE_RECORD */
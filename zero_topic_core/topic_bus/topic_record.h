@@ -0,0 +1,158 @@
+#ifndef TOPIC_RECORD_H_
+#define TOPIC_RECORD_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "topic_bus_config.h"
+#include "topic_bus.h"
+#include "topic_hist.h"
+#include "../../Rte/inc/os_mmap.h"
+#include "../../Rte/inc/os_semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_RECORD
+
+/*
+ * 总线流量录制与回放：把真实运行中的写入与发布录成文件，在新版本上按原节奏重放，
+ * 得到可复现的前后性能对比
+ *   录制端挂在总线与其对象字典上：每次obj_dict_set（写入钩子）、topic_publish_event、
+ *   ISR事件排空、topic_publish_manual与topic_publish_loaned各追加一条记录到内存映射文件，
+ *   追加只是一次memcpy，不做系统调用；文件容量在开始录制时确定，写满后的记录计入dropped
+ *   回放端按原时间间隔、N倍速或尽快把记录重新施加到一条总线上，统计吞吐、发布耗时与定速偏差
+ *
+ * 文件格式（小端，与支持的目标平台一致）：
+ *   topic_record_file_hdr_t + 若干条记录，记录为topic_record_hdr_t + 负载，按4字节对齐；
+ *   文件头中的used与records在每条记录写完后更新，录制进程异常退出时已写入的记录仍可回放
+ */
+
+#define TOPIC_RECORD_MAGIC   0x5A524543U    /* "ZREC" */
+#define TOPIC_RECORD_VERSION 1U
+
+/* 记录类型 */
+typedef enum {
+    TOPIC_RECORD_SET = 1,               /* obj_dict_set：key + 负载 + flags */
+    TOPIC_RECORD_PUBLISH = 2,           /* topic_publish_event或ISR事件排空：key */
+    TOPIC_RECORD_MANUAL = 3,            /* topic_publish_manual：key为topic_id */
+    TOPIC_RECORD_LOANED = 4,            /* topic_publish_loaned：key + 负载 */
+} topic_record_type_t;
+
+/* 文件头（64字节） */
+typedef struct {
+    uint32_t magic;                     /* TOPIC_RECORD_MAGIC */
+    uint16_t version;                   /* TOPIC_RECORD_VERSION */
+    uint16_t header_size;               /* sizeof(topic_record_file_hdr_t) */
+    uint64_t capacity;                  /* 文件长度 */
+    uint64_t used;                      /* 已写入长度（含文件头） */
+    uint64_t records;                   /* 记录数 */
+    uint64_t dropped;                   /* 空间不足而未录制的记录数 */
+    uint64_t start_us;                  /* 开始录制时刻（单调时钟，微秒） */
+    uint64_t duration_us;               /* 首条记录到最后一条记录的时长 */
+    uint64_t reserved;
+} topic_record_file_hdr_t;
+
+/* 记录头（12字节），负载紧随其后 */
+typedef struct {
+    uint32_t dt_us;                     /* 与上一条记录的时间差（微秒，超过UINT32_MAX时截断） */
+    uint16_t key;                       /* event_key，TOPIC_RECORD_MANUAL时为topic_id */
+    uint8_t type;                       /* topic_record_type_t */
+    uint8_t flags;                      /* obj_dict_set的flags */
+    uint32_t len;                       /* 负载长度 */
+} topic_record_hdr_t;
+
+/* 录制统计 */
+typedef struct {
+    uint64_t records;                   /* 已录制的记录数 */
+    uint64_t bytes;                     /* 已写入长度（含文件头） */
+    uint64_t dropped;                   /* 空间不足而未录制的记录数 */
+} topic_record_stats_t;
+
+/* 录制端 */
+typedef struct topic_recorder {
+    topic_bus_t* bus;                   /* 录制的总线 */
+    OsMMap_t* map;                      /* 文件映射 */
+    OsSemaphore_t* lock;                /* 追加互斥（多个发布线程） */
+    topic_record_file_hdr_t* file;      /* 映射区中的文件头 */
+    uint64_t last_us;                   /* 上一条记录的时刻 */
+    int active;                         /* 0表示已停止 */
+} topic_recorder_t;
+
+/* 回放统计 */
+typedef struct {
+    uint64_t records;                   /* 回放的记录数 */
+    uint64_t sets;                      /* 其中的obj_dict_set */
+    uint64_t publishes;                 /* 其中的发布（含手动与借出缓冲发布） */
+    uint64_t errors;                    /* 回放调用失败的记录数 */
+    uint64_t duration_us;               /* 录制时长 */
+    uint64_t elapsed_us;                /* 回放耗时 */
+    double records_per_sec;             /* 回放吞吐 */
+    double publish_avg_us;              /* 单次发布调用（含同步回调与Router）平均耗时 */
+    uint64_t publish_max_us;            /* 单次发布调用最大耗时 */
+    uint64_t lag_max_us;                /* 定速回放时实际施加时刻落后计划时刻的最大值 */
+    double lag_avg_us;                  /* 定速回放的平均落后 */
+#if TOPIC_BUS_ENABLE_HIST
+    topic_hist_snapshot_t publish_hist; /* 单次发布调用耗时分布 */
+#endif
+} topic_replay_stats_t;
+
+/*
+ * @brief 开始录制：创建文件（已存在时覆盖），挂到总线与其对象字典上
+ * @param rec 录制端
+ * @param bus Topic总线（需已关联对象字典，且对象字典未设置其他写入钩子）
+ * @param path 文件路径
+ * @param capacity 文件容量（字节，含文件头）
+ * @return 0成功，-1失败
+ */
+int topic_recorder_start(topic_recorder_t* rec, topic_bus_t* bus, const char* path, size_t capacity);
+
+/*
+ * @brief 停止录制：从总线与对象字典上摘除，写回文件头并关闭映射（文件保留）
+ * @details 可与发布、写入并发调用：摘除后等待正在追加的发布者与写入钩子退出再销毁；
+ *          不能在订阅回调或写入钩子中调用
+ * @param rec 录制端
+ * @return 0成功，-1失败
+ */
+int topic_recorder_stop(topic_recorder_t* rec);
+
+/*
+ * @brief 追加一条记录（总线与写入钩子调用，也可用于补录自定义事件）
+ * @param rec 录制端
+ * @param type 记录类型
+ * @param key event_key或topic_id
+ * @param data 负载（可为NULL）
+ * @param len 负载长度
+ * @param flags obj_dict_set的flags
+ * @return 0成功，-1失败（已停止或空间不足）
+ */
+int topic_recorder_append(topic_recorder_t* rec, uint8_t type, uint16_t key, const void* data, size_t len,
+                          uint8_t flags);
+
+/*
+ * @brief 获取录制统计
+ * @param rec 录制端
+ * @param stats 输出统计
+ */
+void topic_recorder_get_stats(topic_recorder_t* rec, topic_record_stats_t* stats);
+
+/*
+ * @brief 把录制文件回放到总线上
+ * @details SET记录以obj_dict_set写入bus->obj_dict，PUBLISH/MANUAL记录以topic_publish_event/
+ *          topic_publish_manual发布，LOANED记录借出缓冲拷贝负载后以topic_publish_loaned发布
+ *          （总线未初始化借出缓冲池时计入errors）；目标总线的Topic与规则由调用者预先创建
+ * @param bus Topic总线
+ * @param path 录制文件路径
+ * @param speed 回放速度：1.0为原速，N为N倍速，<= 0为尽快回放
+ * @param stats 输出回放统计（可为NULL）
+ * @return 0成功，-1失败（文件无法打开或格式错误）
+ */
+int topic_replay(topic_bus_t* bus, const char* path, double speed, topic_replay_stats_t* stats);
+
+#endif /* TOPIC_BUS_ENABLE_RECORD */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_RECORD_H_ */
@@ -2,15 +2,382 @@
 #include "topic_router.h"
 #include "../../Rte/inc/os_heap.h"
 #include "../../Rte/inc/os_printf.h"
+#include "../../Rte/inc/os_thread.h"
+#include "../../Rte/inc/os_timestamp.h"
 
 /* 检查是否支持VFB */
-#ifdef __VFB_SERVER_H__
-#define TOPIC_ROUTER_VFB_AVAILABLE 1
-#include "../vfb/vfb.h"
-#else
-#define TOPIC_ROUTER_VFB_AVAILABLE 0
+#if TOPIC_ROUTER_ENABLE_VFB
+#include "../../Middlewares/vfb/vfb.h"
 #endif
 
+/* topic_id散列乘数（与总线一致的Fibonacci散列） */
+#define TOPIC_ROUTER_HASH_MUL 2654435761U
+
+/* 批量记录按4字节对齐 */
+#define TOPIC_ROUTER_BATCH_ALIGN(n) (((n) + 3U) & ~(size_t)3U)
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static size_t __router_hash(uint8_t bits, uint16_t topic_id);
+static size_t __index_find(const uint32_t* index, const topic_router_entry_t* routes, uint8_t bits,
+                           uint16_t topic_id);
+static void __index_erase(topic_router_t* router, size_t pos);
+static topic_router_entry_t* __route_alloc(topic_router_t* router, uint16_t topic_id);
+static void __route_unlink(topic_router_t* router, uint32_t idx);
+static topic_router_table_t* __table_alloc(const topic_router_t* router);
+static void __table_publish(topic_router_t* router, topic_router_table_t* table);
+static uint32_t __rcu_read_lock(topic_router_t* router);
+static void __rcu_read_unlock(topic_router_t* router, uint32_t idx);
+static int __rcu_advance(topic_router_t* router);
+static void __rcu_reclaim(topic_router_t* router);
+static int __batch_register(topic_router_t* router, topic_router_batch_t* batch);
+static void __batch_unregister(topic_router_t* router, topic_router_batch_t* batch);
+static size_t __batch_flush_locked(topic_router_batch_t* batch);
+static int __batch_due(const topic_router_batch_t* batch, uint64_t now_us);
+static int __batch_append(topic_router_batch_t* batch, uint16_t topic_id, const void* data, size_t data_len);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/*
+ * @brief 计算topic_id在索引表中的起始探测位置
+ * @param bits 索引表容量的位宽
+ * @param topic_id Topic ID
+ * @return 起始探测下标
+ */
+static size_t __router_hash(uint8_t bits, uint16_t topic_id) {
+    return (size_t)(((uint32_t)topic_id * TOPIC_ROUTER_HASH_MUL) >> (32U - bits));
+}
+
+/*
+ * @brief 查找Topic在索引表中的位置（开放寻址，O(1)；Router索引与快照索引共用）
+ * @param index 索引表（存routes下标+1）
+ * @param routes 索引指向的条目数组
+ * @param bits 索引表容量的位宽
+ * @param topic_id Topic ID
+ * @return 索引表下标，不存在返回SIZE_MAX
+ */
+static size_t __index_find(const uint32_t* index, const topic_router_entry_t* routes, uint8_t bits,
+                           uint16_t topic_id) {
+    size_t mask = ((size_t)1 << bits) - 1;
+    for (size_t pos = __router_hash(bits, topic_id);; pos = (pos + 1) & mask) {
+        uint32_t first = index[pos];
+        if (first == 0) return SIZE_MAX;
+        if (routes[first - 1].topic_id == topic_id) return pos;
+    }
+}
+
+/*
+ * @brief 删除索引表中的位置（线性探测的后移删除，不留墓碑）
+ * @param router Topic Router指针
+ * @param pos 待删除的下标
+ */
+static void __index_erase(topic_router_t* router, size_t pos) {
+    size_t mask = ((size_t)1 << router->topic_index_bits) - 1;
+    router->topic_index[pos] = 0;
+    for (size_t next = (pos + 1) & mask; router->topic_index[next] != 0; next = (next + 1) & mask) {
+        uint32_t first = router->topic_index[next];
+        size_t home = __router_hash(router->topic_index_bits, router->routers[first - 1].topic_id);
+        /* home不在(pos, next]区间内时，该项可前移到空出的pos */
+        if (((next - home) & mask) >= ((next - pos) & mask)) {
+            router->topic_index[pos] = first;
+            router->topic_index[next] = 0;
+            pos = next;
+        }
+    }
+}
+
+/*
+ * @brief 分配空闲条目并链接到Topic的Router链表末尾（保持添加顺序，调用者持有router->lock）
+ * @param router Topic Router指针
+ * @param topic_id Topic ID
+ * @return 条目指针，已满或该Topic已有TOPIC_BUS_MAX_ROUTERS_PER_TOPIC条返回NULL
+ */
+static topic_router_entry_t* __route_alloc(topic_router_t* router, uint16_t topic_id) {
+    if (!router->topic_index || router->router_count >= router->max_routers) return NULL;
+
+    size_t pos = __index_find(router->topic_index, router->routers, router->topic_index_bits, topic_id);
+    if (pos != SIZE_MAX) {
+        size_t count = 0;
+        for (uint32_t idx = router->topic_index[pos]; idx != 0; idx = router->routers[idx - 1].next) {
+            count++;
+        }
+        if (count >= TOPIC_BUS_MAX_ROUTERS_PER_TOPIC) return NULL;
+    }
+
+    size_t slot = 0;
+    while (slot < router->max_routers && router->routers[slot].in_use) {
+        slot++;
+    }
+    if (slot == router->max_routers) return NULL;
+
+    topic_router_entry_t* entry = &router->routers[slot];
+    memset(entry, 0, sizeof(*entry));
+    entry->in_use = 1;
+    entry->topic_id = topic_id;
+
+    if (pos == SIZE_MAX) {
+        /* 表容量不小于2*max_routers，必有空位 */
+        size_t mask = ((size_t)1 << router->topic_index_bits) - 1;
+        pos = __router_hash(router->topic_index_bits, topic_id);
+        while (router->topic_index[pos] != 0) {
+            pos = (pos + 1) & mask;
+        }
+        router->topic_index[pos] = (uint32_t)slot + 1U;
+    } else {
+        topic_router_entry_t* tail = &router->routers[router->topic_index[pos] - 1];
+        while (tail->next != 0) {
+            tail = &router->routers[tail->next - 1];
+        }
+        tail->next = (uint32_t)slot + 1U;
+    }
+    router->router_count++;
+    return entry;
+}
+
+/*
+ * @brief 把条目从Topic的Router链表摘除并释放槽位（调用者持有router->lock）
+ * @param router Topic Router指针
+ * @param idx 条目下标+1
+ */
+static void __route_unlink(topic_router_t* router, uint32_t idx) {
+    topic_router_entry_t* entry = &router->routers[idx - 1];
+    size_t pos = __index_find(router->topic_index, router->routers, router->topic_index_bits, entry->topic_id);
+    uint32_t prev = 0;
+    for (uint32_t cur = router->topic_index[pos]; cur != idx; cur = router->routers[cur - 1].next) {
+        prev = cur;
+    }
+
+    if (prev != 0) {
+        router->routers[prev - 1].next = entry->next;
+    } else if (entry->next != 0) {
+        router->topic_index[pos] = entry->next;
+    } else {
+        __index_erase(router, pos);
+    }
+    memset(entry, 0, sizeof(topic_router_entry_t));
+    router->router_count--;
+}
+
+/*
+ * @brief 分配快照（容量按max_routers，增删前分配，失败时Router保持不变）
+ * @param router Topic Router指针
+ * @return 快照指针，内存不足返回NULL
+ */
+static topic_router_table_t* __table_alloc(const topic_router_t* router) {
+    size_t index_size = (size_t)1 << router->topic_index_bits;
+    /* 每个sink至少被一个条目引用，sink数不超过max_routers */
+    topic_router_table_t* table = (topic_router_table_t*)os_malloc(
+        sizeof(topic_router_table_t) + sizeof(topic_router_entry_t) * router->max_routers +
+        sizeof(topic_router_batch_t*) * router->max_routers + sizeof(uint32_t) * index_size);
+    if (!table) return NULL;
+    table->batches = (topic_router_batch_t**)(table->routes + router->max_routers);
+    table->index = (uint32_t*)(table->batches + router->max_routers);
+    return table;
+}
+
+/*
+ * @brief 按当前条目链表填充快照并原子替换，旧快照退役（调用者持有router->lock）
+ * @details 快照索引与Router索引槽位一一对应，探测序列不变
+ * @param router Topic Router指针
+ * @param table __table_alloc分配的快照
+ */
+static void __table_publish(topic_router_t* router, topic_router_table_t* table) {
+    size_t index_size = (size_t)1 << router->topic_index_bits;
+    size_t count = 0;
+    for (size_t pos = 0; pos < index_size; ++pos) {
+        uint32_t first = router->topic_index[pos];
+        table->index[pos] = first ? (uint32_t)count + 1U : 0;
+        for (uint32_t idx = first; idx != 0; idx = router->routers[idx - 1].next) {
+            table->routes[count++] = router->routers[idx - 1];
+        }
+    }
+    table->count = count;
+    table->batch_count = 0;
+    for (topic_router_batch_t* batch = router->batches; batch; batch = batch->next) {
+        table->batches[table->batch_count++] = batch;
+    }
+    table->retire_next = NULL;
+    table->retire_epoch = 0;
+
+    topic_router_table_t* old = atomic_load_explicit(&router->table, memory_order_relaxed);
+    atomic_store_explicit(&router->table, table, memory_order_seq_cst);
+    if (old) {
+        old->retire_epoch = (uint32_t)atomic_load_explicit(&router->rcu_epoch, memory_order_seq_cst);
+        old->retire_next = router->rcu_retired;
+        router->rcu_retired = old;
+    }
+    __rcu_reclaim(router);
+}
+
+/*
+ * @brief 进入快照读临界区（无等待）
+ * @param router Topic Router指针
+ * @return 读者所在的纪元奇偶槽，退出时传回
+ */
+static uint32_t __rcu_read_lock(topic_router_t* router) {
+    uint32_t idx = (uint32_t)atomic_load_explicit(&router->rcu_epoch, memory_order_acquire) & 1U;
+    atomic_fetch_add_explicit(&router->rcu_readers[idx], 1, memory_order_seq_cst);
+    return idx;
+}
+
+/*
+ * @brief 退出快照读临界区
+ * @param router Topic Router指针
+ * @param idx __rcu_read_lock返回的奇偶槽
+ */
+static void __rcu_read_unlock(topic_router_t* router, uint32_t idx) {
+    atomic_fetch_sub_explicit(&router->rcu_readers[idx], 1, memory_order_release);
+}
+
+/*
+ * @brief 尝试推进一次纪元：要求上一代读者已全部退出（与总线相同，以CAS推进）
+ * @param router Topic Router指针
+ * @return 1纪元已推进，0上一代读者尚未退出
+ */
+static int __rcu_advance(topic_router_t* router) {
+    uint_fast32_t e = atomic_load_explicit(&router->rcu_epoch, memory_order_seq_cst);
+    if (atomic_load_explicit(&router->rcu_readers[(e + 1U) & 1U], memory_order_seq_cst) != 0) {
+        return 0;
+    }
+    (void)atomic_compare_exchange_strong_explicit(&router->rcu_epoch, &e, e + 1U, memory_order_seq_cst,
+                                                  memory_order_seq_cst);
+    return 1;
+}
+
+/*
+ * @brief 推进纪元并释放已过宽限期的快照（调用者持有router->lock，不阻塞）
+ * @param router Topic Router指针
+ */
+static void __rcu_reclaim(topic_router_t* router) {
+    for (int i = 0; i < 2 && router->rcu_retired; ++i) {
+        if (!__rcu_advance(router)) break;  /* 上一代读者尚未退出，下次再试 */
+    }
+
+    uint32_t now = (uint32_t)atomic_load_explicit(&router->rcu_epoch, memory_order_seq_cst);
+    topic_router_table_t** pp = &router->rcu_retired;
+    while (*pp) {
+        topic_router_table_t* table = *pp;
+        if ((uint32_t)(now - table->retire_epoch) >= 2U) {
+            *pp = table->retire_next;
+            os_free(table);
+        } else {
+            pp = &table->retire_next;
+        }
+    }
+}
+
+/*
+ * @brief 登记批量sink（同一sink只登记一次，调用者持有router->lock）
+ * @param router Topic Router指针
+ * @param batch 批量sink
+ * @return 0成功，-1已登记到其他Router
+ */
+static int __batch_register(topic_router_t* router, topic_router_batch_t* batch) {
+    if (batch->owner == router) return 0;
+    if (batch->owner) return -1;  /* next为侵入式链表节点，不能同时挂在两个Router上 */
+    batch->owner = router;
+    batch->next = router->batches;
+    router->batches = batch;
+    return 0;
+}
+
+/*
+ * @brief 没有条目再引用sink时将其从Router注销（调用者持有router->lock）
+ * @param router Topic Router指针
+ * @param batch 批量sink
+ */
+static void __batch_unregister(topic_router_t* router, topic_router_batch_t* batch) {
+    for (size_t i = 0; i < router->max_routers; ++i) {
+        const topic_router_entry_t* entry = &router->routers[i];
+        if (entry->in_use && entry->type == TOPIC_ROUTER_TYPE_BATCH && entry->u.batch == batch) return;
+    }
+    for (topic_router_batch_t** pp = &router->batches; *pp; pp = &(*pp)->next) {
+        if (*pp == batch) {
+            *pp = batch->next;
+            break;
+        }
+    }
+    batch->next = NULL;
+    batch->owner = NULL;
+}
+
+/*
+ * @brief 发送已汇聚的记录（调用者持有sink锁）
+ * @param batch 批量sink
+ * @return 发送的记录数，发送失败返回0（记录计入丢弃）
+ */
+static size_t __batch_flush_locked(topic_router_batch_t* batch) {
+    size_t count = batch->count;
+    if (count == 0) return 0;
+
+    int ret = batch->flush(batch->buf, batch->len, count, batch->user_data);
+    batch->flushes++;
+    batch->len = 0;
+    batch->count = 0;
+    if (ret != 0) {
+        batch->dropped += (uint32_t)count;
+        return 0;
+    }
+    return count;
+}
+
+/*
+ * @brief 判断最早一条记录是否已等待max_delay_ms（调用者持有sink锁）
+ * @param batch 批量sink
+ * @param now_us 当前时间
+ * @return 非0表示应发送
+ */
+static int __batch_due(const topic_router_batch_t* batch, uint64_t now_us) {
+    return batch->count > 0 && batch->max_delay_ms > 0 &&
+           now_us - batch->first_us >= (uint64_t)batch->max_delay_ms * 1000U;
+}
+
+/*
+ * @brief 追加一条记录，缓冲不足时先发送已汇聚的记录
+ * @param batch 批量sink
+ * @param topic_id Topic ID
+ * @param data 负载
+ * @param data_len 负载长度
+ * @return 0成功，-1失败
+ */
+static int __batch_append(topic_router_batch_t* batch, uint16_t topic_id, const void* data, size_t data_len) {
+    size_t record = TOPIC_ROUTER_BATCH_ALIGN(sizeof(topic_router_batch_hdr_t) + data_len);
+    if (os_semaphore_take(batch->lock, 100) < 0) return -1;
+
+    if (data_len > 0xFFFFU || record > batch->capacity) {
+        batch->dropped++;
+        os_semaphore_give(batch->lock);
+        return -1;
+    }
+    if (batch->len + record > batch->capacity) {
+        (void)__batch_flush_locked(batch);
+    }
+    uint64_t now_us = batch->max_delay_ms ? os_monotonic_time_get_microsecond() : 0;
+    if (batch->count == 0) {
+        batch->first_us = now_us;
+    }
+
+    /* 记录头按小端逐字节写入，汇聚缓冲可直接作为跨主机的报文负载（如UDP桥接） */
+    uint8_t* dst = batch->buf + batch->len;
+    dst[0] = (uint8_t)topic_id;
+    dst[1] = (uint8_t)(topic_id >> 8);
+    dst[2] = (uint8_t)data_len;
+    dst[3] = (uint8_t)(data_len >> 8);
+    memcpy(dst + sizeof(topic_router_batch_hdr_t), data, data_len);
+    batch->len += record;
+    batch->count++;
+
+    if ((batch->max_count > 0 && batch->count >= batch->max_count) || __batch_due(batch, now_us)) {
+        (void)__batch_flush_locked(batch);
+    }
+    os_semaphore_give(batch->lock);
+    return 0;
+}
+
 /*
  * @brief 初始化Topic Router
  * @param router Topic Router指针
@@ -19,16 +386,71 @@
  * @return 0成功，-1失败
  */
 int topic_router_init(topic_router_t* router, topic_router_entry_t* routers, size_t max_routers) {
-    if (!router || !routers || max_routers == 0) return -1;
-    
+    if (!router || !routers || max_routers == 0 || max_routers > 0xFFFFU) return -1;
+
     memset(router, 0, sizeof(topic_router_t));
     router->routers = routers;
     router->max_routers = max_routers;
     router->router_count = 0;
-    
+
     /* 初始化Router数组 */
     memset(routers, 0, sizeof(topic_router_entry_t) * max_routers);
-    
+
+    /* topic_id索引：容量不小于2*max_routers，负载因子不超过0.5 */
+    router->topic_index_bits = 1;
+    while (((size_t)1 << router->topic_index_bits) < max_routers * 2) {
+        router->topic_index_bits++;
+    }
+    size_t index_size = (size_t)1 << router->topic_index_bits;
+    router->topic_index = (uint32_t*)os_malloc(sizeof(uint32_t) * index_size);
+    if (!router->topic_index) return -1;
+    memset(router->topic_index, 0, sizeof(uint32_t) * index_size);
+
+    router->lock = os_semaphore_create(1, NULL);
+    if (!router->lock) {
+        os_free(router->topic_index);
+        router->topic_index = NULL;
+        return -1;
+    }
+    atomic_init(&router->table, NULL);
+    atomic_init(&router->rcu_epoch, 0);
+    atomic_init(&router->rcu_readers[0], 0);
+    atomic_init(&router->rcu_readers[1], 0);
+    router->rcu_retired = NULL;
+
+    return 0;
+}
+
+/*
+ * @brief 释放Topic Router的索引
+ * @param router Topic Router指针
+ * @return 0成功，-1失败
+ */
+int topic_router_deinit(topic_router_t* router) {
+    if (!router) return -1;
+    if (router->topic_index) {
+        os_free(router->topic_index);
+        router->topic_index = NULL;
+    }
+    /* 调用者保证没有并发的route，当前与退役的快照可直接释放 */
+    os_free(atomic_exchange_explicit(&router->table, NULL, memory_order_seq_cst));
+    while (router->rcu_retired) {
+        topic_router_table_t* table = router->rcu_retired;
+        router->rcu_retired = table->retire_next;
+        os_free(table);
+    }
+    router->router_count = 0;
+    /* 注销全部sink，之后可登记到其他Router */
+    while (router->batches) {
+        topic_router_batch_t* batch = router->batches;
+        router->batches = batch->next;
+        batch->next = NULL;
+        batch->owner = NULL;
+    }
+    if (router->lock) {
+        os_semaphore_destroy(router->lock);
+        router->lock = NULL;
+    }
     return 0;
 }
 
@@ -40,47 +462,76 @@ int topic_router_init(topic_router_t* router, topic_router_entry_t* routers, siz
  * @return 0成功，-1失败
  */
 int topic_router_add_vfb(topic_router_t* router, uint16_t topic_id, obj_dict_key_t vfb_event_key) {
-    if (!router || router->router_count >= router->max_routers) return -1;
-    
-    /* 查找空闲槽位 */
-    for (size_t i = 0; i < router->max_routers; ++i) {
-        if (router->routers[i].type == 0) {  /* 0表示未使用 */
-            router->routers[i].type = TOPIC_ROUTER_TYPE_VFB;
-            router->routers[i].u.vfb_event_key = vfb_event_key;
-            router->routers[i].user_data = (void*)(uintptr_t)topic_id;
-            router->router_count++;
-            return 0;
-        }
+    if (!router || !router->lock) return -1;
+    if (os_semaphore_take(router->lock, 100) < 0) return -1;
+
+    topic_router_table_t* table = __table_alloc(router);
+    topic_router_entry_t* entry = table ? __route_alloc(router, topic_id) : NULL;
+    if (entry) {
+        entry->type = TOPIC_ROUTER_TYPE_VFB;
+        entry->u.vfb_event_key = vfb_event_key;
+        __table_publish(router, table);
+    } else {
+        os_free(table);
     }
-    
-    return -1;
+    os_semaphore_give(router->lock);
+    return entry ? 0 : -1;
 }
 
 /*
  * @brief 添加自定义Router
  * @param router Topic Router指针
- * @param topic_id Topic ID（用于索引，当前版本暂不支持）
+ * @param topic_id Topic ID
  * @param callback 回调函数
  * @param user_data 用户数据
  * @return 0成功，-1失败
  */
 int topic_router_add_custom(topic_router_t* router, uint16_t topic_id,
                              topic_router_callback_t callback, void* user_data) {
-    if (!router || !callback || router->router_count >= router->max_routers) return -1;
-    
-    /* 查找空闲槽位 */
-    for (size_t i = 0; i < router->max_routers; ++i) {
-        if (router->routers[i].type == 0) {  /* 0表示未使用 */
-            router->routers[i].type = TOPIC_ROUTER_TYPE_CUSTOM;
-            router->routers[i].u.custom_cb = callback;
-            router->routers[i].user_data = (void*)(uintptr_t)topic_id;  /* 用于匹配topic_id */
-            router->routers[i].callback_user_data = user_data;  /* 用于回调函数的用户数据 */
-            router->router_count++;
-            return 0;
-        }
+    if (!router || !router->lock || !callback) return -1;
+    if (os_semaphore_take(router->lock, 100) < 0) return -1;
+
+    topic_router_table_t* table = __table_alloc(router);
+    topic_router_entry_t* entry = table ? __route_alloc(router, topic_id) : NULL;
+    if (entry) {
+        entry->type = TOPIC_ROUTER_TYPE_CUSTOM;
+        entry->u.custom_cb = callback;
+        entry->callback_user_data = user_data;  /* 用于回调函数的用户数据 */
+        __table_publish(router, table);
+    } else {
+        os_free(table);
     }
-    
-    return -1;
+    os_semaphore_give(router->lock);
+    return entry ? 0 : -1;
+}
+
+/*
+ * @brief 添加批量Router
+ * @param router Topic Router指针
+ * @param topic_id Topic ID
+ * @param batch 已初始化的批量sink
+ * @return 0成功，-1失败
+ */
+int topic_router_add_batch(topic_router_t* router, uint16_t topic_id, topic_router_batch_t* batch) {
+    if (!router || !router->lock || !batch || !batch->lock) return -1;
+    if (os_semaphore_take(router->lock, 100) < 0) return -1;
+
+    topic_router_table_t* table = NULL;
+    topic_router_entry_t* entry = NULL;
+    if (batch->owner == NULL || batch->owner == router) {
+        table = __table_alloc(router);
+        entry = table ? __route_alloc(router, topic_id) : NULL;
+    }
+    if (entry) {
+        entry->type = TOPIC_ROUTER_TYPE_BATCH;
+        entry->u.batch = batch;
+        (void)__batch_register(router, batch);
+        __table_publish(router, table);
+    } else {
+        os_free(table);
+    }
+    os_semaphore_give(router->lock);
+    return entry ? 0 : -1;
 }
 
 /*
@@ -93,51 +544,54 @@ int topic_router_add_custom(topic_router_t* router, uint16_t topic_id,
  */
 int topic_router_route(topic_router_t* router, uint16_t topic_id,
                         const void* data, size_t data_len) {
-    if (!router || !data || !router->routers) return -1;
-    
+    if (!router || !data) return -1;
+
+    /* 纪元读区内一次原子加载取得快照，散列探测后直接回调（并发增删Router发布新快照，本次仍用旧快照） */
     int routed = 0;
-    
-    /* 遍历所有Router，查找匹配的Topic */
-    for (size_t i = 0; i < router->max_routers; ++i) {
-        topic_router_entry_t* entry = &router->routers[i];
-        if (!entry || entry->type == 0) continue;  /* 跳过未使用的 */
-        
-        /* 检查是否匹配该Topic（通过user_data中的topic_id判断） */
-        if (!entry->user_data) continue;  /* user_data为NULL，跳过 */
-        uint16_t router_topic_id = (uint16_t)(uintptr_t)entry->user_data;
-        if (router_topic_id != topic_id) continue;
-        
-        switch (entry->type) {
-            case TOPIC_ROUTER_TYPE_VFB: {
-#if TOPIC_ROUTER_VFB_AVAILABLE
-                /* 通过VFB广播 */
-                obj_dict_key_t vfb_key = entry->u.vfb_event_key;
-                if (vfb_send(vfb_key, 0, data, (uint16_t)data_len) == 0) {
-                    routed++;
-                }
-#else
-                /* VFB未启用，跳过 */
-                (void)entry;
+    uint32_t rcu_idx = __rcu_read_lock(router);
+    const topic_router_table_t* table = atomic_load_explicit(&router->table, memory_order_seq_cst);
+    size_t pos = table ? __index_find(table->index, table->routes, router->topic_index_bits, topic_id) : SIZE_MAX;
+    if (pos != SIZE_MAX) {
+        for (size_t i = table->index[pos] - 1U; i < table->count && table->routes[i].topic_id == topic_id; ++i) {
+            const topic_router_entry_t* entry = &table->routes[i];
+            switch (entry->type) {
+                case TOPIC_ROUTER_TYPE_VFB: {
+#if TOPIC_ROUTER_ENABLE_VFB
+                    /* 通过VFB广播 */
+                    obj_dict_key_t vfb_key = entry->u.vfb_event_key;
+                    if (vfb_send(vfb_key, 0, (void*)(uintptr_t)data, (uint16_t)data_len) == FD_PASS) {
+                        routed++;
+                    }
 #endif
-                break;
-            }
-            
-            case TOPIC_ROUTER_TYPE_CUSTOM: {
-                /* 调用自定义回调 */
-                if (entry->u.custom_cb) {
-                    void* user_data = entry->callback_user_data;  /* 可能为NULL，但回调函数应该能处理 */
-                    if (entry->u.custom_cb(topic_id, data, data_len, user_data) == 0) {
+                    break;
+                }
+
+                case TOPIC_ROUTER_TYPE_CUSTOM: {
+                    /* 调用自定义回调 */
+                    if (entry->u.custom_cb) {
+                        void* user_data = entry->callback_user_data;  /* 可能为NULL，但回调函数应该能处理 */
+                        if (entry->u.custom_cb(topic_id, data, data_len, user_data) == 0) {
+                            routed++;
+                        }
+                    }
+                    break;
+                }
+
+                case TOPIC_ROUTER_TYPE_BATCH: {
+                    /* 汇聚到sink，满或达到条数时才发送 */
+                    if (__batch_append(entry->u.batch, topic_id, data, data_len) == 0) {
                         routed++;
                     }
+                    break;
                 }
-                break;
+
+                default:
+                    break;
             }
-            
-            default:
-                break;
         }
     }
-    
+    __rcu_read_unlock(router, rcu_idx);
+
     return (routed > 0) ? 0 : -1;
 }
 
@@ -149,21 +603,255 @@ int topic_router_route(topic_router_t* router, uint16_t topic_id,
  * @return 0成功，-1失败
  */
 int topic_router_remove(topic_router_t* router, uint16_t topic_id, topic_router_type_t type) {
-    if (!router) return -1;
-    
-    for (size_t i = 0; i < router->max_routers; ++i) {
-        topic_router_entry_t* entry = &router->routers[i];
-        if (entry->type == 0) continue;  /* 跳过未使用的 */
-        
-        uint16_t router_topic_id = (uint16_t)(uintptr_t)entry->user_data;
-        
-        if (entry->type == type && router_topic_id == topic_id) {
-            memset(entry, 0, sizeof(topic_router_entry_t));
-            router->router_count--;
-            return 0;
+    if (!router || !router->lock) return -1;
+    if (os_semaphore_take(router->lock, 100) < 0) return -1;
+
+    size_t pos = router->topic_index
+                     ? __index_find(router->topic_index, router->routers, router->topic_index_bits, topic_id)
+                     : SIZE_MAX;
+    topic_router_table_t* table = (pos != SIZE_MAX) ? __table_alloc(router) : NULL;
+    if (!table) {
+        os_semaphore_give(router->lock);
+        return -1;
+    }
+
+    /* 从Topic链表中摘除第一个匹配类型的条目 */
+    for (uint32_t idx = router->topic_index[pos]; idx != 0; idx = router->routers[idx - 1].next) {
+        topic_router_entry_t* entry = &router->routers[idx - 1];
+        if (entry->type != type) continue;
+
+        topic_router_batch_t* batch = (entry->type == TOPIC_ROUTER_TYPE_BATCH) ? entry->u.batch : NULL;
+        __route_unlink(router, idx);
+        /* sink的最后一个Router移除后不再参与flush */
+        if (batch) {
+            __batch_unregister(router, batch);
         }
+        __table_publish(router, table);
+        os_semaphore_give(router->lock);
+        return 0;
     }
-    
+
+    os_free(table);
+    os_semaphore_give(router->lock);
     return -1;
 }
 
+/*
+ * @brief 等待宽限期：此前进入topic_router_route的调用全部退出
+ * @param router Topic Router指针
+ */
+void topic_router_synchronize(topic_router_t* router) {
+    if (!router || !router->lock) return;
+
+    /* 纪元推进两次后，调用前进入读区的读者（分属当前与上一代奇偶槽）均已退出 */
+    uint32_t start = (uint32_t)atomic_load_explicit(&router->rcu_epoch, memory_order_seq_cst);
+    while ((uint32_t)((uint32_t)atomic_load_explicit(&router->rcu_epoch, memory_order_seq_cst) - start) < 2U) {
+        if (!__rcu_advance(router)) {
+            os_thread_sleep_ms(1);  /* 读者可能是被抢占的低优先级任务 */
+        }
+    }
+
+    if (os_semaphore_take(router->lock, 100) > 0) {
+        __rcu_reclaim(router);
+        os_semaphore_give(router->lock);
+    }
+}
+
+/*
+ * @brief 获取Topic的Router数量
+ * @param router Topic Router指针
+ * @param topic_id Topic ID
+ * @return Router数量
+ */
+size_t topic_router_count(topic_router_t* router, uint16_t topic_id) {
+    if (!router || !router->lock) return 0;
+    if (os_semaphore_take(router->lock, 100) < 0) return 0;
+
+    size_t count = 0;
+    size_t pos = router->topic_index
+                     ? __index_find(router->topic_index, router->routers, router->topic_index_bits, topic_id)
+                     : SIZE_MAX;
+    if (pos != SIZE_MAX) {
+        for (uint32_t idx = router->topic_index[pos]; idx != 0; idx = router->routers[idx - 1].next) {
+            count++;
+        }
+    }
+    os_semaphore_give(router->lock);
+    return count;
+}
+
+/*
+ * @brief 发送全部批量sink中已汇聚的记录
+ * @param router Topic Router指针
+ * @return 本次发送的记录数
+ */
+size_t topic_router_flush(topic_router_t* router) {
+    if (!router) return 0;
+    size_t sent = 0;
+    /* 遍历快照中的sink，只取各sink的锁，发送期间并发的route与增删不被阻塞 */
+    uint32_t rcu_idx = __rcu_read_lock(router);
+    const topic_router_table_t* table = atomic_load_explicit(&router->table, memory_order_seq_cst);
+    for (size_t i = 0; table && i < table->batch_count; ++i) {
+        sent += topic_router_batch_flush(table->batches[i]);
+    }
+    __rcu_read_unlock(router, rcu_idx);
+    return sent;
+}
+
+/*
+ * @brief 发送最早一条记录已等待max_delay_ms的批量sink
+ * @param router Topic Router指针
+ * @return 本次发送的记录数
+ */
+size_t topic_router_flush_due(topic_router_t* router) {
+    if (!router) return 0;
+    size_t sent = 0;
+    uint64_t now_us = os_monotonic_time_get_microsecond();
+    uint32_t rcu_idx = __rcu_read_lock(router);
+    const topic_router_table_t* table = atomic_load_explicit(&router->table, memory_order_seq_cst);
+    for (size_t i = 0; table && i < table->batch_count; ++i) {
+        topic_router_batch_t* batch = table->batches[i];
+        if (!batch->lock || os_semaphore_take(batch->lock, 100) < 0) continue;
+        if (__batch_due(batch, now_us)) {
+            sent += __batch_flush_locked(batch);
+        }
+        os_semaphore_give(batch->lock);
+    }
+    __rcu_read_unlock(router, rcu_idx);
+    return sent;
+}
+
+/*
+ * @brief 初始化批量sink
+ * @param batch 批量sink
+ * @param buf 汇聚缓冲
+ * @param capacity 缓冲容量
+ * @param max_count 达到该条数立即发送（0表示只按容量）
+ * @param flush 发送函数
+ * @param user_data 发送函数的用户数据
+ * @return 0成功，-1失败
+ */
+int topic_router_batch_init(topic_router_batch_t* batch, uint8_t* buf, size_t capacity, size_t max_count,
+                            topic_router_flush_t flush, void* user_data) {
+    if (!batch || !buf || !flush || capacity < sizeof(topic_router_batch_hdr_t)) return -1;
+
+    memset(batch, 0, sizeof(*batch));
+    batch->lock = os_semaphore_create(1, NULL);
+    if (!batch->lock) return -1;
+    batch->buf = buf;
+    batch->capacity = capacity;
+    batch->max_count = max_count;
+    batch->max_delay_ms = TOPIC_ROUTER_BATCH_MAX_DELAY_MS;
+    batch->flush = flush;
+    batch->user_data = user_data;
+    return 0;
+}
+
+/*
+ * @brief 设置批量sink中最早一条记录最多等待的时间
+ * @param batch 批量sink
+ * @param max_delay_ms 最长等待（毫秒），0表示只按容量/条数发送
+ * @return 0成功，-1失败
+ */
+int topic_router_batch_set_max_delay(topic_router_batch_t* batch, uint32_t max_delay_ms) {
+    if (!batch || !batch->lock) return -1;
+    if (os_semaphore_take(batch->lock, 100) < 0) return -1;
+    batch->max_delay_ms = max_delay_ms;
+    os_semaphore_give(batch->lock);
+    return 0;
+}
+
+/*
+ * @brief 释放批量sink
+ * @param batch 批量sink
+ * @return 0成功，-1失败
+ */
+int topic_router_batch_deinit(topic_router_batch_t* batch) {
+    if (!batch) return -1;
+
+    topic_router_t* router = batch->owner;
+    if (router) {
+        /* 仍登记在Router上：锁内移除引用本sink的全部条目并注销，再等待仍在使用旧快照的route/flush退出 */
+        if (os_semaphore_take(router->lock, 100) < 0) return -1;
+        topic_router_table_t* table = __table_alloc(router);
+        if (!table) {
+            os_semaphore_give(router->lock);
+            return -1;
+        }
+        for (size_t i = 0; i < router->max_routers; ++i) {
+            const topic_router_entry_t* entry = &router->routers[i];
+            if (entry->in_use && entry->type == TOPIC_ROUTER_TYPE_BATCH && entry->u.batch == batch) {
+                __route_unlink(router, (uint32_t)i + 1U);
+            }
+        }
+        __batch_unregister(router, batch);
+        __table_publish(router, table);
+        os_semaphore_give(router->lock);
+        topic_router_synchronize(router);
+    }
+
+    if (batch->lock) {
+        os_semaphore_destroy(batch->lock);
+        batch->lock = NULL;
+    }
+    batch->len = 0;
+    batch->count = 0;
+    return 0;
+}
+
+/*
+ * @brief 发送批量sink中已汇聚的记录
+ * @param batch 批量sink
+ * @return 本次发送的记录数
+ */
+size_t topic_router_batch_flush(topic_router_batch_t* batch) {
+    if (!batch || !batch->lock) return 0;
+    if (os_semaphore_take(batch->lock, 100) < 0) return 0;
+    size_t sent = __batch_flush_locked(batch);
+    os_semaphore_give(batch->lock);
+    return sent;
+}
+
+/*
+ * @brief 逐条解析批量数据
+ * @param batch 批量数据
+ * @param len 批量数据长度
+ * @param offset 解析位置
+ * @param topic_id 输出Topic ID
+ * @param data 输出负载指针
+ * @param data_len 输出负载长度
+ * @return 0成功，-1已解析完或数据不完整
+ */
+int topic_router_batch_next(const void* batch, size_t len, size_t* offset,
+                            uint16_t* topic_id, const void** data, size_t* data_len) {
+    if (!batch || !offset || *offset + sizeof(topic_router_batch_hdr_t) > len) return -1;
+
+    const uint8_t* p = (const uint8_t*)batch + *offset;
+    topic_router_batch_hdr_t hdr = {
+        .topic_id = (uint16_t)(p[0] | (p[1] << 8)),
+        .len = (uint16_t)(p[2] | (p[3] << 8)),
+    };
+    if (*offset + sizeof(hdr) + hdr.len > len) return -1;
+
+    if (topic_id) *topic_id = hdr.topic_id;
+    if (data) *data = p + sizeof(hdr);
+    if (data_len) *data_len = hdr.len;
+    *offset += TOPIC_ROUTER_BATCH_ALIGN(sizeof(hdr) + hdr.len);
+    return 0;
+}
+
+#if TOPIC_ROUTER_ENABLE_VFB
+/*
+ * @brief 通过VFB发送整批记录
+ * @param batch 批量数据
+ * @param len 批量数据长度
+ * @param count 记录数
+ * @param user_data VFB事件键
+ * @return 0成功，-1失败
+ */
+int topic_router_vfb_flush(const void* batch, size_t len, size_t count, void* user_data) {
+    if (len > 0xFFFFU) return -1;
+    vfb_event_t event = (vfb_event_t)(uintptr_t)user_data;
+    return (vfb_send(event, (uint32_t)count, (void*)(uintptr_t)batch, (uint16_t)len) == FD_PASS) ? 0 : -1;
+}
+#endif
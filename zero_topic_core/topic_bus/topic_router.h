@@ -3,8 +3,10 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include <stdatomic.h>
 #include "topic_bus_config.h"
 #include "../obj_dict/obj_dict.h"
+#include "../../Rte/inc/os_semaphore.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,27 +16,90 @@ extern "C" {
 typedef enum {
     TOPIC_ROUTER_TYPE_VFB,      /* VFB消息队列广播 */
     TOPIC_ROUTER_TYPE_CUSTOM,   /* 自定义服务处理 */
+    TOPIC_ROUTER_TYPE_BATCH,    /* 汇聚到批量sink，成批发送 */
 } topic_router_type_t;
 
 /* Router回调函数类型 */
 typedef int (*topic_router_callback_t)(uint16_t topic_id, const void* data, size_t data_len, void* user_data);
 
+/*
+ * 批量sink的发送函数类型
+ * batch为若干条记录依次排列：每条记录为topic_router_batch_hdr_t + 负载，按4字节对齐，
+ * 可用topic_router_batch_next逐条解析；返回0表示发送成功
+ */
+typedef int (*topic_router_flush_t)(const void* batch, size_t len, size_t count, void* user_data);
+
+/* 批量记录头（在缓冲中按小端存放，与主机字节序无关） */
+typedef struct {
+    uint16_t topic_id;                  /* Topic ID */
+    uint16_t len;                       /* 负载长度（不含头与填充） */
+} topic_router_batch_hdr_t;
+
+/* 批量sink：多个Topic的负载汇聚到同一缓冲，满、达到条数上限、最早一条等待超时或显式flush时整体发送 */
+typedef struct topic_router_batch {
+    uint8_t* buf;                       /* 汇聚缓冲 */
+    size_t capacity;                    /* 缓冲容量 */
+    size_t len;                         /* 已汇聚字节数 */
+    size_t count;                       /* 已汇聚记录数 */
+    size_t max_count;                   /* 达到该条数立即发送（0表示只按容量） */
+    uint32_t max_delay_ms;              /* 最早一条记录最多等待的时间（0表示不按时间发送） */
+    uint64_t first_us;                  /* 最早一条未发送记录的汇聚时刻 */
+    topic_router_flush_t flush;         /* 发送函数 */
+    void* user_data;                    /* 发送函数的用户数据 */
+    OsSemaphore_t* lock;                /* 汇聚/发送互斥 */
+    struct topic_router* owner;         /* 登记到的Router（一个sink只能属于一个Router） */
+    struct topic_router_batch* next;    /* Router内的sink链表 */
+    uint32_t flushes;                   /* 发送次数 */
+    uint32_t dropped;                   /* 超过缓冲容量或发送失败而丢弃的记录数 */
+} topic_router_batch_t;
+
 /* Router条目结构 */
 typedef struct {
     topic_router_type_t type;           /* Router类型 */
+    uint8_t in_use;                     /* 非0表示槽位已占用 */
+    uint16_t topic_id;                  /* 所属Topic */
+    uint32_t next;                      /* 同一Topic的下一条目（下标+1，0为结束） */
     union {
         obj_dict_key_t vfb_event_key;   /* VFB事件键（用于VFB类型） */
         topic_router_callback_t custom_cb;  /* 自定义回调（用于自定义类型） */
+        topic_router_batch_t* batch;    /* 批量sink（用于批量类型） */
     } u;
-    void* user_data;                    /* 用户数据（用于匹配topic_id和回调参数） */
     void* callback_user_data;           /* 回调函数的用户数据（仅用于自定义类型） */
 } topic_router_entry_t;
 
-/* Topic Router结构 */
+/*
+ * 发布用的Router快照（写时复制：增删时在锁内重建并原子替换，topic_router_route无锁读取）
+ *   index与Router索引同容量同布局，存routes下标+1；同一Topic的条目在routes中连续存放（next不使用）；
+ *   batches为已登记sink的拷贝，flush据此遍历，不持有router->lock
+ */
+typedef struct topic_router_table {
+    struct topic_router_table* retire_next;  /* 待回收链表（仅写者在router->lock下访问） */
+    uint32_t retire_epoch;                   /* 退役时的纪元 */
+    size_t count;                            /* 条目数 */
+    size_t batch_count;                      /* 已登记sink数 */
+    topic_router_batch_t** batches;          /* 已登记sink（位于routes之后） */
+    uint32_t* index;                         /* topic_id -> 首条目开放寻址表（位于batches之后） */
+    topic_router_entry_t routes[];           /* 按Topic连续存放的条目 */
+} topic_router_table_t;
+
+/*
+ * Topic Router结构
+ *   条目数组、索引与sink链表由lock保护，增删后发布新的快照；topic_router_route在纪元读区内
+ *   一次原子加载取得快照后直接回调或汇聚，不加锁，运行中可增删Router；flush同样遍历快照中的sink，
+ *   只持有各sink自己的锁；旧快照在宽限期后回收；回调与sink的发送函数中不要调用本Router的flush接口
+ */
 struct topic_router {
     topic_router_entry_t* routers;      /* Router条目数组 */
     size_t max_routers;                 /* 最大Router数量 */
     size_t router_count;                /* 当前Router数量 */
+    uint32_t* topic_index;              /* topic_id -> 首条目开放寻址表（存下标+1，0为空） */
+    uint8_t topic_index_bits;           /* 开放寻址表容量的位宽 */
+    topic_router_batch_t* batches;      /* 已登记的批量sink */
+    OsSemaphore_t* lock;                /* 配置互斥 */
+    _Atomic(topic_router_table_t*) table;   /* 发布用快照（尚无Router时为NULL） */
+    atomic_uint_fast32_t rcu_epoch;         /* 快照回收纪元 */
+    atomic_uint_fast32_t rcu_readers[2];    /* 按纪元奇偶计数的活跃读者 */
+    topic_router_table_t* rcu_retired;      /* 已退役待回收的快照 */
 };
 typedef struct topic_router topic_router_t;
 
@@ -48,7 +113,14 @@ typedef struct topic_router topic_router_t;
 int topic_router_init(topic_router_t* router, topic_router_entry_t* routers, size_t max_routers);
 
 /*
- * @brief 添加VFB Router
+ * @brief 释放Topic Router的索引与快照（不释放条目数组与批量sink，调用时不能有并发的route）
+ * @param router Topic Router指针
+ * @return 0成功，-1失败
+ */
+int topic_router_deinit(topic_router_t* router);
+
+/*
+ * @brief 添加VFB Router（每个Topic至多TOPIC_BUS_MAX_ROUTERS_PER_TOPIC条）
  * @param router Topic Router指针
  * @param topic_id Topic ID
  * @param vfb_event_key VFB事件键
@@ -59,7 +131,7 @@ int topic_router_add_vfb(topic_router_t* router, uint16_t topic_id, obj_dict_key
 /*
  * @brief 添加自定义Router
  * @param router Topic Router指针
- * @param topic_id Topic ID（用于索引，当前版本暂不支持）
+ * @param topic_id Topic ID
  * @param callback 回调函数
  * @param user_data 用户数据
  * @return 0成功，-1失败
@@ -67,6 +139,16 @@ int topic_router_add_vfb(topic_router_t* router, uint16_t topic_id, obj_dict_key
 int topic_router_add_custom(topic_router_t* router, uint16_t topic_id,
                              topic_router_callback_t callback, void* user_data);
 
+/*
+ * @brief 添加批量Router：Topic负载汇聚到sink，多个Topic可共用同一sink
+ * @details sink只能登记到一个Router（sink链表为侵入式），登记到其他Router时返回-1
+ * @param router Topic Router指针
+ * @param topic_id Topic ID
+ * @param batch 已初始化的批量sink
+ * @return 0成功，-1失败
+ */
+int topic_router_add_batch(topic_router_t* router, uint16_t topic_id, topic_router_batch_t* batch);
+
 /*
  * @brief 处理Topic触发（当Topic触发时调用）
  * @param router Topic Router指针
@@ -79,7 +161,8 @@ int topic_router_route(topic_router_t* router, uint16_t topic_id,
                         const void* data, size_t data_len);
 
 /*
- * @brief 移除Router
+ * @brief 移除Router（移除sink的最后一个Router时sink随之从Router注销，之后可登记到其他Router；
+ *        正在进行的发布可能仍在使用移除前的快照，释放回调的用户数据前调用topic_router_synchronize）
  * @param router Topic Router指针
  * @param topic_id Topic ID
  * @param type Router类型
@@ -87,9 +170,95 @@ int topic_router_route(topic_router_t* router, uint16_t topic_id,
  */
 int topic_router_remove(topic_router_t* router, uint16_t topic_id, topic_router_type_t type);
 
+/*
+ * @brief 等待宽限期：此前进入topic_router_route的调用全部退出（不能在Router回调中调用）
+ * @param router Topic Router指针
+ */
+void topic_router_synchronize(topic_router_t* router);
+
+/*
+ * @brief 获取Topic的Router数量
+ * @param router Topic Router指针
+ * @param topic_id Topic ID
+ * @return Router数量
+ */
+size_t topic_router_count(topic_router_t* router, uint16_t topic_id);
+
+/*
+ * @brief 发送全部批量sink中已汇聚的记录
+ * @param router Topic Router指针
+ * @return 本次发送的记录数
+ */
+size_t topic_router_flush(topic_router_t* router);
+
+/*
+ * @brief 发送最早一条记录已等待max_delay_ms的批量sink
+ * @details 汇聚时也会检查等待时间，但最后一条记录之后不再有追加时需由本函数发出；
+ *          Topic Server在没有ISR事件的轮次调用，不使用Server时由应用周期调用
+ * @param router Topic Router指针
+ * @return 本次发送的记录数
+ */
+size_t topic_router_flush_due(topic_router_t* router);
+
+/*
+ * @brief 初始化批量sink
+ * @param batch 批量sink
+ * @param buf 汇聚缓冲
+ * @param capacity 缓冲容量
+ * @param max_count 达到该条数立即发送（0表示只按容量）
+ * @param flush 发送函数
+ * @param user_data 发送函数的用户数据
+ * @return 0成功，-1失败
+ */
+int topic_router_batch_init(topic_router_batch_t* batch, uint8_t* buf, size_t capacity, size_t max_count,
+                            topic_router_flush_t flush, void* user_data);
+
+/*
+ * @brief 设置批量sink中最早一条记录最多等待的时间（初始化为TOPIC_ROUTER_BATCH_MAX_DELAY_MS）
+ * @param batch 批量sink
+ * @param max_delay_ms 最长等待（毫秒），0表示只按容量/条数发送
+ * @return 0成功，-1失败
+ */
+int topic_router_batch_set_max_delay(topic_router_batch_t* batch, uint32_t max_delay_ms);
+
+/*
+ * @brief 释放批量sink（不发送未发送的记录，需要时先调用topic_router_flush）
+ * @details 仍登记在Router上时先移除引用它的全部Router并注销，再等待宽限期，之后才销毁sink锁；
+ *          不能在同一Router的回调或发送函数中调用；Router锁超时或内存不足时返回-1，sink保持可用
+ * @param batch 批量sink
+ * @return 0成功，-1失败
+ */
+int topic_router_batch_deinit(topic_router_batch_t* batch);
+
+/*
+ * @brief 发送批量sink中已汇聚的记录
+ * @param batch 批量sink
+ * @return 本次发送的记录数
+ */
+size_t topic_router_batch_flush(topic_router_batch_t* batch);
+
+/*
+ * @brief 逐条解析批量数据（接收端使用）
+ * @param batch 批量数据
+ * @param len 批量数据长度
+ * @param offset 解析位置（首次传入0，成功后前进到下一条）
+ * @param topic_id 输出Topic ID
+ * @param data 输出负载指针
+ * @param data_len 输出负载长度
+ * @return 0成功，-1已解析完或数据不完整
+ */
+int topic_router_batch_next(const void* batch, size_t len, size_t* offset,
+                            uint16_t* topic_id, const void** data, size_t* data_len);
+
+#if TOPIC_ROUTER_ENABLE_VFB
+/*
+ * @brief 通过VFB发送整批记录的发送函数（user_data为VFB事件键，VFB消息的data字段为记录数）
+ */
+int topic_router_vfb_flush(const void* batch, size_t len, size_t count, void* user_data);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
 
 #endif /* TOPIC_ROUTER_H_ */
-
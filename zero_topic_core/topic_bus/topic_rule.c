@@ -21,7 +21,11 @@ int topic_rule_can_trigger(const topic_rule_t* rule, obj_dict_key_t event_key) {
 
     switch (rule->type) {
         case TOPIC_RULE_OR:
-            /* OR规则：任意事件匹配即可触发 */
+        case TOPIC_RULE_WINDOW:
+        case TOPIC_RULE_DEBOUNCE:
+        case TOPIC_RULE_THROTTLE:
+        case TOPIC_RULE_EDGE:
+            /* OR及过滤类规则：任意事件匹配即可参与评估（过滤在发布时由总线完成） */
         {
             int matched = 0;
             for (size_t i = 0; i < rule->event_count; ++i) {
@@ -73,27 +77,46 @@ void topic_rule_update_mask(topic_rule_t* rule, obj_dict_key_t event_key, int tr
     if (!rule || !rule->events) return;
 
     /* 查找事件在列表中的位置 */
-    for (size_t i = 0; i < rule->event_count && i < 32; ++i) {
+    for (size_t i = 0; i < rule->event_count; ++i) {
         if (rule->events[i] == event_key) {
-            uint32_t bit_mask = 1U << i;
-#if TOPIC_BUS_ENABLE_ATOMICS
             if (triggered) {
-                atomic_fetch_or_explicit(&rule->trigger_mask, bit_mask, memory_order_acq_rel);
-            } else {
+                topic_rule_set_mask_bit(rule, i);
+            } else if (i < 32) {
+                uint32_t bit_mask = 1U << i;
+#if TOPIC_BUS_ENABLE_ATOMICS
                 atomic_fetch_and_explicit(&rule->trigger_mask, ~bit_mask, memory_order_acq_rel);
-            }
 #else
-            if (triggered) {
-                rule->trigger_mask |= bit_mask;
-            } else {
                 rule->trigger_mask &= ~bit_mask;
-            }
 #endif
+            } else if (rule->trigger_mask_ext) {
+                rule->trigger_mask_ext[(i - 32) / 32] &= ~(1U << ((i - 32) % 32));
+            }
             break;
         }
     }
 }
 
+/*
+ * @brief 按事件下标置位触发掩码（用于AND规则）
+ * @param rule 规则指针
+ * @param event_index 事件在rule->events中的下标
+ */
+void topic_rule_set_mask_bit(topic_rule_t* rule, size_t event_index) {
+    if (!rule || event_index >= rule->event_count) return;
+
+    if (event_index < 32) {
+        uint32_t bit_mask = 1U << event_index;
+#if TOPIC_BUS_ENABLE_ATOMICS
+        atomic_fetch_or_explicit(&rule->trigger_mask, bit_mask, memory_order_acq_rel);
+#else
+        rule->trigger_mask |= bit_mask;
+#endif
+    } else if (rule->trigger_mask_ext) {
+        /* 扩展掩码只在持有bus->lock时访问 */
+        rule->trigger_mask_ext[(event_index - 32) / 32] |= 1U << ((event_index - 32) % 32);
+    }
+}
+
 /*
  * @brief 重置触发掩码
  * @param rule 规则指针
@@ -105,6 +128,9 @@ void topic_rule_reset_mask(topic_rule_t* rule) {
 #else
     rule->trigger_mask = 0;
 #endif
+    if (rule->trigger_mask_ext) {
+        memset(rule->trigger_mask_ext, 0, sizeof(uint32_t) * TOPIC_RULE_MASK_EXT_WORDS(rule->event_count));
+    }
 }
 
 /*
@@ -118,18 +144,31 @@ int topic_rule_matches(const topic_rule_t* rule, obj_dict_key_t event_key) {
 
     switch (rule->type) {
         case TOPIC_RULE_OR:
-            /* OR规则：任意匹配即可 */
+        case TOPIC_RULE_WINDOW:
+        case TOPIC_RULE_DEBOUNCE:
+        case TOPIC_RULE_THROTTLE:
+        case TOPIC_RULE_EDGE:
+            /* OR及过滤类规则：任意匹配即可（过滤状态由topic_rule_evaluate判定） */
             return topic_rule_can_trigger(rule, event_key);
 
         case TOPIC_RULE_AND: {
-            /* AND规则：需要检查是否所有位都已置位 */
-            uint32_t full_mask = (1U << rule->event_count) - 1;
+            /* AND规则：需要检查是否所有位都已置位（超过32个事件时逐字检查扩展掩码） */
+            size_t count = rule->event_count;
+            uint32_t full_mask = (count >= 32) ? 0xFFFFFFFFU : ((1U << count) - 1U);
 #if TOPIC_BUS_ENABLE_ATOMICS
-            uint32_t current_mask = atomic_load_explicit(&rule->trigger_mask, memory_order_acquire);
+            uint32_t current_mask = (uint32_t)atomic_load_explicit(&rule->trigger_mask, memory_order_acquire);
 #else
             uint32_t current_mask = rule->trigger_mask;
 #endif
-            return (current_mask == full_mask);
+            if (current_mask != full_mask) return 0;
+            if (count <= 32) return 1;
+            if (!rule->trigger_mask_ext) return 0;
+            for (size_t w = 0; w < TOPIC_RULE_MASK_EXT_WORDS(count); ++w) {
+                size_t bits = count - 32 - w * 32;
+                uint32_t word_full = (bits >= 32) ? 0xFFFFFFFFU : ((1U << bits) - 1U);
+                if (rule->trigger_mask_ext[w] != word_full) return 0;
+            }
+            return 1;
         }
 
         case TOPIC_RULE_MANUAL:
@@ -153,6 +192,26 @@ int topic_rule_check_timeout(const topic_rule_t* rule, obj_dict_key_t event_key,
     
     obj_dict_t* obj_dict = (obj_dict_t*)dict;
     
+    /* 从对象字典获取事件时间戳 */
+    /* 事件不存在时以0时间戳判定：不判断时效性的事件仍满足，其余事件超时 */
+    uint64_t event_ts_us = 0;
+    if (obj_dict_get(obj_dict, event_key, NULL, 0, &event_ts_us, NULL, NULL) < 0) {
+        event_ts_us = 0;
+    }
+    
+    return topic_rule_check_timeout_at(rule, event_key, event_ts_us);
+}
+
+/*
+ * @brief 按给定的事件时间戳检查时效性
+ * @param rule 规则指针
+ * @param event_key 事件键
+ * @param event_ts_us 事件数据时间戳（微秒）
+ * @return 1表示满足时效性，0表示超时或事件不属于该规则
+ */
+int topic_rule_check_timeout_at(const topic_rule_t* rule, obj_dict_key_t event_key, uint64_t event_ts_us) {
+    if (!rule) return 0;
+    
     /* 查找事件在列表中的位置 */
     size_t event_index = SIZE_MAX;
     for (size_t i = 0; i < rule->event_count; ++i) {
@@ -164,9 +223,23 @@ int topic_rule_check_timeout(const topic_rule_t* rule, obj_dict_key_t event_key,
     
     if (event_index == SIZE_MAX) return 0;
     
+    return topic_rule_check_timeout_index(rule, event_index, event_ts_us, os_monotonic_time_get_microsecond());
+}
+
+/*
+ * @brief 按事件下标检查时效性
+ * @param rule 规则指针
+ * @param event_index 事件在rule->events中的下标
+ * @param event_ts_us 事件数据时间戳（微秒）
+ * @param now_us 当前单调时间（微秒）
+ * @return 1表示满足时效性，0表示超时或下标越界
+ */
+int topic_rule_check_timeout_index(const topic_rule_t* rule, size_t event_index, uint64_t event_ts_us, uint64_t now_us) {
+    if (!rule || event_index >= rule->event_count) return 0;
+    
     /* 获取该事件的超时配置 */
     uint32_t timeout_ms = TOPIC_BUS_DEFAULT_EVENT_TIMEOUT_MS;
-    if (rule->event_timeouts_ms && event_index < rule->event_count) {
+    if (rule->event_timeouts_ms) {
         timeout_ms = rule->event_timeouts_ms[event_index];
     }
     
@@ -175,18 +248,138 @@ int topic_rule_check_timeout(const topic_rule_t* rule, obj_dict_key_t event_key,
         return 1;
     }
     
-    /* 从对象字典获取事件时间戳 */
-    uint64_t event_ts_us = 0;
-    if (obj_dict_get(obj_dict, event_key, NULL, 0, &event_ts_us, NULL, NULL) < 0) {
-        return 0;  /* 事件不存在 */
+    /* 时间戳为0表示事件从未写入对象字典 */
+    if (event_ts_us == 0) {
+        return 0;
     }
     
     /* 检查时效性 */
-    uint64_t now_us = os_monotonic_time_get_microsecond();
     uint64_t elapsed_us = (now_us >= event_ts_us) ? (now_us - event_ts_us) : 0;
     uint64_t timeout_us = (uint64_t)timeout_ms * 1000ULL;
     
     return (elapsed_us <= timeout_us) ? 1 : 0;
 }
 
+/*
+ * @brief 计算EDGE规则使用的数据摘要（FNV-1a）
+ * @param data 数据指针
+ * @param data_len 数据长度
+ * @return 数据摘要，保证不为0（0表示事件尚未发布）
+ */
+uint32_t topic_rule_data_hash(const void* data, size_t data_len) {
+    uint32_t hash = 2166136261U;
+    const uint8_t* p = (const uint8_t*)data;
+    for (size_t i = 0; p && i < data_len; ++i) {
+        hash ^= p[i];
+        hash *= 16777619U;
+    }
+    return hash ? hash : 1U;
+}
+
+/*
+ * @brief AND规则：置位触发事件并在集齐后检查其余事件的时效性
+ */
+static int __evaluate_and(topic_rule_t* rule, size_t event_index, uint64_t now_us, void* dict) {
+    topic_rule_set_mask_bit(rule, event_index);
+    if (!topic_rule_matches(rule, rule->events[event_index])) return 0;
+
+    /* 检查所有事件的时效性（触发事件本身已检查） */
+    int all_timeout_ok = 1;
+    obj_dict_key_t event_key = rule->events[event_index];
+    for (size_t j = 0; j < rule->event_count; ++j) {
+        if (rule->events[j] == event_key) continue;
+        int ok = rule->event_ts_us
+               ? topic_rule_check_timeout_index(rule, j, rule->event_ts_us[j], now_us)
+               : topic_rule_check_timeout(rule, rule->events[j], dict);
+        if (!ok) {
+            all_timeout_ok = 0;
+            break;
+        }
+    }
+
+    /* 触发或有事件超时，均重置掩码，准备下次触发 */
+    topic_rule_reset_mask(rule);
+    return all_timeout_ok;
+}
+
+/*
+ * @brief WINDOW规则：统计上次触发后、窗口内发布过的不同事件数
+ */
+static int __evaluate_window(topic_rule_t* rule, uint64_t event_ts_us) {
+    if (!rule->event_ts_us) return 0;
+
+    size_t need = (rule->min_count == 0 || rule->min_count > rule->event_count)
+                ? rule->event_count : rule->min_count;
+    uint64_t window_us = (uint64_t)rule->interval_ms * 1000ULL;
+    size_t hits = 0;
+    for (size_t j = 0; j < rule->event_count && hits < need; ++j) {
+        uint64_t ts = rule->event_ts_us[j];
+        if (ts == 0 || ts <= rule->last_trigger_us) continue;       /* 未发布或已计入上一次触发 */
+        if (event_ts_us >= ts && event_ts_us - ts > window_us) continue;  /* 窗口外 */
+        ++hits;
+    }
+    if (hits < need) return 0;
+
+    /* 已计入的事件不再参与下一次窗口 */
+    rule->last_trigger_us = event_ts_us;
+    return 1;
+}
+
+/*
+ * @brief 评估一次已通过时效检查的规则事件
+ * @param rule 规则指针（event_ts_us快照已写入本次事件）
+ * @param event_index 触发事件在rule->events中的下标
+ * @param event_ts_us 触发事件的数据时间戳（微秒）
+ * @param now_us 当前单调时间（微秒）
+ * @param data_hash 触发事件的数据摘要（仅EDGE规则使用）
+ * @param dict 对象字典（规则无时效快照时使用）
+ * @return 1表示规则本次触发，0表示不触发
+ */
+int topic_rule_evaluate(topic_rule_t* rule, size_t event_index, uint64_t event_ts_us, uint64_t now_us,
+                        uint32_t data_hash, void* dict) {
+    if (!rule || !rule->events || event_index >= rule->event_count) return 0;
+
+    int fire = 0;
+    switch (rule->type) {
+        case TOPIC_RULE_OR:
+            return 1;
+
+        case TOPIC_RULE_AND:
+            return __evaluate_and(rule, event_index, now_us, dict);
+
+        case TOPIC_RULE_WINDOW:
+            fire = __evaluate_window(rule, event_ts_us);
+            break;
 
+        case TOPIC_RULE_DEBOUNCE: {
+            /* 每个事件都顺延静默期，只有静默期后的第一个事件触发 */
+            uint64_t interval_us = (uint64_t)rule->interval_ms * 1000ULL;
+            fire = (rule->last_event_us == 0 || now_us - rule->last_event_us >= interval_us);
+            rule->last_event_us = now_us;
+            break;
+        }
+
+        case TOPIC_RULE_THROTTLE: {
+            uint64_t interval_us = (uint64_t)rule->interval_ms * 1000ULL;
+            fire = (rule->last_trigger_us == 0 || now_us - rule->last_trigger_us >= interval_us);
+            if (fire) {
+                rule->last_trigger_us = now_us;
+            }
+            break;
+        }
+
+        case TOPIC_RULE_EDGE:
+            if (!rule->event_hash) return 1;
+            fire = (rule->event_hash[event_index] != data_hash);
+            rule->event_hash[event_index] = data_hash;
+            break;
+
+        default:
+            return 0;
+    }
+
+    if (!fire) {
+        rule->suppressed_count++;
+    }
+    return fire;
+}
@@ -16,20 +16,35 @@ extern "C" {
 typedef enum {
     TOPIC_RULE_OR,      /* 任一事件触发 */
     TOPIC_RULE_AND,     /* 全部事件触发 */
-    TOPIC_RULE_MANUAL   /* 手动触发 */
+    TOPIC_RULE_MANUAL,  /* 手动触发 */
+    TOPIC_RULE_WINDOW,  /* N-of-M：interval_ms窗口内有min_count个不同事件发布时触发 */
+    TOPIC_RULE_DEBOUNCE,/* 去抖：任一事件触发，距上一次规则事件不足interval_ms时抑制（突发只在开头触发一次） */
+    TOPIC_RULE_THROTTLE,/* 限频：任一事件触发，两次触发的间隔不小于interval_ms */
+    TOPIC_RULE_EDGE     /* 边沿：事件数据与该事件上一次发布的数据不同时触发 */
 } topic_rule_type_t;
 
+/* AND规则第32个之后的事件使用的扩展掩码字数 */
+#define TOPIC_RULE_MASK_EXT_WORDS(event_count) (((event_count) > 32U) ? (((event_count) - 1U) / 32U) : 0U)
+
 /* Topic规则结构 */
 typedef struct {
     topic_rule_type_t type;          /* 规则类型 */
     obj_dict_key_t* events;          /* 事件列表 */
     size_t event_count;              /* 事件数量 */
     uint32_t* event_timeouts_ms;     /* 每个事件的超时时间（毫秒），若为NULL则使用默认值 */
+    uint64_t* event_ts_us;           /* 每个事件最近一次发布时的数据时间戳快照（由总线维护，持有bus->lock访问） */
 #if TOPIC_BUS_ENABLE_ATOMICS
     atomic_uint_fast32_t trigger_mask;  /* 触发掩码（AND规则用，原子操作） */
 #else
     uint32_t trigger_mask;           /* 触发掩码（AND规则用） */
 #endif
+    uint32_t* trigger_mask_ext;      /* AND规则第32个之后事件的触发位（由总线分配，持有bus->lock访问） */
+    uint32_t interval_ms;            /* WINDOW：窗口长度；DEBOUNCE：静默时间；THROTTLE：最小触发间隔 */
+    uint32_t min_count;              /* WINDOW：窗口内需发布的不同事件数，0表示全部 */
+    uint32_t* event_hash;            /* EDGE：各事件最近一次数据摘要，0表示尚未发布（由总线分配） */
+    uint64_t last_trigger_us;        /* WINDOW/THROTTLE：最近一次触发时间（运行期） */
+    uint64_t last_event_us;          /* DEBOUNCE：最近一次规则事件时间（运行期） */
+    uint32_t suppressed_count;       /* 被规则过滤（去抖/限频/边沿/窗口未满）的事件数（运行期） */
 #if TOPIC_BUS_ENABLE_RULE_CACHE
     /* 简单规则缓存：缓存最近一次匹配的event_key及结果 */
     obj_dict_key_t last_event_key_cached;
@@ -43,6 +58,9 @@ int topic_rule_can_trigger(const topic_rule_t* rule, obj_dict_key_t event_key);
 /* 更新触发掩码（用于AND规则） */
 void topic_rule_update_mask(topic_rule_t* rule, obj_dict_key_t event_key, int triggered);
 
+/* 按事件下标置位触发掩码（用于AND规则，无查找） */
+void topic_rule_set_mask_bit(topic_rule_t* rule, size_t event_index);
+
 /* 重置触发掩码 */
 void topic_rule_reset_mask(topic_rule_t* rule);
 
@@ -57,6 +75,42 @@ int topic_rule_matches(const topic_rule_t* rule, obj_dict_key_t event_key);
  */
 int topic_rule_check_timeout(const topic_rule_t* rule, obj_dict_key_t event_key, void* dict);
 
+/* 按给定的事件时间戳检查时效性（数据不在对象字典中时使用）
+ * @param rule 规则指针
+ * @param event_key 事件键
+ * @param event_ts_us 事件数据时间戳（微秒，0表示事件从未写入）
+ * @return 1表示满足时效性，0表示超时或事件不属于该规则
+ */
+int topic_rule_check_timeout_at(const topic_rule_t* rule, obj_dict_key_t event_key, uint64_t event_ts_us);
+
+/* 按事件在规则中的下标检查时效性（无查找，供总线热路径使用）
+ * @param rule 规则指针
+ * @param event_index 事件在rule->events中的下标
+ * @param event_ts_us 事件数据时间戳（微秒，0表示事件从未写入）
+ * @param now_us 当前单调时间（微秒），同一次评估可复用
+ * @return 1表示满足时效性，0表示超时或下标越界
+ */
+int topic_rule_check_timeout_index(const topic_rule_t* rule, size_t event_index, uint64_t event_ts_us, uint64_t now_us);
+
+/* 计算EDGE规则使用的数据摘要（FNV-1a，结果不为0）
+ * @param data 数据指针
+ * @param data_len 数据长度
+ * @return 数据摘要
+ */
+uint32_t topic_rule_data_hash(const void* data, size_t data_len);
+
+/* 评估一次已通过时效检查的规则事件，更新规则状态（需持有bus->lock）
+ * @param rule 规则指针（event_ts_us快照已写入本次事件）
+ * @param event_index 触发事件在rule->events中的下标
+ * @param event_ts_us 触发事件的数据时间戳（微秒）
+ * @param now_us 当前单调时间（微秒）
+ * @param data_hash 触发事件的数据摘要（仅EDGE规则使用）
+ * @param dict 对象字典（规则无时效快照时用于AND规则其余事件的时效检查）
+ * @return 1表示规则本次触发，0表示不触发
+ */
+int topic_rule_evaluate(topic_rule_t* rule, size_t event_index, uint64_t event_ts_us, uint64_t now_us,
+                        uint32_t data_hash, void* dict);
+
 #ifdef __cplusplus
 }
 #endif
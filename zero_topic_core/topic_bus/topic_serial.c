@@ -0,0 +1,600 @@
+#include <string.h>
+#include "topic_serial.h"
+#include "../../Rte/inc/os_timestamp.h"
+
+#if TOPIC_BUS_ENABLE_SERIAL
+
+/* COBS流式编码状态 */
+typedef struct {
+    uint8_t* out;
+    size_t pos;                         /* 下一个写入位置 */
+    size_t code_pos;                    /* 当前块码字节的位置 */
+    uint8_t code;                       /* 当前块码值（数据字节数+1） */
+} topic_serial_cobs_t;
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static uint32_t __crc_update(uint32_t crc, const uint8_t* data, size_t len);
+static void __cobs_put(topic_serial_cobs_t* enc, const uint8_t* data, size_t len);
+static size_t __encode(uint8_t* out, uint8_t flags, uint8_t seq, uint16_t topic_id, const void* data, size_t len);
+static int __write(topic_serial_tx_t* tx, const uint8_t* frame, size_t len);
+static void __send_ack(topic_serial_tx_t* tx, uint8_t seq);
+static void __on_ack(topic_serial_tx_t* tx, uint8_t seq);
+static void __rx_frame(topic_serial_rx_t* rx);
+static void __rx_deliver(topic_serial_rx_t* rx, uint16_t topic_id, const uint8_t* data, size_t len);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+#if TOPIC_SERIAL_CRC32
+#define TOPIC_SERIAL_CRC_INIT 0xFFFFFFFFU
+/* CRC32（IEEE 802.3，反射多项式0xEDB88320） */
+static const uint32_t crc_table[256] = {
+    0x00000000U, 0x77073096U, 0xEE0E612CU, 0x990951BAU, 0x076DC419U, 0x706AF48FU,
+    0xE963A535U, 0x9E6495A3U, 0x0EDB8832U, 0x79DCB8A4U, 0xE0D5E91EU, 0x97D2D988U,
+    0x09B64C2BU, 0x7EB17CBDU, 0xE7B82D07U, 0x90BF1D91U, 0x1DB71064U, 0x6AB020F2U,
+    0xF3B97148U, 0x84BE41DEU, 0x1ADAD47DU, 0x6DDDE4EBU, 0xF4D4B551U, 0x83D385C7U,
+    0x136C9856U, 0x646BA8C0U, 0xFD62F97AU, 0x8A65C9ECU, 0x14015C4FU, 0x63066CD9U,
+    0xFA0F3D63U, 0x8D080DF5U, 0x3B6E20C8U, 0x4C69105EU, 0xD56041E4U, 0xA2677172U,
+    0x3C03E4D1U, 0x4B04D447U, 0xD20D85FDU, 0xA50AB56BU, 0x35B5A8FAU, 0x42B2986CU,
+    0xDBBBC9D6U, 0xACBCF940U, 0x32D86CE3U, 0x45DF5C75U, 0xDCD60DCFU, 0xABD13D59U,
+    0x26D930ACU, 0x51DE003AU, 0xC8D75180U, 0xBFD06116U, 0x21B4F4B5U, 0x56B3C423U,
+    0xCFBA9599U, 0xB8BDA50FU, 0x2802B89EU, 0x5F058808U, 0xC60CD9B2U, 0xB10BE924U,
+    0x2F6F7C87U, 0x58684C11U, 0xC1611DABU, 0xB6662D3DU, 0x76DC4190U, 0x01DB7106U,
+    0x98D220BCU, 0xEFD5102AU, 0x71B18589U, 0x06B6B51FU, 0x9FBFE4A5U, 0xE8B8D433U,
+    0x7807C9A2U, 0x0F00F934U, 0x9609A88EU, 0xE10E9818U, 0x7F6A0DBBU, 0x086D3D2DU,
+    0x91646C97U, 0xE6635C01U, 0x6B6B51F4U, 0x1C6C6162U, 0x856530D8U, 0xF262004EU,
+    0x6C0695EDU, 0x1B01A57BU, 0x8208F4C1U, 0xF50FC457U, 0x65B0D9C6U, 0x12B7E950U,
+    0x8BBEB8EAU, 0xFCB9887CU, 0x62DD1DDFU, 0x15DA2D49U, 0x8CD37CF3U, 0xFBD44C65U,
+    0x4DB26158U, 0x3AB551CEU, 0xA3BC0074U, 0xD4BB30E2U, 0x4ADFA541U, 0x3DD895D7U,
+    0xA4D1C46DU, 0xD3D6F4FBU, 0x4369E96AU, 0x346ED9FCU, 0xAD678846U, 0xDA60B8D0U,
+    0x44042D73U, 0x33031DE5U, 0xAA0A4C5FU, 0xDD0D7CC9U, 0x5005713CU, 0x270241AAU,
+    0xBE0B1010U, 0xC90C2086U, 0x5768B525U, 0x206F85B3U, 0xB966D409U, 0xCE61E49FU,
+    0x5EDEF90EU, 0x29D9C998U, 0xB0D09822U, 0xC7D7A8B4U, 0x59B33D17U, 0x2EB40D81U,
+    0xB7BD5C3BU, 0xC0BA6CADU, 0xEDB88320U, 0x9ABFB3B6U, 0x03B6E20CU, 0x74B1D29AU,
+    0xEAD54739U, 0x9DD277AFU, 0x04DB2615U, 0x73DC1683U, 0xE3630B12U, 0x94643B84U,
+    0x0D6D6A3EU, 0x7A6A5AA8U, 0xE40ECF0BU, 0x9309FF9DU, 0x0A00AE27U, 0x7D079EB1U,
+    0xF00F9344U, 0x8708A3D2U, 0x1E01F268U, 0x6906C2FEU, 0xF762575DU, 0x806567CBU,
+    0x196C3671U, 0x6E6B06E7U, 0xFED41B76U, 0x89D32BE0U, 0x10DA7A5AU, 0x67DD4ACCU,
+    0xF9B9DF6FU, 0x8EBEEFF9U, 0x17B7BE43U, 0x60B08ED5U, 0xD6D6A3E8U, 0xA1D1937EU,
+    0x38D8C2C4U, 0x4FDFF252U, 0xD1BB67F1U, 0xA6BC5767U, 0x3FB506DDU, 0x48B2364BU,
+    0xD80D2BDAU, 0xAF0A1B4CU, 0x36034AF6U, 0x41047A60U, 0xDF60EFC3U, 0xA867DF55U,
+    0x316E8EEFU, 0x4669BE79U, 0xCB61B38CU, 0xBC66831AU, 0x256FD2A0U, 0x5268E236U,
+    0xCC0C7795U, 0xBB0B4703U, 0x220216B9U, 0x5505262FU, 0xC5BA3BBEU, 0xB2BD0B28U,
+    0x2BB45A92U, 0x5CB36A04U, 0xC2D7FFA7U, 0xB5D0CF31U, 0x2CD99E8BU, 0x5BDEAE1DU,
+    0x9B64C2B0U, 0xEC63F226U, 0x756AA39CU, 0x026D930AU, 0x9C0906A9U, 0xEB0E363FU,
+    0x72076785U, 0x05005713U, 0x95BF4A82U, 0xE2B87A14U, 0x7BB12BAEU, 0x0CB61B38U,
+    0x92D28E9BU, 0xE5D5BE0DU, 0x7CDCEFB7U, 0x0BDBDF21U, 0x86D3D2D4U, 0xF1D4E242U,
+    0x68DDB3F8U, 0x1FDA836EU, 0x81BE16CDU, 0xF6B9265BU, 0x6FB077E1U, 0x18B74777U,
+    0x88085AE6U, 0xFF0F6A70U, 0x66063BCAU, 0x11010B5CU, 0x8F659EFFU, 0xF862AE69U,
+    0x616BFFD3U, 0x166CCF45U, 0xA00AE278U, 0xD70DD2EEU, 0x4E048354U, 0x3903B3C2U,
+    0xA7672661U, 0xD06016F7U, 0x4969474DU, 0x3E6E77DBU, 0xAED16A4AU, 0xD9D65ADCU,
+    0x40DF0B66U, 0x37D83BF0U, 0xA9BCAE53U, 0xDEBB9EC5U, 0x47B2CF7FU, 0x30B5FFE9U,
+    0xBDBDF21CU, 0xCABAC28AU, 0x53B39330U, 0x24B4A3A6U, 0xBAD03605U, 0xCDD70693U,
+    0x54DE5729U, 0x23D967BFU, 0xB3667A2EU, 0xC4614AB8U, 0x5D681B02U, 0x2A6F2B94U,
+    0xB40BBE37U, 0xC30C8EA1U, 0x5A05DF1BU, 0x2D02EF8DU,
+};
+
+static uint32_t __crc_update(uint32_t crc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        crc = (crc >> 8) ^ crc_table[(crc ^ data[i]) & 0xFFU];
+    }
+    return crc;
+}
+#define TOPIC_SERIAL_CRC_FINAL(crc) ((crc) ^ 0xFFFFFFFFU)
+#else
+#define TOPIC_SERIAL_CRC_INIT 0xFFFFU
+/* CRC16-CCITT（多项式0x1021，初值0xFFFF） */
+static const uint16_t crc_table[256] = {
+    0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+    0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU,
+    0x1231U, 0x0210U, 0x3273U, 0x2252U, 0x52B5U, 0x4294U, 0x72F7U, 0x62D6U,
+    0x9339U, 0x8318U, 0xB37BU, 0xA35AU, 0xD3BDU, 0xC39CU, 0xF3FFU, 0xE3DEU,
+    0x2462U, 0x3443U, 0x0420U, 0x1401U, 0x64E6U, 0x74C7U, 0x44A4U, 0x5485U,
+    0xA56AU, 0xB54BU, 0x8528U, 0x9509U, 0xE5EEU, 0xF5CFU, 0xC5ACU, 0xD58DU,
+    0x3653U, 0x2672U, 0x1611U, 0x0630U, 0x76D7U, 0x66F6U, 0x5695U, 0x46B4U,
+    0xB75BU, 0xA77AU, 0x9719U, 0x8738U, 0xF7DFU, 0xE7FEU, 0xD79DU, 0xC7BCU,
+    0x48C4U, 0x58E5U, 0x6886U, 0x78A7U, 0x0840U, 0x1861U, 0x2802U, 0x3823U,
+    0xC9CCU, 0xD9EDU, 0xE98EU, 0xF9AFU, 0x8948U, 0x9969U, 0xA90AU, 0xB92BU,
+    0x5AF5U, 0x4AD4U, 0x7AB7U, 0x6A96U, 0x1A71U, 0x0A50U, 0x3A33U, 0x2A12U,
+    0xDBFDU, 0xCBDCU, 0xFBBFU, 0xEB9EU, 0x9B79U, 0x8B58U, 0xBB3BU, 0xAB1AU,
+    0x6CA6U, 0x7C87U, 0x4CE4U, 0x5CC5U, 0x2C22U, 0x3C03U, 0x0C60U, 0x1C41U,
+    0xEDAEU, 0xFD8FU, 0xCDECU, 0xDDCDU, 0xAD2AU, 0xBD0BU, 0x8D68U, 0x9D49U,
+    0x7E97U, 0x6EB6U, 0x5ED5U, 0x4EF4U, 0x3E13U, 0x2E32U, 0x1E51U, 0x0E70U,
+    0xFF9FU, 0xEFBEU, 0xDFDDU, 0xCFFCU, 0xBF1BU, 0xAF3AU, 0x9F59U, 0x8F78U,
+    0x9188U, 0x81A9U, 0xB1CAU, 0xA1EBU, 0xD10CU, 0xC12DU, 0xF14EU, 0xE16FU,
+    0x1080U, 0x00A1U, 0x30C2U, 0x20E3U, 0x5004U, 0x4025U, 0x7046U, 0x6067U,
+    0x83B9U, 0x9398U, 0xA3FBU, 0xB3DAU, 0xC33DU, 0xD31CU, 0xE37FU, 0xF35EU,
+    0x02B1U, 0x1290U, 0x22F3U, 0x32D2U, 0x4235U, 0x5214U, 0x6277U, 0x7256U,
+    0xB5EAU, 0xA5CBU, 0x95A8U, 0x8589U, 0xF56EU, 0xE54FU, 0xD52CU, 0xC50DU,
+    0x34E2U, 0x24C3U, 0x14A0U, 0x0481U, 0x7466U, 0x6447U, 0x5424U, 0x4405U,
+    0xA7DBU, 0xB7FAU, 0x8799U, 0x97B8U, 0xE75FU, 0xF77EU, 0xC71DU, 0xD73CU,
+    0x26D3U, 0x36F2U, 0x0691U, 0x16B0U, 0x6657U, 0x7676U, 0x4615U, 0x5634U,
+    0xD94CU, 0xC96DU, 0xF90EU, 0xE92FU, 0x99C8U, 0x89E9U, 0xB98AU, 0xA9ABU,
+    0x5844U, 0x4865U, 0x7806U, 0x6827U, 0x18C0U, 0x08E1U, 0x3882U, 0x28A3U,
+    0xCB7DU, 0xDB5CU, 0xEB3FU, 0xFB1EU, 0x8BF9U, 0x9BD8U, 0xABBBU, 0xBB9AU,
+    0x4A75U, 0x5A54U, 0x6A37U, 0x7A16U, 0x0AF1U, 0x1AD0U, 0x2AB3U, 0x3A92U,
+    0xFD2EU, 0xED0FU, 0xDD6CU, 0xCD4DU, 0xBDAAU, 0xAD8BU, 0x9DE8U, 0x8DC9U,
+    0x7C26U, 0x6C07U, 0x5C64U, 0x4C45U, 0x3CA2U, 0x2C83U, 0x1CE0U, 0x0CC1U,
+    0xEF1FU, 0xFF3EU, 0xCF5DU, 0xDF7CU, 0xAF9BU, 0xBFBAU, 0x8FD9U, 0x9FF8U,
+    0x6E17U, 0x7E36U, 0x4E55U, 0x5E74U, 0x2E93U, 0x3EB2U, 0x0ED1U, 0x1EF0U,
+};
+
+static uint32_t __crc_update(uint32_t crc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        crc = ((crc << 8) ^ crc_table[((crc >> 8) ^ data[i]) & 0xFFU]) & 0xFFFFU;
+    }
+    return crc;
+}
+#define TOPIC_SERIAL_CRC_FINAL(crc) (crc)
+#endif
+
+/*
+ * @brief COBS编码一段字节（可分多段调用）
+ * @param enc 编码状态
+ * @param data 字节
+ * @param len 长度
+ */
+static void __cobs_put(topic_serial_cobs_t* enc, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; ++i) {
+        uint8_t b = data[i];
+        if (b != 0) {
+            enc->out[enc->pos++] = b;
+            enc->code++;
+        }
+        if (b == 0 || enc->code == 0xFFU) {
+            /* 块结束：回填码字节，开始下一块 */
+            enc->out[enc->code_pos] = enc->code;
+            enc->code_pos = enc->pos++;
+            enc->code = 1;
+        }
+    }
+}
+
+/*
+ * @brief 编码一个完整帧（帧体 + CRC，COBS编码并以0x00结尾）
+ * @param out 输出缓冲（不小于TOPIC_SERIAL_ENCODED_MAX）
+ * @param flags 帧类型与标志
+ * @param seq 序号
+ * @param topic_id Topic ID
+ * @param data 负载
+ * @param len 负载长度
+ * @return 编码后长度
+ */
+static size_t __encode(uint8_t* out, uint8_t flags, uint8_t seq, uint16_t topic_id, const void* data, size_t len) {
+    uint8_t hdr[TOPIC_SERIAL_HDR_SIZE] = { flags, seq, (uint8_t)(topic_id & 0xFFU), (uint8_t)(topic_id >> 8) };
+    uint32_t crc = __crc_update(TOPIC_SERIAL_CRC_INIT, hdr, sizeof(hdr));
+    crc = TOPIC_SERIAL_CRC_FINAL(__crc_update(crc, (const uint8_t*)data, len));
+    uint8_t tail[TOPIC_SERIAL_CRC_SIZE];
+    for (size_t i = 0; i < TOPIC_SERIAL_CRC_SIZE; ++i) {
+        tail[i] = (uint8_t)(crc >> (8U * i));
+    }
+
+    topic_serial_cobs_t enc = { .out = out, .pos = 1, .code_pos = 0, .code = 1 };
+    __cobs_put(&enc, hdr, sizeof(hdr));
+    __cobs_put(&enc, (const uint8_t*)data, len);
+    __cobs_put(&enc, tail, sizeof(tail));
+    out[enc.code_pos] = enc.code;
+    out[enc.pos++] = 0;
+    return enc.pos;
+}
+
+/*
+ * @brief 写出一帧并统计（调用者持有发送端锁）
+ * @return 0成功，-1失败
+ */
+static int __write(topic_serial_tx_t* tx, const uint8_t* frame, size_t len) {
+    if (tx->write(frame, len, tx->user_data) != 0) return -1;
+    tx->stats.bytes += len;
+    return 0;
+}
+
+/*
+ * @brief 发送ACK帧
+ * @param tx 发送端
+ * @param seq 确认的序号
+ */
+static void __send_ack(topic_serial_tx_t* tx, uint8_t seq) {
+    if (os_semaphore_take(tx->lock, 100) < 0) return;
+    size_t n = __encode(tx->frame, TOPIC_SERIAL_TYPE_ACK, seq, 0, NULL, 0);
+    if (__write(tx, tx->frame, n) == 0) {
+        tx->stats.acks_sent++;
+    }
+    os_semaphore_give(tx->lock);
+}
+
+/*
+ * @brief 收到ACK：释放窗口中对应的帧
+ * @param tx 发送端
+ * @param seq 确认的序号
+ */
+static void __on_ack(topic_serial_tx_t* tx, uint8_t seq) {
+#if TOPIC_SERIAL_ACK_WINDOW > 0
+    if (os_semaphore_take(tx->lock, 100) < 0) return;
+    for (size_t i = 0; i < TOPIC_SERIAL_ACK_WINDOW; ++i) {
+        topic_serial_pending_t* p = &tx->pending[i];
+        if (p->used && p->seq == seq) {
+            p->used = 0;
+            tx->stats.acked++;
+            break;
+        }
+    }
+    os_semaphore_give(tx->lock);
+#else
+    (void)tx;
+    (void)seq;
+#endif
+}
+
+/*
+ * @brief 初始化发送端
+ * @param tx 发送端
+ * @param write 写函数
+ * @param user_data 写函数的用户数据
+ * @param ack 非0表示请求确认
+ * @return 0成功，-1失败
+ */
+int topic_serial_tx_init(topic_serial_tx_t* tx, topic_serial_write_t write, void* user_data, int ack) {
+    if (!tx || !write) return -1;
+#if TOPIC_SERIAL_ACK_WINDOW == 0
+    if (ack) return -1;
+#endif
+    memset(tx, 0, sizeof(*tx));
+    tx->write = write;
+    tx->user_data = user_data;
+    tx->ack = ack;
+    tx->lock = os_semaphore_create(1, NULL);
+    return tx->lock ? 0 : -1;
+}
+
+/*
+ * @brief 释放发送端
+ * @param tx 发送端
+ * @return 0成功，-1失败
+ */
+int topic_serial_tx_deinit(topic_serial_tx_t* tx) {
+    if (!tx) return -1;
+    if (tx->lock) {
+        os_semaphore_destroy(tx->lock);
+        tx->lock = NULL;
+    }
+    return 0;
+}
+
+/*
+ * @brief 编码并发送一个DATA帧
+ * @param tx 发送端
+ * @param topic_id Topic ID
+ * @param data 负载
+ * @param len 负载长度
+ * @return 0成功，-1失败
+ */
+int topic_serial_send(topic_serial_tx_t* tx, uint16_t topic_id, const void* data, size_t len) {
+    if (!tx || !tx->lock || (!data && len > 0)) return -1;
+    if (os_semaphore_take(tx->lock, 100) < 0) return -1;
+    if (len > TOPIC_SERIAL_MAX_PAYLOAD) {
+        tx->stats.dropped++;
+        os_semaphore_give(tx->lock);
+        return -1;
+    }
+
+    int ret = -1;
+#if TOPIC_SERIAL_ACK_WINDOW > 0
+    if (tx->ack) {
+        /* 编码到空闲窗口槽位，确认前保留用于重传 */
+        topic_serial_pending_t* slot = NULL;
+        for (size_t i = 0; i < TOPIC_SERIAL_ACK_WINDOW && !slot; ++i) {
+            if (!tx->pending[i].used) slot = &tx->pending[i];
+        }
+        if (slot) {
+            slot->seq = tx->seq;
+            slot->len = (uint16_t)__encode(slot->frame, TOPIC_SERIAL_TYPE_DATA | TOPIC_SERIAL_FLAG_ACK_REQ,
+                                           slot->seq, topic_id, data, len);
+            slot->retries = 0;
+            slot->sent_ms = os_monotonic_time_get_millisecond();
+            slot->used = 1;
+            tx->seq++;
+            /* 写失败时留在窗口中等待重传 */
+            (void)__write(tx, slot->frame, slot->len);
+            tx->stats.frames++;
+            ret = 0;
+        }
+    } else
+#endif
+    {
+        size_t n = __encode(tx->frame, TOPIC_SERIAL_TYPE_DATA, tx->seq++, topic_id, data, len);
+        if (__write(tx, tx->frame, n) == 0) {
+            tx->stats.frames++;
+            ret = 0;
+        }
+    }
+    if (ret != 0) tx->stats.dropped++;
+    os_semaphore_give(tx->lock);
+    return ret;
+}
+
+/*
+ * @brief Router回调
+ * @param topic_id Topic ID
+ * @param data 负载
+ * @param data_len 负载长度
+ * @param user_data 发送端
+ * @return 0成功，-1失败
+ */
+int topic_serial_route(uint16_t topic_id, const void* data, size_t data_len, void* user_data) {
+    return topic_serial_send((topic_serial_tx_t*)user_data, topic_id, data, data_len);
+}
+
+/*
+ * @brief 重传超时未确认的帧
+ * @param tx 发送端
+ * @return 本次重传的帧数
+ */
+size_t topic_serial_tx_poll(topic_serial_tx_t* tx) {
+    size_t count = 0;
+#if TOPIC_SERIAL_ACK_WINDOW > 0
+    if (!tx || !tx->lock || !tx->ack) return 0;
+    if (os_semaphore_take(tx->lock, 100) < 0) return 0;
+    uint64_t now = os_monotonic_time_get_millisecond();
+    for (size_t i = 0; i < TOPIC_SERIAL_ACK_WINDOW; ++i) {
+        topic_serial_pending_t* p = &tx->pending[i];
+        if (!p->used || now - p->sent_ms < TOPIC_SERIAL_ACK_TIMEOUT_MS) continue;
+        if (p->retries >= TOPIC_SERIAL_ACK_RETRIES) {
+            p->used = 0;
+            tx->stats.failed++;
+            continue;
+        }
+        p->retries++;
+        p->sent_ms = now;
+        (void)__write(tx, p->frame, p->len);
+        tx->stats.retransmits++;
+        count++;
+    }
+    os_semaphore_give(tx->lock);
+#else
+    (void)tx;
+#endif
+    return count;
+}
+
+/*
+ * @brief 获取等待确认的帧数
+ * @param tx 发送端
+ * @return 帧数
+ */
+size_t topic_serial_tx_pending(topic_serial_tx_t* tx) {
+    size_t count = 0;
+#if TOPIC_SERIAL_ACK_WINDOW > 0
+    if (!tx || !tx->lock) return 0;
+    if (os_semaphore_take(tx->lock, 100) < 0) return 0;
+    for (size_t i = 0; i < TOPIC_SERIAL_ACK_WINDOW; ++i) {
+        count += tx->pending[i].used ? 1U : 0U;
+    }
+    os_semaphore_give(tx->lock);
+#else
+    (void)tx;
+#endif
+    return count;
+}
+
+/*
+ * @brief 获取发送端统计
+ * @param tx 发送端
+ * @param stats 输出统计
+ */
+void topic_serial_tx_get_stats(topic_serial_tx_t* tx, topic_serial_tx_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!tx || !tx->lock) return;
+    if (os_semaphore_take(tx->lock, 100) < 0) return;
+    *stats = tx->stats;
+    os_semaphore_give(tx->lock);
+}
+
+/*
+ * @brief 把一帧负载注入本地总线
+ * @param rx 接收端
+ * @param topic_id 帧中的Topic ID
+ * @param data 负载
+ * @param len 负载长度
+ */
+static void __rx_deliver(topic_serial_rx_t* rx, uint16_t topic_id, const uint8_t* data, size_t len) {
+    obj_dict_key_t key = (obj_dict_key_t)topic_id;
+    if (rx->map) {
+        size_t i = 0;
+        while (i < rx->map_count && rx->map[i].topic_id != topic_id) {
+            ++i;
+        }
+        if (i == rx->map_count) {
+            rx->stats.unmapped++;
+            return;
+        }
+        key = rx->map[i].event_key;
+    }
+    if (obj_dict_set(rx->bus->obj_dict, key, data, len, 0) != 0) {
+        rx->stats.inject_errors++;
+        return;
+    }
+#if TOPIC_BUS_ENABLE_ISR
+    /* 只入队，由Topic Server排空时分发，接收上下文不执行订阅回调 */
+    if (topic_publish_isr(rx->bus, key) != 0) {
+        rx->stats.inject_errors++;
+        return;
+    }
+#else
+    topic_publish_event(rx->bus, key);
+#endif
+    rx->stats.frames++;
+}
+
+/*
+ * @brief 处理一个已解码的帧（收到0x00分隔符时调用）
+ * @param rx 接收端
+ */
+static void __rx_frame(topic_serial_rx_t* rx) {
+    size_t len = rx->len;
+    if (rx->error) {
+        rx->stats.overflows++;
+        return;
+    }
+    if (rx->remaining != 0 || len < TOPIC_SERIAL_HDR_SIZE + TOPIC_SERIAL_CRC_SIZE) {
+        rx->stats.malformed++;  /* 块未结束即遇到分隔符，或帧过短 */
+        return;
+    }
+
+    const uint8_t* buf = rx->buf;
+    size_t body = len - TOPIC_SERIAL_CRC_SIZE;
+    uint32_t crc = 0;
+    for (size_t i = 0; i < TOPIC_SERIAL_CRC_SIZE; ++i) {
+        crc |= (uint32_t)buf[body + i] << (8U * i);
+    }
+    if (TOPIC_SERIAL_CRC_FINAL(__crc_update(TOPIC_SERIAL_CRC_INIT, buf, body)) != crc) {
+        rx->stats.crc_errors++;
+        return;
+    }
+
+    uint8_t flags = buf[0];
+    uint8_t seq = buf[1];
+    uint16_t topic_id = (uint16_t)(buf[2] | ((uint16_t)buf[3] << 8));
+    uint8_t type = flags & TOPIC_SERIAL_TYPE_MASK;
+    if (type == TOPIC_SERIAL_TYPE_ACK) {
+        rx->stats.acks++;
+        if (rx->tx) __on_ack(rx->tx, seq);
+        return;
+    }
+    if (type != TOPIC_SERIAL_TYPE_DATA) {
+        rx->stats.malformed++;
+        return;
+    }
+
+    if (flags & TOPIC_SERIAL_FLAG_ACK_REQ) {
+        /* 先回ACK（对端可能未收到上一次的ACK），再按序号位图去重 */
+        if (rx->tx) __send_ack(rx->tx, seq);
+        uint8_t ahead = (uint8_t)(seq - rx->ack_high);
+        if (!rx->ack_valid) {
+            rx->ack_high = seq;
+            rx->ack_valid = 1;
+        } else if (ahead != 0 && ahead < 128U) {
+            /* 最大序号前移：跳过的每个序号都使其半个序号空间之前的位过期（丢帧时不留下陈旧位） */
+            for (uint8_t i = 1; i <= ahead; ++i) {
+                uint8_t old = (uint8_t)(rx->ack_high + i + 128U);
+                rx->seen[old >> 5] &= ~(1U << (old & 31U));
+            }
+            rx->ack_high = seq;
+        }
+        uint32_t bit = 1U << (seq & 31U);
+        if (rx->seen[seq >> 5] & bit) {
+            rx->stats.duplicates++;
+            return;
+        }
+        rx->seen[seq >> 5] |= bit;
+    } else {
+        if (rx->seq_valid) {
+            uint8_t gap = (uint8_t)(seq - rx->expected_seq);
+            if (gap < 128U) rx->stats.lost += gap;
+        }
+        rx->expected_seq = (uint8_t)(seq + 1U);
+        rx->seq_valid = 1;
+    }
+    __rx_deliver(rx, topic_id, buf + TOPIC_SERIAL_HDR_SIZE, body - TOPIC_SERIAL_HDR_SIZE);
+}
+
+/*
+ * @brief 初始化接收端
+ * @param rx 接收端
+ * @param bus 注入的本地总线
+ * @param map Topic映射
+ * @param map_count 映射条数
+ * @param tx 反方向的发送端
+ * @return 0成功，-1失败
+ */
+int topic_serial_rx_init(topic_serial_rx_t* rx, topic_bus_t* bus, const topic_serial_map_t* map, size_t map_count,
+                         topic_serial_tx_t* tx) {
+    if (!rx || !bus || !bus->obj_dict || (!map && map_count > 0)) return -1;
+    memset(rx, 0, sizeof(*rx));
+    rx->bus = bus;
+    rx->map = map;
+    rx->map_count = map_count;
+    rx->tx = tx;
+    return 0;
+}
+
+/*
+ * @brief 喂入收到的一段字节
+ * @param rx 接收端
+ * @param data 字节
+ * @param len 长度
+ * @return 本次完成的帧数
+ */
+size_t topic_serial_rx_feed(topic_serial_rx_t* rx, const uint8_t* data, size_t len) {
+    if (!rx || !data) return 0;
+    rx->stats.bytes += len;
+
+    size_t frames = 0;
+    const uint8_t* p = data;
+    const uint8_t* end = data + len;
+    while (p < end) {
+        if (rx->remaining > 0 && *p != 0) {
+            /* 块内数据字节非0：整段拷贝；块内出现0说明块被截断，交给下面的分隔符处理 */
+            size_t n = (size_t)(end - p);
+            if (n > rx->remaining) n = rx->remaining;
+            const uint8_t* zero = (const uint8_t*)memchr(p, 0, n);
+            if (zero) n = (size_t)(zero - p);
+            if (rx->len + n > sizeof(rx->buf)) {
+                rx->error = 1;
+            } else {
+                memcpy(rx->buf + rx->len, p, n);
+                rx->len += n;
+            }
+            p += n;
+            rx->remaining = (uint8_t)(rx->remaining - n);
+            if (rx->remaining == 0) rx->pending_zero = (rx->code != 0xFFU);
+            continue;
+        }
+
+        uint8_t b = *p++;
+        if (b == 0) {
+            /* 分隔符：连续的0（空帧）用于链路空闲与同步，直接忽略 */
+            if (rx->len > 0 || rx->error || rx->code != 0) {
+                __rx_frame(rx);
+                frames++;
+            }
+            rx->len = 0;
+            rx->code = 0;
+            rx->remaining = 0;
+            rx->pending_zero = 0;
+            rx->error = 0;
+            continue;
+        }
+
+        /* 码字节：上一块若不是满块，其后是一个被编码掉的0 */
+        if (rx->pending_zero) {
+            if (rx->len < sizeof(rx->buf)) {
+                rx->buf[rx->len++] = 0;
+            } else {
+                rx->error = 1;
+            }
+        }
+        rx->code = b;
+        rx->remaining = (uint8_t)(b - 1U);
+        rx->pending_zero = (rx->remaining == 0) && (b != 0xFFU);
+    }
+    return frames;
+}
+
+/*
+ * @brief 获取接收端统计
+ * @param rx 接收端
+ * @param stats 输出统计
+ */
+void topic_serial_rx_get_stats(topic_serial_rx_t* rx, topic_serial_rx_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!rx) return;
+    *stats = rx->stats;
+}
+
+#endif /* TOPIC_BUS_ENABLE_SERIAL */
@@ -0,0 +1,225 @@
+#ifndef TOPIC_SERIAL_H_
+#define TOPIC_SERIAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "topic_bus_config.h"
+#include "topic_bus.h"
+#include "../../Rte/inc/os_semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_SERIAL
+
+/*
+ * 串口帧传输：在UART/SPI等字节流链路上转发Topic
+ *   帧体为 flags(1) + seq(1) + topic_id(2) + 负载 + CRC(2或4)，多字节字段小端；
+ *   帧体经COBS编码后以0x00结尾，链路上任意位置丢字节或插入噪声，接收端都在下一个0x00处重新同步
+ *
+ *   发送端可作为自定义Router（topic_serial_route）挂到Topic上，编码结果通过用户提供的写函数输出
+ *   接收端逐块喂入收到的字节（如每次DMA半满/全满），不要求块与帧对齐；完整帧校验通过后
+ *   写入对象字典并以topic_publish_isr入队（未启用ISR路径时为topic_publish_event）
+ *
+ *   确认模式下DATA帧带ACK请求位，接收端回ACK帧；未确认帧保存在发送端窗口中，
+ *   由topic_serial_tx_poll超时重传，接收端按序号丢弃重传造成的重复帧
+ *   编码、解码与重传均使用结构体内的固定缓冲，不使用堆
+ */
+
+#define TOPIC_SERIAL_HDR_SIZE     4U
+#if TOPIC_SERIAL_CRC32
+#define TOPIC_SERIAL_CRC_SIZE     4U
+#else
+#define TOPIC_SERIAL_CRC_SIZE     2U
+#endif
+/* 帧体最大长度（COBS编码前） */
+#define TOPIC_SERIAL_FRAME_MAX    (TOPIC_SERIAL_HDR_SIZE + TOPIC_SERIAL_MAX_PAYLOAD + TOPIC_SERIAL_CRC_SIZE)
+/* 编码后最大长度（COBS每254字节增加1字节，另加首个码字节与结尾0x00） */
+#define TOPIC_SERIAL_ENCODED_MAX  (TOPIC_SERIAL_FRAME_MAX + TOPIC_SERIAL_FRAME_MAX / 254U + 2U)
+
+/* 帧类型（flags低4位） */
+#define TOPIC_SERIAL_TYPE_DATA    0x01U
+#define TOPIC_SERIAL_TYPE_ACK     0x02U
+#define TOPIC_SERIAL_TYPE_MASK    0x0FU
+/* DATA帧请求确认 */
+#define TOPIC_SERIAL_FLAG_ACK_REQ 0x80U
+
+/*
+ * 写函数类型：把一段已编码的字节写到链路，返回0表示成功
+ * 在发送端锁内调用，同一发送端的帧不会交错
+ */
+typedef int (*topic_serial_write_t)(const uint8_t* data, size_t len, void* user_data);
+
+/* 接收端Topic映射 */
+typedef struct {
+    uint16_t topic_id;                  /* 帧中的Topic ID */
+    obj_dict_key_t event_key;           /* 注入本地总线使用的事件键 */
+} topic_serial_map_t;
+
+/* 发送端统计 */
+typedef struct {
+    uint32_t frames;                    /* 发出的DATA帧数（不含重传） */
+    uint32_t acks_sent;                 /* 发出的ACK帧数 */
+    uint64_t bytes;                     /* 写出的字节数（含重传与ACK） */
+    uint32_t dropped;                   /* 负载过长、窗口已满或写失败而未发出的帧数 */
+    uint32_t retransmits;               /* 重传次数 */
+    uint32_t acked;                     /* 收到确认的帧数 */
+    uint32_t failed;                    /* 重传次数用尽仍未确认的帧数 */
+} topic_serial_tx_stats_t;
+
+/* 接收端统计 */
+typedef struct {
+    uint64_t bytes;                     /* 喂入的字节数 */
+    uint32_t frames;                    /* 校验通过并注入的DATA帧数 */
+    uint32_t acks;                      /* 收到的ACK帧数 */
+    uint32_t crc_errors;                /* CRC错误的帧数 */
+    uint32_t malformed;                 /* COBS错误或长度不足的帧数 */
+    uint32_t overflows;                 /* 超过TOPIC_SERIAL_FRAME_MAX的帧数 */
+    uint32_t lost;                      /* 按序号推算丢失的帧数（不含确认模式的帧） */
+    uint32_t duplicates;                /* 重传造成的重复帧数 */
+    uint32_t unmapped;                  /* 没有映射的帧数 */
+    uint32_t inject_errors;             /* 写入对象字典或入队失败的帧数 */
+} topic_serial_rx_stats_t;
+
+#if TOPIC_SERIAL_ACK_WINDOW > 0
+/* 等待确认的帧 */
+typedef struct {
+    uint8_t used;
+    uint8_t seq;
+    uint8_t retries;                    /* 已重传次数 */
+    uint16_t len;                       /* 编码后长度 */
+    uint64_t sent_ms;                   /* 最近一次发送时间 */
+    uint8_t frame[TOPIC_SERIAL_ENCODED_MAX];
+} topic_serial_pending_t;
+#endif
+
+/* 发送端 */
+typedef struct {
+    topic_serial_write_t write;         /* 写函数 */
+    void* user_data;                    /* 写函数的用户数据 */
+    int ack;                            /* 非0表示DATA帧请求确认 */
+    uint8_t seq;                        /* 下一个DATA帧序号 */
+    OsSemaphore_t* lock;                /* 编码与写出互斥（多个发布线程与接收端回ACK共用） */
+    topic_serial_tx_stats_t stats;
+#if TOPIC_SERIAL_ACK_WINDOW > 0
+    topic_serial_pending_t pending[TOPIC_SERIAL_ACK_WINDOW];
+#endif
+    uint8_t frame[TOPIC_SERIAL_ENCODED_MAX];  /* 非确认帧的编码缓冲 */
+} topic_serial_tx_t;
+
+/* 接收端 */
+typedef struct {
+    topic_bus_t* bus;                   /* 注入的本地总线 */
+    const topic_serial_map_t* map;      /* Topic映射（NULL表示event_key = topic_id） */
+    size_t map_count;
+    topic_serial_tx_t* tx;              /* 同一链路反方向的发送端（回ACK与处理收到的ACK，可为NULL） */
+    uint8_t code;                       /* COBS当前块的码字节 */
+    uint8_t remaining;                  /* 当前块剩余的数据字节数 */
+    uint8_t pending_zero;               /* 当前块结束后下一块开始前需补0 */
+    uint8_t error;                      /* 当前帧已溢出 */
+    size_t len;                         /* 当前帧已解码长度 */
+    uint8_t expected_seq;               /* 期望的下一个非确认帧序号 */
+    uint8_t seq_valid;
+    uint8_t ack_high;                   /* 收到的最大确认帧序号（位图窗口为其之前的128个序号） */
+    uint8_t ack_valid;
+    uint32_t seen[8];                   /* 最近收到的确认帧序号位图（去重） */
+    topic_serial_rx_stats_t stats;
+    uint8_t buf[TOPIC_SERIAL_FRAME_MAX];  /* 解码缓冲 */
+} topic_serial_rx_t;
+
+/*
+ * @brief 初始化发送端
+ * @param tx 发送端
+ * @param write 写函数
+ * @param user_data 写函数的用户数据
+ * @param ack 非0表示DATA帧请求确认（需TOPIC_SERIAL_ACK_WINDOW > 0，且对端接收端关联了发送端）
+ * @return 0成功，-1失败
+ */
+int topic_serial_tx_init(topic_serial_tx_t* tx, topic_serial_write_t write, void* user_data, int ack);
+
+/*
+ * @brief 释放发送端
+ * @param tx 发送端
+ * @return 0成功，-1失败
+ */
+int topic_serial_tx_deinit(topic_serial_tx_t* tx);
+
+/*
+ * @brief 编码并发送一个DATA帧
+ * @param tx 发送端
+ * @param topic_id Topic ID
+ * @param data 负载
+ * @param len 负载长度（不超过TOPIC_SERIAL_MAX_PAYLOAD）
+ * @return 0成功，-1失败（确认模式下窗口已满也返回-1）
+ */
+int topic_serial_send(topic_serial_tx_t* tx, uint16_t topic_id, const void* data, size_t len);
+
+/*
+ * @brief Router回调：topic_router_add_custom(&router, topic_id, topic_serial_route, &tx)
+ * @param topic_id Topic ID
+ * @param data 负载
+ * @param data_len 负载长度
+ * @param user_data 发送端
+ * @return 0成功，-1失败
+ */
+int topic_serial_route(uint16_t topic_id, const void* data, size_t data_len, void* user_data);
+
+/*
+ * @brief 重传超时未确认的帧，重传次数用尽的帧计入failed并释放窗口
+ * @param tx 发送端
+ * @return 本次重传的帧数
+ */
+size_t topic_serial_tx_poll(topic_serial_tx_t* tx);
+
+/*
+ * @brief 获取等待确认的帧数
+ * @param tx 发送端
+ * @return 帧数
+ */
+size_t topic_serial_tx_pending(topic_serial_tx_t* tx);
+
+/*
+ * @brief 获取发送端统计
+ * @param tx 发送端
+ * @param stats 输出统计
+ */
+void topic_serial_tx_get_stats(topic_serial_tx_t* tx, topic_serial_tx_stats_t* stats);
+
+/*
+ * @brief 初始化接收端
+ * @param rx 接收端
+ * @param bus 注入的本地总线（需已关联对象字典）
+ * @param map Topic映射（NULL表示event_key = topic_id）
+ * @param map_count 映射条数
+ * @param tx 同一链路反方向的发送端（可为NULL）
+ * @return 0成功，-1失败
+ */
+int topic_serial_rx_init(topic_serial_rx_t* rx, topic_bus_t* bus, const topic_serial_map_t* map, size_t map_count,
+                         topic_serial_tx_t* tx);
+
+/*
+ * @brief 喂入收到的一段字节（任意长度，不要求与帧对齐）
+ * @details 同一接收端只能由一个上下文调用；写入对象字典需在任务上下文中进行，
+ *          DMA中断中应只通知接收任务，由任务调用本函数
+ * @param rx 接收端
+ * @param data 字节
+ * @param len 长度
+ * @return 本次完成的帧数（含校验失败的帧）
+ */
+size_t topic_serial_rx_feed(topic_serial_rx_t* rx, const uint8_t* data, size_t len);
+
+/*
+ * @brief 获取接收端统计
+ * @param rx 接收端
+ * @param stats 输出统计
+ */
+void topic_serial_rx_get_stats(topic_serial_rx_t* rx, topic_serial_rx_stats_t* stats);
+
+#endif /* TOPIC_BUS_ENABLE_SERIAL */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_SERIAL_H_ */
@@ -3,18 +3,43 @@
 #include "../../Rte/inc/os_timestamp.h"
 #include "../../Rte/inc/os_thread.h"
 #include "../../Rte/inc/os_printf.h"
+#include "topic_trace.h"
 
 #if TOPIC_BUS_ENABLE_ISR
 #include "topic_bus.h"
 #include "../ring_buffer/ring_buffer.h"
 #endif
 
+/*
+ * @brief 阻塞等待ISR事件，唤醒后按最大成批延迟等待更多事件
+ * @param server Topic Server指针
+ */
+static void __server_wait_events(topic_server_t* server) {
+#if TOPIC_BUS_ENABLE_ISR
+    /* 空闲时最多等待一个周期，便于响应停止请求 */
+    if (topic_bus_wait_isr(server->bus, server->period_ms) <= 0 || !server->running) return;
+
+    if (server->max_batch_delay_ms > 0) {
+        uint64_t deadline_us = os_monotonic_time_get_microsecond() + (uint64_t)server->max_batch_delay_ms * 1000U;
+        while (server->running &&
+               ring_buffer_mpmc_get_count(server->bus->isr_queue) < TOPIC_BUS_ISR_DRAIN_BATCH &&
+               os_monotonic_time_get_microsecond() < deadline_us) {
+            os_thread_sleep_ms(1);
+        }
+    }
+#else
+    os_thread_sleep_ms(server->period_ms);
+#endif
+}
+
 /* Topic Server任务函数 */
 static void* topic_server_task(void* arg) {
     topic_server_t* server = (topic_server_t*)arg;
     if (!server) return NULL;
+#if TOPIC_BUS_ENABLE_TRACE
+    topic_trace_thread_name("topic_server");
+#endif
 
-    server->running = 1;
     while (server->running) {
         uint64_t start_us = os_monotonic_time_get_microsecond();
         int processed = topic_server_run_once(server);
@@ -25,12 +50,28 @@ static void* topic_server_task(void* arg) {
             server->total_processed += processed;
             server->total_time_us += (end_us - start_us);
         }
+#else
+        (void)start_us;
+        (void)end_us;
 #endif
 
-        /* 等待下一个周期 */
-        os_thread_sleep_ms(server->period_ms);
+        if (server->event_driven) {
+            /* 本轮有事件时立即复查队列，否则阻塞等待生产者唤醒 */
+            if (processed == 0) {
+                __server_wait_events(server);
+            }
+        } else {
+            /* 等待下一个周期 */
+            os_thread_sleep_ms(server->period_ms);
+        }
+#if TOPIC_BUS_ENABLE_STATS
+        server->drain.wakeups++;
+#endif
     }
 
+#if TOPIC_BUS_ENABLE_TRACE
+    topic_trace_thread_exit();
+#endif
     return NULL;
 }
 
@@ -48,10 +89,42 @@ int topic_server_init(topic_server_t* server, topic_bus_t* bus, uint32_t period_
     server->bus = bus;
     server->period_ms = period_ms;
     server->running = 0;
+    server->drain_mode = (topic_server_drain_mode_t)TOPIC_BUS_SERVER_DRAIN_MODE;
+    server->event_driven = TOPIC_BUS_SERVER_EVENT_DRIVEN;
+    server->max_batch_delay_ms = TOPIC_BUS_SERVER_MAX_BATCH_DELAY_MS;
     
     return 0;
 }
 
+/*
+ * @brief 设置ISR队列排空模式
+ * @param server Topic Server指针
+ * @param mode 排空模式
+ * @return 0成功，-1失败
+ */
+int topic_server_set_drain_mode(topic_server_t* server, topic_server_drain_mode_t mode) {
+    if (!server || mode > TOPIC_SERVER_DRAIN_COALESCE) return -1;
+    server->drain_mode = mode;
+    return 0;
+}
+
+/*
+ * @brief 设置Server唤醒方式
+ * @param server Topic Server指针
+ * @param event_driven 非0表示由ISR事件唤醒，0表示按period_ms轮询
+ * @param max_batch_delay_ms 唤醒后等待更多事件成批的最长时间（毫秒）
+ * @return 0成功，-1失败
+ */
+int topic_server_set_wakeup(topic_server_t* server, int event_driven, uint32_t max_batch_delay_ms) {
+    if (!server) return -1;
+#if !TOPIC_BUS_ENABLE_ISR
+    if (event_driven) return -1;  /* 无ISR队列时只能轮询 */
+#endif
+    server->event_driven = event_driven;
+    server->max_batch_delay_ms = max_batch_delay_ms;
+    return 0;
+}
+
 /*
  * @brief 运行Topic Server一次（周期性调用）
  * @param server Topic Server指针
@@ -65,19 +138,54 @@ int topic_server_run_once(topic_server_t* server) {
 #if TOPIC_BUS_ENABLE_ISR
     /* 处理ISR队列中的事件 */
     if (server->bus->isr_queue) {
-        /* 统计处理的事件数量 */
-        topic_bus_isr_event_t evt;
-        while (ring_buffer_read(server->bus->isr_queue, &evt) == 0) {
-            /* 在任务上下文中处理事件 */
-            (void)topic_publish_event(server->bus, evt.event_key);
-            processed++;
+        size_t dispatched = 0;
+        if (server->drain_mode == TOPIC_SERVER_DRAIN_SINGLE) {
+            /* 逐条出队，每个事件单独加锁发布 */
+            topic_bus_isr_event_t evt;
+            while (ring_buffer_mpmc_read(server->bus->isr_queue, &evt) == 0) {
+                /* 在任务上下文中处理事件 */
+                (void)topic_publish_event(server->bus, evt.event_key);
+                processed++;
+            }
+            dispatched = (size_t)processed;
+        } else {
+            /* 批量出队，整批一次加锁评估规则 */
+            int coalesce = (server->drain_mode == TOPIC_SERVER_DRAIN_COALESCE);
+            size_t n;
+            size_t distinct = 0;
+            while ((n = topic_bus_drain_isr_batch(server->bus, coalesce, &distinct)) > 0) {
+                processed += (int)n;
+                dispatched += distinct;
+            }
         }
+
+#if TOPIC_BUS_ENABLE_STATS
+        if (processed > 0) {
+            server->drain.bursts++;
+            server->drain.events_drained += (uint64_t)processed;
+            server->drain.events_dispatched += dispatched;
+            if ((uint32_t)processed > server->drain.max_burst) {
+                server->drain.max_burst = (uint32_t)processed;
+            }
+        }
+#endif
     }
 #else
     /* 非ISR模式下，可以添加其他处理逻辑 */
     processed = 0;
 #endif
 
+#if TOPIC_BUS_ENABLE_ROUTER
+    /* 本轮分发汇聚到批量sink的记录整批发出；没有ISR事件时只发出等待超时的sink（任务上下文发布汇聚的记录） */
+    if (server->bus->router) {
+        if (processed > 0) {
+            (void)topic_router_flush(server->bus->router);
+        } else {
+            (void)topic_router_flush_due(server->bus->router);
+        }
+    }
+#endif
+
     /* 检查Topic Bus性能（可选） */
     /* 这里可以添加性能检测逻辑 */
     
@@ -99,8 +207,12 @@ int topic_server_start(topic_server_t* server) {
         .ScheduleType = 0
     };
     
-    OsThread_t* thread = os_thread_create(topic_server_task, server, &attr);
-    if (!thread) return -1;
+    server->running = 1;
+    server->thread = os_thread_create(topic_server_task, server, &attr);
+    if (!server->thread) {
+        server->running = 0;
+        return -1;
+    }
     
     return 0;
 }
@@ -112,6 +224,14 @@ int topic_server_start(topic_server_t* server) {
 void topic_server_stop(topic_server_t* server) {
     if (!server) return;
     server->running = 0;
+    if (server->thread) {
+#if TOPIC_BUS_ENABLE_ISR
+        topic_bus_isr_wakeup(server->bus);
+#endif
+        os_thread_join(server->thread);
+        os_thread_destroy(server->thread);
+        server->thread = NULL;
+    }
 }
 
 #if TOPIC_BUS_ENABLE_STATS
@@ -137,5 +257,16 @@ uint64_t topic_server_get_stats(topic_server_t* server, uint64_t* avg_time_us) {
     
     return server->total_processed;
 }
-#endif
 
+/*
+ * @brief 获取ISR队列排空统计
+ * @param server Topic Server指针
+ * @param stats 统计输出
+ * @return 0成功，-1失败
+ */
+int topic_server_get_drain_stats(topic_server_t* server, topic_server_drain_stats_t* stats) {
+    if (!server || !stats) return -1;
+    *stats = server->drain;
+    return 0;
+}
+#endif
@@ -3,20 +3,44 @@
 
 #include <stdint.h>
 #include "topic_bus.h"
+#include "../../Rte/inc/os_thread.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* ISR队列排空模式 */
+typedef enum {
+    TOPIC_SERVER_DRAIN_SINGLE = 0,   /* 逐条出队并发布 */
+    TOPIC_SERVER_DRAIN_BATCH = 1,    /* 批量出队，整批一次加锁评估规则 */
+    TOPIC_SERVER_DRAIN_COALESCE = 2  /* 批量出队并合并同批重复事件 */
+} topic_server_drain_mode_t;
+
+#if TOPIC_BUS_ENABLE_STATS
+/* ISR队列排空统计 */
+typedef struct {
+    uint64_t bursts;                /* 非空批次数 */
+    uint64_t events_drained;        /* 出队事件总数 */
+    uint64_t events_dispatched;     /* 实际评估分发的事件数（合并后） */
+    uint32_t max_burst;             /* 单次运行出队的最大事件数 */
+    uint64_t wakeups;               /* Server任务唤醒次数（含空闲超时） */
+} topic_server_drain_stats_t;
+#endif
+
 /* Topic Server结构 */
 typedef struct {
     topic_bus_t* bus;              /* Topic总线指针 */
     uint32_t period_ms;            /* 运行周期（毫秒） */
     uint32_t last_run_time_ms;     /* 上次运行时间 */
-    int running;                    /* 运行标志 */
+    volatile int running;           /* 运行标志 */
+    topic_server_drain_mode_t drain_mode; /* ISR队列排空模式 */
+    int event_driven;               /* 非0：阻塞等待ISR事件唤醒，period_ms作为空闲超时 */
+    uint32_t max_batch_delay_ms;    /* 唤醒后等待成批的最长时间（毫秒） */
+    OsThread_t* thread;             /* Server任务句柄 */
 #if TOPIC_BUS_ENABLE_STATS
     uint64_t total_processed;       /* 总处理事件数 */
     uint64_t total_time_us;        /* 总耗时（微秒） */
+    topic_server_drain_stats_t drain; /* ISR队列排空统计 */
 #endif
 } topic_server_t;
 
@@ -29,6 +53,23 @@ typedef struct {
  */
 int topic_server_init(topic_server_t* server, topic_bus_t* bus, uint32_t period_ms);
 
+/*
+ * @brief 设置ISR队列排空模式
+ * @param server Topic Server指针
+ * @param mode 排空模式
+ * @return 0成功，-1失败
+ */
+int topic_server_set_drain_mode(topic_server_t* server, topic_server_drain_mode_t mode);
+
+/*
+ * @brief 设置Server唤醒方式
+ * @param server Topic Server指针
+ * @param event_driven 非0表示由ISR事件唤醒，0表示按period_ms轮询
+ * @param max_batch_delay_ms 唤醒后等待更多事件成批的最长时间（毫秒，0表示立即处理）
+ * @return 0成功，-1失败
+ */
+int topic_server_set_wakeup(topic_server_t* server, int event_driven, uint32_t max_batch_delay_ms);
+
 /*
  * @brief 运行Topic Server一次（周期性调用）
  * @param server Topic Server指针
@@ -44,7 +85,7 @@ int topic_server_run_once(topic_server_t* server);
 int topic_server_start(topic_server_t* server);
 
 /*
- * @brief 停止Topic Server
+ * @brief 停止Topic Server（唤醒并等待任务退出）
  * @param server Topic Server指针
  */
 void topic_server_stop(topic_server_t* server);
@@ -57,6 +98,15 @@ void topic_server_stop(topic_server_t* server);
  * @return 总处理事件数
  */
 uint64_t topic_server_get_stats(topic_server_t* server, uint64_t* avg_time_us);
+
+/*
+ * @brief 获取ISR队列排空统计
+ * @details 平均突发长度 = events_drained / bursts，合并比 = events_drained / events_dispatched
+ * @param server Topic Server指针
+ * @param stats 统计输出
+ * @return 0成功，-1失败
+ */
+int topic_server_get_drain_stats(topic_server_t* server, topic_server_drain_stats_t* stats);
 #endif
 
 #ifdef __cplusplus
@@ -0,0 +1,843 @@
+#include <stdio.h>
+#include <string.h>
+#include "topic_shm.h"
+#include "../../Rte/inc/os_heap.h"
+#include "../../Rte/inc/os_timestamp.h"
+
+#if TOPIC_BUS_ENABLE_SHM
+
+#define TOPIC_SHM_MAGIC   0x5A54534DU   /* "ZTSM" */
+#define TOPIC_SHM_VERSION 1U
+
+/* 映射区内各段按缓存行对齐 */
+#define TOPIC_SHM_ALIGN(n) (((n) + 63U) & ~(size_t)63U)
+
+/* 进程槽位 */
+typedef struct {
+    atomic_int in_use;                  /* 非0表示已被某进程占用 */
+    atomic_int waiting;                 /* 非0表示该进程即将阻塞，发布者需唤醒 */
+    atomic_uint gen;                    /* 占用/释放时递增，用于识别信号量是否需要重新打开 */
+} topic_shm_proc_t;
+
+/* 映射区首部（所有引用均为相对映射区起点的偏移） */
+struct topic_shm_header {
+    uint32_t magic;                     /* 初始化完成后写入 */
+    uint32_t version;
+    uint64_t total_size;                /* 映射区总大小 */
+    uint32_t max_topics;
+    uint32_t max_events;
+    uint32_t value_size;                /* 单个值缓冲的数据容量 */
+    uint32_t value_stride;              /* 单个值缓冲（含头）的跨度 */
+    uint32_t value_depth;
+    uint32_t ring_size;
+    uint32_t event_index_bits;          /* event_key索引容量的位宽 */
+    uint32_t reserved;
+    uint64_t topics_off;                /* topic_shm_topic_t[max_topics] */
+    uint64_t events_off;                /* topic_shm_event_t[max_events] */
+    uint64_t event_index_off;           /* atomic_uint[1 << event_index_bits]，存事件槽位+1 */
+    uint64_t values_off;                /* 值缓冲[max_events * value_depth] */
+    uint64_t ring_off;                  /* topic_shm_note_t[ring_size] */
+    atomic_uint topic_count;            /* 已创建的Topic数（控制面锁内追加） */
+    atomic_uint event_count;            /* 已登记的事件数（控制面锁内追加） */
+    atomic_uint_fast64_t ring_head;     /* 通知环累计写入位置 */
+    topic_shm_proc_t procs[TOPIC_SHM_MAX_PROCS];
+};
+
+/* 共享内存Topic */
+typedef struct {
+    uint16_t topic_id;
+    uint8_t type;                       /* TOPIC_RULE_OR / TOPIC_RULE_AND */
+    uint8_t event_count;
+    uint16_t events[TOPIC_SHM_MAX_TOPIC_EVENTS];
+    atomic_uint and_mask;               /* AND规则已到达事件的位图 */
+} topic_shm_topic_t;
+
+/* 共享内存事件 */
+typedef struct {
+    uint16_t key;
+    uint16_t reserved;
+    atomic_uint topic_count;            /* 关联的Topic数 */
+    uint16_t topics[TOPIC_SHM_MAX_EVENT_TOPICS];  /* 关联的Topic槽位 */
+    atomic_uint write_count;            /* 累计借出次数（轮转选择值缓冲） */
+    atomic_uint latest;                 /* 最近发布的值缓冲下标+1，0表示尚未发布 */
+} topic_shm_event_t;
+
+/* 值缓冲头（其后紧跟value_size字节数据） */
+typedef struct {
+    atomic_uint seq;                    /* 偶数为稳定版本，奇数为写入中 */
+    uint32_t len;                       /* 数据长度 */
+    uint16_t event_slot;                /* 所属事件槽位 */
+    uint16_t index;                     /* 在该事件内的缓冲下标 */
+    uint32_t reserved;
+    uint64_t ts_us;                     /* 发布时间 */
+} topic_shm_value_t;
+
+/* 通知（seq为2*pos+2表示位置pos的通知已写完，奇数表示写入中） */
+typedef struct {
+    atomic_uint_fast64_t seq;
+    uint16_t topic_slot;
+    uint16_t event_slot;
+    uint16_t index;                     /* 值缓冲下标 */
+    uint16_t reserved;
+    uint32_t value_seq;                 /* 发布时值缓冲的版本号 */
+    uint32_t len;
+    uint64_t ts_us;
+} topic_shm_note_t;
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static topic_shm_topic_t* __topics(const topic_shm_t* shm);
+static topic_shm_event_t* __events(const topic_shm_t* shm);
+static atomic_uint* __event_index(const topic_shm_t* shm);
+static topic_shm_value_t* __value(const topic_shm_t* shm, uint32_t event_slot, uint32_t index);
+static topic_shm_note_t* __ring(const topic_shm_t* shm);
+static size_t __event_hash(const topic_shm_header_t* hdr, obj_dict_key_t key);
+static int __event_find(const topic_shm_t* shm, obj_dict_key_t key);
+static int __event_register_locked(topic_shm_t* shm, obj_dict_key_t key);
+static int __event_get(topic_shm_t* shm, obj_dict_key_t key);
+static int __proc_attach(topic_shm_t* shm);
+static void __proc_detach(topic_shm_t* shm);
+static void __peer_wake(topic_shm_t* shm, int proc);
+static void __note_push(topic_shm_t* shm, uint32_t topic_slot, const topic_shm_value_t* value, uint32_t value_seq);
+static void __dispatch(topic_shm_t* shm, topic_shm_event_t* ev, const topic_shm_value_t* value, uint32_t value_seq);
+static void __deliver(topic_shm_t* shm, const topic_shm_note_t* note);
+static int __drain(topic_shm_t* shm);
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+static topic_shm_topic_t* __topics(const topic_shm_t* shm) {
+    return (topic_shm_topic_t*)((uint8_t*)shm->hdr + shm->hdr->topics_off);
+}
+
+static topic_shm_event_t* __events(const topic_shm_t* shm) {
+    return (topic_shm_event_t*)((uint8_t*)shm->hdr + shm->hdr->events_off);
+}
+
+static atomic_uint* __event_index(const topic_shm_t* shm) {
+    return (atomic_uint*)((uint8_t*)shm->hdr + shm->hdr->event_index_off);
+}
+
+static topic_shm_value_t* __value(const topic_shm_t* shm, uint32_t event_slot, uint32_t index) {
+    size_t n = (size_t)event_slot * shm->hdr->value_depth + index;
+    return (topic_shm_value_t*)((uint8_t*)shm->hdr + shm->hdr->values_off + n * shm->hdr->value_stride);
+}
+
+static topic_shm_note_t* __ring(const topic_shm_t* shm) {
+    return (topic_shm_note_t*)((uint8_t*)shm->hdr + shm->hdr->ring_off);
+}
+
+/*
+ * @brief 计算event_key在索引中的起始探测位置
+ * @param hdr 映射区首部
+ * @param key 事件键
+ * @return 起始探测下标
+ */
+static size_t __event_hash(const topic_shm_header_t* hdr, obj_dict_key_t key) {
+    return (size_t)(((uint32_t)key * 2654435761U) >> (32U - hdr->event_index_bits));
+}
+
+/*
+ * @brief 无锁查找事件槽位（槽位先初始化再以release发布到索引）
+ * @param shm 进程内句柄
+ * @param key 事件键
+ * @return 事件槽位，不存在返回-1
+ */
+static int __event_find(const topic_shm_t* shm, obj_dict_key_t key) {
+    atomic_uint* index = __event_index(shm);
+    topic_shm_event_t* events = __events(shm);
+    size_t mask = ((size_t)1 << shm->hdr->event_index_bits) - 1;
+    for (size_t pos = __event_hash(shm->hdr, key);; pos = (pos + 1) & mask) {
+        unsigned slot = atomic_load_explicit(&index[pos], memory_order_acquire);
+        if (slot == 0) return -1;
+        if (events[slot - 1].key == key) return (int)(slot - 1);
+    }
+}
+
+/*
+ * @brief 登记事件（调用者持有控制面锁）
+ * @param shm 进程内句柄
+ * @param key 事件键
+ * @return 事件槽位，已满返回-1
+ */
+static int __event_register_locked(topic_shm_t* shm, obj_dict_key_t key) {
+    int found = __event_find(shm, key);
+    if (found >= 0) return found;
+
+    topic_shm_header_t* hdr = shm->hdr;
+    unsigned slot = atomic_load_explicit(&hdr->event_count, memory_order_relaxed);
+    if (slot >= hdr->max_events) return -1;
+
+    topic_shm_event_t* ev = &__events(shm)[slot];
+    memset(ev, 0, sizeof(*ev));
+    ev->key = key;
+    for (uint32_t i = 0; i < hdr->value_depth; ++i) {
+        topic_shm_value_t* value = __value(shm, slot, i);
+        memset(value, 0, sizeof(*value));
+        value->event_slot = (uint16_t)slot;
+        value->index = (uint16_t)i;
+    }
+
+    atomic_uint* index = __event_index(shm);
+    size_t mask = ((size_t)1 << hdr->event_index_bits) - 1;
+    size_t pos = __event_hash(hdr, key);
+    while (atomic_load_explicit(&index[pos], memory_order_relaxed) != 0) {
+        pos = (pos + 1) & mask;
+    }
+    atomic_store_explicit(&index[pos], slot + 1U, memory_order_release);
+    atomic_store_explicit(&hdr->event_count, slot + 1U, memory_order_release);
+    return (int)slot;
+}
+
+/*
+ * @brief 查找事件，不存在时登记
+ * @param shm 进程内句柄
+ * @param key 事件键
+ * @return 事件槽位，失败返回-1
+ */
+static int __event_get(topic_shm_t* shm, obj_dict_key_t key) {
+    int slot = __event_find(shm, key);
+    if (slot >= 0) return slot;
+    if (os_semaphore_take(shm->lock, 100) < 0) return -1;
+    slot = __event_register_locked(shm, key);
+    os_semaphore_give(shm->lock);
+    return slot;
+}
+
+/*
+ * @brief 占用进程槽位并创建本进程的唤醒信号量
+ * @param shm 进程内句柄
+ * @return 0成功，-1失败
+ */
+static int __proc_attach(topic_shm_t* shm) {
+    char sem_name[sizeof(shm->name) + 16];
+    for (int i = 0; i < TOPIC_SHM_MAX_PROCS; ++i) {
+        topic_shm_proc_t* proc = &shm->hdr->procs[i];
+        int expected = 0;
+        if (!atomic_compare_exchange_strong(&proc->in_use, &expected, 1)) continue;
+
+        snprintf(sem_name, sizeof(sem_name), "%s.p%d", shm->name, i);
+        shm->signal = os_semaphore_create(0, sem_name);
+        if (!shm->signal) {
+            atomic_store_explicit(&proc->in_use, 0, memory_order_release);
+            return -1;
+        }
+        atomic_store_explicit(&proc->waiting, 0, memory_order_relaxed);
+        atomic_fetch_add_explicit(&proc->gen, 1, memory_order_release);
+        shm->proc = i;
+        /* 从接入时刻开始接收通知 */
+        shm->cursor = atomic_load_explicit(&shm->hdr->ring_head, memory_order_acquire);
+        return 0;
+    }
+    return -1;
+}
+
+/*
+ * @brief 释放进程槽位与唤醒信号量
+ * @param shm 进程内句柄
+ */
+static void __proc_detach(topic_shm_t* shm) {
+    if (shm->proc < 0) return;
+    topic_shm_proc_t* proc = &shm->hdr->procs[shm->proc];
+    atomic_fetch_add_explicit(&proc->gen, 1, memory_order_release);
+    atomic_store_explicit(&proc->waiting, 0, memory_order_relaxed);
+    atomic_store_explicit(&proc->in_use, 0, memory_order_release);
+    if (shm->signal) {
+        os_semaphore_destroy(shm->signal);
+        shm->signal = NULL;
+    }
+    shm->proc = -1;
+}
+
+/*
+ * @brief 唤醒另一个进程（按需打开其命名信号量并缓存）
+ * @param shm 进程内句柄
+ * @param proc 目标进程槽位
+ */
+static void __peer_wake(topic_shm_t* shm, int proc) {
+    char sem_name[sizeof(shm->name) + 16];
+    unsigned gen = atomic_load_explicit(&shm->hdr->procs[proc].gen, memory_order_acquire);
+    if (os_semaphore_take(shm->peer_lock, 100) < 0) return;
+
+    topic_shm_peer_t* peer = &shm->peers[proc];
+    if (peer->sem && peer->gen != gen) {
+        /* 该槽位已换了进程，原信号量文件已被删除 */
+        os_semaphore_close(peer->sem);
+        peer->sem = NULL;
+    }
+    if (!peer->sem) {
+        snprintf(sem_name, sizeof(sem_name), "%s.p%d", shm->name, proc);
+        peer->sem = os_semaphore_open(sem_name);
+        peer->gen = gen;
+    }
+    if (peer->sem) {
+        os_semaphore_give(peer->sem);
+        atomic_fetch_add_explicit(&shm->wakeups, 1, memory_order_relaxed);
+    }
+    os_semaphore_give(shm->peer_lock);
+}
+
+/*
+ * @brief 追加一条通知（多生产者：fetch_add占位，seqlock式提交）
+ * @param shm 进程内句柄
+ * @param topic_slot 触发的Topic槽位
+ * @param value 值缓冲
+ * @param value_seq 值缓冲发布后的版本号
+ */
+static void __note_push(topic_shm_t* shm, uint32_t topic_slot, const topic_shm_value_t* value, uint32_t value_seq) {
+    topic_shm_header_t* hdr = shm->hdr;
+    uint64_t pos = atomic_fetch_add_explicit(&hdr->ring_head, 1, memory_order_seq_cst);
+    topic_shm_note_t* note = &__ring(shm)[pos & (hdr->ring_size - 1U)];
+
+    atomic_store_explicit(&note->seq, pos * 2U + 1U, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    note->topic_slot = (uint16_t)topic_slot;
+    note->event_slot = value->event_slot;
+    note->index = value->index;
+    note->value_seq = value_seq;
+    note->len = value->len;
+    note->ts_us = value->ts_us;
+    atomic_store_explicit(&note->seq, pos * 2U + 2U, memory_order_release);
+}
+
+/*
+ * @brief 按规则计算触发的Topic并追加通知，随后唤醒正在等待的进程
+ * @param shm 进程内句柄
+ * @param ev 事件
+ * @param value 已发布的值缓冲
+ * @param value_seq 值缓冲版本号
+ */
+static void __dispatch(topic_shm_t* shm, topic_shm_event_t* ev, const topic_shm_value_t* value, uint32_t value_seq) {
+    topic_shm_topic_t* topics = __topics(shm);
+    unsigned topic_count = atomic_load_explicit(&ev->topic_count, memory_order_acquire);
+    int pushed = 0;
+
+    for (unsigned i = 0; i < topic_count; ++i) {
+        uint32_t slot = ev->topics[i];
+        topic_shm_topic_t* topic = &topics[slot];
+        if (topic->type == TOPIC_RULE_AND) {
+            /* 全部事件到达后由完成置位的发布者清零并触发，并发发布时只触发一次 */
+            unsigned bit = 0;
+            for (unsigned k = 0; k < topic->event_count; ++k) {
+                if (topic->events[k] == ev->key) bit |= 1U << k;
+            }
+            unsigned full = (1U << topic->event_count) - 1U;
+            unsigned seen = atomic_fetch_or_explicit(&topic->and_mask, bit, memory_order_acq_rel) | bit;
+            if (seen != full ||
+                !atomic_compare_exchange_strong_explicit(&topic->and_mask, &seen, 0,
+                                                         memory_order_acq_rel, memory_order_relaxed)) {
+                continue;
+            }
+        }
+        __note_push(shm, slot, value, value_seq);
+        pushed++;
+    }
+    if (pushed == 0) return;
+
+    /* 与等待方“先置waiting再查ring_head”配对，不会丢失唤醒 */
+    atomic_thread_fence(memory_order_seq_cst);
+    for (int p = 0; p < TOPIC_SHM_MAX_PROCS; ++p) {
+        topic_shm_proc_t* proc = &shm->hdr->procs[p];
+        if (!atomic_load_explicit(&proc->waiting, memory_order_relaxed) ||
+            !atomic_load_explicit(&proc->in_use, memory_order_relaxed)) {
+            continue;
+        }
+        if (p == shm->proc) {
+            /* 本进程的轮询线程正在等待（发布来自本进程的其他线程）：直接释放本进程的信号量 */
+            os_semaphore_give(shm->signal);
+        } else {
+            __peer_wake(shm, p);
+        }
+    }
+}
+
+/*
+ * @brief 将一条通知交给本进程的订阅者
+ * @param shm 进程内句柄
+ * @param note 通知副本
+ */
+static void __deliver(topic_shm_t* shm, const topic_shm_note_t* note) {
+    if (note->topic_slot >= atomic_load_explicit(&shm->hdr->topic_count, memory_order_acquire)) return;
+    uint16_t topic_id = __topics(shm)[note->topic_slot].topic_id;
+
+    topic_shm_value_t* value = __value(shm, note->event_slot, note->index);
+    const void* data = (const uint8_t*)value + sizeof(topic_shm_value_t);
+    int checked = 0;
+    for (size_t i = 0; i < shm->sub_count; ++i) {
+        topic_shm_sub_t* sub = &shm->subs[i];
+        if (sub->topic_id != topic_id) continue;
+        if (!checked) {
+            /* 读取前版本号已变化：该缓冲已被后续发布复用 */
+            if (atomic_load_explicit(&value->seq, memory_order_acquire) != note->value_seq) {
+                shm->overruns++;
+                return;
+            }
+            checked = 1;
+        }
+        sub->callback(topic_id, data, note->len, sub->user_data);
+        shm->delivered++;
+    }
+
+    /* 回调期间被覆盖：回调看到的数据可能不完整 */
+    if (checked) {
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&value->seq, memory_order_relaxed) != note->value_seq) {
+            shm->overruns++;
+        }
+    }
+}
+
+/*
+ * @brief 处理通知环中本进程尚未读取的通知
+ * @param shm 进程内句柄
+ * @return 处理的通知数
+ */
+static int __drain(topic_shm_t* shm) {
+    topic_shm_header_t* hdr = shm->hdr;
+    topic_shm_note_t* ring = __ring(shm);
+    int count = 0;
+
+    for (;;) {
+        topic_shm_note_t* slot = &ring[shm->cursor & (hdr->ring_size - 1U)];
+        uint64_t expected = shm->cursor * 2U + 2U;
+        uint64_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        if (seq < expected) break;      /* 尚未写入或正在写入 */
+        if (seq > expected) {
+            /* 已被下一圈覆盖：跳到最旧的仍有效位置 */
+            uint64_t head = atomic_load_explicit(&hdr->ring_head, memory_order_acquire);
+            uint64_t oldest = (head > hdr->ring_size) ? head - hdr->ring_size : 0;
+            if (oldest <= shm->cursor) oldest = shm->cursor + 1U;
+            shm->lost += oldest - shm->cursor;
+            shm->cursor = oldest;
+            continue;
+        }
+
+        topic_shm_note_t note;
+        note.topic_slot = slot->topic_slot;
+        note.event_slot = slot->event_slot;
+        note.index = slot->index;
+        note.value_seq = slot->value_seq;
+        note.len = slot->len;
+        note.ts_us = slot->ts_us;
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&slot->seq, memory_order_relaxed) != expected) continue;
+
+        shm->cursor++;
+        __deliver(shm, &note);
+        count++;
+    }
+    return count;
+}
+
+/*
+ * @brief 创建共享内存总线
+ * @param shm 进程内句柄
+ * @param name 映射区名称
+ * @param config 配置
+ * @return 0成功，-1失败
+ */
+int topic_shm_create(topic_shm_t* shm, const char* name, const topic_shm_config_t* config) {
+    if (!shm || !name || strlen(name) >= sizeof(shm->name)) return -1;
+
+    topic_shm_config_t cfg = {
+        .max_topics = TOPIC_SHM_DEFAULT_MAX_TOPICS,
+        .max_events = TOPIC_SHM_DEFAULT_MAX_EVENTS,
+        .value_size = TOPIC_SHM_DEFAULT_VALUE_SIZE,
+        .value_depth = TOPIC_SHM_DEFAULT_VALUE_DEPTH,
+        .ring_size = TOPIC_SHM_DEFAULT_RING_SIZE,
+    };
+    if (config) cfg = *config;
+    if (cfg.max_topics == 0 || cfg.max_topics > 0xFFFFU || cfg.max_events == 0 || cfg.max_events > 0xFFFFU ||
+        cfg.value_size == 0 || cfg.value_size > 0xFFFFFFFFU || cfg.value_depth < 2 || cfg.value_depth > 0xFFFFU ||
+        cfg.ring_size < 2 || (cfg.ring_size & (cfg.ring_size - 1U)) != 0) {
+        return -1;
+    }
+
+    memset(shm, 0, sizeof(*shm));
+    shm->proc = -1;
+    strcpy(shm->name, name);
+
+    /* 计算各段偏移 */
+    uint32_t index_bits = 1;
+    while (((size_t)1 << index_bits) < cfg.max_events * 2) {
+        index_bits++;
+    }
+    size_t stride = TOPIC_SHM_ALIGN(sizeof(topic_shm_value_t) + cfg.value_size);
+    size_t off = TOPIC_SHM_ALIGN(sizeof(topic_shm_header_t));
+    size_t topics_off = off;
+    off = TOPIC_SHM_ALIGN(off + sizeof(topic_shm_topic_t) * cfg.max_topics);
+    size_t events_off = off;
+    off = TOPIC_SHM_ALIGN(off + sizeof(topic_shm_event_t) * cfg.max_events);
+    size_t index_off = off;
+    off = TOPIC_SHM_ALIGN(off + sizeof(atomic_uint) * ((size_t)1 << index_bits));
+    size_t values_off = off;
+    off = TOPIC_SHM_ALIGN(off + stride * cfg.max_events * cfg.value_depth);
+    size_t ring_off = off;
+    off = TOPIC_SHM_ALIGN(off + sizeof(topic_shm_note_t) * cfg.ring_size);
+
+    char lock_name[sizeof(shm->name) + 8];
+    snprintf(lock_name, sizeof(lock_name), "%s.lock", name);
+    shm->map = os_mmap_create(name, off);
+    shm->lock = os_semaphore_create(1, lock_name);
+    shm->peer_lock = os_semaphore_create(1, NULL);
+    if (!shm->map || !shm->lock || !shm->peer_lock) goto __error;
+    shm->owner = 1;
+
+    topic_shm_header_t* hdr = (topic_shm_header_t*)shm->map->pBuffer;
+    memset(hdr, 0, off);
+    hdr->version = TOPIC_SHM_VERSION;
+    hdr->total_size = off;
+    hdr->max_topics = (uint32_t)cfg.max_topics;
+    hdr->max_events = (uint32_t)cfg.max_events;
+    hdr->value_size = (uint32_t)cfg.value_size;
+    hdr->value_stride = (uint32_t)stride;
+    hdr->value_depth = (uint32_t)cfg.value_depth;
+    hdr->ring_size = (uint32_t)cfg.ring_size;
+    hdr->event_index_bits = index_bits;
+    hdr->topics_off = topics_off;
+    hdr->events_off = events_off;
+    hdr->event_index_off = index_off;
+    hdr->values_off = values_off;
+    hdr->ring_off = ring_off;
+    shm->hdr = hdr;
+
+    /* 首部完整后再写入magic，接入方以此判断初始化完成 */
+    atomic_thread_fence(memory_order_release);
+    hdr->magic = TOPIC_SHM_MAGIC;
+
+    if (__proc_attach(shm) != 0) goto __error;
+    return 0;
+
+__error:
+    topic_shm_close(shm);
+    return -1;
+}
+
+/*
+ * @brief 接入已创建的共享内存总线
+ * @param shm 进程内句柄
+ * @param name 映射区名称
+ * @return 0成功，-1失败
+ */
+int topic_shm_open(topic_shm_t* shm, const char* name) {
+    if (!shm || !name || strlen(name) >= sizeof(shm->name)) return -1;
+
+    memset(shm, 0, sizeof(*shm));
+    shm->proc = -1;
+    strcpy(shm->name, name);
+
+    /* 先映射首部取得总大小，再映射整个区域 */
+    OsMMap_t* probe = os_mmap_open(name, sizeof(topic_shm_header_t));
+    if (!probe) return -1;
+    topic_shm_header_t* probe_hdr = (topic_shm_header_t*)probe->pBuffer;
+    uint32_t magic = probe_hdr->magic;
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t total_size = probe_hdr->total_size;
+    uint32_t version = probe_hdr->version;
+    os_mmap_close(probe);
+    if (magic != TOPIC_SHM_MAGIC || version != TOPIC_SHM_VERSION) return -1;
+
+    char lock_name[sizeof(shm->name) + 8];
+    snprintf(lock_name, sizeof(lock_name), "%s.lock", name);
+    shm->map = os_mmap_open(name, (size_t)total_size);
+    shm->lock = os_semaphore_open(lock_name);
+    shm->peer_lock = os_semaphore_create(1, NULL);
+    if (!shm->map || !shm->lock || !shm->peer_lock) goto __error;
+    shm->hdr = (topic_shm_header_t*)shm->map->pBuffer;
+
+    if (__proc_attach(shm) != 0) goto __error;
+    return 0;
+
+__error:
+    topic_shm_close(shm);
+    return -1;
+}
+
+/*
+ * @brief 退出共享内存总线
+ * @param shm 进程内句柄
+ * @return 0成功，-1失败
+ */
+int topic_shm_close(topic_shm_t* shm) {
+    if (!shm) return -1;
+    if (shm->hdr) {
+        __proc_detach(shm);
+    }
+    for (int i = 0; i < TOPIC_SHM_MAX_PROCS; ++i) {
+        if (shm->peers[i].sem) {
+            os_semaphore_close(shm->peers[i].sem);
+            shm->peers[i].sem = NULL;
+        }
+    }
+    if (shm->peer_lock) {
+        os_semaphore_destroy(shm->peer_lock);
+        shm->peer_lock = NULL;
+    }
+    if (shm->lock) {
+        if (shm->owner) {
+            os_semaphore_destroy(shm->lock);
+        } else {
+            os_semaphore_close(shm->lock);
+        }
+        shm->lock = NULL;
+    }
+    if (shm->map) {
+        if (shm->owner) {
+            os_mmap_destroy(shm->map);
+        } else {
+            os_mmap_close(shm->map);
+        }
+        shm->map = NULL;
+    }
+    shm->hdr = NULL;
+    shm->sub_count = 0;
+    return 0;
+}
+
+/*
+ * @brief 在共享内存中创建Topic规则
+ * @param shm 进程内句柄
+ * @param topic_id Topic ID
+ * @param rule 规则
+ * @return 0成功，-1失败
+ */
+int topic_shm_rule_create(topic_shm_t* shm, uint16_t topic_id, const topic_rule_t* rule) {
+    if (!shm || !shm->hdr || !rule || !rule->events || rule->event_count == 0 ||
+        rule->event_count > TOPIC_SHM_MAX_TOPIC_EVENTS ||
+        (rule->type != TOPIC_RULE_OR && rule->type != TOPIC_RULE_AND)) {
+        return -1;
+    }
+    if (os_semaphore_take(shm->lock, 100) < 0) return -1;
+
+    topic_shm_header_t* hdr = shm->hdr;
+    topic_shm_topic_t* topics = __topics(shm);
+    unsigned slot = atomic_load_explicit(&hdr->topic_count, memory_order_relaxed);
+    int ret = (slot < hdr->max_topics) ? 0 : -1;
+    for (unsigned i = 0; ret == 0 && i < slot; ++i) {
+        if (topics[i].topic_id == topic_id) ret = -1;  /* 已存在 */
+    }
+
+    /* 先登记全部事件并检查容量，再修改任何关联关系 */
+    int event_slots[TOPIC_SHM_MAX_TOPIC_EVENTS];
+    topic_shm_event_t* events = __events(shm);
+    for (size_t i = 0; ret == 0 && i < rule->event_count; ++i) {
+        event_slots[i] = __event_register_locked(shm, rule->events[i]);
+        if (event_slots[i] < 0 ||
+            atomic_load_explicit(&events[event_slots[i]].topic_count, memory_order_relaxed) >= TOPIC_SHM_MAX_EVENT_TOPICS) {
+            ret = -1;
+        }
+    }
+
+    if (ret == 0) {
+        topic_shm_topic_t* topic = &topics[slot];
+        memset(topic, 0, sizeof(*topic));
+        topic->topic_id = topic_id;
+        topic->type = (uint8_t)rule->type;
+        topic->event_count = (uint8_t)rule->event_count;
+        for (size_t i = 0; i < rule->event_count; ++i) {
+            topic->events[i] = rule->events[i];
+        }
+        atomic_store_explicit(&hdr->topic_count, slot + 1U, memory_order_release);
+
+        /* 关联到事件：先写槽位再以release增加计数，发布者无锁读取 */
+        for (size_t i = 0; i < rule->event_count; ++i) {
+            topic_shm_event_t* ev = &events[event_slots[i]];
+            unsigned n = atomic_load_explicit(&ev->topic_count, memory_order_relaxed);
+            int dup = 0;
+            for (unsigned k = 0; k < n; ++k) {
+                if (ev->topics[k] == slot) dup = 1;  /* 同一事件在规则中重复出现 */
+            }
+            if (dup) continue;
+            ev->topics[n] = (uint16_t)slot;
+            atomic_store_explicit(&ev->topic_count, n + 1U, memory_order_release);
+        }
+    }
+
+    os_semaphore_give(shm->lock);
+    return ret;
+}
+
+/*
+ * @brief 订阅Topic
+ * @param shm 进程内句柄
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_shm_subscribe(topic_shm_t* shm, uint16_t topic_id,
+                        void (*callback)(uint16_t, const void*, size_t, void*), void* user_data) {
+    if (!shm || !callback || shm->sub_count >= TOPIC_SHM_MAX_SUBS) return -1;
+    topic_shm_sub_t* sub = &shm->subs[shm->sub_count];
+    sub->callback = callback;
+    sub->user_data = user_data;
+    sub->topic_id = topic_id;
+    shm->sub_count++;
+    return 0;
+}
+
+/*
+ * @brief 取消订阅
+ * @param shm 进程内句柄
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_shm_unsubscribe(topic_shm_t* shm, uint16_t topic_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*), void* user_data) {
+    if (!shm) return -1;
+    for (size_t i = 0; i < shm->sub_count; ++i) {
+        topic_shm_sub_t* sub = &shm->subs[i];
+        if (sub->topic_id == topic_id && sub->callback == callback && sub->user_data == user_data) {
+            memmove(sub, sub + 1, (shm->sub_count - i - 1) * sizeof(*sub));
+            shm->sub_count--;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * @brief 借出事件的下一个值缓冲
+ * @param shm 进程内句柄
+ * @param event_key 事件键
+ * @param size 需要的字节数
+ * @return 缓冲指针，失败返回NULL
+ */
+void* topic_shm_loan(topic_shm_t* shm, obj_dict_key_t event_key, size_t size) {
+    if (!shm || !shm->hdr || size > shm->hdr->value_size) return NULL;
+    int slot = __event_get(shm, event_key);
+    if (slot < 0) return NULL;
+
+    topic_shm_event_t* ev = &__events(shm)[slot];
+    unsigned index = atomic_fetch_add_explicit(&ev->write_count, 1, memory_order_relaxed) % shm->hdr->value_depth;
+    topic_shm_value_t* value = __value(shm, (uint32_t)slot, index);
+
+    /* 版本号置为奇数后再写数据，读者据此识别写入中的缓冲 */
+    atomic_fetch_add_explicit(&value->seq, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    return (uint8_t*)value + sizeof(topic_shm_value_t);
+}
+
+/*
+ * @brief 发布借出的缓冲
+ * @param shm 进程内句柄
+ * @param payload 借出的缓冲
+ * @param len 实际写入的字节数
+ * @return 0成功，-1失败
+ */
+int topic_shm_publish_loaned(topic_shm_t* shm, void* payload, size_t len) {
+    if (!shm || !shm->hdr || !payload || len > shm->hdr->value_size) return -1;
+
+    /* 由缓冲地址反推值缓冲头，并确认它确实位于值缓冲段内 */
+    topic_shm_header_t* hdr = shm->hdr;
+    size_t off = (size_t)((uint8_t*)payload - (uint8_t*)hdr) - sizeof(topic_shm_value_t);
+    size_t values_len = (size_t)hdr->max_events * hdr->value_depth * hdr->value_stride;
+    if ((uint8_t*)payload < (uint8_t*)hdr || off < hdr->values_off || off >= hdr->values_off + values_len ||
+        (off - hdr->values_off) % hdr->value_stride != 0) {
+        return -1;
+    }
+    topic_shm_value_t* value = (topic_shm_value_t*)((uint8_t*)hdr + off);
+    topic_shm_event_t* ev = &__events(shm)[value->event_slot];
+
+    value->len = (uint32_t)len;
+    value->ts_us = os_monotonic_time_get_microsecond();
+    unsigned seq = atomic_fetch_add_explicit(&value->seq, 1, memory_order_release) + 1U;
+    atomic_store_explicit(&ev->latest, (unsigned)value->index + 1U, memory_order_release);
+    atomic_fetch_add_explicit(&shm->published, 1, memory_order_relaxed);
+
+    __dispatch(shm, ev, value, seq);
+    return 0;
+}
+
+/*
+ * @brief 发布事件
+ * @param shm 进程内句柄
+ * @param event_key 事件键
+ * @param data 数据
+ * @param len 数据长度
+ * @return 0成功，-1失败
+ */
+int topic_shm_publish(topic_shm_t* shm, obj_dict_key_t event_key, const void* data, size_t len) {
+    if (!data && len > 0) return -1;
+    void* payload = topic_shm_loan(shm, event_key, len);
+    if (!payload) return -1;
+    if (len > 0) memcpy(payload, data, len);
+    return topic_shm_publish_loaned(shm, payload, len);
+}
+
+/*
+ * @brief 读取事件的最新值
+ * @param shm 进程内句柄
+ * @param event_key 事件键
+ * @param out 输出缓冲
+ * @param out_size 输出缓冲大小
+ * @return 数据长度，事件不存在、尚未发布或重试TOPIC_SHM_GET_RETRIES次仍在写入返回-1
+ */
+int topic_shm_get(topic_shm_t* shm, obj_dict_key_t event_key, void* out, size_t out_size) {
+    if (!shm || !shm->hdr || (!out && out_size > 0)) return -1;
+    int slot = __event_find(shm, event_key);
+    if (slot < 0) return -1;
+    topic_shm_event_t* ev = &__events(shm)[slot];
+
+    for (uint32_t retry = 0; retry < TOPIC_SHM_GET_RETRIES; ++retry) {
+        unsigned latest = atomic_load_explicit(&ev->latest, memory_order_acquire);
+        if (latest == 0) return -1;
+        topic_shm_value_t* value = __value(shm, (uint32_t)slot, latest - 1U);
+        unsigned seq = atomic_load_explicit(&value->seq, memory_order_acquire);
+        if (seq & 1U) continue;  /* 正在写入 */
+
+        size_t len = value->len;
+        memcpy(out, (const uint8_t*)value + sizeof(topic_shm_value_t), (len < out_size) ? len : out_size);
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&value->seq, memory_order_relaxed) == seq) {
+            return (int)len;
+        }
+    }
+    return -1;  /* 写者进程可能在借出与发布之间退出，值缓冲停留在写入中 */
+}
+
+/*
+ * @brief 处理本进程的待处理通知
+ * @param shm 进程内句柄
+ * @param timeout_ms 最长等待时间（毫秒）
+ * @return 本次处理的通知数
+ */
+int topic_shm_poll(topic_shm_t* shm, uint32_t timeout_ms) {
+    if (!shm || !shm->hdr || shm->proc < 0) return 0;
+
+    int count = __drain(shm);
+    if (count > 0 || timeout_ms == 0) return count;
+
+    /* 先声明等待再复查通知环，发布者在追加通知后检查waiting */
+    topic_shm_proc_t* proc = &shm->hdr->procs[shm->proc];
+    atomic_store_explicit(&proc->waiting, 1, memory_order_seq_cst);
+    if (atomic_load_explicit(&shm->hdr->ring_head, memory_order_seq_cst) == shm->cursor) {
+        (void)os_semaphore_take(shm->signal, timeout_ms);
+    }
+    atomic_store_explicit(&proc->waiting, 0, memory_order_relaxed);
+    return __drain(shm);
+}
+
+/*
+ * @brief 获取本进程统计
+ * @param shm 进程内句柄
+ * @param stats 输出统计
+ */
+void topic_shm_get_stats(const topic_shm_t* shm, topic_shm_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!shm) return;
+    topic_shm_t* s = (topic_shm_t*)shm;
+    stats->published = atomic_load_explicit(&s->published, memory_order_relaxed);
+    stats->wakeups = atomic_load_explicit(&s->wakeups, memory_order_relaxed);
+    stats->delivered = shm->delivered;
+    stats->lost = shm->lost;
+    stats->overruns = shm->overruns;
+}
+
+#endif /* TOPIC_BUS_ENABLE_SHM */
@@ -0,0 +1,200 @@
+#ifndef TOPIC_SHM_H_
+#define TOPIC_SHM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "topic_bus_config.h"
+#include "topic_rule.h"
+#include "../obj_dict/obj_dict.h"
+#include "../../Rte/inc/os_mmap.h"
+#include "../../Rte/inc/os_semaphore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if TOPIC_BUS_ENABLE_SHM
+
+/*
+ * 共享内存多进程Topic总线：
+ *   一块命名映射区内放置Topic表、事件值缓冲（对象字典值）与无锁广播通知环，全部以偏移量互相引用，
+ *   各进程映射到不同地址也可直接使用。发布者把数据写入事件值缓冲（或借出缓冲直接写入），
+ *   按规则计算触发的Topic后向通知环追加通知；订阅进程按自己的读位置取通知，
+ *   回调直接拿到映射区内的数据指针，跨进程零拷贝
+ *
+ *   每个事件有value_depth个值缓冲轮流写入，缓冲带版本号（seqlock）：回调前后版本号变化说明
+ *   数据在回调期间被新发布覆盖，计入overruns；通知环被写满一圈仍未读取的通知计入lost
+ *   跨进程唤醒使用每进程一个命名信号量，只在订阅进程即将阻塞时释放
+ */
+
+/* 共享内存总线配置 */
+typedef struct {
+    size_t max_topics;                  /* 最大Topic数 */
+    size_t max_events;                  /* 最大事件数 */
+    size_t value_size;                  /* 单个事件值缓冲的最大字节数 */
+    size_t value_depth;                 /* 每个事件的值缓冲个数（>=2） */
+    size_t ring_size;                   /* 通知环容量（2的幂） */
+} topic_shm_config_t;
+
+/* 共享内存总线统计（本进程） */
+typedef struct {
+    uint64_t published;                 /* 本进程发布次数 */
+    uint64_t delivered;                 /* 本进程回调次数 */
+    uint64_t lost;                      /* 未及时读取而被覆盖的通知数 */
+    uint64_t overruns;                  /* 回调前或回调期间数据被覆盖的次数 */
+    uint64_t wakeups;                   /* 本进程释放的跨进程唤醒次数 */
+} topic_shm_stats_t;
+
+typedef struct topic_shm_header topic_shm_header_t;
+
+/* 其他进程的唤醒信号量缓存 */
+typedef struct {
+    OsSemaphore_t* sem;                 /* 已打开的命名信号量 */
+    uint32_t gen;                       /* 打开时该进程槽位的代数 */
+} topic_shm_peer_t;
+
+/* 本进程的订阅 */
+typedef struct {
+    void (*callback)(uint16_t topic_id, const void* data, size_t data_len, void* user);
+    void* user_data;
+    uint16_t topic_id;
+} topic_shm_sub_t;
+
+/* 共享内存总线的进程内句柄 */
+typedef struct {
+    OsMMap_t* map;                      /* 映射区 */
+    topic_shm_header_t* hdr;            /* 映射区首部 */
+    OsSemaphore_t* lock;                /* 控制面锁（跨进程命名信号量，仅建Topic/登记事件时使用） */
+    OsSemaphore_t* signal;              /* 本进程的唤醒信号量 */
+    int proc;                           /* 本进程在映射区中的槽位 */
+    int owner;                          /* 非0表示由本进程创建，关闭时删除映射区 */
+    uint64_t cursor;                    /* 通知环读取位置 */
+    topic_shm_peer_t peers[TOPIC_SHM_MAX_PROCS];
+    topic_shm_sub_t subs[TOPIC_SHM_MAX_SUBS];
+    size_t sub_count;                   /* 订阅数 */
+    OsSemaphore_t* peer_lock;           /* 保护peers（本进程多线程发布） */
+    atomic_uint_fast64_t published;     /* 本进程发布次数 */
+    atomic_uint_fast64_t wakeups;       /* 本进程释放的跨进程唤醒次数 */
+    uint64_t delivered;                 /* 以下仅由poll线程更新 */
+    uint64_t lost;
+    uint64_t overruns;
+    char name[96];                      /* 映射区名称（路径） */
+} topic_shm_t;
+
+/*
+ * @brief 创建共享内存总线（已存在同名映射区时重建）
+ * @param shm 进程内句柄
+ * @param name 映射区名称（Linux上为文件路径，建议位于/dev/shm）
+ * @param config 配置（NULL使用TOPIC_SHM_DEFAULT_*）
+ * @return 0成功，-1失败
+ */
+int topic_shm_create(topic_shm_t* shm, const char* name, const topic_shm_config_t* config);
+
+/*
+ * @brief 接入已创建的共享内存总线
+ * @param shm 进程内句柄
+ * @param name 映射区名称
+ * @return 0成功，-1失败（不存在、版本不符或进程槽位已满）
+ */
+int topic_shm_open(topic_shm_t* shm, const char* name);
+
+/*
+ * @brief 退出共享内存总线；创建者同时删除映射区与控制面锁
+ * @param shm 进程内句柄
+ * @return 0成功，-1失败
+ */
+int topic_shm_close(topic_shm_t* shm);
+
+/*
+ * @brief 在共享内存中创建Topic规则（任一进程均可创建，对全部进程生效）
+ * @param shm 进程内句柄
+ * @param topic_id Topic ID
+ * @param rule 规则（仅支持TOPIC_RULE_OR与TOPIC_RULE_AND，不含时效检查）
+ * @return 0成功，-1失败
+ */
+int topic_shm_rule_create(topic_shm_t* shm, uint16_t topic_id, const topic_rule_t* rule);
+
+/*
+ * @brief 订阅Topic（回调在本进程调用topic_shm_poll的线程中执行）
+ * @param shm 进程内句柄
+ * @param topic_id Topic ID
+ * @param callback 回调函数（data指向映射区，回调返回后不应再访问）
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_shm_subscribe(topic_shm_t* shm, uint16_t topic_id,
+                        void (*callback)(uint16_t, const void*, size_t, void*), void* user_data);
+
+/*
+ * @brief 取消订阅
+ * @param shm 进程内句柄
+ * @param topic_id Topic ID
+ * @param callback 回调函数
+ * @param user_data 用户数据
+ * @return 0成功，-1失败
+ */
+int topic_shm_unsubscribe(topic_shm_t* shm, uint16_t topic_id,
+                          void (*callback)(uint16_t, const void*, size_t, void*), void* user_data);
+
+/*
+ * @brief 借出事件的下一个值缓冲，生产者直接写入（零拷贝发布）
+ * @param shm 进程内句柄
+ * @param event_key 事件键（首次使用时自动登记）
+ * @param size 需要的字节数（不超过value_size）
+ * @return 缓冲指针，失败返回NULL；必须随后调用topic_shm_publish_loaned
+ */
+void* topic_shm_loan(topic_shm_t* shm, obj_dict_key_t event_key, size_t size);
+
+/*
+ * @brief 发布借出的缓冲
+ * @param shm 进程内句柄
+ * @param payload topic_shm_loan返回的缓冲
+ * @param len 实际写入的字节数
+ * @return 0成功，-1失败
+ */
+int topic_shm_publish_loaned(topic_shm_t* shm, void* payload, size_t len);
+
+/*
+ * @brief 发布事件（拷贝一次到映射区）
+ * @param shm 进程内句柄
+ * @param event_key 事件键
+ * @param data 数据
+ * @param len 数据长度
+ * @return 0成功，-1失败
+ */
+int topic_shm_publish(topic_shm_t* shm, obj_dict_key_t event_key, const void* data, size_t len);
+
+/*
+ * @brief 读取事件的最新值（拷贝，发布者并发写入时自动重试，最多TOPIC_SHM_GET_RETRIES次）
+ * @param shm 进程内句柄
+ * @param event_key 事件键
+ * @param out 输出缓冲
+ * @param out_size 输出缓冲大小
+ * @return 数据长度，事件不存在、尚未发布或最新值一直处于写入中返回-1
+ */
+int topic_shm_get(topic_shm_t* shm, obj_dict_key_t event_key, void* out, size_t out_size);
+
+/*
+ * @brief 处理本进程的待处理通知，没有通知时最多阻塞timeout_ms
+ * @details 同一进程内只能由一个线程调用
+ * @param shm 进程内句柄
+ * @param timeout_ms 最长等待时间（毫秒），0表示不等待
+ * @return 本次处理的通知数
+ */
+int topic_shm_poll(topic_shm_t* shm, uint32_t timeout_ms);
+
+/*
+ * @brief 获取本进程统计
+ * @param shm 进程内句柄
+ * @param stats 输出统计
+ */
+void topic_shm_get_stats(const topic_shm_t* shm, topic_shm_stats_t* stats);
+
+#endif /* TOPIC_BUS_ENABLE_SHM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_SHM_H_ */
@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "topic_trace.h"
+#include "../../Rte/inc/os_heap.h"
+
+#if TOPIC_BUS_ENABLE_TRACE
+
+#if TOPIC_TRACE_ENABLE_EXPORT
+#include "../../Rte/inc/os_file.h"
+
+/* 导出缓冲大小（字节），写满3/4时写入文件 */
+#define TOPIC_TRACE_EXPORT_BUF 4096
+
+/* 导出上下文 */
+typedef struct {
+    OsFile_t* file;                     /* 输出文件 */
+    size_t offset;                      /* 文件写入偏移 */
+    size_t len;                         /* 缓冲中待写入的字节数 */
+    int error;                          /* 写入失败标志 */
+    int first;                          /* 尚未写入任何事件（逗号分隔） */
+    double us_per_tick;                 /* 时钟计数 -> 微秒 */
+    char buf[TOPIC_TRACE_EXPORT_BUF];
+} topic_trace_export_t;
+#endif
+
+/* ============================================================
+ * 全局变量 (Global Variables)
+ * ============================================================ */
+
+atomic_int g_topic_trace_level = ATOMIC_VAR_INIT(TOPIC_TRACE_DEFAULT_LEVEL);
+TOPIC_TRACE_TLS topic_trace_ring_t* g_topic_trace_ring = NULL;
+
+static _Atomic(topic_trace_ring_t*) s_trace_rings[TOPIC_TRACE_MAX_THREADS];
+static atomic_size_t s_trace_ring_count = ATOMIC_VAR_INIT(0);
+static atomic_uint s_trace_thread_seq = ATOMIC_VAR_INIT(0);
+static atomic_uint_fast64_t s_trace_lost = ATOMIC_VAR_INIT(0);
+static atomic_int s_trace_base_state = ATOMIC_VAR_INIT(0);  /* 0未校准，1校准中，2已校准 */
+static uint64_t s_trace_base_tick = 0;
+static uint64_t s_trace_base_us = 0;
+static TOPIC_TRACE_TLS int s_trace_claim_failed = 0;
+
+/* ============================================================
+ * 函数声明 (Function Declaration)
+ * ============================================================ */
+
+static void __trace_base_init(void);
+static topic_trace_ring_t* __trace_ring_reuse(void);
+static topic_trace_ring_t* __trace_ring_alloc(void);
+#if TOPIC_TRACE_ENABLE_EXPORT
+static void __export_flush(topic_trace_export_t* ctx);
+static void __export_printf(topic_trace_export_t* ctx, const char* fmt, ...);
+static int __export_record(topic_trace_export_t* ctx, const topic_trace_record_t* rec, int* depth);
+#endif
+
+/* ============================================================
+ * 函数实现 (Function Implementation)
+ * ============================================================ */
+
+/*
+ * @brief 记录时钟校准起点（首次占用缓冲时执行一次）
+ */
+static void __trace_base_init(void) {
+    int expected = 0;
+    if (atomic_load_explicit(&s_trace_base_state, memory_order_acquire) != 0 ||
+        !atomic_compare_exchange_strong(&s_trace_base_state, &expected, 1)) {
+        return;
+    }
+    s_trace_base_us = os_monotonic_time_get_microsecond();
+    s_trace_base_tick = TOPIC_TRACE_CLOCK();
+    atomic_store_explicit(&s_trace_base_state, 2, memory_order_release);
+}
+
+/*
+ * @brief 复用已退出线程释放的缓冲
+ * @return 缓冲指针，没有可复用的缓冲返回NULL
+ */
+static topic_trace_ring_t* __trace_ring_reuse(void) {
+    size_t count = atomic_load_explicit(&s_trace_ring_count, memory_order_acquire);
+    for (size_t i = 0; i < count && i < TOPIC_TRACE_MAX_THREADS; ++i) {
+        topic_trace_ring_t* ring = atomic_load_explicit(&s_trace_rings[i], memory_order_acquire);
+        int expected = 0;
+        if (ring && atomic_load_explicit(&ring->in_use, memory_order_relaxed) == 0 &&
+            atomic_compare_exchange_strong(&ring->in_use, &expected, 1)) {
+            return ring;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * @brief 分配新的线程缓冲并登记
+ * @return 缓冲指针，已达TOPIC_TRACE_MAX_THREADS或内存不足返回NULL
+ */
+static topic_trace_ring_t* __trace_ring_alloc(void) {
+    size_t index = atomic_load_explicit(&s_trace_ring_count, memory_order_relaxed);
+    do {
+        if (index >= TOPIC_TRACE_MAX_THREADS) return NULL;
+    } while (!atomic_compare_exchange_weak(&s_trace_ring_count, &index, index + 1));
+
+    topic_trace_ring_t* ring = (topic_trace_ring_t*)os_malloc(sizeof(topic_trace_ring_t));
+    if (!ring) return NULL;  /* 该槽位保持为空，导出时跳过 */
+    memset(ring, 0, sizeof(*ring));
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->in_use, 1);
+    atomic_store_explicit(&s_trace_rings[index], ring, memory_order_release);
+    return ring;
+}
+
+/*
+ * @brief 为当前线程占用一个跟踪缓冲
+ * @return 缓冲指针，缓冲已耗尽返回NULL
+ */
+topic_trace_ring_t* topic_trace_ring_claim(void) {
+    if (s_trace_claim_failed) {
+        atomic_fetch_add_explicit(&s_trace_lost, 1, memory_order_relaxed);
+        return NULL;
+    }
+    __trace_base_init();
+
+    topic_trace_ring_t* ring = __trace_ring_reuse();
+    if (!ring) ring = __trace_ring_alloc();
+    if (!ring) {
+        s_trace_claim_failed = 1;
+        atomic_fetch_add_explicit(&s_trace_lost, 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    ring->thread = (uint8_t)atomic_fetch_add_explicit(&s_trace_thread_seq, 1, memory_order_relaxed);
+    snprintf(ring->name, sizeof(ring->name), "thread-%u", (unsigned)ring->thread);
+    g_topic_trace_ring = ring;
+    return ring;
+}
+
+/*
+ * @brief 设置跟踪级别
+ * @param level TOPIC_TRACE_LEVEL_OFF/PUBLISH/CALLBACK
+ */
+void topic_trace_enable(int level) {
+    if (level < TOPIC_TRACE_LEVEL_OFF) level = TOPIC_TRACE_LEVEL_OFF;
+    if (level > TOPIC_TRACE_LEVEL_CALLBACK) level = TOPIC_TRACE_LEVEL_CALLBACK;
+    atomic_store_explicit(&g_topic_trace_level, level, memory_order_relaxed);
+}
+
+/*
+ * @brief 设置当前线程在导出结果中的名称
+ * @param name 线程名称
+ */
+void topic_trace_thread_name(const char* name) {
+    if (!name) return;
+    topic_trace_ring_t* ring = g_topic_trace_ring;
+    if (!ring && !(ring = topic_trace_ring_claim())) return;
+    strncpy(ring->name, name, sizeof(ring->name) - 1);
+    ring->name[sizeof(ring->name) - 1] = '\0';
+}
+
+/*
+ * @brief 当前线程退出前释放其跟踪缓冲
+ */
+void topic_trace_thread_exit(void) {
+    topic_trace_ring_t* ring = g_topic_trace_ring;
+    if (!ring) return;
+    g_topic_trace_ring = NULL;
+    atomic_store_explicit(&ring->in_use, 0, memory_order_release);
+}
+
+/*
+ * @brief 丢弃此前的全部记录
+ */
+void topic_trace_reset(void) {
+    size_t count = atomic_load_explicit(&s_trace_ring_count, memory_order_acquire);
+    for (size_t i = 0; i < count && i < TOPIC_TRACE_MAX_THREADS; ++i) {
+        topic_trace_ring_t* ring = atomic_load_explicit(&s_trace_rings[i], memory_order_acquire);
+        if (ring) {
+            atomic_store_explicit(&ring->tail, atomic_load_explicit(&ring->head, memory_order_acquire),
+                                  memory_order_relaxed);
+        }
+    }
+    atomic_store_explicit(&s_trace_lost, 0, memory_order_relaxed);
+}
+
+/*
+ * @brief 获取跟踪统计
+ * @param stats 输出统计
+ */
+void topic_trace_get_stats(topic_trace_stats_t* stats) {
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    size_t count = atomic_load_explicit(&s_trace_ring_count, memory_order_acquire);
+    for (size_t i = 0; i < count && i < TOPIC_TRACE_MAX_THREADS; ++i) {
+        topic_trace_ring_t* ring = atomic_load_explicit(&s_trace_rings[i], memory_order_acquire);
+        if (!ring) continue;
+        uint32_t head = (uint32_t)atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint32_t tail = (uint32_t)atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        uint32_t avail = head - tail;
+        stats->threads++;
+        stats->records += (avail < TOPIC_TRACE_RING_SIZE) ? avail : TOPIC_TRACE_RING_SIZE;
+    }
+    stats->lost = atomic_load_explicit(&s_trace_lost, memory_order_relaxed);
+}
+
+#if TOPIC_TRACE_ENABLE_EXPORT
+/*
+ * @brief 将导出缓冲写入文件
+ * @param ctx 导出上下文
+ */
+static void __export_flush(topic_trace_export_t* ctx) {
+    if (ctx->len == 0 || ctx->error) return;
+    if (os_file_write(ctx->file, ctx->offset, (const uint8_t*)ctx->buf, ctx->len) != (ssize_t)ctx->len) {
+        ctx->error = 1;
+    }
+    ctx->offset += ctx->len;
+    ctx->len = 0;
+}
+
+/*
+ * @brief 向导出缓冲追加格式化文本
+ * @param ctx 导出上下文
+ * @param fmt 格式串
+ */
+static void __export_printf(topic_trace_export_t* ctx, const char* fmt, ...) {
+    if (ctx->len > TOPIC_TRACE_EXPORT_BUF * 3 / 4) {
+        __export_flush(ctx);
+    }
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(ctx->buf + ctx->len, TOPIC_TRACE_EXPORT_BUF - ctx->len, fmt, ap);
+    va_end(ap);
+    if (n > 0) {
+        size_t room = TOPIC_TRACE_EXPORT_BUF - ctx->len - 1;
+        ctx->len += ((size_t)n < room) ? (size_t)n : room;
+    }
+}
+
+/*
+ * @brief 将一条记录转换为Chrome trace事件
+ * @param ctx 导出上下文
+ * @param rec 跟踪记录
+ * @param depth 所在线程当前未结束的区间数（用于丢弃起点已被覆盖的结束事件）
+ * @return 1已写入，0丢弃
+ */
+static int __export_record(topic_trace_export_t* ctx, const topic_trace_record_t* rec, int* depth) {
+    double ts = (double)(int64_t)(rec->ts - s_trace_base_tick) * ctx->us_per_tick;
+    const char* sep = ctx->first ? "" : ",\n";
+    unsigned topic = rec->topic_id;
+    unsigned event = rec->event_key;
+    unsigned arg = rec->arg;
+
+    switch (rec->phase) {
+        case TOPIC_TRACE_PUBLISH_BEGIN:
+            if (rec->topic_id == 0xFFFF) {
+                __export_printf(ctx, "%s{\"name\":\"publish event %u\",\"cat\":\"topic\",\"ph\":\"B\",\"ts\":%.3f,"
+                                "\"pid\":1,\"tid\":%u,\"args\":{\"event\":%u}}", sep, event, ts, rec->thread, event);
+            } else {
+                __export_printf(ctx, "%s{\"name\":\"publish topic %u\",\"cat\":\"topic\",\"ph\":\"B\",\"ts\":%.3f,"
+                                "\"pid\":1,\"tid\":%u,\"args\":{\"topic\":%u,\"event\":%u}}",
+                                sep, topic, ts, rec->thread, topic, event);
+            }
+            (*depth)++;
+            break;
+        case TOPIC_TRACE_CALLBACK_BEGIN:
+            __export_printf(ctx, "%s{\"name\":\"topic %u sub %u\",\"cat\":\"callback\",\"ph\":\"B\",\"ts\":%.3f,"
+                            "\"pid\":1,\"tid\":%u,\"args\":{\"topic\":%u,\"event\":%u,\"sub\":%u}}",
+                            sep, topic, arg, ts, rec->thread, topic, event, arg);
+            (*depth)++;
+            break;
+        case TOPIC_TRACE_ROUTER_BEGIN:
+            __export_printf(ctx, "%s{\"name\":\"router topic %u\",\"cat\":\"router\",\"ph\":\"B\",\"ts\":%.3f,"
+                            "\"pid\":1,\"tid\":%u,\"args\":{\"topic\":%u}}", sep, topic, ts, rec->thread, topic);
+            (*depth)++;
+            break;
+        case TOPIC_TRACE_ASYNC_BEGIN:
+            __export_printf(ctx, "%s{\"name\":\"async topic %u\",\"cat\":\"callback\",\"ph\":\"B\",\"ts\":%.3f,"
+                            "\"pid\":1,\"tid\":%u,\"args\":{\"topic\":%u}}", sep, topic, ts, rec->thread, topic);
+            (*depth)++;
+            break;
+        case TOPIC_TRACE_DRAIN_BEGIN:
+            __export_printf(ctx, "%s{\"name\":\"isr drain\",\"cat\":\"topic\",\"ph\":\"B\",\"ts\":%.3f,"
+                            "\"pid\":1,\"tid\":%u,\"args\":{\"events\":%u}}", sep, ts, rec->thread, arg);
+            (*depth)++;
+            break;
+        case TOPIC_TRACE_PUBLISH_END:
+        case TOPIC_TRACE_CALLBACK_END:
+        case TOPIC_TRACE_ROUTER_END:
+        case TOPIC_TRACE_ASYNC_END:
+        case TOPIC_TRACE_DRAIN_END:
+            if (*depth == 0) return 0;  /* 对应的开始记录已被覆盖 */
+            __export_printf(ctx, "%s{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", sep, ts, rec->thread);
+            (*depth)--;
+            break;
+        case TOPIC_TRACE_MATCH:
+            __export_printf(ctx, "%s{\"name\":\"match topic %u\",\"cat\":\"rule\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,"
+                            "\"pid\":1,\"tid\":%u,\"args\":{\"topic\":%u,\"event\":%u}}",
+                            sep, topic, ts, rec->thread, topic, event);
+            break;
+        case TOPIC_TRACE_ASYNC_SUBMIT:
+            __export_printf(ctx, "%s{\"name\":\"submit topic %u\",\"cat\":\"callback\",\"ph\":\"i\",\"s\":\"t\","
+                            "\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"topic\":%u,\"sub\":%u}}",
+                            sep, topic, ts, rec->thread, topic, arg);
+            break;
+        default:
+            return 0;
+    }
+    ctx->first = 0;
+    return 1;
+}
+
+/*
+ * @brief 将全部线程的跟踪记录导出为Chrome trace JSON
+ * @param path 输出文件路径
+ * @return 写入的事件数，失败返回-1
+ */
+int topic_trace_export_chrome(const char* path) {
+    if (!path || atomic_load_explicit(&s_trace_base_state, memory_order_acquire) != 2) return -1;
+
+    topic_trace_export_t* ctx = (topic_trace_export_t*)os_malloc(sizeof(topic_trace_export_t));
+    if (!ctx) return -1;
+    memset(ctx, 0, sizeof(*ctx));
+    OsFileCfg_t cfg = { .pFilePath = path, .Flags = OS_FILE_FLAG_CREAT | OS_FILE_FLAG_WRONLY | OS_FILE_FLAG_TRUNC };
+    ctx->file = os_file_open(&cfg);
+    if (!ctx->file) {
+        os_free(ctx);
+        return -1;
+    }
+    ctx->first = 1;
+
+    /* 以首次记录与当前时刻两点校准时钟计数 */
+    uint64_t now_us = os_monotonic_time_get_microsecond();
+    uint64_t now_tick = TOPIC_TRACE_CLOCK();
+    ctx->us_per_tick = (now_tick > s_trace_base_tick && now_us > s_trace_base_us)
+                     ? (double)(now_us - s_trace_base_us) / (double)(now_tick - s_trace_base_tick) : 1.0;
+
+    __export_printf(ctx, "{\"traceEvents\":[\n");
+    int events = 0;
+    size_t count = atomic_load_explicit(&s_trace_ring_count, memory_order_acquire);
+    for (size_t i = 0; i < count && i < TOPIC_TRACE_MAX_THREADS; ++i) {
+        topic_trace_ring_t* ring = atomic_load_explicit(&s_trace_rings[i], memory_order_acquire);
+        if (!ring) continue;
+
+        __export_printf(ctx, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                        ctx->first ? "" : ",\n", (unsigned)ring->thread, ring->name);
+        ctx->first = 0;
+
+        uint32_t head = (uint32_t)atomic_load_explicit(&ring->head, memory_order_acquire);
+        uint32_t tail = (uint32_t)atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        uint32_t start = (head - tail > TOPIC_TRACE_RING_SIZE) ? head - TOPIC_TRACE_RING_SIZE : tail;
+        int depth = 0;
+        uint8_t thread = 0xFF;
+        for (uint32_t idx = start; idx != head; ++idx) {
+            topic_trace_record_t rec = ring->records[idx & (TOPIC_TRACE_RING_SIZE - 1U)];
+            /* 复制期间所属线程已写到同一槽位时丢弃（写者在发布head前先写记录） */
+            atomic_thread_fence(memory_order_acquire);
+            uint32_t now_head = (uint32_t)atomic_load_explicit(&ring->head, memory_order_relaxed);
+            if ((uint32_t)(now_head - idx) >= TOPIC_TRACE_RING_SIZE) continue;
+            if (rec.thread != thread) {
+                thread = rec.thread;  /* 缓冲被新线程复用，区间嵌套重新计数 */
+                depth = 0;
+            }
+            events += __export_record(ctx, &rec, &depth);
+        }
+    }
+    __export_printf(ctx, "\n],\"displayTimeUnit\":\"ns\"}\n");
+    __export_flush(ctx);
+
+    int error = ctx->error;
+    os_file_close(ctx->file);
+    os_free(ctx);
+    return error ? -1 : events;
+}
+#endif
+
+#endif
@@ -0,0 +1,184 @@
+#ifndef TOPIC_TRACE_H_
+#define TOPIC_TRACE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "topic_bus_config.h"
+#include "../../Rte/inc/os_timestamp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 二进制事件跟踪：每个线程一个单写者环形缓冲，记录为16字节定长结构，
+ * 写入只有一次线程局部变量读取、一次时钟读取与一次release存储，不加锁、不分配内存（首次记录除外）；
+ * 环满后覆盖最旧记录。topic_trace_export_chrome将全部线程的记录转换为Chrome trace JSON，
+ * 可直接用chrome://tracing或Perfetto（ui.perfetto.dev）打开
+ *
+ * 时钟源TOPIC_TRACE_CLOCK()需为64位单调计数：x86使用TSC，AArch64使用通用定时器，
+ * 其他平台默认os_monotonic_time_get_microsecond()；MCU可定义为扩展到64位的周期计数器。
+ * 导出时以首次记录与导出时刻的os_monotonic_time_get_microsecond()校准为微秒
+ *
+ * ISR中不要记录：线程局部变量在ISR中指向被打断线程的缓冲，会与该线程的写入交错
+ */
+
+#ifndef TOPIC_TRACE_CLOCK
+#if defined(__x86_64__) || defined(__i386__)
+#define TOPIC_TRACE_CLOCK() ((uint64_t)__builtin_ia32_rdtsc())
+#elif defined(__aarch64__)
+static inline uint64_t __topic_trace_cntvct(void) {
+    uint64_t v;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(v));
+    return v;
+}
+#define TOPIC_TRACE_CLOCK() __topic_trace_cntvct()
+#else
+#define TOPIC_TRACE_CLOCK() os_monotonic_time_get_microsecond()
+#endif
+#endif
+
+/* 跟踪级别 */
+#define TOPIC_TRACE_LEVEL_OFF       0   /* 不记录 */
+#define TOPIC_TRACE_LEVEL_PUBLISH   1   /* 发布、规则命中、Router与ISR排空 */
+#define TOPIC_TRACE_LEVEL_CALLBACK  2   /* 另记录每个同步回调的开始/结束与异步投递/执行 */
+
+/* 跟踪阶段 */
+typedef enum {
+    TOPIC_TRACE_PUBLISH_BEGIN = 1,      /* 发布开始（event_key；手动发布时为topic_id） */
+    TOPIC_TRACE_PUBLISH_END,            /* 发布结束 */
+    TOPIC_TRACE_MATCH,                  /* 规则命中（topic_id, event_key） */
+    TOPIC_TRACE_CALLBACK_BEGIN,         /* 同步回调开始（arg为订阅者序号，回调级） */
+    TOPIC_TRACE_CALLBACK_END,           /* 同步回调结束（回调级） */
+    TOPIC_TRACE_ROUTER_BEGIN,           /* Router处理开始 */
+    TOPIC_TRACE_ROUTER_END,             /* Router处理结束 */
+    TOPIC_TRACE_ASYNC_SUBMIT,           /* 投递到异步订阅者队列（回调级） */
+    TOPIC_TRACE_ASYNC_BEGIN,            /* 执行器工作线程回调开始（回调级） */
+    TOPIC_TRACE_ASYNC_END,              /* 执行器工作线程回调结束（回调级） */
+    TOPIC_TRACE_DRAIN_BEGIN,            /* ISR队列批量排空开始（arg为出队事件数） */
+    TOPIC_TRACE_DRAIN_END,              /* ISR队列批量排空结束 */
+} topic_trace_phase_t;
+
+/* 跟踪记录（16字节） */
+typedef struct {
+    uint64_t ts;                        /* TOPIC_TRACE_CLOCK()计数 */
+    uint16_t topic_id;                  /* Topic ID（无关时为0xFFFF） */
+    uint16_t event_key;                 /* 事件键 */
+    uint16_t arg;                       /* 附加参数（订阅者序号、事件数等） */
+    uint8_t phase;                      /* topic_trace_phase_t */
+    uint8_t thread;                     /* 线程序号 */
+} topic_trace_record_t;
+
+/* 单线程跟踪环形缓冲 */
+typedef struct {
+    atomic_uint_fast32_t head;          /* 累计写入记录数（仅所属线程写） */
+    atomic_uint_fast32_t tail;          /* 导出起点（topic_trace_reset写入） */
+    atomic_int in_use;                  /* 非0表示已被某线程占用 */
+    uint8_t thread;                     /* 当前占用线程的序号 */
+    char name[16];                      /* 线程名称 */
+    topic_trace_record_t records[TOPIC_TRACE_RING_SIZE];
+} topic_trace_ring_t;
+
+/* 跟踪统计 */
+typedef struct {
+    size_t threads;                     /* 已分配的线程缓冲数 */
+    size_t records;                     /* 当前可导出的记录数 */
+    uint64_t lost;                      /* 因线程缓冲耗尽未记录的次数 */
+} topic_trace_stats_t;
+
+#if TOPIC_BUS_ENABLE_TRACE
+
+extern atomic_int g_topic_trace_level;
+extern TOPIC_TRACE_TLS topic_trace_ring_t* g_topic_trace_ring;
+
+/*
+ * @brief 为当前线程占用一个跟踪缓冲（首次记录时由topic_trace_record调用）
+ * @return 缓冲指针，缓冲已耗尽返回NULL
+ */
+topic_trace_ring_t* topic_trace_ring_claim(void);
+
+/*
+ * @brief 写入一条跟踪记录（当前级别低于level时直接返回）
+ * @param level 记录所需的最低跟踪级别
+ * @param phase 跟踪阶段
+ * @param topic_id Topic ID
+ * @param event_key 事件键
+ * @param arg 附加参数
+ */
+static inline void topic_trace_record(int level, uint8_t phase, uint16_t topic_id, uint16_t event_key,
+                                      uint16_t arg) {
+    if (atomic_load_explicit(&g_topic_trace_level, memory_order_relaxed) < level) return;
+    topic_trace_ring_t* ring = g_topic_trace_ring;
+    if (!ring && !(ring = topic_trace_ring_claim())) return;
+
+    uint32_t head = (uint32_t)atomic_load_explicit(&ring->head, memory_order_relaxed);
+    topic_trace_record_t* rec = &ring->records[head & (TOPIC_TRACE_RING_SIZE - 1U)];
+    rec->ts = TOPIC_TRACE_CLOCK();
+    rec->topic_id = topic_id;
+    rec->event_key = event_key;
+    rec->arg = arg;
+    rec->phase = phase;
+    rec->thread = ring->thread;
+    atomic_store_explicit(&ring->head, head + 1U, memory_order_release);
+}
+
+#define TOPIC_TRACE(phase, topic_id, event_key, arg) \
+    topic_trace_record(TOPIC_TRACE_LEVEL_PUBLISH, (uint8_t)(phase), (uint16_t)(topic_id), (uint16_t)(event_key), \
+                       (uint16_t)(arg))
+
+/* 每个回调一条的记录：仅在TOPIC_TRACE_LEVEL_CALLBACK级别写入 */
+#define TOPIC_TRACE_CB(phase, topic_id, event_key, arg) \
+    topic_trace_record(TOPIC_TRACE_LEVEL_CALLBACK, (uint8_t)(phase), (uint16_t)(topic_id), (uint16_t)(event_key), \
+                       (uint16_t)(arg))
+
+/*
+ * @brief 设置跟踪级别（默认TOPIC_TRACE_DEFAULT_LEVEL）
+ * @details 回调级每个回调多两条记录，订阅者多时显著增加发布开销，排查回调耗时时再开启
+ * @param level TOPIC_TRACE_LEVEL_OFF/PUBLISH/CALLBACK（大于CALLBACK按CALLBACK处理）
+ */
+void topic_trace_enable(int level);
+
+/*
+ * @brief 设置当前线程在导出结果中的名称
+ * @param name 线程名称（最多15个字符）
+ */
+void topic_trace_thread_name(const char* name);
+
+/*
+ * @brief 当前线程退出前释放其跟踪缓冲，供之后的新线程复用（已有记录保留到被覆盖）
+ */
+void topic_trace_thread_exit(void);
+
+/*
+ * @brief 丢弃此前的全部记录（只移动导出起点，不打扰正在写入的线程）
+ */
+void topic_trace_reset(void);
+
+/*
+ * @brief 获取跟踪统计
+ * @param stats 输出统计
+ */
+void topic_trace_get_stats(topic_trace_stats_t* stats);
+
+#if TOPIC_TRACE_ENABLE_EXPORT
+/*
+ * @brief 将全部线程的跟踪记录导出为Chrome trace JSON（Perfetto可直接打开）
+ * @details 回调/Router/发布/排空为B/E区间，规则命中与异步投递为瞬时事件；
+ *          导出期间被覆盖的记录自动丢弃，可在运行中导出
+ * @param path 输出文件路径
+ * @return 写入的事件数，失败返回-1
+ */
+int topic_trace_export_chrome(const char* path);
+#endif
+
+#else
+#define TOPIC_TRACE(phase, topic_id, event_key, arg) ((void)0)
+#define TOPIC_TRACE_CB(phase, topic_id, event_key, arg) ((void)0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TOPIC_TRACE_H_ */